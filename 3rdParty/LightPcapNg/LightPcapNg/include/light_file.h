@@ -30,11 +30,24 @@
 typedef _compression_t *light_compression;
 typedef _decompression_t *light_decompression;
 
+// PCPP patch
+// User supplied output functions, used instead of the FILE* when set. Every call of the write function receives
+// complete pcapng blocks
+typedef struct light_io_callbacks
+{
+	void* cookie;
+	// Return the number of bytes written, or (size_t)-1 on failure
+	size_t (*write)(void* cookie, const void* buf, size_t count);
+	int (*flush)(void* cookie);
+} light_io_callbacks;
+// PCPP patch end
+
 typedef struct light_file_t
 {
 	FILE* file;
 	light_compression compression_context;
 	light_decompression decompression_context;
+	light_io_callbacks io_callbacks; // PCPP patch
 
 } light_file_t;
 
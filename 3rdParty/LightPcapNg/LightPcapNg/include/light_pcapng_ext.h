@@ -29,6 +29,7 @@ extern "C" {
 #endif
 
 #include "light_types.h"
+#include "light_file.h" // PCPP patch
 
 #include <stddef.h>
 #include <stdint.h>
@@ -83,6 +84,12 @@ light_pcapng_t *light_pcapng_open_write(const char* file_path, light_pcapng_file
 
 light_pcapng_t *light_pcapng_open_append(const char* file_path);
 
+// PCPP patch
+// Write a pcapng stream through user supplied I/O functions instead of a file. The stream isn't closed by
+// light_pcapng_close()
+light_pcapng_t *light_pcapng_open_write_callbacks(const light_io_callbacks *callbacks, light_pcapng_file_info *file_info);
+// PCPP patch end
+
 light_pcapng_file_info *light_create_default_file_info();
 
 light_pcapng_file_info *light_create_file_info(const char *os_desc, const char *hardware_desc, const char *user_app_desc, const char *file_comment);
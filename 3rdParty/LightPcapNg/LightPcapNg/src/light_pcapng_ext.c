@@ -223,6 +223,28 @@ light_pcapng_t *light_pcapng_open_read(const char* file_path, light_boolean read
 	return pcapng;
 }
 
+// PCPP patch
+static void __write_section_header(light_pcapng_t *pcapng, light_pcapng_file_info *file_info);
+
+light_pcapng_t *light_pcapng_open_write_callbacks(const light_io_callbacks *callbacks, light_pcapng_file_info *file_info)
+{
+	DCHECK_NULLP(file_info, return NULL);
+	DCHECK_NULLP(callbacks, return NULL);
+
+	light_file file = light_open_callbacks(callbacks);
+	DCHECK_ASSERT_EXP(file != NULL, "invalid I/O callbacks", return NULL);
+
+	light_pcapng_t *pcapng = calloc(1, sizeof(struct _light_pcapng_t));
+	pcapng->file = file;
+	pcapng->file_info = file_info;
+	pcapng->pcapng = NULL;
+
+	__write_section_header(pcapng, file_info);
+
+	return pcapng;
+}
+// PCPP patch end
+
 light_pcapng_t *light_pcapng_open_write(const char* file_path, light_pcapng_file_info *file_info, int compression_level)
 {
 	DCHECK_NULLP(file_info, return NULL);
@@ -237,6 +259,15 @@ light_pcapng_t *light_pcapng_open_write(const char* file_path, light_pcapng_file
 
 	pcapng->pcapng = NULL;
 
+	// PCPP patch
+	__write_section_header(pcapng, file_info);
+
+	return pcapng;
+}
+
+static void __write_section_header(light_pcapng_t *pcapng, light_pcapng_file_info *file_info)
+{
+	// PCPP patch end
 	struct _light_section_header section_header;
 	section_header.byteorder_magic = BYTE_ORDER_MAGIC;
 	section_header.major_version = file_info->major_version;
@@ -286,8 +317,6 @@ light_pcapng_t *light_pcapng_open_write(const char* file_path, light_pcapng_file
 
 
 	light_pcapng_release(blocks_to_write);
-
-	return pcapng;
 }
 
 light_pcapng_t *light_pcapng_open_append(const char* file_path)
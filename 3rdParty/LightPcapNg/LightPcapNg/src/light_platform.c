@@ -137,6 +137,22 @@ light_file light_open_compression(const char *file_name, const __read_mode_t mod
 
 
 
+// PCPP patch
+light_file light_open_callbacks(const light_io_callbacks *callbacks)
+{
+	if (callbacks == NULL || callbacks->write == NULL)
+		return NULL;
+
+	light_file fd = calloc(1, sizeof(light_file_t));
+	fd->file = INVALID_FILE;
+	fd->compression_context = NULL;
+	fd->decompression_context = NULL;
+	fd->io_callbacks = *callbacks;
+
+	return fd;
+}
+// PCPP patch end
+
 size_t light_read(light_file fd, void *buf, size_t count)
 {
 	if (fd->decompression_context == NULL)
@@ -152,6 +168,13 @@ size_t light_read(light_file fd, void *buf, size_t count)
 
 size_t light_write(light_file fd, const void *buf, size_t count)
 {
+	// PCPP patch
+	if (fd->io_callbacks.write != NULL)
+	{
+		return fd->io_callbacks.write(fd->io_callbacks.cookie, buf, count);
+	}
+	// PCPP patch end
+
 	if (fd->compression_context == NULL)
 	{
 		size_t bytes_written = fwrite(buf, 1, count, fd->file);
@@ -178,7 +201,12 @@ size_t light_size(light_file fd)
 int light_close(light_file fd)
 {
 	light_close_compressed(fd);
-	int rc = fclose(fd->file);
+	// PCPP patch
+	// the stream behind user supplied callbacks is owned and closed by the user
+	int rc = 0;
+	if (fd->file != INVALID_FILE)
+		rc = fclose(fd->file);
+	// PCPP patch end
 
 	free(fd);
 
@@ -187,11 +215,21 @@ int light_close(light_file fd)
 
 int light_flush(light_file fd)
 {
+	// PCPP patch
+	if (fd->file == INVALID_FILE)
+		return fd->io_callbacks.flush != NULL ? fd->io_callbacks.flush(fd->io_callbacks.cookie) : 0;
+	// PCPP patch end
+
 	return fflush(fd->file);
 }
 
 int light_eof(light_file fd)
 {
+	// PCPP patch
+	if (fd->file == INVALID_FILE)
+		return 0;
+	// PCPP patch end
+
 	return feof(fd->file);
 }
 
@@ -2,10 +2,13 @@ import argparse
 from dataclasses import dataclass, asdict, is_dataclass
 import json
 import re
+import struct
 from typing import Optional
 import urllib.request
 
 MANUF_URL = "https://gitlab.com/wireshark/wireshark/-/raw/master/epan/manuf-data.c"
+BINARY_MAGIC = b"PCPPOUI\x00"
+BINARY_VERSION = 1
 REGEX_PATTERN = r"\{\s*((?:0x[0-9A-Fa-f]{2}\s*,\s*){2}(?:0x[0-9A-Fa-f]{2}\s*,\s*)*0x[0-9A-Fa-f]{2})\s*\},\s*(\"(?:[^\"\\]|\\.)*\"),\s*(\"(?:[^\"\\]|\\.)*\")"
 
 
@@ -56,6 +59,19 @@ def parse_args():
         default="PCPP_OUIDataset.json",
         help="Output file path",
     )
+    parser.add_argument(
+        "--binary-output-file",
+        "-b",
+        type=str,
+        default="PCPP_OUIDataset.bin",
+        help="Binary output file path, loaded with OUILookup::initOUIDatabaseFromBinary()",
+    )
+    parser.add_argument(
+        "--json-input-file",
+        "-j",
+        type=str,
+        help="Read an existing JSON dataset instead of the Wireshark manuf data and only write the binary file",
+    )
     return parser.parse_args()
 
 
@@ -141,9 +157,94 @@ def update_oui_dataset(
         update_masked_filters_in_record(oui_dataset[mac_hash], line_elements)
 
 
+def load_json_dataset(path: str) -> dict[str, OUIRecord]:
+    with open(path, "r", encoding="utf8") as in_file:
+        json_dataset = json.load(in_file)
+
+    oui_dataset = {}
+    for mac_hash, record in json_dataset.items():
+        masked_filters = [
+            MaskedFilter(mask=entry["mask"], vendors=entry["vendors"])
+            for entry in record.get("maskedFilters", [])
+        ]
+        oui_dataset[mac_hash] = OUIRecord(
+            vendor=record["vendor"], masked_filters=masked_filters or None
+        )
+
+    return oui_dataset
+
+
+def write_binary_dataset(oui_dataset: dict[str, OUIRecord], path: str) -> None:
+    """
+    Write the dataset in the binary format of OUILookup. All integers are little-endian:
+    - header: magic (8 bytes), version, OUI count, masked group count, masked entry count, string pool size, reserved
+      (uint32 each)
+    - OUI table sorted by OUI: OUI, vendor offset (uint32 each)
+    - masked group table sorted by OUI: OUI, first masked entry, masked entry count (uint32 each)
+    - masked entries of each group sorted by mask (longest first) and address: address (uint64), vendor offset, mask
+      (uint32 each)
+    - string pool of NUL-terminated UTF-8 vendor names
+    """
+    string_pool = bytearray()
+    string_offsets = {}
+
+    def add_string(value: str) -> int:
+        if value not in string_offsets:
+            string_offsets[value] = len(string_pool)
+            string_pool.extend(value.encode("utf-8") + b"\x00")
+        return string_offsets[value]
+
+    oui_table = bytearray()
+    group_table = bytearray()
+    masked_table = bytearray()
+    masked_count = 0
+    group_count = 0
+    for oui in sorted(int(mac_hash) for mac_hash in oui_dataset):
+        record = oui_dataset[str(oui)]
+        oui_table += struct.pack("<II", oui, add_string(record.vendor))
+        if not record.masked_filters:
+            continue
+
+        entries = sorted(
+            (
+                (masked_filter.mask, int(address), vendor)
+                for masked_filter in record.masked_filters
+                for address, vendor in masked_filter.vendors.items()
+            ),
+            key=lambda entry: (-entry[0], entry[1]),
+        )
+        group_table += struct.pack("<III", oui, masked_count, len(entries))
+        group_count += 1
+        for mask, address, vendor in entries:
+            masked_table += struct.pack("<QII", address, add_string(vendor), mask)
+        masked_count += len(entries)
+
+    with open(path, "wb") as out_file:
+        out_file.write(BINARY_MAGIC)
+        out_file.write(
+            struct.pack(
+                "<IIIIII",
+                BINARY_VERSION,
+                len(oui_dataset),
+                group_count,
+                masked_count,
+                len(string_pool),
+                0,
+            )
+        )
+        out_file.write(oui_table)
+        out_file.write(group_table)
+        out_file.write(masked_table)
+        out_file.write(string_pool)
+
+
 def main() -> None:
     args = parse_args()
 
+    if args.json_input_file:
+        write_binary_dataset(load_json_dataset(args.json_input_file), args.binary_output_file)
+        return
+
     if args.input_file:
         with open(args.input_file, "r", encoding="utf8") as in_file:
             lines = in_file.readlines()
@@ -174,6 +275,8 @@ def main() -> None:
         )
         out_file.write("\n")
 
+    write_binary_dataset(oui_dataset, args.binary_output_file)
+
 
 if __name__ == "__main__":
     main()
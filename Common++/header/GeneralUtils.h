@@ -2,6 +2,7 @@
 
 #include <string>
 #include <stdint.h>
+#include <string.h>
 #include <type_traits>
 
 /// @file
@@ -65,4 +66,32 @@ namespace pcpp
 			return static_cast<typename std::underlying_type<EnumClass>::type>(value);
 		}
 	};
+
+	/// Mix a 64-bit value into a 64-bit hash whose bits all depend on all the input bits (the finalizer of
+	/// MurmurHash3). Used by the hash() methods of the address and flow key types
+	/// @param[in] value The value to mix
+	/// @return The mixed value
+	inline uint64_t hashMix64(uint64_t value)
+	{
+		value ^= value >> 33;
+		value *= 0xFF51AFD7ED558CCDULL;
+		value ^= value >> 33;
+		value *= 0xC4CEB9FE1A85EC53ULL;
+		value ^= value >> 33;
+		return value;
+	}
+
+	/// Hash 16 bytes, for example an IPv6 address, into 64 bits. The two 8-byte halves are multiplied by different
+	/// constants independently, so the CPU can compute them in parallel, and are combined by a single final mix
+	/// @param[in] data A pointer to 16 bytes, there are no alignment requirements
+	/// @return The hash
+	inline uint64_t hashMix128(const uint8_t* data)
+	{
+		uint64_t low, high;
+		memcpy(&low, data, sizeof(low));
+		memcpy(&high, data + sizeof(low), sizeof(high));
+		low *= 0x9E3779B97F4A7C15ULL;
+		high *= 0xC2B2AE3D27D4EB4FULL;
+		return hashMix64(low ^ ((high << 31) | (high >> 33)));
+	}
 }  // namespace pcpp
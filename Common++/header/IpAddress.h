@@ -6,8 +6,11 @@
 #include <algorithm>
 #include <ostream>
 #include <array>
+#include <functional>
 #include <memory>
 
+#include "GeneralUtils.h"
+
 /// @file
 
 /// @namespace pcpp
@@ -27,6 +30,9 @@ namespace pcpp
 	class IPv4Address
 	{
 	public:
+		/// The maximum length of the string representation of an IPv4 address
+		static constexpr size_t MaxStringLength = 15;
+
 		/// A default constructor that creates an instance of the class with the zero-initialized address
 		IPv4Address() = default;
 
@@ -72,6 +78,18 @@ namespace pcpp
 		/// @return A string representation of the address
 		std::string toString() const;
 
+		/// Write the string representation of the address to a buffer without allocating memory
+		/// @param[out] buffer The buffer to write to, the string is null-terminated
+		/// @param[in] bufferLen The buffer size, MaxStringLength + 1 is always enough
+		/// @return The string length, or 0 if the buffer is too small
+		size_t toString(char* buffer, size_t bufferLen) const;
+
+		/// @return A 64-bit hash of the address
+		uint64_t hash() const
+		{
+			return hashMix64(toInt());
+		}
+
 		/// @return True if an address is multicast, false otherwise.
 		bool isMulticast() const;
 
@@ -155,6 +173,9 @@ namespace pcpp
 	class IPv6Address
 	{
 	public:
+		/// The maximum length of the string representation of an IPv6 address
+		static constexpr size_t MaxStringLength = 45;
+
 		/// A default constructor that creates an instance of the class with the zero-initialized address.
 		IPv6Address() = default;
 
@@ -193,6 +214,18 @@ namespace pcpp
 		/// @return A string representation of the address
 		std::string toString() const;
 
+		/// Write the string representation of the address to a buffer without allocating memory
+		/// @param[out] buffer The buffer to write to, the string is null-terminated
+		/// @param[in] bufferLen The buffer size, MaxStringLength + 1 is always enough
+		/// @return The string length, or 0 if the buffer is too small
+		size_t toString(char* buffer, size_t bufferLen) const;
+
+		/// @return A 64-bit hash of the address
+		uint64_t hash() const
+		{
+			return hashMix128(m_Bytes.data());
+		}
+
 		/// Determine whether the address is a multicast address
 		/// @return True if an address is multicast
 		bool isMulticast() const;
@@ -284,6 +317,9 @@ namespace pcpp
 			IPv6AddressType
 		};
 
+		/// The maximum length of the string representation of an IPv4 or IPv6 address
+		static constexpr size_t MaxStringLength = IPv6Address::MaxStringLength;
+
 		/// A default constructor that creates an instance of the class with unspecified IPv4 address
 		IPAddress() : m_Type(IPv4AddressType)
 		{}
@@ -327,6 +363,23 @@ namespace pcpp
 			return (getType() == IPv4AddressType) ? m_IPv4.toString() : m_IPv6.toString();
 		}
 
+		/// Write the string representation of the address to a buffer without allocating memory
+		/// @param[out] buffer The buffer to write to, the string is null-terminated
+		/// @param[in] bufferLen The buffer size, MaxStringLength + 1 is always enough
+		/// @return The string length, or 0 if the buffer is too small
+		size_t toString(char* buffer, size_t bufferLen) const
+		{
+			return (getType() == IPv4AddressType) ? m_IPv4.toString(buffer, bufferLen)
+			                                      : m_IPv6.toString(buffer, bufferLen);
+		}
+
+		/// @return A 64-bit hash of the address. It's the same as the hash of the IPv4Address or IPv6Address it
+		/// holds
+		uint64_t hash() const
+		{
+			return (getType() == IPv4AddressType) ? m_IPv4.hash() : m_IPv6.hash();
+		}
+
 		/// @return Determine whether the object contains an IP version 4 address
 		bool isIPv4() const
 		{
@@ -898,3 +951,33 @@ namespace pcpp
 	}
 
 }  // namespace pcpp
+
+namespace std
+{
+	/// A std::hash specialization that allows using IPv4Address as a key of unordered containers
+	template <> struct hash<pcpp::IPv4Address>
+	{
+		size_t operator()(const pcpp::IPv4Address& addr) const
+		{
+			return static_cast<size_t>(addr.hash());
+		}
+	};
+
+	/// A std::hash specialization that allows using IPv6Address as a key of unordered containers
+	template <> struct hash<pcpp::IPv6Address>
+	{
+		size_t operator()(const pcpp::IPv6Address& addr) const
+		{
+			return static_cast<size_t>(addr.hash());
+		}
+	};
+
+	/// A std::hash specialization that allows using IPAddress as a key of unordered containers
+	template <> struct hash<pcpp::IPAddress>
+	{
+		size_t operator()(const pcpp::IPAddress& addr) const
+		{
+			return static_cast<size_t>(addr.hash());
+		}
+	};
+}  // namespace std
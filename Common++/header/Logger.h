@@ -1,7 +1,10 @@
 #pragma once
 
 #include <stdio.h>
+#include <atomic>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <iomanip>
 #include <stdint.h>
@@ -17,23 +20,49 @@
 #	define PCAPPP_FILENAME __FILE__
 #endif
 
-#define PCPP_LOG(level, message)                                                                                       \
-	do                                                                                                                 \
-	{                                                                                                                  \
-		std::ostringstream* sstream = pcpp::Logger::getInstance().internalCreateLogStream();                           \
-		(*sstream) << message;                                                                                         \
-		pcpp::Logger::getInstance().internalPrintLogMessage(sstream, level, PCAPPP_FILENAME, __FUNCTION__, __LINE__);  \
-	} while (0)
+// The most verbose log level compiled into the code, as a pcpp::Logger::LogLevel value. Log calls that are more
+// verbose are removed at compile time, so they cost nothing even if the log level is raised at runtime. PcapPlusPlus
+// libraries are built with the level set by the PCAPPP_LOG_LEVEL CMake option
+#ifndef PCPP_LOG_COMPILED_LEVEL
+#	define PCPP_LOG_COMPILED_LEVEL 2
+#endif
 
-#define PCPP_LOG_DEBUG(message)                                                                                        \
+#define PCPP_LOG(level, message)                                                                                       \
 	do                                                                                                                 \
 	{                                                                                                                  \
-		if (pcpp::Logger::getInstance().logsEnabled() && pcpp::Logger::getInstance().isDebugEnabled(LOG_MODULE))       \
+		static pcpp::internal::LogCallSite pcppLogCallSite;                                                            \
+		uint32_t pcppSuppressedLogs = 0;                                                                               \
+		if (pcpp::Logger::getInstance().internalCheckRateLimit(pcppLogCallSite, pcppSuppressedLogs))                   \
 		{                                                                                                              \
-			PCPP_LOG(pcpp::Logger::Debug, message);                                                                    \
+			std::ostringstream sstream;                                                                                \
+			sstream << message;                                                                                        \
+			pcpp::Logger::getInstance().internalPrintLogMessage(sstream, level, PCAPPP_FILENAME, __FUNCTION__,         \
+			                                                    __LINE__, pcppSuppressedLogs);                         \
 		}                                                                                                              \
 	} while (0)
 
+#if PCPP_LOG_COMPILED_LEVEL >= 2
+#	define PCPP_LOG_DEBUG(message)                                                                                    \
+		do                                                                                                             \
+		{                                                                                                              \
+			if (pcpp::Logger::getInstance().logsEnabled() && pcpp::Logger::getInstance().isDebugEnabled(LOG_MODULE))   \
+			{                                                                                                          \
+				PCPP_LOG(pcpp::Logger::Debug, message);                                                                \
+			}                                                                                                          \
+		} while (0)
+#else
+// the message stays in a discarded branch so values that are only used in debug logs don't become unused
+#	define PCPP_LOG_DEBUG(message)                                                                                    \
+		do                                                                                                             \
+		{                                                                                                              \
+			if (false)                                                                                                 \
+			{                                                                                                          \
+				std::ostringstream sstream;                                                                            \
+				sstream << message;                                                                                    \
+			}                                                                                                          \
+		} while (0)
+#endif
+
 #define PCPP_LOG_ERROR(message)                                                                                        \
 	do                                                                                                                 \
 	{                                                                                                                  \
@@ -100,6 +129,8 @@ namespace pcpp
 		PacketLogModuleWakeOnLanLayer,   ///< WakeOnLanLayer module (Packet++)
 		PacketLogModuleSmtpLayer,        ///< SmtpLayer module (Packet++)
 		PacketLogModuleWireGuardLayer,   ///< WireGuardLayer module (Packet++)
+		PacketLogModuleFlowMeter,        ///< FlowMeter and flow record export module (Packet++)
+		PacketLogModuleHttpReassembly,   ///< HttpReassembly module (Packet++)
 		PcapLogModuleWinPcapLiveDevice,  ///< WinPcapLiveDevice module (Pcap++)
 		PcapLogModuleRemoteDevice,       ///< WinPcapRemoteDevice module (Pcap++)
 		PcapLogModuleLiveDevice,         ///< PcapLiveDevice module (Pcap++)
@@ -109,10 +140,27 @@ namespace pcpp
 		PcapLogModuleDpdkDevice,         ///< DpdkDevice module (Pcap++)
 		PcapLogModuleKniDevice,          ///< KniDevice module (Pcap++)
 		PcapLogModuleXdpDevice,          ///< XdpDevice module (Pcap++)
+		PcapLogModuleRssDispatcher,      ///< RssDispatcher module (Pcap++)
 		NetworkUtils,                    ///< NetworkUtils module (Pcap++)
 		NumOfLogModules
 	};
 
+	namespace internal
+	{
+		class AsyncLogBackend;
+
+		/// The rate limiting state of a single log call. Used internally by the logging macros
+		struct LogCallSite
+		{
+			std::atomic<int64_t> windowStart;
+			std::atomic<uint32_t> messagesInWindow;
+			std::atomic<uint32_t> suppressedMessages;
+
+			constexpr LogCallSite() : windowStart(0), messagesInWindow(0), suppressedMessages(0)
+			{}
+		};
+	}  // namespace internal
+
 	/// @class Logger
 	/// PcapPlusPlus logger manager.
 	/// PcapPlusPlus uses this logger to output both error and debug logs.
@@ -127,6 +175,14 @@ namespace pcpp
 	/// Logs are printed to console by default in a certain format. The user can set a different print function to
 	/// change the format or to print to other media (such as files, etc.).
 	///
+	/// By default logs are printed by the thread that logs them. Logger#enableAsyncLogging() moves printing to a
+	/// background thread, so threads that log bursts of errors (for example capture threads that see malformed
+	/// packets) only format the message and push it to a lock-free queue. Logger#setRateLimit() limits the number of
+	/// messages each log call prints per second.
+	///
+	/// Debug logs that are more verbose than PCPP_LOG_COMPILED_LEVEL are removed at compile time. PcapPlusPlus
+	/// libraries keep them only in Debug builds unless the PCAPPP_LOG_LEVEL CMake option says otherwise.
+	///
 	/// PcapPlusPlus logger is a singleton which can be reached from anywhere in the code.
 	///
 	/// Note: Logger#Info level logs are currently only used in DPDK devices to set DPDK log level to RTE_LOG_NOTICE.
@@ -162,7 +218,7 @@ namespace pcpp
 		/// @return The log level set for this module
 		LogLevel getLogLevel(LogModule module)
 		{
-			return m_LogModulesArray[module];
+			return m_LogModulesArray[module].load(std::memory_order_relaxed);
 		}
 
 		/// Set the log level for a certain PcapPlusPlus module
@@ -170,7 +226,7 @@ namespace pcpp
 		/// @param[in] level The log level to set the module to
 		void setLogLevel(LogModule module, LogLevel level)
 		{
-			m_LogModulesArray[module] = level;
+			m_LogModulesArray[module].store(level, std::memory_order_relaxed);
 		}
 
 		/// Check whether a certain module is set to debug log level
@@ -178,7 +234,7 @@ namespace pcpp
 		/// @return True if this module log level is "debug". False otherwise
 		bool isDebugEnabled(LogModule module) const
 		{
-			return m_LogModulesArray[module] == Debug;
+			return m_LogModulesArray[module].load(std::memory_order_relaxed) == Debug;
 		}
 
 		/// Set all PcapPlusPlus modules to a certain log level
@@ -186,45 +242,91 @@ namespace pcpp
 		void setAllModulesToLogLevel(LogLevel level)
 		{
 			for (int i = 1; i < NumOfLogModules; i++)
-				m_LogModulesArray[i] = level;
+				m_LogModulesArray[i].store(level, std::memory_order_relaxed);
 		}
 
 		/// Set a custom log printer.
 		/// @param[in] printer A log printer function that will be called for every log message
 		void setLogPrinter(LogPrinter printer)
 		{
-			m_LogPrinter = printer;
+			m_LogPrinter.store(printer);
 		}
 
 		/// Set the log printer back to the default printer
 		void resetLogPrinter()
 		{
-			m_LogPrinter = &defaultLogPrinter;
+			m_LogPrinter.store(&defaultLogPrinter);
 		}
 
 		/// @return Get the last error message
 		std::string getLastError()
 		{
+			std::lock_guard<std::mutex> lock(m_LastErrorMutex);
 			return m_LastError;
 		}
 
 		/// Suppress logs in all PcapPlusPlus modules
 		void suppressLogs()
 		{
-			m_LogsEnabled = false;
+			m_LogsEnabled.store(false, std::memory_order_relaxed);
 		}
 
 		/// Enable logs in all PcapPlusPlus modules
 		void enableLogs()
 		{
-			m_LogsEnabled = true;
+			m_LogsEnabled.store(true, std::memory_order_relaxed);
 		}
 
 		/// Get an indication if logs are currently enabled.
 		/// @return True if logs are currently enabled, false otherwise
 		bool logsEnabled() const
 		{
-			return m_LogsEnabled;
+			return m_LogsEnabled.load(std::memory_order_relaxed);
+		}
+
+		/// Print logs from a background thread. Each logging thread then only formats the message and pushes it to
+		/// a lock-free queue of its own, and the log printer is called by the background thread. If a queue is full
+		/// the message is dropped and counted by getNumOfDroppedLogMessages(). The last error message is still
+		/// updated by the logging thread.<BR>
+		/// This method and disableAsyncLogging() must not be called while other threads are logging
+		/// @param[in] queueCapacity The number of messages each logging thread can queue. It's rounded up to a power
+		/// of 2
+		void enableAsyncLogging(size_t queueCapacity = 1024);
+
+		/// Print all queued messages, stop the background thread and go back to printing logs from the thread that
+		/// logs them. Does nothing if async logging is disabled
+		void disableAsyncLogging();
+
+		/// @return True if logs are printed from a background thread
+		bool isAsyncLoggingEnabled() const
+		{
+			return m_AsyncBackend != nullptr;
+		}
+
+		/// Wait until all messages that were queued before this call are printed. Does nothing if async logging is
+		/// disabled. Must not be called from a log printer
+		void flushLogs();
+
+		/// @return The number of messages that were dropped because the queue of the logging thread was full
+		uint64_t getNumOfDroppedLogMessages() const
+		{
+			return m_DroppedLogMessages.load(std::memory_order_relaxed);
+		}
+
+		/// Limit the number of messages each log call prints per second. Messages above the limit aren't formatted
+		/// and don't update the last error message. The next message that the same log call prints says how many
+		/// messages were suppressed
+		/// @param[in] maxMessagesPerSecond The maximum number of messages per second of each log call, or 0 to
+		/// disable rate limiting (the default)
+		void setRateLimit(uint32_t maxMessagesPerSecond)
+		{
+			m_RateLimit.store(maxMessagesPerSecond, std::memory_order_relaxed);
+		}
+
+		/// @return The maximum number of messages per second of each log call, or 0 if rate limiting is disabled
+		uint32_t getRateLimit() const
+		{
+			return m_RateLimit.load(std::memory_order_relaxed);
 		}
 
 		template <class T> Logger& operator<<(const T& msg)
@@ -233,11 +335,12 @@ namespace pcpp
 			return *this;
 		}
 
-		std::ostringstream* internalCreateLogStream();
+		/// An internal method that applies the rate limit of a log call. Shouldn't be used externally.
+		bool internalCheckRateLimit(internal::LogCallSite& callSite, uint32_t& suppressedMessages);
 
 		/// An internal method to print log messages. Shouldn't be used externally.
-		void internalPrintLogMessage(std::ostringstream* logStream, Logger::LogLevel logLevel, const char* file,
-		                             const char* method, int line);
+		void internalPrintLogMessage(std::ostringstream& logStream, Logger::LogLevel logLevel, const char* file,
+		                             const char* method, int line, uint32_t suppressedMessages = 0);
 
 		/// Get access to Logger singleton
 		/// @todo: make this singleton thread-safe/
@@ -249,14 +352,19 @@ namespace pcpp
 		}
 
 	private:
-		bool m_LogsEnabled;
-		Logger::LogLevel m_LogModulesArray[NumOfLogModules];
-		LogPrinter m_LogPrinter;
+		std::atomic<bool> m_LogsEnabled;
+		std::atomic<Logger::LogLevel> m_LogModulesArray[NumOfLogModules];
+		std::atomic<LogPrinter> m_LogPrinter;
+		std::mutex m_LastErrorMutex;
 		std::string m_LastError;
 		std::ostringstream* m_LogStream;
+		std::atomic<uint32_t> m_RateLimit;
+		std::atomic<uint64_t> m_DroppedLogMessages;
+		std::unique_ptr<internal::AsyncLogBackend> m_AsyncBackend;
 
 		// private c'tor - this class is a singleton
 		Logger();
+		~Logger();
 
 		static void defaultLogPrinter(LogLevel logLevel, const std::string& logMessage, const std::string& file,
 		                              const std::string& method, const int line);
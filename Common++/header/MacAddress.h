@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #include <initializer_list>
 #include <iterator>
 #include <ostream>
@@ -8,6 +9,8 @@
 #include <string.h>
 #include <string>
 
+#include "GeneralUtils.h"
+
 /// @file
 
 /// @namespace pcpp
@@ -20,6 +23,9 @@ namespace pcpp
 	class MacAddress
 	{
 	public:
+		/// The length of the string representation of a MAC address
+		static constexpr size_t MaxStringLength = 17;
+
 		/// Default constructor for this class.
 		/// Initializes the address as 00:00:00:00:00:00.
 		MacAddress() = default;
@@ -118,6 +124,20 @@ namespace pcpp
 		/// @return A string representation of the address
 		std::string toString() const;
 
+		/// Write the string representation of the address to a buffer without allocating memory
+		/// @param[out] buffer The buffer to write to, the string is null-terminated
+		/// @param[in] bufferLen The buffer size, MaxStringLength + 1 is always enough
+		/// @return The string length, or 0 if the buffer is too small
+		size_t toString(char* buffer, size_t bufferLen) const;
+
+		/// @return A 64-bit hash of the address
+		uint64_t hash() const
+		{
+			uint64_t value = 0;
+			memcpy(&value, m_Address, sizeof(m_Address));
+			return hashMix64(value);
+		}
+
 		/// Allocates a byte array of length 6 and copies address value into it. Array deallocation is user
 		/// responsibility
 		/// @param[in] arr A pointer to where array will be allocated
@@ -148,3 +168,15 @@ namespace pcpp
 		return os;
 	}
 }  // namespace pcpp
+
+namespace std
+{
+	/// A std::hash specialization that allows using MacAddress as a key of unordered containers
+	template <> struct hash<pcpp::MacAddress>
+	{
+		size_t operator()(const pcpp::MacAddress& addr) const
+		{
+			return static_cast<size_t>(addr.hash());
+		}
+	};
+}  // namespace std
@@ -13,10 +13,15 @@ namespace pcpp
 {
 	/// @class OUILookup
 	/// Provides vendor name matching functionality from MAC addresses. It uses an internal database to define name of
-	/// the vendor. The class itself should be initialized by using initOUIDatabaseFromJson() otherwise all requests
-	/// will return "Unknown" as vendor. The class itself currently does not support on-fly modifying the database but
-	/// anyone who wants to add/modify/remove entries, should modify 3rdParty/OUILookup/PCPP_OUIDatabase.json file and
-	/// call to initOUIDatabaseFromJson() function to renew the internal data.
+	/// the vendor. The class itself should be initialized by using initOUIDatabaseFromJson() or
+	/// initOUIDatabaseFromBinary() otherwise all requests will return "Unknown" as vendor. The class itself currently
+	/// does not support on-fly modifying the database but anyone who wants to add/modify/remove entries, should modify
+	/// 3rdParty/OUIDataset/PCPP_OUIDataset.json file and call to initOUIDatabaseFromJson() function to renew the
+	/// internal data.
+	///
+	/// The binary database (3rdParty/OUIDataset/PCPP_OUIDataset.bin) is generated from the same data by
+	/// 3rdParty/OUIDataset/create_oui_data.py. It's memory-mapped as is, so loading it doesn't parse or copy anything
+	/// and lookups are binary searches in its sorted tables
 	class OUILookup
 	{
 	private:
@@ -39,21 +44,66 @@ namespace pcpp
 		/// formatted MAC address
 		typedef std::unordered_map<uint64_t, VendorData> OUIVendorMap;
 
+		/// The tables of a binary database, pointing into the mapped file (or a copy of it where files can't be
+		/// mapped)
+		struct BinaryDatabase
+		{
+			void* mappedData = nullptr;
+			size_t mappedLen = 0;
+			std::vector<uint8_t> buffer;
+			const uint8_t* ouiTable = nullptr;
+			uint32_t ouiCount = 0;
+			const uint8_t* groupTable = nullptr;
+			uint32_t groupCount = 0;
+			const uint8_t* maskedTable = nullptr;
+			uint32_t maskedCount = 0;
+			const char* stringPool = nullptr;
+			uint32_t stringPoolSize = 0;
+		};
+
 		/// Internal vendor list for MAC addresses
 		OUIVendorMap vendorMap;
 
+		/// Internal binary database, used instead of vendorMap when it's loaded
+		BinaryDatabase binaryDatabase;
+
 		template <typename T> int64_t internalParser(T& jsonData);
 
+		int64_t parseBinaryDatabase(const uint8_t* data, size_t dataLen);
+		void clearBinaryDatabase();
+		const char* findVendorNameInBinaryDatabase(uint64_t macAddr) const;
+
 	public:
+		OUILookup() = default;
+
+		OUILookup(const OUILookup&) = delete;
+		OUILookup& operator=(const OUILookup&) = delete;
+
+		~OUILookup();
+
 		/// Initialise internal OUI database from a JSON file
 		/// @param[in] path Path to OUI database. The database itself is located at
-		/// 3rdParty/OUILookup/PCPP_OUIDatabase.json
+		/// 3rdParty/OUIDataset/PCPP_OUIDataset.json
 		/// @return Returns the number of total vendors, negative on errors
 		int64_t initOUIDatabaseFromJson(const std::string& path = "");
 
+		/// Initialise internal OUI database from a binary file generated by create_oui_data.py. The file is
+		/// memory-mapped and stays mapped until the database is initialized again or the object is destroyed
+		/// @param[in] path Path to OUI database. The database itself is located at
+		/// 3rdParty/OUIDataset/PCPP_OUIDataset.bin
+		/// @return Returns the number of total vendors, negative on errors
+		int64_t initOUIDatabaseFromBinary(const std::string& path);
+
 		/// Returns the vendor of the MAC address. OUI database should be initialized with initOUIDatabaseFromJson()
+		/// or initOUIDatabaseFromBinary()
 		/// @param[in] addr MAC address to search
 		/// @return Vendor name
 		std::string getVendorName(const pcpp::MacAddress& addr);
+
+		/// Returns the vendor of the MAC address without allocating memory
+		/// @param[in] addr MAC address to search
+		/// @return A NUL-terminated vendor name owned by the database, or nullptr if the vendor is unknown. The
+		/// pointer is valid until the database is initialized again or the object is destroyed
+		const char* findVendorName(const pcpp::MacAddress& addr) const;
 	};
 }  // namespace pcpp
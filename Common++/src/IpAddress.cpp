@@ -20,6 +20,10 @@ namespace pcpp
 	const IPv4Address IPv4Address::Zero;
 	const IPv6Address IPv6Address::Zero;
 
+	constexpr size_t IPv4Address::MaxStringLength;
+	constexpr size_t IPv6Address::MaxStringLength;
+	constexpr size_t IPAddress::MaxStringLength;
+
 	const IPv4Address IPv4Address::MulticastRangeLowerBound("224.0.0.0");
 	const IPv4Address IPv4Address::MulticastRangeUpperBound("239.255.255.255");
 	const IPv6Address IPv6Address::MulticastRangeLowerBound("ff00:0000:0000:0000:0000:0000:0000:0000");
@@ -38,6 +42,31 @@ namespace pcpp
 		return std::string();
 	}
 
+	size_t IPv4Address::toString(char* buffer, size_t bufferLen) const
+	{
+		// formatted by hand, inet_ntop is several times slower for IPv4
+		char addrBuffer[MaxStringLength + 1];
+		size_t len = 0;
+		for (size_t i = 0; i < m_Bytes.size(); ++i)
+		{
+			uint8_t octet = m_Bytes[i];
+			if (octet >= 100)
+				addrBuffer[len++] = static_cast<char>('0' + octet / 100);
+			if (octet >= 10)
+				addrBuffer[len++] = static_cast<char>('0' + (octet / 10) % 10);
+			addrBuffer[len++] = static_cast<char>('0' + octet % 10);
+			if (i < m_Bytes.size() - 1)
+				addrBuffer[len++] = '.';
+		}
+
+		if (buffer == nullptr || bufferLen <= len)
+			return 0;
+
+		memcpy(buffer, addrBuffer, len);
+		buffer[len] = '\0';
+		return len;
+	}
+
 	bool IPv4Address::isMulticast() const
 	{
 		return !operator<(MulticastRangeLowerBound) &&
@@ -91,6 +120,20 @@ namespace pcpp
 		return std::string();
 	}
 
+	size_t IPv6Address::toString(char* buffer, size_t bufferLen) const
+	{
+		char addrBuffer[INET6_ADDRSTRLEN];
+		if (buffer == nullptr || inet_ntop(AF_INET6, toBytes(), addrBuffer, sizeof(addrBuffer)) == nullptr)
+			return 0;
+
+		size_t len = strlen(addrBuffer);
+		if (bufferLen <= len)
+			return 0;
+
+		memcpy(buffer, addrBuffer, len + 1);
+		return len;
+	}
+
 	bool IPv6Address::isMulticast() const
 	{
 		return !operator<(MulticastRangeLowerBound);
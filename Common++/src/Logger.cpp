@@ -1,16 +1,261 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <sstream>
+#include <thread>
+#include <vector>
 #include "Logger.h"
 
 namespace pcpp
 {
 
-	Logger::Logger() : m_LogsEnabled(true), m_LogPrinter(&defaultLogPrinter)
+	namespace internal
+	{
+		struct LogRecord
+		{
+			Logger::LogLevel level;
+			const char* file;
+			const char* method;
+			int line;
+			std::string message;
+		};
+
+		// A bounded single-producer single-consumer queue of log records. Each logging thread has its own queue, so
+		// pushing a record never waits for other logging threads or for the background thread
+		class LogRecordQueue
+		{
+		public:
+			explicit LogRecordQueue(size_t capacity) : m_Records(capacity), m_Head(0), m_Tail(0), m_Retired(false)
+			{}
+
+			bool push(LogRecord& record)
+			{
+				size_t tail = m_Tail.load(std::memory_order_relaxed);
+				if (tail - m_Head.load(std::memory_order_acquire) == m_Records.size())
+				{
+					return false;
+				}
+
+				m_Records[tail & (m_Records.size() - 1)] = std::move(record);
+				m_Tail.store(tail + 1, std::memory_order_release);
+				return true;
+			}
+
+			bool pop(LogRecord& record)
+			{
+				size_t head = m_Head.load(std::memory_order_relaxed);
+				if (head == m_Tail.load(std::memory_order_acquire))
+				{
+					return false;
+				}
+
+				record = std::move(m_Records[head & (m_Records.size() - 1)]);
+				m_Head.store(head + 1, std::memory_order_release);
+				return true;
+			}
+
+			// called by the producer when its thread exits. Nothing is pushed to a retired queue anymore, so once it
+			// is empty it can be removed
+			void retire()
+			{
+				m_Retired.store(true, std::memory_order_release);
+			}
+
+			bool isRetiredAndEmpty() const
+			{
+				return m_Retired.load(std::memory_order_acquire) &&
+				       m_Head.load(std::memory_order_relaxed) == m_Tail.load(std::memory_order_acquire);
+			}
+
+		private:
+			std::vector<LogRecord> m_Records;
+			std::atomic<size_t> m_Head;
+			std::atomic<size_t> m_Tail;
+			std::atomic<bool> m_Retired;
+		};
+
+		// Owns the per-thread queues and the background thread that drains them into the log printer
+		class AsyncLogBackend
+		{
+		public:
+			AsyncLogBackend(const std::atomic<Logger::LogPrinter>& logPrinter, size_t queueCapacity)
+			    : m_LogPrinter(logPrinter), m_QueueCapacity(queueCapacity), m_Id(++s_LastId), m_Stop(false),
+			      m_FlushRequested(0), m_FlushCompleted(0)
+			{
+				{
+					std::lock_guard<std::mutex> lock(s_LiveBackendMutex);
+					s_LiveBackendId = m_Id;
+				}
+				m_Worker = std::thread(&AsyncLogBackend::workerMain, this);
+			}
+
+			~AsyncLogBackend()
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_WorkerMutex);
+					m_Stop = true;
+				}
+				m_WorkerCond.notify_one();
+				m_Worker.join();
+
+				// the queues are freed after this point, so exiting threads must not retire them anymore
+				std::lock_guard<std::mutex> lock(s_LiveBackendMutex);
+				s_LiveBackendId = 0;
+			}
+
+			bool push(LogRecord& record)
+			{
+				ThreadQueue& threadQueue = getThreadQueue();
+				if (threadQueue.backendId != m_Id)
+				{
+					std::unique_ptr<LogRecordQueue> queue(new LogRecordQueue(m_QueueCapacity));
+					threadQueue.queue = queue.get();
+					threadQueue.backendId = m_Id;
+					std::lock_guard<std::mutex> lock(m_QueuesMutex);
+					m_Queues.push_back(std::move(queue));
+				}
+
+				return threadQueue.queue->push(record);
+			}
+
+			void flush()
+			{
+				std::unique_lock<std::mutex> lock(m_WorkerMutex);
+				uint64_t flushRequest = ++m_FlushRequested;
+				m_WorkerCond.notify_one();
+				m_FlushCond.wait(lock, [this, flushRequest] { return m_FlushCompleted >= flushRequest; });
+			}
+
+		private:
+			// the queue of the current thread. The backend id tells whether it belongs to this backend or to one
+			// that was already destroyed. When the thread exits the queue is retired, unless its backend is gone
+			struct ThreadQueue
+			{
+				uint64_t backendId = 0;
+				LogRecordQueue* queue = nullptr;
+
+				~ThreadQueue()
+				{
+					std::lock_guard<std::mutex> lock(s_LiveBackendMutex);
+					if (queue != nullptr && backendId == s_LiveBackendId)
+					{
+						queue->retire();
+					}
+				}
+			};
+
+			static ThreadQueue& getThreadQueue()
+			{
+				static thread_local ThreadQueue threadQueue;
+				return threadQueue;
+			}
+
+			void workerMain()
+			{
+				std::unique_lock<std::mutex> lock(m_WorkerMutex);
+				while (true)
+				{
+					// everything that was queued before the stop or flush request is printed by the drain below
+					uint64_t flushRequest = m_FlushRequested;
+					bool stop = m_Stop;
+					lock.unlock();
+					while (drainQueues() > 0)
+					{
+					}
+					lock.lock();
+
+					m_FlushCompleted = flushRequest;
+					m_FlushCond.notify_all();
+					if (stop)
+					{
+						break;
+					}
+
+					// logging threads don't notify the background thread, so it polls the queues
+					m_WorkerCond.wait_for(lock, std::chrono::milliseconds(10), [this, flushRequest] {
+						return m_Stop || m_FlushRequested != flushRequest;
+					});
+				}
+			}
+
+			size_t drainQueues()
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_QueuesMutex);
+					m_QueuesToDrain.clear();
+					for (const auto& queue : m_Queues)
+					{
+						m_QueuesToDrain.push_back(queue.get());
+					}
+				}
+
+				size_t numOfRecords = 0;
+				bool hasRetiredQueues = false;
+				LogRecord record;
+				for (auto queue : m_QueuesToDrain)
+				{
+					while (queue->pop(record))
+					{
+						m_LogPrinter.load()(record.level, record.message, record.file, record.method, record.line);
+						numOfRecords++;
+					}
+
+					hasRetiredQueues = hasRetiredQueues || queue->isRetiredAndEmpty();
+				}
+
+				// queues of threads that exited are removed once everything they hold was printed
+				if (hasRetiredQueues)
+				{
+					std::lock_guard<std::mutex> lock(m_QueuesMutex);
+					m_Queues.erase(std::remove_if(m_Queues.begin(), m_Queues.end(),
+					                              [](const std::unique_ptr<LogRecordQueue>& queue) {
+						                              return queue->isRetiredAndEmpty();
+					                              }),
+					               m_Queues.end());
+				}
+
+				return numOfRecords;
+			}
+
+			static std::atomic<uint64_t> s_LastId;
+			// the id of the backend whose queues may still be retired by exiting threads. Logger keeps at most one
+			// backend at a time
+			static std::mutex s_LiveBackendMutex;
+			static uint64_t s_LiveBackendId;
+
+			const std::atomic<Logger::LogPrinter>& m_LogPrinter;
+			size_t m_QueueCapacity;
+			uint64_t m_Id;
+
+			std::mutex m_QueuesMutex;
+			std::vector<std::unique_ptr<LogRecordQueue>> m_Queues;
+			std::vector<LogRecordQueue*> m_QueuesToDrain;
+
+			std::mutex m_WorkerMutex;
+			std::condition_variable m_WorkerCond;
+			std::condition_variable m_FlushCond;
+			bool m_Stop;
+			uint64_t m_FlushRequested;
+			uint64_t m_FlushCompleted;
+			std::thread m_Worker;
+		};
+
+		std::atomic<uint64_t> AsyncLogBackend::s_LastId(0);
+		std::mutex AsyncLogBackend::s_LiveBackendMutex;
+		uint64_t AsyncLogBackend::s_LiveBackendId = 0;
+	}  // namespace internal
+
+	Logger::Logger()
+	    : m_LogsEnabled(true), m_LogPrinter(&defaultLogPrinter), m_LogStream(nullptr), m_RateLimit(0),
+	      m_DroppedLogMessages(0)
 	{
 		m_LastError.reserve(200);
 		for (int i = 0; i < NumOfLogModules; i++)
-			m_LogModulesArray[i] = Info;
+			m_LogModulesArray[i].store(Info, std::memory_order_relaxed);
 	}
 
+	Logger::~Logger() = default;
+
 	std::string Logger::logLevelAsString(LogLevel logLevel)
 	{
 		switch (logLevel)
@@ -33,24 +278,91 @@ namespace pcpp
 		          << sstream.str() << "] " << logMessage << std::endl;
 	}
 
-	std::ostringstream* Logger::internalCreateLogStream()
+	void Logger::enableAsyncLogging(size_t queueCapacity)
+	{
+		disableAsyncLogging();
+
+		size_t roundedCapacity = 2;
+		while (roundedCapacity < queueCapacity)
+		{
+			roundedCapacity <<= 1;
+		}
+
+		m_AsyncBackend.reset(new internal::AsyncLogBackend(m_LogPrinter, roundedCapacity));
+	}
+
+	void Logger::disableAsyncLogging()
+	{
+		m_AsyncBackend.reset();
+	}
+
+	void Logger::flushLogs()
+	{
+		if (m_AsyncBackend != nullptr)
+		{
+			m_AsyncBackend->flush();
+		}
+	}
+
+	bool Logger::internalCheckRateLimit(internal::LogCallSite& callSite, uint32_t& suppressedMessages)
 	{
-		return new std::ostringstream();
+		uint32_t rateLimit = m_RateLimit.load(std::memory_order_relaxed);
+		if (rateLimit == 0)
+		{
+			return true;
+		}
+
+		int64_t now =
+		    std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch())
+		        .count();
+		int64_t windowStart = callSite.windowStart.load(std::memory_order_relaxed);
+		if (windowStart != now &&
+		    callSite.windowStart.compare_exchange_strong(windowStart, now, std::memory_order_relaxed))
+		{
+			callSite.messagesInWindow.store(0, std::memory_order_relaxed);
+		}
+
+		if (callSite.messagesInWindow.fetch_add(1, std::memory_order_relaxed) >= rateLimit)
+		{
+			callSite.suppressedMessages.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		suppressedMessages = callSite.suppressedMessages.exchange(0, std::memory_order_relaxed);
+		return true;
 	}
 
-	void Logger::internalPrintLogMessage(std::ostringstream* logStream, Logger::LogLevel logLevel, const char* file,
-	                                     const char* method, int line)
+	void Logger::internalPrintLogMessage(std::ostringstream& logStream, Logger::LogLevel logLevel, const char* file,
+	                                     const char* method, int line, uint32_t suppressedMessages)
 	{
-		std::string logMessage = logStream->str();
-		delete logStream;
+		if (suppressedMessages > 0)
+		{
+			logStream << " (" << suppressedMessages << " similar messages were suppressed)";
+		}
+
+		std::string logMessage = logStream.str();
 		if (logLevel == Logger::Error)
 		{
+			std::lock_guard<std::mutex> lock(m_LastErrorMutex);
 			m_LastError = logMessage;
 		}
-		if (m_LogsEnabled)
+
+		if (!logsEnabled())
+		{
+			return;
+		}
+
+		if (m_AsyncBackend != nullptr)
 		{
-			m_LogPrinter(logLevel, logMessage, file, method, line);
+			internal::LogRecord record = { logLevel, file, method, line, std::move(logMessage) };
+			if (!m_AsyncBackend->push(record))
+			{
+				m_DroppedLogMessages.fetch_add(1, std::memory_order_relaxed);
+			}
+			return;
 		}
+
+		m_LogPrinter.load()(logLevel, logMessage, file, method, line);
 	}
 
 }  // namespace pcpp
@@ -5,6 +5,8 @@ namespace pcpp
 
 	MacAddress MacAddress::Zero(0, 0, 0, 0, 0, 0);
 
+	constexpr size_t MacAddress::MaxStringLength;
+
 	std::string MacAddress::toString() const
 	{
 		char str[19];
@@ -13,6 +15,24 @@ namespace pcpp
 		return std::string(str);
 	}
 
+	size_t MacAddress::toString(char* buffer, size_t bufferLen) const
+	{
+		static const char hexDigits[] = "0123456789abcdef";
+
+		if (buffer == nullptr || bufferLen <= MaxStringLength)
+			return 0;
+
+		for (size_t i = 0; i < sizeof(m_Address); ++i)
+		{
+			buffer[i * 3] = hexDigits[m_Address[i] >> 4];
+			buffer[i * 3 + 1] = hexDigits[m_Address[i] & 0x0f];
+			buffer[i * 3 + 2] = ':';
+		}
+
+		buffer[MaxStringLength] = '\0';
+		return MaxStringLength;
+	}
+
 	MacAddress::MacAddress(const std::string& address)
 	{
 		constexpr size_t validMacAddressLength = 17;
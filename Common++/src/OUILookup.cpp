@@ -3,15 +3,124 @@
 
 #include "json.hpp"
 
+#include <cstring>
 #include <fstream>
+#include <iterator>
+#if !defined(_WIN32)
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
 
 namespace pcpp
 {
 
+	namespace
+	{
+		// The layout of the binary database, see write_binary_dataset() in create_oui_data.py
+		const char BinaryMagic[8] = { 'P', 'C', 'P', 'P', 'O', 'U', 'I', '\0' };
+		constexpr uint32_t BinaryVersion = 1;
+		constexpr size_t BinaryHeaderLen = 32;
+		constexpr size_t OUIEntryLen = 8;
+		constexpr size_t GroupEntryLen = 12;
+		constexpr size_t MaskedEntryLen = 16;
+
+		uint32_t readLE32(const uint8_t* data)
+		{
+			return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+			       (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+		}
+
+		uint64_t readLE64(const uint8_t* data)
+		{
+			return static_cast<uint64_t>(readLE32(data)) | (static_cast<uint64_t>(readLE32(data + 4)) << 32);
+		}
+
+		// binary search of a table sorted by its first uint32 field
+		const uint8_t* findEntry(const uint8_t* table, uint32_t count, size_t entryLen, uint32_t key)
+		{
+			uint32_t low = 0;
+			uint32_t high = count;
+			while (low < high)
+			{
+				uint32_t mid = low + (high - low) / 2;
+				uint32_t midKey = readLE32(table + mid * entryLen);
+				if (midKey == key)
+					return table + mid * entryLen;
+				if (midKey < key)
+					low = mid + 1;
+				else
+					high = mid;
+			}
+
+			return nullptr;
+		}
+
+		uint32_t getMask(const uint8_t* maskedEntries, uint32_t index)
+		{
+			return readLE32(maskedEntries + static_cast<size_t>(index) * MaskedEntryLen + 12);
+		}
+
+		// the masked entries of an OUI are sorted by mask, longest first, and by address. Each mask range is searched
+		// separately, so the longest matching prefix is found
+		const uint8_t* findMaskedEntry(const uint8_t* entries, uint32_t count, uint64_t macAddr)
+		{
+			uint32_t rangeStart = 0;
+			while (rangeStart < count)
+			{
+				uint32_t mask = getMask(entries, rangeStart);
+				uint32_t rangeEnd = rangeStart + 1;
+				while (rangeEnd < count && getMask(entries, rangeEnd) == mask)
+					++rangeEnd;
+
+				if (mask > 0 && mask <= 48)
+				{
+					uint64_t bufferAddr = macAddr & ~((static_cast<uint64_t>(1) << (48 - mask)) - 1);
+					uint32_t low = rangeStart;
+					uint32_t high = rangeEnd;
+					while (low < high)
+					{
+						uint32_t mid = low + (high - low) / 2;
+						const uint8_t* entry = entries + static_cast<size_t>(mid) * MaskedEntryLen;
+						uint64_t entryAddr = readLE64(entry);
+						if (entryAddr == bufferAddr)
+							return entry;
+
+						if (entryAddr < bufferAddr)
+							low = mid + 1;
+						else
+							high = mid;
+					}
+				}
+
+				rangeStart = rangeEnd;
+			}
+
+			return nullptr;
+		}
+
+		uint64_t macAddressToInt(const pcpp::MacAddress& addr)
+		{
+			uint8_t buffArray[6];
+			addr.copyTo(buffArray);
+
+			return (((uint64_t)((buffArray)[5]) << 0) + ((uint64_t)((buffArray)[4]) << 8) +
+			        ((uint64_t)((buffArray)[3]) << 16) + ((uint64_t)((buffArray)[2]) << 24) +
+			        ((uint64_t)((buffArray)[1]) << 32) + ((uint64_t)((buffArray)[0]) << 40));
+		}
+	}  // namespace
+
+	OUILookup::~OUILookup()
+	{
+		clearBinaryDatabase();
+	}
+
 	template <typename T> int64_t OUILookup::internalParser(T& jsonData)
 	{
 		// Clear all entries before adding
 		vendorMap.clear();
+		clearBinaryDatabase();
 
 		int64_t ctrRead = 0;
 		nlohmann::json parsedJson = nlohmann::json::parse(jsonData);
@@ -78,22 +187,141 @@ namespace pcpp
 		return internalParser(dataFile);
 	}
 
-	std::string OUILookup::getVendorName(const pcpp::MacAddress& addr)
+	int64_t OUILookup::initOUIDatabaseFromBinary(const std::string& path)
 	{
-		if (vendorMap.empty())
-			PCPP_LOG_DEBUG("Vendor map is empty");
+		vendorMap.clear();
+		clearBinaryDatabase();
+
+#if !defined(_WIN32)
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+		{
+			PCPP_LOG_ERROR(std::string("Can't open OUI database: ") + strerror(errno));
+			return -1;
+		}
+
+		struct stat fileStat;
+		if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) || fileStat.st_size == 0)
+		{
+			::close(fd);
+			PCPP_LOG_ERROR("OUI database isn't a regular file or is empty");
+			return -1;
+		}
+
+		size_t dataLen = static_cast<size_t>(fileStat.st_size);
+		void* data = mmap(nullptr, dataLen, PROT_READ, MAP_PRIVATE, fd, 0);
+		// the mapping stays valid after the descriptor is closed
+		::close(fd);
+		if (data == MAP_FAILED)
+		{
+			PCPP_LOG_ERROR(std::string("Can't map OUI database: ") + strerror(errno));
+			return -1;
+		}
+
+		binaryDatabase.mappedData = data;
+		binaryDatabase.mappedLen = dataLen;
+		return parseBinaryDatabase(static_cast<const uint8_t*>(data), dataLen);
+#else
+		std::ifstream dataFile(path, std::ios::binary);
+		if (!dataFile.is_open())
+		{
+			PCPP_LOG_ERROR(std::string("Can't open OUI database: ") + strerror(errno));
+			return -1;
+		}
+
+		binaryDatabase.buffer.assign(std::istreambuf_iterator<char>(dataFile), std::istreambuf_iterator<char>());
+		return parseBinaryDatabase(binaryDatabase.buffer.data(), binaryDatabase.buffer.size());
+#endif
+	}
+
+	int64_t OUILookup::parseBinaryDatabase(const uint8_t* data, size_t dataLen)
+	{
+		if (dataLen < BinaryHeaderLen || memcmp(data, BinaryMagic, sizeof(BinaryMagic)) != 0 ||
+		    readLE32(data + 8) != BinaryVersion)
+		{
+			PCPP_LOG_ERROR("OUI database isn't a binary OUI database or its version isn't supported");
+			clearBinaryDatabase();
+			return -1;
+		}
+
+		uint32_t ouiCount = readLE32(data + 12);
+		uint32_t groupCount = readLE32(data + 16);
+		uint32_t maskedCount = readLE32(data + 20);
+		uint32_t stringPoolSize = readLE32(data + 24);
+
+		size_t groupTableOffset = BinaryHeaderLen + static_cast<size_t>(ouiCount) * OUIEntryLen;
+		size_t maskedTableOffset = groupTableOffset + static_cast<size_t>(groupCount) * GroupEntryLen;
+		size_t stringPoolOffset = maskedTableOffset + static_cast<size_t>(maskedCount) * MaskedEntryLen;
+		// every string in the pool ends with NUL, so any offset into the pool is a valid string
+		if (stringPoolOffset + stringPoolSize != dataLen || stringPoolSize == 0 || data[dataLen - 1] != 0)
+		{
+			PCPP_LOG_ERROR("OUI database is truncated or corrupted");
+			clearBinaryDatabase();
+			return -1;
+		}
+
+		binaryDatabase.ouiTable = data + BinaryHeaderLen;
+		binaryDatabase.ouiCount = ouiCount;
+		binaryDatabase.groupTable = data + groupTableOffset;
+		binaryDatabase.groupCount = groupCount;
+		binaryDatabase.maskedTable = data + maskedTableOffset;
+		binaryDatabase.maskedCount = maskedCount;
+		binaryDatabase.stringPool = reinterpret_cast<const char*>(data + stringPoolOffset);
+		binaryDatabase.stringPoolSize = stringPoolSize;
+
+		int64_t ctrRead = static_cast<int64_t>(ouiCount) + maskedCount;
+		PCPP_LOG_DEBUG(std::to_string(ctrRead) + " vendors read successfully");
+		return ctrRead;
+	}
 
-		// Get MAC address
-		uint8_t buffArray[6];
-		addr.copyTo(buffArray);
+	void OUILookup::clearBinaryDatabase()
+	{
+#if !defined(_WIN32)
+		if (binaryDatabase.mappedData != nullptr)
+			munmap(binaryDatabase.mappedData, binaryDatabase.mappedLen);
+#endif
+		binaryDatabase = BinaryDatabase();
+	}
 
-		uint64_t macAddr = (((uint64_t)((buffArray)[5]) << 0) + ((uint64_t)((buffArray)[4]) << 8) +
-		                    ((uint64_t)((buffArray)[3]) << 16) + ((uint64_t)((buffArray)[2]) << 24) +
-		                    ((uint64_t)((buffArray)[1]) << 32) + ((uint64_t)((buffArray)[0]) << 40));
+	const char* OUILookup::findVendorNameInBinaryDatabase(uint64_t macAddr) const
+	{
+		const BinaryDatabase& db = binaryDatabase;
+		uint32_t oui = static_cast<uint32_t>(macAddr >> 24);
+		const uint8_t* ouiEntry = findEntry(db.ouiTable, db.ouiCount, OUIEntryLen, oui);
+		if (ouiEntry == nullptr)
+			return nullptr;
+
+		const uint8_t* groupEntry = findEntry(db.groupTable, db.groupCount, GroupEntryLen, oui);
+		if (groupEntry != nullptr)
+		{
+			uint32_t first = readLE32(groupEntry + 4);
+			uint32_t count = readLE32(groupEntry + 8);
+			if (first <= db.maskedCount && count <= db.maskedCount - first)
+			{
+				const uint8_t* entry =
+				    findMaskedEntry(db.maskedTable + static_cast<size_t>(first) * MaskedEntryLen, count, macAddr);
+				if (entry != nullptr)
+				{
+					uint32_t vendorOffset = readLE32(entry + 8);
+					return vendorOffset < db.stringPoolSize ? db.stringPool + vendorOffset : nullptr;
+				}
+			}
+		}
+
+		uint32_t vendorOffset = readLE32(ouiEntry + 4);
+		return vendorOffset < db.stringPoolSize ? db.stringPool + vendorOffset : nullptr;
+	}
+
+	const char* OUILookup::findVendorName(const pcpp::MacAddress& addr) const
+	{
+		uint64_t macAddr = macAddressToInt(addr);
+
+		if (binaryDatabase.stringPool != nullptr)
+			return findVendorNameInBinaryDatabase(macAddr);
 
 		auto itr = vendorMap.find(macAddr >> 24);
 		if (itr == vendorMap.end())
-			return "Unknown";
+			return nullptr;
 
 		for (const auto& entry : itr->second.maskedFilter)
 		{
@@ -102,10 +330,22 @@ namespace pcpp
 
 			auto subItr = entry.vendorMap.find(bufferAddr);
 			if (subItr != entry.vendorMap.end())
-				return subItr->second;
+				return subItr->second.c_str();
 		}
 
-		return itr->second.vendorName;
+		return itr->second.vendorName.c_str();
+	}
+
+	std::string OUILookup::getVendorName(const pcpp::MacAddress& addr)
+	{
+		if (vendorMap.empty() && binaryDatabase.stringPool == nullptr)
+			PCPP_LOG_DEBUG("Vendor map is empty");
+
+		const char* vendorName = findVendorName(addr);
+		if (vendorName == nullptr)
+			return "Unknown";
+
+		return vendorName;
 	}
 
 }  // namespace pcpp
@@ -8,7 +8,7 @@
 #include "TcpLayer.h"
 #include "IPv4Layer.h"
 #include "PayloadLayer.h"
-#include "PacketUtils.h"
+#include "FlowTable.h"
 #include "SystemUtils.h"
 
 /**
@@ -156,7 +156,7 @@ public:
 	/**
 	 * C'tor - clear all structures
 	 */
-	explicit HttpStatsCollector(uint16_t dstPort)
+	explicit HttpStatsCollector(uint16_t dstPort) : m_FlowTable(MaxNumOfFlows, FlowIdleTimeoutSec)
 	{
 		clear();
 		m_DstPort = dstPort;
@@ -177,14 +177,16 @@ public:
 			return;
 
 		// collect general HTTP traffic stats on this packet
-		uint32_t hashVal = collectHttpTrafficStats(httpPacket);
+		HttpFlowData* flowData = collectHttpTrafficStats(httpPacket);
+		if (flowData == nullptr)
+			return;
 
 		// if packet is an HTTP request - collect HTTP request stats on this packet
 		if (httpPacket->isPacketOfType(pcpp::HTTPRequest))
 		{
 			pcpp::HttpRequestLayer* req = httpPacket->getLayerOfType<pcpp::HttpRequestLayer>();
 			pcpp::TcpLayer* tcpLayer1 = httpPacket->getLayerOfType<pcpp::TcpLayer>();
-			collectHttpGeneralStats(tcpLayer1, req, hashVal);
+			collectHttpGeneralStats(tcpLayer1, req, *flowData);
 			collectRequestStats(req);
 		}
 		// if packet is an HTTP response - collect HTTP response stats on this packet
@@ -192,7 +194,7 @@ public:
 		{
 			pcpp::HttpResponseLayer* res = httpPacket->getLayerOfType<pcpp::HttpResponseLayer>();
 			pcpp::TcpLayer* tcpLayer1 = httpPacket->getLayerOfType<pcpp::TcpLayer>();
-			collectHttpGeneralStats(tcpLayer1, res, hashVal);
+			collectHttpGeneralStats(tcpLayer1, res, *flowData);
 			collectResponseStats(res);
 		}
 
@@ -320,9 +322,9 @@ private:
 
 	/**
 	 * Collect stats relevant for every HTTP packet (request, response or any other)
-	 * This method calculates and returns the flow key for this packet
+	 * This method finds and returns the flow data of this packet
 	 */
-	uint32_t collectHttpTrafficStats(pcpp::Packet* httpPacket)
+	HttpFlowData* collectHttpTrafficStats(pcpp::Packet* httpPacket)
 	{
 		pcpp::TcpLayer* tcpLayer = httpPacket->getLayerOfType<pcpp::TcpLayer>();
 
@@ -332,99 +334,103 @@ private:
 		// count packet num
 		m_GeneralStats.numOfHttpPackets++;
 
-		// calculate a hash key for this flow to be used in the flow table
-		uint32_t hashVal = pcpp::hash5Tuple(httpPacket);
+		// find the flow of this packet in the flow table or create it
+		bool isNewFlow = false;
+		HttpFlowData* flowData = m_FlowTable.getOrCreateFlow(*httpPacket, &isNewFlow);
+		if (flowData == nullptr)
+			return nullptr;
 
-		// if flow is a new flow (meaning it's not already in the flow table)
-		if (m_FlowTable.find(hashVal) == m_FlowTable.end())
+		// if flow is a new flow (meaning it wasn't already in the flow table)
+		if (isNewFlow)
 		{
 			// count this new flow
 			m_GeneralStats.numOfHttpFlows++;
-			m_FlowTable[hashVal].clear();
+			flowData->clear();
 		}
 
-		// calculate averages
-		if (m_FlowTable.size() != 0)
+		// calculate averages. Idle flows are evicted from the flow table so the averages are calculated over all
+		// flows seen so far
+		if (m_GeneralStats.numOfHttpFlows != 0)
 		{
-			m_GeneralStats.averageAmountOfDataPerFlow =
-			    static_cast<double>(m_GeneralStats.amountOfHttpTraffic) / static_cast<double>(m_FlowTable.size());
-			m_GeneralStats.averageNumOfPacketsPerFlow =
-			    static_cast<double>(m_GeneralStats.numOfHttpPackets) / static_cast<double>(m_FlowTable.size());
+			m_GeneralStats.averageAmountOfDataPerFlow = static_cast<double>(m_GeneralStats.amountOfHttpTraffic) /
+			                                            static_cast<double>(m_GeneralStats.numOfHttpFlows);
+			m_GeneralStats.averageNumOfPacketsPerFlow = static_cast<double>(m_GeneralStats.numOfHttpPackets) /
+			                                            static_cast<double>(m_GeneralStats.numOfHttpFlows);
 		}
 
-		return hashVal;
+		return flowData;
 	}
 
 	/**
 	 * Collect stats relevant for HTTP messages (requests or responses)
 	 */
-	void collectHttpGeneralStats(pcpp::TcpLayer* tcpLayer, pcpp::HttpMessage* message, uint32_t flowKey)
+	void collectHttpGeneralStats(pcpp::TcpLayer* tcpLayer, pcpp::HttpMessage* message, HttpFlowData& flowData)
 	{
 		// if num of current opened transaction is negative it means something went completely wrong
-		if (m_FlowTable[flowKey].numOfOpenTransactions < 0)
+		if (flowData.numOfOpenTransactions < 0)
 			return;
 
 		if (message->getProtocol() == pcpp::HTTPRequest)
 		{
 			// if new packet seq number is smaller than previous seen seq number current it means this packet is
 			// a re-transmitted packet and should be ignored
-			if (m_FlowTable[flowKey].curSeqNumberRequests >=
+			if (flowData.curSeqNumberRequests >=
 			    pcpp::netToHost32(tcpLayer->getTcpHeader()->sequenceNumber))
 				return;
 
 			// a new request - increase num of open transactions
-			m_FlowTable[flowKey].numOfOpenTransactions++;
+			flowData.numOfOpenTransactions++;
 
 			// if the previous message seen on this flow is HTTP request and if flow is not already marked as HTTP
 			// pipelining - mark it as so and increase number of HTTP pipelining flows
-			if (!m_FlowTable[flowKey].httpPipeliningFlow && m_FlowTable[flowKey].lastSeenMessage == pcpp::HTTPRequest)
+			if (!flowData.httpPipeliningFlow && flowData.lastSeenMessage == pcpp::HTTPRequest)
 			{
-				m_FlowTable[flowKey].httpPipeliningFlow = true;
+				flowData.httpPipeliningFlow = true;
 				m_GeneralStats.numOfHttpPipeliningFlows++;
 			}
 
 			// set last seen message on flow as HTTP request
-			m_FlowTable[flowKey].lastSeenMessage = pcpp::HTTPRequest;
+			flowData.lastSeenMessage = pcpp::HTTPRequest;
 
 			// set last seen sequence number
-			m_FlowTable[flowKey].curSeqNumberRequests = pcpp::netToHost32(tcpLayer->getTcpHeader()->sequenceNumber);
+			flowData.curSeqNumberRequests = pcpp::netToHost32(tcpLayer->getTcpHeader()->sequenceNumber);
 		}
 		else if (message->getProtocol() == pcpp::HTTPResponse)
 		{
 			// if new packet seq number is smaller than previous seen seq number current it means this packet is
 			// a re-transmitted packet and should be ignored
-			if (m_FlowTable[flowKey].curSeqNumberResponses >=
+			if (flowData.curSeqNumberResponses >=
 			    pcpp::netToHost32(tcpLayer->getTcpHeader()->sequenceNumber))
 				return;
 
 			// a response - decrease num of open transactions
-			m_FlowTable[flowKey].numOfOpenTransactions--;
+			flowData.numOfOpenTransactions--;
 
 			// if the previous message seen on this flow is HTTP response and if flow is not already marked as HTTP
 			// pipelining - mark it as so and increase number of HTTP pipelining flows
-			if (!m_FlowTable[flowKey].httpPipeliningFlow && m_FlowTable[flowKey].lastSeenMessage == pcpp::HTTPResponse)
+			if (!flowData.httpPipeliningFlow && flowData.lastSeenMessage == pcpp::HTTPResponse)
 			{
-				m_FlowTable[flowKey].httpPipeliningFlow = true;
+				flowData.httpPipeliningFlow = true;
 				m_GeneralStats.numOfHttpPipeliningFlows++;
 			}
 
 			// set last seen message on flow as HTTP response
-			m_FlowTable[flowKey].lastSeenMessage = pcpp::HTTPResponse;
+			flowData.lastSeenMessage = pcpp::HTTPResponse;
 
-			if (m_FlowTable[flowKey].numOfOpenTransactions >= 0)
+			if (flowData.numOfOpenTransactions >= 0)
 			{
 				// a transaction was closed - increase number of complete transactions
 				m_GeneralStats.numOfHttpTransactions++;
 
 				// calc average transactions per flow
-				if (m_FlowTable.size() != 0)
+				if (m_GeneralStats.numOfHttpFlows != 0)
 					m_GeneralStats.averageNumOfHttpTransactionsPerFlow =
 					    static_cast<double>(m_GeneralStats.numOfHttpTransactions) /
-					    static_cast<double>(m_FlowTable.size());
+					    static_cast<double>(m_GeneralStats.numOfHttpFlows);
 			}
 
 			// set last seen sequence number
-			m_FlowTable[flowKey].curSeqNumberResponses = pcpp::netToHost32(tcpLayer->getTcpHeader()->sequenceNumber);
+			flowData.curSeqNumberResponses = pcpp::netToHost32(tcpLayer->getTcpHeader()->sequenceNumber);
 		}
 	}
 
@@ -509,7 +515,11 @@ private:
 	HttpResponseStats m_ResponseStats;
 	HttpResponseStats m_PrevResponseStats;
 
-	std::unordered_map<uint32_t, HttpFlowData> m_FlowTable;
+	// the maximum number of concurrent flows and the time after which a flow with no packets is forgotten
+	static constexpr size_t MaxNumOfFlows = 200000;
+	static constexpr uint32_t FlowIdleTimeoutSec = 600;
+
+	pcpp::FlowTable<HttpFlowData> m_FlowTable;
 
 	double m_LastCalcRateTime;
 	double m_StartTime;
@@ -0,0 +1,240 @@
+#include "BenchmarkUtils.h"
+
+#include <PcapPlusPlusVersion.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+#if defined(__linux__)
+#	include <linux/perf_event.h>
+#	include <sys/ioctl.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#endif
+
+// Every heap allocation of the benchmark process goes through these replacements of the global operator new, so the
+// benchmarks can report allocations per packet
+static std::atomic<uint64_t> numOfAllocations(0);
+
+void* operator new(std::size_t size)
+{
+	numOfAllocations.fetch_add(1, std::memory_order_relaxed);
+	void* ptr = std::malloc(size == 0 ? 1 : size);
+	if (ptr == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	numOfAllocations.fetch_add(1, std::memory_order_relaxed);
+	return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+	return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+PacketCounters::PacketCounters() : m_StartAllocations(0), m_PerfEventFd(-1)
+{
+#if defined(__linux__)
+	perf_event_attr attr = {};
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.size = sizeof(attr);
+	attr.config = PERF_COUNT_HW_CACHE_MISSES;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	// count the calling thread on any CPU. This fails in most containers and VMs, then no cache misses are reported
+	m_PerfEventFd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+	if (m_PerfEventFd >= 0)
+	{
+		ioctl(m_PerfEventFd, PERF_EVENT_IOC_RESET, 0);
+		ioctl(m_PerfEventFd, PERF_EVENT_IOC_ENABLE, 0);
+	}
+#endif
+	m_StartAllocations = numOfAllocations.load(std::memory_order_relaxed);
+}
+
+PacketCounters::~PacketCounters()
+{
+#if defined(__linux__)
+	if (m_PerfEventFd >= 0)
+	{
+		close(m_PerfEventFd);
+	}
+#endif
+}
+
+void PacketCounters::report(benchmark::State& state, size_t numOfPackets, size_t numOfBytes)
+{
+	uint64_t allocations = numOfAllocations.load(std::memory_order_relaxed) - m_StartAllocations;
+
+	state.SetItemsProcessed(static_cast<int64_t>(numOfPackets));
+	state.SetBytesProcessed(static_cast<int64_t>(numOfBytes));
+	if (numOfPackets == 0)
+	{
+		return;
+	}
+
+	state.counters["allocs/pkt"] = static_cast<double>(allocations) / numOfPackets;
+
+#if defined(__linux__)
+	if (m_PerfEventFd >= 0)
+	{
+		ioctl(m_PerfEventFd, PERF_EVENT_IOC_DISABLE, 0);
+		uint64_t cacheMisses = 0;
+		if (read(m_PerfEventFd, &cacheMisses, sizeof(cacheMisses)) == sizeof(cacheMisses))
+		{
+			state.counters["cache-misses/pkt"] = static_cast<double>(cacheMisses) / numOfPackets;
+		}
+	}
+#endif
+}
+
+void BaselineReporter::ReportRuns(const std::vector<Run>& runs)
+{
+	benchmark::ConsoleReporter::ReportRuns(runs);
+
+	// skipped benchmarks have no items_per_second counter
+	for (const auto& run : runs)
+	{
+		auto itemsPerSecond = run.counters.find("items_per_second");
+		if (run.run_type == Run::RT_Iteration && run.iterations > 0 && itemsPerSecond != run.counters.end())
+		{
+			m_ItemsPerSecond[run.benchmark_name()] = itemsPerSecond->second.value;
+		}
+	}
+}
+
+bool BaselineReporter::saveBaseline(const std::string& fileName) const
+{
+	std::ofstream file(fileName);
+	if (!file)
+	{
+		return false;
+	}
+
+	file << "{" << std::endl
+	     << "  \"context\": {" << std::endl
+	     << "    \"pcapplusplus_version\": \"" << pcpp::getPcapPlusPlusVersionFull() << "\"" << std::endl
+	     << "  }," << std::endl
+	     << "  \"benchmarks\": [";
+	bool first = true;
+	for (const auto& result : m_ItemsPerSecond)
+	{
+		file << (first ? "" : ",") << std::endl
+		     << "    {\"name\": \"" << result.first << "\", \"items_per_second\": " << std::setprecision(10)
+		     << result.second << "}";
+		first = false;
+	}
+	file << std::endl << "  ]" << std::endl << "}" << std::endl;
+	return file.good();
+}
+
+namespace
+{
+	// Read the name and items_per_second of every benchmark from a JSON baseline. Both this reporter and Google
+	// Benchmark write one object per benchmark with these keys, so a simple scan is enough
+	std::map<std::string, double> readBaseline(const std::string& content)
+	{
+		const std::string nameKey = "\"name\":";
+		const std::string itemsPerSecondKey = "\"items_per_second\":";
+
+		std::map<std::string, double> result;
+		size_t namePos = content.find(nameKey);
+		while (namePos != std::string::npos)
+		{
+			size_t nameStart = content.find('"', namePos + nameKey.size());
+			size_t nameEnd = nameStart == std::string::npos ? std::string::npos : content.find('"', nameStart + 1);
+			if (nameEnd == std::string::npos)
+			{
+				break;
+			}
+
+			size_t nextNamePos = content.find(nameKey, nameEnd);
+			size_t valuePos = content.find(itemsPerSecondKey, nameEnd);
+			if (valuePos != std::string::npos && valuePos < nextNamePos)
+			{
+				result[content.substr(nameStart + 1, nameEnd - nameStart - 1)] =
+				    std::strtod(content.c_str() + valuePos + itemsPerSecondKey.size(), nullptr);
+			}
+			namePos = nextNamePos;
+		}
+
+		return result;
+	}
+}  // namespace
+
+bool BaselineReporter::compareWithBaseline(const std::string& fileName, double maxRegressionPercent) const
+{
+	std::ifstream file(fileName);
+	if (!file)
+	{
+		std::cerr << "Cannot read baseline file " << fileName << std::endl;
+		return false;
+	}
+
+	std::stringstream content;
+	content << file.rdbuf();
+	std::map<std::string, double> baseline = readBaseline(content.str());
+
+	bool regressed = false;
+	std::cout << std::endl
+	          << std::left << std::setw(50) << "Benchmark" << std::right << std::setw(15) << "Baseline pkt/s"
+	          << std::setw(15) << "Current pkt/s" << std::setw(10) << "Change" << std::endl;
+	for (const auto& result : m_ItemsPerSecond)
+	{
+		auto baselineResult = baseline.find(result.first);
+		if (baselineResult == baseline.end() || baselineResult->second <= 0)
+		{
+			continue;
+		}
+
+		double changePercent = (result.second / baselineResult->second - 1) * 100;
+		bool isRegression = changePercent < -maxRegressionPercent;
+		regressed = regressed || isRegression;
+		std::cout << std::left << std::setw(50) << result.first << std::right << std::fixed << std::setprecision(0)
+		          << std::setw(15) << baselineResult->second << std::setw(15) << result.second << std::showpos
+		          << std::setprecision(1) << std::setw(9) << changePercent << "%" << std::noshowpos
+		          << (isRegression ? "  REGRESSION" : "") << std::endl;
+	}
+	std::cout.unsetf(std::ios::floatfield);
+	std::cout << std::setprecision(6);
+
+	return !regressed;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Measures the heap allocations and, where perf_event_open() is available, the CPU cache misses of the current
+ * thread from its creation until report() is called
+ */
+class PacketCounters
+{
+public:
+	PacketCounters();
+	~PacketCounters();
+
+	PacketCounters(const PacketCounters&) = delete;
+	PacketCounters& operator=(const PacketCounters&) = delete;
+
+	/**
+	 * Set packets/s, bytes/s, allocations per packet and cache misses per packet of a benchmark
+	 * @param[in] state The benchmark state
+	 * @param[in] numOfPackets The number of packets processed by the benchmark
+	 * @param[in] numOfBytes The number of bytes processed by the benchmark
+	 */
+	void report(benchmark::State& state, size_t numOfPackets, size_t numOfBytes);
+
+private:
+	uint64_t m_StartAllocations;
+	int m_PerfEventFd;
+};
+
+/**
+ * A console reporter that also keeps the packets/s result of every benchmark, so they can be saved as a baseline or
+ * compared with one
+ */
+class BaselineReporter : public benchmark::ConsoleReporter
+{
+public:
+	void ReportRuns(const std::vector<Run>& runs) override;
+
+	/**
+	 * Save the results as a JSON baseline file
+	 * @param[in] fileName The file to write
+	 * @return False if the file can't be written
+	 */
+	bool saveBaseline(const std::string& fileName) const;
+
+	/**
+	 * Compare the results with a baseline file and print the change of every benchmark. The baseline can be a file
+	 * written by saveBaseline() or the JSON output of Google Benchmark (--benchmark_out)
+	 * @param[in] fileName The baseline file
+	 * @param[in] maxRegressionPercent The largest drop in packets/s that isn't considered a regression
+	 * @return False if the file can't be read or a benchmark regressed
+	 */
+	bool compareWithBaseline(const std::string& fileName, double maxRegressionPercent) const;
+
+private:
+	std::map<std::string, double> m_ItemsPerSecond;
+};
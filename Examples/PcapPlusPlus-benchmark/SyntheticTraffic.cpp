@@ -0,0 +1,592 @@
+#include "SyntheticTraffic.h"
+
+#include <DnsLayer.h>
+#include <EthLayer.h>
+#include <GreLayer.h>
+#include <GtpLayer.h>
+#include <HttpLayer.h>
+#include <IPv4Layer.h>
+#include <IPv6Extensions.h>
+#include <IPv6Layer.h>
+#include <Packet.h>
+#include <PayloadLayer.h>
+#include <SystemUtils.h>
+#include <TcpLayer.h>
+#include <UdpLayer.h>
+#include <VxlanLayer.h>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <string>
+
+namespace
+{
+	// the ports of the plain TCP flows and UDP datagrams are out of the ranges of the built-in dissectors, so their
+	// payload is parsed as PayloadLayer
+	const uint16_t PlainPortMin = 20000;
+	const uint16_t PlainPortMax = 29999;
+
+	const size_t IPv4FragmentSize = 1480;
+	const size_t IPv6FragmentSize = 1448;
+
+	struct TcpSegment
+	{
+		bool fromClient;
+		uint8_t flags;
+		uint32_t seq;
+		uint32_t ack;
+		size_t payloadLen;
+	};
+
+	enum TcpFlags : uint8_t
+	{
+		TcpFin = 0x01,
+		TcpSyn = 0x02,
+		TcpPsh = 0x08,
+		TcpAck = 0x10
+	};
+
+	/**
+	 * Generates packets from a seeded Mersenne Twister. Only the raw 32-bit output of the engine is used, as it's
+	 * the same on all platforms while the standard distributions aren't
+	 */
+	class TrafficGenerator
+	{
+	public:
+		TrafficGenerator(uint32_t seed) : m_Random(seed), m_TimestampUsec(1700000000ULL * 1000000)
+		{}
+
+		void generate(TrafficProfile profile, size_t numOfPackets, std::vector<pcpp::RawPacket>& packets)
+		{
+			while (packets.size() < numOfPackets)
+			{
+				generateOne(profile, packets);
+			}
+		}
+
+	private:
+		std::mt19937 m_Random;
+		uint64_t m_TimestampUsec;
+
+		void generateOne(TrafficProfile profile, std::vector<pcpp::RawPacket>& packets)
+		{
+			switch (profile)
+			{
+			case TrafficProfile::IPv4Tcp:
+				generateTcpFlow(false, packets);
+				break;
+			case TrafficProfile::IPv6Udp:
+				generateIPv6Udp(packets);
+				break;
+			case TrafficProfile::Tunnels:
+				generateTunnel(packets);
+				break;
+			case TrafficProfile::Http:
+				generateHttp(packets);
+				break;
+			case TrafficProfile::Tls:
+				generateTls(packets);
+				break;
+			case TrafficProfile::Dns:
+				generateDns(packets);
+				break;
+			case TrafficProfile::Fragments:
+				generateFragments(packets);
+				break;
+			case TrafficProfile::TcpOutOfOrder:
+				generateTcpFlow(true, packets);
+				break;
+			case TrafficProfile::Mixed:
+				generateOne(static_cast<TrafficProfile>(random(0, static_cast<uint32_t>(TrafficProfile::Mixed) - 1)),
+				            packets);
+				break;
+			}
+		}
+
+		uint32_t random(uint32_t min, uint32_t max)
+		{
+			return min + static_cast<uint32_t>(m_Random() % (static_cast<uint64_t>(max) - min + 1));
+		}
+
+		bool chance(uint32_t oneIn)
+		{
+			return random(1, oneIn) == 1;
+		}
+
+		pcpp::MacAddress randomMac()
+		{
+			return pcpp::MacAddress(0x00, 0x1b, static_cast<uint8_t>(random(0, 255)),
+			                        static_cast<uint8_t>(random(0, 255)), static_cast<uint8_t>(random(0, 255)),
+			                        static_cast<uint8_t>(random(0, 255)));
+		}
+
+		pcpp::IPv4Address randomIPv4()
+		{
+			std::array<uint8_t, 4> bytes = { 10, static_cast<uint8_t>(random(0, 255)),
+				                             static_cast<uint8_t>(random(0, 255)),
+				                             static_cast<uint8_t>(random(1, 254)) };
+			return pcpp::IPv4Address(bytes);
+		}
+
+		pcpp::IPv6Address randomIPv6()
+		{
+			std::array<uint8_t, 16> bytes = { 0x20, 0x01, 0x0d, 0xb8 };
+			for (size_t i = 4; i < bytes.size(); i++)
+			{
+				bytes[i] = static_cast<uint8_t>(random(0, 255));
+			}
+			return pcpp::IPv6Address(bytes);
+		}
+
+		std::vector<uint8_t> randomBytes(size_t len)
+		{
+			std::vector<uint8_t> bytes(len);
+			for (auto& byte : bytes)
+			{
+				byte = static_cast<uint8_t>(m_Random());
+			}
+			return bytes;
+		}
+
+		void addPacket(pcpp::Packet& packet, std::vector<pcpp::RawPacket>& packets, bool computeFields = true)
+		{
+			if (computeFields)
+			{
+				packet.computeCalculateFields();
+			}
+
+			m_TimestampUsec += random(1, 200);
+			timespec timestamp;
+			timestamp.tv_sec = static_cast<time_t>(m_TimestampUsec / 1000000);
+			timestamp.tv_nsec = static_cast<long>(m_TimestampUsec % 1000000) * 1000;
+			packets.emplace_back(*packet.getRawPacket());
+			packets.back().setPacketTimeStamp(timestamp);
+		}
+
+		pcpp::IPv4Layer* createIPv4Layer(const pcpp::IPv4Address& srcIP, const pcpp::IPv4Address& dstIP)
+		{
+			pcpp::IPv4Layer* ipLayer = new pcpp::IPv4Layer(srcIP, dstIP);
+			ipLayer->getIPv4Header()->ipId = pcpp::hostToNet16(static_cast<uint16_t>(random(0, 0xffff)));
+			ipLayer->getIPv4Header()->timeToLive = 64;
+			return ipLayer;
+		}
+
+		void generateTcpFlow(bool outOfOrder, std::vector<pcpp::RawPacket>& packets)
+		{
+			pcpp::MacAddress clientMac = randomMac(), serverMac = randomMac();
+			pcpp::IPv4Address clientIP = randomIPv4(), serverIP = randomIPv4();
+			uint16_t clientPort = static_cast<uint16_t>(random(PlainPortMin, PlainPortMax));
+			uint16_t serverPort = static_cast<uint16_t>(random(PlainPortMin, PlainPortMax));
+			uint32_t clientSeq = m_Random(), serverSeq = m_Random();
+
+			// handshake, data in both directions and teardown
+			std::vector<TcpSegment> segments;
+			segments.push_back({ true, TcpSyn, clientSeq++, 0, 0 });
+			segments.push_back({ false, TcpSyn | TcpAck, serverSeq++, clientSeq, 0 });
+			segments.push_back({ true, TcpAck, clientSeq, serverSeq, 0 });
+			size_t firstDataSegment = segments.size();
+			uint32_t numOfDataSegments = random(4, 16);
+			for (uint32_t i = 0; i < numOfDataSegments; i++)
+			{
+				bool fromClient = chance(3);
+				size_t payloadLen = random(64, 1400);
+				uint32_t& seq = fromClient ? clientSeq : serverSeq;
+				uint32_t ack = fromClient ? serverSeq : clientSeq;
+				segments.push_back({ fromClient, TcpPsh | TcpAck, seq, ack, payloadLen });
+				seq += static_cast<uint32_t>(payloadLen);
+			}
+			size_t lastDataSegment = segments.size();
+			segments.push_back({ true, TcpFin | TcpAck, clientSeq++, serverSeq, 0 });
+			segments.push_back({ false, TcpFin | TcpAck, serverSeq++, clientSeq, 0 });
+			segments.push_back({ true, TcpAck, clientSeq, serverSeq, 0 });
+
+			if (outOfOrder)
+			{
+				// swap neighbouring data segments and retransmit some of them
+				for (size_t i = firstDataSegment; i + 1 < lastDataSegment; i++)
+				{
+					if (chance(3))
+					{
+						std::swap(segments[i], segments[i + 1]);
+						i++;
+					}
+				}
+				for (size_t i = lastDataSegment; i > firstDataSegment; i--)
+				{
+					if (chance(6))
+					{
+						segments.insert(segments.begin() + i, segments[i - 1]);
+					}
+				}
+			}
+
+			for (const auto& segment : segments)
+			{
+				pcpp::Packet packet(100 + segment.payloadLen);
+				packet.addLayer(segment.fromClient ? new pcpp::EthLayer(clientMac, serverMac)
+				                                   : new pcpp::EthLayer(serverMac, clientMac),
+				                true);
+				packet.addLayer(segment.fromClient ? createIPv4Layer(clientIP, serverIP)
+				                                   : createIPv4Layer(serverIP, clientIP),
+				                true);
+				pcpp::TcpLayer* tcpLayer = segment.fromClient ? new pcpp::TcpLayer(clientPort, serverPort)
+				                                              : new pcpp::TcpLayer(serverPort, clientPort);
+				pcpp::tcphdr* tcpHeader = tcpLayer->getTcpHeader();
+				tcpHeader->sequenceNumber = pcpp::hostToNet32(segment.seq);
+				tcpHeader->ackNumber = pcpp::hostToNet32(segment.ack);
+				tcpHeader->finFlag = (segment.flags & TcpFin) ? 1 : 0;
+				tcpHeader->synFlag = (segment.flags & TcpSyn) ? 1 : 0;
+				tcpHeader->pshFlag = (segment.flags & TcpPsh) ? 1 : 0;
+				tcpHeader->ackFlag = (segment.flags & TcpAck) ? 1 : 0;
+				tcpHeader->windowSize = pcpp::hostToNet16(65535);
+				packet.addLayer(tcpLayer, true);
+				if (segment.payloadLen > 0)
+				{
+					std::vector<uint8_t> payload = randomBytes(segment.payloadLen);
+					packet.addLayer(new pcpp::PayloadLayer(payload.data(), payload.size()), true);
+				}
+				addPacket(packet, packets);
+			}
+		}
+
+		void generateIPv6Udp(std::vector<pcpp::RawPacket>& packets)
+		{
+			pcpp::Packet packet(1500);
+			packet.addLayer(new pcpp::EthLayer(randomMac(), randomMac()), true);
+			packet.addLayer(new pcpp::IPv6Layer(randomIPv6(), randomIPv6()), true);
+			packet.addLayer(new pcpp::UdpLayer(static_cast<uint16_t>(random(PlainPortMin, PlainPortMax)),
+			                                   static_cast<uint16_t>(random(PlainPortMin, PlainPortMax))),
+			                true);
+			std::vector<uint8_t> payload = randomBytes(random(32, 1200));
+			packet.addLayer(new pcpp::PayloadLayer(payload.data(), payload.size()), true);
+			addPacket(packet, packets);
+		}
+
+		void addInnerPacket(pcpp::Packet& packet)
+		{
+			packet.addLayer(createIPv4Layer(randomIPv4(), randomIPv4()), true);
+			if (chance(2))
+			{
+				packet.addLayer(new pcpp::TcpLayer(static_cast<uint16_t>(random(PlainPortMin, PlainPortMax)),
+				                                   static_cast<uint16_t>(random(PlainPortMin, PlainPortMax))),
+				                true);
+			}
+			else
+			{
+				packet.addLayer(new pcpp::UdpLayer(static_cast<uint16_t>(random(PlainPortMin, PlainPortMax)),
+				                                   static_cast<uint16_t>(random(PlainPortMin, PlainPortMax))),
+				                true);
+			}
+			std::vector<uint8_t> payload = randomBytes(random(32, 1200));
+			packet.addLayer(new pcpp::PayloadLayer(payload.data(), payload.size()), true);
+		}
+
+		void generateTunnel(std::vector<pcpp::RawPacket>& packets)
+		{
+			pcpp::Packet packet(1600);
+			packet.addLayer(new pcpp::EthLayer(randomMac(), randomMac()), true);
+			packet.addLayer(createIPv4Layer(randomIPv4(), randomIPv4()), true);
+			switch (random(0, 2))
+			{
+			case 0:
+				packet.addLayer(new pcpp::GREv0Layer(), true);
+				break;
+			case 1:
+				packet.addLayer(new pcpp::UdpLayer(static_cast<uint16_t>(random(PlainPortMin, PlainPortMax)), 4789),
+				                true);
+				packet.addLayer(new pcpp::VxlanLayer(random(1, 0xffffff)), true);
+				packet.addLayer(new pcpp::EthLayer(randomMac(), randomMac()), true);
+				break;
+			default:
+				packet.addLayer(new pcpp::UdpLayer(2152, 2152), true);
+				packet.addLayer(new pcpp::GtpV1Layer(pcpp::GtpV1_GPDU, m_Random()), true);
+				break;
+			}
+			addInnerPacket(packet);
+			addPacket(packet, packets);
+		}
+
+		void generateHttp(std::vector<pcpp::RawPacket>& packets)
+		{
+			static const char* const hosts[] = { "www.example.com", "api.example.net", "cdn.example.org",
+				                                 "images.example.com" };
+			static const char* const userAgents[] = { "Mozilla/5.0 (X11; Linux x86_64; rv:120.0) Gecko/20100101",
+				                                      "curl/8.4.0", "Wget/1.21.4" };
+
+			pcpp::MacAddress clientMac = randomMac(), serverMac = randomMac();
+			pcpp::IPv4Address clientIP = randomIPv4(), serverIP = randomIPv4();
+			uint16_t clientPort = static_cast<uint16_t>(random(PlainPortMin, PlainPortMax));
+
+			pcpp::Packet request(1500);
+			request.addLayer(new pcpp::EthLayer(clientMac, serverMac), true);
+			request.addLayer(createIPv4Layer(clientIP, serverIP), true);
+			request.addLayer(new pcpp::TcpLayer(clientPort, 80), true);
+			pcpp::HttpRequestLayer* httpRequest = new pcpp::HttpRequestLayer(
+			    pcpp::HttpRequestLayer::HttpGET, "/resource/" + std::to_string(random(0, 100000)) + "?page=1",
+			    pcpp::OneDotOne);
+			httpRequest->addField(PCPP_HTTP_HOST_FIELD, hosts[random(0, 3)]);
+			httpRequest->addField(PCPP_HTTP_USER_AGENT_FIELD, userAgents[random(0, 2)]);
+			httpRequest->addField(PCPP_HTTP_ACCEPT_FIELD, "*/*");
+			httpRequest->addField(PCPP_HTTP_COOKIE_FIELD, "session=" + std::to_string(m_Random()));
+			httpRequest->addEndOfHeader();
+			request.addLayer(httpRequest, true);
+			addPacket(request, packets);
+
+			pcpp::Packet response(1500);
+			response.addLayer(new pcpp::EthLayer(serverMac, clientMac), true);
+			response.addLayer(createIPv4Layer(serverIP, clientIP), true);
+			response.addLayer(new pcpp::TcpLayer(80, clientPort), true);
+			size_t bodyLen = random(100, 1200);
+			pcpp::HttpResponseLayer* httpResponse =
+			    new pcpp::HttpResponseLayer(pcpp::OneDotOne, pcpp::HttpResponseStatusCode::Http200OK);
+			httpResponse->addField(PCPP_HTTP_CONTENT_TYPE_FIELD, "text/html");
+			httpResponse->addField(PCPP_HTTP_CONTENT_LENGTH_FIELD, std::to_string(bodyLen));
+			httpResponse->addField(PCPP_HTTP_SERVER_FIELD, "nginx");
+			httpResponse->addEndOfHeader();
+			response.addLayer(httpResponse, true);
+			std::vector<uint8_t> body = randomBytes(bodyLen);
+			response.addLayer(new pcpp::PayloadLayer(body.data(), body.size()), true);
+			addPacket(response, packets);
+		}
+
+		static void appendUint16(std::vector<uint8_t>& data, size_t value)
+		{
+			data.push_back(static_cast<uint8_t>(value >> 8));
+			data.push_back(static_cast<uint8_t>(value));
+		}
+
+		static void setUint16(std::vector<uint8_t>& data, size_t offset, size_t value)
+		{
+			data[offset] = static_cast<uint8_t>(value >> 8);
+			data[offset + 1] = static_cast<uint8_t>(value);
+		}
+
+		std::vector<uint8_t> createClientHello(const std::string& serverName)
+		{
+			static const uint16_t cipherSuites[] = { 0x1301, 0x1302, 0x1303, 0xc02b, 0xc02f, 0xc02c,
+				                                     0xc030, 0xcca9, 0xcca8, 0xc013, 0xc014, 0x009c };
+
+			// record header, handshake header and the fixed part of the ClientHello
+			std::vector<uint8_t> data = { 0x16, 0x03, 0x01, 0, 0, 0x01, 0, 0, 0, 0x03, 0x03 };
+			std::vector<uint8_t> clientRandom = randomBytes(32);
+			data.insert(data.end(), clientRandom.begin(), clientRandom.end());
+			data.push_back(0);  // session ID length
+			size_t numOfCipherSuites = random(4, sizeof(cipherSuites) / sizeof(cipherSuites[0]));
+			appendUint16(data, numOfCipherSuites * 2);
+			for (size_t i = 0; i < numOfCipherSuites; i++)
+			{
+				appendUint16(data, cipherSuites[i]);
+			}
+			data.insert(data.end(), { 1, 0 });  // compression methods
+
+			size_t extensionsLenOffset = data.size();
+			appendUint16(data, 0);
+
+			// server_name
+			appendUint16(data, 0x0000);
+			appendUint16(data, serverName.size() + 5);
+			appendUint16(data, serverName.size() + 3);
+			data.push_back(0);
+			appendUint16(data, serverName.size());
+			data.insert(data.end(), serverName.begin(), serverName.end());
+			// supported_groups
+			data.insert(data.end(), { 0x00, 0x0a, 0x00, 0x08, 0x00, 0x06, 0x00, 0x1d, 0x00, 0x17, 0x00, 0x18 });
+			// ec_point_formats
+			data.insert(data.end(), { 0x00, 0x0b, 0x00, 0x02, 0x01, 0x00 });
+			// signature_algorithms
+			data.insert(data.end(), { 0x00, 0x0d, 0x00, 0x08, 0x00, 0x06, 0x04, 0x03, 0x08, 0x04, 0x04, 0x01 });
+			// application_layer_protocol_negotiation: h2, http/1.1
+			data.insert(data.end(), { 0x00, 0x10, 0x00, 0x0e, 0x00, 0x0c, 0x02, 'h', '2', 0x08, 'h', 't', 't', 'p',
+			                          '/', '1', '.', '1' });
+			// supported_versions: TLS 1.3, TLS 1.2
+			data.insert(data.end(), { 0x00, 0x2b, 0x00, 0x05, 0x04, 0x03, 0x04, 0x03, 0x03 });
+
+			setUint16(data, extensionsLenOffset, data.size() - extensionsLenOffset - 2);
+			setUint16(data, 3, data.size() - 5);
+			size_t handshakeLen = data.size() - 9;
+			data[6] = static_cast<uint8_t>(handshakeLen >> 16);
+			setUint16(data, 7, handshakeLen);
+			return data;
+		}
+
+		void generateTls(std::vector<pcpp::RawPacket>& packets)
+		{
+			pcpp::MacAddress clientMac = randomMac(), serverMac = randomMac();
+			pcpp::IPv4Address clientIP = randomIPv4(), serverIP = randomIPv4();
+			uint16_t clientPort = static_cast<uint16_t>(random(PlainPortMin, PlainPortMax));
+
+			pcpp::Packet clientHello(1500);
+			clientHello.addLayer(new pcpp::EthLayer(clientMac, serverMac), true);
+			clientHello.addLayer(createIPv4Layer(clientIP, serverIP), true);
+			clientHello.addLayer(new pcpp::TcpLayer(clientPort, 443), true);
+			std::string serverName = "service" + std::to_string(random(0, 999)) + ".example.com";
+			std::vector<uint8_t> helloData = createClientHello(serverName);
+			clientHello.addLayer(new pcpp::PayloadLayer(helloData.data(), helloData.size()), true);
+			addPacket(clientHello, packets);
+
+			uint32_t numOfRecords = random(1, 4);
+			for (uint32_t i = 0; i < numOfRecords; i++)
+			{
+				bool fromClient = chance(3);
+				pcpp::Packet applicationData(1500);
+				applicationData.addLayer(fromClient ? new pcpp::EthLayer(clientMac, serverMac)
+				                                    : new pcpp::EthLayer(serverMac, clientMac),
+				                         true);
+				applicationData.addLayer(fromClient ? createIPv4Layer(clientIP, serverIP)
+				                                    : createIPv4Layer(serverIP, clientIP),
+				                         true);
+				applicationData.addLayer(fromClient ? new pcpp::TcpLayer(clientPort, 443)
+				                                    : new pcpp::TcpLayer(443, clientPort),
+				                         true);
+				size_t recordLen = random(64, 1300);
+				std::vector<uint8_t> record = { 0x17, 0x03, 0x03, 0, 0 };
+				setUint16(record, 3, recordLen);
+				std::vector<uint8_t> encrypted = randomBytes(recordLen);
+				record.insert(record.end(), encrypted.begin(), encrypted.end());
+				applicationData.addLayer(new pcpp::PayloadLayer(record.data(), record.size()), true);
+				addPacket(applicationData, packets);
+			}
+		}
+
+		void generateDns(std::vector<pcpp::RawPacket>& packets)
+		{
+			static const char* const domains[] = { "example.com", "example.net", "example.org", "test.example.com" };
+
+			pcpp::MacAddress clientMac = randomMac(), serverMac = randomMac();
+			pcpp::IPv4Address clientIP = randomIPv4(), serverIP = randomIPv4();
+			uint16_t clientPort = static_cast<uint16_t>(random(PlainPortMin, PlainPortMax));
+			uint16_t transactionID = static_cast<uint16_t>(random(0, 0xffff));
+			std::string name = "host" + std::to_string(random(0, 9999)) + "." + domains[random(0, 3)];
+
+			pcpp::Packet query(512);
+			query.addLayer(new pcpp::EthLayer(clientMac, serverMac), true);
+			query.addLayer(createIPv4Layer(clientIP, serverIP), true);
+			query.addLayer(new pcpp::UdpLayer(clientPort, 53), true);
+			pcpp::DnsLayer* queryLayer = new pcpp::DnsLayer();
+			queryLayer->getDnsHeader()->transactionID = pcpp::hostToNet16(transactionID);
+			queryLayer->getDnsHeader()->recursionDesired = 1;
+			queryLayer->addQuery(name, pcpp::DNS_TYPE_A, pcpp::DNS_CLASS_IN);
+			query.addLayer(queryLayer, true);
+			addPacket(query, packets);
+
+			pcpp::Packet response(512);
+			response.addLayer(new pcpp::EthLayer(serverMac, clientMac), true);
+			response.addLayer(createIPv4Layer(serverIP, clientIP), true);
+			response.addLayer(new pcpp::UdpLayer(53, clientPort), true);
+			pcpp::DnsLayer* responseLayer = new pcpp::DnsLayer();
+			responseLayer->getDnsHeader()->transactionID = pcpp::hostToNet16(transactionID);
+			responseLayer->getDnsHeader()->queryOrResponse = 1;
+			responseLayer->getDnsHeader()->recursionDesired = 1;
+			responseLayer->getDnsHeader()->recursionAvailable = 1;
+			responseLayer->addQuery(name, pcpp::DNS_TYPE_A, pcpp::DNS_CLASS_IN);
+			uint32_t numOfAnswers = random(1, 4);
+			for (uint32_t i = 0; i < numOfAnswers; i++)
+			{
+				pcpp::IPv4DnsResourceData answerData(randomIPv4());
+				responseLayer->addAnswer(name, pcpp::DNS_TYPE_A, pcpp::DNS_CLASS_IN, random(60, 3600), &answerData);
+			}
+			response.addLayer(responseLayer, true);
+			addPacket(response, packets);
+		}
+
+		void generateFragments(std::vector<pcpp::RawPacket>& packets)
+		{
+			// the fragmented datagram: a UDP header followed by the payload
+			size_t datagramLen = random(2000, 8000);
+			std::vector<uint8_t> datagram = randomBytes(datagramLen);
+			setUint16(datagram, 0, random(PlainPortMin, PlainPortMax));
+			setUint16(datagram, 2, random(PlainPortMin, PlainPortMax));
+			setUint16(datagram, 4, datagramLen);
+			setUint16(datagram, 6, 0);
+
+			bool isIPv4 = chance(2);
+			size_t fragmentSize = isIPv4 ? IPv4FragmentSize : IPv6FragmentSize;
+			std::vector<size_t> offsets;
+			for (size_t offset = 0; offset < datagramLen; offset += fragmentSize)
+			{
+				offsets.push_back(offset);
+			}
+			if (chance(4))
+			{
+				std::reverse(offsets.begin(), offsets.end());
+			}
+
+			pcpp::MacAddress srcMac = randomMac(), dstMac = randomMac();
+			pcpp::IPv4Address srcIPv4 = randomIPv4(), dstIPv4 = randomIPv4();
+			pcpp::IPv6Address srcIPv6 = randomIPv6(), dstIPv6 = randomIPv6();
+			uint32_t fragmentID = m_Random();
+			for (auto offset : offsets)
+			{
+				size_t fragmentLen = std::min(fragmentSize, datagramLen - offset);
+				bool lastFragment = offset + fragmentLen == datagramLen;
+
+				pcpp::Packet packet(1600);
+				packet.addLayer(new pcpp::EthLayer(srcMac, dstMac), true);
+				if (isIPv4)
+				{
+					pcpp::IPv4Layer* ipLayer = createIPv4Layer(srcIPv4, dstIPv4);
+					ipLayer->getIPv4Header()->ipId = pcpp::hostToNet16(static_cast<uint16_t>(fragmentID));
+					ipLayer->getIPv4Header()->protocol = pcpp::PACKETPP_IPPROTO_UDP;
+					ipLayer->getIPv4Header()->fragmentOffset = pcpp::hostToNet16(
+					    static_cast<uint16_t>((lastFragment ? 0 : 0x2000) | (offset / 8)));
+					packet.addLayer(ipLayer, true);
+				}
+				else
+				{
+					pcpp::IPv6Layer* ipLayer = new pcpp::IPv6Layer(srcIPv6, dstIPv6);
+					ipLayer->getIPv6Header()->hopLimit = 64;
+					packet.addLayer(ipLayer, true);
+					pcpp::IPv6FragmentationHeader fragmentHeader(fragmentID, static_cast<uint16_t>(offset),
+					                                             lastFragment);
+					ipLayer->addExtension<pcpp::IPv6FragmentationHeader>(fragmentHeader);
+				}
+				packet.addLayer(new pcpp::PayloadLayer(datagram.data() + offset, fragmentLen), true);
+				packet.computeCalculateFields();
+
+				if (!isIPv4)
+				{
+					// the fragment payload isn't a parsed UDP layer, so set the next header of the fragment header
+					pcpp::IPv6FragmentationHeader* fragmentHeader =
+					    packet.getLayerOfType<pcpp::IPv6Layer>()->getExtensionOfType<pcpp::IPv6FragmentationHeader>();
+					fragmentHeader->getFragHeader()->nextHeader = pcpp::PACKETPP_IPPROTO_UDP;
+				}
+				addPacket(packet, packets, false);
+			}
+		}
+	};
+}  // namespace
+
+const char* getTrafficProfileName(TrafficProfile profile)
+{
+	switch (profile)
+	{
+	case TrafficProfile::IPv4Tcp:
+		return "ipv4_tcp";
+	case TrafficProfile::IPv6Udp:
+		return "ipv6_udp";
+	case TrafficProfile::Tunnels:
+		return "tunnels";
+	case TrafficProfile::Http:
+		return "http";
+	case TrafficProfile::Tls:
+		return "tls";
+	case TrafficProfile::Dns:
+		return "dns";
+	case TrafficProfile::Fragments:
+		return "fragments";
+	case TrafficProfile::TcpOutOfOrder:
+		return "tcp_out_of_order";
+	default:
+		return "mixed";
+	}
+}
+
+std::vector<pcpp::RawPacket> generateTraffic(TrafficProfile profile, size_t numOfPackets, uint32_t seed)
+{
+	std::vector<pcpp::RawPacket> packets;
+	packets.reserve(numOfPackets + 64);
+	TrafficGenerator generator(seed);
+	generator.generate(profile, numOfPackets, packets);
+	return packets;
+}
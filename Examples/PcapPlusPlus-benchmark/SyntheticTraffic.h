@@ -0,0 +1,48 @@
+#pragma once
+
+#include <RawPacket.h>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * The kinds of synthetic traffic the benchmarks run on
+ */
+enum class TrafficProfile
+{
+	/** TCP flows over IPv4 with in-order segments */
+	IPv4Tcp,
+	/** UDP over IPv6 */
+	IPv6Udp,
+	/** GRE, VXLAN and GTP-U tunnels with an inner IPv4 packet */
+	Tunnels,
+	/** HTTP requests and responses */
+	Http,
+	/** TLS ClientHello messages followed by application data */
+	Tls,
+	/** DNS queries and responses */
+	Dns,
+	/** IPv4 and IPv6 fragments of large UDP datagrams, some of them out of order */
+	Fragments,
+	/** TCP flows over IPv4 with reordered and retransmitted segments */
+	TcpOutOfOrder,
+	/** All of the above, interleaved */
+	Mixed
+};
+
+/**
+ * @param[in] profile A traffic profile
+ * @return The profile name, as used in benchmark names
+ */
+const char* getTrafficProfileName(TrafficProfile profile);
+
+/**
+ * Generate synthetic traffic. The same profile, packet count and seed always generate the same packets, so results
+ * of different builds and machines can be compared
+ * @param[in] profile The kind of traffic to generate
+ * @param[in] numOfPackets The number of packets to generate. Flows, datagrams and fragment trains are completed, so
+ * a few more packets may be generated
+ * @param[in] seed The seed of the random generator
+ * @return The generated packets, with increasing timestamps
+ */
+std::vector<pcpp::RawPacket> generateTraffic(TrafficProfile profile, size_t numOfPackets, uint32_t seed = 1);
@@ -1,4 +1,5 @@
 #include <Packet.h>
+#include <PacketTemplate.h>
 #include <PcapFileDevice.h>
 #include <PcapPlusPlusVersion.h>
 
@@ -7,15 +8,38 @@
 #include <IPv6Layer.h>
 #include <TcpLayer.h>
 #include <UdpLayer.h>
+#include <SSLLayer.h>
+#include <TLSFingerprint.h>
 
 #include <benchmark/benchmark.h>
 
+#include "BenchmarkUtils.h"
+
+#include <cstdlib>
 #include <iostream>
+#include <string>
+#include <vector>
 
 static std::string pcapFileName = "";
+static std::string pcapNgFileName = "benchmark-input.pcapng";
+
+// The benchmarks in this file read packets from the file given with --pcap-file, those in benchmark-subsystems.cpp
+// run on synthetic traffic
+static bool skipWithoutPcapFile(benchmark::State& state)
+{
+	if (pcapFileName.empty())
+	{
+		state.SkipWithError("No pcap file, use --pcap-file");
+		return true;
+	}
+	return false;
+}
 
 static void BM_PcapFileRead(benchmark::State& state)
 {
+	if (skipWithoutPcapFile(state))
+		return;
+
 	// Open the pcap file for reading
 	pcpp::PcapFileReaderDevice reader(pcapFileName);
 	if (!reader.open())
@@ -55,6 +79,51 @@ static void BM_PcapFileRead(benchmark::State& state)
 }
 BENCHMARK(BM_PcapFileRead);
 
+static void BM_PcapNgFileRead(benchmark::State& state, bool zeroCopy)
+{
+	if (skipWithoutPcapFile(state))
+		return;
+
+	// Open the pcapng file converted from the input pcap file for reading
+	pcpp::PcapNgFileReaderDevice reader(pcapNgFileName);
+	if (!reader.open())
+	{
+		state.SkipWithError("Cannot open pcapng file for reading");
+		return;
+	}
+
+	size_t totalBytes = 0;
+	size_t totalPackets = 0;
+	pcpp::RawPacket rawPacket;
+	for (auto _ : state)
+	{
+		if (!(zeroCopy ? reader.getNextPacketZeroCopy(rawPacket) : reader.getNextPacket(rawPacket)))
+		{
+			// If the rawPacket is empty there should be an error
+			if (totalBytes == 0)
+			{
+				state.SkipWithError("Cannot read packet");
+				return;
+			}
+
+			// Rewind the file if it reached the end
+			state.PauseTiming();
+			reader.close();
+			reader.open();
+			state.ResumeTiming();
+			continue;
+		}
+
+		++totalPackets;
+		totalBytes += rawPacket.getRawDataLen();
+	}
+
+	state.SetBytesProcessed(totalBytes);
+	state.SetItemsProcessed(totalPackets);
+}
+BENCHMARK_CAPTURE(BM_PcapNgFileRead, copy, false);
+BENCHMARK_CAPTURE(BM_PcapNgFileRead, zero_copy, true);
+
 static void BM_PcapFileWrite(benchmark::State& state)
 {
 	// Open the pcap file for writing
@@ -95,6 +164,9 @@ BENCHMARK(BM_PcapFileWrite);
 
 static void BM_PacketParsing(benchmark::State& state)
 {
+	if (skipWithoutPcapFile(state))
+		return;
+
 	// Open the pcap file for reading
 	size_t totalBytes = 0;
 	size_t totalPackets = 0;
@@ -139,6 +211,11 @@ static void BM_PacketParsing(benchmark::State& state)
 	// Set statistics to the benchmark state
 	state.SetBytesProcessed(totalBytes);
 	state.SetItemsProcessed(totalPackets);
+
+	// The number of dissectors depends on PCAPPP_PROTOCOLS, label it to compare minimal and full builds
+	state.SetLabel(std::to_string(pcpp::TcpLayer::getDissectorTable().getDissectorNames().size()) + " TCP and " +
+	               std::to_string(pcpp::UdpLayer::getDissectorTable().getDissectorNames().size()) +
+	               " UDP dissectors");
 }
 BENCHMARK(BM_PacketParsing);
 
@@ -197,40 +274,233 @@ static void BM_PacketCrafting(benchmark::State& state)
 }
 BENCHMARK(BM_PacketCrafting);
 
+static void BM_PacketTemplate(benchmark::State& state)
+{
+	// Build the same kind of packet as BM_PacketCrafting once, then craft the variants from the template
+	pcpp::Packet packet;
+	packet.addLayer(new pcpp::EthLayer(pcpp::MacAddress("00:11:22:33:44:55"), pcpp::MacAddress("66:77:88:99:aa:bb")),
+	                true);
+	packet.addLayer(new pcpp::IPv4Layer(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("10.0.0.2")), true);
+	packet.addLayer(new pcpp::UdpLayer(1000, 2000), true);
+
+	pcpp::PacketTemplate packetTemplate(packet);
+	int srcIP = packetTemplate.addField("src_ip", pcpp::PacketTemplateField::SrcIP);
+	int dstIP = packetTemplate.addField("dst_ip", pcpp::PacketTemplateField::DstIP);
+	int srcPort = packetTemplate.addField("src_port", pcpp::PacketTemplateField::SrcPort);
+	int dstPort = packetTemplate.addField("dst_port", pcpp::PacketTemplateField::DstPort);
+
+	const size_t batchSize = 64;
+	pcpp::PacketTemplateBatch batch(packetTemplate, batchSize);
+	size_t totalBytes = 0;
+	size_t totalPackets = 0;
+	uint32_t counter = 0;
+
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < batchSize; i++)
+		{
+			counter++;
+			batch.setFieldValue(i, srcIP, pcpp::IPv4Address(counter));
+			batch.setFieldValue(i, dstIP, pcpp::IPv4Address(~counter));
+			batch.setFieldValue(i, srcPort, counter);
+			batch.setFieldValue(i, dstPort, counter >> 16);
+		}
+		benchmark::DoNotOptimize(batch.getRawPackets());
+
+		totalPackets += batchSize;
+		totalBytes += batchSize * packetTemplate.getDataLen();
+	}
+
+	state.SetBytesProcessed(totalBytes);
+	state.SetItemsProcessed(totalPackets);
+}
+BENCHMARK(BM_PacketTemplate);
+
+static void BM_TLSFingerprint(benchmark::State& state, bool useScanner)
+{
+	if (skipWithoutPcapFile(state))
+		return;
+
+	// Load the packets that start with a TLS ClientHello or ServerHello into memory, so only fingerprinting is
+	// measured
+	pcpp::PcapFileReaderDevice reader(pcapFileName);
+	if (!reader.open())
+	{
+		state.SkipWithError("Cannot open pcap file for reading");
+		return;
+	}
+
+	std::vector<pcpp::RawPacket> helloPackets;
+	std::vector<size_t> payloadOffsets;
+	pcpp::RawPacket rawPacket;
+	while (reader.getNextPacket(rawPacket))
+	{
+		pcpp::Packet parsedPacket(&rawPacket, pcpp::TCP);
+		pcpp::TcpLayer* tcpLayer = parsedPacket.getLayerOfType<pcpp::TcpLayer>();
+		if (tcpLayer == nullptr || tcpLayer->getLayerPayloadSize() < 6)
+			continue;
+
+		const uint8_t* payload = tcpLayer->getLayerPayload();
+		if (payload[0] == pcpp::SSL_HANDSHAKE &&
+		    (payload[5] == pcpp::SSL_CLIENT_HELLO || payload[5] == pcpp::SSL_SERVER_HELLO))
+		{
+			helloPackets.push_back(rawPacket);
+			payloadOffsets.push_back(payload - rawPacket.getRawData());
+		}
+	}
+
+	if (helloPackets.empty())
+	{
+		state.SkipWithError("The pcap file has no TLS hello messages");
+		return;
+	}
+
+	size_t totalBytes = 0;
+	size_t totalFingerprints = 0;
+	size_t packetIndex = 0;
+	for (auto _ : state)
+	{
+		pcpp::RawPacket& helloPacket = helloPackets[packetIndex];
+		size_t payloadOffset = payloadOffsets[packetIndex];
+		packetIndex = (packetIndex + 1) % helloPackets.size();
+
+		if (useScanner)
+		{
+			// Scan the TCP payload directly, without parsing the packet or allocating memory
+			const uint8_t* payload = helloPacket.getRawData() + payloadOffset;
+			size_t payloadLen = helloPacket.getRawDataLen() - payloadOffset;
+			pcpp::TLSClientHelloFingerprint clientHelloFingerprint;
+			pcpp::TLSServerHelloFingerprint serverHelloFingerprint;
+			if (pcpp::TLSFingerprintScanner::scanClientHello(payload, payloadLen, clientHelloFingerprint) ==
+			    pcpp::TLSFingerprintScanner::ScanResult::Success)
+			{
+				benchmark::DoNotOptimize(clientHelloFingerprint.ja4[0]);
+				++totalFingerprints;
+			}
+			else if (pcpp::TLSFingerprintScanner::scanServerHello(payload, payloadLen, serverHelloFingerprint) ==
+			         pcpp::TLSFingerprintScanner::ScanResult::Success)
+			{
+				benchmark::DoNotOptimize(serverHelloFingerprint.ja3sHash[0]);
+				++totalFingerprints;
+			}
+		}
+		else
+		{
+			// Parse the packet and use the SSL layer classes, like the TLSFingerprinting example used to
+			pcpp::Packet parsedPacket(&helloPacket);
+			pcpp::SSLHandshakeLayer* handshakeLayer = parsedPacket.getLayerOfType<pcpp::SSLHandshakeLayer>();
+			if (handshakeLayer != nullptr)
+			{
+				auto clientHello = handshakeLayer->getHandshakeMessageOfType<pcpp::SSLClientHelloMessage>();
+				auto serverHello = handshakeLayer->getHandshakeMessageOfType<pcpp::SSLServerHelloMessage>();
+				if (clientHello != nullptr)
+				{
+					benchmark::DoNotOptimize(clientHello->generateTLSFingerprint().toStringAndMD5());
+					++totalFingerprints;
+				}
+				else if (serverHello != nullptr)
+				{
+					benchmark::DoNotOptimize(serverHello->generateTLSFingerprint().toStringAndMD5());
+					++totalFingerprints;
+				}
+			}
+		}
+
+		totalBytes += helloPacket.getRawDataLen();
+	}
+
+	state.SetBytesProcessed(totalBytes);
+	state.SetItemsProcessed(totalFingerprints);
+}
+BENCHMARK_CAPTURE(BM_TLSFingerprint, packet_parsing, false);
+BENCHMARK_CAPTURE(BM_TLSFingerprint, scanner, true);
+
 int main(int argc, char** argv)
 {
 	// Initialize the benchmark
 	benchmark::Initialize(&argc, argv);
 
-	// Parse command line arguments to find the pcap file name
+	// Parse the remaining command line arguments
+	std::string saveBaselineFileName;
+	std::string baselineFileName;
+	double maxRegressionPercent = 10;
 	for (int idx = 1; idx < argc; ++idx)
 	{
-		if (strcmp(argv[idx], "--pcap-file") == 0)
+		std::string option = argv[idx];
+		if (option != "--pcap-file" && option != "--save-baseline" && option != "--baseline" &&
+		    option != "--max-regression")
 		{
-			if (idx == argc - 1)
-			{
-				std::cerr << "Please provide a pcap file name after --pcap-file" << std::endl;
-				return 1;
-			}
+			std::cerr << "Unknown option " << option << std::endl;
+			return 1;
+		}
 
-			pcapFileName = argv[idx + 1];
-			break;
+		if (idx == argc - 1)
+		{
+			std::cerr << "Please provide a value after " << option << std::endl;
+			return 1;
 		}
+
+		std::string value = argv[++idx];
+		if (option == "--pcap-file")
+			pcapFileName = value;
+		else if (option == "--save-baseline")
+			saveBaselineFileName = value;
+		else if (option == "--baseline")
+			baselineFileName = value;
+		else
+			maxRegressionPercent = std::atof(value.c_str());
 	}
 
 	if (pcapFileName.empty())
 	{
-		std::cerr << "Please provide a pcap file name using --pcap-file" << std::endl;
-		return 1;
+		std::cout << "No pcap file given with --pcap-file, only the benchmarks on synthetic traffic will run"
+		          << std::endl;
+	}
+	else
+	{
+		// Convert the pcap file to pcapng for the pcapng read benchmarks
+		pcpp::PcapFileReaderDevice pcapReader(pcapFileName);
+		pcpp::PcapNgFileWriterDevice pcapNgWriter(pcapNgFileName);
+		if (!pcapReader.open() || !pcapNgWriter.open())
+		{
+			std::cerr << "Cannot convert the pcap file to pcapng" << std::endl;
+			return 1;
+		}
+
+		pcpp::RawPacket rawPacket;
+		while (pcapReader.getNextPacket(rawPacket))
+			pcapNgWriter.writePacket(rawPacket);
+		pcapReader.close();
+		pcapNgWriter.close();
+
+		benchmark::AddCustomContext("Pcap file", pcapFileName);
 	}
 
 	benchmark::AddCustomContext("PcapPlusPlus version", pcpp::getPcapPlusPlusVersionFull());
 	benchmark::AddCustomContext("Build info", pcpp::getBuildDateTime());
 	benchmark::AddCustomContext("Git info", pcpp::getGitInfo());
-	benchmark::AddCustomContext("Pcap file", pcapFileName);
 
 	// Run the benchmarks
-	benchmark::RunSpecifiedBenchmarks();
+	if (saveBaselineFileName.empty() && baselineFileName.empty())
+	{
+		benchmark::RunSpecifiedBenchmarks();
+		return 0;
+	}
+
+	// Keep the results to save them as a baseline or compare them with one
+	BaselineReporter reporter;
+	benchmark::RunSpecifiedBenchmarks(&reporter);
+
+	if (!saveBaselineFileName.empty() && !reporter.saveBaseline(saveBaselineFileName))
+	{
+		std::cerr << "Cannot write baseline file " << saveBaselineFileName << std::endl;
+		return 1;
+	}
+
+	if (!baselineFileName.empty() && !reporter.compareWithBaseline(baselineFileName, maxRegressionPercent))
+	{
+		return 2;
+	}
 
 	return 0;
 }
@@ -0,0 +1,528 @@
+// Benchmarks of PcapPlusPlus subsystems on synthetic traffic. Unlike the benchmarks in benchmark-google.cpp they don't
+// need an input file, and their traffic is the same on every run, so results can be compared across builds
+
+#include "BenchmarkUtils.h"
+#include "SyntheticTraffic.h"
+
+#include <DnsLayer.h>
+#include <DnsView.h>
+#include <HttpLayer.h>
+#include <IPReassembly.h>
+#include <Packet.h>
+#include <PacketUtils.h>
+#include <PcapFileDevice.h>
+#include <PcapFilter.h>
+#include <SSLHandshake.h>
+#include <SSLLayer.h>
+#include <TcpReassembly.h>
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace
+{
+	const size_t NumOfSyntheticPackets = 10000;
+
+	// Traffic is generated once per profile and shared by all benchmarks
+	const std::vector<pcpp::RawPacket>& getTraffic(TrafficProfile profile)
+	{
+		static std::map<TrafficProfile, std::vector<pcpp::RawPacket>> traffic;
+		auto trafficIter = traffic.find(profile);
+		if (trafficIter == traffic.end())
+		{
+			trafficIter = traffic.emplace(profile, generateTraffic(profile, NumOfSyntheticPackets)).first;
+		}
+		return trafficIter->second;
+	}
+
+	size_t getTotalBytes(const std::vector<pcpp::RawPacket>& packets)
+	{
+		size_t totalBytes = 0;
+		for (const auto& packet : packets)
+		{
+			totalBytes += packet.getRawDataLen();
+		}
+		return totalBytes;
+	}
+
+	// Parsed packets of a profile, for benchmarks of hashing and protocol accessors that shouldn't measure parsing
+	std::vector<std::unique_ptr<pcpp::Packet>> parseTraffic(TrafficProfile profile)
+	{
+		std::vector<std::unique_ptr<pcpp::Packet>> parsedPackets;
+		for (const auto& rawPacket : getTraffic(profile))
+		{
+			parsedPackets.emplace_back(new pcpp::Packet(const_cast<pcpp::RawPacket*>(&rawPacket)));
+		}
+		return parsedPackets;
+	}
+
+	void onTcpMessageReady(int8_t, const pcpp::TcpStreamData& tcpData, void* userCookie)
+	{
+		*static_cast<size_t*>(userCookie) += tcpData.getDataLength();
+	}
+}  // namespace
+
+static void BM_SyntheticParsing(benchmark::State& state, TrafficProfile profile)
+{
+	const std::vector<pcpp::RawPacket>& packets = getTraffic(profile);
+	size_t totalBytes = 0;
+	size_t totalPackets = 0;
+	size_t packetIndex = 0;
+
+	PacketCounters counters;
+	for (auto _ : state)
+	{
+		pcpp::RawPacket* rawPacket = const_cast<pcpp::RawPacket*>(&packets[packetIndex]);
+		packetIndex = (packetIndex + 1) % packets.size();
+
+		pcpp::Packet parsedPacket(rawPacket);
+		benchmark::DoNotOptimize(parsedPacket.getLastLayer());
+
+		++totalPackets;
+		totalBytes += rawPacket->getRawDataLen();
+	}
+	counters.report(state, totalPackets, totalBytes);
+}
+BENCHMARK_CAPTURE(BM_SyntheticParsing, ipv4_tcp, TrafficProfile::IPv4Tcp);
+BENCHMARK_CAPTURE(BM_SyntheticParsing, ipv6_udp, TrafficProfile::IPv6Udp);
+BENCHMARK_CAPTURE(BM_SyntheticParsing, tunnels, TrafficProfile::Tunnels);
+BENCHMARK_CAPTURE(BM_SyntheticParsing, http, TrafficProfile::Http);
+BENCHMARK_CAPTURE(BM_SyntheticParsing, tls, TrafficProfile::Tls);
+BENCHMARK_CAPTURE(BM_SyntheticParsing, dns, TrafficProfile::Dns);
+BENCHMARK_CAPTURE(BM_SyntheticParsing, fragments, TrafficProfile::Fragments);
+BENCHMARK_CAPTURE(BM_SyntheticParsing, mixed, TrafficProfile::Mixed);
+
+static void BM_ParseUntilLayer(benchmark::State& state, pcpp::OsiModelLayer parseUntilLayer)
+{
+	const std::vector<pcpp::RawPacket>& packets = getTraffic(TrafficProfile::Mixed);
+	size_t totalBytes = 0;
+	size_t totalPackets = 0;
+	size_t packetIndex = 0;
+
+	PacketCounters counters;
+	for (auto _ : state)
+	{
+		pcpp::RawPacket* rawPacket = const_cast<pcpp::RawPacket*>(&packets[packetIndex]);
+		packetIndex = (packetIndex + 1) % packets.size();
+
+		pcpp::Packet parsedPacket(rawPacket, parseUntilLayer);
+		benchmark::DoNotOptimize(parsedPacket.getLastLayer());
+
+		++totalPackets;
+		totalBytes += rawPacket->getRawDataLen();
+	}
+	counters.report(state, totalPackets, totalBytes);
+}
+BENCHMARK_CAPTURE(BM_ParseUntilLayer, data_link, pcpp::OsiModelDataLinkLayer);
+BENCHMARK_CAPTURE(BM_ParseUntilLayer, network, pcpp::OsiModelNetworkLayer);
+BENCHMARK_CAPTURE(BM_ParseUntilLayer, transport, pcpp::OsiModelTransportLayer);
+
+static void BM_TcpReassembly(benchmark::State& state, TrafficProfile profile)
+{
+	// Each iteration reassembles all flows of the traffic with a new TcpReassembly instance
+	std::vector<pcpp::RawPacket> packets = getTraffic(profile);
+	size_t trafficBytes = getTotalBytes(packets);
+	size_t totalBytes = 0;
+	size_t totalPackets = 0;
+	size_t reassembledBytes = 0;
+
+	PacketCounters counters;
+	for (auto _ : state)
+	{
+		pcpp::TcpReassembly tcpReassembly(onTcpMessageReady, &reassembledBytes);
+		for (auto& rawPacket : packets)
+		{
+			tcpReassembly.reassemblePacket(&rawPacket);
+		}
+		tcpReassembly.closeAllConnections();
+
+		totalPackets += packets.size();
+		totalBytes += trafficBytes;
+	}
+	counters.report(state, totalPackets, totalBytes);
+	state.counters["reassembled_bytes/iter"] =
+	    benchmark::Counter(static_cast<double>(reassembledBytes), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_CAPTURE(BM_TcpReassembly, in_order, TrafficProfile::IPv4Tcp);
+BENCHMARK_CAPTURE(BM_TcpReassembly, out_of_order, TrafficProfile::TcpOutOfOrder);
+
+static void BM_IPReassembly(benchmark::State& state)
+{
+	// Each iteration reassembles all fragments of the traffic with a new IPReassembly instance
+	std::vector<pcpp::RawPacket> packets = getTraffic(TrafficProfile::Fragments);
+	size_t trafficBytes = getTotalBytes(packets);
+	size_t totalBytes = 0;
+	size_t totalPackets = 0;
+	size_t reassembledPackets = 0;
+
+	PacketCounters counters;
+	for (auto _ : state)
+	{
+		pcpp::IPReassembly ipReassembly;
+		for (auto& rawPacket : packets)
+		{
+			pcpp::IPReassembly::ReassemblyStatus status;
+			pcpp::Packet* reassembledPacket = ipReassembly.processPacket(&rawPacket, status);
+			if (status == pcpp::IPReassembly::REASSEMBLED)
+			{
+				++reassembledPackets;
+				delete reassembledPacket;
+			}
+		}
+
+		totalPackets += packets.size();
+		totalBytes += trafficBytes;
+	}
+	counters.report(state, totalPackets, totalBytes);
+	state.counters["reassembled/iter"] =
+	    benchmark::Counter(static_cast<double>(reassembledPackets), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_IPReassembly);
+
+static void BM_BpfFilter(benchmark::State& state)
+{
+	const std::vector<pcpp::RawPacket>& packets = getTraffic(TrafficProfile::Mixed);
+	pcpp::BpfFilterWrapper filter;
+	if (!filter.setFilter("tcp port 80 or udp port 53 or (ip6 and udp)"))
+	{
+		state.SkipWithError("Cannot compile the BPF filter");
+		return;
+	}
+
+	size_t totalBytes = 0;
+	size_t totalPackets = 0;
+	size_t matchedPackets = 0;
+	size_t packetIndex = 0;
+
+	PacketCounters counters;
+	for (auto _ : state)
+	{
+		const pcpp::RawPacket& rawPacket = packets[packetIndex];
+		packetIndex = (packetIndex + 1) % packets.size();
+
+		if (filter.matchPacketWithFilter(&rawPacket))
+		{
+			++matchedPackets;
+		}
+
+		++totalPackets;
+		totalBytes += rawPacket.getRawDataLen();
+	}
+	counters.report(state, totalPackets, totalBytes);
+	benchmark::DoNotOptimize(matchedPackets);
+}
+BENCHMARK(BM_BpfFilter);
+
+static void BM_Hash5Tuple(benchmark::State& state)
+{
+	std::vector<std::unique_ptr<pcpp::Packet>> parsedPackets = parseTraffic(TrafficProfile::Mixed);
+	size_t totalBytes = 0;
+	size_t totalPackets = 0;
+	size_t packetIndex = 0;
+
+	PacketCounters counters;
+	for (auto _ : state)
+	{
+		pcpp::Packet* packet = parsedPackets[packetIndex].get();
+		packetIndex = (packetIndex + 1) % parsedPackets.size();
+
+		benchmark::DoNotOptimize(pcpp::hash5Tuple(packet));
+
+		++totalPackets;
+		totalBytes += packet->getRawPacketReadOnly()->getRawDataLen();
+	}
+	counters.report(state, totalPackets, totalBytes);
+}
+BENCHMARK(BM_Hash5Tuple);
+
+static void BM_Hash5Tuple64(benchmark::State& state)
+{
+	std::vector<std::unique_ptr<pcpp::Packet>> parsedPackets = parseTraffic(TrafficProfile::Mixed);
+	size_t totalBytes = 0;
+	size_t totalPackets = 0;
+	size_t packetIndex = 0;
+
+	PacketCounters counters;
+	for (auto _ : state)
+	{
+		pcpp::Packet* packet = parsedPackets[packetIndex].get();
+		packetIndex = (packetIndex + 1) % parsedPackets.size();
+
+		benchmark::DoNotOptimize(pcpp::hash5Tuple64(packet));
+
+		++totalPackets;
+		totalBytes += packet->getRawPacketReadOnly()->getRawDataLen();
+	}
+	counters.report(state, totalPackets, totalBytes);
+}
+BENCHMARK(BM_Hash5Tuple64);
+
+static void BM_ToeplitzHash(benchmark::State& state)
+{
+	std::vector<std::unique_ptr<pcpp::Packet>> parsedPackets = parseTraffic(TrafficProfile::Mixed);
+	pcpp::ToeplitzHash toeplitzHash;
+	size_t totalBytes = 0;
+	size_t totalPackets = 0;
+	size_t packetIndex = 0;
+
+	PacketCounters counters;
+	for (auto _ : state)
+	{
+		pcpp::Packet* packet = parsedPackets[packetIndex].get();
+		packetIndex = (packetIndex + 1) % parsedPackets.size();
+
+		benchmark::DoNotOptimize(toeplitzHash.hash5Tuple(packet));
+
+		++totalPackets;
+		totalBytes += packet->getRawPacketReadOnly()->getRawDataLen();
+	}
+	counters.report(state, totalPackets, totalBytes);
+}
+BENCHMARK(BM_ToeplitzHash);
+
+static void BM_BufferHash(benchmark::State& state, bool useHash64)
+{
+	// The argument is the buffer length, each computed hash counts as a packet
+	std::vector<uint8_t> buffer(static_cast<size_t>(state.range(0)));
+	for (size_t i = 0; i < buffer.size(); i++)
+	{
+		buffer[i] = static_cast<uint8_t>(i * 2654435761U);
+	}
+
+	size_t totalBytes = 0;
+	size_t totalPackets = 0;
+
+	PacketCounters counters;
+	for (auto _ : state)
+	{
+		if (useHash64)
+			benchmark::DoNotOptimize(pcpp::hash64(buffer.data(), buffer.size()));
+		else
+			benchmark::DoNotOptimize(pcpp::fnvHash(buffer.data(), buffer.size()));
+
+		++totalPackets;
+		totalBytes += buffer.size();
+	}
+	counters.report(state, totalPackets, totalBytes);
+}
+BENCHMARK_CAPTURE(BM_BufferHash, fnv, false)->Arg(13)->Arg(37)->Arg(1500);
+BENCHMARK_CAPTURE(BM_BufferHash, hash64, true)->Arg(13)->Arg(37)->Arg(1500);
+
+static void BM_Checksum(benchmark::State& state)
+{
+	// The argument is the buffer length, each computed checksum counts as a packet
+	std::vector<uint16_t> buffer(static_cast<size_t>(state.range(0)) / 2);
+	for (size_t i = 0; i < buffer.size(); i++)
+	{
+		buffer[i] = static_cast<uint16_t>(i * 2654435761U);
+	}
+
+	size_t totalBytes = 0;
+	size_t totalPackets = 0;
+
+	PacketCounters counters;
+	for (auto _ : state)
+	{
+		pcpp::ScalarBuffer<uint16_t> vec = { buffer.data(), buffer.size() * 2 };
+		benchmark::DoNotOptimize(pcpp::computeChecksum(&vec, 1));
+
+		++totalPackets;
+		totalBytes += buffer.size() * 2;
+	}
+	counters.report(state, totalPackets, totalBytes);
+}
+BENCHMARK(BM_Checksum)->Arg(64)->Arg(576)->Arg(1500)->Arg(9000);
+
+static void BM_DnsAccessors(benchmark::State& state, bool useDnsView)
+{
+	// DnsLayer parses records into objects when the packet is parsed, so its variant measures only the accessors.
+	// DnsView locates records and decodes names on demand, so its variant includes creating the view
+	std::vector<std::unique_ptr<pcpp::Packet>> parsedPackets = parseTraffic(TrafficProfile::Dns);
+	std::vector<pcpp::DnsLayer*> dnsLayers;
+	size_t totalBytes = 0;
+	for (const auto& packet : parsedPackets)
+	{
+		pcpp::DnsLayer* dnsLayer = packet->getLayerOfType<pcpp::DnsLayer>();
+		if (dnsLayer != nullptr)
+		{
+			dnsLayers.push_back(dnsLayer);
+		}
+	}
+
+	size_t totalPackets = 0;
+	size_t layerIndex = 0;
+	char nameBuffer[pcpp::DnsView::NameBufferSize];
+
+	PacketCounters counters;
+	for (auto _ : state)
+	{
+		pcpp::DnsLayer* dnsLayer = dnsLayers[layerIndex];
+		layerIndex = (layerIndex + 1) % dnsLayers.size();
+
+		if (useDnsView)
+		{
+			pcpp::DnsView dnsView(*dnsLayer);
+			pcpp::DnsRecordView record;
+			for (size_t i = 0; dnsView.getRecord(i, record); i++)
+			{
+				dnsView.decodeName(record.nameOffset, nameBuffer, sizeof(nameBuffer));
+				benchmark::DoNotOptimize(nameBuffer[0]);
+				benchmark::DoNotOptimize(record.data);
+			}
+		}
+		else
+		{
+			for (pcpp::DnsQuery* query = dnsLayer->getFirstQuery(); query != nullptr;
+			     query = dnsLayer->getNextQuery(query))
+			{
+				benchmark::DoNotOptimize(query->getName());
+			}
+			for (pcpp::DnsResource* answer = dnsLayer->getFirstAnswer(); answer != nullptr;
+			     answer = dnsLayer->getNextAnswer(answer))
+			{
+				benchmark::DoNotOptimize(answer->getName());
+				benchmark::DoNotOptimize(answer->getData()->toString());
+			}
+		}
+
+		++totalPackets;
+		totalBytes += dnsLayer->getDataLen();
+	}
+	counters.report(state, totalPackets, totalBytes);
+}
+BENCHMARK_CAPTURE(BM_DnsAccessors, dns_layer, false);
+BENCHMARK_CAPTURE(BM_DnsAccessors, dns_view, true);
+
+static void BM_TlsAccessors(benchmark::State& state)
+{
+	std::vector<std::unique_ptr<pcpp::Packet>> parsedPackets = parseTraffic(TrafficProfile::Tls);
+	std::vector<pcpp::SSLClientHelloMessage*> clientHellos;
+	for (const auto& packet : parsedPackets)
+	{
+		pcpp::SSLHandshakeLayer* handshakeLayer = packet->getLayerOfType<pcpp::SSLHandshakeLayer>();
+		if (handshakeLayer == nullptr)
+		{
+			continue;
+		}
+
+		pcpp::SSLClientHelloMessage* clientHello =
+		    handshakeLayer->getHandshakeMessageOfType<pcpp::SSLClientHelloMessage>();
+		if (clientHello != nullptr)
+		{
+			clientHellos.push_back(clientHello);
+		}
+	}
+
+	size_t totalBytes = 0;
+	size_t totalPackets = 0;
+	size_t helloIndex = 0;
+
+	PacketCounters counters;
+	for (auto _ : state)
+	{
+		pcpp::SSLClientHelloMessage* clientHello = clientHellos[helloIndex];
+		helloIndex = (helloIndex + 1) % clientHellos.size();
+
+		pcpp::SSLServerNameIndicationExtension* sniExtension =
+		    clientHello->getExtensionOfType<pcpp::SSLServerNameIndicationExtension>();
+		if (sniExtension != nullptr)
+		{
+			benchmark::DoNotOptimize(sniExtension->getHostName());
+		}
+		for (int i = 0; i < clientHello->getCipherSuiteCount(); i++)
+		{
+			bool isValid = false;
+			benchmark::DoNotOptimize(clientHello->getCipherSuiteID(i, isValid));
+		}
+		benchmark::DoNotOptimize(clientHello->getHandshakeVersion());
+
+		++totalPackets;
+		totalBytes += clientHello->getMessageLength();
+	}
+	counters.report(state, totalPackets, totalBytes);
+}
+BENCHMARK(BM_TlsAccessors);
+
+static void BM_HttpAccessors(benchmark::State& state)
+{
+	std::vector<std::unique_ptr<pcpp::Packet>> parsedPackets = parseTraffic(TrafficProfile::Http);
+	size_t totalBytes = 0;
+	size_t totalPackets = 0;
+	size_t packetIndex = 0;
+
+	PacketCounters counters;
+	for (auto _ : state)
+	{
+		pcpp::Packet* packet = parsedPackets[packetIndex].get();
+		packetIndex = (packetIndex + 1) % parsedPackets.size();
+
+		pcpp::HttpRequestLayer* request = packet->getLayerOfType<pcpp::HttpRequestLayer>();
+		if (request != nullptr)
+		{
+			benchmark::DoNotOptimize(request->getFirstLine()->getUri());
+			pcpp::HeaderField* hostField = request->getFieldByName(PCPP_HTTP_HOST_FIELD);
+			if (hostField != nullptr)
+			{
+				benchmark::DoNotOptimize(hostField->getFieldValue());
+			}
+			totalBytes += request->getDataLen();
+		}
+		else
+		{
+			pcpp::HttpResponseLayer* response = packet->getLayerOfType<pcpp::HttpResponseLayer>();
+			if (response != nullptr)
+			{
+				benchmark::DoNotOptimize(response->getFirstLine()->getStatusCodeAsInt());
+				benchmark::DoNotOptimize(response->getContentLength());
+				totalBytes += response->getDataLen();
+			}
+		}
+
+		++totalPackets;
+	}
+	counters.report(state, totalPackets, totalBytes);
+}
+BENCHMARK(BM_HttpAccessors);
+
+static void BM_SyntheticWrite(benchmark::State& state, bool pcapng)
+{
+	const std::vector<pcpp::RawPacket>& packets = getTraffic(TrafficProfile::Mixed);
+	std::unique_ptr<pcpp::IFileWriterDevice> writer;
+	if (pcapng)
+	{
+		writer.reset(new pcpp::PcapNgFileWriterDevice("benchmark-synthetic.pcapng"));
+	}
+	else
+	{
+		writer.reset(new pcpp::PcapFileWriterDevice("benchmark-synthetic.pcap"));
+	}
+
+	if (!writer->open())
+	{
+		state.SkipWithError("Cannot open the output file for writing");
+		return;
+	}
+
+	size_t totalBytes = 0;
+	size_t totalPackets = 0;
+	size_t packetIndex = 0;
+
+	PacketCounters counters;
+	for (auto _ : state)
+	{
+		const pcpp::RawPacket& rawPacket = packets[packetIndex];
+		packetIndex = (packetIndex + 1) % packets.size();
+
+		writer->writePacket(rawPacket);
+
+		++totalPackets;
+		totalBytes += rawPacket.getRawDataLen();
+	}
+	counters.report(state, totalPackets, totalBytes);
+	writer->close();
+}
+BENCHMARK_CAPTURE(BM_SyntheticWrite, pcap, false);
+BENCHMARK_CAPTURE(BM_SyntheticWrite, pcapng, true);
@@ -13,9 +13,10 @@ class TwoTupleSplitter : public ValueBasedSplitter
 public:
 	/**
 	 * A c'tor for this class that gets the maximum number of files. If this number is lower or equal to 0 it's
-	 * considered not to have a file count limit
+	 * considered not to have a file count limit. The maximum number of concurrent flows is passed to the flow table
 	 */
-	explicit TwoTupleSplitter(int maxFiles) : ValueBasedSplitter(maxFiles)
+	explicit TwoTupleSplitter(int maxFiles, size_t maxNumOfFlows = DefaultMaxNumOfFlows)
+	    : ValueBasedSplitter(maxFiles, maxNumOfFlows)
 	{}
 
 	/**
@@ -24,23 +25,34 @@ public:
 	 */
 	int getFileNumber(pcpp::Packet& packet, std::vector<int>& filesToClose)
 	{
-		// hash the 2-tuple and look for it in the flow table
-		uint32_t hash = pcpp::hash2Tuple(&packet);
+		// build the 2-tuple flow key: the IP addresses only. All packets that aren't IPv4 or IPv6 share the all-zero
+		// key
+		pcpp::FlowKey key;
+		if (key.fromPacket(packet))
+		{
+			key.port1 = 0;
+			key.port2 = 0;
+			key.protocol = 0;
+		}
+
+		// look for the flow in the flow table
+		bool isNewFlow = false;
+		FlowData* flow = getOrCreateFlow(packet, key, isNewFlow);
 
 		// if flow isn't found in the flow table
-		if (m_FlowTable.find(hash) == m_FlowTable.end())
+		if (isNewFlow)
 		{
-			// create a new entry and get a new file number for it
-			m_FlowTable[hash] = getNextFileNumber(filesToClose);
+			// get a new file number for it
+			flow->fileNumber = getNextFileNumber(filesToClose);
 		}
 		else  // flow is found in the 2-tuple flow table
 		{
 			// indicate file is being written because this file may not be in the LRU list (and hence closed),
 			// so we need to put it there, open it, and maybe close another file
-			writingToFile(m_FlowTable[hash], filesToClose);
+			writingToFile(flow->fileNumber, filesToClose);
 		}
 
-		return m_FlowTable[hash];
+		return flow->fileNumber;
 	}
 };
 
@@ -54,10 +66,6 @@ public:
 class FiveTupleSplitter : public ValueBasedSplitter
 {
 private:
-	// a flow table for saving TCP state per flow. Currently the only data that is saved is whether
-	// the last packet seen on the flow was a TCP SYN packet
-	std::unordered_map<uint32_t, bool> m_TcpFlowTable;
-
 	/**
 	 * A utility method that takes a packet and returns true if it's a TCP SYN packet
 	 */
@@ -82,9 +90,10 @@ private:
 public:
 	/**
 	 * A c'tor for this class that gets the maximum number of files. If this number is lower or equal to 0 it's
-	 * considered not to have a file count limit
+	 * considered not to have a file count limit. The maximum number of concurrent flows is passed to the flow table
 	 */
-	explicit FiveTupleSplitter(int maxFiles) : ValueBasedSplitter(maxFiles)
+	explicit FiveTupleSplitter(int maxFiles, size_t maxNumOfFlows = DefaultMaxNumOfFlows)
+	    : ValueBasedSplitter(maxFiles, maxNumOfFlows)
 	{}
 
 	/**
@@ -92,20 +101,26 @@ public:
 	 */
 	int getFileNumber(pcpp::Packet& packet, std::vector<int>& filesToClose)
 	{
-		// hash the 5-tuple and look for it in the flow table
-		uint32_t hash = pcpp::hash5Tuple(&packet);
+		// build the 5-tuple flow key. All packets that aren't IPv4/IPv6 or TCP/UDP share the all-zero key
+		pcpp::FlowKey key;
+		if (packet.isPacketOfType(pcpp::TCP) || packet.isPacketOfType(pcpp::UDP))
+			key.fromPacket(packet);
+
+		// look for the flow in the flow table
+		bool isNewFlow = false;
+		FlowData* flow = getOrCreateFlow(packet, key, isNewFlow);
 
 		// if flow isn't found in the flow table
-		if (m_FlowTable.find(hash) == m_FlowTable.end())
+		if (isNewFlow)
 		{
-			// create a new entry and get a new file number for it
-			m_FlowTable[hash] = getNextFileNumber(filesToClose);
+			// get a new file number for it
+			flow->fileNumber = getNextFileNumber(filesToClose);
 
 			// if this is s a TCP packet check whether it's a SYN packet
-			// and save this data in the TCP flow table
+			// and save this data in the flow table
 			if (packet.isPacketOfType(pcpp::TCP))
 			{
-				m_TcpFlowTable[hash] = isTcpSyn(packet);
+				flow->lastPacketWasTcpSyn = isTcpSyn(packet);
 			}
 		}
 		else  // flow is found in the flow table
@@ -119,29 +134,29 @@ public:
 				//(with the same 5-tuple as the previous one), so assign a new file number to it.
 				// unless the last packet was also SYN, which is an indication of SYN retransmission.
 				// In this case don't assign a new file number
-				if (isSyn && m_TcpFlowTable.find(hash) != m_TcpFlowTable.end() && m_TcpFlowTable[hash] == false)
+				if (isSyn && flow->lastPacketWasTcpSyn == false)
 				{
-					m_FlowTable[hash] = getNextFileNumber(filesToClose);
+					flow->fileNumber = getNextFileNumber(filesToClose);
 				}
 				else
 				{
 					// indicate file is being written because this file may not be in the LRU list (and hence closed),
 					// so we need to put it there, open it, and maybe close another file
-					writingToFile(m_FlowTable[hash], filesToClose);
+					writingToFile(flow->fileNumber, filesToClose);
 				}
 
-				// update the TCP flow table
-				m_TcpFlowTable[hash] = isSyn;
+				// update the TCP state of the flow
+				flow->lastPacketWasTcpSyn = isSyn;
 			}
 			else
 			{
 				// indicate file is being written because this file may not be in the LRU list (and hence closed),
 				// so we need to put it there, open it, and maybe close another file
-				writingToFile(m_FlowTable[hash], filesToClose);
+				writingToFile(flow->fileNumber, filesToClose);
 			}
 		}
 
-		return m_FlowTable[hash];
+		return flow->fileNumber;
 	}
 
 	void updateStringStream(std::ostringstream& sstream, const std::string& srcIp, uint16_t srcPort,
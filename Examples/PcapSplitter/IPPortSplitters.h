@@ -16,7 +16,7 @@ public:
 	/**
 	 * C'tor for this class, does nothing but calling its ancestor
 	 */
-	IPPortSplitter(int maxFiles) : ValueBasedSplitter(maxFiles)
+	IPPortSplitter(int maxFiles, size_t maxNumOfFlows) : ValueBasedSplitter(maxFiles, maxNumOfFlows)
 	{}
 
 	/**
@@ -32,15 +32,20 @@ public:
 			return 0;
 		}
 
-		// hash the 5-tuple and look for it in the flow table
-		uint32_t hash = pcpp::hash5Tuple(&packet);
+		// look for the 5-tuple in the flow table
+		pcpp::FlowKey key;
+		if (!key.fromPacket(packet))
+			return 0;
+
+		bool isNewFlow = false;
+		FlowData* flow = getOrCreateFlow(packet, key, isNewFlow);
 
-		if (m_FlowTable.find(hash) != m_FlowTable.end())
+		if (!isNewFlow)
 		{
-			writingToFile(m_FlowTable[hash], filesToClose);
+			writingToFile(flow->fileNumber, filesToClose);
 
-			// if found it, follow the file number written in the hash record
-			return m_FlowTable[hash];
+			// if found it, follow the file number written in the flow record
+			return flow->fileNumber;
 		}
 
 		// if it's the first packet seen on this flow, try to guess the server port
@@ -59,24 +64,24 @@ public:
 					// SYN packet
 					if (!tcpLayer->getTcpHeader()->ackFlag)
 					{
-						m_FlowTable[hash] =
+						flow->fileNumber =
 						    getFileNumberForValue(getValue(packet, SYN, srcPort, dstPort), filesToClose);
-						return m_FlowTable[hash];
+						return flow->fileNumber;
 					}
 					// SYN/ACK packet
 					else
 					{
-						m_FlowTable[hash] =
+						flow->fileNumber =
 						    getFileNumberForValue(getValue(packet, SYN_ACK, srcPort, dstPort), filesToClose);
-						return m_FlowTable[hash];
+						return flow->fileNumber;
 					}
 				}
 				// Other TCP packet
 				else
 				{
-					m_FlowTable[hash] =
+					flow->fileNumber =
 					    getFileNumberForValue(getValue(packet, TCP_OTHER, srcPort, dstPort), filesToClose);
-					return m_FlowTable[hash];
+					return flow->fileNumber;
 				}
 			}
 		}
@@ -89,8 +94,8 @@ public:
 			{
 				uint16_t srcPort = udpLayer->getSrcPort();
 				uint16_t dstPort = udpLayer->getDstPort();
-				m_FlowTable[hash] = getFileNumberForValue(getValue(packet, UDP, srcPort, dstPort), filesToClose);
-				return m_FlowTable[hash];
+				flow->fileNumber = getFileNumberForValue(getValue(packet, UDP, srcPort, dstPort), filesToClose);
+				return flow->fileNumber;
 			}
 		}
 
@@ -251,7 +256,8 @@ public:
 	/**
 	 * C'tor for this class, does nothing but calling its ancestor
 	 */
-	explicit ClientIPSplitter(int maxFiles) : IPPortSplitter(maxFiles)
+	explicit ClientIPSplitter(int maxFiles, size_t maxNumOfFlows = DefaultMaxNumOfFlows)
+	    : IPPortSplitter(maxFiles, maxNumOfFlows)
 	{}
 
 protected:
@@ -327,7 +333,8 @@ public:
 	/**
 	 * C'tor for this class, does nothing but calling its ancestor
 	 */
-	explicit ServerIPSplitter(int maxFiles) : IPPortSplitter(maxFiles)
+	explicit ServerIPSplitter(int maxFiles, size_t maxNumOfFlows = DefaultMaxNumOfFlows)
+	    : IPPortSplitter(maxFiles, maxNumOfFlows)
 	{}
 
 protected:
@@ -404,7 +411,8 @@ public:
 	/**
 	 * C'tor for this class, does nothing but calling its ancestor
 	 */
-	explicit ServerPortSplitter(int maxFiles) : IPPortSplitter(maxFiles)
+	explicit ServerPortSplitter(int maxFiles, size_t maxNumOfFlows = DefaultMaxNumOfFlows)
+	    : IPPortSplitter(maxFiles, maxNumOfFlows)
 	{}
 
 protected:
@@ -483,7 +491,8 @@ public:
 	/**
 	 * C'tor for this class, does nothing but calling its ancestor
 	 */
-	explicit ClientPortSplitter(int maxFiles) : IPPortSplitter(maxFiles)
+	explicit ClientPortSplitter(int maxFiles, size_t maxNumOfFlows = DefaultMaxNumOfFlows)
+	    : IPPortSplitter(maxFiles, maxNumOfFlows)
 	{}
 
 protected:
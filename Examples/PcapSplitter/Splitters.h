@@ -9,6 +9,7 @@
 #include "UdpLayer.h"
 #include "DnsLayer.h"
 #include "PacketUtils.h"
+#include "FlowTable.h"
 #include <unordered_map>
 #include <algorithm>
 #include <iomanip>
@@ -162,17 +163,73 @@ public:
 class ValueBasedSplitter : public SplitterWithMaxFiles
 {
 protected:
+	/**
+	 * The data kept for each flow in the flow table
+	 */
+	struct FlowData
+	{
+		// the file the packets of the flow are written to
+		int fileNumber;
+		// whether the last packet seen on the flow was a TCP SYN packet
+		bool lastPacketWasTcpSyn;
+
+		FlowData() : fileNumber(0), lastPacketWasTcpSyn(false)
+		{}
+	};
+
 	// A flow table that keeps track of all flows (a flow is usually identified by 5-tuple)
-	std::unordered_map<uint32_t, int> m_FlowTable;
+	pcpp::FlowTable<FlowData> m_FlowTable;
 	// a map between the relevant packet value (e.g client-ip) and the file to write the packet to
 	std::unordered_map<uint32_t, int> m_ValueToFileTable;
+	// the number of flows that were forgotten because the flow table was full
+	uint64_t m_NumOfEvictedFlows;
 
 	/**
-	 * A protected c'tor for this class that only propagate the maxFiles to its ancestor
+	 * A protected c'tor for this class that propagates the maxFiles to its ancestor and creates the flow table
+	 * @param[in] maxFiles The maximum number of files
+	 * @param[in] maxNumOfFlows The maximum number of concurrent flows kept in the flow table. When a capture has more
+	 * concurrent flows the least recently used flow is forgotten, and if it's seen again it's treated as a new flow, so
+	 * its packets may be written to a different file. getNumOfEvictedFlows() tells if it happened
 	 */
-	explicit ValueBasedSplitter(int maxFiles) : SplitterWithMaxFiles(maxFiles, 1)
+	ValueBasedSplitter(int maxFiles, size_t maxNumOfFlows)
+	    : SplitterWithMaxFiles(maxFiles, 1), m_FlowTable(maxNumOfFlows, 0, onFlowEvicted, this), m_NumOfEvictedFlows(0)
 	{}
 
+	/**
+	 * The flow table eviction callback, counts the flows that were forgotten because the flow table was full
+	 */
+	static void onFlowEvicted(const pcpp::FlowKey&, FlowData&, pcpp::FlowEvictionReason reason, void* userCookie)
+	{
+		if (reason == pcpp::FlowTableFull)
+			static_cast<ValueBasedSplitter*>(userCookie)->m_NumOfEvictedFlows++;
+	}
+
+public:
+	// the default maximum number of concurrent flows kept in the flow table
+	static constexpr size_t DefaultMaxNumOfFlows = 250000;
+
+	/**
+	 * @return The number of flows that were forgotten because the flow table was full. If it's not 0, packets of the
+	 * same flow may have been written to different files and the maximum number of flows should be raised
+	 */
+	uint64_t getNumOfEvictedFlows() const
+	{
+		return m_NumOfEvictedFlows;
+	}
+
+protected:
+	/**
+	 * A helper method that finds the flow of a packet in the flow table or creates it
+	 * @param[in] packet The packet, its timestamp is used for the flow table LRU bookkeeping
+	 * @param[in] key The flow key of the packet
+	 * @param[out] isNewFlow Set to true if the flow wasn't in the flow table
+	 * @return The flow data
+	 */
+	FlowData* getOrCreateFlow(pcpp::Packet& packet, const pcpp::FlowKey& key, bool& isNewFlow)
+	{
+		return m_FlowTable.getOrCreateFlow(key, packet.getRawPacketReadOnly()->getPacketTimeStamp(), &isNewFlow);
+	}
+
 	/**
 	 * A helper method that gets the packet value and returns the file to write it to, and also a file to close if the
 	 * LRU list is full
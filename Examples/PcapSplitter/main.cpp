@@ -35,7 +35,7 @@
  * - Options 3-7 supports both IPv4 and IPV6
  * - Number of output files isn't limited, unless the user set such limit in options 3-7
  * - There is no limit on the size of the input file, the number of packets it contains or the number of connections it
- *   contains
+ *   contains. Options 3-7 keep track of up to 250000 concurrent connections by default, which can be changed with -c
  * - The user can also set a BPF filter to instruct the application to handle only packets filtered by the filter. The
  *   rest of the packets in the input file will be ignored
  * - In options 3-5 & 7 all packets which aren't UDP or TCP (hence don't belong to any connection) will be written to
@@ -64,6 +64,7 @@ static struct option PcapSplitterOptions[] = {
 	{ "method",      required_argument, nullptr, 'm' },
 	{ "param",       required_argument, nullptr, 'p' },
 	{ "filter",      required_argument, nullptr, 'i' },
+	{ "max-flows",   required_argument, nullptr, 'c' },
 	{ "version",     no_argument,       nullptr, 'v' },
 	{ "help",        no_argument,       nullptr, 'h' },
 	{ nullptr,       0,                 nullptr, 0   }
@@ -103,8 +104,9 @@ void printUsage()
 	    << std::endl
 	    << "Usage:" << std::endl
 	    << "------" << std::endl
-	    << pcpp::AppName::get() << " [-h] [-v] [-i filter] -f pcap_file -o output_dir -m split_method [-p split_param]"
+	    << pcpp::AppName::get() << " [-h] [-v] [-i filter] [-c max_flows] -f pcap_file -o output_dir -m split_method"
 	    << std::endl
+	    << "           [-p split_param]" << std::endl
 	    << std::endl
 	    << "Options:" << std::endl
 	    << std::endl
@@ -164,6 +166,14 @@ void printUsage()
 	    << std::endl
 	    << "    -i filter       : Apply a BPF filter, meaning only filtered packets will be counted in the split"
 	    << std::endl
+	    << "    -c max_flows    : The maximum number of concurrent connections tracked by the client-ip, server-ip,"
+	    << std::endl
+	    << "                      server-port, client-port, ip-src-dst and connection methods. When there are more"
+	    << std::endl
+	    << "                      the least recently active connection is forgotten, and its next packets may be"
+	    << std::endl
+	    << "                      written to a different file. The default is "
+	    << ValueBasedSplitter::DefaultMaxNumOfFlows << std::endl
 	    << "    -v              : Displays the current version and exists" << std::endl
 	    << "    -h              : Displays this help message and exits" << std::endl
 	    << std::endl;
@@ -238,10 +248,12 @@ int main(int argc, char* argv[])
 
 	bool paramWasSet = false;
 
+	size_t maxNumOfFlows = ValueBasedSplitter::DefaultMaxNumOfFlows;
+
 	int optionIndex = 0;
 	int opt = 0;
 
-	while ((opt = getopt_long(argc, argv, "f:o:m:p:i:vh", PcapSplitterOptions, &optionIndex)) != -1)
+	while ((opt = getopt_long(argc, argv, "f:o:m:p:i:c:vh", PcapSplitterOptions, &optionIndex)) != -1)
 	{
 		switch (opt)
 		{
@@ -263,6 +275,9 @@ int main(int argc, char* argv[])
 		case 'i':
 			filter = optarg;
 			break;
+		case 'c':
+			maxNumOfFlows = strtoull(optarg, nullptr, 10);
+			break;
 		case 'h':
 			printUsage();
 			exit(0);
@@ -295,6 +310,11 @@ int main(int argc, char* argv[])
 		EXIT_WITH_ERROR("Split method was not given");
 	}
 
+	if (maxNumOfFlows == 0)
+	{
+		EXIT_WITH_ERROR("Max number of flows must be a positive number");
+	}
+
 	std::unique_ptr<Splitter> splitter;
 
 	// decide of the splitter to use, according to the user's choice
@@ -311,32 +331,32 @@ int main(int argc, char* argv[])
 	else if (method == SPLIT_BY_IP_CLIENT)
 	{
 		int paramAsInt = (paramWasSet ? atoi(param) : SplitterWithMaxFiles::UNLIMITED_FILES_MAGIC_NUMBER);
-		splitter.reset(new ClientIPSplitter(paramAsInt));
+		splitter.reset(new ClientIPSplitter(paramAsInt, maxNumOfFlows));
 	}
 	else if (method == SPLIT_BY_IP_SERVER)
 	{
 		int paramAsInt = (paramWasSet ? atoi(param) : SplitterWithMaxFiles::UNLIMITED_FILES_MAGIC_NUMBER);
-		splitter.reset(new ServerIPSplitter(paramAsInt));
+		splitter.reset(new ServerIPSplitter(paramAsInt, maxNumOfFlows));
 	}
 	else if (method == SPLIT_BY_SERVER_PORT)
 	{
 		int paramAsInt = (paramWasSet ? atoi(param) : SplitterWithMaxFiles::UNLIMITED_FILES_MAGIC_NUMBER);
-		splitter.reset(new ServerPortSplitter(paramAsInt));
+		splitter.reset(new ServerPortSplitter(paramAsInt, maxNumOfFlows));
 	}
 	else if (method == SPLIT_BY_CLIENT_PORT)
 	{
 		int paramAsInt = (paramWasSet ? atoi(param) : SplitterWithMaxFiles::UNLIMITED_FILES_MAGIC_NUMBER);
-		splitter.reset(new ClientPortSplitter(paramAsInt));
+		splitter.reset(new ClientPortSplitter(paramAsInt, maxNumOfFlows));
 	}
 	else if (method == SPLIT_BY_2_TUPLE)
 	{
 		int paramAsInt = (paramWasSet ? atoi(param) : SplitterWithMaxFiles::UNLIMITED_FILES_MAGIC_NUMBER);
-		splitter.reset(new TwoTupleSplitter(paramAsInt));
+		splitter.reset(new TwoTupleSplitter(paramAsInt, maxNumOfFlows));
 	}
 	else if (method == SPLIT_BY_5_TUPLE)
 	{
 		int paramAsInt = (paramWasSet ? atoi(param) : SplitterWithMaxFiles::UNLIMITED_FILES_MAGIC_NUMBER);
-		splitter.reset(new FiveTupleSplitter(paramAsInt));
+		splitter.reset(new FiveTupleSplitter(paramAsInt, maxNumOfFlows));
 	}
 	else if (method == SPLIT_BY_BPF_FILTER)
 	{
@@ -476,6 +496,16 @@ int main(int argc, char* argv[])
 	std::cout << "Finished. Read and written " << packetCountSoFar << " packets to " << numOfFiles << " files"
 	          << std::endl;
 
+	// warn if connections were forgotten, since their packets may have been split between files
+	ValueBasedSplitter* valueBasedSplitter = dynamic_cast<ValueBasedSplitter*>(splitter.get());
+	if (valueBasedSplitter != nullptr && valueBasedSplitter->getNumOfEvictedFlows() > 0)
+	{
+		std::cout << "WARNING: " << valueBasedSplitter->getNumOfEvictedFlows()
+		          << " connections were forgotten because more than " << maxNumOfFlows
+		          << " connections were active at the same time, so some connections may be split between files."
+		          << " Use -c to raise the limit" << std::endl;
+	}
+
 	// close the reader file
 	reader->close();
 
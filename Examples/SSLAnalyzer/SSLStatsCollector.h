@@ -5,7 +5,7 @@
 #include "TcpLayer.h"
 #include "IPv4Layer.h"
 #include "PayloadLayer.h"
-#include "PacketUtils.h"
+#include "FlowTable.h"
 #include "SSLLayer.h"
 #include "SystemUtils.h"
 
@@ -130,7 +130,7 @@ public:
 	/**
 	 * C'tor - clear all structures
 	 */
-	SSLStatsCollector()
+	SSLStatsCollector() : m_FlowTable(MaxNumOfFlows, FlowIdleTimeoutSec)
 	{
 		clear();
 	}
@@ -145,12 +145,12 @@ public:
 			return;
 
 		// collect general SSL traffic stats on this packet
-		uint32_t hashVal = collectSSLTrafficStats(sslPacket);
+		SSLFlowData* flowData = collectSSLTrafficStats(sslPacket);
 
 		// if packet contains one or more SSL messages, collect stats on them
-		if (sslPacket->isPacketOfType(pcpp::SSL))
+		if (flowData != nullptr && sslPacket->isPacketOfType(pcpp::SSL))
 		{
-			collectSSLStats(sslPacket, hashVal);
+			collectSSLStats(sslPacket, *flowData);
 		}
 
 		// calculate current sample time which is the time-span from start time until current time
@@ -266,9 +266,9 @@ private:
 
 	/**
 	 * Collect stats relevant for every SSL packet (any SSL message)
-	 * This method calculates and returns the flow key for this packet
+	 * This method finds and returns the flow data of this packet
 	 */
-	uint32_t collectSSLTrafficStats(pcpp::Packet* sslpPacket)
+	SSLFlowData* collectSSLTrafficStats(pcpp::Packet* sslpPacket)
 	{
 		pcpp::TcpLayer* tcpLayer = sslpPacket->getLayerOfType<pcpp::TcpLayer>();
 
@@ -278,11 +278,14 @@ private:
 		// count packet num
 		m_GeneralStats.numOfSSLPackets++;
 
-		// calculate a hash key for this flow to be used in the flow table
-		uint32_t hashVal = hash5Tuple(sslpPacket);
+		// find the flow of this packet in the flow table or create it
+		bool isNewFlow = false;
+		SSLFlowData* flowData = m_FlowTable.getOrCreateFlow(*sslpPacket, &isNewFlow);
+		if (flowData == nullptr)
+			return nullptr;
 
-		// if flow is a new flow (meaning it's not already in the flow table)
-		if (m_FlowTable.find(hashVal) == m_FlowTable.end())
+		// if flow is a new flow (meaning it wasn't already in the flow table)
+		if (isNewFlow)
 		{
 			// count this new flow
 			m_GeneralStats.numOfSSLFlows++;
@@ -295,25 +298,26 @@ private:
 			else
 				m_GeneralStats.sslPortCount[dstPort]++;
 
-			m_FlowTable[hashVal].clear();
+			flowData->clear();
 		}
 
-		// calculate averages
-		if (m_FlowTable.size() != 0)
+		// calculate averages. Idle flows are evicted from the flow table so the averages are calculated over all
+		// flows seen so far
+		if (m_GeneralStats.numOfSSLFlows != 0)
 		{
-			m_GeneralStats.averageAmountOfDataPerFlow =
-			    static_cast<double>(m_GeneralStats.amountOfSSLTraffic) / static_cast<double>(m_FlowTable.size());
-			m_GeneralStats.averageNumOfPacketsPerFlow =
-			    static_cast<double>(m_GeneralStats.numOfSSLPackets) / static_cast<double>(m_FlowTable.size());
+			m_GeneralStats.averageAmountOfDataPerFlow = static_cast<double>(m_GeneralStats.amountOfSSLTraffic) /
+			                                            static_cast<double>(m_GeneralStats.numOfSSLFlows);
+			m_GeneralStats.averageNumOfPacketsPerFlow = static_cast<double>(m_GeneralStats.numOfSSLPackets) /
+			                                            static_cast<double>(m_GeneralStats.numOfSSLFlows);
 		}
 
-		return hashVal;
+		return flowData;
 	}
 
 	/**
 	 * Collect stats relevant for several kinds SSL messages
 	 */
-	void collectSSLStats(pcpp::Packet* sslPacket, uint32_t flowKey)
+	void collectSSLStats(pcpp::Packet* sslPacket, SSLFlowData& flowData)
 	{
 		// go over all SSL messages in this packet
 		pcpp::SSLLayer* sslLayer = sslPacket->getLayerOfType<pcpp::SSLLayer>();
@@ -324,10 +328,10 @@ private:
 			if (recType == pcpp::SSL_ALERT)
 			{
 				// if it's the first alert seen in this flow
-				if (m_FlowTable[flowKey].seenAlertPacket == false)
+				if (flowData.seenAlertPacket == false)
 				{
 					m_GeneralStats.numOfFlowsWithAlerts++;
-					m_FlowTable[flowKey].seenAlertPacket = true;
+					flowData.seenAlertPacket = true;
 				}
 			}
 
@@ -335,10 +339,10 @@ private:
 			else if (recType == pcpp::SSL_APPLICATION_DATA)
 			{
 				// if it's the first app data message seen on this flow it means handshake was completed
-				if (m_FlowTable[flowKey].seenAppDataPacket == false)
+				if (flowData.seenAppDataPacket == false)
 				{
 					m_GeneralStats.numOfHandshakeCompleteFlows++;
-					m_FlowTable[flowKey].seenAppDataPacket = true;
+					flowData.seenAppDataPacket = true;
 				}
 			}
 
@@ -416,7 +420,11 @@ private:
 	ServerHelloStats m_ServerHelloStats;
 	ServerHelloStats m_PrevServerHelloStats;
 
-	std::unordered_map<uint32_t, SSLFlowData> m_FlowTable;
+	// the maximum number of concurrent flows and the time after which a flow with no packets is forgotten
+	static constexpr size_t MaxNumOfFlows = 200000;
+	static constexpr uint32_t FlowIdleTimeoutSec = 600;
+
+	pcpp::FlowTable<SSLFlowData> m_FlowTable;
 
 	double m_LastCalcRateTime;
 	double m_StartTime;
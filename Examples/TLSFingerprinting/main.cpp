@@ -20,7 +20,7 @@
 #include "IPLayer.h"
 #include "TcpLayer.h"
 #include "SSLLayer.h"
-#include "SSLHandshake.h"
+#include "TLSFingerprint.h"
 #include "PcapPlusPlusVersion.h"
 #include "PcapLiveDeviceList.h"
 #include "PcapFileDevice.h"
@@ -326,55 +326,48 @@ void printStats(const TLSFingerprintingStats& stats, bool chFP, bool shFP)
  */
 void handlePacket(pcpp::RawPacket* rawPacket, const HandlePacketData* data)
 {
-	pcpp::Packet parsedPacket(rawPacket);
+	// parse only up to the TCP layer, the TLS fingerprints are computed directly from the TCP payload
+	pcpp::Packet parsedPacket(rawPacket, pcpp::TCP);
 	data->stats->numOfPacketsTotal++;
-	if (parsedPacket.isPacketOfType(pcpp::SSL))
+
+	pcpp::TcpLayer* tcpLayer = parsedPacket.getLayerOfType<pcpp::TcpLayer>();
+	if (tcpLayer == nullptr ||
+	    (!pcpp::SSLLayer::isSSLPort(tcpLayer->getSrcPort()) && !pcpp::SSLLayer::isSSLPort(tcpLayer->getDstPort())))
+		return;
+
+	const uint8_t* payload = tcpLayer->getLayerPayload();
+	size_t payloadLen = tcpLayer->getLayerPayloadSize();
+
+	// if user requested to extract ClientHello TLS fingerprint
+	if (data->chFP)
+	{
+		pcpp::TLSClientHelloFingerprint tlsFingerprint;
+		if (pcpp::TLSFingerprintScanner::scanClientHello(payload, payloadLen, tlsFingerprint) ==
+		    pcpp::TLSFingerprintScanner::ScanResult::Success)
+		{
+			data->stats->numOfCHPackets++;
+			data->stats->chFingerprints[tlsFingerprint.ja3Hash]++;
+			// write data to output file
+			writeToOutputFile(data->outputFile, parsedPacket,
+			                  std::string(tlsFingerprint.ja3, tlsFingerprint.ja3Length), tlsFingerprint.ja3Hash,
+			                  "ClientHello", data->separator);
+			return;
+		}
+	}
+
+	// if user requested to extract ServerHello TLS fingerprint
+	if (data->shFP)
 	{
-		// extract the SSL/TLS handhsake layer
-		pcpp::SSLHandshakeLayer* sslHandshakeLayer = parsedPacket.getLayerOfType<pcpp::SSLHandshakeLayer>();
-		if (sslHandshakeLayer != nullptr)
+		pcpp::TLSServerHelloFingerprint tlsFingerprint;
+		if (pcpp::TLSFingerprintScanner::scanServerHello(payload, payloadLen, tlsFingerprint) ==
+		    pcpp::TLSFingerprintScanner::ScanResult::Success)
 		{
-			// if user requested to extract ClientHello TLS fingerprint
-			if (data->chFP)
-			{
-				// check if the SSL/TLS handhsake layer contains a ClientHello message
-				pcpp::SSLClientHelloMessage* clientHelloMessage =
-				    sslHandshakeLayer->getHandshakeMessageOfType<pcpp::SSLClientHelloMessage>();
-				if (clientHelloMessage != nullptr)
-				{
-					data->stats->numOfCHPackets++;
-
-					// extract the TLS fingerprint
-					pcpp::SSLClientHelloMessage::ClientHelloTLSFingerprint tlsFingerprint =
-					    clientHelloMessage->generateTLSFingerprint();
-					std::pair<std::string, std::string> tlsFingerprintStringAndMD5 = tlsFingerprint.toStringAndMD5();
-					data->stats->chFingerprints[tlsFingerprintStringAndMD5.second]++;
-					// write data to output file
-					writeToOutputFile(data->outputFile, parsedPacket, tlsFingerprintStringAndMD5.first,
-					                  tlsFingerprintStringAndMD5.second, "ClientHello", data->separator);
-					return;
-				}
-			}
-			// if user requested to extract ServerHello TLS fingerprint
-			if (data->shFP)
-			{
-				// check if the SSL/TLS handhsake layer contains a ServerHello message
-				pcpp::SSLServerHelloMessage* servertHelloMessage =
-				    sslHandshakeLayer->getHandshakeMessageOfType<pcpp::SSLServerHelloMessage>();
-				if (servertHelloMessage != nullptr)
-				{
-					data->stats->numOfSHPackets++;
-
-					// extract the TLS fingerprint
-					pcpp::SSLServerHelloMessage::ServerHelloTLSFingerprint tlsFingerprint =
-					    servertHelloMessage->generateTLSFingerprint();
-					std::pair<std::string, std::string> tlsFingerprintStringAndMD5 = tlsFingerprint.toStringAndMD5();
-					data->stats->shFingerprints[tlsFingerprintStringAndMD5.second]++;
-					// write data to output file
-					writeToOutputFile(data->outputFile, parsedPacket, tlsFingerprintStringAndMD5.first,
-					                  tlsFingerprintStringAndMD5.second, "ServerHello", data->separator);
-				}
-			}
+			data->stats->numOfSHPackets++;
+			data->stats->shFingerprints[tlsFingerprint.ja3sHash]++;
+			// write data to output file
+			writeToOutputFile(data->outputFile, parsedPacket,
+			                  std::string(tlsFingerprint.ja3s, tlsFingerprint.ja3sLength), tlsFingerprint.ja3sHash,
+			                  "ServerHello", data->separator);
 		}
 	}
 }
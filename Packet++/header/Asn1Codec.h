@@ -4,6 +4,7 @@
 #include <memory>
 #include <typeinfo>
 #include <stdexcept>
+#include <vector>
 #include "PointerVector.h"
 
 /// @file
@@ -579,4 +580,391 @@ namespace pcpp
 			return {};
 		}
 	};
+
+	/**
+	 * @struct Asn1Element
+	 * A view of an ASN.1 element returned by Asn1Reader. It doesn't own or copy any data: the value points into the
+	 * buffer the reader was created with
+	 */
+	struct Asn1Element
+	{
+		/** The tag class */
+		Asn1TagClass tagClass;
+		/** True if the element is constructed (contains other elements), false if it's primitive */
+		bool isConstructed;
+		/** The tag type (tag number) */
+		uint8_t tagType;
+		/** The number of constructed elements that contain this element within the data the reader was created with */
+		size_t depth;
+		/** The offset of the element from the start of the data the reader was created with */
+		size_t offset;
+		/** The length of the tag and length fields */
+		size_t headerLength;
+		/** A pointer to the value */
+		const uint8_t* value;
+		/** The value length */
+		size_t valueLength;
+
+		/**
+		 * @return The universal tag type if the tag class is Universal, otherwise Asn1UniversalTagType#NotApplicable
+		 */
+		Asn1UniversalTagType getUniversalTagType() const
+		{
+			return tagClass == Asn1TagClass::Universal ? static_cast<Asn1UniversalTagType>(tagType)
+			                                           : Asn1UniversalTagType::NotApplicable;
+		}
+
+		/**
+		 * @return The total length of the element: tag, length and value
+		 */
+		size_t getTotalLength() const
+		{
+			return headerLength + valueLength;
+		}
+
+		/**
+		 * @param[in] tagClass A tag class
+		 * @param[in] isConstructed Whether the element should be constructed
+		 * @param[in] tagType A tag type
+		 * @return True if the element has this tag
+		 */
+		bool hasTag(Asn1TagClass tagClass, bool isConstructed, uint8_t tagType) const
+		{
+			return this->tagClass == tagClass && this->isConstructed == isConstructed && this->tagType == tagType;
+		}
+
+		/**
+		 * @param[in] tagType A universal tag type
+		 * @param[in] isConstructed Whether the element should be constructed
+		 * @return True if the element has this universal tag
+		 */
+		bool hasTag(Asn1UniversalTagType tagType, bool isConstructed) const
+		{
+			return hasTag(Asn1TagClass::Universal, isConstructed, static_cast<uint8_t>(tagType));
+		}
+
+		/**
+		 * Decode the value of an Integer or Enumerated element the same way Asn1IntegerRecord does
+		 * @param[out] result The value
+		 * @return False if the element is constructed or its value isn't 1 to 4 bytes long
+		 */
+		bool getIntegerValue(uint32_t& result) const;
+
+		/**
+		 * Decode the value of a Boolean element
+		 * @param[out] result The value
+		 * @return False if the element is constructed or its value length isn't 1
+		 */
+		bool getBooleanValue(bool& result) const;
+
+		/**
+		 * Find a sub-element of a constructed element
+		 * @param[in] index The index of the sub-element
+		 * @param[out] result The sub-element. Its depth and offset are relative to this element's value
+		 * @return False if this element isn't constructed, has less sub-elements or a sub-element before the
+		 * requested one is malformed
+		 */
+		bool getSubElement(size_t index, Asn1Element& result) const;
+	};
+
+	/**
+	 * @class Asn1Reader
+	 * A pull parser for BER-encoded (and therefore DER-encoded) ASN.1 data that doesn't allocate memory or build
+	 * records. Each call to next() returns an event: the start of an element, whose fields are available through
+	 * getElement(), or the end of the constructed element that was entered last. Constructed elements are entered
+	 * automatically, call skip() right after one is returned to step over its content instead.<BR>
+	 * Only the definite length form is supported, which is the only one DER and LDAP allow. Tag types up to 255 are
+	 * supported, and nesting is limited to Asn1Reader::MaxDepth levels. Sub-elements must fit inside the element that
+	 * contains them. After an error the reader keeps returning Event::Error
+	 *
+	 * Here is an example that prints the tree of the data:
+	 * @code
+	 * pcpp::Asn1Reader reader(data, dataLen);
+	 * pcpp::Asn1Reader::Event event;
+	 * while ((event = reader.next()) == pcpp::Asn1Reader::Event::Element ||
+	 *        event == pcpp::Asn1Reader::Event::EndOfConstructed)
+	 * {
+	 *     if (event == pcpp::Asn1Reader::Event::Element)
+	 *         std::cout << std::string(reader.getElement().depth * 2, ' ') << (int)reader.getElement().tagType
+	 *                   << std::endl;
+	 * }
+	 * @endcode
+	 */
+	class Asn1Reader
+	{
+	public:
+		/** The maximum number of constructed elements that can be entered at the same time */
+		static constexpr size_t MaxDepth = 32;
+
+		/**
+		 * @enum Event
+		 * An event returned by next()
+		 */
+		enum class Event
+		{
+			/** An element starts. Its fields are available through getElement() */
+			Element,
+			/** The constructed element that was entered last ends */
+			EndOfConstructed,
+			/** All the data was read */
+			EndOfData,
+			/** The data is malformed or nested too deep */
+			Error
+		};
+
+		/**
+		 * A c'tor for this class
+		 * @param[in] data The data to read, starting with an ASN.1 element
+		 * @param[in] dataLen The data length
+		 */
+		Asn1Reader(const uint8_t* data, size_t dataLen);
+
+		/**
+		 * Read the next event
+		 * @return The event
+		 */
+		Event next();
+
+		/**
+		 * Skip the content of the constructed element that was just returned, so that the next event is the element
+		 * that follows it or the end of the element that contains it. Skipping a primitive element does nothing
+		 * @return False if the last event isn't Event::Element
+		 */
+		bool skip();
+
+		/**
+		 * @return The last element returned by next()
+		 */
+		const Asn1Element& getElement() const
+		{
+			return m_Element;
+		}
+
+		/**
+		 * @return The number of constructed elements currently entered
+		 */
+		size_t getDepth() const
+		{
+			return m_Depth;
+		}
+
+		/**
+		 * @return The offset of the next element from the start of the data
+		 */
+		size_t getOffset() const
+		{
+			return m_Offset;
+		}
+
+		/**
+		 * @return True if the reader encountered an error
+		 */
+		bool hasError() const
+		{
+			return m_HasError;
+		}
+
+		/**
+		 * Decode the tag and length of the element at the start of data without reading its value
+		 * @param[in] data The data
+		 * @param[in] dataLen The data length
+		 * @param[out] result The element, with depth and offset 0
+		 * @return False if the data doesn't start with a well-formed element that it contains entirely
+		 */
+		static bool readElement(const uint8_t* data, size_t dataLen, Asn1Element& result);
+
+	private:
+		const uint8_t* m_Data;
+		size_t m_DataLen;
+		size_t m_Offset;
+		size_t m_Depth;
+		size_t m_EndOffsets[MaxDepth];
+		Asn1Element m_Element;
+		bool m_CanSkip;
+		bool m_HasError;
+
+		Event fail();
+	};
+
+	/**
+	 * @class Asn1Writer
+	 * An encoder that writes ASN.1 elements into a single buffer, as opposed to Asn1Record#encode() that creates a
+	 * vector for every record. The length of a constructed element isn't known when it's started, so the longest
+	 * length field is reserved for it and the length is written when the element ends. The unused bytes of the
+	 * reserved fields are removed in a single pass when the outermost element ends, so the data is moved once no
+	 * matter how deep the elements are nested. The encoding is the same as Asn1Record#encode(): lengths use the
+	 * minimal form, and integers use the minimal number of bytes for their unsigned value. The value of a
+	 * constructed element must be shorter than 4GB.<BR>
+	 * Ending an element that wasn't started, or nesting more than Asn1Writer::MaxDepth elements, throws
+	 * std::runtime_error
+	 */
+	class Asn1Writer
+	{
+	public:
+		/** The maximum number of constructed elements that can be started and not yet ended */
+		static constexpr size_t MaxDepth = 32;
+
+		/**
+		 * A c'tor for this class
+		 * @param[in] initialCapacity The number of bytes to reserve in the buffer
+		 */
+		explicit Asn1Writer(size_t initialCapacity = 256);
+
+		/**
+		 * Start a constructed element. Elements written until endConstructed() is called are its content
+		 * @param[in] tagClass The tag class
+		 * @param[in] tagType The tag type
+		 */
+		void beginConstructed(Asn1TagClass tagClass, uint8_t tagType);
+
+		/**
+		 * Start a Sequence element
+		 */
+		void beginSequence()
+		{
+			beginConstructed(Asn1TagClass::Universal, static_cast<uint8_t>(Asn1UniversalTagType::Sequence));
+		}
+
+		/**
+		 * Start a Set element
+		 */
+		void beginSet()
+		{
+			beginConstructed(Asn1TagClass::Universal, static_cast<uint8_t>(Asn1UniversalTagType::Set));
+		}
+
+		/**
+		 * End the constructed element that was started last and write its length
+		 */
+		void endConstructed();
+
+		/**
+		 * Write a primitive element
+		 * @param[in] tagClass The tag class
+		 * @param[in] tagType The tag type
+		 * @param[in] value The value
+		 * @param[in] valueLen The value length
+		 */
+		void writePrimitive(Asn1TagClass tagClass, uint8_t tagType, const uint8_t* value, size_t valueLen);
+
+		/**
+		 * Write an Integer element
+		 * @param[in] value The value
+		 */
+		void writeInteger(uint32_t value)
+		{
+			writeIntegerElement(Asn1UniversalTagType::Integer, value);
+		}
+
+		/**
+		 * Write an Enumerated element
+		 * @param[in] value The value
+		 */
+		void writeEnumerated(uint32_t value)
+		{
+			writeIntegerElement(Asn1UniversalTagType::Enumerated, value);
+		}
+
+		/**
+		 * Write a Boolean element
+		 * @param[in] value The value
+		 */
+		void writeBoolean(bool value);
+
+		/**
+		 * Write an Octet String element
+		 * @param[in] value The value
+		 * @param[in] valueLen The value length
+		 */
+		void writeOctetString(const uint8_t* value, size_t valueLen)
+		{
+			writePrimitive(Asn1TagClass::Universal, static_cast<uint8_t>(Asn1UniversalTagType::OctetString), value,
+			               valueLen);
+		}
+
+		/**
+		 * Write an Octet String element
+		 * @param[in] value The value
+		 */
+		void writeOctetString(const std::string& value)
+		{
+			writeOctetString(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+		}
+
+		/**
+		 * Write a Null element
+		 */
+		void writeNull()
+		{
+			writePrimitive(Asn1TagClass::Universal, static_cast<uint8_t>(Asn1UniversalTagType::Null), nullptr, 0);
+		}
+
+		/**
+		 * Append data that is already encoded, for example the result of Asn1Record#encode()
+		 * @param[in] data The encoded data
+		 * @param[in] dataLen The data length
+		 */
+		void writeEncoded(const uint8_t* data, size_t dataLen);
+
+		/**
+		 * @return The number of constructed elements started and not yet ended
+		 */
+		size_t getDepth() const
+		{
+			return m_Depth;
+		}
+
+		/**
+		 * @return The encoded data. It's final only when all constructed elements were ended
+		 */
+		const uint8_t* getData() const
+		{
+			return m_Buffer.data();
+		}
+
+		/**
+		 * @return The encoded data length
+		 */
+		size_t getDataLen() const
+		{
+			return m_Buffer.size();
+		}
+
+		/**
+		 * @return The encoded data
+		 */
+		const std::vector<uint8_t>& getBuffer() const
+		{
+			return m_Buffer;
+		}
+
+		/**
+		 * Clear the buffer and the started elements so the writer can be reused
+		 */
+		void clear();
+
+	private:
+		// the length field reserved for a constructed element: the long form with 4 length bytes
+		static constexpr size_t ReservedLengthFieldSize = 5;
+
+		// unused bytes of a reserved length field, which are removed when the outermost element ends
+		struct Gap
+		{
+			size_t offset;
+			size_t length;
+		};
+
+		std::vector<uint8_t> m_Buffer;
+		size_t m_Depth;
+		size_t m_LengthOffsets[MaxDepth];
+		// the total length of the gaps when each started element began
+		size_t m_GapBytesAtBegin[MaxDepth];
+		std::vector<Gap> m_Gaps;
+		size_t m_GapBytes;
+
+		void removeGaps();
+		void writeTag(Asn1TagClass tagClass, bool isConstructed, uint8_t tagType);
+		void writeLength(size_t length);
+		void writeIntegerElement(Asn1UniversalTagType tagType, uint32_t value);
+	};
 }  // namespace pcpp
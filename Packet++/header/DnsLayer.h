@@ -95,6 +95,7 @@ namespace pcpp
 		friend class IDnsResource;
 		friend class DnsQuery;
 		friend class DnsResource;
+		friend class DnsView;
 
 	public:
 		/**
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "DnsLayerEnums.h"
+
+/// @file
+
+/**
+ * \namespace pcpp
+ * \brief The main namespace for the PcapPlusPlus lib
+ */
+namespace pcpp
+{
+	struct dnshdr;
+	class DnsLayer;
+
+	/**
+	 * @struct DnsRecordView
+	 * A DNS record (query or resource) as returned by DnsView. It contains the record fields and offsets into the DNS
+	 * message, and points directly to the message data
+	 */
+	struct DnsRecordView
+	{
+		/** The section the record belongs to */
+		DnsResourceType resourceType;
+		/** The offset of the record from the start of the DNS message */
+		size_t recordOffset;
+		/** The offset of the record name from the start of the DNS message. Use it with DnsView#decodeName() */
+		size_t nameOffset;
+		/** The record DNS type */
+		DnsType dnsType;
+		/** The record DNS class. For OPT records this is the requestor's UDP payload size */
+		DnsClass dnsClass;
+		/** The record TTL, or 0 for queries */
+		uint32_t ttl;
+		/** The offset of the record data from the start of the DNS message, or 0 for queries */
+		size_t dataOffset;
+		/** A pointer to the record data, or nullptr for queries */
+		const uint8_t* data;
+		/** The record data length, or 0 for queries */
+		size_t dataLength;
+		/** The total size of the record in bytes */
+		size_t size;
+	};
+
+	/**
+	 * @class DnsView
+	 * A read-only, zero-copy view of a DNS message. Unlike DnsLayer, which parses all records into heap-allocated
+	 * objects and decodes all of their names when it's created, DnsView locates records lazily when they are requested
+	 * and decodes names only on demand into a buffer supplied by the caller. The offsets of the first
+	 * DnsView::MaxIndexedRecords records are kept in an inline array, and the decoded text of compression pointer
+	 * targets is memoized in an inline cache, so repeated lookups don't re-walk the message.<BR>
+	 * All accesses are bounds-checked. Compression pointers must point backwards, before the start of the label
+	 * sequence they appear in, which guarantees decoding terminates, and the encoded name length is limited to 255
+	 * bytes (RFC 1035). Names are compared case-insensitively as DNS requires.<BR>
+	 * DnsView doesn't allocate memory and doesn't copy the message, so the data must outlive the view. Because lookups
+	 * update the index and cache, a DnsView object must not be used by several threads concurrently
+	 */
+	class DnsView
+	{
+	public:
+		/** The number of record offsets kept in the inline index */
+		static constexpr size_t MaxIndexedRecords = 32;
+		/** The number of compression pointer targets memoized in the name cache */
+		static constexpr size_t NameCacheSize = 16;
+		/** A buffer of this size is always large enough for a decoded name and its terminating null */
+		static constexpr size_t NameBufferSize = 256;
+
+		/**
+		 * A c'tor for this class
+		 * @param[in] data A pointer to a DNS message, starting at the DNS header
+		 * @param[in] dataLen The message length. A DNS message is at most 65535 bytes long, data beyond that is
+		 * ignored
+		 */
+		DnsView(const uint8_t* data, size_t dataLen);
+
+		/**
+		 * A c'tor that creates a view of the DNS message in a DnsLayer or DnsOverTcpLayer. The view points to the
+		 * layer data and is invalidated when the layer is modified
+		 * @param[in] dnsLayer The DNS layer
+		 */
+		explicit DnsView(const DnsLayer& dnsLayer);
+
+		/**
+		 * @return True if the data is long enough to contain a DNS header
+		 */
+		bool isValid() const
+		{
+			return m_Data != nullptr;
+		}
+
+		/**
+		 * @return A pointer to the DNS header, or nullptr if the view isn't valid
+		 */
+		const dnshdr* getDnsHeader() const;
+
+		/**
+		 * @return A pointer to the DNS message
+		 */
+		const uint8_t* getData() const
+		{
+			return m_Data;
+		}
+
+		/**
+		 * @return The DNS message length
+		 */
+		size_t getDataLen() const
+		{
+			return m_DataLen;
+		}
+
+		/**
+		 * @return The number of queries in the DNS header
+		 */
+		size_t getQueryCount() const;
+
+		/**
+		 * @return The number of answers in the DNS header
+		 */
+		size_t getAnswerCount() const;
+
+		/**
+		 * @return The number of authorities in the DNS header
+		 */
+		size_t getAuthorityCount() const;
+
+		/**
+		 * @return The number of additional records in the DNS header
+		 */
+		size_t getAdditionalRecordCount() const;
+
+		/**
+		 * @return The total number of records in the DNS header
+		 */
+		size_t getRecordCount() const;
+
+		/**
+		 * @param[in] resourceType A section of the message
+		 * @return The number of records in the DNS header for this section
+		 */
+		size_t getRecordCount(DnsResourceType resourceType) const;
+
+		/**
+		 * Get a record by its index in the message, where queries come first, then answers, authorities and additional
+		 * records
+		 * @param[in] index The record index
+		 * @param[out] record The record, valid only if true is returned
+		 * @return False if the index is out of range or the record or one of the records before it is malformed
+		 */
+		bool getRecord(size_t index, DnsRecordView& record) const;
+
+		/**
+		 * Get a record by its index in its section
+		 * @param[in] resourceType The section
+		 * @param[in] index The record index in the section
+		 * @param[out] record The record, valid only if true is returned
+		 * @return False if the index is out of range or the record or one of the records before it is malformed
+		 */
+		bool getRecord(DnsResourceType resourceType, size_t index, DnsRecordView& record) const;
+
+		/**
+		 * Decode a possibly compressed name into a caller-supplied buffer. The decoded name has the same format as
+		 * IDnsResource#getName(): labels separated by dots without a trailing dot, and an empty string for the root
+		 * @param[in] nameOffset The offset of the encoded name from the start of the message, for example
+		 * DnsRecordView#nameOffset, or the offset of a name inside record data
+		 * @param[out] buffer The buffer to decode into. The name is null-terminated
+		 * @param[in] bufferLen The buffer size. A buffer of NameBufferSize bytes always suffices
+		 * @param[out] nameLength If not nullptr, set to the length of the decoded name without the terminating null
+		 * @return False if the name is malformed or the buffer is too small
+		 */
+		bool decodeName(size_t nameOffset, char* buffer, size_t bufferLen, size_t* nameLength = nullptr) const;
+
+		/**
+		 * Compare an encoded name to a name in text form without decoding it. The comparison is case-insensitive and
+		 * a trailing dot in the text form is ignored
+		 * @param[in] nameOffset The offset of the encoded name from the start of the message
+		 * @param[in] name The name to compare to
+		 * @param[in] nameLen The length of the name to compare to
+		 * @return True if the encoded name is valid and equals the name
+		 */
+		bool isNameEqual(size_t nameOffset, const char* name, size_t nameLen) const;
+
+		/**
+		 * Compare an encoded name to a name in text form without decoding it. The comparison is case-insensitive and
+		 * a trailing dot in the text form is ignored
+		 * @param[in] nameOffset The offset of the encoded name from the start of the message
+		 * @param[in] name The name to compare to
+		 * @return True if the encoded name is valid and equals the name
+		 */
+		bool isNameEqual(size_t nameOffset, const std::string& name) const
+		{
+			return isNameEqual(nameOffset, name.data(), name.size());
+		}
+
+		/**
+		 * Search a section for a record by its name. Unlike DnsLayer#getQuery() and its siblings the comparison is
+		 * case-insensitive
+		 * @param[in] resourceType The section to search
+		 * @param[in] name The name to search for
+		 * @param[in] exactMatch If true the record name must equal the name, otherwise it must contain it
+		 * @return The index of the first matching record in the section, or -1 if there is none
+		 */
+		int findRecord(DnsResourceType resourceType, const std::string& name, bool exactMatch) const;
+
+		/**
+		 * @return The number of times a compression pointer target was found in the name cache
+		 */
+		size_t getNameCacheHitCount() const
+		{
+			return m_NameCacheHits;
+		}
+
+	private:
+		struct NameCacheEntry
+		{
+			uint16_t targetOffset;
+			uint16_t textOffset;
+			uint16_t textLength;
+			uint16_t wireLength;
+		};
+
+		static constexpr size_t NameCacheTextSize = 1024;
+
+		const uint8_t* m_Data;
+		size_t m_DataLen;
+
+		mutable uint16_t m_RecordOffsets[MaxIndexedRecords];
+		mutable size_t m_NumOfIndexedRecords;
+		mutable size_t m_CursorIndex;
+		mutable size_t m_CursorOffset;
+		mutable size_t m_FirstMalformedIndex;
+
+		mutable NameCacheEntry m_NameCache[NameCacheSize];
+		mutable size_t m_NameCacheCount;
+		mutable char m_NameCacheText[NameCacheTextSize];
+		mutable size_t m_NameCacheTextLength;
+		mutable size_t m_NameCacheHits;
+
+		void init(const uint8_t* data, size_t dataLen);
+		bool skipName(size_t offset, size_t& endOffset) const;
+		bool parseRecord(size_t index, size_t offset, DnsRecordView& record) const;
+		const NameCacheEntry* lookupName(size_t targetOffset) const;
+		void cacheName(size_t targetOffset, const char* text, size_t textLength, size_t wireLength) const;
+	};
+
+}  // namespace pcpp
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "FlowMeter.h"
+
+/// @file
+
+/// The IPFIX template ID of IPv4 flow records written by pcpp::IpfixEncoder
+#define IPFIX_IPV4_TEMPLATE_ID 256
+/// The IPFIX template ID of IPv6 flow records written by pcpp::IpfixEncoder
+#define IPFIX_IPV6_TEMPLATE_ID 257
+
+/**
+ * \namespace pcpp
+ * \brief The main namespace for the PcapPlusPlus lib
+ */
+namespace pcpp
+{
+	/**
+	 * @class IpfixEncoder
+	 * A FlowRecordSink that encodes flow records as IPFIX messages (RFC 7011). Records are encoded with one of two
+	 * templates, IPFIX_IPV4_TEMPLATE_ID for IPv4 flows and IPFIX_IPV6_TEMPLATE_ID for IPv6 flows, with these
+	 * information elements in this order:
+	 *    - sourceIPv4Address/sourceIPv6Address and destinationIPv4Address/destinationIPv6Address (the initiator is the
+	 *      source)
+	 *    - sourceTransportPort, destinationTransportPort, protocolIdentifier
+	 *    - tcpControlBits and its reverse element
+	 *    - flowStartMilliseconds, flowEndMilliseconds
+	 *    - octetDeltaCount, packetDeltaCount and their reverse elements
+	 *    - flowEndReason
+	 *
+	 * The reverse elements are the ones defined for bidirectional flows in RFC 5103 (enterprise number 29305). The
+	 * templates are sent in the first message and then every templateRefreshInterval messages. Each call to
+	 * exportRecords() produces one or more complete messages that are passed to a user callback, which can write them
+	 * to a file (a sequence of messages is a valid IPFIX file, RFC 5655) or send them to a collector. The export time
+	 * of a message is the end time of the latest flow in it, so the output depends only on the metered packets
+	 */
+	class IpfixEncoder : public FlowRecordSink
+	{
+	public:
+		/**
+		 * @typedef OnIpfixMessageCallback
+		 * A callback that is called for every encoded message
+		 * @param[in] message The message data. Valid only until the callback returns
+		 * @param[in] messageLen The message length
+		 * @param[in] userCookie The user cookie given in the c'tor
+		 * @return True if the message was delivered, false otherwise
+		 */
+		typedef bool (*OnIpfixMessageCallback)(const uint8_t* message, size_t messageLen, void* userCookie);
+
+		/**
+		 * A c'tor for this class
+		 * @param[in] onMessage The callback to pass encoded messages to
+		 * @param[in] userCookie A pointer passed to the callback
+		 * @param[in] observationDomainId The observation domain ID written in the message headers. The default is 0
+		 * @param[in] maxMessageSize The maximum message size, between 512 and 65535. The default is 1400 which fits
+		 * in one UDP datagram on most networks
+		 * @param[in] templateRefreshInterval Resend the templates every this number of messages. 0 means send them
+		 * only in the first message, which is suitable for files and reliable transports. The default is 0
+		 */
+		IpfixEncoder(OnIpfixMessageCallback onMessage, void* userCookie, uint32_t observationDomainId = 0,
+		             size_t maxMessageSize = 1400, uint32_t templateRefreshInterval = 0);
+
+		/**
+		 * Encode records and pass the messages to the callback
+		 * @param[in] records The records
+		 * @param[in] count The number of records
+		 * @return True if all messages were delivered, false if the callback failed for any of them
+		 */
+		bool exportRecords(const FlowRecord* records, size_t count) override;
+
+		/**
+		 * @return The number of data records encoded so far, which is also the sequence number of the next message
+		 */
+		uint32_t getSequenceNumber() const
+		{
+			return m_SequenceNumber;
+		}
+
+	private:
+		OnIpfixMessageCallback m_OnMessage;
+		void* m_UserCookie;
+		uint32_t m_ObservationDomainId;
+		size_t m_MaxMessageSize;
+		uint32_t m_TemplateRefreshInterval;
+		uint32_t m_SequenceNumber;
+		uint32_t m_NumOfMessages;
+		std::mutex m_Mutex;
+		std::vector<uint8_t> m_Message;
+		size_t m_SetOffset;
+		uint16_t m_SetId;
+		uint32_t m_NumOfRecordsInMessage;
+		uint64_t m_ExportTime;
+
+		void startMessage();
+		bool finishMessage();
+		void closeSet();
+		void writeTemplate(uint16_t templateId, bool isIPv6);
+		void writeRecord(const FlowRecord& record);
+	};
+
+	/**
+	 * @class FlowRecordFileWriter
+	 * A FlowRecordSink that writes records to a compact binary file that can be read by FlowRecordFileReader. The
+	 * file starts with an 8-byte header (the magic "PFR1", a 16-bit version and 16 reserved bits) followed by the
+	 * records. All fields are little endian. Each record has a fixed part: flags (bit 0 is set for IPv6, bit 1 for a
+	 * reversed initiator), protocol, end reason, the TCP flags of both directions, both ports, both IP addresses (4 or
+	 * 16 bytes each) and the 64-bit start time; followed by LEB128 variable-length integers for the duration and for
+	 * the packet and byte counters of both directions. A typical IPv4 record takes about 35 bytes
+	 */
+	class FlowRecordFileWriter : public FlowRecordSink
+	{
+	public:
+		/**
+		 * A c'tor for this class. The file isn't opened until open() is called
+		 * @param[in] fileName The file name
+		 */
+		explicit FlowRecordFileWriter(const std::string& fileName);
+
+		/**
+		 * A d'tor for this class. Closes the file if it's open
+		 */
+		~FlowRecordFileWriter() override;
+
+		FlowRecordFileWriter(const FlowRecordFileWriter&) = delete;
+		FlowRecordFileWriter& operator=(const FlowRecordFileWriter&) = delete;
+
+		/**
+		 * Create the file and write the file header. An existing file is overwritten
+		 * @return True if the file was created, false otherwise (an error is printed to log)
+		 */
+		bool open();
+
+		/**
+		 * @return True if the file is open
+		 */
+		bool isOpened() const
+		{
+			return m_File != nullptr;
+		}
+
+		/**
+		 * Close the file
+		 */
+		void close();
+
+		/**
+		 * Append records to the file
+		 * @param[in] records The records
+		 * @param[in] count The number of records
+		 * @return True if the records were written, false if the file isn't open or a write failed
+		 */
+		bool exportRecords(const FlowRecord* records, size_t count) override;
+
+		/**
+		 * Flush the file buffers
+		 * @return True if the flush succeeded, false otherwise
+		 */
+		bool flush() override;
+
+	private:
+		std::string m_FileName;
+		FILE* m_File;
+		std::mutex m_Mutex;
+		std::vector<uint8_t> m_Buffer;
+	};
+
+	/**
+	 * @class FlowRecordFileReader
+	 * Reads files written by FlowRecordFileWriter
+	 */
+	class FlowRecordFileReader
+	{
+	public:
+		/**
+		 * A c'tor for this class. The file isn't opened until open() is called
+		 * @param[in] fileName The file name
+		 */
+		explicit FlowRecordFileReader(const std::string& fileName);
+
+		/**
+		 * A d'tor for this class. Closes the file if it's open
+		 */
+		~FlowRecordFileReader();
+
+		FlowRecordFileReader(const FlowRecordFileReader&) = delete;
+		FlowRecordFileReader& operator=(const FlowRecordFileReader&) = delete;
+
+		/**
+		 * Open the file and verify its header
+		 * @return True if the file was opened, false otherwise (an error is printed to log)
+		 */
+		bool open();
+
+		/**
+		 * Close the file
+		 */
+		void close();
+
+		/**
+		 * Read the next record
+		 * @param[out] record The record
+		 * @return True if a record was read, false at the end of the file or if the file is corrupted or not open
+		 */
+		bool getNextRecord(FlowRecord& record);
+
+	private:
+		std::string m_FileName;
+		FILE* m_File;
+
+		bool readVarInt(uint64_t& value);
+	};
+
+}  // namespace pcpp
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "FlowTable.h"
+#include "RawPacket.h"
+
+/// @file
+
+/**
+ * \namespace pcpp
+ * \brief The main namespace for the PcapPlusPlus lib
+ */
+namespace pcpp
+{
+	/**
+	 * The reason a flow record was exported. The values are the ones of the IPFIX flowEndReason information element
+	 * (RFC 5102)
+	 */
+	enum FlowEndReason
+	{
+		/** The flow saw no packets for longer than the idle timeout */
+		FlowEndIdleTimeout = 1,
+		/** The flow was active for longer than the active timeout. The flow continues in a new record */
+		FlowEndActiveTimeout = 2,
+		/** The end of the flow was detected, for example a TCP RST or FIN in both directions */
+		FlowEndOfFlowDetected = 3,
+		/** The record was exported by FlowMeter#flush() */
+		FlowEndForcedEnd = 4,
+		/** The flow was evicted because the flow table was full */
+		FlowEndLackOfResources = 5
+	};
+
+	/**
+	 * @struct FlowRecord
+	 * A bidirectional flow record. The record is oriented by the flow initiator: the endpoint that sent the first
+	 * packet of the flow seen by the meter. Index 0 of the per-direction counters refers to packets sent by the
+	 * initiator and index 1 to packets sent by the responder
+	 */
+	struct FlowRecord
+	{
+		/** The canonical flow key */
+		FlowKey key;
+		/** False if the initiator is endpoint 1 of the key, true if it is endpoint 2 */
+		bool isReversed;
+		/** The reason the record was exported */
+		FlowEndReason endReason;
+		/** The OR of the TCP flags seen in each direction, 0 for non-TCP flows */
+		uint8_t tcpFlags[2];
+		/** The timestamp of the first packet of the record, in nanoseconds since the epoch */
+		uint64_t startTime;
+		/** The timestamp of the last packet of the record, in nanoseconds since the epoch */
+		uint64_t endTime;
+		/** The number of packets in each direction */
+		uint64_t packets[2];
+		/** The number of IP bytes (IP header and payload) in each direction */
+		uint64_t bytes[2];
+
+		/**
+		 * A c'tor that creates an empty record
+		 */
+		FlowRecord() : isReversed(false), endReason(FlowEndForcedEnd), startTime(0), endTime(0)
+		{
+			tcpFlags[0] = tcpFlags[1] = 0;
+			packets[0] = packets[1] = 0;
+			bytes[0] = bytes[1] = 0;
+		}
+
+		/**
+		 * @return The initiator's IP address bytes, 4 bytes for IPv4 and 16 bytes for IPv6
+		 */
+		const uint8_t* getSrcIP() const
+		{
+			return isReversed ? key.ip2 : key.ip1;
+		}
+
+		/**
+		 * @return The responder's IP address bytes, 4 bytes for IPv4 and 16 bytes for IPv6
+		 */
+		const uint8_t* getDstIP() const
+		{
+			return isReversed ? key.ip1 : key.ip2;
+		}
+
+		/**
+		 * @return The initiator's port
+		 */
+		uint16_t getSrcPort() const
+		{
+			return isReversed ? key.port2 : key.port1;
+		}
+
+		/**
+		 * @return The responder's port
+		 */
+		uint16_t getDstPort() const
+		{
+			return isReversed ? key.port1 : key.port2;
+		}
+	};
+
+	/**
+	 * @class FlowRecordSink
+	 * An abstract destination of exported flow records. A FlowMeter passes its records to the sink in batches. A
+	 * sink may be shared by several meters running on different threads only if the sink implementation is
+	 * thread-safe. The sinks in this library are thread-safe, they lock a mutex once per batch
+	 */
+	class FlowRecordSink
+	{
+	public:
+		virtual ~FlowRecordSink() = default;
+
+		/**
+		 * Export a batch of records
+		 * @param[in] records The records. They're valid only until the method returns
+		 * @param[in] count The number of records
+		 * @return True if the records were exported, false otherwise
+		 */
+		virtual bool exportRecords(const FlowRecord* records, size_t count) = 0;
+
+		/**
+		 * Flush records buffered by the sink, if any. The default implementation does nothing
+		 * @return True if the buffered records were written, false otherwise
+		 */
+		virtual bool flush()
+		{
+			return true;
+		}
+	};
+
+	/**
+	 * @class FlowMeter
+	 * A flow metering engine. The meter is given raw packets from any source (live devices, DPDK devices, file
+	 * readers), classifies them to bidirectional 5-tuple flows and keeps per-flow packet, byte and TCP flag counters.
+	 * Flow records are exported to a FlowRecordSink when:
+	 *    - A flow saw no packets for longer than the idle timeout
+	 *    - A flow was active for longer than the active timeout. The flow's counters are then reset and it continues
+	 *      in a new record
+	 *    - A TCP flow was closed (RST, or FIN in both directions) and a new SYN with the same 5-tuple arrives, or the
+	 *      closed flow becomes idle
+	 *    - The flow table is full and the flow is the least recently used one
+	 *    - flush() is called
+	 *
+	 * Time is taken from the packet timestamps, so processing a capture file gives the same records as processing the
+	 * same traffic live. Packets are parsed only up to the transport layer, the flows are kept in a preallocated
+	 * FlowTable and records are handed to the sink in batches, so the per-packet cost is a partial parse and one hash
+	 * table lookup. This class isn't thread-safe. To meter traffic on several cores, create one meter per core (for
+	 * example one per RX queue of a device that spreads flows between queues) and give them the same thread-safe
+	 * sink or a sink each
+	 */
+	class FlowMeter
+	{
+	public:
+		/**
+		 * @struct FlowMeterConfig
+		 * The meter configuration
+		 */
+		struct FlowMeterConfig
+		{
+			/** The maximum number of concurrent flows. The default is 1,000,000 */
+			size_t maxFlows;
+			/** The idle timeout in seconds. The default is 15 */
+			uint32_t idleTimeoutSec;
+			/** The active timeout in seconds, 0 disables it. The default is 1800 */
+			uint32_t activeTimeoutSec;
+			/** The number of records passed to the sink at once. The default is 256 */
+			size_t batchSize;
+
+			/**
+			 * A c'tor for this struct
+			 * @param[in] maxFlows The maximum number of concurrent flows, default is 1,000,000
+			 * @param[in] idleTimeoutSec The idle timeout in seconds, default is 15
+			 * @param[in] activeTimeoutSec The active timeout in seconds, default is 1800
+			 * @param[in] batchSize The export batch size, default is 256
+			 */
+			explicit FlowMeterConfig(size_t maxFlows = 1000000, uint32_t idleTimeoutSec = 15,
+			                         uint32_t activeTimeoutSec = 1800, size_t batchSize = 256)
+			    : maxFlows(maxFlows), idleTimeoutSec(idleTimeoutSec), activeTimeoutSec(activeTimeoutSec),
+			      batchSize(batchSize)
+			{}
+		};
+
+		/**
+		 * @struct FlowMeterStats
+		 * Meter counters
+		 */
+		struct FlowMeterStats
+		{
+			/** Packets given to the meter */
+			uint64_t packets;
+			/** Packets ignored because they have no IPv4 or IPv6 layer */
+			uint64_t nonIPPackets;
+			/** Flows created */
+			uint64_t flows;
+			/** Records exported */
+			uint64_t records;
+			/** Batches the sink failed to export */
+			uint64_t exportErrors;
+		};
+
+		/**
+		 * A c'tor for this class
+		 * @param[in] sink The sink to export records to. Must remain valid as long as the meter is used
+		 * @param[in] config The meter configuration
+		 */
+		explicit FlowMeter(FlowRecordSink* sink, const FlowMeterConfig& config = FlowMeterConfig());
+
+		FlowMeter(const FlowMeter&) = delete;
+		FlowMeter& operator=(const FlowMeter&) = delete;
+
+		/**
+		 * Meter a raw packet. The packet is parsed up to the transport layer
+		 * @param[in] rawPacket The packet
+		 * @return True if the packet was counted in a flow, false if it has no IPv4 or IPv6 layer
+		 */
+		bool processPacket(RawPacket* rawPacket);
+
+		/**
+		 * Meter an already parsed packet
+		 * @param[in] packet The packet
+		 * @return True if the packet was counted in a flow, false if it has no IPv4 or IPv6 layer
+		 */
+		bool processPacket(Packet& packet);
+
+		/**
+		 * Export flows that are idle at the given time. Should be called periodically when packets may stop
+		 * arriving, since otherwise idle flows are detected only while packets are processed
+		 * @param[in] now The current time
+		 */
+		void advanceTime(const timespec& now);
+
+		/**
+		 * Export all flows with FlowEndForcedEnd, pass the pending batch to the sink and flush the sink. Usually
+		 * called at the end of a capture. The meter doesn't export anything when it's destroyed, so this method
+		 * should be called before
+		 */
+		void flush();
+
+		/**
+		 * @return The number of flows currently metered
+		 */
+		size_t getNumOfActiveFlows() const
+		{
+			return m_FlowTable.getNumOfFlows();
+		}
+
+		/**
+		 * @return The meter counters
+		 */
+		const FlowMeterStats& getStatistics() const
+		{
+			return m_Stats;
+		}
+
+	private:
+		struct FlowState
+		{
+			bool isReversed;
+			bool isEnded;
+			bool finSeen[2];
+			uint8_t tcpFlags[2];
+			uint64_t startTime;
+			uint64_t endTime;
+			uint64_t packets[2];
+			uint64_t bytes[2];
+
+			FlowState();
+			void resetCounters();
+		};
+
+		FlowRecordSink* m_Sink;
+		FlowMeterConfig m_Config;
+		uint64_t m_ActiveTimeoutNs;
+		FlowTable<FlowState> m_FlowTable;
+		std::vector<FlowRecord> m_Batch;
+		uint64_t m_LastIdleCheck;
+		FlowMeterStats m_Stats;
+
+		static void onFlowEvicted(const FlowKey& key, FlowState& state, FlowEvictionReason reason, void* userCookie);
+		void exportFlow(const FlowKey& key, const FlowState& state, FlowEndReason reason);
+		void exportBatch();
+	};
+
+}  // namespace pcpp
@@ -0,0 +1,658 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <vector>
+#include "IpAddress.h"
+#include "Packet.h"
+
+/// @file
+
+/**
+ * \namespace pcpp
+ * \brief The main namespace for the PcapPlusPlus lib
+ */
+namespace pcpp
+{
+	/**
+	 * @struct FlowKey
+	 * A bidirectional 5-tuple flow key. The two endpoints of the flow are stored in a canonical order (the endpoint
+	 * with the lower IP address, or the lower port if the IP addresses are equal, is always endpoint 1) so packets of
+	 * both directions of a flow produce the same key. Unlike hash5Tuple() the full addresses are kept, so two
+	 * different flows never share a key. The struct has no padding holes and can be compared with memcmp
+	 */
+	struct FlowKey
+	{
+		/** The maximum length of the string representation of a key */
+		static constexpr size_t MaxStringLength = 121;
+
+		/** The IP address of endpoint 1. IPv4 addresses occupy the first 4 bytes, the rest is zeroed */
+		uint8_t ip1[16];
+		/** The IP address of endpoint 2. IPv4 addresses occupy the first 4 bytes, the rest is zeroed */
+		uint8_t ip2[16];
+		/** The port of endpoint 1 in host byte order, 0 if the protocol isn't TCP or UDP */
+		uint16_t port1;
+		/** The port of endpoint 2 in host byte order, 0 if the protocol isn't TCP or UDP */
+		uint16_t port2;
+		/** The IP protocol number (for example 6 for TCP and 17 for UDP) */
+		uint8_t protocol;
+		/** 4 or 6 */
+		uint8_t ipVersion;
+		/** Always 0 */
+		uint16_t reserved;
+
+		/**
+		 * A c'tor that creates an all-zero key
+		 */
+		FlowKey()
+		{
+			memset(this, 0, sizeof(FlowKey));
+		}
+
+		/**
+		 * Fill the key from a packet. The IP addresses are taken from the IPv4/IPv6 layer preceding the last TCP or
+		 * UDP layer in the packet. If the packet has no TCP or UDP layer, the last IPv4/IPv6 layer is used and the
+		 * ports are set to 0
+		 * @param[in] packet The packet to build the key from
+		 * @param[out] isReversed Optional. Set to true if the packet was sent by endpoint 2, false if it was sent by
+		 * endpoint 1
+		 * @return True if the key was built, false if the packet has no IPv4 or IPv6 layer. In that case the key is
+		 * left unchanged
+		 */
+		bool fromPacket(Packet& packet, bool* isReversed = nullptr);
+
+		/**
+		 * Fill the key from layers found by getFlowLayers()
+		 * @param[in] ipLayer An IPv4 or IPv6 layer
+		 * @param[in] transportLayer A TCP or UDP layer, or nullptr
+		 * @param[out] isReversed Optional. Set to true if the packet was sent by endpoint 2, false if it was sent by
+		 * endpoint 1
+		 * @return True if the key was built, false if ipLayer is nullptr or isn't an IPv4 or IPv6 layer
+		 */
+		bool fromLayers(Layer* ipLayer, Layer* transportLayer, bool* isReversed = nullptr);
+
+		/**
+		 * Find the layers a flow key is built from, as described in fromPacket()
+		 * @param[in] packet The packet
+		 * @param[out] ipLayer The IPv4 or IPv6 layer, nullptr if not found
+		 * @param[out] transportLayer The TCP or UDP layer, nullptr if not found
+		 * @return True if an IPv4 or IPv6 layer was found
+		 */
+		static bool getFlowLayers(Packet& packet, Layer*& ipLayer, Layer*& transportLayer);
+
+		/**
+		 * @return A 32-bit hash of the key
+		 */
+		uint32_t hash() const;
+
+		/**
+		 * @return A string representation of the key in the format of "ip1:port1 <-> ip2:port2 proto N", with IPv6
+		 * addresses in square brackets
+		 */
+		std::string toString() const;
+
+		/**
+		 * Write the string representation of the key (see toString()) to a buffer without allocating memory
+		 * @param[out] buffer The buffer to write to, the string is null-terminated
+		 * @param[in] bufferLen The buffer size, MaxStringLength + 1 is always enough
+		 * @return The string length, or 0 if the buffer is too small
+		 */
+		size_t toString(char* buffer, size_t bufferLen) const;
+
+		bool operator==(const FlowKey& other) const
+		{
+			return memcmp(this, &other, sizeof(FlowKey)) == 0;
+		}
+
+		bool operator!=(const FlowKey& other) const
+		{
+			return !(*this == other);
+		}
+	};
+
+	/**
+	 * @struct FiveTuple
+	 * A directional 5-tuple: the source and destination endpoints of a packet as they appear in it. hash() depends on
+	 * the direction while symmetricHash() returns the same value for both directions of a connection, so for example
+	 * both directions can be dispatched to the same worker thread while the key still tells them apart. toFlowKey()
+	 * converts the tuple to the canonical bidirectional FlowKey. Like FlowKey, the struct has no padding holes and can
+	 * be compared with memcmp
+	 */
+	struct FiveTuple
+	{
+		/** The maximum length of the string representation of a tuple */
+		static constexpr size_t MaxStringLength = 120;
+
+		/** The source IP address. IPv4 addresses occupy the first 4 bytes, the rest is zeroed */
+		uint8_t srcIP[16];
+		/** The destination IP address. IPv4 addresses occupy the first 4 bytes, the rest is zeroed */
+		uint8_t dstIP[16];
+		/** The source port in host byte order, 0 if the protocol isn't TCP or UDP */
+		uint16_t srcPort;
+		/** The destination port in host byte order, 0 if the protocol isn't TCP or UDP */
+		uint16_t dstPort;
+		/** The IP protocol number (for example 6 for TCP and 17 for UDP) */
+		uint8_t protocol;
+		/** 4 or 6 */
+		uint8_t ipVersion;
+		/** Always 0 */
+		uint16_t reserved;
+
+		/**
+		 * A c'tor that creates an all-zero tuple
+		 */
+		FiveTuple()
+		{
+			memset(this, 0, sizeof(FiveTuple));
+		}
+
+		/**
+		 * A c'tor that creates a tuple from IP addresses, ports and a protocol
+		 * @param[in] srcIPAddr The source IP address
+		 * @param[in] dstIPAddr The destination IP address, must be of the same version as srcIPAddr
+		 * @param[in] srcPortNum The source port
+		 * @param[in] dstPortNum The destination port
+		 * @param[in] ipProtocol The IP protocol number
+		 */
+		FiveTuple(const IPAddress& srcIPAddr, const IPAddress& dstIPAddr, uint16_t srcPortNum, uint16_t dstPortNum,
+		          uint8_t ipProtocol);
+
+		/**
+		 * Fill the tuple from a packet, using the same layers as FlowKey#fromPacket()
+		 * @param[in] packet The packet to build the tuple from
+		 * @return True if the tuple was built, false if the packet has no IPv4 or IPv6 layer. In that case the tuple
+		 * is left unchanged
+		 */
+		bool fromPacket(Packet& packet);
+
+		/**
+		 * Fill the tuple from layers found by FlowKey#getFlowLayers()
+		 * @param[in] ipLayer An IPv4 or IPv6 layer
+		 * @param[in] transportLayer A TCP or UDP layer, or nullptr
+		 * @return True if the tuple was built, false if ipLayer is nullptr or isn't an IPv4 or IPv6 layer
+		 */
+		bool fromLayers(Layer* ipLayer, Layer* transportLayer);
+
+		/**
+		 * @return The source IP address
+		 */
+		IPAddress getSrcIPAddress() const;
+
+		/**
+		 * @return The destination IP address
+		 */
+		IPAddress getDstIPAddress() const;
+
+		/**
+		 * @return The tuple of the opposite direction, with the source and destination swapped
+		 */
+		FiveTuple reversed() const;
+
+		/**
+		 * Convert the tuple to the canonical bidirectional flow key
+		 * @param[out] isReversed Optional. Set to true if the source of the tuple is endpoint 2 of the key
+		 * @return The flow key
+		 */
+		FlowKey toFlowKey(bool* isReversed = nullptr) const;
+
+		/**
+		 * @return A 64-bit hash of the tuple. The tuples of the two directions of a connection have different hashes
+		 */
+		uint64_t hash() const;
+
+		/**
+		 * @return A 64-bit hash of the tuple that is the same for the tuples of the two directions of a connection
+		 */
+		uint64_t symmetricHash() const;
+
+		/**
+		 * @return A string representation of the tuple in the format of "srcIP:srcPort -> dstIP:dstPort proto N",
+		 * with IPv6 addresses in square brackets
+		 */
+		std::string toString() const;
+
+		/**
+		 * Write the string representation of the tuple (see toString()) to a buffer without allocating memory
+		 * @param[out] buffer The buffer to write to, the string is null-terminated
+		 * @param[in] bufferLen The buffer size, MaxStringLength + 1 is always enough
+		 * @return The string length, or 0 if the buffer is too small
+		 */
+		size_t toString(char* buffer, size_t bufferLen) const;
+
+		bool operator==(const FiveTuple& other) const
+		{
+			return memcmp(this, &other, sizeof(FiveTuple)) == 0;
+		}
+
+		bool operator!=(const FiveTuple& other) const
+		{
+			return !(*this == other);
+		}
+	};
+
+	/**
+	 * An enum of the reasons a flow is removed from a FlowTable
+	 */
+	enum FlowEvictionReason
+	{
+		/** The flow saw no packets for longer than the idle timeout */
+		FlowIdleTimeout,
+		/** The table was full and the flow was the least recently used one */
+		FlowTableFull,
+		/** The table was cleared by FlowTable#clear() */
+		FlowTableCleared
+	};
+
+	/**
+	 * @class FlowTable
+	 * A fixed-capacity table that maps bidirectional flows (FlowKey) to a user state object. The table is designed
+	 * to track a very large number of flows with predictable memory:
+	 *    - All state objects are preallocated in one slab when the table is created. A new flow reuses a free slot of
+	 *      the slab, and no memory is allocated or freed while packets are processed
+	 *    - The index is an open-addressing hash table with linear probing whose slots hold only an 8-byte hash and
+	 *      slab index, so a lookup usually touches a single cache line of the index before reading the entry itself
+	 *    - Entries are kept in an intrusive least recently used list. When the table is full the least recently used
+	 *      flow is evicted to make room for a new one. Flows that saw no packets for longer than the idle timeout are
+	 *      evicted as new packets arrive. Time is taken from the packet timestamps, not from the wall clock, so the
+	 *      same capture file always produces the same evictions
+	 *
+	 * An eviction callback can be set to get the flow key and state of every evicted flow, for example to export
+	 * its statistics. This class isn't thread-safe.
+	 * @tparam State The per-flow state. Must be default constructible and copy or move assignable. A newly created
+	 * flow gets a default constructed state
+	 */
+	template <typename State> class FlowTable
+	{
+	public:
+		/**
+		 * @typedef OnFlowEvictedCallback
+		 * A callback that is called for every flow the table evicts. The flow is removed from the table once the
+		 * callback returns, so the callback must not access the table
+		 * @param[in] key The key of the evicted flow
+		 * @param[in] state The state of the evicted flow
+		 * @param[in] reason The reason the flow is evicted
+		 * @param[in] userCookie The user cookie given in the c'tor
+		 */
+		typedef void (*OnFlowEvictedCallback)(const FlowKey& key, State& state, FlowEvictionReason reason,
+		                                      void* userCookie);
+
+		/**
+		 * A c'tor for this class. Allocates the index and the state slab for maxFlows flows
+		 * @param[in] maxFlows The maximum number of flows the table holds. Must be between 1 and 2^30
+		 * @param[in] idleTimeoutSec Flows that saw no packets for this number of seconds are evicted. 0 means flows
+		 * are evicted only when the table is full. The default is 0
+		 * @param[in] onFlowEvicted An optional callback to call for every evicted flow
+		 * @param[in] userCookie A pointer passed to the eviction callback
+		 */
+		explicit FlowTable(size_t maxFlows, uint32_t idleTimeoutSec = 0, OnFlowEvictedCallback onFlowEvicted = nullptr,
+		                   void* userCookie = nullptr)
+		    : m_MaxFlows(clampMaxFlows(maxFlows)),
+		      m_IdleTimeoutNs(static_cast<uint64_t>(idleTimeoutSec) * 1000000000ULL), m_OnFlowEvicted(onFlowEvicted),
+		      m_UserCookie(userCookie), m_NumOfFlows(0), m_LruHead(NoEntry), m_LruTail(NoEntry), m_FreeHead(NoEntry)
+		{
+			// keep the index load factor at 0.75 or below
+			size_t numOfSlots = 2;
+			while (numOfSlots < m_MaxFlows + m_MaxFlows / 3 + 1)
+				numOfSlots <<= 1;
+
+			m_SlotMask = static_cast<uint32_t>(numOfSlots - 1);
+			m_Slots.resize(numOfSlots);
+			m_Entries.resize(m_MaxFlows);
+			initFreeList();
+		}
+
+		FlowTable(const FlowTable&) = delete;
+		FlowTable& operator=(const FlowTable&) = delete;
+
+		/**
+		 * Find a flow without updating its last seen time or its place in the least recently used list
+		 * @param[in] key The flow key
+		 * @return A pointer to the flow state, or nullptr if the flow isn't in the table
+		 */
+		State* getFlow(const FlowKey& key)
+		{
+			uint32_t slot;
+			uint32_t entry = find(key, key.hash(), slot);
+			return entry == NoEntry ? nullptr : &m_Entries[entry].state;
+		}
+
+		/**
+		 * Find a flow and create it if it isn't in the table. Before a flow is created, flows that are idle at the
+		 * given time are evicted, and if the table is still full the least recently used flow is evicted. The flow
+		 * becomes the most recently used one and its last seen time is set to the given time
+		 * @param[in] key The flow key
+		 * @param[in] timestamp The time of the current packet
+		 * @param[out] isNewFlow Optional. Set to true if the flow was created by this call
+		 * @return A pointer to the flow state. The pointer is valid until the flow is evicted or removed
+		 */
+		State* getOrCreateFlow(const FlowKey& key, const timespec& timestamp, bool* isNewFlow = nullptr)
+		{
+			uint64_t now = toNanoSec(timestamp);
+			uint32_t hash = key.hash();
+			uint32_t slot;
+			uint32_t entry = find(key, hash, slot);
+
+			if (entry != NoEntry)
+			{
+				if (isNewFlow != nullptr)
+					*isNewFlow = false;
+
+				Entry& existing = m_Entries[entry];
+				if (now > existing.lastSeen)
+					existing.lastSeen = now;
+				moveToLruHead(entry);
+				return &existing.state;
+			}
+
+			if (isNewFlow != nullptr)
+				*isNewFlow = true;
+
+			// evicting may move index slots, so the insertion slot is searched for again afterwards
+			if (evictIdle(now) > 0 || m_FreeHead == NoEntry)
+			{
+				if (m_FreeHead == NoEntry)
+					evict(m_LruTail, FlowTableFull);
+				find(key, hash, slot);
+			}
+
+			entry = m_FreeHead;
+			Entry& newEntry = m_Entries[entry];
+			m_FreeHead = newEntry.lruNext;
+
+			newEntry.key = key;
+			newEntry.hash = hash;
+			newEntry.lastSeen = now;
+			newEntry.state = State();
+			pushLruHead(entry);
+
+			m_Slots[slot].hash = hash;
+			m_Slots[slot].entry = entry;
+			m_NumOfFlows++;
+			return &newEntry.state;
+		}
+
+		/**
+		 * Build a flow key from a packet and find or create its flow. The packet's timestamp is used as the current
+		 * time. See getOrCreateFlow(const FlowKey&, const timespec&, bool*)
+		 * @param[in] packet The packet
+		 * @param[out] isNewFlow Optional. Set to true if the flow was created by this call
+		 * @param[out] isReversed Optional. Set to true if the packet was sent by endpoint 2 of the flow key
+		 * @return A pointer to the flow state, or nullptr if the packet has no IPv4 or IPv6 layer
+		 */
+		State* getOrCreateFlow(Packet& packet, bool* isNewFlow = nullptr, bool* isReversed = nullptr)
+		{
+			FlowKey key;
+			if (!key.fromPacket(packet, isReversed))
+				return nullptr;
+
+			return getOrCreateFlow(key, packet.getRawPacketReadOnly()->getPacketTimeStamp(), isNewFlow);
+		}
+
+		/**
+		 * Remove a flow from the table. The eviction callback isn't called
+		 * @param[in] key The flow key
+		 * @return True if the flow was found and removed, false otherwise
+		 */
+		bool removeFlow(const FlowKey& key)
+		{
+			uint32_t slot;
+			uint32_t entry = find(key, key.hash(), slot);
+			if (entry == NoEntry)
+				return false;
+
+			remove(entry, slot);
+			return true;
+		}
+
+		/**
+		 * Evict all flows that saw no packets for longer than the idle timeout at the given time. Useful when
+		 * packets stop arriving, since idle flows are otherwise evicted only when new flows are created. Does nothing
+		 * if the idle timeout is 0
+		 * @param[in] now The current time
+		 * @return The number of evicted flows
+		 */
+		size_t evictIdleFlows(const timespec& now)
+		{
+			return evictIdle(toNanoSec(now));
+		}
+
+		/**
+		 * Evict all flows from the table. The eviction callback is called for each of them with FlowTableCleared,
+		 * from the least recently used flow to the most recently used one
+		 */
+		void clear()
+		{
+			while (m_LruTail != NoEntry)
+				evict(m_LruTail, FlowTableCleared);
+		}
+
+		/**
+		 * Call a function for every flow in the table, from the most recently used flow to the least recently used
+		 * one. The function must not add or remove flows
+		 * @param[in] func A callable with the signature void(const FlowKey&, State&)
+		 */
+		template <typename Func> void forEachFlow(Func func)
+		{
+			for (uint32_t entry = m_LruHead; entry != NoEntry; entry = m_Entries[entry].lruNext)
+				func(m_Entries[entry].key, m_Entries[entry].state);
+		}
+
+		/**
+		 * @return The number of flows currently in the table
+		 */
+		size_t getNumOfFlows() const
+		{
+			return m_NumOfFlows;
+		}
+
+		/**
+		 * @return The maximum number of flows the table holds
+		 */
+		size_t getMaxNumOfFlows() const
+		{
+			return m_MaxFlows;
+		}
+
+		/**
+		 * @return The idle timeout in seconds
+		 */
+		uint32_t getIdleTimeout() const
+		{
+			return static_cast<uint32_t>(m_IdleTimeoutNs / 1000000000ULL);
+		}
+
+	private:
+		static constexpr uint32_t NoEntry = 0xFFFFFFFF;
+		static constexpr size_t MaxCapacity = 1 << 30;
+
+		struct Slot
+		{
+			uint32_t hash;
+			uint32_t entry;
+
+			Slot() : hash(0), entry(NoEntry)
+			{}
+		};
+
+		struct Entry
+		{
+			FlowKey key;
+			uint32_t hash;
+			uint32_t lruPrev;
+			// also links the free list
+			uint32_t lruNext;
+			uint64_t lastSeen;
+			State state;
+		};
+
+		size_t m_MaxFlows;
+		uint64_t m_IdleTimeoutNs;
+		OnFlowEvictedCallback m_OnFlowEvicted;
+		void* m_UserCookie;
+		size_t m_NumOfFlows;
+		uint32_t m_SlotMask;
+		uint32_t m_LruHead;
+		uint32_t m_LruTail;
+		uint32_t m_FreeHead;
+		std::vector<Slot> m_Slots;
+		std::vector<Entry> m_Entries;
+
+		static size_t clampMaxFlows(size_t maxFlows)
+		{
+			if (maxFlows < 1)
+				return 1;
+			return maxFlows > MaxCapacity ? static_cast<size_t>(MaxCapacity) : maxFlows;
+		}
+
+		static uint64_t toNanoSec(const timespec& ts)
+		{
+			return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+		}
+
+		void initFreeList()
+		{
+			for (size_t i = 0; i < m_MaxFlows; i++)
+				m_Entries[i].lruNext = (i + 1 < m_MaxFlows ? static_cast<uint32_t>(i + 1) : NoEntry);
+			m_FreeHead = 0;
+		}
+
+		// returns the entry of the key, or NoEntry and the empty slot the key should be inserted at
+		uint32_t find(const FlowKey& key, uint32_t hash, uint32_t& slot) const
+		{
+			slot = hash & m_SlotMask;
+			while (true)
+			{
+				const Slot& cur = m_Slots[slot];
+				if (cur.entry == NoEntry)
+					return NoEntry;
+
+				if (cur.hash == hash && m_Entries[cur.entry].key == key)
+					return cur.entry;
+
+				slot = (slot + 1) & m_SlotMask;
+			}
+		}
+
+		uint32_t findSlotOfEntry(uint32_t entry) const
+		{
+			uint32_t slot = m_Entries[entry].hash & m_SlotMask;
+			while (m_Slots[slot].entry != entry)
+				slot = (slot + 1) & m_SlotMask;
+			return slot;
+		}
+
+		// backward shift deletion, keeps probe sequences intact without tombstones
+		void removeSlot(uint32_t hole)
+		{
+			uint32_t next = (hole + 1) & m_SlotMask;
+			while (m_Slots[next].entry != NoEntry)
+			{
+				uint32_t home = m_Slots[next].hash & m_SlotMask;
+				if (((next - home) & m_SlotMask) >= ((next - hole) & m_SlotMask))
+				{
+					m_Slots[hole] = m_Slots[next];
+					hole = next;
+				}
+				next = (next + 1) & m_SlotMask;
+			}
+			m_Slots[hole] = Slot();
+		}
+
+		void unlinkLru(uint32_t entry)
+		{
+			Entry& e = m_Entries[entry];
+			if (e.lruPrev != NoEntry)
+				m_Entries[e.lruPrev].lruNext = e.lruNext;
+			else
+				m_LruHead = e.lruNext;
+
+			if (e.lruNext != NoEntry)
+				m_Entries[e.lruNext].lruPrev = e.lruPrev;
+			else
+				m_LruTail = e.lruPrev;
+		}
+
+		void pushLruHead(uint32_t entry)
+		{
+			Entry& e = m_Entries[entry];
+			e.lruPrev = NoEntry;
+			e.lruNext = m_LruHead;
+			if (m_LruHead != NoEntry)
+				m_Entries[m_LruHead].lruPrev = entry;
+			else
+				m_LruTail = entry;
+			m_LruHead = entry;
+		}
+
+		void moveToLruHead(uint32_t entry)
+		{
+			if (entry == m_LruHead)
+				return;
+
+			unlinkLru(entry);
+			pushLruHead(entry);
+		}
+
+		void remove(uint32_t entry, uint32_t slot)
+		{
+			removeSlot(slot);
+			unlinkLru(entry);
+			m_Entries[entry].state = State();
+			m_Entries[entry].lruNext = m_FreeHead;
+			m_FreeHead = entry;
+			m_NumOfFlows--;
+		}
+
+		void evict(uint32_t entry, FlowEvictionReason reason)
+		{
+			if (m_OnFlowEvicted != nullptr)
+				m_OnFlowEvicted(m_Entries[entry].key, m_Entries[entry].state, reason, m_UserCookie);
+
+			remove(entry, findSlotOfEntry(entry));
+		}
+
+		size_t evictIdle(uint64_t now)
+		{
+			if (m_IdleTimeoutNs == 0)
+				return 0;
+
+			// the least recently used flow is the one seen longest ago, so stop at the first flow that isn't idle
+			size_t count = 0;
+			while (m_LruTail != NoEntry && m_Entries[m_LruTail].lastSeen + m_IdleTimeoutNs < now)
+			{
+				evict(m_LruTail, FlowIdleTimeout);
+				count++;
+			}
+			return count;
+		}
+	};
+
+}  // namespace pcpp
+
+namespace std
+{
+	/**
+	 * A std::hash specialization that allows using FlowKey as a key of unordered containers
+	 */
+	template <> struct hash<pcpp::FlowKey>
+	{
+		size_t operator()(const pcpp::FlowKey& key) const
+		{
+			return static_cast<size_t>(key.hash());
+		}
+	};
+
+	/**
+	 * A std::hash specialization that allows using FiveTuple as a key of unordered containers
+	 */
+	template <> struct hash<pcpp::FiveTuple>
+	{
+		size_t operator()(const pcpp::FiveTuple& tuple) const
+		{
+			return static_cast<size_t>(tuple.hash());
+		}
+	};
+}  // namespace std
@@ -0,0 +1,414 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "HttpLayer.h"
+#include "TcpReassembly.h"
+
+/// @file
+
+/**
+ * \namespace pcpp
+ * \brief The main namespace for the PcapPlusPlus lib
+ */
+namespace pcpp
+{
+	/**
+	 * @struct HttpFieldView
+	 * A header field of a message parsed by HttpReassembly. The name and value point into the parsed data and are
+	 * valid only during the callback the message is passed to
+	 */
+	struct HttpFieldView
+	{
+		/** The field name, not null-terminated */
+		const char* name;
+		/** The field name length */
+		size_t nameLength;
+		/** The field value without leading and trailing whitespace, not null-terminated */
+		const char* value;
+		/** The field value length */
+		size_t valueLength;
+	};
+
+	/**
+	 * @class HttpMessageView
+	 * The start line and header fields of an HTTP request or response parsed by HttpReassembly. The view points into
+	 * the parsed data and is valid only during the HttpReassembly#OnHttpMessageHeaders callback it's passed to
+	 */
+	class HttpMessageView
+	{
+		friend class HttpReassembly;
+
+	public:
+		/**
+		 * @return True if the message is a request, false if it's a response
+		 */
+		bool isRequest() const
+		{
+			return m_IsRequest;
+		}
+
+		/**
+		 * @return The request method. For responses, the method of the request the response answers, or
+		 * HttpRequestLayer#HttpMethodUnknown if it isn't known
+		 */
+		HttpRequestLayer::HttpMethod getMethod() const
+		{
+			return m_Method;
+		}
+
+		/**
+		 * @return The request URI, not null-terminated. nullptr for responses
+		 */
+		const char* getUri() const
+		{
+			return m_Uri;
+		}
+
+		/**
+		 * @return The request URI length, 0 for responses
+		 */
+		size_t getUriLength() const
+		{
+			return m_UriLength;
+		}
+
+		/**
+		 * @return The response status code, for example 200. 0 for requests
+		 */
+		int getStatusCode() const
+		{
+			return m_StatusCode;
+		}
+
+		/**
+		 * @return The HTTP version of the message
+		 */
+		HttpVersion getVersion() const
+		{
+			return m_Version;
+		}
+
+		/**
+		 * @return A pointer to the raw header data, from the start line up to and including the empty line that ends
+		 * the header
+		 */
+		const char* getHeaderData() const
+		{
+			return m_HeaderData;
+		}
+
+		/**
+		 * @return The raw header length
+		 */
+		size_t getHeaderLength() const
+		{
+			return m_HeaderLength;
+		}
+
+		/**
+		 * @return The number of header fields
+		 */
+		size_t getFieldCount() const
+		{
+			return m_Fields.size();
+		}
+
+		/**
+		 * Get a header field by its position
+		 * @param[in] index The field index, must be lower than getFieldCount()
+		 * @return The field
+		 */
+		const HttpFieldView& getField(size_t index) const
+		{
+			return m_Fields[index];
+		}
+
+		/**
+		 * Get a header field by name. The search is case insensitive
+		 * @param[in] name The field name
+		 * @param[in] index If the field appears more than once, which appearance to get. The default is 0
+		 * @return A pointer to the field or nullptr if it doesn't exist
+		 */
+		const HttpFieldView* getFieldByName(const std::string& name, size_t index = 0) const;
+
+		/**
+		 * @return True if the message body uses the chunked transfer encoding
+		 */
+		bool isChunked() const
+		{
+			return m_IsChunked;
+		}
+
+		/**
+		 * @return The value of the Content-Length field or -1 if the message doesn't have one
+		 */
+		int64_t getContentLength() const
+		{
+			return m_ContentLength;
+		}
+
+	private:
+		bool m_IsRequest;
+		HttpRequestLayer::HttpMethod m_Method;
+		const char* m_Uri;
+		size_t m_UriLength;
+		int m_StatusCode;
+		HttpVersion m_Version;
+		const char* m_HeaderData;
+		size_t m_HeaderLength;
+		std::vector<HttpFieldView> m_Fields;
+		bool m_IsChunked;
+		int64_t m_ContentLength;
+
+		HttpMessageView();
+		bool parse(const char* data, size_t dataLen);
+	};
+
+	/**
+	 * @struct HttpMessageInfo
+	 * A summary of an HTTP message passed to the HttpReassembly#OnHttpMessageEnd callback
+	 */
+	struct HttpMessageInfo
+	{
+		/** True if the message is a request, false if it's a response */
+		bool isRequest;
+		/** The request method. For responses, the method of the request the response answers if it's known */
+		HttpRequestLayer::HttpMethod method;
+		/** The response status code, 0 for requests */
+		int statusCode;
+		/** The HTTP version of the message */
+		HttpVersion version;
+		/** The header length in bytes */
+		size_t headerLength;
+		/** The number of body bytes passed to the HttpReassembly#OnHttpBodyData callback, after chunked decoding */
+		uint64_t bodyLength;
+		/** False if part of the message was lost, or the connection ended before the message did */
+		bool isComplete;
+	};
+
+	/**
+	 * @struct HttpReassemblyConfiguration
+	 * A structure for configuring the HttpReassembly class
+	 */
+	struct HttpReassemblyConfiguration
+	{
+		/** The maximum size of a message header. Larger headers are treated as parse errors. The default is 16KB */
+		size_t maxHeaderSize;
+		/** The maximum number of concurrent connections, 0 means unlimited. The default is 100,000 */
+		size_t maxConnections;
+
+		/**
+		 * A c'tor for this struct
+		 * @param[in] maxHeaderSize The maximum size of a message header, default is 16KB
+		 * @param[in] maxConnections The maximum number of concurrent connections, default is 100,000
+		 */
+		explicit HttpReassemblyConfiguration(size_t maxHeaderSize = 16384, size_t maxConnections = 100000)
+		    : maxHeaderSize(maxHeaderSize), maxConnections(maxConnections)
+		{}
+	};
+
+	/**
+	 * @class HttpReassembly
+	 * A streaming HTTP/1.x parser that reassembles requests and responses from the data of TcpReassembly. The
+	 * parser is incremental: a header is buffered until it's complete, but bodies are never buffered. Body data is
+	 * passed to a callback as it arrives, after removing the chunked transfer encoding framing if it's used, so the
+	 * memory used per connection is bounded by the maximum header size regardless of the message sizes. The parser
+	 * supports:
+	 *    - Pipelined requests and persistent connections
+	 *    - Bodies delimited by Content-Length, by the chunked transfer encoding, or by the end of the connection
+	 *    - Responses without a body: responses to HEAD requests, 1xx, 204 and 304 responses
+	 *    - Connections that stop being HTTP after a 101 response or a successful CONNECT
+	 *    - Lost data: lost body bytes of a message with a known length are skipped and the message is reported as
+	 *      incomplete. Otherwise the parser skips data until a TCP segment that starts a new message
+	 *
+	 * The parser can be fed directly by TcpReassembly by passing onTcpMessageReady() and onTcpConnectionEnd() as its
+	 * callbacks and the HttpReassembly instance as its cookie, or by calling processTcpData() and closeConnection()
+	 * from the user's own TcpReassembly callbacks. For each message the OnHttpMessageHeaders callback is invoked once
+	 * the header is complete, the OnHttpBodyData callback is invoked for each piece of the body and the
+	 * OnHttpMessageEnd callback is invoked when the message ends. The side parameter of the callbacks is the side of
+	 * the TCP connection as given by TcpReassembly. This class isn't thread-safe
+	 */
+	class HttpReassembly
+	{
+	public:
+		/**
+		 * @typedef OnHttpMessageHeaders
+		 * A callback invoked when the header of a message is complete
+		 * @param[in] side The side of the TCP connection the message was sent from
+		 * @param[in] message The message start line and header fields. Valid only until the callback returns
+		 * @param[in] connectionData The TCP connection information
+		 * @param[in] userCookie The user cookie given in the c'tor
+		 */
+		typedef void (*OnHttpMessageHeaders)(int8_t side, const HttpMessageView& message,
+		                                     const ConnectionData& connectionData, void* userCookie);
+
+		/**
+		 * @typedef OnHttpBodyData
+		 * A callback invoked for each piece of a message body
+		 * @param[in] side The side of the TCP connection the message was sent from
+		 * @param[in] data The body data. Valid only until the callback returns
+		 * @param[in] dataLen The body data length
+		 * @param[in] connectionData The TCP connection information
+		 * @param[in] userCookie The user cookie given in the c'tor
+		 */
+		typedef void (*OnHttpBodyData)(int8_t side, const uint8_t* data, size_t dataLen,
+		                               const ConnectionData& connectionData, void* userCookie);
+
+		/**
+		 * @typedef OnHttpMessageEnd
+		 * A callback invoked when a message ends
+		 * @param[in] side The side of the TCP connection the message was sent from
+		 * @param[in] message A summary of the message
+		 * @param[in] connectionData The TCP connection information
+		 * @param[in] userCookie The user cookie given in the c'tor
+		 */
+		typedef void (*OnHttpMessageEnd)(int8_t side, const HttpMessageInfo& message,
+		                                 const ConnectionData& connectionData, void* userCookie);
+
+		/**
+		 * @struct HttpReassemblyStats
+		 * Reassembly counters
+		 */
+		struct HttpReassemblyStats
+		{
+			/** Requests whose header was parsed */
+			uint64_t requests;
+			/** Responses whose header was parsed */
+			uint64_t responses;
+			/** Messages that ended incomplete */
+			uint64_t incompleteMessages;
+			/** Data that couldn't be parsed as HTTP, including headers larger than the maximum size */
+			uint64_t parseErrors;
+			/** Pieces of TCP data ignored because the maximum number of connections was reached */
+			uint64_t ignoredTcpData;
+		};
+
+		/**
+		 * A c'tor for this class
+		 * @param[in] onMessageHeaders The callback to invoke when a message header is complete. Can be nullptr
+		 * @param[in] onBodyData The callback to invoke for body data. Can be nullptr
+		 * @param[in] onMessageEnd The callback to invoke when a message ends. Can be nullptr
+		 * @param[in] userCookie A pointer passed to the callbacks
+		 * @param[in] config The reassembly configuration
+		 */
+		HttpReassembly(OnHttpMessageHeaders onMessageHeaders, OnHttpBodyData onBodyData,
+		               OnHttpMessageEnd onMessageEnd, void* userCookie = nullptr,
+		               const HttpReassemblyConfiguration& config = HttpReassemblyConfiguration());
+
+		HttpReassembly(const HttpReassembly&) = delete;
+		HttpReassembly& operator=(const HttpReassembly&) = delete;
+
+		/**
+		 * Parse new data of a TCP connection. Should be called from a TcpReassembly#OnTcpMessageReady callback
+		 * @param[in] side The side of the TCP connection the data was sent from
+		 * @param[in] tcpData The data
+		 */
+		void processTcpData(int8_t side, const TcpStreamData& tcpData);
+
+		/**
+		 * End the messages in progress on a connection and release its state. Should be called from a
+		 * TcpReassembly#OnTcpConnectionEnd callback
+		 * @param[in] connectionData The TCP connection information
+		 * @param[in] isClosedByFinRst True if the connection was closed by FIN or RST, in which case a response whose
+		 * body is delimited by the end of the connection is complete. False if it was closed manually
+		 * @note This method and processTcpData() must not be called from the HttpReassembly callbacks
+		 */
+		void closeConnection(const ConnectionData& connectionData, bool isClosedByFinRst);
+
+		/**
+		 * A TcpReassembly#OnTcpMessageReady callback that calls processTcpData()
+		 * @param[in] side The side of the TCP connection the data was sent from
+		 * @param[in] tcpData The data
+		 * @param[in] userCookie A pointer to the HttpReassembly instance
+		 */
+		static void onTcpMessageReady(int8_t side, const TcpStreamData& tcpData, void* userCookie);
+
+		/**
+		 * A TcpReassembly#OnTcpConnectionEnd callback that calls closeConnection()
+		 * @param[in] connectionData The TCP connection information
+		 * @param[in] reason The reason the connection ended
+		 * @param[in] userCookie A pointer to the HttpReassembly instance
+		 */
+		static void onTcpConnectionEnd(const ConnectionData& connectionData, TcpReassembly::ConnectionEndReason reason,
+		                               void* userCookie);
+
+		/**
+		 * @return The number of connections currently tracked
+		 */
+		size_t getNumOfConnections() const
+		{
+			return m_Connections.size();
+		}
+
+		/**
+		 * @return The reassembly counters
+		 */
+		const HttpReassemblyStats& getStatistics() const
+		{
+			return m_Stats;
+		}
+
+	private:
+		enum ParseState : uint8_t
+		{
+			MessageStart,
+			BodyWithLength,
+			ChunkSize,
+			ChunkData,
+			ChunkDataEnd,
+			ChunkTrailer,
+			BodyUntilClose,
+			NotHttp
+		};
+
+		struct StreamState
+		{
+			ParseState state;
+			HttpMessageInfo message;
+			uint64_t remaining;
+			// a partial header, chunk size line or trailer line
+			std::string buffer;
+
+			StreamState();
+		};
+
+		static const size_t MaxPendingRequests = 16;
+
+		struct ConnectionState
+		{
+			StreamState sides[2];
+			// the methods of requests waiting for a response, needed to know if a response has a body
+			uint8_t pendingMethods[MaxPendingRequests];
+			uint8_t firstPendingMethod;
+			uint8_t numOfPendingMethods;
+			bool isTunnel;
+
+			ConnectionState();
+		};
+
+		OnHttpMessageHeaders m_OnMessageHeaders;
+		OnHttpBodyData m_OnBodyData;
+		OnHttpMessageEnd m_OnMessageEnd;
+		void* m_UserCookie;
+		HttpReassemblyConfiguration m_Config;
+		std::unordered_map<uint32_t, ConnectionState> m_Connections;
+		HttpMessageView m_MessageView;
+		HttpReassemblyStats m_Stats;
+
+		void processData(ConnectionState& connection, int8_t side, const uint8_t* data, size_t dataLen,
+		                 const ConnectionData& connectionData);
+		size_t processHeader(ConnectionState& connection, int8_t side, const uint8_t* data, size_t dataLen,
+		                     const ConnectionData& connectionData);
+		bool startMessage(ConnectionState& connection, int8_t side, const char* header, size_t headerLen,
+		                  const ConnectionData& connectionData);
+		void endMessage(ConnectionState& connection, int8_t side, const ConnectionData& connectionData);
+		void abortMessage(ConnectionState& connection, int8_t side, const ConnectionData& connectionData);
+		void skipMissingData(ConnectionState& connection, int8_t side, size_t missingBytes, const uint8_t* data,
+		                     size_t dataLen, const ConnectionData& connectionData);
+		void setParseError(ConnectionState& connection, int8_t side, const ConnectionData& connectionData);
+	};
+
+}  // namespace pcpp
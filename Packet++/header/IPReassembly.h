@@ -1,10 +1,8 @@
 #pragma once
 
 #include "Packet.h"
-#include "LRUList.h"
 #include "IpAddress.h"
-#include "PointerVector.h"
-#include <unordered_map>
+#include <vector>
 
 /**
  * @file
@@ -16,28 +14,33 @@
  * parameter, does the reassembly and returns a fully reassembled packet when done.<BR>
  *
  * The logic works as follows:
- * - There is an internal map that stores the reassembly data for each packet. The key to this map, meaning the way to
- *   uniquely associate a fragment to a (reassembled) packet is the triplet of source IP, destination IP and IP ID (for
- *   IPv4) or Fragment ID (for IPv6)
- * - When the first fragment arrives a new record is created in the map and the fragment data is copied
- * - With each fragment arriving the fragment data is copied right after the previous fragment and the reassembled
- *   packet is gradually being built
- * - When the last fragment arrives the packet is fully reassembled and returned to the user. Since all fragment data is
- *   copied, the packet pointer returned to the user has to be freed by the user when done using it
- * - The logic supports out-of-order fragments, meaning that a fragment which arrives out-of-order, its data will be
- *   copied to a list of out-of-order fragments where it waits for its turn. This list is observed each time a new
- *   fragment arrives to see if the next fragment(s) wait(s) in this list
+ * - There is an internal table that stores the reassembly data for each packet. The key to this table, meaning the
+ *   way to uniquely associate a fragment to a (reassembled) packet is the triplet of source IP, destination IP and IP
+ *   ID (for IPv4) or Fragment ID (for IPv6). The whole key is compared, not only its hash, so fragments of different
+ *   packets are never mixed
+ * - When the first fragment of a packet arrives (no matter if it's the fragment with offset 0 or not) a record is taken
+ *   from a pool of records. Records of packets that were reassembled or dropped are returned to the pool along with
+ *   their buffers, so their memory is reused by the next packets
+ * - The data of each fragment is copied directly to its offset in the reassembled packet buffer, and the ranges that
+ *   are still missing (the "holes") are tracked as described in RFC 815. This means out-of-order fragments are
+ *   handled without storing them aside and without searching for the next fragment
+ * - When there are no holes left and both the first and last fragments arrived the packet is fully reassembled and
+ *   returned to the user. Since all fragment data is copied, the packet pointer returned to the user has to be freed
+ *   by the user when done using it
  * - If a non-IP packet arrives it's returned as is to the user
  * - If a non-fragment packet arrives it's returned as is to the user
  *
  * In order to limit the amount of memory used by this mechanism there is a limit to the number of concurrent packets
  * being reassembled. The default limit is #PCPP_IP_REASSEMBLY_DEFAULT_MAX_PACKETS_TO_STORE but the user can set any
  * value (determined in pcpp#IPReassembly c'tor). Once capacity (the number of concurrent reassembled packets) exceeds
- * this number, the packet that was least recently used will be dropped from the map along with all the data that was
- * reassembled so far. This means that if the next fragment from this packet suddenly appears it will be treated as a
- * new reassembled packet (which will create another record in the map). The user can be notified when reassembled
- * packets are removed from the map by registering to the pcpp#IPReassembly#OnFragmentsClean callback in
- * pcpp#IPReassembly c'tor
+ * this number, the packet that was least recently used will be dropped from the table along with all the data that
+ * was reassembled so far. This means that if the next fragment from this packet suddenly appears it will be treated as
+ * a new reassembled packet (which will create another record in the table). In addition, the total size of the
+ * fragment data that is stored can be limited with pcpp#IPReassembly#setMaxMemoryUsage(), and packets whose fragments
+ * stop arriving can be dropped after a timeout with pcpp#IPReassembly#setFragmentTimeout(). The user can be notified
+ * when reassembled packets are dropped by registering to the pcpp#IPReassembly#OnFragmentsClean callback in
+ * pcpp#IPReassembly c'tor, and the number of dropped packets and fragments is available in
+ * pcpp#IPReassembly#getStatistics()
  */
 
 /**
@@ -345,7 +348,8 @@ namespace pcpp
 		 * The IP reassembly mechanism has a certain capacity of concurrent packets it can handle. This capacity is
 		 * determined in its c'tor (default value is #PCPP_IP_REASSEMBLY_DEFAULT_MAX_PACKETS_TO_STORE). When traffic
 		 * volume exceeds this capacity the mechanism starts dropping packets in a LRU manner (least recently used are
-		 * dropped first). Whenever a packet is dropped this callback is fired
+		 * dropped first). Packets are also dropped when the memory limit is reached or when they time out. Whenever a
+		 * packet is dropped this callback is fired
 		 * @param[in] key A pointer to the identifier of the packet that is being dropped
 		 * @param[in] userCookie A pointer to the cookie provided by the user in IPReassemby c'tor (or nullptr if no
 		 * cookie provided)
@@ -374,6 +378,27 @@ namespace pcpp
 			REASSEMBLED = 0x20
 		};
 
+		/**
+		 * @struct Statistics
+		 * Counters of the packets and fragments processed by IPReassembly
+		 */
+		struct Statistics
+		{
+			/** The number of packets that were fully reassembled */
+			uint64_t packetsReassembled;
+			/** The number of fragments whose data was already received, such as retransmitted fragments */
+			uint64_t duplicateFragments;
+			/** The number of fragments that were dropped because they are inconsistent with the other fragments of
+			 * their packet, for example data beyond the last fragment or beyond the maximum IP packet size */
+			uint64_t malformedFragments;
+			/** The number of partially reassembled packets that were dropped because the capacity limit was reached */
+			uint64_t packetsDroppedCapacity;
+			/** The number of partially reassembled packets that were dropped because the memory limit was reached */
+			uint64_t packetsDroppedMemory;
+			/** The number of partially reassembled packets that were dropped because they timed out */
+			uint64_t packetsDroppedTimeout;
+		};
+
 		/**
 		 * A c'tor for this class.
 		 * @param[in] onFragmentsCleanCallback The callback to be called when packets are dropped due to capacity limit.
@@ -385,15 +410,7 @@ namespace pcpp
 		 * #PCPP_IP_REASSEMBLY_DEFAULT_MAX_PACKETS_TO_STORE
 		 */
 		explicit IPReassembly(OnFragmentsClean onFragmentsCleanCallback = nullptr, void* callbackUserCookie = nullptr,
-		                      size_t maxPacketsToStore = PCPP_IP_REASSEMBLY_DEFAULT_MAX_PACKETS_TO_STORE)
-		    : m_PacketLRU(maxPacketsToStore), m_OnFragmentsCleanCallback(onFragmentsCleanCallback),
-		      m_CallbackUserCookie(callbackUserCookie)
-		{}
-
-		/**
-		 * A d'tor for this class
-		 */
-		~IPReassembly();
+		                      size_t maxPacketsToStore = PCPP_IP_REASSEMBLY_DEFAULT_MAX_PACKETS_TO_STORE);
 
 		/**
 		 * The main API that drives IPReassembly. This method should be called whenever a fragment arrives. This method
@@ -408,9 +425,9 @@ namespace pcpp
 		 * - The input fragment is not a IPv4 or IPv6 fragment packet
 		 * - The input fragment is the first fragment of the packet
 		 * - The input fragment is not the first or last fragment
-		 * - The input fragment came out-of-order, meaning that wasn't the fragment that was currently expected (it's
-		 *   data is copied to the out-of-order fragment list)
-		 * - The input fragment is malformed and will be ignored
+		 * - The input fragment came out-of-order, meaning that wasn't the fragment that was currently expected (its
+		 *   data is copied to its place in the reassembled packet)
+		 * - The input fragment is malformed and will be ignored, for example if it ends beyond the last fragment
 		 * - The input fragment is the last one and the packet is now fully reassembled. In this case the return value
 		 * will contain a pointer to the reassembled packet
 		 * @param[in] parseUntil Optional parameter. Parse the reassembled packet until you reach a certain protocol
@@ -447,9 +464,9 @@ namespace pcpp
 		 * - The input fragment is not a IPv4 or IPv6 fragment packet
 		 * - The input fragment is the first fragment of the packet
 		 * - The input fragment is not the first or last fragment
-		 * - The input fragment came out-of-order, meaning that wasn't the fragment that was currently expected (it's
-		 *   data is copied to the out-of-order fragment list)
-		 * - The input fragment is malformed and will be ignored
+		 * - The input fragment came out-of-order, meaning that wasn't the fragment that was currently expected (its
+		 *   data is copied to its place in the reassembled packet)
+		 * - The input fragment is malformed and will be ignored, for example if it ends beyond the last fragment
 		 * - The input fragment is the last one and the packet is now fully reassembled. In this case the return value
 		 *   will contain a pointer to the reassembled packet
 		 * @param[in] parseUntil Optional parameter. Parse the raw and reassembled packets until you reach a certain
@@ -500,7 +517,7 @@ namespace pcpp
 		 */
 		size_t getMaxCapacity() const
 		{
-			return m_PacketLRU.getMaxSize();
+			return m_MaxPacketsToStore;
 		}
 
 		/**
@@ -508,62 +525,137 @@ namespace pcpp
 		 */
 		size_t getCurrentCapacity() const
 		{
-			return m_FragmentMap.size();
+			return m_NumOfEntries;
+		}
+
+		/**
+		 * Limit the total size of the fragment data stored for partially reassembled packets. When a fragment would
+		 * exceed this limit, the least recently used packets are dropped until it fits. If the packet the fragment
+		 * belongs to doesn't fit by itself, this packet is dropped instead
+		 * @param[in] maxMemoryUsage The limit in bytes, 0 means no limit (which is the default)
+		 */
+		void setMaxMemoryUsage(size_t maxMemoryUsage)
+		{
+			m_MaxMemoryUsage = maxMemoryUsage;
+		}
+
+		/**
+		 * @return The limit set in setMaxMemoryUsage(), 0 means no limit
+		 */
+		size_t getMaxMemoryUsage() const
+		{
+			return m_MaxMemoryUsage;
+		}
+
+		/**
+		 * @return The total size in bytes of the fragment data currently stored for partially reassembled packets
+		 */
+		size_t getCurrentMemoryUsage() const
+		{
+			return m_CurrentMemoryUsage;
+		}
+
+		/**
+		 * Drop partially reassembled packets that didn't get a new fragment for a certain time. Time is measured by the
+		 * timestamps of the processed fragments, so it works the same for live traffic and for packets read from a
+		 * file. Expired packets are dropped when the next fragment is processed
+		 * @param[in] timeoutSec The timeout in seconds, 0 means packets never time out (which is the default)
+		 */
+		void setFragmentTimeout(uint32_t timeoutSec)
+		{
+			m_FragmentTimeoutSec = timeoutSec;
 		}
 
+		/**
+		 * @return The timeout set in setFragmentTimeout(), 0 means packets never time out
+		 */
+		uint32_t getFragmentTimeout() const
+		{
+			return m_FragmentTimeoutSec;
+		}
+
+		/**
+		 * @return The counters of the packets and fragments processed so far
+		 */
+		const Statistics& getStatistics() const
+		{
+			return m_Statistics;
+		}
+
+		/**
+		 * Zero all counters returned by getStatistics()
+		 */
+		void resetStatistics();
+
 	private:
-		struct IPFragment
+		struct FragmentKey
 		{
-			uint16_t fragmentOffset;
-			bool lastFragment;
-			uint8_t* fragmentData;
-			size_t fragmentDataLen;
-			IPFragment()
-			{
-				fragmentOffset = 0;
-				lastFragment = false;
-				fragmentData = nullptr;
-				fragmentDataLen = 0;
-			}
-			~IPFragment()
-			{
-				delete[] fragmentData;
-			}
+			uint8_t srcIP[16];
+			uint8_t dstIP[16];
+			uint32_t fragmentID;
+			ProtocolType protocol;
+
+			bool operator==(const FragmentKey& other) const;
+		};
+
+		// a range of the reassembled payload that wasn't received yet, "end" is exclusive
+		struct FragmentHole
+		{
+			size_t start;
+			size_t end;
 		};
 
 		struct IPFragmentData
 		{
-			uint16_t currentOffset;
-			RawPacket* data;
-			bool deleteData;
-			uint32_t fragmentID;
-			PacketKey* packetKey;
-			PointerVector<IPFragment> outOfOrderFragments;
-			IPFragmentData(PacketKey* pktKey, uint32_t fragId)
-			{
-				currentOffset = 0;
-				data = nullptr;
-				deleteData = true;
-				fragmentID = fragId;
-				packetKey = pktKey;
-			}
-			~IPFragmentData()
-			{
-				delete packetKey;
-				if (deleteData && data != nullptr)
-				{
-					delete data;
-				}
-			}
+			FragmentKey key;
+			uint32_t hash;
+			// the LRU list links, for records in the pool lruNext links the free records
+			uint32_t lruPrev;
+			uint32_t lruNext;
+			bool gotFirstFragment;
+			bool gotLastFragment;
+			time_t lastSeenSec;
+			timespec timestamp;
+			LinkLayerType linkLayerType;
+			size_t ipHeaderOffset;
+			// the first fragment from the beginning of the packet up to the IP payload
+			std::vector<uint8_t> headerData;
+			std::vector<uint8_t> payload;
+			// sorted by offset
+			std::vector<FragmentHole> holes;
 		};
 
-		LRUList<uint32_t> m_PacketLRU;
-		std::unordered_map<uint32_t, IPFragmentData*> m_FragmentMap;
+		std::vector<IPFragmentData> m_Entries;
+		// an open addressing hash table of indices into m_Entries
+		std::vector<uint32_t> m_Buckets;
+		uint32_t m_FreeEntries;
+		uint32_t m_LruHead;
+		uint32_t m_LruTail;
+		size_t m_NumOfEntries;
+		size_t m_MaxPacketsToStore;
+		size_t m_MaxMemoryUsage;
+		size_t m_CurrentMemoryUsage;
+		uint32_t m_FragmentTimeoutSec;
+		Statistics m_Statistics;
 		OnFragmentsClean m_OnFragmentsCleanCallback;
 		void* m_CallbackUserCookie;
 
-		void addNewFragment(uint32_t hash, IPFragmentData* fragData);
-		bool matchOutOfOrderFragments(IPFragmentData* fragData);
+		static void createFragmentKey(const PacketKey& packetKey, FragmentKey& result);
+		static uint32_t hashFragmentKey(const FragmentKey& key);
+
+		uint32_t findEntry(const FragmentKey& key, uint32_t hash) const;
+		uint32_t createEntry(const FragmentKey& key, uint32_t hash);
+		void releaseEntry(uint32_t index);
+		void dropEntry(uint32_t index, uint64_t& dropCounter);
+		void moveToLruHead(uint32_t index);
+		void unlinkFromLru(uint32_t index);
+		void insertToBuckets(uint32_t index);
+		void removeFromBuckets(uint32_t index);
+		void dropExpiredEntries(time_t now);
+		bool reserveMemory(uint32_t index, size_t bytes);
+		void addFragmentData(uint32_t index, size_t offset, const uint8_t* data, size_t dataLen, bool isLastFragment);
+		Packet* createPacket(const IPFragmentData& fragData, size_t payloadLen, ProtocolType parseUntil,
+		                     OsiModelLayer parseUntilLayer) const;
 	};
 
 }  // namespace pcpp
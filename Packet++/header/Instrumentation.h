@@ -0,0 +1,173 @@
+#pragma once
+
+#include "ProtocolType.h"
+#include <array>
+#include <cstdint>
+#include <string>
+
+/// @file
+
+/**
+ * Count an instrumentation event of the calling thread. It's compiled out unless PcapPlusPlus is built with
+ * PCAPPP_ENABLE_INSTRUMENTATION, in which case PCPP_INSTRUMENTATION is defined when compiling the libraries
+ * @param[in] counter The name of a pcpp::InstrumentationCounter value
+ * @param[in] value The value to add to the counter
+ */
+#ifdef PCPP_INSTRUMENTATION
+#	define PCPP_INSTRUMENT_COUNT(counter, value)                                                                       \
+		pcpp::internal::addToInstrumentationCounter(pcpp::InstrumentationCounter::counter, value)
+#	define PCPP_INSTRUMENT_LAYER(protocol) pcpp::internal::countLayerAllocation(protocol)
+#else
+#	define PCPP_INSTRUMENT_COUNT(counter, value) ((void)0)
+#	define PCPP_INSTRUMENT_LAYER(protocol) ((void)0)
+#endif
+
+/**
+ * \namespace pcpp
+ * \brief The main namespace for the PcapPlusPlus lib
+ */
+namespace pcpp
+{
+	namespace internal
+	{
+		class InstrumentationRegistry;
+	}
+
+	/**
+	 * The events counted by the instrumentation of the libraries
+	 */
+	enum class InstrumentationCounter
+	{
+		/** RawPacket objects copied with the copy c'tor or assignment operator */
+		RawPacketCopies,
+		/** Bytes copied by RawPacket copies */
+		RawPacketBytesCopied,
+		/** Buffers allocated by TcpReassembly for out-of-order TCP fragments */
+		TcpReassemblyFragmentBuffers,
+		/** Bytes copied into TcpReassembly out-of-order fragment buffers */
+		TcpReassemblyBytesBuffered,
+		/** Fragment buffers grown and reassembled packets allocated by IPReassembly */
+		IPReassemblyBuffers,
+		/** Bytes copied into IPReassembly fragment buffers */
+		IPReassemblyBytesBuffered,
+		/** Packets matched against a BPF filter */
+		FilterEvaluations,
+		/** Batches of packets received from a live device (a pcap_dispatch() or rte_eth_rx_burst() call that returned
+		 * packets) */
+		DeviceRxBatches,
+		/** Packets received from a live device */
+		DeviceRxPackets,
+		/** Batches of packets sent to a live device (a PcapLiveDevice#sendPackets() call or a DpdkDevice send call) */
+		DeviceTxBatches,
+		/** Packets sent to a live device */
+		DeviceTxPackets,
+		/** The number of counters, not a counter */
+		NumOfCounters
+	};
+
+	/**
+	 * @class InstrumentationSnapshot
+	 * The values of the instrumentation counters at a certain time, either the sum over all threads or the values of
+	 * a single thread. All values are 0 if the libraries were built without instrumentation
+	 */
+	class InstrumentationSnapshot
+	{
+	public:
+		/**
+		 * A c'tor that creates a snapshot with all values set to 0
+		 */
+		InstrumentationSnapshot();
+
+		/**
+		 * @param[in] counter The counter
+		 * @return The value of the counter
+		 */
+		uint64_t getCounter(InstrumentationCounter counter) const
+		{
+			return m_Counters[static_cast<size_t>(counter)];
+		}
+
+		/**
+		 * @param[in] protocol A protocol
+		 * @return The number of layers of this protocol that Packet allocated while parsing packets
+		 */
+		uint64_t getLayerAllocations(ProtocolType protocol) const
+		{
+			return m_LayerAllocations[protocol];
+		}
+
+		/**
+		 * @return The number of layers of all protocols that Packet allocated while parsing packets
+		 */
+		uint64_t getTotalLayerAllocations() const;
+
+		/**
+		 * @return The snapshot in the Prometheus text exposition format. Every counter is a metric named
+		 * "pcpp_<counter>_total" and layer allocations are a "pcpp_layer_allocations_total" metric with a protocol
+		 * label. Only protocols that had allocations are written
+		 */
+		std::string toPrometheusText() const;
+
+		/**
+		 * @return The snapshot as a JSON object with the counters as numbers and a "layer_allocations" object that
+		 * maps protocol names to the number of allocations
+		 */
+		std::string toJson() const;
+
+		/**
+		 * Subtract the values of an earlier snapshot, for example to get the events of a single stage
+		 * @param[in] other The earlier snapshot
+		 * @return A snapshot with the difference of every value
+		 */
+		InstrumentationSnapshot operator-(const InstrumentationSnapshot& other) const;
+
+	private:
+		friend class internal::InstrumentationRegistry;
+
+		std::array<uint64_t, static_cast<size_t>(InstrumentationCounter::NumOfCounters)> m_Counters;
+		std::array<uint64_t, 256> m_LayerAllocations;
+	};
+
+	/**
+	 * @return True if the libraries were built with instrumentation (PCAPPP_ENABLE_INSTRUMENTATION)
+	 */
+	bool isInstrumentationEnabled();
+
+	/**
+	 * @return The counters summed over all threads, including threads that already exited, since the last call to
+	 * resetInstrumentation()
+	 */
+	InstrumentationSnapshot getInstrumentationSnapshot();
+
+	/**
+	 * @return The counters of the calling thread since the last call to resetInstrumentation()
+	 */
+	InstrumentationSnapshot getThreadInstrumentationSnapshot();
+
+	/**
+	 * Start counting from 0 in all threads. The counters themselves are owned by the threads that update them, so the
+	 * current values are kept as an offset that is subtracted from later snapshots
+	 */
+	void resetInstrumentation();
+
+	/**
+	 * @param[in] counter A counter
+	 * @return The counter name as it appears in the exporters, for example "raw_packet_copies"
+	 */
+	std::string getInstrumentationCounterName(InstrumentationCounter counter);
+
+	namespace internal
+	{
+		/**
+		 * Add a value to a counter of the calling thread. Use PCPP_INSTRUMENT_COUNT() instead, which is compiled out
+		 * when instrumentation is disabled
+		 */
+		void addToInstrumentationCounter(InstrumentationCounter counter, uint64_t value);
+
+		/**
+		 * Count a layer allocation of the calling thread. Use PCPP_INSTRUMENT_LAYER() instead, which is compiled out
+		 * when instrumentation is disabled
+		 */
+		void countLayerAllocation(ProtocolType protocol);
+	}  // namespace internal
+}  // namespace pcpp
@@ -414,7 +414,9 @@ namespace pcpp
 
 		/**
 		 * @return The root ASN.1 record of the LDAP message. All of the message data will be under this record.
-		 * If the Root ASN.1 record is malformed, an exception is thrown
+		 * If the Root ASN.1 record is malformed, an exception is thrown. The record tree is decoded on the first
+		 * call: the getters of this class and its subclasses read the message data directly with Asn1Reader and
+		 * don't need it
 		 */
 		Asn1SequenceRecord* getRootAsn1Record() const;
 
@@ -498,7 +500,7 @@ namespace pcpp
 		 */
 		size_t getHeaderLen() const override
 		{
-			return m_Asn1Record->getTotalLength();
+			return m_MessageLength;
 		}
 
 		void computeCalculateFields() override
@@ -512,13 +514,20 @@ namespace pcpp
 		std::string toString() const override;
 
 	protected:
-		std::unique_ptr<Asn1Record> m_Asn1Record;
+		mutable std::unique_ptr<Asn1Record> m_Asn1Record;
+		size_t m_MessageLength = 0;
 
-		LdapLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-		          Packet* packet);
+		LdapLayer(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet);
 		LdapLayer() = default;
 		void init(uint16_t messageId, LdapOperationType operationType, const std::vector<Asn1Record*>& messageRecords,
 		          const std::vector<LdapControl>& controls);
+
+		// Getters for the ASN.1 elements of the message. They throw the same exceptions the Asn1Record tree does:
+		// std::invalid_argument if the data is malformed, std::bad_cast if an element doesn't have the expected type
+		// and std::out_of_range if a sub-element doesn't exist
+		Asn1Element getRootAsn1Element() const;
+		Asn1Element getLdapOperationAsn1Element() const;
+		static Asn1Element getSubElement(const Asn1Element& element, size_t index);
 		virtual std::string getExtendedInfoString() const
 		{
 			return "";
@@ -586,9 +595,8 @@ namespace pcpp
 		static constexpr uint8_t referralTagType = 3;
 
 		LdapResponseLayer() = default;
-		LdapResponseLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-		                  Packet* packet)
-		    : LdapLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapResponseLayer(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapLayer(data, dataLen, prevLayer, packet)
 		{}
 
 		LdapResponseLayer(uint16_t messageId, LdapOperationType operationType, LdapResultCode resultCode,
@@ -718,9 +726,8 @@ namespace pcpp
 	protected:
 		friend LdapLayer* LdapLayer::parseLdapMessage(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet);
 
-		LdapBindRequestLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-		                     Packet* packet)
-		    : LdapLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapBindRequestLayer(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapLayer(data, dataLen, prevLayer, packet)
 		{}
 
 		std::string getExtendedInfoString() const override;
@@ -771,9 +778,8 @@ namespace pcpp
 
 		static constexpr int serverSaslCredentialsTagType = 7;
 
-		LdapBindResponseLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-		                      Packet* packet)
-		    : LdapResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapBindResponseLayer(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapResponseLayer(data, dataLen, prevLayer, packet)
 		{}
 	};
 
@@ -809,9 +815,8 @@ namespace pcpp
 	protected:
 		friend LdapLayer* LdapLayer::parseLdapMessage(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet);
 
-		LdapUnbindRequestLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-		                       Packet* packet)
-		    : LdapLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapUnbindRequestLayer(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapLayer(data, dataLen, prevLayer, packet)
 		{}
 	};
 
@@ -1043,9 +1048,8 @@ namespace pcpp
 		static constexpr int filterIndex = 6;
 		static constexpr int attributesIndex = 7;
 
-		LdapSearchRequestLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-		                       Packet* packet)
-		    : LdapLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapSearchRequestLayer(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapLayer(data, dataLen, prevLayer, packet)
 		{}
 
 		std::string getExtendedInfoString() const override;
@@ -1093,9 +1097,8 @@ namespace pcpp
 		static constexpr int attributeTypeIndex = 0;
 		static constexpr int attributeValueIndex = 1;
 
-		LdapSearchResultEntryLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen,
-		                           Layer* prevLayer, Packet* packet)
-		    : LdapLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapSearchResultEntryLayer(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapLayer(data, dataLen, prevLayer, packet)
 		{}
 	};
 
@@ -1130,9 +1133,8 @@ namespace pcpp
 	protected:
 		friend LdapLayer* LdapLayer::parseLdapMessage(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet);
 
-		LdapSearchResultDoneLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen,
-		                          Layer* prevLayer, Packet* packet)
-		    : LdapResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapSearchResultDoneLayer(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapResponseLayer(data, dataLen, prevLayer, packet)
 		{}
 	};
 
@@ -1167,9 +1169,8 @@ namespace pcpp
 	protected:
 		friend LdapLayer* LdapLayer::parseLdapMessage(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet);
 
-		LdapModifyResponseLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-		                        Packet* packet)
-		    : LdapResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapModifyResponseLayer(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapResponseLayer(data, dataLen, prevLayer, packet)
 		{}
 	};
 
@@ -1204,9 +1205,8 @@ namespace pcpp
 	protected:
 		friend LdapLayer* LdapLayer::parseLdapMessage(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet);
 
-		LdapAddResponseLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-		                     Packet* packet)
-		    : LdapResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapAddResponseLayer(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapResponseLayer(data, dataLen, prevLayer, packet)
 		{}
 	};
 
@@ -1241,9 +1241,8 @@ namespace pcpp
 	protected:
 		friend LdapLayer* LdapLayer::parseLdapMessage(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet);
 
-		LdapDeleteResponseLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-		                        Packet* packet)
-		    : LdapResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapDeleteResponseLayer(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapResponseLayer(data, dataLen, prevLayer, packet)
 		{}
 	};
 
@@ -1278,9 +1277,8 @@ namespace pcpp
 	protected:
 		friend LdapLayer* LdapLayer::parseLdapMessage(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet);
 
-		LdapModifyDNResponseLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen,
-		                          Layer* prevLayer, Packet* packet)
-		    : LdapResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapModifyDNResponseLayer(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapResponseLayer(data, dataLen, prevLayer, packet)
 		{}
 	};
 
@@ -1315,9 +1313,8 @@ namespace pcpp
 	protected:
 		friend LdapLayer* LdapLayer::parseLdapMessage(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet);
 
-		LdapCompareResponseLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen,
-		                         Layer* prevLayer, Packet* packet)
-		    : LdapResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapCompareResponseLayer(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapResponseLayer(data, dataLen, prevLayer, packet)
 		{}
 	};
 }  // namespace pcpp
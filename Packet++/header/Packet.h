@@ -41,8 +41,10 @@ namespace pcpp
 		 * When using this constructor an empty raw buffer is allocated (with the size of maxPacketLen) and a new
 		 * RawPacket is created
 		 * @param[in] maxPacketLen The expected packet length in bytes
+		 * @param[in] headroom Bytes to allocate in front of the packet data, so layers inserted before the first layer
+		 * (for example by encapsulate()) don't move the data of the packet. The default is 0
 		 */
-		explicit Packet(size_t maxPacketLen = 1);
+		explicit Packet(size_t maxPacketLen = 1, size_t headroom = 0);
 
 		/**
 		 * A constructor for creating a new packet with a buffer that is pre-allocated by the user.
@@ -274,6 +276,33 @@ namespace pcpp
 		 */
 		bool removeAllLayersAfter(Layer* layer);
 
+		/**
+		 * Add layers in front of the first layer of the packet, for example the outer Ethernet, IP, UDP and VXLAN
+		 * layers of a tunnel. If the raw packet has enough headroom (see RawPacket#getHeadroom()) the layers are
+		 * prepended without moving the packet data, otherwise the headroom is allocated once for all the layers if the
+		 * packet data can be reallocated. The calculated fields of the new layers aren't computed, call
+		 * computeCalculateFields() afterwards
+		 * @param[in] outerLayers The layers to add, from the outermost one. Like in insertLayer() they're attached to
+		 * the packet and cannot be attached to other packets
+		 * @param[in] ownInPacket If true, Packet fully owns the layers, including memory deletion upon destruct.
+		 * Default is false.
+		 * @return True if all the layers were added, or false otherwise (an appropriate error log message will be
+		 * printed in such cases). If adding one of the layers failed the layers after it in outerLayers were already
+		 * added
+		 */
+		bool encapsulate(const std::vector<Layer*>& outerLayers, bool ownInPacket = false);
+
+		/**
+		 * Remove all the layers before a certain layer, which becomes the first layer of the packet, for example to
+		 * strip the outer layers of a tunnel. The removed bytes become headroom of the raw packet, so the packet data
+		 * isn't moved and the packet can be encapsulated again cheaply. The removed layers are deleted or detached
+		 * like in removeLayer(). The link layer type of the raw packet isn't changed
+		 * @param[in] innerLayer The layer that should become the first layer of the packet
+		 * @return True if the layers were removed, or false if innerLayer isn't a layer of this packet or removing a
+		 * layer failed. In any case of failure an appropriate error log message will be printed
+		 */
+		bool decapsulate(Layer* innerLayer);
+
 		/**
 		 * Detach a layer from the packet. Detaching means the layer instance will not be deleted, but rather separated
 		 * from the packet - e.g it will be removed from the layer chain of the packet and its data will be copied from
@@ -390,6 +419,8 @@ namespace pcpp
 		bool shortenLayer(Layer* layer, int offsetInLayer, size_t numOfBytesToShorten);
 
 		void reallocateRawData(size_t newSize);
+		bool reserveHeadroom(size_t headroom);
+		void updateLayersDataPtr();
 
 		bool removeLayer(Layer* layer, bool tryToDelete);
 
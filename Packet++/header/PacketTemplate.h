@@ -0,0 +1,342 @@
+#pragma once
+
+#include "IpAddress.h"
+#include "Packet.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @file
+
+/**
+ * \namespace pcpp
+ * \brief The main namespace for the PcapPlusPlus lib
+ */
+namespace pcpp
+{
+	/**
+	 * The well-known fields that PacketTemplate#addField() can find in a packet
+	 */
+	enum class PacketTemplateField
+	{
+		/** The source address of an IPv4 or IPv6 layer */
+		SrcIP,
+		/** The destination address of an IPv4 or IPv6 layer */
+		DstIP,
+		/** The IPv4 identification field */
+		IPv4Id,
+		/** The IPv4 TTL or IPv6 hop limit */
+		Ttl,
+		/** The source port of a TCP or UDP layer */
+		SrcPort,
+		/** The destination port of a TCP or UDP layer */
+		DstPort,
+		/** The TCP sequence number */
+		TcpSequence,
+		/** The TCP acknowledgment number */
+		TcpAck,
+		/** The payload of a TCP or UDP layer */
+		Payload
+	};
+
+	/**
+	 * @class PacketTemplate
+	 * A packet frozen into a byte template, used to craft many variants of the same packet much faster than building
+	 * each of them with Packet#addLayer() and Packet#computeCalculateFields().<BR>
+	 * The template is built once from a packet, then named fields (IP addresses, ports, sequence numbers, payload
+	 * regions or any other byte range) are added to it. A variant is made by copying the template into a buffer with
+	 * writeTo() and setting some of its fields. Setting a field patches its bytes in place and updates the checksums
+	 * that cover them incrementally (RFC 1624): IPv4 header checksums and TCP/UDP checksums, including the TCP/UDP
+	 * pseudo header and the checksums of outer layers when the packet is tunneled. Fields keep the length they have
+	 * in the template, so every variant has the same length and no length field changes.<BR>
+	 * A UDP checksum that is 0 in the template (not computed) is left 0. Other checksums (for example ICMP or GRE)
+	 * aren't updated, so fields covered by them shouldn't be changed.<BR>
+	 * Setting fields doesn't allocate memory, so it can be used at high packet rates.
+	 * PacketTemplateBatch keeps a batch of variants in preallocated buffers that can be sent with
+	 * PcapLiveDevice#sendPackets()
+	 */
+	class PacketTemplate
+	{
+	public:
+		/**
+		 * A c'tor that freezes a packet into a template. Packet#computeCalculateFields() is called on the packet
+		 * first, the packet can be reused or destroyed after the template is built
+		 * @param[in] packet The packet to build the template from
+		 */
+		explicit PacketTemplate(Packet& packet);
+
+		/**
+		 * Add a well-known field of the packet
+		 * @param[in] name The field name, must be unique in the template
+		 * @param[in] field The field
+		 * @param[in] layerIndex Which layer the field is taken from when the packet has several layers the field
+		 * can belong to, for example 1 for the inner IP layer of a tunneled packet. The IP fields count IPv4 and IPv6
+		 * layers, the port and payload fields count TCP and UDP layers and the TCP fields count TCP layers
+		 * @return The index of the field, or -1 if the name is already used or the packet has no such field
+		 */
+		int addField(const std::string& name, PacketTemplateField field, int layerIndex = 0);
+
+		/**
+		 * Add a field at any byte range of the packet
+		 * @param[in] name The field name, must be unique in the template
+		 * @param[in] offset The offset of the field from the start of the packet
+		 * @param[in] length The field length in bytes
+		 * @return The index of the field, or -1 if the name is already used, the range is out of the packet or it
+		 * overlaps a checksum that the template updates
+		 */
+		int addField(const std::string& name, size_t offset, size_t length);
+
+		/**
+		 * @param[in] name A field name
+		 * @return The index of the field, or -1 if there is no field with this name
+		 */
+		int getFieldIndex(const std::string& name) const;
+
+		/**
+		 * @param[in] fieldIndex A field index
+		 * @return The offset of the field from the start of the packet, or 0 if the index is invalid
+		 */
+		size_t getFieldOffset(int fieldIndex) const;
+
+		/**
+		 * @param[in] fieldIndex A field index
+		 * @return The field length in bytes, or 0 if the index is invalid
+		 */
+		size_t getFieldLength(int fieldIndex) const;
+
+		/**
+		 * @return The template bytes
+		 */
+		const uint8_t* getData() const
+		{
+			return m_Data.data();
+		}
+
+		/**
+		 * @return The length of the template and of every variant made from it
+		 */
+		size_t getDataLen() const
+		{
+			return m_Data.size();
+		}
+
+		/**
+		 * @return The link layer type of the packet the template was built from
+		 */
+		LinkLayerType getLinkLayerType() const
+		{
+			return m_LinkLayerType;
+		}
+
+		/**
+		 * Copy the template into a buffer to start a new variant
+		 * @param[out] buffer A buffer of at least getDataLen() bytes
+		 */
+		void writeTo(uint8_t* buffer) const;
+
+		/**
+		 * Set an integer field of a variant. The value is written in network byte order using the field length
+		 * @param[in,out] buffer A variant written by writeTo()
+		 * @param[in] fieldIndex The field index
+		 * @param[in] value The new value
+		 * @return False if the index is invalid or the field is longer than 8 bytes
+		 */
+		bool setFieldValue(uint8_t* buffer, int fieldIndex, uint64_t value) const;
+
+		/**
+		 * Set an IPv4 address field of a variant
+		 * @param[in,out] buffer A variant written by writeTo()
+		 * @param[in] fieldIndex The field index
+		 * @param[in] address The new address
+		 * @return False if the index is invalid or the field length isn't 4
+		 */
+		bool setFieldValue(uint8_t* buffer, int fieldIndex, const IPv4Address& address) const;
+
+		/**
+		 * Set an IPv6 address field of a variant
+		 * @param[in,out] buffer A variant written by writeTo()
+		 * @param[in] fieldIndex The field index
+		 * @param[in] address The new address
+		 * @return False if the index is invalid or the field length isn't 16
+		 */
+		bool setFieldValue(uint8_t* buffer, int fieldIndex, const IPv6Address& address) const;
+
+		/**
+		 * Copy bytes to the start of a field of a variant, for example a payload region
+		 * @param[in,out] buffer A variant written by writeTo()
+		 * @param[in] fieldIndex The field index
+		 * @param[in] data The bytes to copy
+		 * @param[in] dataLen The number of bytes, at most the field length
+		 * @return False if the index is invalid or dataLen is larger than the field length
+		 */
+		bool setFieldData(uint8_t* buffer, int fieldIndex, const uint8_t* data, size_t dataLen) const;
+
+	private:
+		// a checksum the template updates and the byte range it covers
+		struct ChecksumRegion
+		{
+			size_t start;
+			size_t end;
+			size_t checksumOffset;
+			// UDP checksums that are 0 aren't computed and are left 0
+			bool keepZero;
+			// the IP addresses in the pseudo header of a TCP/UDP checksum, an empty range for IPv4 header checksums
+			size_t pseudoHeaderStart;
+			size_t pseudoHeaderEnd;
+			// the other regions that cover the checksum bytes, for example the outer UDP checksum of a tunnel
+			std::vector<size_t> outerRegions;
+		};
+
+		// the part of a field covered by a checksum region, directly or through the pseudo header
+		struct FieldCoverage
+		{
+			size_t regionIndex;
+			size_t start;
+			size_t end;
+			// whether the first byte is the low byte of a 16-bit word of the checksum
+			bool isOdd;
+		};
+
+		struct Field
+		{
+			std::string name;
+			size_t offset;
+			size_t length;
+			std::vector<FieldCoverage> coverages;
+		};
+
+		// the IPv4, IPv6, TCP and UDP layers of the packet, used to find well-known fields
+		struct LayerInfo
+		{
+			ProtocolType protocol;
+			size_t offset;
+			size_t payloadOffset;
+			size_t end;
+		};
+
+		static constexpr size_t MaxFieldCoverages = 8;
+
+		void addLayers(Packet& packet);
+		void patch(uint8_t* buffer, const Field& field, const uint8_t* data, size_t dataLen) const;
+		void updateChecksum(uint8_t* buffer, size_t regionIndex, uint32_t oldSum, uint32_t newSum) const;
+		const Field* getField(int fieldIndex) const;
+
+		std::vector<uint8_t> m_Data;
+		LinkLayerType m_LinkLayerType;
+		std::vector<LayerInfo> m_Layers;
+		std::vector<ChecksumRegion> m_Regions;
+		std::vector<Field> m_Fields;
+	};
+
+	/**
+	 * @class PacketTemplateBatch
+	 * A batch of variants of a PacketTemplate in one preallocated buffer, with a RawPacket that points to each of
+	 * them. The RawPacket array can be sent as is with PcapLiveDevice#sendPackets(), or the variants can be copied to
+	 * other buffers such as DPDK mbufs. The batch can be reused: reset() copies the template into all the variants
+	 * again, or only the fields that change can be set again
+	 */
+	class PacketTemplateBatch
+	{
+	public:
+		/**
+		 * A c'tor that allocates the batch and copies the template into all of its variants
+		 * @param[in] packetTemplate The template. It must outlive the batch
+		 * @param[in] batchSize The number of variants in the batch
+		 */
+		PacketTemplateBatch(const PacketTemplate& packetTemplate, size_t batchSize);
+
+		PacketTemplateBatch(const PacketTemplateBatch&) = delete;
+		PacketTemplateBatch& operator=(const PacketTemplateBatch&) = delete;
+
+		/**
+		 * @return The number of variants in the batch
+		 */
+		size_t getBatchSize() const
+		{
+			return m_RawPackets.size();
+		}
+
+		/**
+		 * @param[in] index A variant index
+		 * @return The bytes of the variant
+		 */
+		uint8_t* getPacketData(size_t index)
+		{
+			return m_Buffer.data() + index * m_PacketTemplate.getDataLen();
+		}
+
+		/**
+		 * @return An array of getBatchSize() RawPacket objects that point to the variants. They don't own the data
+		 */
+		RawPacket* getRawPackets()
+		{
+			return m_RawPackets.data();
+		}
+
+		/**
+		 * Copy the template into all the variants
+		 */
+		void reset();
+
+		/**
+		 * Set the timestamp of all the variants
+		 * @param[in] timestamp The timestamp
+		 */
+		void setTimestamp(timespec timestamp);
+
+		/**
+		 * Set an integer field of a variant, see PacketTemplate#setFieldValue()
+		 * @param[in] index The variant index
+		 * @param[in] fieldIndex The field index
+		 * @param[in] value The new value
+		 * @return False if the field can't be set
+		 */
+		bool setFieldValue(size_t index, int fieldIndex, uint64_t value)
+		{
+			return m_PacketTemplate.setFieldValue(getPacketData(index), fieldIndex, value);
+		}
+
+		/**
+		 * Set an IPv4 address field of a variant, see PacketTemplate#setFieldValue()
+		 * @param[in] index The variant index
+		 * @param[in] fieldIndex The field index
+		 * @param[in] address The new address
+		 * @return False if the field can't be set
+		 */
+		bool setFieldValue(size_t index, int fieldIndex, const IPv4Address& address)
+		{
+			return m_PacketTemplate.setFieldValue(getPacketData(index), fieldIndex, address);
+		}
+
+		/**
+		 * Set an IPv6 address field of a variant, see PacketTemplate#setFieldValue()
+		 * @param[in] index The variant index
+		 * @param[in] fieldIndex The field index
+		 * @param[in] address The new address
+		 * @return False if the field can't be set
+		 */
+		bool setFieldValue(size_t index, int fieldIndex, const IPv6Address& address)
+		{
+			return m_PacketTemplate.setFieldValue(getPacketData(index), fieldIndex, address);
+		}
+
+		/**
+		 * Copy bytes to the start of a field of a variant, see PacketTemplate#setFieldData()
+		 * @param[in] index The variant index
+		 * @param[in] fieldIndex The field index
+		 * @param[in] data The bytes to copy
+		 * @param[in] dataLen The number of bytes
+		 * @return False if the field can't be set
+		 */
+		bool setFieldData(size_t index, int fieldIndex, const uint8_t* data, size_t dataLen)
+		{
+			return m_PacketTemplate.setFieldData(getPacketData(index), fieldIndex, data, dataLen);
+		}
+
+	private:
+		const PacketTemplate& m_PacketTemplate;
+		std::vector<uint8_t> m_Buffer;
+		std::vector<RawPacket> m_RawPackets;
+	};
+
+}  // namespace pcpp
@@ -2,6 +2,7 @@
 
 #include "Packet.h"
 #include "IpAddress.h"
+#include <vector>
 
 /// @file
 
@@ -83,4 +84,117 @@ namespace pcpp
 	 */
 	uint32_t hash2Tuple(Packet* packet);
 
+	/**
+	 * Computes a 64bit hash of a byte buffer. The buffer is read 16 bytes at a time and each pair of 8-byte words is
+	 * folded with a 64x64->128bit multiplication, in the style of wyhash. It's much faster than fnvHash() on long
+	 * buffers and all its 64 bits are usable, for example as the key of large hash tables
+	 * @param[in] buffer The byte buffer, there are no alignment requirements
+	 * @param[in] bufSize The size of the byte buffer
+	 * @param[in] seed A seed, different seeds give independent hash functions
+	 * @return The 64bit hash value
+	 */
+	uint64_t hash64(const uint8_t* buffer, size_t bufSize, uint64_t seed = 0);
+
+	/**
+	 * Computes a 64bit hash of a 5-tuple given as raw header fields
+	 * @param[in] srcIP The source IP address in network byte order, 4 bytes for IPv4 or 16 bytes for IPv6
+	 * @param[in] dstIP The destination IP address, with the same length as srcIP
+	 * @param[in] ipLen The length of the IP addresses: 4 or 16
+	 * @param[in] srcPort The source port in host byte order
+	 * @param[in] dstPort The destination port in host byte order
+	 * @param[in] protocol The IP protocol number
+	 * @param[in] directionUnique If false (the default) the hash is symmetric: both directions of a flow, where the
+	 * source and destination endpoints are swapped, have the same hash value
+	 * @return The 64bit hash value
+	 */
+	uint64_t hash5Tuple64(const uint8_t* srcIP, const uint8_t* dstIP, size_t ipLen, uint16_t srcPort,
+	                      uint16_t dstPort, uint8_t protocol, bool directionUnique = false);
+
+	/**
+	 * A 64bit version of hash5Tuple(). The addresses and ports are read directly from the IPv4 or IPv6 header and the
+	 * TCP or UDP header, without copying them
+	 * @param[in] packet The packet to calculate hash for
+	 * @param[in] directionUnique Make hash value unique for each direction
+	 * @return The hash value calculated for this packet or 0 if the packet doesn't contain 5-tuple
+	 */
+	uint64_t hash5Tuple64(Packet* packet, bool directionUnique = false);
+
+	/**
+	 * A 64bit version of hash2Tuple(). The value is the same in both directions
+	 * @param[in] packet The packet to calculate hash for
+	 * @return The hash value calculated for this packet or 0 if the packet isn't IPv4/6
+	 */
+	uint64_t hash2Tuple64(Packet* packet);
+
+	/**
+	 * @class ToeplitzHash
+	 * The Toeplitz hash that NICs use for Receive Side Scaling (RSS) to choose the RX queue of a packet. With the same
+	 * key it computes the same 32bit value as the NIC, so software can tell which queue (or which core) a flow is
+	 * received on, or spread packets the same way the hardware does. The hash is computed with a table that is built
+	 * from the key in the c'tor, one 32bit lookup per input byte.<BR>
+	 * The input is the one defined for RSS: the source and destination IP addresses followed by the source and
+	 * destination ports, all in network byte order. The default key is the one DpdkDevice configures by default,
+	 * 0x6D5A repeated, which makes the hash symmetric: both directions of a flow are received on the same queue
+	 */
+	class ToeplitzHash
+	{
+	public:
+		/**
+		 * The length of the default key, and of the key of most NICs
+		 */
+		static constexpr size_t DefaultKeyLength = 40;
+
+		/**
+		 * The default key, the same as the default RSS key of DpdkDevice
+		 */
+		static const uint8_t DefaultKey[DefaultKeyLength];
+
+		/**
+		 * A c'tor that builds the lookup table of a key
+		 * @param[in] key The RSS key. If it's nullptr the default key is used
+		 * @param[in] keyLength The length of the key in bytes. Inputs can be up to keyLength - 4 bytes long, a
+		 * 40-byte key is enough for an IPv6 4-tuple (36 bytes). The key length must be at least 5 bytes, otherwise
+		 * an error is printed to log and the default key is used
+		 */
+		explicit ToeplitzHash(const uint8_t* key = nullptr, size_t keyLength = DefaultKeyLength);
+
+		/**
+		 * @return The maximum length in bytes of an input to hash()
+		 */
+		size_t getMaxInputLength() const
+		{
+			return m_MaxInputLength;
+		}
+
+		/**
+		 * Compute the Toeplitz hash of a buffer
+		 * @param[in] buffer The input bytes
+		 * @param[in] bufSize The input length. If it exceeds getMaxInputLength() an error is printed to log and 0
+		 * is returned
+		 * @return The 32bit hash value
+		 */
+		uint32_t hash(const uint8_t* buffer, size_t bufSize) const;
+
+		/**
+		 * Compute the RSS hash of a packet's IP addresses and TCP or UDP ports, the input of the RSS hash types
+		 * NONFRAG_IPV4_TCP, NONFRAG_IPV4_UDP, NONFRAG_IPV6_TCP and NONFRAG_IPV6_UDP. The first IPv4 or IPv6 layer
+		 * of the packet is used
+		 * @param[in] packet The packet to calculate hash for
+		 * @return The hash value, or 0 if the packet isn't a TCP or UDP packet over IPv4/6
+		 */
+		uint32_t hash5Tuple(Packet* packet) const;
+
+		/**
+		 * Compute the RSS hash of a packet's IP addresses, the input of the RSS hash types IPV4 and IPV6
+		 * @param[in] packet The packet to calculate hash for
+		 * @return The hash value, or 0 if the packet isn't IPv4/6
+		 */
+		uint32_t hash2Tuple(Packet* packet) const;
+
+	private:
+		// m_Table[i * 256 + b] is the hash of byte value b at input offset i
+		std::vector<uint32_t> m_Table;
+		size_t m_MaxInputLength;
+	};
+
 }  // namespace pcpp
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @file
+
+/**
+ * \namespace pcpp
+ * \brief The main namespace for the PcapPlusPlus lib
+ */
+namespace pcpp
+{
+	class Layer;
+	class Packet;
+
+	/**
+	 * @class PortDissectorTable
+	 * A table that selects the layer above a transport layer (TCP or UDP) by the transport ports. Each dissector is a
+	 * function that gets the payload and the ports and either creates the next layer or returns nullptr if the
+	 * payload doesn't belong to its protocol. A dissector is registered either on a list of ports, in which case it's
+	 * called only if the source or destination port is one of them, or as a heuristic dissector which is called for
+	 * every port. When several dissectors are candidates they are called by ascending priority until one of them
+	 * returns a layer.<BR>
+	 * The candidates of every port are looked up in a dense port-indexed table, so packets on ports that no dissector
+	 * is registered on don't pay for any port or payload checks. The table is rebuilt whenever a dissector is
+	 * registered, unregistered, enabled or disabled, so these methods should be called before packets are parsed and
+	 * must not be called while other threads parse packets.<BR>
+	 * The tables used by TcpLayer and UdpLayer are returned by TcpLayer#getDissectorTable() and
+	 * UdpLayer#getDissectorTable(). Built-in dissectors are named after their protocol (for example "HTTP" or "DNS")
+	 * and have priorities in steps of 100, so user dissectors can be registered before, between or after them
+	 */
+	class PortDissectorTable
+	{
+	public:
+		/**
+		 * A dissector function
+		 * @param[in] data A pointer to the payload of the transport layer
+		 * @param[in] dataLen The payload length
+		 * @param[in] prevLayer The transport layer
+		 * @param[in] packet The packet the layer belongs to
+		 * @param[in] srcPort The source port
+		 * @param[in] dstPort The destination port
+		 * @return The new layer, or nullptr if the payload doesn't belong to the dissector's protocol
+		 */
+		typedef Layer* (*DissectorFunc)(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet,
+		                                uint16_t srcPort, uint16_t dstPort);
+
+		/** The maximum number of dissectors in a table */
+		static constexpr size_t MaxDissectors = 64;
+
+		/**
+		 * A c'tor that creates an empty table
+		 */
+		PortDissectorTable();
+
+		/**
+		 * Register a dissector that is called for packets whose source or destination port is in a list of ports
+		 * @param[in] name A unique name for the dissector
+		 * @param[in] priority Candidates with a lower priority are called first. Candidates with the same priority
+		 * are called in registration order
+		 * @param[in] dissector The dissector function
+		 * @param[in] ports The ports to register the dissector on
+		 * @return False if the name is already registered, the dissector or port list is empty, or the table is full
+		 */
+		bool registerDissector(const std::string& name, int priority, DissectorFunc dissector,
+		                       const std::vector<uint16_t>& ports);
+
+		/**
+		 * Register a heuristic dissector that is called for packets on all ports
+		 * @param[in] name A unique name for the dissector
+		 * @param[in] priority Candidates with a lower priority are called first. Candidates with the same priority
+		 * are called in registration order
+		 * @param[in] dissector The dissector function
+		 * @return False if the name is already registered, the dissector is nullptr or the table is full
+		 */
+		bool registerHeuristicDissector(const std::string& name, int priority, DissectorFunc dissector);
+
+		/**
+		 * Remove a dissector from the table
+		 * @param[in] name The dissector name
+		 * @return False if there is no dissector with this name
+		 */
+		bool unregisterDissector(const std::string& name);
+
+		/**
+		 * Enable or disable a dissector. A disabled dissector stays registered but is never called, so packets of its
+		 * protocol are parsed by the next candidate or as a PayloadLayer
+		 * @param[in] name The dissector name
+		 * @param[in] enabled Whether to enable or disable the dissector
+		 * @return False if there is no dissector with this name
+		 */
+		bool setDissectorEnabled(const std::string& name, bool enabled);
+
+		/**
+		 * @param[in] name The dissector name
+		 * @return True if a dissector with this name is registered and enabled
+		 */
+		bool isDissectorEnabled(const std::string& name) const;
+
+		/**
+		 * @param[in] name The dissector name
+		 * @return True if a dissector with this name is registered
+		 */
+		bool isDissectorRegistered(const std::string& name) const;
+
+		/**
+		 * @return The names of all registered dissectors, in the order they are called
+		 */
+		std::vector<std::string> getDissectorNames() const;
+
+		/**
+		 * @param[in] port A port number
+		 * @return The number of enabled dissectors that are called for this port, including heuristic dissectors
+		 */
+		size_t getDissectorCount(uint16_t port) const;
+
+		/**
+		 * A helper for registering dissectors on the ports recognized by an existing port check function, such as
+		 * HttpMessage#isHttpPort()
+		 * @param[in] isPort A function that checks whether a port belongs to a protocol
+		 * @return All ports for which the function returns true, in ascending order
+		 */
+		static std::vector<uint16_t> getMatchingPorts(bool (*isPort)(uint16_t port));
+
+		/**
+		 * Call the candidate dissectors for a pair of ports by priority until one of them creates a layer
+		 * @param[in] data A pointer to the payload of the transport layer
+		 * @param[in] dataLen The payload length
+		 * @param[in] prevLayer The transport layer
+		 * @param[in] packet The packet the layer belongs to
+		 * @param[in] srcPort The source port
+		 * @param[in] dstPort The destination port
+		 * @return The layer created by the first dissector that accepted the payload, or nullptr if none did
+		 */
+		Layer* dissect(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t srcPort,
+		               uint16_t dstPort) const;
+
+	private:
+		struct DissectorEntry
+		{
+			std::string name;
+			int priority;
+			DissectorFunc dissector;
+			std::vector<uint16_t> ports;
+			bool isHeuristic;
+			bool isEnabled;
+		};
+
+		// sorted by priority, the index of a dissector is its bit in the candidate masks
+		std::vector<DissectorEntry> m_Dissectors;
+		// the index of each port's candidate mask in m_CandidateMasks. Index 0 is the empty mask
+		std::vector<uint16_t> m_PortToMaskIndex;
+		std::vector<uint64_t> m_CandidateMasks;
+		uint64_t m_HeuristicMask;
+
+		bool addDissector(DissectorEntry&& entry);
+		std::vector<DissectorEntry>::iterator findDissector(const std::string& name);
+		std::vector<DissectorEntry>::const_iterator findDissector(const std::string& name) const;
+		void rebuild();
+	};
+
+}  // namespace pcpp
@@ -271,6 +271,9 @@ namespace pcpp
 		uint8_t* m_RawData;
 		int m_RawDataLen;
 		int m_FrameLength;
+		// the bytes of the buffer before and after the data that can be used without moving the data
+		size_t m_Headroom;
+		size_t m_Tailroom;
 		timespec m_TimeStamp;
 		bool m_DeleteRawDataAtDestructor;
 		bool m_RawPacketSet;
@@ -396,6 +399,36 @@ namespace pcpp
 		bool initWithRawData(const uint8_t* pRawData, int rawDataLen, timespec timestamp,
 		                     LinkLayerType layerType = LINKTYPE_ETHERNET);
 
+		/**
+		 * Set a raw data that was allocated with new[] and take its ownership: unlike setRawData() the data is freed
+		 * when it's replaced, when clear() is called or when this instance is destroyed, regardless of
+		 * deleteRawDataAtDestructor. The old data is freed first if this instance owned it
+		 * @param[in] pRawData A pointer to the new raw data, allocated with new[]
+		 * @param[in] rawDataLen The new raw data length in bytes
+		 * @param[in] timestamp The timestamp packet was received by the NIC (in usec precision)
+		 * @param[in] layerType The link layer type for this raw data
+		 * @param[in] frameLength The packet length if it's different from the captured length, or -1 if both lengths
+		 * are equal
+		 * @return True if raw data was set successfully, false otherwise
+		 */
+		virtual bool setOwnedRawData(uint8_t* pRawData, int rawDataLen, timeval timestamp,
+		                             LinkLayerType layerType = LINKTYPE_ETHERNET, int frameLength = -1);
+
+		/**
+		 * Set a raw data that was allocated with new[] and take its ownership: unlike setRawData() the data is freed
+		 * when it's replaced, when clear() is called or when this instance is destroyed, regardless of
+		 * deleteRawDataAtDestructor. The old data is freed first if this instance owned it
+		 * @param[in] pRawData A pointer to the new raw data, allocated with new[]
+		 * @param[in] rawDataLen The new raw data length in bytes
+		 * @param[in] timestamp The timestamp packet was received by the NIC (in nsec precision)
+		 * @param[in] layerType The link layer type for this raw data
+		 * @param[in] frameLength The packet length if it's different from the captured length, or -1 if both lengths
+		 * are equal
+		 * @return True if raw data was set successfully, false otherwise
+		 */
+		virtual bool setOwnedRawData(uint8_t* pRawData, int rawDataLen, timespec timestamp,
+		                             LinkLayerType layerType = LINKTYPE_ETHERNET, int frameLength = -1);
+
 		/**
 		 * Get raw data pointer
 		 * @return A read-only pointer to the raw data
@@ -472,10 +505,18 @@ namespace pcpp
 			return m_RawPacketSet;
 		}
 
+		/**
+		 * @return True if the raw data buffer is freed by this instance, or false if it belongs to the user, meaning
+		 * deleteRawDataAtDestructor was set to 'false' and the buffer wasn't reallocated since
+		 */
+		bool isRawDataOwned() const
+		{
+			return m_DeleteRawDataAtDestructor;
+		}
+
 		/**
 		 * Clears all members of this instance, meaning setting raw data to nullptr, raw data length to 0, etc.
-		 * Currently raw data is always freed, even if deleteRawDataAtDestructor was set to 'false'
-		 * @todo deleteRawDataAtDestructor was set to 'true', don't free the raw data
+		 * The raw data is freed only if deleteRawDataAtDestructor was set to 'true'
 		 * @todo set timestamp to a default value as well
 		 */
 		virtual void clear();
@@ -510,12 +551,61 @@ namespace pcpp
 		 */
 		virtual bool removeData(int atIndex, size_t numOfBytesToRemove);
 
+		/**
+		 * @return The number of bytes before the data that belong to the buffer, so data can be prepended to them with
+		 * prependData() without moving the current data. It's 0 unless the buffer was allocated with reserveRoom() or
+		 * data was removed with removeDataFromStart()
+		 */
+		virtual size_t getHeadroom() const
+		{
+			return m_Headroom;
+		}
+
+		/**
+		 * @return The number of bytes after the data that are known to belong to the buffer, so data can be appended or
+		 * inserted without reallocating the buffer. It's 0 when the data was set by the user with setRawData(), since
+		 * the size of a user buffer isn't known
+		 */
+		virtual size_t getTailroom() const
+		{
+			return m_Tailroom;
+		}
+
+		/**
+		 * Add data in front of the current data using the headroom. Unlike insertData() at index 0 the current data
+		 * isn't moved, so the cost depends only on the length of the prepended data
+		 * @param[in] dataToPrepend A pointer to the data to prepend. If it's nullptr the bytes are only added and left
+		 * with their current value
+		 * @param[in] dataToPrependLen Length in bytes of dataToPrepend
+		 * @return True if the data was prepended, or false if the headroom is too small
+		 */
+		virtual bool prependData(const uint8_t* dataToPrepend, size_t dataToPrependLen);
+
+		/**
+		 * Remove bytes from the start of the current data. Unlike removeData() at index 0 the remaining data isn't
+		 * moved, the removed bytes become headroom
+		 * @param[in] numOfBytesToRemove Number of bytes to remove
+		 * @return True if the bytes were removed, or false if there is less data than numOfBytesToRemove
+		 */
+		virtual bool removeDataFromStart(size_t numOfBytesToRemove);
+
+		/**
+		 * Make sure the buffer has at least a certain headroom and tailroom. If it doesn't, a new buffer is allocated
+		 * with the larger of the current and requested headroom and tailroom, the data is copied to it and the old
+		 * buffer is freed if deleteRawDataAtDestructor was set to 'true'. The new buffer is always freed by this
+		 * instance
+		 * @param[in] headroom The required headroom in bytes
+		 * @param[in] tailroom The required tailroom in bytes
+		 * @return True if the buffer has the required headroom and tailroom, false otherwise
+		 */
+		virtual bool reserveRoom(size_t headroom, size_t tailroom);
+
 		/**
 		 * Re-allocate raw packet buffer meaning add size to it without losing the current packet data. This method
 		 * allocates the required buffer size as instructed by the use and then copies the raw data from the current
 		 * allocated buffer to the new one. This method can become useful if the user wants to insert or append data to
 		 * the raw data, and the previous allocated buffer is too small, so the user wants to allocate a larger buffer
-		 * and get RawPacket instance to point to it
+		 * and get RawPacket instance to point to it. The headroom is kept in the new buffer
 		 * @param[in] newBufferLength The new buffer length as required by the user. The method is responsible to
 		 * allocate the memory
 		 * @return True if data was reallocated successfully, false otherwise
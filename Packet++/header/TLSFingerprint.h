@@ -0,0 +1,253 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "TcpReassembly.h"
+
+/// @file
+
+/**
+ * \namespace pcpp
+ * \brief The main namespace for the PcapPlusPlus lib
+ */
+namespace pcpp
+{
+	/**
+	 * @struct TLSClientHelloFingerprint
+	 * The JA3 and JA4 fingerprints of a TLS ClientHello message, computed by TLSFingerprintScanner into fixed-size
+	 * buffers. The JA3 string has the same format as SSLClientHelloMessage::ClientHelloTLSFingerprint::toString()
+	 */
+	struct TLSClientHelloFingerprint
+	{
+		/** The maximum length of the JA3 string stored in this struct */
+		static constexpr size_t MaxJa3Length = 1023;
+		/** The maximum number of cipher suites, extensions or signature algorithms JA4 is computed from */
+		static constexpr size_t MaxJa4ListSize = 512;
+
+		/** The TLS version in the ClientHello message */
+		uint16_t tlsVersion;
+		/**
+		 * The JA3 string, null-terminated, for example:
+		 * <b>771,4866-4867-4865-255,0-11-10-35-22-23-13-43-45-51,29-23-30-25-24,0-1-2</b>
+		 */
+		char ja3[MaxJa3Length + 1];
+		/** The length of the JA3 string */
+		size_t ja3Length;
+		/** True if the JA3 string was longer than MaxJa3Length and was truncated. ja3Hash covers the full string */
+		bool isJa3Truncated;
+		/** The MD5 hash of the JA3 string as a null-terminated lowercase hex string */
+		char ja3Hash[33];
+		/** The JA4 fingerprint, null-terminated, for example: <b>t13d1516h2_8daaf6152771_e5627efa2ab1</b> */
+		char ja4[37];
+		/** True if a list had more than MaxJa4ListSize entries, in which case JA4 is computed from the first ones */
+		bool isJa4Truncated;
+	};
+
+	/**
+	 * @struct TLSServerHelloFingerprint
+	 * The JA3S fingerprint of a TLS ServerHello message, computed by TLSFingerprintScanner into fixed-size buffers. The
+	 * JA3S string has the same format as SSLServerHelloMessage::ServerHelloTLSFingerprint::toString()
+	 */
+	struct TLSServerHelloFingerprint
+	{
+		/** The maximum length of the JA3S string stored in this struct */
+		static constexpr size_t MaxJa3sLength = 511;
+
+		/** The TLS version in the ServerHello message, or in its "supported versions" extension if it has one */
+		uint16_t tlsVersion;
+		/** The JA3S string, null-terminated, for example: <b>771,49195,65281-16-11</b> */
+		char ja3s[MaxJa3sLength + 1];
+		/** The length of the JA3S string */
+		size_t ja3sLength;
+		/** True if the JA3S string was longer than MaxJa3sLength and was truncated. ja3sHash covers the full string */
+		bool isJa3sTruncated;
+		/** The MD5 hash of the JA3S string as a null-terminated lowercase hex string */
+		char ja3sHash[33];
+	};
+
+	/**
+	 * @class TLSFingerprintScanner
+	 * Computes JA3, JA3S and JA4 fingerprints directly from raw TLS data, without parsing a Packet, without creating
+	 * SSLHandshakeMessage objects and without heap allocations. GREASE values are ignored in the JA3 cipher suites,
+	 * extensions and supported groups, like SSLClientHelloMessage#generateTLSFingerprint() does, and in all JA4 lists.
+	 * JA4 is computed with "t" (TLS over TCP) as its protocol
+	 */
+	class TLSFingerprintScanner
+	{
+	public:
+		/**
+		 * @enum ScanResult
+		 * The result of scanning data for a hello message
+		 */
+		enum class ScanResult
+		{
+			/** The fingerprint was computed */
+			Success,
+			/** The data is the beginning of a hello message that continues beyond the data */
+			NeedMoreData,
+			/** The data doesn't start with a hello message of the requested type */
+			NotHello,
+			/** The data starts with a hello message but its fields are malformed */
+			Malformed
+		};
+
+		/**
+		 * Compute the fingerprints of a ClientHello message
+		 * @param[in] data A handshake message, starting at its 4-byte handshake header
+		 * @param[in] dataLen The data length
+		 * @param[out] result The fingerprints, valid only if ScanResult::Success is returned
+		 * @return The scan result
+		 */
+		static ScanResult scanClientHelloMessage(const uint8_t* data, size_t dataLen,
+		                                         TLSClientHelloFingerprint& result);
+
+		/**
+		 * Compute the fingerprint of a ServerHello message
+		 * @param[in] data A handshake message, starting at its 4-byte handshake header
+		 * @param[in] dataLen The data length
+		 * @param[out] result The fingerprint, valid only if ScanResult::Success is returned
+		 * @return The scan result
+		 */
+		static ScanResult scanServerHelloMessage(const uint8_t* data, size_t dataLen,
+		                                         TLSServerHelloFingerprint& result);
+
+		/**
+		 * Compute the fingerprints of a ClientHello message in a TLS record, for example a TCP payload. This is the
+		 * per-packet fast path: a message that spans more than one record or packet isn't handled and
+		 * ScanResult::NeedMoreData is returned. Use TLSFingerprintReassembly for such messages
+		 * @param[in] data The data, starting at a TLS record header
+		 * @param[in] dataLen The data length
+		 * @param[out] result The fingerprints, valid only if ScanResult::Success is returned
+		 * @return The scan result
+		 */
+		static ScanResult scanClientHello(const uint8_t* data, size_t dataLen, TLSClientHelloFingerprint& result);
+
+		/**
+		 * Compute the fingerprint of a ServerHello message in a TLS record, for example a TCP payload. A message that
+		 * spans more than one record or packet isn't handled and ScanResult::NeedMoreData is returned
+		 * @param[in] data The data, starting at a TLS record header
+		 * @param[in] dataLen The data length
+		 * @param[out] result The fingerprint, valid only if ScanResult::Success is returned
+		 * @return The scan result
+		 */
+		static ScanResult scanServerHello(const uint8_t* data, size_t dataLen, TLSServerHelloFingerprint& result);
+	};
+
+	/**
+	 * @class TLSFingerprintReassembly
+	 * Computes the fingerprints of the hello messages of TLS connections reassembled by TcpReassembly, including hello
+	 * messages that are split across TCP segments or TLS records. Set onTcpMessageReady() and onTcpConnectionEnd() as
+	 * the TcpReassembly callbacks with a pointer to this object as the cookie, or call processTcpData() from your own
+	 * callbacks. A hello message contained in one segment is scanned in place; only hello messages that span segments
+	 * or records are copied. Each side of a connection is scanned until its first handshake message, after which its
+	 * data is ignored
+	 */
+	class TLSFingerprintReassembly
+	{
+	public:
+		/**
+		 * @typedef OnClientHelloFingerprint
+		 * A callback that is called when the fingerprints of a ClientHello message are computed
+		 * @param[in] side The side of the connection that sent the message
+		 * @param[in] fingerprint The fingerprints
+		 * @param[in] connData The connection data
+		 * @param[in] userCookie The user cookie given in the c'tor
+		 */
+		typedef void (*OnClientHelloFingerprint)(int8_t side, const TLSClientHelloFingerprint& fingerprint,
+		                                         const ConnectionData& connData, void* userCookie);
+
+		/**
+		 * @typedef OnServerHelloFingerprint
+		 * A callback that is called when the fingerprint of a ServerHello message is computed
+		 * @param[in] side The side of the connection that sent the message
+		 * @param[in] fingerprint The fingerprint
+		 * @param[in] connData The connection data
+		 * @param[in] userCookie The user cookie given in the c'tor
+		 */
+		typedef void (*OnServerHelloFingerprint)(int8_t side, const TLSServerHelloFingerprint& fingerprint,
+		                                         const ConnectionData& connData, void* userCookie);
+
+		/**
+		 * A c'tor for this class
+		 * @param[in] onClientHello The callback for ClientHello fingerprints, may be nullptr
+		 * @param[in] onServerHello The callback for ServerHello fingerprints, may be nullptr
+		 * @param[in] userCookie A pointer passed to the callbacks
+		 * @param[in] maxHelloSize The maximum size of a hello message that is buffered. Larger messages are ignored.
+		 * The default is 65536
+		 */
+		TLSFingerprintReassembly(OnClientHelloFingerprint onClientHello, OnServerHelloFingerprint onServerHello,
+		                         void* userCookie = nullptr, size_t maxHelloSize = 65536);
+
+		TLSFingerprintReassembly(const TLSFingerprintReassembly&) = delete;
+		TLSFingerprintReassembly& operator=(const TLSFingerprintReassembly&) = delete;
+
+		/**
+		 * Process reassembled TCP data of one side of a connection
+		 * @param[in] side The side of the connection
+		 * @param[in] tcpData The data
+		 */
+		void processTcpData(int8_t side, const TcpStreamData& tcpData);
+
+		/**
+		 * Release the state of a connection
+		 * @param[in] connData The connection data
+		 */
+		void closeConnection(const ConnectionData& connData);
+
+		/**
+		 * A TcpReassembly message ready callback that passes the data to processTcpData()
+		 * @param[in] side The side of the connection
+		 * @param[in] tcpData The data
+		 * @param[in] userCookie A pointer to a TLSFingerprintReassembly object
+		 */
+		static void onTcpMessageReady(int8_t side, const TcpStreamData& tcpData, void* userCookie);
+
+		/**
+		 * A TcpReassembly connection end callback that calls closeConnection()
+		 * @param[in] connData The connection data
+		 * @param[in] reason The reason the connection ended
+		 * @param[in] userCookie A pointer to a TLSFingerprintReassembly object
+		 */
+		static void onTcpConnectionEnd(const ConnectionData& connData, TcpReassembly::ConnectionEndReason reason,
+		                               void* userCookie);
+
+		/**
+		 * @return The number of connections currently tracked
+		 */
+		size_t getNumOfConnections() const
+		{
+			return m_Connections.size();
+		}
+
+	private:
+		struct SideState
+		{
+			bool isDone;
+			uint8_t recordHeaderLength;
+			uint8_t recordHeader[5];
+			size_t recordRemaining;
+			std::vector<uint8_t> message;
+
+			SideState() : isDone(false), recordHeaderLength(0), recordHeader(), recordRemaining(0)
+			{}
+		};
+
+		struct ConnectionState
+		{
+			SideState sides[2];
+		};
+
+		OnClientHelloFingerprint m_OnClientHello;
+		OnServerHelloFingerprint m_OnServerHello;
+		void* m_UserCookie;
+		size_t m_MaxHelloSize;
+		std::unordered_map<uint32_t, ConnectionState> m_Connections;
+
+		void processRecordData(SideState& sideState, int8_t side, const uint8_t* data, size_t dataLen,
+		                       const ConnectionData& connData);
+		void scanMessage(int8_t side, const uint8_t* data, size_t dataLen, const ConnectionData& connData);
+		void finishSide(SideState& sideState);
+	};
+
+}  // namespace pcpp
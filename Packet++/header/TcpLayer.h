@@ -2,6 +2,7 @@
 
 #include "DeprecationUtils.h"
 #include "Layer.h"
+#include "PortDissectorTable.h"
 #include "TLVData.h"
 #include <string.h>
 
@@ -641,11 +642,19 @@ namespace pcpp
 		 */
 		static inline bool isDataValid(const uint8_t* data, size_t dataLen);
 
+		/**
+		 * @return The table of dissectors that selects the layer above TCP layers by their ports. Dissectors
+		 * registered in this table or enabled or disabled in it apply to all TCP layers parsed afterwards
+		 */
+		static PortDissectorTable& getDissectorTable();
+
 		// implement abstract methods
 
 		/**
-		 * Currently identifies the following next layers: HttpRequestLayer, HttpResponseLayer. Otherwise sets
-		 * PayloadLayer
+		 * Selects the next layer with the dissectors in getDissectorTable(). Currently identifies the following next
+		 * layers: HttpRequestLayer, HttpResponseLayer, SSLLayer, SipRequestLayer, SipResponseLayer, BgpLayer,
+		 * SSHLayer, DnsOverTcpLayer, TelnetLayer, FtpRequestLayer, FtpResponseLayer, FtpDataLayer, SomeIpLayer,
+		 * TpktLayer, SmtpRequestLayer, SmtpResponseLayer, LdapLayer, GtpV2Layer. Otherwise sets PayloadLayer
 		 */
 		void parseNextLayer() override;
 
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <map>
+#include <vector>
 #include "Layer.h"
 
 /// @file
@@ -281,7 +281,24 @@ namespace pcpp
 		HeaderField* m_FieldList;
 		HeaderField* m_LastField;
 		int m_FieldsOffset;
-		std::multimap<std::string, HeaderField*> m_FieldNameToFieldMap;
+
+		/**
+		 * An entry of the field name index. Well-known field names (Host, Content-Length, Via, Call-ID, etc.) are
+		 * resolved to a non-zero ID by a perfect hash, other names are matched by hash and then by a case insensitive
+		 * comparison
+		 */
+		struct FieldIndexEntry
+		{
+			HeaderField* field;
+			uint32_t nameHash;
+			uint16_t knownNameId;
+		};
+
+		// all fields in the order they were parsed or added
+		std::vector<FieldIndexEntry> m_FieldIndex;
+
+		FieldIndexEntry makeFieldIndexEntry(HeaderField* field) const;
+		void unindexField(HeaderField* field);
 	};
 
 }  // namespace pcpp
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Packet.h"
+#include <cstdint>
+#include <vector>
+
+/// @file
+
+/**
+ * \namespace pcpp
+ * \brief The main namespace for the PcapPlusPlus lib
+ */
+namespace pcpp
+{
+	/**
+	 * The tunnels that TunnelEncapsulator and decapsulateTunnel() support
+	 */
+	enum class TunnelType
+	{
+		/** VXLAN over UDP, the inner packet is an Ethernet frame */
+		VXLAN,
+		/** GRE version 0, the inner packet is an Ethernet frame (transparent Ethernet bridging) or an IP packet */
+		GRE,
+		/** GTP-U (GTPv1 G-PDU messages over UDP port 2152), the inner packet is an IP packet */
+		GTPv1U,
+		/** IPv4 or IPv6 over IPv4 or IPv6 (IP protocol 4 or 41) */
+		IPinIP
+	};
+
+	/**
+	 * @class TunnelEncapsulator
+	 * Pushes the outer headers of a tunnel in front of Ethernet packets, in place on their RawPacket and without
+	 * parsing them. The outer headers are built once as a Packet with the regular layers, for example EthLayer,
+	 * IPv4Layer, UdpLayer and VxlanLayer, and every encapsulated packet gets a copy of them with its length fields and
+	 * checksums updated: the IPv4 total length and header checksum, the IPv6 payload length, the UDP length and the
+	 * GTP-U message length. The UDP checksum is 0 over IPv4 and computed over IPv6, where it's mandatory.<BR>
+	 * The headers are written to the headroom of the raw packet (see RawPacket#getHeadroom()), so packets allocated
+	 * with enough headroom (for example Packet created with a headroom or DPDK mbufs) are encapsulated without moving
+	 * their data. Other raw packets are reallocated once with the required headroom.<BR>
+	 * VXLAN and GRE with transparent Ethernet bridging carry the whole Ethernet frame. GTP-U, IP-in-IP and GRE with
+	 * another protocol carry the IP packet of the frame, so its Ethernet header and VLAN tags are removed
+	 */
+	class TunnelEncapsulator
+	{
+	public:
+		/**
+		 * A c'tor that takes the outer headers from a packet. Packet#computeCalculateFields() is called on the packet
+		 * first, then its bytes are copied, so the packet can be reused or destroyed afterwards
+		 * @param[in] outerHeaders A packet that contains only the outer headers: an Ethernet layer, optional VLAN
+		 * layers, an IPv4 or IPv6 layer and the tunnel layers. For VXLAN and GTP-U a UdpLayer followed by a VxlanLayer
+		 * or a GtpV1Layer of a G-PDU message. For GRE a GREv0Layer without checksum, sequence number and routing,
+		 * whose protocol is PCPP_ETHERTYPE_ETHBRIDGE to carry Ethernet frames. For IP-in-IP nothing after the IP
+		 * layer. If the packet doesn't match any of these an error is printed to log and isValid() returns false
+		 */
+		explicit TunnelEncapsulator(Packet& outerHeaders);
+
+		/**
+		 * @return True if the outer headers passed to the c'tor are a supported tunnel
+		 */
+		bool isValid() const
+		{
+			return m_Valid;
+		}
+
+		/**
+		 * @return The tunnel type of the outer headers
+		 */
+		TunnelType getTunnelType() const
+		{
+			return m_TunnelType;
+		}
+
+		/**
+		 * @return The length of the outer headers in bytes
+		 */
+		size_t getHeaderLen() const
+		{
+			return m_Header.size();
+		}
+
+		/**
+		 * Encapsulate a packet
+		 * @param[in,out] rawPacket An Ethernet packet. For tunnels that carry IP packets the frame must contain an IPv4
+		 * or IPv6 packet
+		 * @return True if the packet was encapsulated, or false if the encapsulator isn't valid, the packet isn't
+		 * an Ethernet packet of the right kind or its headroom can't be allocated. In these cases an error is printed
+		 * to log and the packet isn't changed
+		 */
+		bool encapsulate(RawPacket& rawPacket) const;
+
+		/**
+		 * Encapsulate a batch of packets, see encapsulate(RawPacket&)
+		 * @param[in,out] rawPackets An array of packets
+		 * @param[in] count The number of packets in the array
+		 * @return The number of packets that were encapsulated
+		 */
+		size_t encapsulate(RawPacket* rawPackets, size_t count) const;
+
+		/**
+		 * Encapsulate a batch of packets, see encapsulate(RawPacket&)
+		 * @param[in,out] rawPackets An array of pointers to packets
+		 * @param[in] count The number of packets in the array
+		 * @return The number of packets that were encapsulated
+		 */
+		size_t encapsulate(RawPacket** rawPackets, size_t count) const;
+
+	private:
+		std::vector<uint8_t> m_Header;
+		TunnelType m_TunnelType;
+		bool m_Valid;
+		bool m_InnerEthernet;
+		bool m_IsIPv4;
+		size_t m_IPOffset;
+		// 0 if the tunnel has no UDP header
+		size_t m_UdpOffset;
+		// the offset of the VXLAN, GRE or GTP header
+		size_t m_TunnelOffset;
+	};
+
+	/**
+	 * Strip the outer headers of a tunneled Ethernet packet in place, without parsing the inner packet and without
+	 * moving it: the outer headers become headroom of the raw packet (see RawPacket#removeDataFromStart()). VXLAN
+	 * and GRE packets with transparent Ethernet bridging become the inner Ethernet frame. Packets that carry an IP
+	 * packet (GTP-U, IP-in-IP and other GRE packets) keep their outer Ethernet header and VLAN tags in front of the
+	 * inner IP packet, with the EtherType of the inner packet.<BR>
+	 * The outer IPv4 or IPv6 header may follow VLAN tags. IPv6 extension headers, fragmented outer IPv4 packets and GRE
+	 * routing aren't supported. The outer checksums aren't verified
+	 * @param[in,out] rawPacket An Ethernet packet
+	 * @param[out] tunnelType If not nullptr, set to the type of the stripped tunnel
+	 * @return True if the packet was a supported tunnel and was decapsulated, false otherwise. The packet isn't changed
+	 * if false is returned
+	 */
+	bool decapsulateTunnel(RawPacket& rawPacket, TunnelType* tunnelType = nullptr);
+
+	/**
+	 * Decapsulate a batch of packets, see decapsulateTunnel(RawPacket&, TunnelType*)
+	 * @param[in,out] rawPackets An array of packets
+	 * @param[in] count The number of packets in the array
+	 * @return The number of packets that were decapsulated
+	 */
+	size_t decapsulateTunnel(RawPacket* rawPackets, size_t count);
+
+	/**
+	 * Decapsulate a batch of packets, see decapsulateTunnel(RawPacket&, TunnelType*)
+	 * @param[in,out] rawPackets An array of pointers to packets
+	 * @param[in] count The number of packets in the array
+	 * @return The number of packets that were decapsulated
+	 */
+	size_t decapsulateTunnel(RawPacket** rawPackets, size_t count);
+
+}  // namespace pcpp
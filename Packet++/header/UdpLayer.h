@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Layer.h"
+#include "PortDissectorTable.h"
 
 /// @file
 
@@ -82,11 +83,18 @@ namespace pcpp
 		 */
 		uint16_t calculateChecksum(bool writeResultToPacket);
 
+		/**
+		 * @return The table of dissectors that selects the layer above UDP layers by their ports. Dissectors
+		 * registered in this table or enabled or disabled in it apply to all UDP layers parsed afterwards
+		 */
+		static PortDissectorTable& getDissectorTable();
+
 		// implement abstract methods
 
 		/**
-		 * Currently identifies the following next layers: DnsLayer, DhcpLayer, VxlanLayer, SipRequestLayer,
-		 * SipResponseLayer, RadiusLayer. Otherwise sets PayloadLayer
+		 * Selects the next layer with the dissectors in getDissectorTable(). Currently identifies the following next
+		 * layers: DhcpLayer, VxlanLayer, DnsLayer, SipRequestLayer, SipResponseLayer, RadiusLayer, GtpV1Layer,
+		 * GtpV2Layer, DhcpV6Layer, NtpLayer, SomeIpLayer, WakeOnLanLayer, WireGuardLayer. Otherwise sets PayloadLayer
 		 */
 		void parseNextLayer() override;
 
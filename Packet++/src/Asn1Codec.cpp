@@ -772,4 +772,444 @@ namespace pcpp
 		m_ValueLength = 0;
 		m_TotalLength = 2;
 	}
+
+	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	// Asn1Element, Asn1Reader and Asn1Writer
+	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+	constexpr size_t Asn1Reader::MaxDepth;
+	constexpr size_t Asn1Writer::MaxDepth;
+
+	bool Asn1Element::getIntegerValue(uint32_t& result) const
+	{
+		if (isConstructed || valueLength < 1 || valueLength > sizeof(uint32_t))
+		{
+			return false;
+		}
+
+		result = 0;
+		for (size_t i = 0; i < valueLength; i++)
+		{
+			result = (result << 8) | value[i];
+		}
+
+		return true;
+	}
+
+	bool Asn1Element::getBooleanValue(bool& result) const
+	{
+		if (isConstructed || valueLength != 1)
+		{
+			return false;
+		}
+
+		result = value[0] != 0;
+		return true;
+	}
+
+	bool Asn1Element::getSubElement(size_t index, Asn1Element& result) const
+	{
+		if (!isConstructed)
+		{
+			return false;
+		}
+
+		Asn1Reader reader(value, valueLength);
+		for (size_t curIndex = 0; reader.next() == Asn1Reader::Event::Element; curIndex++)
+		{
+			if (curIndex == index)
+			{
+				result = reader.getElement();
+				return true;
+			}
+
+			reader.skip();
+		}
+
+		return false;
+	}
+
+	Asn1Reader::Asn1Reader(const uint8_t* data, size_t dataLen)
+	    : m_Data(data), m_DataLen(data == nullptr ? 0 : dataLen), m_Offset(0), m_Depth(0), m_EndOffsets(),
+	      m_Element(), m_CanSkip(false), m_HasError(false)
+	{}
+
+	Asn1Reader::Event Asn1Reader::fail()
+	{
+		m_HasError = true;
+		m_CanSkip = false;
+		return Event::Error;
+	}
+
+	Asn1Reader::Event Asn1Reader::next()
+	{
+		if (m_HasError)
+		{
+			return Event::Error;
+		}
+
+		m_CanSkip = false;
+
+		if (m_Depth > 0 && m_Offset == m_EndOffsets[m_Depth - 1])
+		{
+			m_Depth--;
+			return Event::EndOfConstructed;
+		}
+
+		size_t endOffset = m_Depth > 0 ? m_EndOffsets[m_Depth - 1] : m_DataLen;
+		if (m_Offset == endOffset)
+		{
+			return Event::EndOfData;
+		}
+
+		Asn1Element element;
+		if (!readElement(m_Data + m_Offset, endOffset - m_Offset, element))
+		{
+			return fail();
+		}
+
+		element.depth = m_Depth;
+		element.offset = m_Offset;
+
+		if (element.isConstructed)
+		{
+			if (m_Depth == MaxDepth)
+			{
+				return fail();
+			}
+
+			m_EndOffsets[m_Depth++] = m_Offset + element.getTotalLength();
+			m_Offset += element.headerLength;
+		}
+		else
+		{
+			m_Offset += element.getTotalLength();
+		}
+
+		m_Element = element;
+		m_CanSkip = true;
+		return Event::Element;
+	}
+
+	bool Asn1Reader::skip()
+	{
+		if (!m_CanSkip)
+		{
+			return false;
+		}
+
+		if (m_Element.isConstructed)
+		{
+			m_Depth--;
+			m_Offset = m_EndOffsets[m_Depth];
+		}
+
+		m_CanSkip = false;
+		return true;
+	}
+
+	bool Asn1Reader::readElement(const uint8_t* data, size_t dataLen, Asn1Element& result)
+	{
+		if (data == nullptr || dataLen < 2)
+		{
+			return false;
+		}
+
+		switch (data[0] & 0xc0)
+		{
+		case 0xc0:
+			result.tagClass = Asn1TagClass::Private;
+			break;
+		case 0x80:
+			result.tagClass = Asn1TagClass::ContextSpecific;
+			break;
+		case 0x40:
+			result.tagClass = Asn1TagClass::Application;
+			break;
+		default:
+			result.tagClass = Asn1TagClass::Universal;
+			break;
+		}
+
+		result.isConstructed = (data[0] & 0x20) != 0;
+
+		size_t offset = 1;
+		uint32_t tagType = data[0] & 0x1f;
+		if (tagType == 0x1f)
+		{
+			// high tag numbers are encoded in base 128, the last byte has its 8th bit cleared
+			tagType = 0;
+			uint8_t byte;
+			do
+			{
+				if (offset >= dataLen)
+				{
+					return false;
+				}
+
+				byte = data[offset++];
+				tagType = (tagType << 7) | (byte & 0x7f);
+				if (tagType > std::numeric_limits<uint8_t>::max())
+				{
+					return false;
+				}
+			} while ((byte & 0x80) != 0);
+		}
+
+		result.tagType = static_cast<uint8_t>(tagType);
+
+		if (offset >= dataLen)
+		{
+			return false;
+		}
+
+		size_t valueLength = data[offset++];
+		if ((valueLength & 0x80) != 0)
+		{
+			// 0x80 is the indefinite length form, which isn't supported, and 0xff is reserved
+			size_t lengthBytes = valueLength & 0x7f;
+			if (lengthBytes == 0 || lengthBytes == 0x7f || lengthBytes > dataLen - offset)
+			{
+				return false;
+			}
+
+			valueLength = 0;
+			for (size_t i = 0; i < lengthBytes; i++)
+			{
+				if ((valueLength >> (std::numeric_limits<size_t>::digits - 8)) != 0)
+				{
+					return false;
+				}
+
+				valueLength = (valueLength << 8) | data[offset++];
+			}
+		}
+
+		if (valueLength > dataLen - offset)
+		{
+			return false;
+		}
+
+		result.depth = 0;
+		result.offset = 0;
+		result.headerLength = offset;
+		result.value = data + offset;
+		result.valueLength = valueLength;
+		return true;
+	}
+
+	constexpr size_t Asn1Writer::ReservedLengthFieldSize;
+
+	Asn1Writer::Asn1Writer(size_t initialCapacity)
+	    : m_Depth(0), m_LengthOffsets(), m_GapBytesAtBegin(), m_GapBytes(0)
+	{
+		m_Buffer.reserve(initialCapacity);
+	}
+
+	void Asn1Writer::writeTag(Asn1TagClass tagClass, bool isConstructed, uint8_t tagType)
+	{
+		uint8_t tagByte;
+		switch (tagClass)
+		{
+		case Asn1TagClass::Private:
+			tagByte = 0xc0;
+			break;
+		case Asn1TagClass::ContextSpecific:
+			tagByte = 0x80;
+			break;
+		case Asn1TagClass::Application:
+			tagByte = 0x40;
+			break;
+		default:
+			tagByte = 0;
+			break;
+		}
+
+		if (isConstructed)
+		{
+			tagByte |= 0x20;
+		}
+
+		if (tagType < 0x1f)
+		{
+			m_Buffer.push_back(tagByte | tagType);
+			return;
+		}
+
+		m_Buffer.push_back(tagByte | 0x1f);
+		if (tagType > 0x7f)
+		{
+			m_Buffer.push_back(0x80 | (tagType >> 7));
+		}
+		m_Buffer.push_back(tagType & 0x7f);
+	}
+
+	void Asn1Writer::writeLength(size_t length)
+	{
+		if (length < 128)
+		{
+			m_Buffer.push_back(static_cast<uint8_t>(length));
+			return;
+		}
+
+		size_t lengthBytes = 0;
+		for (auto tempLength = length; tempLength != 0; tempLength >>= 8)
+		{
+			lengthBytes++;
+		}
+
+		m_Buffer.push_back(static_cast<uint8_t>(0x80 | lengthBytes));
+		for (size_t i = lengthBytes; i > 0; i--)
+		{
+			m_Buffer.push_back(static_cast<uint8_t>(length >> ((i - 1) * 8)));
+		}
+	}
+
+	void Asn1Writer::beginConstructed(Asn1TagClass tagClass, uint8_t tagType)
+	{
+		if (m_Depth == MaxDepth)
+		{
+			throw std::runtime_error("Cannot begin ASN.1 constructed record, too many nested records");
+		}
+
+		writeTag(tagClass, true, tagType);
+		// a placeholder for the length, which is written in endConstructed()
+		m_LengthOffsets[m_Depth] = m_Buffer.size();
+		m_GapBytesAtBegin[m_Depth] = m_GapBytes;
+		m_Depth++;
+		m_Buffer.insert(m_Buffer.end(), ReservedLengthFieldSize, 0);
+	}
+
+	void Asn1Writer::endConstructed()
+	{
+		if (m_Depth == 0)
+		{
+			throw std::runtime_error("Cannot end ASN.1 constructed record, no record was begun");
+		}
+
+		size_t lengthOffset = m_LengthOffsets[--m_Depth];
+		// the gaps of the elements nested in this one aren't part of its value
+		size_t valueLength =
+		    m_Buffer.size() - lengthOffset - ReservedLengthFieldSize - (m_GapBytes - m_GapBytesAtBegin[m_Depth]);
+		if (static_cast<uint64_t>(valueLength) > 0xffffffffULL)
+		{
+			throw std::runtime_error("Cannot end ASN.1 constructed record, its value is too long");
+		}
+
+		size_t lengthFieldSize = 1;
+		if (valueLength < 128)
+		{
+			m_Buffer[lengthOffset] = static_cast<uint8_t>(valueLength);
+		}
+		else
+		{
+			size_t lengthBytes = 0;
+			for (auto tempLength = valueLength; tempLength != 0; tempLength >>= 8)
+			{
+				lengthBytes++;
+			}
+
+			m_Buffer[lengthOffset] = static_cast<uint8_t>(0x80 | lengthBytes);
+			for (size_t i = 0; i < lengthBytes; i++)
+			{
+				m_Buffer[lengthOffset + 1 + i] = static_cast<uint8_t>(valueLength >> ((lengthBytes - 1 - i) * 8));
+			}
+			lengthFieldSize += lengthBytes;
+		}
+
+		if (lengthFieldSize < ReservedLengthFieldSize)
+		{
+			m_Gaps.push_back({ lengthOffset + lengthFieldSize, ReservedLengthFieldSize - lengthFieldSize });
+			m_GapBytes += ReservedLengthFieldSize - lengthFieldSize;
+		}
+
+		if (m_Depth == 0)
+		{
+			removeGaps();
+		}
+	}
+
+	void Asn1Writer::removeGaps()
+	{
+		if (m_Gaps.empty())
+		{
+			return;
+		}
+
+		// the gaps were added as elements ended, inner elements first
+		std::sort(m_Gaps.begin(), m_Gaps.end(),
+		          [](const Gap& gap1, const Gap& gap2) { return gap1.offset < gap2.offset; });
+
+		size_t writeOffset = m_Gaps.front().offset;
+		for (size_t i = 0; i < m_Gaps.size(); i++)
+		{
+			size_t readOffset = m_Gaps[i].offset + m_Gaps[i].length;
+			size_t readEnd = (i + 1 < m_Gaps.size() ? m_Gaps[i + 1].offset : m_Buffer.size());
+			if (readEnd > readOffset)
+			{
+				memmove(m_Buffer.data() + writeOffset, m_Buffer.data() + readOffset, readEnd - readOffset);
+			}
+			writeOffset += readEnd - readOffset;
+		}
+
+		m_Buffer.resize(writeOffset);
+		m_Gaps.clear();
+		m_GapBytes = 0;
+	}
+
+	void Asn1Writer::writePrimitive(Asn1TagClass tagClass, uint8_t tagType, const uint8_t* value, size_t valueLen)
+	{
+		writeTag(tagClass, false, tagType);
+		writeLength(valueLen);
+		if (valueLen > 0)
+		{
+			m_Buffer.insert(m_Buffer.end(), value, value + valueLen);
+		}
+	}
+
+	void Asn1Writer::writeIntegerElement(Asn1UniversalTagType tagType, uint32_t value)
+	{
+		size_t valueLength = sizeof(uint32_t);
+		if (value <= std::numeric_limits<uint8_t>::max())
+		{
+			valueLength = 1;
+		}
+		else if (value <= std::numeric_limits<uint16_t>::max())
+		{
+			valueLength = 2;
+		}
+		else if (value <= 0xffffff)
+		{
+			valueLength = 3;
+		}
+
+		writeTag(Asn1TagClass::Universal, false, static_cast<uint8_t>(tagType));
+		writeLength(valueLength);
+		for (size_t i = valueLength; i > 0; i--)
+		{
+			m_Buffer.push_back(static_cast<uint8_t>(value >> ((i - 1) * 8)));
+		}
+	}
+
+	void Asn1Writer::writeBoolean(bool value)
+	{
+		uint8_t byte = value ? 0xff : 0x00;
+		writePrimitive(Asn1TagClass::Universal, static_cast<uint8_t>(Asn1UniversalTagType::Boolean), &byte, 1);
+	}
+
+	void Asn1Writer::writeEncoded(const uint8_t* data, size_t dataLen)
+	{
+		if (dataLen > 0)
+		{
+			m_Buffer.insert(m_Buffer.end(), data, data + dataLen);
+		}
+	}
+
+	void Asn1Writer::clear()
+	{
+		m_Buffer.clear();
+		m_Gaps.clear();
+		m_GapBytes = 0;
+		m_Depth = 0;
+	}
 }  // namespace pcpp
@@ -0,0 +1,573 @@
+#define LOG_MODULE PacketLogModuleDnsLayer
+
+#include "DnsView.h"
+#include "DnsLayer.h"
+#include "EndianPortable.h"
+#include <cstring>
+
+namespace pcpp
+{
+
+	constexpr size_t DnsView::MaxIndexedRecords;
+	constexpr size_t DnsView::NameCacheSize;
+	constexpr size_t DnsView::NameBufferSize;
+	constexpr size_t DnsView::NameCacheTextSize;
+
+	namespace
+	{
+		constexpr size_t MaxDnsMessageSize = 0xffff;
+		constexpr size_t MaxEncodedNameLength = 255;
+		constexpr size_t QueryFixedSize = 4;
+		constexpr size_t ResourceFixedSize = 10;
+		constexpr size_t NotMalformed = static_cast<size_t>(-1);
+		// the number of compression pointer targets of a single name that are added to the name cache
+		constexpr size_t MaxFollowedPointers = 4;
+
+		inline char toLowerAscii(char c)
+		{
+			return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+		}
+
+		enum class NameToken
+		{
+			Label,
+			Pointer,
+			End,
+			Error
+		};
+
+		// Walks the labels of an encoded name, following compression pointers only when asked to. A pointer must point
+		// before the start of the label sequence it appears in, so the walk always terminates
+		struct NameReader
+		{
+			const uint8_t* data;
+			size_t dataLen;
+			size_t pos;
+			size_t segmentStart;
+			size_t wireLength;
+			const uint8_t* label;
+			size_t labelLength;
+			size_t pointerTarget;
+
+			NameReader(const uint8_t* msgData, size_t msgDataLen, size_t offset)
+			    : data(msgData), dataLen(msgDataLen), pos(offset), segmentStart(offset), wireLength(0), label(nullptr),
+			      labelLength(0), pointerTarget(0)
+			{}
+
+			NameToken next()
+			{
+				if (pos >= dataLen)
+					return NameToken::Error;
+
+				uint8_t length = data[pos];
+				if ((length & 0xc0) == 0xc0)
+				{
+					if (pos + 2 > dataLen)
+						return NameToken::Error;
+
+					pointerTarget = static_cast<size_t>(length & 0x3f) << 8 | data[pos + 1];
+					if (pointerTarget < sizeof(dnshdr) || pointerTarget >= segmentStart)
+						return NameToken::Error;
+
+					return NameToken::Pointer;
+				}
+
+				// the extended (0x40) and reserved (0x80) label types aren't supported
+				if ((length & 0xc0) != 0)
+					return NameToken::Error;
+
+				if (length == 0)
+				{
+					wireLength++;
+					return NameToken::End;
+				}
+
+				// leave room for the terminating zero length
+				if (pos + 1 + length > dataLen || wireLength + 1 + length + 1 > MaxEncodedNameLength)
+					return NameToken::Error;
+
+				label = data + pos + 1;
+				labelLength = length;
+				wireLength += 1 + length;
+				pos += 1 + length;
+				return NameToken::Label;
+			}
+
+			void followPointer()
+			{
+				pos = pointerTarget;
+				segmentStart = pointerTarget;
+			}
+		};
+
+		// Compares text to the name prefix of a case-insensitive comparison in progress. Returns false on a mismatch
+		bool matchText(const char* text, size_t textLength, const char* name, size_t nameLen, size_t& matched)
+		{
+			if (textLength > nameLen - matched)
+				return false;
+
+			for (size_t i = 0; i < textLength; i++)
+			{
+				if (toLowerAscii(text[i]) != toLowerAscii(name[matched + i]))
+					return false;
+			}
+
+			matched += textLength;
+			return true;
+		}
+
+		bool matchSeparator(const char* name, size_t nameLen, size_t& matched)
+		{
+			if (matched == 0)
+				return true;
+
+			if (matched >= nameLen || name[matched] != '.')
+				return false;
+
+			matched++;
+			return true;
+		}
+
+		bool containsIgnoreCase(const char* text, size_t textLength, const char* pattern, size_t patternLength)
+		{
+			if (patternLength > textLength)
+				return false;
+
+			for (size_t start = 0; start + patternLength <= textLength; start++)
+			{
+				size_t i = 0;
+				while (i < patternLength && toLowerAscii(text[start + i]) == toLowerAscii(pattern[i]))
+					i++;
+
+				if (i == patternLength)
+					return true;
+			}
+
+			return false;
+		}
+	}  // namespace
+
+	DnsView::DnsView(const uint8_t* data, size_t dataLen)
+	{
+		init(data, dataLen);
+	}
+
+	DnsView::DnsView(const DnsLayer& dnsLayer)
+	{
+		size_t offsetAdjustment = dnsLayer.m_OffsetAdjustment;
+		if (dnsLayer.getDataLen() < offsetAdjustment)
+			init(nullptr, 0);
+		else
+			init(dnsLayer.getData() + offsetAdjustment, dnsLayer.getDataLen() - offsetAdjustment);
+	}
+
+	void DnsView::init(const uint8_t* data, size_t dataLen)
+	{
+		if (data == nullptr || dataLen < sizeof(dnshdr))
+		{
+			m_Data = nullptr;
+			m_DataLen = 0;
+		}
+		else
+		{
+			m_Data = data;
+			m_DataLen = dataLen > MaxDnsMessageSize ? MaxDnsMessageSize : dataLen;
+		}
+
+		m_NumOfIndexedRecords = 0;
+		m_CursorIndex = 0;
+		m_CursorOffset = sizeof(dnshdr);
+		m_FirstMalformedIndex = NotMalformed;
+		m_NameCacheCount = 0;
+		m_NameCacheTextLength = 0;
+		m_NameCacheHits = 0;
+	}
+
+	const dnshdr* DnsView::getDnsHeader() const
+	{
+		return reinterpret_cast<const dnshdr*>(m_Data);
+	}
+
+	size_t DnsView::getQueryCount() const
+	{
+		return isValid() ? be16toh(getDnsHeader()->numberOfQuestions) : 0;
+	}
+
+	size_t DnsView::getAnswerCount() const
+	{
+		return isValid() ? be16toh(getDnsHeader()->numberOfAnswers) : 0;
+	}
+
+	size_t DnsView::getAuthorityCount() const
+	{
+		return isValid() ? be16toh(getDnsHeader()->numberOfAuthority) : 0;
+	}
+
+	size_t DnsView::getAdditionalRecordCount() const
+	{
+		return isValid() ? be16toh(getDnsHeader()->numberOfAdditional) : 0;
+	}
+
+	size_t DnsView::getRecordCount() const
+	{
+		return getQueryCount() + getAnswerCount() + getAuthorityCount() + getAdditionalRecordCount();
+	}
+
+	size_t DnsView::getRecordCount(DnsResourceType resourceType) const
+	{
+		switch (resourceType)
+		{
+		case DnsQueryType:
+			return getQueryCount();
+		case DnsAnswerType:
+			return getAnswerCount();
+		case DnsAuthorityType:
+			return getAuthorityCount();
+		case DnsAdditionalType:
+			return getAdditionalRecordCount();
+		default:
+			return 0;
+		}
+	}
+
+	bool DnsView::skipName(size_t offset, size_t& endOffset) const
+	{
+		// only the part of the name at this offset is checked here, pointer targets are checked when it's decoded
+		size_t pos = offset;
+		while (pos < m_DataLen)
+		{
+			uint8_t length = m_Data[pos];
+			if ((length & 0xc0) == 0xc0)
+			{
+				if (pos + 2 > m_DataLen)
+					return false;
+
+				endOffset = pos + 2;
+				return true;
+			}
+
+			if ((length & 0xc0) != 0 || pos - offset + 1 + length > MaxEncodedNameLength)
+				return false;
+
+			if (length == 0)
+			{
+				endOffset = pos + 1;
+				return true;
+			}
+
+			pos += 1 + length;
+		}
+
+		return false;
+	}
+
+	bool DnsView::parseRecord(size_t index, size_t offset, DnsRecordView& record) const
+	{
+		size_t nameEnd = 0;
+		if (!skipName(offset, nameEnd))
+			return false;
+
+		size_t numOfQueries = getQueryCount();
+		size_t numOfAnswers = getAnswerCount();
+		size_t numOfAuthorities = getAuthorityCount();
+		if (index < numOfQueries)
+			record.resourceType = DnsQueryType;
+		else if (index < numOfQueries + numOfAnswers)
+			record.resourceType = DnsAnswerType;
+		else if (index < numOfQueries + numOfAnswers + numOfAuthorities)
+			record.resourceType = DnsAuthorityType;
+		else
+			record.resourceType = DnsAdditionalType;
+
+		size_t fixedSize = record.resourceType == DnsQueryType ? QueryFixedSize : ResourceFixedSize;
+		if (nameEnd + fixedSize > m_DataLen)
+			return false;
+
+		const uint8_t* fixedPart = m_Data + nameEnd;
+		record.recordOffset = offset;
+		record.nameOffset = offset;
+		record.dnsType = static_cast<DnsType>(fixedPart[0] << 8 | fixedPart[1]);
+		record.dnsClass = static_cast<DnsClass>(fixedPart[2] << 8 | fixedPart[3]);
+
+		if (record.resourceType == DnsQueryType)
+		{
+			record.ttl = 0;
+			record.dataOffset = 0;
+			record.data = nullptr;
+			record.dataLength = 0;
+			record.size = nameEnd + QueryFixedSize - offset;
+			return true;
+		}
+
+		record.ttl = static_cast<uint32_t>(fixedPart[4]) << 24 | static_cast<uint32_t>(fixedPart[5]) << 16 |
+		             static_cast<uint32_t>(fixedPart[6]) << 8 | fixedPart[7];
+		record.dataLength = static_cast<size_t>(fixedPart[8]) << 8 | fixedPart[9];
+		record.dataOffset = nameEnd + ResourceFixedSize;
+		if (record.dataOffset + record.dataLength > m_DataLen)
+			return false;
+
+		record.data = m_Data + record.dataOffset;
+		record.size = record.dataOffset + record.dataLength - offset;
+		return true;
+	}
+
+	bool DnsView::getRecord(size_t index, DnsRecordView& record) const
+	{
+		if (!isValid() || index >= getRecordCount() || index >= m_FirstMalformedIndex)
+			return false;
+
+		if (index < m_NumOfIndexedRecords)
+			return parseRecord(index, m_RecordOffsets[index], record);
+
+		// the cursor is past the requested record, which is beyond the index, so restart from the last indexed one
+		if (index < m_CursorIndex)
+		{
+			m_CursorIndex = m_NumOfIndexedRecords - 1;
+			m_CursorOffset = m_RecordOffsets[m_CursorIndex];
+		}
+
+		while (true)
+		{
+			if (m_CursorIndex == m_NumOfIndexedRecords && m_NumOfIndexedRecords < MaxIndexedRecords)
+			{
+				m_RecordOffsets[m_NumOfIndexedRecords] = static_cast<uint16_t>(m_CursorOffset);
+				m_NumOfIndexedRecords++;
+			}
+
+			if (!parseRecord(m_CursorIndex, m_CursorOffset, record))
+			{
+				m_FirstMalformedIndex = m_CursorIndex;
+				if (m_CursorIndex < m_NumOfIndexedRecords)
+					m_NumOfIndexedRecords = m_CursorIndex;
+				return false;
+			}
+
+			if (m_CursorIndex == index)
+				return true;
+
+			m_CursorOffset += record.size;
+			m_CursorIndex++;
+		}
+	}
+
+	bool DnsView::getRecord(DnsResourceType resourceType, size_t index, DnsRecordView& record) const
+	{
+		if (index >= getRecordCount(resourceType))
+			return false;
+
+		size_t firstIndex = 0;
+		if (resourceType != DnsQueryType)
+			firstIndex += getQueryCount();
+		if (resourceType == DnsAuthorityType || resourceType == DnsAdditionalType)
+			firstIndex += getAnswerCount();
+		if (resourceType == DnsAdditionalType)
+			firstIndex += getAuthorityCount();
+
+		return getRecord(firstIndex + index, record);
+	}
+
+	const DnsView::NameCacheEntry* DnsView::lookupName(size_t targetOffset) const
+	{
+		for (size_t i = 0; i < m_NameCacheCount; i++)
+		{
+			if (m_NameCache[i].targetOffset == targetOffset)
+			{
+				m_NameCacheHits++;
+				return &m_NameCache[i];
+			}
+		}
+
+		return nullptr;
+	}
+
+	void DnsView::cacheName(size_t targetOffset, const char* text, size_t textLength, size_t wireLength) const
+	{
+		for (size_t i = 0; i < m_NameCacheCount; i++)
+		{
+			if (m_NameCache[i].targetOffset == targetOffset)
+				return;
+		}
+
+		// a decoded name is always shorter than NameCacheTextSize, so starting over makes room for it
+		if (m_NameCacheCount == NameCacheSize || m_NameCacheTextLength + textLength > NameCacheTextSize)
+		{
+			m_NameCacheCount = 0;
+			m_NameCacheTextLength = 0;
+		}
+
+		NameCacheEntry& entry = m_NameCache[m_NameCacheCount++];
+		entry.targetOffset = static_cast<uint16_t>(targetOffset);
+		entry.textOffset = static_cast<uint16_t>(m_NameCacheTextLength);
+		entry.textLength = static_cast<uint16_t>(textLength);
+		entry.wireLength = static_cast<uint16_t>(wireLength);
+		memcpy(m_NameCacheText + m_NameCacheTextLength, text, textLength);
+		m_NameCacheTextLength += textLength;
+	}
+
+	bool DnsView::decodeName(size_t nameOffset, char* buffer, size_t bufferLen, size_t* nameLength) const
+	{
+		if (!isValid() || buffer == nullptr || bufferLen == 0)
+			return false;
+
+		buffer[0] = 0;
+
+		size_t followedTargets[MaxFollowedPointers];
+		size_t followedTextLength[MaxFollowedPointers];
+		size_t followedWireLength[MaxFollowedPointers];
+		size_t numOfFollowed = 0;
+
+		NameReader reader(m_Data, m_DataLen, nameOffset);
+		size_t textLength = 0;
+		size_t wireLength = 0;
+		bool done = false;
+		while (!done)
+		{
+			switch (reader.next())
+			{
+			case NameToken::Label:
+			{
+				size_t separatorLength = textLength > 0 ? 1 : 0;
+				if (textLength + separatorLength + reader.labelLength + 1 > bufferLen)
+					return false;
+
+				if (separatorLength > 0)
+					buffer[textLength++] = '.';
+
+				memcpy(buffer + textLength, reader.label, reader.labelLength);
+				textLength += reader.labelLength;
+				break;
+			}
+			case NameToken::Pointer:
+			{
+				const NameCacheEntry* cached = lookupName(reader.pointerTarget);
+				if (cached == nullptr)
+				{
+					if (numOfFollowed < MaxFollowedPointers)
+					{
+						followedTargets[numOfFollowed] = reader.pointerTarget;
+						followedTextLength[numOfFollowed] = textLength;
+						followedWireLength[numOfFollowed] = reader.wireLength;
+						numOfFollowed++;
+					}
+
+					reader.followPointer();
+					break;
+				}
+
+				if (reader.wireLength + cached->wireLength > MaxEncodedNameLength)
+					return false;
+
+				size_t separatorLength = (textLength > 0 && cached->textLength > 0) ? 1 : 0;
+				if (textLength + separatorLength + cached->textLength + 1 > bufferLen)
+					return false;
+
+				if (separatorLength > 0)
+					buffer[textLength++] = '.';
+
+				memcpy(buffer + textLength, m_NameCacheText + cached->textOffset, cached->textLength);
+				textLength += cached->textLength;
+				wireLength = reader.wireLength + cached->wireLength;
+				done = true;
+				break;
+			}
+			case NameToken::End:
+				wireLength = reader.wireLength;
+				done = true;
+				break;
+			default:
+				return false;
+			}
+		}
+
+		buffer[textLength] = 0;
+		if (nameLength != nullptr)
+			*nameLength = textLength;
+
+		// the text of a pointer target is the suffix of the decoded name that starts after the separator, if any
+		for (size_t i = 0; i < numOfFollowed; i++)
+		{
+			size_t suffixStart = followedTextLength[i];
+			if (suffixStart > 0 && suffixStart < textLength)
+				suffixStart++;
+
+			cacheName(followedTargets[i], buffer + suffixStart, textLength - suffixStart,
+			          wireLength - followedWireLength[i]);
+		}
+
+		return true;
+	}
+
+	bool DnsView::isNameEqual(size_t nameOffset, const char* name, size_t nameLen) const
+	{
+		if (!isValid() || (name == nullptr && nameLen > 0))
+			return false;
+
+		if (nameLen > 0 && name[nameLen - 1] == '.')
+			nameLen--;
+
+		NameReader reader(m_Data, m_DataLen, nameOffset);
+		size_t matched = 0;
+		while (true)
+		{
+			switch (reader.next())
+			{
+			case NameToken::Label:
+				if (!matchSeparator(name, nameLen, matched) ||
+				    !matchText(reinterpret_cast<const char*>(reader.label), reader.labelLength, name, nameLen, matched))
+					return false;
+				break;
+			case NameToken::Pointer:
+			{
+				const NameCacheEntry* cached = lookupName(reader.pointerTarget);
+				if (cached == nullptr)
+				{
+					reader.followPointer();
+					break;
+				}
+
+				if (reader.wireLength + cached->wireLength > MaxEncodedNameLength)
+					return false;
+
+				if (cached->textLength > 0 &&
+				    (!matchSeparator(name, nameLen, matched) ||
+				     !matchText(m_NameCacheText + cached->textOffset, cached->textLength, name, nameLen, matched)))
+					return false;
+
+				return matched == nameLen;
+			}
+			case NameToken::End:
+				return matched == nameLen;
+			default:
+				return false;
+			}
+		}
+	}
+
+	int DnsView::findRecord(DnsResourceType resourceType, const std::string& name, bool exactMatch) const
+	{
+		char decodedName[NameBufferSize];
+		size_t count = getRecordCount(resourceType);
+		for (size_t i = 0; i < count; i++)
+		{
+			DnsRecordView record;
+			if (!getRecord(resourceType, i, record))
+				return -1;
+
+			if (exactMatch)
+			{
+				if (isNameEqual(record.nameOffset, name))
+					return static_cast<int>(i);
+
+				continue;
+			}
+
+			size_t decodedNameLength = 0;
+			if (decodeName(record.nameOffset, decodedName, sizeof(decodedName), &decodedNameLength) &&
+			    containsIgnoreCase(decodedName, decodedNameLength, name.data(), name.size()))
+				return static_cast<int>(i);
+		}
+
+		return -1;
+	}
+
+}  // namespace pcpp
@@ -0,0 +1,507 @@
+#define LOG_MODULE PacketLogModuleFlowMeter
+
+#include "FlowExport.h"
+#include "Logger.h"
+#include <cstring>
+
+namespace pcpp
+{
+
+	static const uint16_t IpfixVersion = 10;
+	static const size_t IpfixMessageHeaderLen = 16;
+	static const size_t IpfixSetHeaderLen = 4;
+	static const uint16_t IpfixTemplateSetId = 2;
+	static const uint16_t IpfixEnterpriseBit = 0x8000;
+	// the enterprise number of the reverse information elements of RFC 5103
+	static const uint32_t IpfixReversePen = 29305;
+
+	static const size_t IpfixMinMessageSize = 512;
+	static const size_t IpfixMaxMessageSize = 65535;
+
+	struct IpfixField
+	{
+		uint16_t id;
+		uint16_t length;
+		bool isReverse;
+	};
+
+	// the fields of both templates, the IP address fields are replaced by their IPv6 counterparts in the IPv6 template
+	static const IpfixField IpfixTemplateFields[] = {
+		{ 8, 4, false },  // sourceIPv4Address
+		{ 12, 4, false },  // destinationIPv4Address
+		{ 7, 2, false },  // sourceTransportPort
+		{ 11, 2, false },  // destinationTransportPort
+		{ 4, 1, false },  // protocolIdentifier
+		{ 6, 2, false },  // tcpControlBits
+		{ 6, 2, true },  // reverseTcpControlBits
+		{ 152, 8, false },  // flowStartMilliseconds
+		{ 153, 8, false },  // flowEndMilliseconds
+		{ 1, 8, false },  // octetDeltaCount
+		{ 2, 8, false },  // packetDeltaCount
+		{ 1, 8, true },  // reverseOctetDeltaCount
+		{ 2, 8, true },  // reversePacketDeltaCount
+		{ 136, 1, false }  // flowEndReason
+	};
+
+	static const size_t IpfixNumOfTemplateFields = sizeof(IpfixTemplateFields) / sizeof(IpfixTemplateFields[0]);
+	static const uint16_t IpfixSourceIPv6Address = 27;
+	static const uint16_t IpfixDestinationIPv6Address = 28;
+
+	static size_t getIpfixRecordLength(bool isIPv6)
+	{
+		size_t len = 0;
+		for (size_t i = 0; i < IpfixNumOfTemplateFields; i++)
+			len += IpfixTemplateFields[i].length;
+
+		return isIPv6 ? len + 2 * (16 - 4) : len;
+	}
+
+	static void appendUInt8(std::vector<uint8_t>& buffer, uint8_t value)
+	{
+		buffer.push_back(value);
+	}
+
+	static void appendBE16(std::vector<uint8_t>& buffer, uint16_t value)
+	{
+		buffer.push_back(static_cast<uint8_t>(value >> 8));
+		buffer.push_back(static_cast<uint8_t>(value));
+	}
+
+	static void appendBE32(std::vector<uint8_t>& buffer, uint32_t value)
+	{
+		appendBE16(buffer, static_cast<uint16_t>(value >> 16));
+		appendBE16(buffer, static_cast<uint16_t>(value));
+	}
+
+	static void appendBE64(std::vector<uint8_t>& buffer, uint64_t value)
+	{
+		appendBE32(buffer, static_cast<uint32_t>(value >> 32));
+		appendBE32(buffer, static_cast<uint32_t>(value));
+	}
+
+	static void writeBE16(std::vector<uint8_t>& buffer, size_t offset, uint16_t value)
+	{
+		buffer[offset] = static_cast<uint8_t>(value >> 8);
+		buffer[offset + 1] = static_cast<uint8_t>(value);
+	}
+
+	static void writeBE32(std::vector<uint8_t>& buffer, size_t offset, uint32_t value)
+	{
+		writeBE16(buffer, offset, static_cast<uint16_t>(value >> 16));
+		writeBE16(buffer, offset + 2, static_cast<uint16_t>(value));
+	}
+
+	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	// IpfixEncoder
+	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+	IpfixEncoder::IpfixEncoder(OnIpfixMessageCallback onMessage, void* userCookie, uint32_t observationDomainId,
+	                           size_t maxMessageSize, uint32_t templateRefreshInterval)
+	    : m_OnMessage(onMessage), m_UserCookie(userCookie), m_ObservationDomainId(observationDomainId),
+	      m_MaxMessageSize(maxMessageSize), m_TemplateRefreshInterval(templateRefreshInterval), m_SequenceNumber(0),
+	      m_NumOfMessages(0), m_SetOffset(0), m_SetId(0), m_NumOfRecordsInMessage(0), m_ExportTime(0)
+	{
+		if (m_MaxMessageSize < IpfixMinMessageSize)
+			m_MaxMessageSize = IpfixMinMessageSize;
+		else if (m_MaxMessageSize > IpfixMaxMessageSize)
+			m_MaxMessageSize = IpfixMaxMessageSize;
+
+		m_Message.reserve(m_MaxMessageSize);
+	}
+
+	bool IpfixEncoder::exportRecords(const FlowRecord* records, size_t count)
+	{
+		if (m_OnMessage == nullptr)
+		{
+			PCPP_LOG_ERROR("IPFIX message callback is not set");
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		bool result = true;
+		startMessage();
+		for (size_t i = 0; i < count; i++)
+		{
+			const FlowRecord& record = records[i];
+			bool isIPv6 = (record.key.ipVersion == 6);
+			uint16_t templateId = isIPv6 ? IPFIX_IPV6_TEMPLATE_ID : IPFIX_IPV4_TEMPLATE_ID;
+			size_t neededLen = getIpfixRecordLength(isIPv6) + (m_SetId != templateId ? IpfixSetHeaderLen : 0);
+
+			if (m_NumOfRecordsInMessage > 0 && m_Message.size() + neededLen > m_MaxMessageSize)
+			{
+				result = finishMessage() && result;
+				startMessage();
+			}
+
+			if (m_SetId != templateId)
+			{
+				closeSet();
+				m_SetOffset = m_Message.size();
+				m_SetId = templateId;
+				appendBE16(m_Message, templateId);
+				appendBE16(m_Message, 0);
+			}
+
+			writeRecord(record);
+		}
+
+		if (m_NumOfRecordsInMessage > 0)
+			result = finishMessage() && result;
+
+		return result;
+	}
+
+	void IpfixEncoder::startMessage()
+	{
+		m_Message.clear();
+		m_Message.resize(IpfixMessageHeaderLen);
+		m_SetId = 0;
+		m_NumOfRecordsInMessage = 0;
+		m_ExportTime = 0;
+
+		bool sendTemplates = (m_NumOfMessages == 0);
+		if (m_TemplateRefreshInterval != 0 && m_NumOfMessages % m_TemplateRefreshInterval == 0)
+			sendTemplates = true;
+
+		if (!sendTemplates)
+			return;
+
+		m_SetOffset = m_Message.size();
+		m_SetId = IpfixTemplateSetId;
+		appendBE16(m_Message, IpfixTemplateSetId);
+		appendBE16(m_Message, 0);
+		writeTemplate(IPFIX_IPV4_TEMPLATE_ID, false);
+		writeTemplate(IPFIX_IPV6_TEMPLATE_ID, true);
+	}
+
+	bool IpfixEncoder::finishMessage()
+	{
+		closeSet();
+
+		writeBE16(m_Message, 0, IpfixVersion);
+		writeBE16(m_Message, 2, static_cast<uint16_t>(m_Message.size()));
+		writeBE32(m_Message, 4, static_cast<uint32_t>(m_ExportTime / 1000000000ULL));
+		writeBE32(m_Message, 8, m_SequenceNumber);
+		writeBE32(m_Message, 12, m_ObservationDomainId);
+
+		m_SequenceNumber += m_NumOfRecordsInMessage;
+		m_NumOfMessages++;
+
+		if (!m_OnMessage(m_Message.data(), m_Message.size(), m_UserCookie))
+		{
+			PCPP_LOG_ERROR("Failed to deliver IPFIX message #" << m_NumOfMessages);
+			return false;
+		}
+
+		return true;
+	}
+
+	void IpfixEncoder::closeSet()
+	{
+		if (m_SetId == 0)
+			return;
+
+		writeBE16(m_Message, m_SetOffset + 2, static_cast<uint16_t>(m_Message.size() - m_SetOffset));
+		m_SetId = 0;
+	}
+
+	void IpfixEncoder::writeTemplate(uint16_t templateId, bool isIPv6)
+	{
+		appendBE16(m_Message, templateId);
+		appendBE16(m_Message, static_cast<uint16_t>(IpfixNumOfTemplateFields));
+		for (size_t i = 0; i < IpfixNumOfTemplateFields; i++)
+		{
+			const IpfixField& field = IpfixTemplateFields[i];
+			uint16_t id = field.id;
+			uint16_t length = field.length;
+			if (isIPv6 && i < 2)
+			{
+				id = (i == 0 ? IpfixSourceIPv6Address : IpfixDestinationIPv6Address);
+				length = 16;
+			}
+
+			appendBE16(m_Message, field.isReverse ? static_cast<uint16_t>(id | IpfixEnterpriseBit) : id);
+			appendBE16(m_Message, length);
+			if (field.isReverse)
+				appendBE32(m_Message, IpfixReversePen);
+		}
+	}
+
+	void IpfixEncoder::writeRecord(const FlowRecord& record)
+	{
+		size_t ipLen = (record.key.ipVersion == 6 ? 16 : 4);
+		m_Message.insert(m_Message.end(), record.getSrcIP(), record.getSrcIP() + ipLen);
+		m_Message.insert(m_Message.end(), record.getDstIP(), record.getDstIP() + ipLen);
+		appendBE16(m_Message, record.getSrcPort());
+		appendBE16(m_Message, record.getDstPort());
+		appendUInt8(m_Message, record.key.protocol);
+		appendBE16(m_Message, record.tcpFlags[0]);
+		appendBE16(m_Message, record.tcpFlags[1]);
+		appendBE64(m_Message, record.startTime / 1000000ULL);
+		appendBE64(m_Message, record.endTime / 1000000ULL);
+		appendBE64(m_Message, record.bytes[0]);
+		appendBE64(m_Message, record.packets[0]);
+		appendBE64(m_Message, record.bytes[1]);
+		appendBE64(m_Message, record.packets[1]);
+		appendUInt8(m_Message, static_cast<uint8_t>(record.endReason));
+
+		if (record.endTime > m_ExportTime)
+			m_ExportTime = record.endTime;
+
+		m_NumOfRecordsInMessage++;
+	}
+
+	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	// FlowRecordFileWriter / FlowRecordFileReader
+	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+	static const char FlowFileMagic[4] = { 'P', 'F', 'R', '1' };
+	static const uint16_t FlowFileVersion = 1;
+	static const size_t FlowFileHeaderLen = 8;
+
+	static const uint8_t FlowFileFlagIPv6 = 0x01;
+	static const uint8_t FlowFileFlagReversed = 0x02;
+
+	// flags, protocol, end reason, 2 TCP flags and 2 ports
+	static const size_t FlowFileRecordFixedLen = 9;
+
+	static void appendLE16(std::vector<uint8_t>& buffer, uint16_t value)
+	{
+		buffer.push_back(static_cast<uint8_t>(value));
+		buffer.push_back(static_cast<uint8_t>(value >> 8));
+	}
+
+	static void appendLE64(std::vector<uint8_t>& buffer, uint64_t value)
+	{
+		for (int i = 0; i < 8; i++)
+			buffer.push_back(static_cast<uint8_t>(value >> (8 * i)));
+	}
+
+	static void appendVarInt(std::vector<uint8_t>& buffer, uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			buffer.push_back(static_cast<uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+		buffer.push_back(static_cast<uint8_t>(value));
+	}
+
+	FlowRecordFileWriter::FlowRecordFileWriter(const std::string& fileName) : m_FileName(fileName), m_File(nullptr)
+	{}
+
+	FlowRecordFileWriter::~FlowRecordFileWriter()
+	{
+		close();
+	}
+
+	bool FlowRecordFileWriter::open()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (m_File != nullptr)
+		{
+			PCPP_LOG_ERROR("Flow record file '" << m_FileName << "' is already open");
+			return false;
+		}
+
+		m_File = fopen(m_FileName.c_str(), "wb");
+		if (m_File == nullptr)
+		{
+			PCPP_LOG_ERROR("Cannot create flow record file '" << m_FileName << "'");
+			return false;
+		}
+
+		uint8_t header[FlowFileHeaderLen] = { 0 };
+		memcpy(header, FlowFileMagic, sizeof(FlowFileMagic));
+		header[4] = static_cast<uint8_t>(FlowFileVersion);
+		header[5] = static_cast<uint8_t>(FlowFileVersion >> 8);
+		if (fwrite(header, 1, sizeof(header), m_File) != sizeof(header))
+		{
+			PCPP_LOG_ERROR("Cannot write the header of flow record file '" << m_FileName << "'");
+			fclose(m_File);
+			m_File = nullptr;
+			return false;
+		}
+
+		return true;
+	}
+
+	void FlowRecordFileWriter::close()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (m_File == nullptr)
+			return;
+
+		fclose(m_File);
+		m_File = nullptr;
+	}
+
+	bool FlowRecordFileWriter::exportRecords(const FlowRecord* records, size_t count)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (m_File == nullptr)
+		{
+			PCPP_LOG_ERROR("Flow record file '" << m_FileName << "' is not open");
+			return false;
+		}
+
+		m_Buffer.clear();
+		for (size_t i = 0; i < count; i++)
+		{
+			const FlowRecord& record = records[i];
+			bool isIPv6 = (record.key.ipVersion == 6);
+			size_t ipLen = isIPv6 ? 16 : 4;
+
+			uint8_t flags = (isIPv6 ? FlowFileFlagIPv6 : 0) | (record.isReversed ? FlowFileFlagReversed : 0);
+			m_Buffer.push_back(flags);
+			m_Buffer.push_back(record.key.protocol);
+			m_Buffer.push_back(static_cast<uint8_t>(record.endReason));
+			m_Buffer.push_back(record.tcpFlags[0]);
+			m_Buffer.push_back(record.tcpFlags[1]);
+			appendLE16(m_Buffer, record.key.port1);
+			appendLE16(m_Buffer, record.key.port2);
+			m_Buffer.insert(m_Buffer.end(), record.key.ip1, record.key.ip1 + ipLen);
+			m_Buffer.insert(m_Buffer.end(), record.key.ip2, record.key.ip2 + ipLen);
+			appendLE64(m_Buffer, record.startTime);
+			appendVarInt(m_Buffer, record.endTime >= record.startTime ? record.endTime - record.startTime : 0);
+			appendVarInt(m_Buffer, record.packets[0]);
+			appendVarInt(m_Buffer, record.packets[1]);
+			appendVarInt(m_Buffer, record.bytes[0]);
+			appendVarInt(m_Buffer, record.bytes[1]);
+		}
+
+		if (fwrite(m_Buffer.data(), 1, m_Buffer.size(), m_File) != m_Buffer.size())
+		{
+			PCPP_LOG_ERROR("Cannot write to flow record file '" << m_FileName << "'");
+			return false;
+		}
+
+		return true;
+	}
+
+	bool FlowRecordFileWriter::flush()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		return m_File != nullptr && fflush(m_File) == 0;
+	}
+
+	FlowRecordFileReader::FlowRecordFileReader(const std::string& fileName) : m_FileName(fileName), m_File(nullptr)
+	{}
+
+	FlowRecordFileReader::~FlowRecordFileReader()
+	{
+		close();
+	}
+
+	bool FlowRecordFileReader::open()
+	{
+		if (m_File != nullptr)
+		{
+			PCPP_LOG_ERROR("Flow record file '" << m_FileName << "' is already open");
+			return false;
+		}
+
+		m_File = fopen(m_FileName.c_str(), "rb");
+		if (m_File == nullptr)
+		{
+			PCPP_LOG_ERROR("Cannot open flow record file '" << m_FileName << "'");
+			return false;
+		}
+
+		uint8_t header[FlowFileHeaderLen];
+		if (fread(header, 1, sizeof(header), m_File) != sizeof(header) ||
+		    memcmp(header, FlowFileMagic, sizeof(FlowFileMagic)) != 0)
+		{
+			PCPP_LOG_ERROR("'" << m_FileName << "' is not a flow record file");
+			close();
+			return false;
+		}
+
+		uint16_t version = static_cast<uint16_t>(header[4] | (header[5] << 8));
+		if (version != FlowFileVersion)
+		{
+			PCPP_LOG_ERROR("Unsupported flow record file version " << version);
+			close();
+			return false;
+		}
+
+		return true;
+	}
+
+	void FlowRecordFileReader::close()
+	{
+		if (m_File == nullptr)
+			return;
+
+		fclose(m_File);
+		m_File = nullptr;
+	}
+
+	bool FlowRecordFileReader::readVarInt(uint64_t& value)
+	{
+		value = 0;
+		for (int shift = 0; shift < 64; shift += 7)
+		{
+			int byte = fgetc(m_File);
+			if (byte == EOF)
+				return false;
+
+			value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0)
+				return true;
+		}
+
+		return false;
+	}
+
+	bool FlowRecordFileReader::getNextRecord(FlowRecord& record)
+	{
+		if (m_File == nullptr)
+			return false;
+
+		uint8_t fixed[FlowFileRecordFixedLen];
+		size_t readLen = fread(fixed, 1, sizeof(fixed), m_File);
+		if (readLen == 0)
+			return false;
+
+		if (readLen != sizeof(fixed))
+		{
+			PCPP_LOG_ERROR("Flow record file '" << m_FileName << "' is truncated");
+			return false;
+		}
+
+		record = FlowRecord();
+		bool isIPv6 = (fixed[0] & FlowFileFlagIPv6) != 0;
+		size_t ipLen = isIPv6 ? 16 : 4;
+		record.isReversed = (fixed[0] & FlowFileFlagReversed) != 0;
+		record.key.ipVersion = isIPv6 ? 6 : 4;
+		record.key.protocol = fixed[1];
+		record.endReason = static_cast<FlowEndReason>(fixed[2]);
+		record.tcpFlags[0] = fixed[3];
+		record.tcpFlags[1] = fixed[4];
+		record.key.port1 = static_cast<uint16_t>(fixed[5] | (fixed[6] << 8));
+		record.key.port2 = static_cast<uint16_t>(fixed[7] | (fixed[8] << 8));
+
+		uint8_t startTime[8];
+		uint64_t duration;
+		if (fread(record.key.ip1, 1, ipLen, m_File) != ipLen || fread(record.key.ip2, 1, ipLen, m_File) != ipLen ||
+		    fread(startTime, 1, sizeof(startTime), m_File) != sizeof(startTime) || !readVarInt(duration) ||
+		    !readVarInt(record.packets[0]) || !readVarInt(record.packets[1]) || !readVarInt(record.bytes[0]) ||
+		    !readVarInt(record.bytes[1]))
+		{
+			PCPP_LOG_ERROR("Flow record file '" << m_FileName << "' is truncated");
+			return false;
+		}
+
+		for (int i = 7; i >= 0; i--)
+			record.startTime = (record.startTime << 8) | startTime[i];
+		record.endTime = record.startTime + duration;
+
+		return true;
+	}
+
+}  // namespace pcpp
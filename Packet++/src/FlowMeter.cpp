@@ -0,0 +1,214 @@
+#define LOG_MODULE PacketLogModuleFlowMeter
+
+#include "FlowMeter.h"
+#include "IPv4Layer.h"
+#include "IPv6Layer.h"
+#include "TcpLayer.h"
+#include "Logger.h"
+#include "EndianPortable.h"
+
+namespace pcpp
+{
+
+	static const uint64_t NanoSecPerSec = 1000000000ULL;
+
+	// TCP flag bits in byte 13 of the TCP header
+	static const uint8_t TcpFlagFin = 0x01;
+	static const uint8_t TcpFlagSyn = 0x02;
+	static const uint8_t TcpFlagRst = 0x04;
+	static const uint8_t TcpFlagAck = 0x10;
+
+	FlowMeter::FlowState::FlowState() : isReversed(false), isEnded(false)
+	{
+		finSeen[0] = finSeen[1] = false;
+		resetCounters();
+	}
+
+	void FlowMeter::FlowState::resetCounters()
+	{
+		tcpFlags[0] = tcpFlags[1] = 0;
+		startTime = endTime = 0;
+		packets[0] = packets[1] = 0;
+		bytes[0] = bytes[1] = 0;
+	}
+
+	FlowMeter::FlowMeter(FlowRecordSink* sink, const FlowMeterConfig& config)
+	    : m_Sink(sink), m_Config(config),
+	      m_ActiveTimeoutNs(static_cast<uint64_t>(config.activeTimeoutSec) * NanoSecPerSec),
+	      m_FlowTable(config.maxFlows, config.idleTimeoutSec, onFlowEvicted, this), m_LastIdleCheck(0)
+	{
+		if (m_Config.batchSize == 0)
+			m_Config.batchSize = 1;
+
+		m_Batch.reserve(m_Config.batchSize);
+		memset(&m_Stats, 0, sizeof(m_Stats));
+	}
+
+	bool FlowMeter::processPacket(RawPacket* rawPacket)
+	{
+		Packet packet(rawPacket, false, UnknownProtocol, OsiModelTransportLayer);
+		return processPacket(packet);
+	}
+
+	bool FlowMeter::processPacket(Packet& packet)
+	{
+		m_Stats.packets++;
+
+		Layer* ipLayer;
+		Layer* transportLayer;
+		FlowKey key;
+		bool isReversed = false;
+		if (!FlowKey::getFlowLayers(packet, ipLayer, transportLayer) ||
+		    !key.fromLayers(ipLayer, transportLayer, &isReversed))
+		{
+			m_Stats.nonIPPackets++;
+			return false;
+		}
+
+		timespec timestamp = packet.getRawPacketReadOnly()->getPacketTimeStamp();
+		uint64_t now = static_cast<uint64_t>(timestamp.tv_sec) * NanoSecPerSec + timestamp.tv_nsec;
+
+		// idle flows are evicted by the flow table only when new flows are created, so check them once a second
+		if (now >= m_LastIdleCheck + NanoSecPerSec)
+		{
+			m_FlowTable.evictIdleFlows(timestamp);
+			m_LastIdleCheck = now;
+		}
+
+		uint64_t ipBytes;
+		if (ipLayer->getProtocol() == IPv4)
+		{
+			ipBytes = be16toh(static_cast<IPv4Layer*>(ipLayer)->getIPv4Header()->totalLength);
+		}
+		else
+		{
+			uint16_t payloadLength = be16toh(static_cast<IPv6Layer*>(ipLayer)->getIPv6Header()->payloadLength);
+			// a payload length of 0 means a jumbo payload
+			ipBytes = payloadLength != 0 ? payloadLength + sizeof(ip6_hdr) : ipLayer->getDataLen();
+		}
+
+		uint8_t tcpFlags = 0;
+		if (transportLayer != nullptr && transportLayer->getProtocol() == TCP)
+			tcpFlags = transportLayer->getData()[13];
+
+		bool isNewFlow = false;
+		FlowState* flow = m_FlowTable.getOrCreateFlow(key, timestamp, &isNewFlow);
+
+		if (!isNewFlow)
+		{
+			if (flow->isEnded && (tcpFlags & (TcpFlagSyn | TcpFlagAck)) == TcpFlagSyn)
+			{
+				// a new connection reuses the 5-tuple of a closed one
+				exportFlow(key, *flow, FlowEndOfFlowDetected);
+				*flow = FlowState();
+				isNewFlow = true;
+			}
+			else if (m_ActiveTimeoutNs != 0 && now >= flow->startTime + m_ActiveTimeoutNs)
+			{
+				exportFlow(key, *flow, FlowEndActiveTimeout);
+				flow->resetCounters();
+				flow->startTime = now;
+			}
+		}
+
+		if (isNewFlow)
+		{
+			flow->isReversed = isReversed;
+			flow->startTime = now;
+			m_Stats.flows++;
+		}
+
+		int direction = (isReversed == flow->isReversed ? 0 : 1);
+		flow->packets[direction]++;
+		flow->bytes[direction] += ipBytes;
+		flow->tcpFlags[direction] |= tcpFlags;
+		if (now > flow->endTime)
+			flow->endTime = now;
+
+		if ((tcpFlags & TcpFlagRst) != 0)
+			flow->isEnded = true;
+
+		if ((tcpFlags & TcpFlagFin) != 0)
+		{
+			flow->finSeen[direction] = true;
+			if (flow->finSeen[0] && flow->finSeen[1])
+				flow->isEnded = true;
+		}
+
+		return true;
+	}
+
+	void FlowMeter::advanceTime(const timespec& now)
+	{
+		m_FlowTable.evictIdleFlows(now);
+		exportBatch();
+	}
+
+	void FlowMeter::flush()
+	{
+		m_FlowTable.clear();
+		exportBatch();
+		if (!m_Sink->flush())
+			m_Stats.exportErrors++;
+	}
+
+	void FlowMeter::onFlowEvicted(const FlowKey& key, FlowState& state, FlowEvictionReason reason, void* userCookie)
+	{
+		FlowMeter* meter = static_cast<FlowMeter*>(userCookie);
+
+		FlowEndReason endReason;
+		switch (reason)
+		{
+		case FlowIdleTimeout:
+			endReason = state.isEnded ? FlowEndOfFlowDetected : FlowEndIdleTimeout;
+			break;
+		case FlowTableFull:
+			endReason = FlowEndLackOfResources;
+			break;
+		default:
+			endReason = FlowEndForcedEnd;
+			break;
+		}
+
+		meter->exportFlow(key, state, endReason);
+	}
+
+	void FlowMeter::exportFlow(const FlowKey& key, const FlowState& state, FlowEndReason reason)
+	{
+		m_Batch.push_back(FlowRecord());
+		FlowRecord& record = m_Batch.back();
+		record.key = key;
+		record.isReversed = state.isReversed;
+		record.endReason = reason;
+		record.startTime = state.startTime;
+		record.endTime = state.endTime;
+		for (int i = 0; i < 2; i++)
+		{
+			record.tcpFlags[i] = state.tcpFlags[i];
+			record.packets[i] = state.packets[i];
+			record.bytes[i] = state.bytes[i];
+		}
+
+		if (m_Batch.size() >= m_Config.batchSize)
+			exportBatch();
+	}
+
+	void FlowMeter::exportBatch()
+	{
+		if (m_Batch.empty())
+			return;
+
+		if (m_Sink->exportRecords(m_Batch.data(), m_Batch.size()))
+		{
+			m_Stats.records += m_Batch.size();
+		}
+		else
+		{
+			PCPP_LOG_ERROR("Failed to export " << m_Batch.size() << " flow records");
+			m_Stats.exportErrors++;
+		}
+
+		m_Batch.clear();
+	}
+
+}  // namespace pcpp
@@ -0,0 +1,318 @@
+#include "FlowTable.h"
+#include "IPv4Layer.h"
+#include "IPv6Layer.h"
+#include "TcpLayer.h"
+#include "UdpLayer.h"
+#include "IpAddress.h"
+#include "GeneralUtils.h"
+
+namespace pcpp
+{
+
+	constexpr size_t FlowKey::MaxStringLength;
+	constexpr size_t FiveTuple::MaxStringLength;
+
+	namespace
+	{
+		// appends to a buffer that is known to be large enough
+		class StringBuilder
+		{
+		public:
+			explicit StringBuilder(char* buffer) : m_Buffer(buffer), m_Len(0)
+			{}
+
+			void append(const char* str)
+			{
+				size_t len = strlen(str);
+				memcpy(m_Buffer + m_Len, str, len);
+				m_Len += len;
+			}
+
+			void appendNumber(unsigned int value)
+			{
+				char digits[10];
+				size_t numOfDigits = 0;
+				do
+				{
+					digits[numOfDigits++] = static_cast<char>('0' + value % 10);
+					value /= 10;
+				} while (value != 0);
+
+				while (numOfDigits > 0)
+					m_Buffer[m_Len++] = digits[--numOfDigits];
+			}
+
+			void appendEndpoint(const uint8_t* ip, uint16_t port, uint8_t ipVersion)
+			{
+				if (ipVersion == 4)
+				{
+					m_Len += IPv4Address(ip).toString(m_Buffer + m_Len, IPv4Address::MaxStringLength + 1);
+				}
+				else
+				{
+					append("[");
+					m_Len += IPv6Address(ip).toString(m_Buffer + m_Len, IPv6Address::MaxStringLength + 1);
+					append("]");
+				}
+
+				append(":");
+				appendNumber(port);
+			}
+
+			size_t getLength() const
+			{
+				return m_Len;
+			}
+
+		private:
+			char* m_Buffer;
+			size_t m_Len;
+		};
+
+		template <size_t MaxStringLength>
+		size_t formatEndpoints(char* buffer, size_t bufferLen, const uint8_t* ip1, uint16_t port1, const uint8_t* ip2,
+		                       uint16_t port2, uint8_t protocol, uint8_t ipVersion, const char* separator)
+		{
+			char localBuffer[MaxStringLength + 1];
+			StringBuilder builder(localBuffer);
+			builder.appendEndpoint(ip1, port1, ipVersion);
+			builder.append(separator);
+			builder.appendEndpoint(ip2, port2, ipVersion);
+			builder.append(" proto ");
+			builder.appendNumber(protocol);
+
+			size_t len = builder.getLength();
+			if (buffer == nullptr || bufferLen <= len)
+				return 0;
+
+			memcpy(buffer, localBuffer, len);
+			buffer[len] = '\0';
+			return len;
+		}
+
+		uint64_t rotateLeft(uint64_t value, int bits)
+		{
+			return (value << bits) | (value >> (64 - bits));
+		}
+
+		uint64_t hashEndpoint(const uint8_t* ip, uint16_t port)
+		{
+			return hashMix128(ip) ^ (static_cast<uint64_t>(port) * 0x9E3779B97F4A7C15ULL);
+		}
+	}  // namespace
+
+	bool FlowKey::getFlowLayers(Packet& packet, Layer*& ipLayer, Layer*& transportLayer)
+	{
+		transportLayer = nullptr;
+		ipLayer = nullptr;
+		for (Layer* layer = packet.getLastLayer(); layer != nullptr; layer = layer->getPrevLayer())
+		{
+			ProtocolType protocol = layer->getProtocol();
+			if (transportLayer == nullptr && (protocol == TCP || protocol == UDP))
+			{
+				transportLayer = layer;
+			}
+			else if (protocol == IPv4 || protocol == IPv6)
+			{
+				ipLayer = layer;
+				break;
+			}
+		}
+
+		return ipLayer != nullptr;
+	}
+
+	bool FlowKey::fromPacket(Packet& packet, bool* isReversed)
+	{
+		Layer* ipLayer;
+		Layer* transportLayer;
+		if (!getFlowLayers(packet, ipLayer, transportLayer))
+			return false;
+
+		return fromLayers(ipLayer, transportLayer, isReversed);
+	}
+
+	bool FlowKey::fromLayers(Layer* ipLayer, Layer* transportLayer, bool* isReversed)
+	{
+		FiveTuple tuple;
+		if (!tuple.fromLayers(ipLayer, transportLayer))
+			return false;
+
+		*this = tuple.toFlowKey(isReversed);
+		return true;
+	}
+
+	uint32_t FlowKey::hash() const
+	{
+		// multiply-xorshift over the key as 8-byte words, sizeof(FlowKey) is a multiple of 8
+		static_assert(sizeof(FlowKey) % sizeof(uint64_t) == 0, "FlowKey size must be a multiple of 8");
+
+		const uint8_t* data = reinterpret_cast<const uint8_t*>(this);
+		uint64_t result = 0x9E3779B97F4A7C15ULL;
+		for (size_t offset = 0; offset < sizeof(FlowKey); offset += sizeof(uint64_t))
+		{
+			uint64_t word;
+			memcpy(&word, data + offset, sizeof(word));
+			result ^= word;
+			result *= 0xFF51AFD7ED558CCDULL;
+			result ^= result >> 32;
+		}
+
+		result *= 0xC4CEB9FE1A85EC53ULL;
+		result ^= result >> 29;
+		return static_cast<uint32_t>(result);
+	}
+
+	std::string FlowKey::toString() const
+	{
+		char buffer[MaxStringLength + 1];
+		size_t len = toString(buffer, sizeof(buffer));
+		return std::string(buffer, len);
+	}
+
+	size_t FlowKey::toString(char* buffer, size_t bufferLen) const
+	{
+		return formatEndpoints<MaxStringLength>(buffer, bufferLen, ip1, port1, ip2, port2, protocol, ipVersion,
+		                                        " <-> ");
+	}
+
+	FiveTuple::FiveTuple(const IPAddress& srcIPAddr, const IPAddress& dstIPAddr, uint16_t srcPortNum,
+	                     uint16_t dstPortNum, uint8_t ipProtocol)
+	{
+		memset(this, 0, sizeof(FiveTuple));
+		if (srcIPAddr.isIPv4())
+		{
+			memcpy(srcIP, srcIPAddr.getIPv4().toBytes(), 4);
+			memcpy(dstIP, dstIPAddr.getIPv4().toBytes(), 4);
+			ipVersion = 4;
+		}
+		else
+		{
+			memcpy(srcIP, srcIPAddr.getIPv6().toBytes(), 16);
+			memcpy(dstIP, dstIPAddr.getIPv6().toBytes(), 16);
+			ipVersion = 6;
+		}
+
+		srcPort = srcPortNum;
+		dstPort = dstPortNum;
+		protocol = ipProtocol;
+	}
+
+	bool FiveTuple::fromPacket(Packet& packet)
+	{
+		Layer* ipLayer;
+		Layer* transportLayer;
+		if (!FlowKey::getFlowLayers(packet, ipLayer, transportLayer))
+			return false;
+
+		return fromLayers(ipLayer, transportLayer);
+	}
+
+	bool FiveTuple::fromLayers(Layer* ipLayer, Layer* transportLayer)
+	{
+		if (ipLayer == nullptr || (ipLayer->getProtocol() != IPv4 && ipLayer->getProtocol() != IPv6))
+			return false;
+
+		memset(this, 0, sizeof(FiveTuple));
+		if (ipLayer->getProtocol() == IPv4)
+		{
+			iphdr* ipHeader = static_cast<IPv4Layer*>(ipLayer)->getIPv4Header();
+			memcpy(srcIP, &ipHeader->ipSrc, 4);
+			memcpy(dstIP, &ipHeader->ipDst, 4);
+			protocol = ipHeader->protocol;
+			ipVersion = 4;
+		}
+		else
+		{
+			ip6_hdr* ipHeader = static_cast<IPv6Layer*>(ipLayer)->getIPv6Header();
+			memcpy(srcIP, ipHeader->ipSrc, 16);
+			memcpy(dstIP, ipHeader->ipDst, 16);
+			protocol = ipHeader->nextHeader;
+			ipVersion = 6;
+		}
+
+		if (transportLayer != nullptr && transportLayer->getProtocol() == TCP)
+		{
+			TcpLayer* tcpLayer = static_cast<TcpLayer*>(transportLayer);
+			srcPort = tcpLayer->getSrcPort();
+			dstPort = tcpLayer->getDstPort();
+			protocol = PACKETPP_IPPROTO_TCP;
+		}
+		else if (transportLayer != nullptr && transportLayer->getProtocol() == UDP)
+		{
+			UdpLayer* udpLayer = static_cast<UdpLayer*>(transportLayer);
+			srcPort = udpLayer->getSrcPort();
+			dstPort = udpLayer->getDstPort();
+			protocol = PACKETPP_IPPROTO_UDP;
+		}
+
+		return true;
+	}
+
+	IPAddress FiveTuple::getSrcIPAddress() const
+	{
+		return ipVersion == 4 ? IPAddress(IPv4Address(srcIP)) : IPAddress(IPv6Address(srcIP));
+	}
+
+	IPAddress FiveTuple::getDstIPAddress() const
+	{
+		return ipVersion == 4 ? IPAddress(IPv4Address(dstIP)) : IPAddress(IPv6Address(dstIP));
+	}
+
+	FiveTuple FiveTuple::reversed() const
+	{
+		FiveTuple result(*this);
+		memcpy(result.srcIP, dstIP, sizeof(srcIP));
+		memcpy(result.dstIP, srcIP, sizeof(dstIP));
+		result.srcPort = dstPort;
+		result.dstPort = srcPort;
+		return result;
+	}
+
+	FlowKey FiveTuple::toFlowKey(bool* isReversed) const
+	{
+		int cmp = memcmp(srcIP, dstIP, sizeof(srcIP));
+		bool reversed = (cmp > 0 || (cmp == 0 && srcPort > dstPort));
+
+		FlowKey key;
+		memcpy(key.ip1, reversed ? dstIP : srcIP, sizeof(key.ip1));
+		memcpy(key.ip2, reversed ? srcIP : dstIP, sizeof(key.ip2));
+		key.port1 = reversed ? dstPort : srcPort;
+		key.port2 = reversed ? srcPort : dstPort;
+		key.protocol = protocol;
+		key.ipVersion = ipVersion;
+
+		if (isReversed != nullptr)
+			*isReversed = reversed;
+
+		return key;
+	}
+
+	uint64_t FiveTuple::hash() const
+	{
+		uint64_t protocolAndVersion = (static_cast<uint64_t>(protocol) << 8) | ipVersion;
+		return hashMix64(hashEndpoint(srcIP, srcPort) ^ rotateLeft(hashEndpoint(dstIP, dstPort), 32) ^
+		                 protocolAndVersion);
+	}
+
+	uint64_t FiveTuple::symmetricHash() const
+	{
+		// addition is commutative, so swapping the endpoints doesn't change the result
+		uint64_t protocolAndVersion = (static_cast<uint64_t>(protocol) << 8) | ipVersion;
+		return hashMix64((hashEndpoint(srcIP, srcPort) + hashEndpoint(dstIP, dstPort)) ^ protocolAndVersion);
+	}
+
+	std::string FiveTuple::toString() const
+	{
+		char buffer[MaxStringLength + 1];
+		size_t len = toString(buffer, sizeof(buffer));
+		return std::string(buffer, len);
+	}
+
+	size_t FiveTuple::toString(char* buffer, size_t bufferLen) const
+	{
+		return formatEndpoints<MaxStringLength>(buffer, bufferLen, srcIP, srcPort, dstIP, dstPort, protocol, ipVersion,
+		                                        " -> ");
+	}
+
+}  // namespace pcpp
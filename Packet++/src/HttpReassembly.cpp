@@ -0,0 +1,753 @@
+#define LOG_MODULE PacketLogModuleHttpReassembly
+
+#include "HttpReassembly.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cctype>
+
+namespace pcpp
+{
+
+	namespace
+	{
+
+		// a buffer with a larger capacity is freed when it's no longer used, so idle connections stay small
+		const size_t MaxIdleBufferCapacity = 1024;
+
+		enum LineStatus
+		{
+			LineComplete,
+			LineIncomplete,
+			LineTooLong
+		};
+
+		inline bool isWhitespace(char c)
+		{
+			return c == ' ' || c == '\t';
+		}
+
+		bool equalsIgnoreCase(const char* str1, const char* str2, size_t len)
+		{
+			for (size_t i = 0; i < len; ++i)
+			{
+				if (::tolower(static_cast<unsigned char>(str1[i])) != ::tolower(static_cast<unsigned char>(str2[i])))
+					return false;
+			}
+
+			return true;
+		}
+
+		void releaseBuffer(std::string& buffer)
+		{
+			if (buffer.capacity() > MaxIdleBufferCapacity)
+				std::string().swap(buffer);
+			else
+				buffer.clear();
+		}
+
+		// return the length of the header including the empty line that ends it, or 0 if the header isn't complete
+		size_t findHeaderEnd(const char* data, size_t dataLen, size_t startOffset)
+		{
+			const char* end = data + dataLen;
+			const char* ptr = data + startOffset;
+			while (ptr < end)
+			{
+				const char* newLine = static_cast<const char*>(memchr(ptr, '\n', end - ptr));
+				if (newLine == nullptr)
+					return 0;
+
+				if (newLine + 1 < end && newLine[1] == '\n')
+					return newLine + 2 - data;
+
+				if (newLine + 2 < end && newLine[1] == '\r' && newLine[2] == '\n')
+					return newLine + 3 - data;
+
+				ptr = newLine + 1;
+			}
+
+			return 0;
+		}
+
+		bool looksLikeMessageStart(const uint8_t* data, size_t dataLen)
+		{
+			const char* text = reinterpret_cast<const char*>(data);
+			if (dataLen >= 5 && memcmp(text, "HTTP/", 5) == 0)
+				return true;
+
+			// the longest method name is 7 characters, look only at the beginning of the data
+			return HttpRequestFirstLine::parseMethod(text, std::min(dataLen, static_cast<size_t>(16))) !=
+			       HttpRequestLayer::HttpMethodUnknown;
+		}
+
+		// parse the hex chunk size at the start of a chunk size line, a chunk extension may follow it
+		bool parseChunkSize(const char* line, size_t lineLen, uint64_t& chunkSize)
+		{
+			chunkSize = 0;
+			size_t i = 0;
+			for (; i < lineLen; ++i)
+			{
+				char c = line[i];
+				uint64_t digit;
+				if (c >= '0' && c <= '9')
+					digit = c - '0';
+				else if (c >= 'a' && c <= 'f')
+					digit = c - 'a' + 10;
+				else if (c >= 'A' && c <= 'F')
+					digit = c - 'A' + 10;
+				else
+					break;
+
+				// chunks larger than 2^60 bytes are surely a parse error
+				if (i >= 15)
+					return false;
+
+				chunkSize = (chunkSize << 4) | digit;
+			}
+
+			if (i == 0)
+				return false;
+
+			for (; i < lineLen; ++i)
+			{
+				if (!isWhitespace(line[i]))
+					return line[i] == ';';
+			}
+
+			return true;
+		}
+
+		// collect a line that may be split between pieces of data. When the line is complete, line and lineLen are set
+		// to the line without its terminator
+		LineStatus readLine(std::string& buffer, const uint8_t* data, size_t dataLen, size_t maxLineLen,
+		                    const char*& line, size_t& lineLen, size_t& consumed)
+		{
+			const char* text = reinterpret_cast<const char*>(data);
+			const char* newLine = static_cast<const char*>(memchr(text, '\n', dataLen));
+			size_t partLen = (newLine != nullptr ? static_cast<size_t>(newLine - text) : dataLen);
+			if (buffer.size() + partLen > maxLineLen)
+				return LineTooLong;
+
+			if (newLine == nullptr)
+			{
+				buffer.append(text, dataLen);
+				consumed = dataLen;
+				return LineIncomplete;
+			}
+
+			consumed = partLen + 1;
+			if (buffer.empty())
+			{
+				line = text;
+				lineLen = partLen;
+			}
+			else
+			{
+				buffer.append(text, partLen);
+				line = buffer.data();
+				lineLen = buffer.size();
+			}
+
+			if (lineLen > 0 && line[lineLen - 1] == '\r')
+				lineLen--;
+
+			return LineComplete;
+		}
+
+		// TcpReassembly adds a "[N bytes missing]" text before data that follows lost data, return its length
+		size_t getMissingDataTextLength(const uint8_t* data, size_t dataLen, size_t missingBytes)
+		{
+			char text[32];
+			int textLen = snprintf(text, sizeof(text), "[%u bytes missing]", static_cast<unsigned int>(missingBytes));
+			if (textLen > 0 && static_cast<size_t>(textLen) <= dataLen && memcmp(data, text, textLen) == 0)
+				return static_cast<size_t>(textLen);
+
+			return 0;
+		}
+
+	}  // namespace
+
+	// -------- Class HttpMessageView -----------------
+
+	HttpMessageView::HttpMessageView()
+	    : m_IsRequest(false), m_Method(HttpRequestLayer::HttpMethodUnknown), m_Uri(nullptr), m_UriLength(0),
+	      m_StatusCode(0), m_Version(HttpVersionUnknown), m_HeaderData(nullptr), m_HeaderLength(0), m_IsChunked(false),
+	      m_ContentLength(-1)
+	{}
+
+	const HttpFieldView* HttpMessageView::getFieldByName(const std::string& name, size_t index) const
+	{
+		for (const HttpFieldView& field : m_Fields)
+		{
+			if (field.nameLength == name.length() && equalsIgnoreCase(field.name, name.c_str(), name.length()))
+			{
+				if (index == 0)
+					return &field;
+
+				index--;
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool HttpMessageView::parse(const char* data, size_t dataLen)
+	{
+		m_HeaderData = data;
+		m_HeaderLength = dataLen;
+		m_Method = HttpRequestLayer::HttpMethodUnknown;
+		m_Uri = nullptr;
+		m_UriLength = 0;
+		m_StatusCode = 0;
+		m_Version = HttpVersionUnknown;
+		m_Fields.clear();
+		m_IsChunked = false;
+		m_ContentLength = -1;
+
+		// the header always ends with an empty line, so the first line is terminated
+		const char* end = data + dataLen;
+		const char* lineEnd = static_cast<const char*>(memchr(data, '\n', dataLen));
+		size_t lineLen = lineEnd - data;
+		if (lineLen > 0 && data[lineLen - 1] == '\r')
+			lineLen--;
+
+		if (lineLen >= 5 && memcmp(data, "HTTP/", 5) == 0)
+		{
+			// status line: "HTTP/x.y SSS reason"
+			m_IsRequest = false;
+			m_Version = HttpResponseFirstLine::parseVersion(data, lineLen);
+			if (lineLen < 12 || data[8] != ' ' || !isdigit(static_cast<unsigned char>(data[9])) ||
+			    !isdigit(static_cast<unsigned char>(data[10])) || !isdigit(static_cast<unsigned char>(data[11])) ||
+			    (lineLen > 12 && data[12] != ' '))
+			{
+				PCPP_LOG_DEBUG("Invalid HTTP status line");
+				return false;
+			}
+
+			m_StatusCode = (data[9] - '0') * 100 + (data[10] - '0') * 10 + (data[11] - '0');
+		}
+		else
+		{
+			// request line: "METHOD uri HTTP/x.y"
+			m_IsRequest = true;
+			m_Method = HttpRequestFirstLine::parseMethod(data, lineLen);
+			if (m_Method == HttpRequestLayer::HttpMethodUnknown)
+			{
+				PCPP_LOG_DEBUG("Invalid HTTP request line");
+				return false;
+			}
+
+			const char* uri = static_cast<const char*>(memchr(data, ' ', lineLen)) + 1;
+			const char* lineStop = data + lineLen;
+			const char* lastSpace = lineStop - 1;
+			while (lastSpace >= uri && *lastSpace != ' ')
+				lastSpace--;
+
+			m_Uri = uri;
+			if (lastSpace < uri)
+			{
+				// an HTTP/0.9 style request line without a version
+				m_UriLength = lineStop - uri;
+			}
+			else
+			{
+				m_UriLength = lastSpace - uri;
+				m_Version = HttpResponseFirstLine::parseVersion(lastSpace + 1, lineStop - lastSpace - 1);
+			}
+		}
+
+		for (const char* line = lineEnd + 1; line < end;)
+		{
+			lineEnd = static_cast<const char*>(memchr(line, '\n', end - line));
+			if (lineEnd == nullptr)
+				break;
+
+			const char* nextLine = lineEnd + 1;
+			if (lineEnd > line && lineEnd[-1] == '\r')
+				lineEnd--;
+
+			// the empty line that ends the header
+			if (lineEnd == line)
+				break;
+
+			// continuation lines of the obsolete line folding and lines without a separator are ignored
+			const char* separator =
+			    isWhitespace(*line) ? nullptr : static_cast<const char*>(memchr(line, ':', lineEnd - line));
+			if (separator != nullptr)
+			{
+				const char* value = separator + 1;
+				const char* valueEnd = lineEnd;
+				while (value < valueEnd && isWhitespace(*value))
+					value++;
+				while (valueEnd > value && isWhitespace(valueEnd[-1]))
+					valueEnd--;
+
+				HttpFieldView field = { line, static_cast<size_t>(separator - line), value,
+					                    static_cast<size_t>(valueEnd - value) };
+				m_Fields.push_back(field);
+			}
+
+			line = nextLine;
+		}
+
+		const size_t transferEncodingLen = sizeof(PCPP_HTTP_TRANSFER_ENCODING_FIELD) - 1;
+		const size_t contentLengthLen = sizeof(PCPP_HTTP_CONTENT_LENGTH_FIELD) - 1;
+		for (const HttpFieldView& field : m_Fields)
+		{
+			if (field.nameLength == transferEncodingLen &&
+			    equalsIgnoreCase(field.name, PCPP_HTTP_TRANSFER_ENCODING_FIELD, transferEncodingLen))
+			{
+				// the body is chunked only if chunked is the last transfer coding
+				m_IsChunked =
+				    field.valueLength >= 7 && equalsIgnoreCase(field.value + field.valueLength - 7, "chunked", 7);
+			}
+			else if (field.nameLength == contentLengthLen &&
+			         equalsIgnoreCase(field.name, PCPP_HTTP_CONTENT_LENGTH_FIELD, contentLengthLen))
+			{
+				if (field.valueLength == 0 || field.valueLength > 18)
+					return false;
+
+				int64_t contentLength = 0;
+				for (size_t i = 0; i < field.valueLength; ++i)
+				{
+					if (!isdigit(static_cast<unsigned char>(field.value[i])))
+						return false;
+					contentLength = contentLength * 10 + (field.value[i] - '0');
+				}
+
+				// different Content-Length values make the message length ambiguous
+				if (m_ContentLength != -1 && m_ContentLength != contentLength)
+					return false;
+
+				m_ContentLength = contentLength;
+			}
+		}
+
+		return true;
+	}
+
+	// -------- Class HttpReassembly -----------------
+
+	HttpReassembly::StreamState::StreamState() : state(MessageStart), remaining(0)
+	{
+		memset(&message, 0, sizeof(message));
+	}
+
+	HttpReassembly::ConnectionState::ConnectionState() : firstPendingMethod(0), numOfPendingMethods(0), isTunnel(false)
+	{
+		memset(pendingMethods, 0, sizeof(pendingMethods));
+	}
+
+	HttpReassembly::HttpReassembly(OnHttpMessageHeaders onMessageHeaders, OnHttpBodyData onBodyData,
+	                               OnHttpMessageEnd onMessageEnd, void* userCookie,
+	                               const HttpReassemblyConfiguration& config)
+	    : m_OnMessageHeaders(onMessageHeaders), m_OnBodyData(onBodyData), m_OnMessageEnd(onMessageEnd),
+	      m_UserCookie(userCookie), m_Config(config)
+	{
+		memset(&m_Stats, 0, sizeof(m_Stats));
+	}
+
+	void HttpReassembly::onTcpMessageReady(int8_t side, const TcpStreamData& tcpData, void* userCookie)
+	{
+		static_cast<HttpReassembly*>(userCookie)->processTcpData(side, tcpData);
+	}
+
+	void HttpReassembly::onTcpConnectionEnd(const ConnectionData& connectionData,
+	                                        TcpReassembly::ConnectionEndReason reason, void* userCookie)
+	{
+		static_cast<HttpReassembly*>(userCookie)
+		    ->closeConnection(connectionData, reason == TcpReassembly::TcpReassemblyConnectionClosedByFIN_RST);
+	}
+
+	void HttpReassembly::processTcpData(int8_t side, const TcpStreamData& tcpData)
+	{
+		if (side != 0 && side != 1)
+			return;
+
+		const ConnectionData& connectionData = tcpData.getConnectionData();
+		auto iter = m_Connections.find(connectionData.flowKey);
+		if (iter == m_Connections.end())
+		{
+			if (m_Config.maxConnections != 0 && m_Connections.size() >= m_Config.maxConnections)
+			{
+				m_Stats.ignoredTcpData++;
+				return;
+			}
+
+			iter = m_Connections.emplace(connectionData.flowKey, ConnectionState()).first;
+		}
+
+		ConnectionState& connection = iter->second;
+		const uint8_t* data = tcpData.getData();
+		size_t dataLen = tcpData.getDataLength();
+
+		if (tcpData.isBytesMissing())
+		{
+			size_t textLen = getMissingDataTextLength(data, dataLen, tcpData.getMissingByteCount());
+			data += textLen;
+			dataLen -= textLen;
+			skipMissingData(connection, side, tcpData.getMissingByteCount(), data, dataLen, connectionData);
+		}
+		else if (connection.sides[side].state == NotHttp && !connection.isTunnel &&
+		         looksLikeMessageStart(data, dataLen))
+		{
+			// resume after a parse error at data that starts a new message
+			connection.sides[side].state = MessageStart;
+		}
+
+		processData(connection, side, data, dataLen, connectionData);
+	}
+
+	void HttpReassembly::closeConnection(const ConnectionData& connectionData, bool isClosedByFinRst)
+	{
+		auto iter = m_Connections.find(connectionData.flowKey);
+		if (iter == m_Connections.end())
+			return;
+
+		ConnectionState& connection = iter->second;
+		for (int8_t side = 0; side < 2; side++)
+		{
+			if (connection.sides[side].state == BodyUntilClose && isClosedByFinRst)
+				endMessage(connection, side, connectionData);
+			else
+				abortMessage(connection, side, connectionData);
+		}
+
+		m_Connections.erase(iter);
+	}
+
+	void HttpReassembly::processData(ConnectionState& connection, int8_t side, const uint8_t* data, size_t dataLen,
+	                                 const ConnectionData& connectionData)
+	{
+		StreamState& stream = connection.sides[side];
+
+		while (dataLen > 0)
+		{
+			size_t consumed = dataLen;
+
+			switch (stream.state)
+			{
+			case MessageStart:
+			{
+				consumed = processHeader(connection, side, data, dataLen, connectionData);
+				break;
+			}
+
+			case BodyWithLength:
+			case ChunkData:
+			case BodyUntilClose:
+			{
+				if (stream.state != BodyUntilClose && stream.remaining < consumed)
+					consumed = static_cast<size_t>(stream.remaining);
+
+				if (m_OnBodyData != nullptr)
+					m_OnBodyData(side, data, consumed, connectionData, m_UserCookie);
+
+				stream.message.bodyLength += consumed;
+				if (stream.state == BodyUntilClose)
+					break;
+
+				stream.remaining -= consumed;
+				if (stream.remaining == 0)
+				{
+					if (stream.state == BodyWithLength)
+						endMessage(connection, side, connectionData);
+					else
+						stream.state = ChunkDataEnd;
+				}
+				break;
+			}
+
+			case ChunkSize:
+			case ChunkDataEnd:
+			case ChunkTrailer:
+			{
+				const char* line = nullptr;
+				size_t lineLen = 0;
+				LineStatus status =
+				    readLine(stream.buffer, data, dataLen, m_Config.maxHeaderSize, line, lineLen, consumed);
+				if (status == LineIncomplete)
+					break;
+
+				if (status == LineTooLong)
+				{
+					setParseError(connection, side, connectionData);
+					consumed = dataLen;
+					break;
+				}
+
+				bool isValid = true;
+				bool isMessageEnd = false;
+				if (stream.state == ChunkSize)
+				{
+					uint64_t chunkSize = 0;
+					isValid = parseChunkSize(line, lineLen, chunkSize);
+					stream.remaining = chunkSize;
+					stream.state = (chunkSize == 0 ? ChunkTrailer : ChunkData);
+				}
+				else if (stream.state == ChunkDataEnd)
+				{
+					// chunk data must be followed by CRLF
+					isValid = (lineLen == 0);
+					stream.state = ChunkSize;
+				}
+				else
+				{
+					// trailer fields are ignored, the message ends at an empty line
+					isMessageEnd = (lineLen == 0);
+				}
+
+				stream.buffer.clear();
+
+				if (!isValid)
+				{
+					setParseError(connection, side, connectionData);
+					consumed = dataLen;
+				}
+				else if (isMessageEnd)
+				{
+					endMessage(connection, side, connectionData);
+				}
+				break;
+			}
+
+			case NotHttp:
+				break;
+			}
+
+			data += consumed;
+			dataLen -= consumed;
+		}
+	}
+
+	size_t HttpReassembly::processHeader(ConnectionState& connection, int8_t side, const uint8_t* data,
+	                                     size_t dataLen, const ConnectionData& connectionData)
+	{
+		StreamState& stream = connection.sides[side];
+		const char* text = reinterpret_cast<const char*>(data);
+
+		if (stream.buffer.empty())
+		{
+			// skip empty lines between messages
+			size_t emptyLinesLen = 0;
+			while (emptyLinesLen < dataLen && (text[emptyLinesLen] == '\r' || text[emptyLinesLen] == '\n'))
+				emptyLinesLen++;
+
+			if (emptyLinesLen > 0)
+				return emptyLinesLen;
+
+			// the whole header is in this piece of data, parse it without copying
+			size_t headerLen = findHeaderEnd(text, dataLen, 0);
+			if (headerLen != 0)
+			{
+				if (headerLen > m_Config.maxHeaderSize ||
+				    !startMessage(connection, side, text, headerLen, connectionData))
+				{
+					setParseError(connection, side, connectionData);
+					return dataLen;
+				}
+
+				return headerLen;
+			}
+		}
+
+		size_t prevLen = stream.buffer.size();
+		size_t appendLen = std::min(dataLen, m_Config.maxHeaderSize - prevLen);
+		stream.buffer.append(text, appendLen);
+
+		// the end of the header may start in the previous piece of data
+		size_t headerLen = findHeaderEnd(stream.buffer.data(), stream.buffer.size(), prevLen >= 3 ? prevLen - 3 : 0);
+		if (headerLen == 0)
+		{
+			if (stream.buffer.size() >= m_Config.maxHeaderSize)
+			{
+				PCPP_LOG_DEBUG("HTTP header is larger than " << m_Config.maxHeaderSize << " bytes");
+				setParseError(connection, side, connectionData);
+				return dataLen;
+			}
+
+			return appendLen;
+		}
+
+		if (!startMessage(connection, side, stream.buffer.data(), headerLen, connectionData))
+		{
+			setParseError(connection, side, connectionData);
+			return dataLen;
+		}
+
+		return headerLen - prevLen;
+	}
+
+	bool HttpReassembly::startMessage(ConnectionState& connection, int8_t side, const char* header, size_t headerLen,
+	                                  const ConnectionData& connectionData)
+	{
+		HttpMessageView& view = m_MessageView;
+		if (!view.parse(header, headerLen))
+			return false;
+
+		// the state to move to after the header, MessageStart means the message has no body
+		ParseState bodyState = MessageStart;
+
+		if (view.m_IsRequest)
+		{
+			m_Stats.requests++;
+			if (connection.numOfPendingMethods < MaxPendingRequests)
+			{
+				size_t index = (connection.firstPendingMethod + connection.numOfPendingMethods) % MaxPendingRequests;
+				connection.pendingMethods[index] = static_cast<uint8_t>(view.m_Method);
+				connection.numOfPendingMethods++;
+			}
+
+			if (view.m_IsChunked)
+				bodyState = ChunkSize;
+			else if (view.m_ContentLength > 0)
+				bodyState = BodyWithLength;
+		}
+		else
+		{
+			m_Stats.responses++;
+
+			// 1xx responses are interim, the final response to the same request follows them
+			bool isFinalResponse = (view.m_StatusCode >= 200 || view.m_StatusCode == 101);
+			if (connection.numOfPendingMethods > 0)
+			{
+				view.m_Method =
+				    static_cast<HttpRequestLayer::HttpMethod>(connection.pendingMethods[connection.firstPendingMethod]);
+				if (isFinalResponse)
+				{
+					connection.firstPendingMethod = (connection.firstPendingMethod + 1) % MaxPendingRequests;
+					connection.numOfPendingMethods--;
+				}
+			}
+
+			if (view.m_StatusCode == 101 ||
+			    (view.m_Method == HttpRequestLayer::HttpCONNECT && view.m_StatusCode / 100 == 2))
+			{
+				connection.isTunnel = true;
+			}
+			else if (view.m_StatusCode >= 200 && view.m_StatusCode != 204 && view.m_StatusCode != 304 &&
+			         view.m_Method != HttpRequestLayer::HttpHEAD)
+			{
+				if (view.m_IsChunked)
+					bodyState = ChunkSize;
+				else if (view.m_ContentLength > 0)
+					bodyState = BodyWithLength;
+				else if (view.m_ContentLength < 0)
+					bodyState = BodyUntilClose;
+			}
+		}
+
+		StreamState& stream = connection.sides[side];
+		stream.message.isRequest = view.m_IsRequest;
+		stream.message.method = view.m_Method;
+		stream.message.statusCode = view.m_StatusCode;
+		stream.message.version = view.m_Version;
+		stream.message.headerLength = headerLen;
+		stream.message.bodyLength = 0;
+		stream.message.isComplete = true;
+
+		if (m_OnMessageHeaders != nullptr)
+			m_OnMessageHeaders(side, view, connectionData, m_UserCookie);
+
+		releaseBuffer(stream.buffer);
+
+		if (connection.isTunnel)
+		{
+			// the other side stops being HTTP too, unless it's in the middle of a message
+			StreamState& otherStream = connection.sides[1 - side];
+			if (otherStream.state == MessageStart)
+			{
+				releaseBuffer(otherStream.buffer);
+				otherStream.state = NotHttp;
+			}
+		}
+
+		if (bodyState == MessageStart)
+		{
+			endMessage(connection, side, connectionData);
+		}
+		else
+		{
+			stream.state = bodyState;
+			stream.remaining = (bodyState == BodyWithLength ? static_cast<uint64_t>(view.m_ContentLength) : 0);
+		}
+
+		return true;
+	}
+
+	void HttpReassembly::endMessage(ConnectionState& connection, int8_t side, const ConnectionData& connectionData)
+	{
+		StreamState& stream = connection.sides[side];
+		if (!stream.message.isComplete)
+			m_Stats.incompleteMessages++;
+
+		if (m_OnMessageEnd != nullptr)
+			m_OnMessageEnd(side, stream.message, connectionData, m_UserCookie);
+
+		stream.state = (connection.isTunnel ? NotHttp : MessageStart);
+		stream.remaining = 0;
+		releaseBuffer(stream.buffer);
+	}
+
+	void HttpReassembly::abortMessage(ConnectionState& connection, int8_t side, const ConnectionData& connectionData)
+	{
+		StreamState& stream = connection.sides[side];
+		if (stream.state != MessageStart && stream.state != NotHttp)
+		{
+			stream.message.isComplete = false;
+			endMessage(connection, side, connectionData);
+		}
+
+		releaseBuffer(stream.buffer);
+	}
+
+	void HttpReassembly::skipMissingData(ConnectionState& connection, int8_t side, size_t missingBytes,
+	                                     const uint8_t* data, size_t dataLen, const ConnectionData& connectionData)
+	{
+		StreamState& stream = connection.sides[side];
+
+		switch (stream.state)
+		{
+		case BodyWithLength:
+		case ChunkData:
+		{
+			// the lost bytes are all in the body, skip them
+			if (missingBytes > stream.remaining)
+				break;
+
+			stream.message.isComplete = false;
+			stream.remaining -= missingBytes;
+			if (stream.remaining == 0)
+			{
+				if (stream.state == BodyWithLength)
+					endMessage(connection, side, connectionData);
+				else
+					stream.state = ChunkDataEnd;
+			}
+			return;
+		}
+
+		case BodyUntilClose:
+		{
+			stream.message.isComplete = false;
+			return;
+		}
+
+		default:
+			break;
+		}
+
+		// the position in the message is lost, resume at the next message if this data starts one
+		abortMessage(connection, side, connectionData);
+		stream.state = (!connection.isTunnel && looksLikeMessageStart(data, dataLen) ? MessageStart : NotHttp);
+	}
+
+	void HttpReassembly::setParseError(ConnectionState& connection, int8_t side, const ConnectionData& connectionData)
+	{
+		m_Stats.parseErrors++;
+		abortMessage(connection, side, connectionData);
+		connection.sides[side].state = NotHttp;
+	}
+
+}  // namespace pcpp
@@ -5,682 +5,714 @@
 #include "IPv6Layer.h"
 #include "PacketUtils.h"
 #include "Logger.h"
+#include "Instrumentation.h"
 #include "EndianPortable.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
 
 namespace pcpp
 {
 
-	uint32_t IPReassemblyHashPacket(IPv4Layer* ipv4Layer)
+	namespace
 	{
-		ScalarBuffer<uint8_t> vec[3];
+		constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
 
-		vec[0].buffer = (uint8_t*)&ipv4Layer->getIPv4Header()->ipSrc;
-		vec[0].len = 4;
-		vec[1].buffer = (uint8_t*)&ipv4Layer->getIPv4Header()->ipDst;
-		vec[1].len = 4;
-		vec[2].buffer = (uint8_t*)&ipv4Layer->getIPv4Header()->ipId;
-		vec[2].len = 2;
+		// the end of the last hole before the last fragment arrives
+		constexpr size_t UnknownEnd = std::numeric_limits<size_t>::max();
 
-		return pcpp::fnvHash(vec, 3);
-	}
+		// the IPv4 total length and IPv6 payload length fields are 16-bit
+		constexpr size_t MaxLengthFieldValue = 0xffff;
 
-	uint32_t IPReassemblyHashBy3Tuple(const IPv4Address& ipSrc, const IPv4Address& ipDst, uint16_t ipID)
-	{
-		ScalarBuffer<uint8_t> vec[3];
+		constexpr size_t MinNumOfBuckets = 16;
+
+		void placeInBuckets(std::vector<uint32_t>& buckets, uint32_t index, uint32_t hash)
+		{
+			size_t mask = buckets.size() - 1;
+			size_t bucket = hash & mask;
+			while (buckets[bucket] != InvalidIndex)
+			{
+				bucket = (bucket + 1) & mask;
+			}
 
-		uint16_t ipIdNetworkOrder = htobe16(ipID);
-		uint32_t ipSrcAsInt = ipSrc.toInt();
-		uint32_t ipDstAsInt = ipDst.toInt();
+			buckets[bucket] = index;
+		}
 
-		vec[0].buffer = (uint8_t*)&ipSrcAsInt;
-		vec[0].len = 4;
-		vec[1].buffer = (uint8_t*)&ipDstAsInt;
-		vec[1].len = 4;
-		vec[2].buffer = (uint8_t*)&ipIdNetworkOrder;
-		vec[2].len = 2;
+		// the longest payload a reassembled packet can have so its length field doesn't overflow. The IPv4 total length
+		// includes the IP header, and the IPv6 payload length includes the extension headers
+		size_t getMaxPayloadLength(ProtocolType protocol, size_t ipHeaderLen)
+		{
+			size_t lengthFieldHeaderLen = (protocol == IPv4 ? ipHeaderLen : ipHeaderLen - sizeof(ip6_hdr));
+			return lengthFieldHeaderLen < MaxLengthFieldValue ? MaxLengthFieldValue - lengthFieldHeaderLen : 0;
+		}
+	}  // namespace
 
-		return pcpp::fnvHash(vec, 3);
+	uint32_t IPReassembly::IPv4PacketKey::getHashValue() const
+	{
+		FragmentKey key;
+		createFragmentKey(*this, key);
+		return hashFragmentKey(key);
 	}
 
-	class IPFragmentWrapper
+	uint32_t IPReassembly::IPv6PacketKey::getHashValue() const
 	{
-	public:
-		virtual bool isFragment() = 0;
-		virtual bool isFirstFragment() = 0;
-		virtual bool isLastFragment() = 0;
-		virtual uint16_t getFragmentOffset() = 0;
-		virtual uint32_t getFragmentId() = 0;
-		virtual uint32_t hashPacket() = 0;
-		virtual IPReassembly::PacketKey* createPacketKey() = 0;
-
-		virtual uint8_t* getIPLayerPayload() = 0;
-		virtual size_t getIPLayerPayloadSize() = 0;
-
-		virtual ~IPFragmentWrapper()
-		{}
-
-	protected:
-		IPFragmentWrapper()
-		{}
-	};
-
-	class IPv4FragmentWrapper : public IPFragmentWrapper
+		FragmentKey key;
+		createFragmentKey(*this, key);
+		return hashFragmentKey(key);
+	}
+
+	bool IPReassembly::FragmentKey::operator==(const FragmentKey& other) const
 	{
-	public:
-		explicit IPv4FragmentWrapper(Packet* fragment)
-		{
-			m_IPLayer = fragment->isPacketOfType(IPv4) ? fragment->getLayerOfType<IPv4Layer>() : nullptr;
-		}
+		return fragmentID == other.fragmentID && protocol == other.protocol &&
+		       memcmp(srcIP, other.srcIP, sizeof(srcIP)) == 0 && memcmp(dstIP, other.dstIP, sizeof(dstIP)) == 0;
+	}
 
-		// implement abstract methods
+	IPReassembly::IPReassembly(OnFragmentsClean onFragmentsCleanCallback, void* callbackUserCookie,
+	                           size_t maxPacketsToStore)
+	    : m_FreeEntries(InvalidIndex), m_LruHead(InvalidIndex), m_LruTail(InvalidIndex), m_NumOfEntries(0),
+	      m_MaxPacketsToStore(maxPacketsToStore), m_MaxMemoryUsage(0), m_CurrentMemoryUsage(0),
+	      m_FragmentTimeoutSec(0), m_Statistics(), m_OnFragmentsCleanCallback(onFragmentsCleanCallback),
+	      m_CallbackUserCookie(callbackUserCookie)
+	{}
 
-		bool isFragment() override
-		{
-			return m_IPLayer->isFragment();
-		}
+	Packet* IPReassembly::processPacket(Packet* fragment, ReassemblyStatus& status, ProtocolType parseUntil,
+	                                    OsiModelLayer parseUntilLayer)
+	{
+		status = NON_IP_PACKET;
 
-		bool isFirstFragment() override
-		{
-			return m_IPLayer->isFirstFragment();
-		}
+		FragmentKey key;
+		memset(&key, 0, sizeof(key));
+		Layer* ipLayer = nullptr;
+		bool isFirstFragment = false;
+		bool isLastFragment = false;
+		size_t fragOffset = 0;
 
-		bool isLastFragment() override
+		if (fragment->isPacketOfType(IPv4))
 		{
-			return m_IPLayer->isLastFragment();
-		}
+			IPv4Layer* ipv4Layer = fragment->getLayerOfType<IPv4Layer>();
+			iphdr* ipHeader = ipv4Layer->getIPv4Header();
 
-		uint16_t getFragmentOffset() override
-		{
-			return m_IPLayer->getFragmentOffset();
-		}
+			// packet is not a fragment
+			if (!ipv4Layer->isFragment())
+			{
+				PCPP_LOG_DEBUG("Got a non fragment packet with FragID=0x" << std::hex << be16toh(ipHeader->ipId)
+				                                                          << ", returning packet to user");
+				status = NON_FRAGMENT;
+				return fragment;
+			}
 
-		uint32_t getFragmentId() override
-		{
-			return (uint32_t)be16toh(m_IPLayer->getIPv4Header()->ipId);
+			memcpy(key.srcIP, &ipHeader->ipSrc, sizeof(ipHeader->ipSrc));
+			memcpy(key.dstIP, &ipHeader->ipDst, sizeof(ipHeader->ipDst));
+			key.fragmentID = be16toh(ipHeader->ipId);
+			key.protocol = IPv4;
+			isFirstFragment = ipv4Layer->isFirstFragment();
+			isLastFragment = ipv4Layer->isLastFragment();
+			fragOffset = ipv4Layer->getFragmentOffset();
+			ipLayer = ipv4Layer;
 		}
-
-		uint32_t hashPacket() override
+		else if (fragment->isPacketOfType(IPv6))
 		{
-			ScalarBuffer<uint8_t> vec[3];
+			IPv6Layer* ipv6Layer = fragment->getLayerOfType<IPv6Layer>();
+			IPv6FragmentationHeader* fragHeader = ipv6Layer->getExtensionOfType<IPv6FragmentationHeader>();
 
-			vec[0].buffer = (uint8_t*)&m_IPLayer->getIPv4Header()->ipSrc;
-			vec[0].len = 4;
-			vec[1].buffer = (uint8_t*)&m_IPLayer->getIPv4Header()->ipDst;
-			vec[1].len = 4;
-			vec[2].buffer = (uint8_t*)&m_IPLayer->getIPv4Header()->ipId;
-			vec[2].len = 2;
+			// packet is not a fragment
+			if (fragHeader == nullptr)
+			{
+				PCPP_LOG_DEBUG("Got a non fragment IPv6 packet, returning packet to user");
+				status = NON_FRAGMENT;
+				return fragment;
+			}
 
-			return pcpp::fnvHash(vec, 3);
+			memcpy(key.srcIP, ipv6Layer->getIPv6Header()->ipSrc, sizeof(key.srcIP));
+			memcpy(key.dstIP, ipv6Layer->getIPv6Header()->ipDst, sizeof(key.dstIP));
+			key.fragmentID = be32toh(fragHeader->getFragHeader()->id);
+			key.protocol = IPv6;
+			isFirstFragment = fragHeader->isFirstFragment();
+			isLastFragment = fragHeader->isLastFragment();
+			fragOffset = fragHeader->getFragmentOffset();
+			ipLayer = ipv6Layer;
 		}
-
-		IPReassembly::PacketKey* createPacketKey() override
+		else
 		{
-			return new IPReassembly::IPv4PacketKey(be16toh(m_IPLayer->getIPv4Header()->ipId),
-			                                       m_IPLayer->getSrcIPv4Address(), m_IPLayer->getDstIPv4Address());
+			// packet is not an IP packet
+			PCPP_LOG_DEBUG("Got a non-IP packet, returning packet to user");
+			return fragment;
 		}
 
-		uint8_t* getIPLayerPayload() override
+		RawPacket* fragmentRawPacket = fragment->getRawPacket();
+		timespec timestamp = fragmentRawPacket->getPacketTimeStamp();
+
+		if (m_FragmentTimeoutSec > 0)
 		{
-			return m_IPLayer->getLayerPayload();
+			dropExpiredEntries(timestamp.tv_sec);
 		}
 
-		size_t getIPLayerPayloadSize() override
+		uint32_t hash = hashFragmentKey(key);
+		uint32_t index = findEntry(key, hash);
+
+		// this is the first fragment seen for this packet
+		if (index == InvalidIndex)
+		{
+			PCPP_LOG_DEBUG("Got new packet with FragID=0x" << std::hex << key.fragmentID
+			                                               << ", allocating place in table");
+			index = createEntry(key, hash);
+		}
+		else
 		{
-			return m_IPLayer->getLayerPayloadSize();
+			// mark this packet as used
+			moveToLruHead(index);
 		}
 
-	private:
-		IPv4Layer* m_IPLayer;
-	};
+		IPFragmentData& fragData = m_Entries[index];
+		fragData.lastSeenSec = timestamp.tv_sec;
 
-	class IPv6FragmentWrapper : public IPFragmentWrapper
-	{
-	public:
-		explicit IPv6FragmentWrapper(Packet* fragment)
+		if (isFirstFragment && fragData.gotFirstFragment)
 		{
-			m_IPLayer = fragment->isPacketOfType(IPv6) ? fragment->getLayerOfType<IPv6Layer>() : nullptr;
-			if (m_IPLayer != nullptr)
-				m_FragHeader = m_IPLayer->getExtensionOfType<IPv6FragmentationHeader>();
-			else
-				m_FragHeader = nullptr;
+			PCPP_LOG_DEBUG("[FragID=0x" << std::hex << key.fragmentID << "] Got duplicated first fragment");
+			m_Statistics.duplicateFragments++;
+			status = FRAGMENT;
+			return nullptr;
 		}
 
-		// implement abstract methods
+		uint8_t* payload = ipLayer->getLayerPayload();
+		size_t payloadLen = ipLayer->getLayerPayloadSize();
+		size_t fragEnd = fragOffset + payloadLen;
+		size_t maxPayloadLen = getMaxPayloadLength(key.protocol, payload - ipLayer->getData());
 
-		bool isFragment() override
+		// the reassembled packet length must fit in the IP length field, the fragment must not end beyond the last
+		// fragment, and the last fragment must not end before data that was already received
+		if (fragEnd > maxPayloadLen || (fragData.gotLastFragment && fragEnd > fragData.payload.size()) ||
+		    (isLastFragment && fragEnd < fragData.payload.size()))
 		{
-			return (m_FragHeader != nullptr);
+			PCPP_LOG_DEBUG("[FragID=0x" << std::hex << key.fragmentID << "] Fragment with offset " << std::dec
+			                            << fragOffset << " and length " << payloadLen << " is malformed");
+			m_Statistics.malformedFragments++;
+			status = MALFORMED_FRAGMENT;
+			return nullptr;
 		}
 
-		bool isFirstFragment() override
+		// copy only data from the beginning of the first fragment to the IP layer payload. Data beyond the payload such
+		// as packet trailer isn't copied
+		size_t headerLen = isFirstFragment ? payload - fragmentRawPacket->getRawData() : 0;
+		size_t payloadGrowth = fragEnd > fragData.payload.size() ? fragEnd - fragData.payload.size() : 0;
+		if (!reserveMemory(index, headerLen + payloadGrowth))
 		{
-			if (isFragment())
-				return m_FragHeader->isFirstFragment();
-
-			return false;
+			PCPP_LOG_DEBUG("[FragID=0x" << std::hex << key.fragmentID
+			                            << "] Packet exceeds the memory limit by itself, dropped it");
+			status = FRAGMENT;
+			return nullptr;
 		}
 
-		bool isLastFragment() override
+		size_t currentOffset = fragData.holes.empty() ? fragData.payload.size() : fragData.holes.front().start;
+
+		if (isFirstFragment)
 		{
-			if (isFragment())
-				return m_FragHeader->isLastFragment();
+			PCPP_LOG_DEBUG("[FragID=0x" << std::hex << key.fragmentID << "] Got first fragment");
 
-			return false;
+			fragData.headerData.assign(fragmentRawPacket->getRawData(), fragmentRawPacket->getRawData() + headerLen);
+			fragData.ipHeaderOffset = ipLayer->getData() - fragmentRawPacket->getRawData();
+			fragData.timestamp = timestamp;
+			fragData.linkLayerType = fragmentRawPacket->getLinkLayerType();
+			fragData.gotFirstFragment = true;
+			status = FIRST_FRAGMENT;
 		}
-
-		uint16_t getFragmentOffset() override
+		// if current fragment offset is larger than expected - this means this fragment is out-of-order
+		else if (fragOffset > currentOffset)
 		{
-			if (isFragment())
-				return m_FragHeader->getFragmentOffset();
-
-			return 0;
+			PCPP_LOG_DEBUG("[FragID=0x" << std::hex << key.fragmentID << "] Got out-of-ordered fragment with offset "
+			                            << std::dec << fragOffset << " (expected: " << currentOffset << ")");
+			status = OUT_OF_ORDER_FRAGMENT;
 		}
+		else
+		{
+			PCPP_LOG_DEBUG("[FragID=0x" << std::hex << key.fragmentID << "] Got fragment with offset " << std::dec
+			                            << fragOffset);
+			status = FRAGMENT;
+		}
+
+		addFragmentData(index, fragOffset, payload, payloadLen, isLastFragment);
 
-		uint32_t getFragmentId() override
+		if (!fragData.gotFirstFragment || !fragData.gotLastFragment || !fragData.holes.empty())
 		{
-			return be32toh(m_FragHeader->getFragHeader()->id);
+			return nullptr;
 		}
 
-		uint32_t hashPacket() override
+		// the IP header of the first fragment may be longer than the headers of the fragments checked before it arrived
+		if (fragData.payload.size() > getMaxPayloadLength(key.protocol, fragData.headerData.size() -
+		                                                                    fragData.ipHeaderOffset))
 		{
-			if (m_FragHeader == nullptr)
-				return 0;
+			PCPP_LOG_DEBUG("[FragID=0x" << std::hex << key.fragmentID << "] Reassembled packet length "
+			                            << std::dec << fragData.payload.size() << " exceeds the IP length field");
+			releaseEntry(index);
+			m_Statistics.malformedFragments++;
+			status = MALFORMED_FRAGMENT;
+			return nullptr;
+		}
 
-			ScalarBuffer<uint8_t> vec[3];
+		PCPP_LOG_DEBUG("[FragID=0x" << std::hex << key.fragmentID
+		                            << "] Reassembly process completed, allocating a packet and returning it");
 
-			vec[0].buffer = m_IPLayer->getIPv6Header()->ipSrc;
-			vec[0].len = 16;
-			vec[1].buffer = m_IPLayer->getIPv6Header()->ipDst;
-			vec[1].len = 16;
-			vec[2].buffer = (uint8_t*)&m_FragHeader->getFragHeader()->id;
-			vec[2].len = 4;
+		Packet* reassembledPacket = createPacket(fragData, fragData.payload.size(), parseUntil, parseUntilLayer);
+		releaseEntry(index);
+		m_Statistics.packetsReassembled++;
+		status = REASSEMBLED;
+		return reassembledPacket;
+	}
 
-			return pcpp::fnvHash(vec, 3);
-		}
+	Packet* IPReassembly::processPacket(RawPacket* fragment, ReassemblyStatus& status, ProtocolType parseUntil,
+	                                    OsiModelLayer parseUntilLayer)
+	{
+		Packet* parsedFragment = new Packet(fragment, false, parseUntil, parseUntilLayer);
+		Packet* result = processPacket(parsedFragment, status, parseUntil, parseUntilLayer);
+		if (result != parsedFragment)
+			delete parsedFragment;
 
-		IPReassembly::PacketKey* createPacketKey() override
-		{
-			return new IPReassembly::IPv6PacketKey(be32toh(m_FragHeader->getFragHeader()->id),
-			                                       m_IPLayer->getSrcIPv6Address(), m_IPLayer->getDstIPv6Address());
-		}
+		return result;
+	}
 
-		uint8_t* getIPLayerPayload() override
-		{
-			return m_IPLayer->getLayerPayload();
-		}
+	Packet* IPReassembly::getCurrentPacket(const PacketKey& key)
+	{
+		FragmentKey fragKey;
+		createFragmentKey(key, fragKey);
+		uint32_t index = findEntry(fragKey, hashFragmentKey(fragKey));
 
-		size_t getIPLayerPayloadSize() override
+		// no data is available before the first fragment arrives
+		if (index == InvalidIndex || !m_Entries[index].gotFirstFragment)
 		{
-			return m_IPLayer->getLayerPayloadSize();
+			return nullptr;
 		}
 
-	private:
-		IPv6Layer* m_IPLayer;
-		IPv6FragmentationHeader* m_FragHeader;
-	};
+		// return the data up to the first missing fragment
+		const IPFragmentData& fragData = m_Entries[index];
+		size_t payloadLen = fragData.holes.empty() ? fragData.payload.size() : fragData.holes.front().start;
+		return createPacket(fragData, payloadLen, UnknownProtocol, OsiModelLayerUnknown);
+	}
 
-	uint32_t IPReassembly::IPv4PacketKey::getHashValue() const
+	void IPReassembly::removePacket(const PacketKey& key)
 	{
-		ScalarBuffer<uint8_t> vec[3];
-
-		uint16_t ipIdNetworkOrder = htobe16(m_IpID);
-		uint32_t ipSrcAsInt = m_SrcIP.toInt();
-		uint32_t ipDstAsInt = m_DstIP.toInt();
+		FragmentKey fragKey;
+		createFragmentKey(key, fragKey);
+		uint32_t index = findEntry(fragKey, hashFragmentKey(fragKey));
+		if (index != InvalidIndex)
+		{
+			releaseEntry(index);
+		}
+	}
 
-		vec[0].buffer = (uint8_t*)&ipSrcAsInt;
-		vec[0].len = 4;
-		vec[1].buffer = (uint8_t*)&ipDstAsInt;
-		vec[1].len = 4;
-		vec[2].buffer = (uint8_t*)&ipIdNetworkOrder;
-		vec[2].len = 2;
+	void IPReassembly::resetStatistics()
+	{
+		m_Statistics = Statistics();
+	}
 
-		return pcpp::fnvHash(vec, 3);
+	void IPReassembly::createFragmentKey(const PacketKey& packetKey, FragmentKey& result)
+	{
+		memset(&result, 0, sizeof(result));
+		result.protocol = packetKey.getProtocolType();
+		if (result.protocol == IPv4)
+		{
+			const IPv4PacketKey& ipv4Key = static_cast<const IPv4PacketKey&>(packetKey);
+			memcpy(result.srcIP, ipv4Key.getSrcIP().toBytes(), 4);
+			memcpy(result.dstIP, ipv4Key.getDstIP().toBytes(), 4);
+			result.fragmentID = ipv4Key.getIpID();
+		}
+		else
+		{
+			const IPv6PacketKey& ipv6Key = static_cast<const IPv6PacketKey&>(packetKey);
+			memcpy(result.srcIP, ipv6Key.getSrcIP().toBytes(), 16);
+			memcpy(result.dstIP, ipv6Key.getDstIP().toBytes(), 16);
+			result.fragmentID = ipv6Key.getFragmentID();
+		}
 	}
 
-	uint32_t IPReassembly::IPv6PacketKey::getHashValue() const
+	uint32_t IPReassembly::hashFragmentKey(const FragmentKey& key)
 	{
 		ScalarBuffer<uint8_t> vec[3];
 
-		uint32_t fragIdNetworkOrder = htobe32(m_FragmentID);
-		uint8_t ipSrcAsByteArr[16];
-		uint8_t ipDstAsByteArr[16];
-		m_SrcIP.copyTo(ipSrcAsByteArr);
-		m_DstIP.copyTo(ipDstAsByteArr);
+		// hash the IP addresses and the IP/fragment ID in network order, as they appear in the packet
+		uint16_t ipIdNetworkOrder = htobe16(static_cast<uint16_t>(key.fragmentID));
+		uint32_t fragIdNetworkOrder = htobe32(key.fragmentID);
+		size_t ipAddrLen = key.protocol == IPv4 ? 4 : 16;
 
-		vec[0].buffer = ipSrcAsByteArr;
-		vec[0].len = 16;
-		vec[1].buffer = ipDstAsByteArr;
-		vec[1].len = 16;
-		vec[2].buffer = (uint8_t*)&fragIdNetworkOrder;
-		vec[2].len = 4;
+		vec[0].buffer = const_cast<uint8_t*>(key.srcIP);
+		vec[0].len = ipAddrLen;
+		vec[1].buffer = const_cast<uint8_t*>(key.dstIP);
+		vec[1].len = ipAddrLen;
+		if (key.protocol == IPv4)
+		{
+			vec[2].buffer = reinterpret_cast<uint8_t*>(&ipIdNetworkOrder);
+			vec[2].len = sizeof(ipIdNetworkOrder);
+		}
+		else
+		{
+			vec[2].buffer = reinterpret_cast<uint8_t*>(&fragIdNetworkOrder);
+			vec[2].len = sizeof(fragIdNetworkOrder);
+		}
 
 		return pcpp::fnvHash(vec, 3);
 	}
 
-	IPReassembly::~IPReassembly()
+	uint32_t IPReassembly::findEntry(const FragmentKey& key, uint32_t hash) const
 	{
-		// empty the map - go over all keys, delete all IPFragmentData objects and remove them from the map
-		while (!m_FragmentMap.empty())
+		if (m_Buckets.empty())
 		{
-			delete m_FragmentMap.begin()->second;
-			m_FragmentMap.erase(m_FragmentMap.begin());
+			return InvalidIndex;
 		}
+
+		size_t mask = m_Buckets.size() - 1;
+		for (size_t bucket = hash & mask; m_Buckets[bucket] != InvalidIndex; bucket = (bucket + 1) & mask)
+		{
+			const IPFragmentData& fragData = m_Entries[m_Buckets[bucket]];
+			if (fragData.hash == hash && fragData.key == key)
+			{
+				return m_Buckets[bucket];
+			}
+		}
+
+		return InvalidIndex;
 	}
 
-	Packet* IPReassembly::processPacket(Packet* fragment, ReassemblyStatus& status, ProtocolType parseUntil,
-	                                    OsiModelLayer parseUntilLayer)
+	uint32_t IPReassembly::createEntry(const FragmentKey& key, uint32_t hash)
 	{
-		status = NON_IP_PACKET;
+		// the table is full, remove the least recently used packet
+		if (m_NumOfEntries >= m_MaxPacketsToStore && m_LruTail != InvalidIndex)
+		{
+			PCPP_LOG_DEBUG("Reached maximum packet capacity, removing data for FragID=0x"
+			               << std::hex << m_Entries[m_LruTail].key.fragmentID);
+			dropEntry(m_LruTail, m_Statistics.packetsDroppedCapacity);
+		}
 
-		// packet is not an IP packet
-		if (!fragment->isPacketOfType(IPv4) && !fragment->isPacketOfType(IPv6))
+		// reuse a record of a packet that was reassembled or dropped, along with its buffers
+		uint32_t index;
+		if (m_FreeEntries != InvalidIndex)
 		{
-			PCPP_LOG_DEBUG("Got a non-IP packet, returning packet to user");
-			status = NON_IP_PACKET;
-			return fragment;
+			index = m_FreeEntries;
+			m_FreeEntries = m_Entries[index].lruNext;
+		}
+		else
+		{
+			index = static_cast<uint32_t>(m_Entries.size());
+			m_Entries.emplace_back();
 		}
 
-		// get IPv4 layer
-		// IPv4Layer* ipLayer = fragment->getLayerOfType<IPv4Layer>();
+		IPFragmentData& fragData = m_Entries[index];
+		fragData.key = key;
+		fragData.hash = hash;
+		fragData.gotFirstFragment = false;
+		fragData.gotLastFragment = false;
+		fragData.lastSeenSec = 0;
+		fragData.timestamp = timespec();
+		fragData.linkLayerType = LINKTYPE_ETHERNET;
+		fragData.ipHeaderOffset = 0;
+		fragData.headerData.clear();
+		fragData.payload.clear();
+		fragData.holes.assign(1, { 0, UnknownEnd });
 
-		// create fragment wrapper
-		IPv4FragmentWrapper ipv4Wrapper(fragment);
-		IPv6FragmentWrapper ipv6Wrapper(fragment);
-		IPFragmentWrapper* fragWrapper = nullptr;
-		if (fragment->isPacketOfType(IPv4))
-			fragWrapper = &ipv4Wrapper;
-		else  // fragment->isPacketOfType(IPv6)
-			fragWrapper = &ipv6Wrapper;
+		m_NumOfEntries++;
+		insertToBuckets(index);
 
-		// packet is not a fragment
-		if (!(fragWrapper->isFragment()))
-		{
-			PCPP_LOG_DEBUG("Got a non fragment packet with FragID=0x" << std::hex << fragWrapper->getFragmentId()
-			                                                          << ", returning packet to user");
-			status = NON_FRAGMENT;
-			return fragment;
-		}
+		fragData.lruPrev = InvalidIndex;
+		fragData.lruNext = InvalidIndex;
+		moveToLruHead(index);
+		return index;
+	}
 
-		// create a hash from source IP, destination IP and IP/fragment ID
-		uint32_t hash = fragWrapper->hashPacket();
+	void IPReassembly::releaseEntry(uint32_t index)
+	{
+		IPFragmentData& fragData = m_Entries[index];
+		m_CurrentMemoryUsage -= fragData.headerData.size() + fragData.payload.size();
+		removeFromBuckets(index);
+		unlinkFromLru(index);
+		fragData.lruNext = m_FreeEntries;
+		m_FreeEntries = index;
+		m_NumOfEntries--;
+	}
 
-		IPFragmentData* fragData = nullptr;
+	void IPReassembly::dropEntry(uint32_t index, uint64_t& dropCounter)
+	{
+		dropCounter++;
 
-		// check whether this packet already exists in the map
-		std::unordered_map<uint32_t, IPFragmentData*>::iterator iter = m_FragmentMap.find(hash);
+		// release the record before firing the callback, so the callback can process packets or remove them
+		FragmentKey key = m_Entries[index].key;
+		releaseEntry(index);
 
-		// this is the first fragment seen for this packet
-		if (iter == m_FragmentMap.end())
+		if (m_OnFragmentsCleanCallback == nullptr)
 		{
-			PCPP_LOG_DEBUG("Got new packet with FragID=0x" << std::hex << fragWrapper->getFragmentId()
-			                                               << ", allocating place in map");
-
-			// create the IPFragmentData object
-			fragData = new IPFragmentData(fragWrapper->createPacketKey(), fragWrapper->getFragmentId());
+			return;
+		}
 
-			// add the new fragment to the map
-			addNewFragment(hash, fragData);
+		if (key.protocol == IPv4)
+		{
+			IPv4PacketKey packetKey(static_cast<uint16_t>(key.fragmentID), IPv4Address(key.srcIP),
+			                        IPv4Address(key.dstIP));
+			m_OnFragmentsCleanCallback(&packetKey, m_CallbackUserCookie);
 		}
-		else  // packet was seen before
+		else
 		{
-			// get the IPFragmentData object
-			fragData = iter->second;
-
-			// mark this packet as used
-			m_PacketLRU.put(hash, nullptr);
+			IPv6PacketKey packetKey(key.fragmentID, IPv6Address(key.srcIP), IPv6Address(key.dstIP));
+			m_OnFragmentsCleanCallback(&packetKey, m_CallbackUserCookie);
 		}
+	}
 
-		bool gotLastFragment = false;
+	void IPReassembly::moveToLruHead(uint32_t index)
+	{
+		if (m_LruHead == index)
+		{
+			return;
+		}
 
-		// if current fragment is the first fragment of this packet
-		if (fragWrapper->isFirstFragment())
+		IPFragmentData& fragData = m_Entries[index];
+		if (fragData.lruPrev != InvalidIndex || m_LruTail == index)
 		{
-			if (fragData->data == nullptr)  // first fragment
-			{
-				PCPP_LOG_DEBUG("[FragID=0x" << std::hex << fragWrapper->getFragmentId()
-				                            << "] Got first fragment, allocating RawPacket");
-
-				// create the reassembled packet and copy the fragment data to it
-
-				// copy only data from the beginning of the fragment to the end of IP layer payload.
-				// Don't copy data beyond it such as packet trailer
-				auto fragmentRawPacket = fragment->getRawPacket();
-				auto rawDataLen = fragWrapper->getIPLayerPayload() - fragmentRawPacket->getRawData() +
-				                  fragWrapper->getIPLayerPayloadSize();
-				auto rawData = new uint8_t[rawDataLen];
-				memcpy(rawData, fragmentRawPacket->getRawData(), rawDataLen);
-
-				fragData->data = new RawPacket(rawData, rawDataLen, fragmentRawPacket->getPacketTimeStamp(), true,
-				                               fragmentRawPacket->getLinkLayerType());
-				fragData->currentOffset = fragWrapper->getIPLayerPayloadSize();
-				status = FIRST_FRAGMENT;
-
-				// check if the next fragments already arrived out-of-order and waiting in the out-of-order list
-				gotLastFragment = matchOutOfOrderFragments(fragData);
-			}
-			else  // duplicated first fragment
-			{
-				PCPP_LOG_DEBUG("[FragID=0x" << std::hex << fragWrapper->getFragmentId()
-				                            << "] Got duplicated first fragment");
-				status = FRAGMENT;
-				return nullptr;
-			}
+			unlinkFromLru(index);
 		}
 
-		else  // not first fragment
+		fragData.lruPrev = InvalidIndex;
+		fragData.lruNext = m_LruHead;
+		if (m_LruHead != InvalidIndex)
 		{
-			PCPP_LOG_DEBUG("[FragID=0x" << std::hex << fragWrapper->getFragmentId() << "] Got fragment");
+			m_Entries[m_LruHead].lruPrev = index;
+		}
 
-			uint16_t fragOffset = fragWrapper->getFragmentOffset();
+		m_LruHead = index;
+		if (m_LruTail == InvalidIndex)
+		{
+			m_LruTail = index;
+		}
+	}
 
-			// check if the current fragment offset matches the expected fragment offset
-			if (fragData->currentOffset == fragOffset)
-			{
-				// malformed fragment which is not the first fragment but its offset is 0
-				if (fragData->data == nullptr)
-				{
-					PCPP_LOG_DEBUG("[FragID=0x" << std::hex << fragWrapper->getFragmentId()
-					                            << "] Fragment is malformed");
-					status = MALFORMED_FRAGMENT;
-					return nullptr;
-				}
+	void IPReassembly::unlinkFromLru(uint32_t index)
+	{
+		IPFragmentData& fragData = m_Entries[index];
 
-				PCPP_LOG_DEBUG("[FragID=0x" << std::hex << fragWrapper->getFragmentId()
-				                            << "] Found next matching fragment with offset " << fragOffset
-				                            << ", adding fragment data to reassembled packet");
+		if (fragData.lruPrev != InvalidIndex)
+			m_Entries[fragData.lruPrev].lruNext = fragData.lruNext;
+		else
+			m_LruHead = fragData.lruNext;
 
-				size_t payloadSize = fragWrapper->getIPLayerPayloadSize();
-				// copy fragment data to reassembled packet
-				fragData->data->reallocateData(fragData->data->getRawDataLen() + payloadSize);
-				fragData->data->appendData(fragWrapper->getIPLayerPayload(), payloadSize);
+		if (fragData.lruNext != InvalidIndex)
+			m_Entries[fragData.lruNext].lruPrev = fragData.lruPrev;
+		else
+			m_LruTail = fragData.lruPrev;
 
-				// update expected offset
-				fragData->currentOffset += payloadSize;
+		fragData.lruPrev = InvalidIndex;
+		fragData.lruNext = InvalidIndex;
+	}
 
-				// if this is the last fragment - mark it
-				if (fragWrapper->isLastFragment())
-					gotLastFragment = true;
-				else
-					// if not the last fragment - check if the next fragments are waiting in the out-of-order list
-					gotLastFragment = matchOutOfOrderFragments(fragData);
-			}
-			// if current fragment offset is larger than expected - this means this fragment is out-of-order
-			else if (fragOffset > fragData->currentOffset)
-			{
-				PCPP_LOG_DEBUG("[FragID=0x" << std::hex << fragWrapper->getFragmentId()
-				                            << "] Got out-of-ordered fragment with offset " << fragOffset
-				                            << " (expected: " << fragData->currentOffset
-				                            << "). Adding it to out-of-order list");
-
-				// create a new IPFragment and copy the fragment data and params to it
-				size_t payloadSize = fragWrapper->getIPLayerPayloadSize();
-				IPFragment* newFrag = new IPFragment();
-				newFrag->fragmentOffset = fragWrapper->getFragmentOffset();
-				newFrag->fragmentData = new uint8_t[payloadSize];
-				newFrag->fragmentDataLen = payloadSize;
-				memcpy(newFrag->fragmentData, fragWrapper->getIPLayerPayload(), newFrag->fragmentDataLen);
-				newFrag->lastFragment = fragWrapper->isLastFragment();
-
-				// store the IPFragment in the out-of-order fragment list
-				fragData->outOfOrderFragments.pushBack(newFrag);
-
-				status = OUT_OF_ORDER_FRAGMENT;
-				return nullptr;
-			}
-			else
+	void IPReassembly::insertToBuckets(uint32_t index)
+	{
+		// keep the load factor at 0.5 at most so probe sequences stay short
+		if (m_NumOfEntries * 2 > m_Buckets.size())
+		{
+			std::vector<uint32_t> oldBuckets(std::max(m_Buckets.size() * 2, MinNumOfBuckets), InvalidIndex);
+			oldBuckets.swap(m_Buckets);
+			for (auto entryIndex : oldBuckets)
 			{
-				PCPP_LOG_DEBUG("[FragID=0x" << std::hex << fragWrapper->getFragmentId()
-				                            << "] Got a fragment with an offset that was already seen: " << fragOffset
-				                            << " (current offset is: " << fragData->currentOffset
-				                            << "), probably duplicated fragment");
+				if (entryIndex != InvalidIndex)
+				{
+					placeInBuckets(m_Buckets, entryIndex, m_Entries[entryIndex].hash);
+				}
 			}
 		}
 
-		// if seen the last fragment
-		if (gotLastFragment)
+		placeInBuckets(m_Buckets, index, m_Entries[index].hash);
+	}
+
+	void IPReassembly::removeFromBuckets(uint32_t index)
+	{
+		size_t mask = m_Buckets.size() - 1;
+		size_t bucket = m_Entries[index].hash & mask;
+		while (m_Buckets[bucket] != index)
 		{
-			PCPP_LOG_DEBUG("[FragID=0x" << std::hex << fragWrapper->getFragmentId()
-			                            << "] Reassembly process completed, allocating a packet and returning it");
-			fragData->deleteData = false;
+			bucket = (bucket + 1) & mask;
+		}
 
-			// fix IP length field
-			if (fragData->packetKey->getProtocolType() == IPv4)
-			{
-				Packet tempPacket(fragData->data, IPv4);
-				IPv4Layer* ipLayer = tempPacket.getLayerOfType<IPv4Layer>();
-				iphdr* iphdr = ipLayer->getIPv4Header();
-				iphdr->totalLength = htobe16(fragData->currentOffset + ipLayer->getHeaderLen());
-				iphdr->fragmentOffset = 0;
-			}
-			else
+		// move back entries that were placed after the removed entry because their bucket was taken, so lookups don't
+		// stop at the empty bucket
+		size_t next = bucket;
+		while (true)
+		{
+			next = (next + 1) & mask;
+			if (m_Buckets[next] == InvalidIndex)
 			{
-				Packet tempPacket(fragData->data, IPv6);
-				IPv6Layer* ipLayer = tempPacket.getLayerOfType<IPv6Layer>();
-				tempPacket.getLayerOfType<IPv6Layer>()->getIPv6Header()->payloadLength =
-				    fragData->currentOffset + ipLayer->getHeaderLen();
+				break;
 			}
 
-			// create a new Packet object with the reassembled data as its RawPacket
-			Packet* reassembledPacket = new Packet(fragData->data, true, parseUntil, parseUntilLayer);
-
-			if (fragData->packetKey->getProtocolType() == IPv4)
+			size_t home = m_Entries[m_Buckets[next]].hash & mask;
+			bool homeBetween = bucket <= next ? (bucket < home && home <= next) : (bucket < home || home <= next);
+			if (!homeBetween)
 			{
-				// re-calculate all IPv4 fields
-				reassembledPacket->getLayerOfType<IPv4Layer>()->computeCalculateFields();
-			}
-			else
-			{
-				// remove fragment extension
-				IPv6Layer* ipLayer = reassembledPacket->getLayerOfType<IPv6Layer>();
-				ipLayer->removeAllExtensions();
-
-				// re-calculate all IPv4 fields
-				ipLayer->computeCalculateFields();
+				m_Buckets[bucket] = m_Buckets[next];
+				bucket = next;
 			}
-
-			PCPP_LOG_DEBUG("[FragID=0x" << std::hex << fragWrapper->getFragmentId()
-			                            << "] Deleting fragment data from map");
-
-			// delete the IPFragmentData object and remove it from the map
-			delete fragData;
-			m_FragmentMap.erase(iter);
-			m_PacketLRU.eraseElement(hash);
-			status = REASSEMBLED;
-			return reassembledPacket;
 		}
 
-		// if got to here it means this fragment is either the first fragment or a fragment in the middle. Set the
-		// appropriate status and return
-		if (status != FIRST_FRAGMENT)
-			status = FRAGMENT;
-
-		return nullptr;
+		m_Buckets[bucket] = InvalidIndex;
 	}
 
-	Packet* IPReassembly::processPacket(RawPacket* fragment, ReassemblyStatus& status, ProtocolType parseUntil,
-	                                    OsiModelLayer parseUntilLayer)
+	void IPReassembly::dropExpiredEntries(time_t now)
 	{
-		Packet* parsedFragment = new Packet(fragment, false, parseUntil, parseUntilLayer);
-		Packet* result = processPacket(parsedFragment, status, parseUntil, parseUntilLayer);
-		if (result != parsedFragment)
-			delete parsedFragment;
-
-		return result;
+		// the least recently used packets are the ones that didn't get a fragment for the longest time
+		while (m_LruTail != InvalidIndex &&
+		       now - m_Entries[m_LruTail].lastSeenSec > static_cast<time_t>(m_FragmentTimeoutSec))
+		{
+			PCPP_LOG_DEBUG("Packet with FragID=0x" << std::hex << m_Entries[m_LruTail].key.fragmentID
+			                                       << " timed out, removing its data");
+			dropEntry(m_LruTail, m_Statistics.packetsDroppedTimeout);
+		}
 	}
 
-	Packet* IPReassembly::getCurrentPacket(const PacketKey& key)
+	bool IPReassembly::reserveMemory(uint32_t index, size_t bytes)
 	{
-		// create a hash out of the packet key
-		uint32_t hash = key.getHashValue();
-
-		// look for this hash value in the map
-		std::unordered_map<uint32_t, IPFragmentData*>::iterator iter = m_FragmentMap.find(hash);
-
-		// hash was found
-		if (iter != m_FragmentMap.end())
+		if (m_MaxMemoryUsage > 0)
 		{
-			IPFragmentData* fragData = iter->second;
-
-			// some data already exists
-			if (fragData != nullptr && fragData->data != nullptr)
+			// the packet being processed is at the head of the LRU list so it's the last one to be dropped
+			while (m_CurrentMemoryUsage + bytes > m_MaxMemoryUsage && m_LruTail != index)
 			{
-				// create a copy of the RawPacket object
-				RawPacket* partialRawPacket = new RawPacket(*(fragData->data));
-
-				// fix IP length field
-				if (fragData->packetKey->getProtocolType() == IPv4)
-				{
-					Packet tempPacket(partialRawPacket, IPv4);
-					IPv4Layer* ipLayer = tempPacket.getLayerOfType<IPv4Layer>();
-					ipLayer->getIPv4Header()->totalLength = htobe16(fragData->currentOffset + ipLayer->getHeaderLen());
-				}
-				else
-				{
-					Packet tempPacket(partialRawPacket, IPv6);
-					IPv6Layer* ipLayer = tempPacket.getLayerOfType<IPv6Layer>();
-					tempPacket.getLayerOfType<IPv6Layer>()->getIPv6Header()->payloadLength =
-					    fragData->currentOffset + +ipLayer->getHeaderLen();
-				}
-
-				// create a packet object wrapping the RawPacket we've just created
-				Packet* partialDataPacket = new Packet(partialRawPacket, true);
-
-				// prepare the packet and return it
-				if (key.getProtocolType() == IPv4)
-				{
-					IPv4Layer* ipLayer = partialDataPacket->getLayerOfType<IPv4Layer>();
-					ipLayer->getIPv4Header()->fragmentOffset = 0;
-					ipLayer->computeCalculateFields();
-				}
-				else  // key.getProtocolType() == IPv6
-				{
-					IPv6Layer* ipLayer = partialDataPacket->getLayerOfType<IPv6Layer>();
-					ipLayer->removeAllExtensions();
-					ipLayer->computeCalculateFields();
-				}
+				PCPP_LOG_DEBUG("Reached memory limit, removing data for FragID=0x"
+				               << std::hex << m_Entries[m_LruTail].key.fragmentID);
+				dropEntry(m_LruTail, m_Statistics.packetsDroppedMemory);
+			}
 
-				return partialDataPacket;
+			if (m_CurrentMemoryUsage + bytes > m_MaxMemoryUsage)
+			{
+				dropEntry(index, m_Statistics.packetsDroppedMemory);
+				return false;
 			}
 		}
 
-		return nullptr;
+		m_CurrentMemoryUsage += bytes;
+		return true;
 	}
 
-	void IPReassembly::removePacket(const PacketKey& key)
+	void IPReassembly::addFragmentData(uint32_t index, size_t offset, const uint8_t* data, size_t dataLen,
+	                                   bool isLastFragment)
 	{
-		// create a hash out of the packet key
-		uint32_t hash = key.getHashValue();
-
-		// look for this hash value in the map
-		std::unordered_map<uint32_t, IPFragmentData*>::iterator iter = m_FragmentMap.find(hash);
-
-		// hash was found
-		if (iter != m_FragmentMap.end())
+		IPFragmentData& fragData = m_Entries[index];
+		std::vector<FragmentHole>& holes = fragData.holes;
+		size_t end = offset + dataLen;
+		if (end > fragData.payload.size())
 		{
-			// free all data saved in the map
-			delete iter->second;
-			m_FragmentMap.erase(iter);
-
-			// remove from LRU list
-			m_PacketLRU.eraseElement(hash);
+			if (end > fragData.payload.capacity())
+			{
+				PCPP_INSTRUMENT_COUNT(IPReassemblyBuffers, 1);
+			}
+			fragData.payload.resize(end);
 		}
-	}
-
-	void IPReassembly::addNewFragment(uint32_t hash, IPFragmentData* fragData)
-	{
-		// put the new frag in the LRU list
-		uint32_t packetRemoved;
 
-		// this means LRU list was full and the least recently used item was removed
-		if (m_PacketLRU.put(hash, &packetRemoved) == 1)
+		// copy the data that fills holes and split the holes as described in RFC 815. Data that was already received is
+		// kept as is
+		bool filledHole = false;
+		for (size_t i = 0; i < holes.size();)
 		{
-			// remove this item from the fragment map
-			std::unordered_map<uint32_t, IPFragmentData*>::iterator iter = m_FragmentMap.find(packetRemoved);
-			IPFragmentData* dataRemoved = iter->second;
+			FragmentHole hole = holes[i];
+			if (hole.start >= end || hole.end <= offset)
+			{
+				i++;
+				continue;
+			}
 
-			PacketKey* key = nullptr;
-			if (m_OnFragmentsCleanCallback != nullptr)
-				key = dataRemoved->packetKey->clone();
+			filledHole = true;
+			size_t copyStart = std::max(hole.start, offset);
+			size_t copyEnd = std::min(hole.end, end);
+			memcpy(fragData.payload.data() + copyStart, data + (copyStart - offset), copyEnd - copyStart);
+			PCPP_INSTRUMENT_COUNT(IPReassemblyBytesBuffered, copyEnd - copyStart);
 
-			PCPP_LOG_DEBUG("Reached maximum packet capacity, removing data for FragID=0x" << std::hex
-			                                                                              << dataRemoved->fragmentID);
-			delete dataRemoved;
-			m_FragmentMap.erase(iter);
+			bool holeBefore = hole.start < offset;
+			bool holeAfter = hole.end > end && !isLastFragment;
+			if (holeBefore && holeAfter)
+			{
+				holes[i].end = offset;
+				holes.insert(holes.begin() + i + 1, { end, hole.end });
+				i += 2;
+			}
+			else if (holeBefore)
+			{
+				holes[i].end = offset;
+				i++;
+			}
+			else if (holeAfter)
+			{
+				holes[i].start = end;
+				i++;
+			}
+			else
+			{
+				holes.erase(holes.begin() + i);
+			}
+		}
 
-			// fire callback if not null
-			if (m_OnFragmentsCleanCallback != nullptr)
+		if (isLastFragment)
+		{
+			// nothing is missing after the last fragment
+			while (!holes.empty() && holes.back().start >= end)
 			{
-				m_OnFragmentsCleanCallback(key, m_CallbackUserCookie);
-				delete key;
+				holes.pop_back();
 			}
+
+			fragData.gotLastFragment = true;
 		}
 
-		// add the new fragment to the map
-		std::pair<uint32_t, IPFragmentData*> pair(hash, fragData);
-		m_FragmentMap.insert(pair);
+		if (!filledHole)
+		{
+			PCPP_LOG_DEBUG("[FragID=0x" << std::hex << fragData.key.fragmentID << "] Fragment with offset "
+			                            << std::dec << offset << " was already received");
+			m_Statistics.duplicateFragments++;
+		}
 	}
 
-	bool IPReassembly::matchOutOfOrderFragments(IPFragmentData* fragData)
+	Packet* IPReassembly::createPacket(const IPFragmentData& fragData, size_t payloadLen, ProtocolType parseUntil,
+	                                   OsiModelLayer parseUntilLayer) const
 	{
-		PCPP_LOG_DEBUG("[FragID=0x" << std::hex << fragData->fragmentID
-		                            << "] Searching out-of-order fragment list for the next fragment");
-
-		// a flag indicating whether the last fragment of the packet was found
-		bool foundLastSegment = false;
+		size_t headerLen = fragData.headerData.size();
+		size_t rawDataLen = headerLen + payloadLen;
+		uint8_t* rawData = new uint8_t[rawDataLen];
+		PCPP_INSTRUMENT_COUNT(IPReassemblyBuffers, 1);
+		memcpy(rawData, fragData.headerData.data(), headerLen);
+		if (payloadLen > 0)
+		{
+			memcpy(rawData + headerLen, fragData.payload.data(), payloadLen);
+		}
 
-		// run until the last fragment was found or until we finished going over the out-of-order list and didn't find
-		// any matching fragment
-		while (!foundLastSegment)
+		// fix the IP length field before parsing, so the IP layer covers all the reassembled data
+		uint8_t* ipHeader = rawData + fragData.ipHeaderOffset;
+		size_t ipHeaderLen = headerLen - fragData.ipHeaderOffset;
+		if (fragData.key.protocol == IPv4)
+		{
+			iphdr* ipv4Header = reinterpret_cast<iphdr*>(ipHeader);
+			ipv4Header->totalLength = htobe16(static_cast<uint16_t>(ipHeaderLen + payloadLen));
+			ipv4Header->fragmentOffset = 0;
+		}
+		else
 		{
-			bool foundOutOfOrderFrag = false;
+			ip6_hdr* ipv6Header = reinterpret_cast<ip6_hdr*>(ipHeader);
+			ipv6Header->payloadLength = htobe16(static_cast<uint16_t>(ipHeaderLen - sizeof(ip6_hdr) + payloadLen));
+		}
 
-			int index = 0;
+		RawPacket* rawPacket = new RawPacket(rawData, static_cast<int>(rawDataLen), fragData.timestamp, true,
+		                                     fragData.linkLayerType);
+		Packet* packet = new Packet(rawPacket, true, parseUntil, parseUntilLayer);
 
-			// go over all fragment in the out-of-order list
-			while (index < (int)fragData->outOfOrderFragments.size())
+		if (fragData.key.protocol == IPv4)
+		{
+			// re-calculate all IPv4 fields
+			IPv4Layer* ipLayer = packet->getLayerOfType<IPv4Layer>();
+			if (ipLayer != nullptr)
 			{
-				// get the current fragment from the out-of-order list
-				IPFragment* frag = fragData->outOfOrderFragments.at(index);
-
-				// this fragment is exactly the one we're looking for
-				if (fragData->currentOffset == frag->fragmentOffset)
-				{
-					// add it to the reassembled packet
-					PCPP_LOG_DEBUG("[FragID=0x"
-					               << std::hex << fragData->fragmentID
-					               << "] Found the next matching fragment in out-of-order list with offset "
-					               << frag->fragmentOffset << ", adding its data to reassembled packet");
-					fragData->data->reallocateData(fragData->data->getRawDataLen() + frag->fragmentDataLen);
-					fragData->data->appendData(frag->fragmentData, frag->fragmentDataLen);
-					fragData->currentOffset += frag->fragmentDataLen;
-					if (frag->lastFragment)  // if this is the last fragment of the packet
-					{
-						PCPP_LOG_DEBUG("[FragID=0x" << std::hex << fragData->fragmentID
-						                            << "] Found last fragment inside out-of-order list");
-						foundLastSegment = true;
-					}
-
-					// remove this fragment from the out-of-order list
-					fragData->outOfOrderFragments.erase(fragData->outOfOrderFragments.begin() + index);
-
-					// mark that we found at least one matching fragment in the out-of-order list
-					foundOutOfOrderFrag = true;
-				}
-				else
-					index++;
+				ipLayer->computeCalculateFields();
 			}
-
-			// during the search we did on the out-of-order list we didn't find any matching fragment
-			if (!foundOutOfOrderFrag)
+		}
+		else
+		{
+			// remove fragment extension and re-calculate all IPv6 fields
+			IPv6Layer* ipLayer = packet->getLayerOfType<IPv6Layer>();
+			if (ipLayer != nullptr)
 			{
-				// break the loop - need to wait for the missing fragment in next incoming packets
-				PCPP_LOG_DEBUG("[FragID=0x" << std::hex << fragData->fragmentID
-				                            << "] Didn't find the next fragment in out-of-order list");
-				break;
+				ipLayer->removeAllExtensions();
+				ipLayer->computeCalculateFields();
 			}
 		}
 
-		return foundLastSegment;
+		return packet;
 	}
 
 }  // namespace pcpp
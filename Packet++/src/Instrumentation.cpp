@@ -0,0 +1,330 @@
+#define LOG_MODULE PacketLogModulePacket
+
+#include "Instrumentation.h"
+#include <atomic>
+#include <mutex>
+#include <sstream>
+
+namespace pcpp
+{
+
+	namespace
+	{
+		constexpr size_t NumOfCounters = static_cast<size_t>(InstrumentationCounter::NumOfCounters);
+
+		const char* const CounterNames[NumOfCounters] = {
+			"raw_packet_copies", "raw_packet_bytes_copied", "tcp_reassembly_fragment_buffers",
+			"tcp_reassembly_bytes_buffered", "ip_reassembly_buffers", "ip_reassembly_bytes_buffered",
+			"filter_evaluations", "device_rx_batches", "device_rx_packets", "device_tx_batches", "device_tx_packets"
+		};
+
+		// indexed by ProtocolType, see ProtocolType.h
+		const char* const ProtocolNames[] = {
+			"UnknownProtocol", "Ethernet", "IPv4", "IPv6", "TCP", "UDP", "HTTPRequest", "HTTPResponse", "ARP", "VLAN",
+			"ICMP", "PPPoESession", "PPPoEDiscovery", "DNS", "MPLS", "GREv0", "GREv1", "PPP_PPTP", "SSL", "SLL",
+			"DHCP", "NULL_LOOPBACK", "IGMPv1", "IGMPv2", "IGMPv3", "GenericPayload", "VXLAN", "SIPRequest",
+			"SIPResponse", "SDP", "PacketTrailer", "Radius", "GTPv1", "EthernetDot3", "BGP", "SSH",
+			"AuthenticationHeader", "ESP", "DHCPv6", "NTP", "Telnet", "FTP", "ICMPv6", "STP", "LLC", "SomeIP",
+			"WakeOnLan", "NFLOG", "TPKT", "VRRPv2", "VRRPv3", "COTP", "SLL2", "S7COMM", "SMTP", "LDAP", "WireGuard",
+			"GTPv2"
+		};
+
+		std::string getProtocolName(size_t protocol)
+		{
+			if (protocol < sizeof(ProtocolNames) / sizeof(ProtocolNames[0]))
+			{
+				return ProtocolNames[protocol];
+			}
+			return "Protocol" + std::to_string(protocol);
+		}
+	}  // namespace
+
+	namespace internal
+	{
+		/**
+		 * The counters of a single thread. Only the owning thread writes them, so an increment is a relaxed load and
+		 * store without a locked instruction, and other threads can read them at any time for a snapshot
+		 */
+		struct ThreadInstrumentation
+		{
+			std::atomic<uint64_t> counters[NumOfCounters];
+			std::atomic<uint64_t> layerAllocations[256];
+
+			// the values at the last reset, guarded by the registry mutex
+			InstrumentationSnapshot resetOffset;
+
+			// the registry keeps the live threads in an intrusive list so registering a thread doesn't allocate
+			ThreadInstrumentation* prev;
+			ThreadInstrumentation* next;
+
+			ThreadInstrumentation() : prev(nullptr), next(nullptr)
+			{
+				for (auto& counter : counters)
+				{
+					counter.store(0, std::memory_order_relaxed);
+				}
+				for (auto& counter : layerAllocations)
+				{
+					counter.store(0, std::memory_order_relaxed);
+				}
+			}
+
+			void addTo(InstrumentationSnapshot& snapshot) const;
+		};
+
+		class InstrumentationRegistry
+		{
+		public:
+			static InstrumentationRegistry& getInstance()
+			{
+				static InstrumentationRegistry instance;
+				return instance;
+			}
+
+			void addThread(ThreadInstrumentation* thread)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				thread->next = m_Threads;
+				if (m_Threads != nullptr)
+				{
+					m_Threads->prev = thread;
+				}
+				m_Threads = thread;
+			}
+
+			void removeThread(ThreadInstrumentation* thread)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				// keep the counts of exited threads in the totals
+				thread->addTo(m_ExitedThreads);
+				if (thread->prev != nullptr)
+				{
+					thread->prev->next = thread->next;
+				}
+				else
+				{
+					m_Threads = thread->next;
+				}
+				if (thread->next != nullptr)
+				{
+					thread->next->prev = thread->prev;
+				}
+			}
+
+			InstrumentationSnapshot getSnapshot()
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				return getTotals() - m_ResetOffset;
+			}
+
+			InstrumentationSnapshot getThreadSnapshot(const ThreadInstrumentation& thread)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				InstrumentationSnapshot result;
+				thread.addTo(result);
+				return result - thread.resetOffset;
+			}
+
+			void reset()
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_ResetOffset = getTotals();
+				for (ThreadInstrumentation* thread = m_Threads; thread != nullptr; thread = thread->next)
+				{
+					thread->resetOffset = InstrumentationSnapshot();
+					thread->addTo(thread->resetOffset);
+				}
+			}
+
+			static void add(InstrumentationSnapshot& snapshot, size_t counter, uint64_t value)
+			{
+				snapshot.m_Counters[counter] += value;
+			}
+
+			static void addLayers(InstrumentationSnapshot& snapshot, size_t protocol, uint64_t value)
+			{
+				snapshot.m_LayerAllocations[protocol] += value;
+			}
+
+		private:
+			InstrumentationRegistry() : m_Threads(nullptr)
+			{}
+
+			InstrumentationSnapshot getTotals() const
+			{
+				InstrumentationSnapshot result = m_ExitedThreads;
+				for (ThreadInstrumentation* thread = m_Threads; thread != nullptr; thread = thread->next)
+				{
+					thread->addTo(result);
+				}
+				return result;
+			}
+
+			std::mutex m_Mutex;
+			ThreadInstrumentation* m_Threads;
+			InstrumentationSnapshot m_ExitedThreads;
+			InstrumentationSnapshot m_ResetOffset;
+		};
+
+		void ThreadInstrumentation::addTo(InstrumentationSnapshot& snapshot) const
+		{
+			for (size_t i = 0; i < NumOfCounters; i++)
+			{
+				InstrumentationRegistry::add(snapshot, i, counters[i].load(std::memory_order_relaxed));
+			}
+			for (size_t i = 0; i < 256; i++)
+			{
+				InstrumentationRegistry::addLayers(snapshot, i, layerAllocations[i].load(std::memory_order_relaxed));
+			}
+		}
+
+		namespace
+		{
+			struct ThreadInstrumentationHolder
+			{
+				ThreadInstrumentation data;
+
+				ThreadInstrumentationHolder()
+				{
+					InstrumentationRegistry::getInstance().addThread(&data);
+				}
+
+				~ThreadInstrumentationHolder()
+				{
+					InstrumentationRegistry::getInstance().removeThread(&data);
+				}
+			};
+
+			ThreadInstrumentation& getThreadInstrumentation()
+			{
+				// the registry is created by the first holder's c'tor, so it's destroyed after the holders of all
+				// threads, including the main thread
+				thread_local ThreadInstrumentationHolder holder;
+				return holder.data;
+			}
+
+			inline void increment(std::atomic<uint64_t>& counter, uint64_t value)
+			{
+				counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+			}
+		}  // namespace
+
+		void addToInstrumentationCounter(InstrumentationCounter counter, uint64_t value)
+		{
+			increment(getThreadInstrumentation().counters[static_cast<size_t>(counter)], value);
+		}
+
+		void countLayerAllocation(ProtocolType protocol)
+		{
+			increment(getThreadInstrumentation().layerAllocations[protocol], 1);
+		}
+	}  // namespace internal
+
+	InstrumentationSnapshot::InstrumentationSnapshot()
+	{
+		m_Counters.fill(0);
+		m_LayerAllocations.fill(0);
+	}
+
+	uint64_t InstrumentationSnapshot::getTotalLayerAllocations() const
+	{
+		uint64_t result = 0;
+		for (uint64_t value : m_LayerAllocations)
+		{
+			result += value;
+		}
+		return result;
+	}
+
+	InstrumentationSnapshot InstrumentationSnapshot::operator-(const InstrumentationSnapshot& other) const
+	{
+		InstrumentationSnapshot result;
+		for (size_t i = 0; i < m_Counters.size(); i++)
+		{
+			result.m_Counters[i] = m_Counters[i] - other.m_Counters[i];
+		}
+		for (size_t i = 0; i < m_LayerAllocations.size(); i++)
+		{
+			result.m_LayerAllocations[i] = m_LayerAllocations[i] - other.m_LayerAllocations[i];
+		}
+		return result;
+	}
+
+	std::string InstrumentationSnapshot::toPrometheusText() const
+	{
+		std::ostringstream stream;
+		for (size_t i = 0; i < m_Counters.size(); i++)
+		{
+			std::string metricName = std::string("pcpp_") + CounterNames[i] + "_total";
+			stream << "# TYPE " << metricName << " counter\n" << metricName << " " << m_Counters[i] << "\n";
+		}
+
+		stream << "# TYPE pcpp_layer_allocations_total counter\n";
+		for (size_t i = 0; i < m_LayerAllocations.size(); i++)
+		{
+			if (m_LayerAllocations[i] > 0)
+			{
+				stream << "pcpp_layer_allocations_total{protocol=\"" << getProtocolName(i) << "\"} "
+				       << m_LayerAllocations[i] << "\n";
+			}
+		}
+
+		return stream.str();
+	}
+
+	std::string InstrumentationSnapshot::toJson() const
+	{
+		std::ostringstream stream;
+		stream << "{";
+		for (size_t i = 0; i < m_Counters.size(); i++)
+		{
+			stream << "\"" << CounterNames[i] << "\":" << m_Counters[i] << ",";
+		}
+
+		stream << "\"layer_allocations\":{";
+		bool first = true;
+		for (size_t i = 0; i < m_LayerAllocations.size(); i++)
+		{
+			if (m_LayerAllocations[i] > 0)
+			{
+				stream << (first ? "" : ",") << "\"" << getProtocolName(i) << "\":" << m_LayerAllocations[i];
+				first = false;
+			}
+		}
+		stream << "}}";
+
+		return stream.str();
+	}
+
+	bool isInstrumentationEnabled()
+	{
+#ifdef PCPP_INSTRUMENTATION
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	InstrumentationSnapshot getInstrumentationSnapshot()
+	{
+		return internal::InstrumentationRegistry::getInstance().getSnapshot();
+	}
+
+	InstrumentationSnapshot getThreadInstrumentationSnapshot()
+	{
+		return internal::InstrumentationRegistry::getInstance().getThreadSnapshot(
+		    internal::getThreadInstrumentation());
+	}
+
+	void resetInstrumentation()
+	{
+		internal::InstrumentationRegistry::getInstance().reset();
+	}
+
+	std::string getInstrumentationCounterName(InstrumentationCounter counter)
+	{
+		size_t index = static_cast<size_t>(counter);
+		return index < NumOfCounters ? CounterNames[index] : "";
+	}
+
+}  // namespace pcpp
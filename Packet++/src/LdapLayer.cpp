@@ -1,5 +1,7 @@
 #include "LdapLayer.h"
 #include "GeneralUtils.h"
+#include <algorithm>
+#include <cstring>
 #include <unordered_map>
 
 namespace pcpp
@@ -183,6 +185,88 @@ namespace pcpp
 
 	// endregion
 
+	// region ASN.1 element helpers
+
+	static void checkAsn1Type(bool isExpectedType)
+	{
+		if (!isExpectedType)
+		{
+			throw std::bad_cast();
+		}
+	}
+
+	static void checkAsn1Reader(const Asn1Reader& reader)
+	{
+		if (reader.hasError())
+		{
+			throw std::invalid_argument("Cannot decode ASN.1 record, data is malformed");
+		}
+	}
+
+	static uint32_t getAsn1IntegerValue(const Asn1Element& element, bool enumeratedOnly)
+	{
+		checkAsn1Type(element.hasTag(Asn1UniversalTagType::Enumerated, false) ||
+		              (!enumeratedOnly && element.hasTag(Asn1UniversalTagType::Integer, false)));
+
+		uint32_t value;
+		if (!element.getIntegerValue(value))
+		{
+			throw std::runtime_error("An integer ASN.1 record of more than 4 bytes is not supported");
+		}
+
+		return value;
+	}
+
+	// returns the value as Asn1OctetStringRecord#getValue() does: as is if it's printable, otherwise as a hex string
+	static std::string getAsn1OctetStringValue(const Asn1Element& element)
+	{
+		checkAsn1Type(element.hasTag(Asn1UniversalTagType::OctetString, false));
+
+		auto value = reinterpret_cast<const char*>(element.value);
+		if (std::all_of(value, value + element.valueLength, [](char c) { return isprint(0xff & c); }))
+		{
+			return std::string(value, element.valueLength);
+		}
+
+		return byteArrayToHexString(element.value, element.valueLength);
+	}
+
+	static bool getAsn1BooleanValue(const Asn1Element& element)
+	{
+		checkAsn1Type(element.hasTag(Asn1UniversalTagType::Boolean, false));
+
+		bool value;
+		if (!element.getBooleanValue(value))
+		{
+			throw std::invalid_argument("Cannot decode ASN.1 boolean record");
+		}
+
+		return value;
+	}
+
+	// true for the primitive elements Asn1Record decodes as Asn1GenericRecord
+	static bool isAsn1GenericElement(const Asn1Element& element)
+	{
+		if (element.isConstructed)
+		{
+			return false;
+		}
+
+		switch (element.getUniversalTagType())
+		{
+		case Asn1UniversalTagType::Integer:
+		case Asn1UniversalTagType::Enumerated:
+		case Asn1UniversalTagType::OctetString:
+		case Asn1UniversalTagType::Boolean:
+		case Asn1UniversalTagType::Null:
+			return false;
+		default:
+			return true;
+		}
+	}
+
+	// endregion
+
 	// region LdapLayer
 
 	LdapLayer::LdapLayer(uint16_t messageId, LdapOperationType operationType,
@@ -191,64 +275,64 @@ namespace pcpp
 		init(messageId, operationType, messageRecords, controls);
 	}
 
-	LdapLayer::LdapLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-	                     Packet* packet)
+	LdapLayer::LdapLayer(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet)
 	    : Layer(data, dataLen, prevLayer, packet, LDAP)
 	{
-		m_Asn1Record = std::move(asn1Record);
+		Asn1Element rootElement;
+		if (Asn1Reader::readElement(data, dataLen, rootElement))
+		{
+			m_MessageLength = rootElement.getTotalLength();
+		}
 	}
 
 	void LdapLayer::init(uint16_t messageId, LdapOperationType operationType,
 	                     const std::vector<Asn1Record*>& messageRecords, const std::vector<LdapControl>& controls)
 	{
-		Asn1IntegerRecord messageIdRecord(messageId);
-		std::unique_ptr<Asn1Record> messageRootRecord;
+		Asn1Writer writer;
+		writer.beginSequence();
+		writer.writeInteger(messageId);
+
 		if (!messageRecords.empty())
 		{
-			messageRootRecord = std::unique_ptr<Asn1Record>(
-			    new Asn1ConstructedRecord(Asn1TagClass::Application, operationType, messageRecords));
+			writer.beginConstructed(Asn1TagClass::Application, operationType);
+			for (auto messageRecord : messageRecords)
+			{
+				auto encodedRecord = messageRecord->encode();
+				writer.writeEncoded(encodedRecord.data(), encodedRecord.size());
+			}
+			writer.endConstructed();
 		}
 		else
 		{
-			messageRootRecord =
-			    std::unique_ptr<Asn1Record>(new Asn1GenericRecord(Asn1TagClass::Application, false, operationType, ""));
+			writer.writePrimitive(Asn1TagClass::Application, operationType, nullptr, 0);
 		}
 
-		std::vector<Asn1Record*> rootSubRecords = { &messageIdRecord, messageRootRecord.get() };
-
-		std::unique_ptr<Asn1ConstructedRecord> controlsRecord;
 		if (!controls.empty())
 		{
-			PointerVector<Asn1Record> controlsSubRecords;
+			writer.beginConstructed(Asn1TagClass::ContextSpecific, 0);
 			for (const auto& control : controls)
 			{
-				Asn1OctetStringRecord controlTypeRecord(control.controlType);
-				if (control.controlValue.empty())
-				{
-					controlsSubRecords.pushBack(new Asn1SequenceRecord({ &controlTypeRecord }));
-				}
-				else
+				writer.beginSequence();
+				writer.writeOctetString(control.controlType);
+				if (!control.controlValue.empty())
 				{
 					auto controlValueSize = static_cast<size_t>(control.controlValue.size() / 2);
 					std::unique_ptr<uint8_t[]> controlValue(new uint8_t[controlValueSize]);
 					controlValueSize = hexStringToByteArray(control.controlValue, controlValue.get(), controlValueSize);
-					Asn1OctetStringRecord controlValueRecord(controlValue.get(), controlValueSize);
-					controlsSubRecords.pushBack(new Asn1SequenceRecord({ &controlTypeRecord, &controlValueRecord }));
+					writer.writeOctetString(controlValue.get(), controlValueSize);
 				}
+				writer.endConstructed();
 			}
-			controlsRecord = std::unique_ptr<Asn1ConstructedRecord>(
-			    new Asn1ConstructedRecord(Asn1TagClass::ContextSpecific, 0, controlsSubRecords));
-			rootSubRecords.push_back(controlsRecord.get());
+			writer.endConstructed();
 		}
 
-		Asn1SequenceRecord rootRecord(rootSubRecords);
+		writer.endConstructed();
 
-		auto encodedData = rootRecord.encode();
-		m_DataLen = encodedData.size();
+		m_DataLen = writer.getDataLen();
 		m_Data = new uint8_t[m_DataLen];
-		std::copy(encodedData.begin(), encodedData.end(), m_Data);
+		memcpy(m_Data, writer.getData(), m_DataLen);
 		m_Protocol = LDAP;
-		m_Asn1Record = Asn1Record::decode(m_Data, m_DataLen, true);
+		m_MessageLength = m_DataLen;
 	}
 
 	std::string LdapLayer::toString() const
@@ -259,52 +343,106 @@ namespace pcpp
 
 	LdapLayer* LdapLayer::parseLdapMessage(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet)
 	{
-		try
+		Asn1Element rootElement;
+		if (!Asn1Reader::readElement(data, dataLen, rootElement) ||
+		    !rootElement.hasTag(Asn1UniversalTagType::Sequence, true))
+		{
+			return nullptr;
+		}
+
+		// the message ID, the operation and the controls must be well-formed, their content is checked when it's read
+		Asn1Reader reader(rootElement.value, rootElement.valueLength);
+		size_t numOfSubElements = 0;
+		uint8_t operationTagType = 0;
+		Asn1Reader::Event event;
+		while ((event = reader.next()) == Asn1Reader::Event::Element)
 		{
-			auto asn1Record = Asn1Record::decode(data, dataLen, true);
-			auto operationType = LdapOperationType::fromUintValue(
-			    asn1Record->castAs<Asn1SequenceRecord>()->getSubRecords().at(operationTypeIndex)->getTagType());
-			switch (operationType)
+			if (numOfSubElements == operationTypeIndex)
 			{
-			case LdapOperationType::BindRequest:
-				return new LdapBindRequestLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
-			case LdapOperationType::BindResponse:
-				return new LdapBindResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
-			case LdapOperationType::UnbindRequest:
-				return new LdapUnbindRequestLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
-			case LdapOperationType::SearchRequest:
-				return new LdapSearchRequestLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
-			case LdapOperationType::SearchResultEntry:
-				return new LdapSearchResultEntryLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
-			case LdapOperationType::SearchResultDone:
-				return new LdapSearchResultDoneLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
-			case LdapOperationType::ModifyResponse:
-				return new LdapModifyResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
-			case LdapOperationType::AddResponse:
-				return new LdapAddResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
-			case LdapOperationType::DeleteResponse:
-				return new LdapDeleteResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
-			case LdapOperationType::ModifyDNResponse:
-				return new LdapModifyDNResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
-			case LdapOperationType::CompareResponse:
-				return new LdapCompareResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
-			case LdapOperationType::Unknown:
-				return nullptr;
-			default:
-				return new LdapLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
+				operationTagType = reader.getElement().tagType;
 			}
+
+			numOfSubElements++;
+			reader.skip();
 		}
-		catch (...)
+
+		if (event != Asn1Reader::Event::EndOfData || numOfSubElements <= operationTypeIndex)
 		{
 			return nullptr;
 		}
+
+		auto operationType = LdapOperationType::fromUintValue(operationTagType);
+		switch (operationType)
+		{
+		case LdapOperationType::BindRequest:
+			return new LdapBindRequestLayer(data, dataLen, prevLayer, packet);
+		case LdapOperationType::BindResponse:
+			return new LdapBindResponseLayer(data, dataLen, prevLayer, packet);
+		case LdapOperationType::UnbindRequest:
+			return new LdapUnbindRequestLayer(data, dataLen, prevLayer, packet);
+		case LdapOperationType::SearchRequest:
+			return new LdapSearchRequestLayer(data, dataLen, prevLayer, packet);
+		case LdapOperationType::SearchResultEntry:
+			return new LdapSearchResultEntryLayer(data, dataLen, prevLayer, packet);
+		case LdapOperationType::SearchResultDone:
+			return new LdapSearchResultDoneLayer(data, dataLen, prevLayer, packet);
+		case LdapOperationType::ModifyResponse:
+			return new LdapModifyResponseLayer(data, dataLen, prevLayer, packet);
+		case LdapOperationType::AddResponse:
+			return new LdapAddResponseLayer(data, dataLen, prevLayer, packet);
+		case LdapOperationType::DeleteResponse:
+			return new LdapDeleteResponseLayer(data, dataLen, prevLayer, packet);
+		case LdapOperationType::ModifyDNResponse:
+			return new LdapModifyDNResponseLayer(data, dataLen, prevLayer, packet);
+		case LdapOperationType::CompareResponse:
+			return new LdapCompareResponseLayer(data, dataLen, prevLayer, packet);
+		case LdapOperationType::Unknown:
+			return nullptr;
+		default:
+			return new LdapLayer(data, dataLen, prevLayer, packet);
+		}
 	}
 
 	Asn1SequenceRecord* LdapLayer::getRootAsn1Record() const
 	{
+		if (m_Asn1Record == nullptr)
+		{
+			m_Asn1Record = Asn1Record::decode(m_Data, m_DataLen, true);
+		}
+
 		return m_Asn1Record->castAs<Asn1SequenceRecord>();
 	}
 
+	Asn1Element LdapLayer::getRootAsn1Element() const
+	{
+		Asn1Element rootElement;
+		if (!Asn1Reader::readElement(m_Data, m_DataLen, rootElement))
+		{
+			throw std::invalid_argument("Cannot decode ASN.1 record, data doesn't contain the entire record");
+		}
+
+		checkAsn1Type(rootElement.hasTag(Asn1UniversalTagType::Sequence, true));
+		return rootElement;
+	}
+
+	Asn1Element LdapLayer::getLdapOperationAsn1Element() const
+	{
+		auto operationElement = getSubElement(getRootAsn1Element(), operationTypeIndex);
+		checkAsn1Type(operationElement.isConstructed);
+		return operationElement;
+	}
+
+	Asn1Element LdapLayer::getSubElement(const Asn1Element& element, size_t index)
+	{
+		Asn1Element subElement;
+		if (!element.getSubElement(index, subElement))
+		{
+			throw std::out_of_range("ASN.1 record doesn't have a sub-record at index " + std::to_string(index));
+		}
+
+		return subElement;
+	}
+
 	Asn1ConstructedRecord* LdapLayer::getLdapOperationAsn1Record() const
 	{
 		return getRootAsn1Record()->getSubRecords().at(operationTypeIndex)->castAs<Asn1ConstructedRecord>();
@@ -312,32 +450,37 @@ namespace pcpp
 
 	uint16_t LdapLayer::getMessageID() const
 	{
-		return getRootAsn1Record()->getSubRecords().at(messageIdIndex)->castAs<Asn1IntegerRecord>()->getValue();
+		return getAsn1IntegerValue(getSubElement(getRootAsn1Element(), messageIdIndex), false);
 	}
 
 	std::vector<LdapControl> LdapLayer::getControls() const
 	{
 		std::vector<LdapControl> controls;
-		if (getRootAsn1Record()->getSubRecords().size() <= controlsIndex)
+		Asn1Element controlsElement;
+		if (!getRootAsn1Element().getSubElement(controlsIndex, controlsElement))
 		{
 			return controls;
 		}
 
-		auto controlsRecord = getRootAsn1Record()->getSubRecords().at(controlsIndex)->castAs<Asn1ConstructedRecord>();
-		for (auto controlRecord : controlsRecord->getSubRecords())
+		checkAsn1Type(controlsElement.isConstructed);
+		Asn1Reader reader(controlsElement.value, controlsElement.valueLength);
+		while (reader.next() == Asn1Reader::Event::Element)
 		{
-			auto controlSequence = controlRecord->castAs<Asn1SequenceRecord>();
-			auto controlType =
-			    controlSequence->getSubRecords().at(controlTypeIndex)->castAs<Asn1OctetStringRecord>()->getValue();
+			auto controlElement = reader.getElement();
+			reader.skip();
+			checkAsn1Type(controlElement.hasTag(Asn1UniversalTagType::Sequence, true));
+
+			auto controlType = getAsn1OctetStringValue(getSubElement(controlElement, controlTypeIndex));
 			std::string controlValue;
-			if (controlSequence->getSubRecords().size() > controlValueIndex)
+			Asn1Element controlValueElement;
+			if (controlElement.getSubElement(controlValueIndex, controlValueElement))
 			{
-				controlValue =
-				    controlSequence->getSubRecords().at(controlValueIndex)->castAs<Asn1OctetStringRecord>()->getValue();
+				controlValue = getAsn1OctetStringValue(controlValueElement);
 			}
 			controls.push_back({ controlType, controlValue });
 		}
 
+		checkAsn1Reader(reader);
 		return controls;
 	}
 
@@ -346,7 +489,7 @@ namespace pcpp
 		uint8_t tagType;
 		try
 		{
-			tagType = getLdapOperationAsn1Record()->getTagType();
+			tagType = getLdapOperationAsn1Element().tagType;
 		}
 		catch (...)
 		{
@@ -418,51 +561,39 @@ namespace pcpp
 
 	LdapResultCode LdapResponseLayer::getResultCode() const
 	{
-		return LdapResultCode::fromUintValue(getLdapOperationAsn1Record()
-		                                         ->getSubRecords()
-		                                         .at(resultCodeIndex)
-		                                         ->castAs<Asn1EnumeratedRecord>()
-		                                         ->getValue());
+		return LdapResultCode::fromUintValue(
+		    getAsn1IntegerValue(getSubElement(getLdapOperationAsn1Element(), resultCodeIndex), true));
 	}
 
 	std::string LdapResponseLayer::getMatchedDN() const
 	{
-		return getLdapOperationAsn1Record()
-		    ->getSubRecords()
-		    .at(matchedDNIndex)
-		    ->castAs<Asn1OctetStringRecord>()
-		    ->getValue();
+		return getAsn1OctetStringValue(getSubElement(getLdapOperationAsn1Element(), matchedDNIndex));
 	}
 
 	std::string LdapResponseLayer::getDiagnosticMessage() const
 	{
-		return getLdapOperationAsn1Record()
-		    ->getSubRecords()
-		    .at(diagnotsticsMessageIndex)
-		    ->castAs<Asn1OctetStringRecord>()
-		    ->getValue();
+		return getAsn1OctetStringValue(getSubElement(getLdapOperationAsn1Element(), diagnotsticsMessageIndex));
 	}
 
 	std::vector<std::string> LdapResponseLayer::getReferral() const
 	{
 		std::vector<std::string> result;
-		if (getLdapOperationAsn1Record()->getSubRecords().size() <= referralIndex)
-		{
-			return result;
-		}
-
-		auto referralRecord = getLdapOperationAsn1Record()->getSubRecords().at(referralIndex);
-		if (referralRecord->getTagClass() != Asn1TagClass::ContextSpecific ||
-		    referralRecord->getTagType() != referralTagType)
+		Asn1Element referralElement;
+		if (!getLdapOperationAsn1Element().getSubElement(referralIndex, referralElement) ||
+		    referralElement.tagClass != Asn1TagClass::ContextSpecific || referralElement.tagType != referralTagType)
 		{
 			return result;
 		}
 
-		for (auto uriRecord : referralRecord->castAs<Asn1ConstructedRecord>()->getSubRecords())
+		checkAsn1Type(referralElement.isConstructed);
+		Asn1Reader reader(referralElement.value, referralElement.valueLength);
+		while (reader.next() == Asn1Reader::Event::Element)
 		{
-			result.push_back(uriRecord->castAs<Asn1OctetStringRecord>()->getValue());
+			result.push_back(getAsn1OctetStringValue(reader.getElement()));
+			reader.skip();
 		}
 
+		checkAsn1Reader(reader);
 		return result;
 	}
 
@@ -525,23 +656,23 @@ namespace pcpp
 
 	uint32_t LdapBindRequestLayer::getVersion() const
 	{
-		return getLdapOperationAsn1Record()->getSubRecords().at(versionIndex)->castAs<Asn1IntegerRecord>()->getValue();
+		return getAsn1IntegerValue(getSubElement(getLdapOperationAsn1Element(), versionIndex), false);
 	}
 
 	std::string LdapBindRequestLayer::getName() const
 	{
-		return getLdapOperationAsn1Record()->getSubRecords().at(nameIndex)->castAs<Asn1OctetStringRecord>()->getValue();
+		return getAsn1OctetStringValue(getSubElement(getLdapOperationAsn1Element(), nameIndex));
 	}
 
 	LdapBindRequestLayer::AuthenticationType LdapBindRequestLayer::getAuthenticationType() const
 	{
-		if (getLdapOperationAsn1Record()->getSubRecords().size() <= credentialIndex)
+		Asn1Element credentialElement;
+		if (!getLdapOperationAsn1Element().getSubElement(credentialIndex, credentialElement))
 		{
 			return LdapBindRequestLayer::AuthenticationType::NotApplicable;
 		}
 
-		auto authType = getLdapOperationAsn1Record()->getSubRecords().at(credentialIndex)->getTagType();
-		switch (authType)
+		switch (credentialElement.tagType)
 		{
 		case 0:
 			return LdapBindRequestLayer::AuthenticationType::Simple;
@@ -559,9 +690,9 @@ namespace pcpp
 			throw std::invalid_argument("Authentication type is not simple");
 		}
 
-		auto authRecord =
-		    getLdapOperationAsn1Record()->getSubRecords().at(credentialIndex)->castAs<Asn1GenericRecord>();
-		return { reinterpret_cast<const char*>(authRecord->getValue()), authRecord->getValueLength() };
+		auto authElement = getSubElement(getLdapOperationAsn1Element(), credentialIndex);
+		checkAsn1Type(isAsn1GenericElement(authElement));
+		return { reinterpret_cast<const char*>(authElement.value), authElement.valueLength };
 	}
 
 	LdapBindRequestLayer::SaslAuthentication LdapBindRequestLayer::getSaslAuthentication() const
@@ -571,20 +702,21 @@ namespace pcpp
 			throw std::invalid_argument("Authentication type is not sasl");
 		}
 
-		auto authRecord =
-		    getLdapOperationAsn1Record()->getSubRecords().at(credentialIndex)->castAs<Asn1ConstructedRecord>();
+		auto authElement = getSubElement(getLdapOperationAsn1Element(), credentialIndex);
+		checkAsn1Type(authElement.isConstructed);
+
 		std::string mechanism;
 		std::vector<uint8_t> credentials;
-		if (authRecord->getSubRecords().size() > saslMechanismIndex)
+		Asn1Element mechanismElement;
+		if (authElement.getSubElement(saslMechanismIndex, mechanismElement))
 		{
-			mechanism = authRecord->getSubRecords().at(saslMechanismIndex)->castAs<Asn1OctetStringRecord>()->getValue();
+			mechanism = getAsn1OctetStringValue(mechanismElement);
 		}
-		if (authRecord->getSubRecords().size() > saslCredentialsIndex)
+		Asn1Element credentialsElement;
+		if (authElement.getSubElement(saslCredentialsIndex, credentialsElement))
 		{
-			auto credentialsAsString =
-			    authRecord->getSubRecords().at(saslCredentialsIndex)->castAs<Asn1OctetStringRecord>()->getValue();
-			credentials.resize(credentialsAsString.size() / 2);
-			hexStringToByteArray(credentialsAsString, credentials.data(), credentials.size());
+			checkAsn1Type(credentialsElement.hasTag(Asn1UniversalTagType::OctetString, false));
+			credentials.assign(credentialsElement.value, credentialsElement.value + credentialsElement.valueLength);
 		}
 
 		return { mechanism, credentials };
@@ -631,10 +763,24 @@ namespace pcpp
 	{
 		try
 		{
-			auto serverSaslCredentialsRecord =
-			    getLdapOperationAsn1Record()->getSubRecords().back()->castAs<Asn1GenericRecord>();
-			return { serverSaslCredentialsRecord->getValue(),
-				     serverSaslCredentialsRecord->getValue() + serverSaslCredentialsRecord->getValueLength() };
+			// the server SASL credentials are the last element of the operation, if it has them
+			auto operationElement = getLdapOperationAsn1Element();
+			Asn1Reader reader(operationElement.value, operationElement.valueLength);
+			Asn1Element lastElement{};
+			bool hasElements = false;
+			while (reader.next() == Asn1Reader::Event::Element)
+			{
+				lastElement = reader.getElement();
+				hasElements = true;
+				reader.skip();
+			}
+
+			if (!hasElements || reader.hasError() || !isAsn1GenericElement(lastElement))
+			{
+				return {};
+			}
+
+			return { lastElement.value, lastElement.value + lastElement.valueLength };
 		}
 		catch (const std::exception&)
 		{
@@ -732,47 +878,36 @@ namespace pcpp
 
 	std::string LdapSearchRequestLayer::getBaseObject() const
 	{
-		return getLdapOperationAsn1Record()
-		    ->getSubRecords()
-		    .at(baseObjectIndex)
-		    ->castAs<Asn1OctetStringRecord>()
-		    ->getValue();
+		return getAsn1OctetStringValue(getSubElement(getLdapOperationAsn1Element(), baseObjectIndex));
 	}
 
 	LdapSearchRequestLayer::SearchRequestScope LdapSearchRequestLayer::getScope() const
 	{
 		return LdapSearchRequestLayer::SearchRequestScope::fromUintValue(
-		    getLdapOperationAsn1Record()->getSubRecords().at(scopeIndex)->castAs<Asn1EnumeratedRecord>()->getValue());
+		    getAsn1IntegerValue(getSubElement(getLdapOperationAsn1Element(), scopeIndex), true));
 	}
 
 	LdapSearchRequestLayer::DerefAliases LdapSearchRequestLayer::getDerefAlias() const
 	{
-		return LdapSearchRequestLayer::DerefAliases::fromUintValue(getLdapOperationAsn1Record()
-		                                                               ->getSubRecords()
-		                                                               .at(derefAliasIndex)
-		                                                               ->castAs<Asn1EnumeratedRecord>()
-		                                                               ->getValue());
+		return LdapSearchRequestLayer::DerefAliases::fromUintValue(
+		    getAsn1IntegerValue(getSubElement(getLdapOperationAsn1Element(), derefAliasIndex), true));
 	}
 
 	uint8_t LdapSearchRequestLayer::getSizeLimit() const
 	{
 		return static_cast<uint8_t>(
-		    getLdapOperationAsn1Record()->getSubRecords().at(sizeLimitIndex)->castAs<Asn1IntegerRecord>()->getValue());
+		    getAsn1IntegerValue(getSubElement(getLdapOperationAsn1Element(), sizeLimitIndex), false));
 	}
 
 	uint8_t LdapSearchRequestLayer::getTimeLimit() const
 	{
 		return static_cast<uint8_t>(
-		    getLdapOperationAsn1Record()->getSubRecords().at(timeLimitIndex)->castAs<Asn1IntegerRecord>()->getValue());
+		    getAsn1IntegerValue(getSubElement(getLdapOperationAsn1Element(), timeLimitIndex), false));
 	}
 
 	bool LdapSearchRequestLayer::getTypesOnly() const
 	{
-		return getLdapOperationAsn1Record()
-		    ->getSubRecords()
-		    .at(typesOnlyIndex)
-		    ->castAs<Asn1BooleanRecord>()
-		    ->getValue();
+		return getAsn1BooleanValue(getSubElement(getLdapOperationAsn1Element(), typesOnlyIndex));
 	}
 
 	Asn1Record* LdapSearchRequestLayer::getFilter() const
@@ -783,18 +918,21 @@ namespace pcpp
 	std::vector<std::string> LdapSearchRequestLayer::getAttributes() const
 	{
 		std::vector<std::string> result;
-		if (getLdapOperationAsn1Record()->getSubRecords().size() <= attributesIndex)
+		Asn1Element attributesElement;
+		if (!getLdapOperationAsn1Element().getSubElement(attributesIndex, attributesElement))
 		{
 			return result;
 		}
 
-		auto attributesRecord =
-		    getLdapOperationAsn1Record()->getSubRecords().at(attributesIndex)->castAs<Asn1SequenceRecord>();
-		for (auto attribute : attributesRecord->getSubRecords())
+		checkAsn1Type(attributesElement.hasTag(Asn1UniversalTagType::Sequence, true));
+		Asn1Reader reader(attributesElement.value, attributesElement.valueLength);
+		while (reader.next() == Asn1Reader::Event::Element)
 		{
-			result.push_back(attribute->castAs<Asn1OctetStringRecord>()->getValue());
+			result.push_back(getAsn1OctetStringValue(reader.getElement()));
+			reader.skip();
 		}
 
+		checkAsn1Reader(reader);
 		return result;
 	}
 
@@ -841,38 +979,42 @@ namespace pcpp
 
 	std::string LdapSearchResultEntryLayer::getObjectName() const
 	{
-		return getLdapOperationAsn1Record()
-		    ->getSubRecords()
-		    .at(objectNameIndex)
-		    ->castAs<Asn1OctetStringRecord>()
-		    ->getValue();
+		return getAsn1OctetStringValue(getSubElement(getLdapOperationAsn1Element(), objectNameIndex));
 	}
 
 	std::vector<LdapAttribute> LdapSearchResultEntryLayer::getAttributes() const
 	{
 		std::vector<LdapAttribute> result;
 
-		auto attributes =
-		    getLdapOperationAsn1Record()->getSubRecords().at(attributesIndex)->castAs<Asn1SequenceRecord>();
-		for (auto attributeRecord : attributes->getSubRecords())
+		auto attributesElement = getSubElement(getLdapOperationAsn1Element(), attributesIndex);
+		checkAsn1Type(attributesElement.hasTag(Asn1UniversalTagType::Sequence, true));
+
+		Asn1Reader reader(attributesElement.value, attributesElement.valueLength);
+		while (reader.next() == Asn1Reader::Event::Element)
 		{
-			auto attrAsSequence = attributeRecord->castAs<Asn1SequenceRecord>();
+			auto attributeElement = reader.getElement();
+			reader.skip();
+			checkAsn1Type(attributeElement.hasTag(Asn1UniversalTagType::Sequence, true));
 
-			auto type =
-			    attrAsSequence->getSubRecords().at(attributeTypeIndex)->castAs<Asn1OctetStringRecord>()->getValue();
+			auto type = getAsn1OctetStringValue(getSubElement(attributeElement, attributeTypeIndex));
 
-			std::vector<std::string> values;
-			auto valuesRecord = attrAsSequence->getSubRecords().at(attributeValueIndex)->castAs<Asn1SetRecord>();
+			auto valuesElement = getSubElement(attributeElement, attributeValueIndex);
+			checkAsn1Type(valuesElement.hasTag(Asn1UniversalTagType::Set, true));
 
-			for (auto valueRecord : valuesRecord->getSubRecords())
+			std::vector<std::string> values;
+			Asn1Reader valuesReader(valuesElement.value, valuesElement.valueLength);
+			while (valuesReader.next() == Asn1Reader::Event::Element)
 			{
-				values.push_back(valueRecord->castAs<Asn1OctetStringRecord>()->getValue());
+				values.push_back(getAsn1OctetStringValue(valuesReader.getElement()));
+				valuesReader.skip();
 			}
+			checkAsn1Reader(valuesReader);
 
 			LdapAttribute ldapAttribute = { type, values };
 			result.push_back(ldapAttribute);
 		}
 
+		checkAsn1Reader(reader);
 		return result;
 	}
 
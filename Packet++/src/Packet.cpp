@@ -12,6 +12,8 @@
 #include "PayloadLayer.h"
 #include "PacketTrailerLayer.h"
 #include "Logger.h"
+#include "Instrumentation.h"
+#include <algorithm>
 #include <numeric>
 #include <sstream>
 #ifdef _MSC_VER
@@ -22,15 +24,14 @@
 namespace pcpp
 {
 
-	Packet::Packet(size_t maxPacketLen)
+	Packet::Packet(size_t maxPacketLen, size_t headroom)
 	    : m_RawPacket(nullptr), m_FirstLayer(nullptr), m_LastLayer(nullptr), m_MaxPacketLen(maxPacketLen),
 	      m_FreeRawPacket(true), m_CanReallocateData(true)
 	{
 		timeval time;
 		gettimeofday(&time, nullptr);
-		uint8_t* data = new uint8_t[maxPacketLen];
-		memset(data, 0, maxPacketLen);
-		m_RawPacket = new RawPacket(data, 0, time, true, LINKTYPE_ETHERNET);
+		m_RawPacket = new RawPacket(nullptr, 0, time, true, LINKTYPE_ETHERNET);
+		m_RawPacket->reserveRoom(headroom, maxPacketLen);
 	}
 
 	Packet::Packet(uint8_t* buffer, size_t bufferSize)
@@ -50,16 +51,24 @@ namespace pcpp
 
 		m_FirstLayer = nullptr;
 		m_LastLayer = nullptr;
-		m_MaxPacketLen = rawPacket->getRawDataLen();
 		m_FreeRawPacket = freeRawPacket;
 		m_RawPacket = rawPacket;
 		m_CanReallocateData = true;
 		if (m_RawPacket == nullptr)
+		{
+			m_MaxPacketLen = 0;
 			return;
+		}
+
+		m_MaxPacketLen = m_RawPacket->getRawDataLen() + m_RawPacket->getTailroom();
 
 		LinkLayerType linkType = m_RawPacket->getLinkLayerType();
 
 		m_FirstLayer = createFirstLayer(linkType);
+		if (m_FirstLayer != nullptr)
+		{
+			PCPP_INSTRUMENT_LAYER(m_FirstLayer->getProtocol());
+		}
 
 		m_LastLayer = m_FirstLayer;
 		Layer* curLayer = m_FirstLayer;
@@ -71,7 +80,10 @@ namespace pcpp
 			curLayer->m_IsAllocatedInPacket = true;
 			curLayer = curLayer->getNextLayer();
 			if (curLayer != nullptr)
+			{
+				PCPP_INSTRUMENT_LAYER(curLayer->getProtocol());
 				m_LastLayer = curLayer;
+			}
 		}
 
 		if (curLayer != nullptr && curLayer->isMemberOfProtocolFamily(parseUntil))
@@ -106,6 +118,7 @@ namespace pcpp
 				    (uint8_t*)(m_LastLayer->getData() + m_LastLayer->getDataLen()), trailerLen, m_LastLayer, this);
 
 				trailerLayer->m_IsAllocatedInPacket = true;
+				PCPP_INSTRUMENT_LAYER(PacketTrailer);
 				m_LastLayer->setNextLayer(trailerLayer);
 				m_LastLayer = trailerLayer;
 			}
@@ -175,8 +188,13 @@ namespace pcpp
 	{
 		m_RawPacket = new RawPacket(*(other.m_RawPacket));
 		m_FreeRawPacket = true;
-		m_MaxPacketLen = other.m_MaxPacketLen;
+		// the copy is allocated with the length of the data only
+		m_MaxPacketLen = m_RawPacket->getRawDataLen() + m_RawPacket->getTailroom();
 		m_FirstLayer = createFirstLayer(m_RawPacket->getLinkLayerType());
+		if (m_FirstLayer != nullptr)
+		{
+			PCPP_INSTRUMENT_LAYER(m_FirstLayer->getProtocol());
+		}
 		m_LastLayer = m_FirstLayer;
 		m_CanReallocateData = true;
 		Layer* curLayer = m_FirstLayer;
@@ -186,7 +204,10 @@ namespace pcpp
 			curLayer->m_IsAllocatedInPacket = true;
 			curLayer = curLayer->getNextLayer();
 			if (curLayer != nullptr)
+			{
+				PCPP_INSTRUMENT_LAYER(curLayer->getProtocol());
 				m_LastLayer = curLayer;
+			}
 		}
 	}
 
@@ -205,6 +226,29 @@ namespace pcpp
 		}
 
 		// set all data pointers in layers to the new array address
+		updateLayersDataPtr();
+	}
+
+	bool Packet::reserveHeadroom(size_t headroom)
+	{
+		if (m_RawPacket->getHeadroom() >= headroom)
+			return true;
+
+		if (!m_CanReallocateData)
+			return false;
+
+		PCPP_LOG_DEBUG("Allocating packet headroom of " << headroom << " bytes");
+
+		// keep the room the packet already has after its data
+		if (!m_RawPacket->reserveRoom(headroom, m_MaxPacketLen - m_RawPacket->getRawDataLen()))
+			return false;
+
+		updateLayersDataPtr();
+		return true;
+	}
+
+	void Packet::updateLayersDataPtr()
+	{
 		const uint8_t* dataPtr = m_RawPacket->getRawData();
 
 		Layer* curLayer = m_FirstLayer;
@@ -238,7 +282,12 @@ namespace pcpp
 		}
 
 		size_t newLayerHeaderLen = newLayer->getHeaderLen();
-		if (m_RawPacket->getRawDataLen() + newLayerHeaderLen > m_MaxPacketLen)
+
+		// a layer inserted before the first layer is written to the headroom if there is enough of it, so the packet
+		// data isn't moved
+		bool prependToData =
+		    prevLayer == nullptr && m_FirstLayer != nullptr && m_RawPacket->getHeadroom() >= newLayerHeaderLen;
+		if (!prependToData && m_RawPacket->getRawDataLen() + newLayerHeaderLen > m_MaxPacketLen)
 		{
 			if (!m_CanReallocateData)
 			{
@@ -254,10 +303,22 @@ namespace pcpp
 		}
 
 		// insert layer data to raw packet
-		int indexToInsertData = 0;
-		if (prevLayer != nullptr)
-			indexToInsertData = prevLayer->m_Data + prevLayer->getHeaderLen() - m_RawPacket->getRawData();
-		m_RawPacket->insertData(indexToInsertData, newLayer->m_Data, newLayerHeaderLen);
+		if (prependToData)
+		{
+			if (!m_RawPacket->prependData(newLayer->m_Data, newLayerHeaderLen))
+			{
+				PCPP_LOG_ERROR("Couldn't prepend the new layer to the packet");
+				return false;
+			}
+			m_MaxPacketLen += newLayerHeaderLen;
+		}
+		else
+		{
+			int indexToInsertData = 0;
+			if (prevLayer != nullptr)
+				indexToInsertData = prevLayer->m_Data + prevLayer->getHeaderLen() - m_RawPacket->getRawData();
+			m_RawPacket->insertData(indexToInsertData, newLayer->m_Data, newLayerHeaderLen);
+		}
 
 		// delete previous layer data
 		delete[] newLayer->m_Data;
@@ -429,10 +490,18 @@ namespace pcpp
 		uint8_t* layerOldData = new uint8_t[layerOldDataSize];
 		memcpy(layerOldData, layer->m_Data, layerOldDataSize);
 
-		// remove data from raw packet
+		// remove data from raw packet. The data of the first layer becomes headroom instead of moving the rest of the
+		// packet, unless the raw data is a user buffer without headroom where the data must stay at the start of the
+		// buffer
 		size_t numOfBytesToRemove = headerLen;
 		int indexOfDataToRemove = layer->m_Data - m_RawPacket->getRawData();
-		if (!m_RawPacket->removeData(indexOfDataToRemove, numOfBytesToRemove))
+		bool removeFromStart =
+		    indexOfDataToRemove == 0 && (m_RawPacket->isRawDataOwned() || m_RawPacket->getHeadroom() > 0);
+		bool removed = removeFromStart ? m_RawPacket->removeDataFromStart(numOfBytesToRemove)
+		                               : m_RawPacket->removeData(indexOfDataToRemove, numOfBytesToRemove);
+		if (removed && removeFromStart)
+			m_MaxPacketLen -= std::min(m_MaxPacketLen, numOfBytesToRemove);
+		if (!removed)
 		{
 			PCPP_LOG_ERROR("Couldn't remove data from packet");
 			delete[] layerOldData;
@@ -507,6 +576,48 @@ namespace pcpp
 		return true;
 	}
 
+	bool Packet::encapsulate(const std::vector<Layer*>& outerLayers, bool ownInPacket)
+	{
+		size_t headroom = 0;
+		for (const Layer* layer : outerLayers)
+		{
+			if (layer == nullptr)
+			{
+				PCPP_LOG_ERROR("Layer to add is nullptr");
+				return false;
+			}
+			headroom += layer->getHeaderLen();
+		}
+
+		// if there isn't enough headroom and it can't be allocated the layers are inserted by moving the data
+		reserveHeadroom(headroom);
+
+		for (auto iter = outerLayers.rbegin(); iter != outerLayers.rend(); ++iter)
+		{
+			if (!insertLayer(nullptr, *iter, ownInPacket))
+				return false;
+		}
+
+		return true;
+	}
+
+	bool Packet::decapsulate(Layer* innerLayer)
+	{
+		if (innerLayer == nullptr || innerLayer->m_Packet != this)
+		{
+			PCPP_LOG_ERROR("Layer isn't allocated to this packet");
+			return false;
+		}
+
+		while (m_FirstLayer != innerLayer)
+		{
+			if (!removeLayer(m_FirstLayer, true))
+				return false;
+		}
+
+		return true;
+	}
+
 	Layer* Packet::getLayerOfType(ProtocolType layerType, int index) const
 	{
 		Layer* curLayer = getFirstLayer();
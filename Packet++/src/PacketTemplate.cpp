@@ -0,0 +1,439 @@
+#define LOG_MODULE PacketLogModulePacket
+
+#include "PacketTemplate.h"
+#include "IPv4Layer.h"
+#include "IPv6Layer.h"
+#include "TcpLayer.h"
+#include "UdpLayer.h"
+#include "Logger.h"
+#include "EndianPortable.h"
+#include <algorithm>
+#include <cstring>
+#ifdef _MSC_VER
+#	include "SystemUtils.h"
+#endif
+
+namespace pcpp
+{
+
+	namespace
+	{
+		// The one's complement sum of bytes as 16-bit big-endian words. If isOdd is set the first byte is the low byte
+		// of a word, the carries are folded by the caller
+		uint32_t sumBytes(const uint8_t* data, size_t dataLen, bool isOdd)
+		{
+			uint32_t sum = 0;
+			size_t i = 0;
+			if (isOdd && dataLen > 0)
+			{
+				sum += data[0];
+				i = 1;
+			}
+
+			for (; i + 1 < dataLen; i += 2)
+			{
+				sum += static_cast<uint32_t>(data[i] << 8 | data[i + 1]);
+			}
+
+			if (i < dataLen)
+			{
+				sum += static_cast<uint32_t>(data[i] << 8);
+			}
+
+			return sum;
+		}
+
+		uint16_t foldSum(uint32_t sum)
+		{
+			while (sum >> 16)
+			{
+				sum = (sum & 0xffff) + (sum >> 16);
+			}
+			return static_cast<uint16_t>(sum);
+		}
+	}  // namespace
+
+	PacketTemplate::PacketTemplate(Packet& packet) : m_LinkLayerType(packet.getRawPacketReadOnly()->getLinkLayerType())
+	{
+		packet.computeCalculateFields();
+
+		const RawPacket* rawPacket = packet.getRawPacketReadOnly();
+		m_Data.assign(rawPacket->getRawData(), rawPacket->getRawData() + rawPacket->getRawDataLen());
+		addLayers(packet);
+	}
+
+	void PacketTemplate::addLayers(Packet& packet)
+	{
+		const uint8_t* rawData = packet.getRawPacketReadOnly()->getRawData();
+		const Layer* ipLayer = nullptr;
+		size_t ipEnd = 0;
+
+		for (Layer* layer = packet.getFirstLayer(); layer != nullptr; layer = layer->getNextLayer())
+		{
+			size_t offset = layer->getData() - rawData;
+			ProtocolType protocol = layer->getProtocol();
+			if (protocol == IPv4 && layer->getHeaderLen() >= sizeof(iphdr))
+			{
+				const iphdr* ipHeader = static_cast<IPv4Layer*>(layer)->getIPv4Header();
+				size_t headerLen = layer->getHeaderLen();
+				ipEnd = std::min(offset + be16toh(ipHeader->totalLength), m_Data.size());
+				m_Layers.push_back({ protocol, offset, offset + headerLen, ipEnd });
+				m_Regions.push_back({ offset, offset + headerLen, offset + 10, false, 0, 0, {} });
+				ipLayer = layer;
+			}
+			else if (protocol == IPv6 && layer->getDataLen() >= sizeof(ip6_hdr))
+			{
+				const ip6_hdr* ipHeader = static_cast<IPv6Layer*>(layer)->getIPv6Header();
+				ipEnd = std::min(offset + sizeof(ip6_hdr) + be16toh(ipHeader->payloadLength), m_Data.size());
+				m_Layers.push_back({ protocol, offset, offset + sizeof(ip6_hdr), ipEnd });
+				ipLayer = layer;
+			}
+			else if ((protocol == TCP && layer->getHeaderLen() >= sizeof(tcphdr)) ||
+			         (protocol == UDP && layer->getHeaderLen() >= sizeof(udphdr)))
+			{
+				size_t end = ipEnd;
+				size_t checksumOffset = offset + 16;
+				bool keepZero = false;
+				if (protocol == UDP)
+				{
+					const udphdr* udpHeader = static_cast<UdpLayer*>(layer)->getUdpHeader();
+					end = std::min(offset + be16toh(udpHeader->length), m_Data.size());
+					checksumOffset = offset + 6;
+					keepZero = udpHeader->headerChecksum == 0;
+				}
+				end = std::max(end, offset + layer->getHeaderLen());
+				m_Layers.push_back({ protocol, offset, offset + layer->getHeaderLen(), end });
+
+				// the IP addresses are contiguous in both headers, so they're covered as one range
+				if (ipLayer != nullptr)
+				{
+					size_t ipOffset = ipLayer->getData() - rawData;
+					bool isIPv4 = ipLayer->getProtocol() == IPv4;
+					size_t pseudoHeaderStart = ipOffset + (isIPv4 ? 12 : 8);
+					size_t pseudoHeaderEnd = ipOffset + (isIPv4 ? 20 : 40);
+					m_Regions.push_back(
+					    { offset, end, checksumOffset, keepZero, pseudoHeaderStart, pseudoHeaderEnd, {} });
+				}
+				ipLayer = nullptr;
+			}
+		}
+
+		for (size_t i = 0; i < m_Regions.size(); i++)
+		{
+			for (size_t j = 0; j < m_Regions.size(); j++)
+			{
+				if (i != j && m_Regions[j].start <= m_Regions[i].checksumOffset &&
+				    m_Regions[i].checksumOffset < m_Regions[j].end)
+				{
+					m_Regions[i].outerRegions.push_back(j);
+				}
+			}
+		}
+	}
+
+	int PacketTemplate::addField(const std::string& name, PacketTemplateField field, int layerIndex)
+	{
+		int index = 0;
+		for (const LayerInfo& layer : m_Layers)
+		{
+			bool isIP = layer.protocol == IPv4 || layer.protocol == IPv6;
+			bool isTransport = layer.protocol == TCP || layer.protocol == UDP;
+			bool matches = false;
+			switch (field)
+			{
+			case PacketTemplateField::SrcIP:
+			case PacketTemplateField::DstIP:
+			case PacketTemplateField::Ttl:
+				matches = isIP;
+				break;
+			case PacketTemplateField::IPv4Id:
+				matches = layer.protocol == IPv4;
+				break;
+			case PacketTemplateField::SrcPort:
+			case PacketTemplateField::DstPort:
+			case PacketTemplateField::Payload:
+				matches = isTransport;
+				break;
+			case PacketTemplateField::TcpSequence:
+			case PacketTemplateField::TcpAck:
+				matches = layer.protocol == TCP;
+				break;
+			}
+
+			if (!matches || index++ != layerIndex)
+			{
+				continue;
+			}
+
+			bool isIPv4 = layer.protocol == IPv4;
+			switch (field)
+			{
+			case PacketTemplateField::SrcIP:
+				return addField(name, layer.offset + (isIPv4 ? 12 : 8), isIPv4 ? 4 : 16);
+			case PacketTemplateField::DstIP:
+				return addField(name, layer.offset + (isIPv4 ? 16 : 24), isIPv4 ? 4 : 16);
+			case PacketTemplateField::Ttl:
+				return addField(name, layer.offset + (isIPv4 ? 8 : 7), 1);
+			case PacketTemplateField::IPv4Id:
+				return addField(name, layer.offset + 4, 2);
+			case PacketTemplateField::SrcPort:
+				return addField(name, layer.offset, 2);
+			case PacketTemplateField::DstPort:
+				return addField(name, layer.offset + 2, 2);
+			case PacketTemplateField::TcpSequence:
+				return addField(name, layer.offset + 4, 4);
+			case PacketTemplateField::TcpAck:
+				return addField(name, layer.offset + 8, 4);
+			case PacketTemplateField::Payload:
+				return addField(name, layer.payloadOffset, layer.end - layer.payloadOffset);
+			}
+		}
+
+		PCPP_LOG_ERROR("Cannot add field '" << name << "', the packet has no layer with this field at index "
+		                                    << layerIndex);
+		return -1;
+	}
+
+	int PacketTemplate::addField(const std::string& name, size_t offset, size_t length)
+	{
+		if (getFieldIndex(name) >= 0)
+		{
+			PCPP_LOG_ERROR("Cannot add field '" << name << "', a field with this name already exists");
+			return -1;
+		}
+
+		if (length == 0 || offset + length > m_Data.size())
+		{
+			PCPP_LOG_ERROR("Cannot add field '" << name << "', it's empty or out of the packet");
+			return -1;
+		}
+
+		Field newField;
+		newField.name = name;
+		newField.offset = offset;
+		newField.length = length;
+		size_t end = offset + length;
+		for (size_t i = 0; i < m_Regions.size(); i++)
+		{
+			const ChecksumRegion& region = m_Regions[i];
+			if (offset < region.checksumOffset + 2 && region.checksumOffset < end)
+			{
+				PCPP_LOG_ERROR("Cannot add field '" << name << "', it overlaps a checksum");
+				return -1;
+			}
+
+			size_t coverageStart = std::max(offset, region.start);
+			size_t coverageEnd = std::min(end, region.end);
+			if (coverageStart < coverageEnd)
+			{
+				bool isOdd = (coverageStart - region.start) % 2 == 1;
+				newField.coverages.push_back({ i, coverageStart, coverageEnd, isOdd });
+			}
+
+			coverageStart = std::max(offset, region.pseudoHeaderStart);
+			coverageEnd = std::min(end, region.pseudoHeaderEnd);
+			if (coverageStart < coverageEnd)
+			{
+				bool isOdd = (coverageStart - region.pseudoHeaderStart) % 2 == 1;
+				newField.coverages.push_back({ i, coverageStart, coverageEnd, isOdd });
+			}
+		}
+
+		if (newField.coverages.size() > MaxFieldCoverages)
+		{
+			PCPP_LOG_ERROR("Cannot add field '" << name << "', it's covered by too many checksums");
+			return -1;
+		}
+
+		m_Fields.push_back(newField);
+		return static_cast<int>(m_Fields.size() - 1);
+	}
+
+	int PacketTemplate::getFieldIndex(const std::string& name) const
+	{
+		for (size_t i = 0; i < m_Fields.size(); i++)
+		{
+			if (m_Fields[i].name == name)
+			{
+				return static_cast<int>(i);
+			}
+		}
+		return -1;
+	}
+
+	const PacketTemplate::Field* PacketTemplate::getField(int fieldIndex) const
+	{
+		if (fieldIndex < 0 || static_cast<size_t>(fieldIndex) >= m_Fields.size())
+		{
+			PCPP_LOG_ERROR("Invalid field index " << fieldIndex);
+			return nullptr;
+		}
+		return &m_Fields[fieldIndex];
+	}
+
+	size_t PacketTemplate::getFieldOffset(int fieldIndex) const
+	{
+		const Field* field = getField(fieldIndex);
+		return field != nullptr ? field->offset : 0;
+	}
+
+	size_t PacketTemplate::getFieldLength(int fieldIndex) const
+	{
+		const Field* field = getField(fieldIndex);
+		return field != nullptr ? field->length : 0;
+	}
+
+	void PacketTemplate::writeTo(uint8_t* buffer) const
+	{
+		if (!m_Data.empty())
+		{
+			memcpy(buffer, m_Data.data(), m_Data.size());
+		}
+	}
+
+	bool PacketTemplate::setFieldValue(uint8_t* buffer, int fieldIndex, uint64_t value) const
+	{
+		const Field* field = getField(fieldIndex);
+		if (field == nullptr || field->length > sizeof(value))
+		{
+			return false;
+		}
+
+		uint8_t data[sizeof(value)];
+		for (size_t i = field->length; i > 0; i--)
+		{
+			data[i - 1] = static_cast<uint8_t>(value);
+			value >>= 8;
+		}
+		patch(buffer, *field, data, field->length);
+		return true;
+	}
+
+	bool PacketTemplate::setFieldValue(uint8_t* buffer, int fieldIndex, const IPv4Address& address) const
+	{
+		const Field* field = getField(fieldIndex);
+		if (field == nullptr || field->length != 4)
+		{
+			return false;
+		}
+
+		patch(buffer, *field, address.toBytes(), 4);
+		return true;
+	}
+
+	bool PacketTemplate::setFieldValue(uint8_t* buffer, int fieldIndex, const IPv6Address& address) const
+	{
+		const Field* field = getField(fieldIndex);
+		if (field == nullptr || field->length != 16)
+		{
+			return false;
+		}
+
+		patch(buffer, *field, address.toBytes(), 16);
+		return true;
+	}
+
+	bool PacketTemplate::setFieldData(uint8_t* buffer, int fieldIndex, const uint8_t* data, size_t dataLen) const
+	{
+		const Field* field = getField(fieldIndex);
+		if (field == nullptr || dataLen > field->length)
+		{
+			return false;
+		}
+
+		patch(buffer, *field, data, dataLen);
+		return true;
+	}
+
+	void PacketTemplate::patch(uint8_t* buffer, const Field& field, const uint8_t* data, size_t dataLen) const
+	{
+		// sum the covered bytes before and after they're written, only the written bytes change
+		size_t end = field.offset + dataLen;
+		uint32_t oldSums[MaxFieldCoverages];
+		for (size_t i = 0; i < field.coverages.size(); i++)
+		{
+			const FieldCoverage& coverage = field.coverages[i];
+			size_t coverageEnd = std::min(coverage.end, end);
+			oldSums[i] = coverage.start < coverageEnd
+			                 ? sumBytes(buffer + coverage.start, coverageEnd - coverage.start, coverage.isOdd)
+			                 : 0;
+		}
+
+		memcpy(buffer + field.offset, data, dataLen);
+
+		for (size_t i = 0; i < field.coverages.size(); i++)
+		{
+			const FieldCoverage& coverage = field.coverages[i];
+			size_t coverageEnd = std::min(coverage.end, end);
+			if (coverage.start < coverageEnd)
+			{
+				updateChecksum(buffer, coverage.regionIndex, oldSums[i],
+				               sumBytes(buffer + coverage.start, coverageEnd - coverage.start, coverage.isOdd));
+			}
+		}
+	}
+
+	void PacketTemplate::updateChecksum(uint8_t* buffer, size_t regionIndex, uint32_t oldSum, uint32_t newSum) const
+	{
+		const ChecksumRegion& region = m_Regions[regionIndex];
+		uint8_t* checksumBytes = buffer + region.checksumOffset;
+		uint16_t checksum = static_cast<uint16_t>(checksumBytes[0] << 8 | checksumBytes[1]);
+		if (region.keepZero && checksum == 0)
+		{
+			return;
+		}
+
+		// HC' = ~(~HC + ~m + m') as described in RFC 1624
+		uint32_t sum = static_cast<uint16_t>(~checksum) + static_cast<uint16_t>(~foldSum(oldSum)) + foldSum(newSum);
+		uint16_t newChecksum = static_cast<uint16_t>(~foldSum(sum));
+		if (region.keepZero && newChecksum == 0)
+		{
+			newChecksum = 0xffff;
+		}
+
+		uint8_t oldChecksumBytes[2] = { checksumBytes[0], checksumBytes[1] };
+		checksumBytes[0] = static_cast<uint8_t>(newChecksum >> 8);
+		checksumBytes[1] = static_cast<uint8_t>(newChecksum);
+
+		// the checksum itself is covered by the checksums of outer layers
+		for (size_t outerRegion : region.outerRegions)
+		{
+			bool isOdd = (region.checksumOffset - m_Regions[outerRegion].start) % 2 == 1;
+			uint32_t outerOldSum = sumBytes(oldChecksumBytes, 2, isOdd);
+			updateChecksum(buffer, outerRegion, outerOldSum, sumBytes(checksumBytes, 2, isOdd));
+		}
+	}
+
+	PacketTemplateBatch::PacketTemplateBatch(const PacketTemplate& packetTemplate, size_t batchSize)
+	    : m_PacketTemplate(packetTemplate), m_Buffer(packetTemplate.getDataLen() * batchSize)
+	{
+		timeval time;
+		gettimeofday(&time, nullptr);
+
+		m_RawPackets.reserve(batchSize);
+		for (size_t i = 0; i < batchSize; i++)
+		{
+			m_RawPackets.emplace_back(getPacketData(i), static_cast<int>(packetTemplate.getDataLen()), time, false,
+			                          packetTemplate.getLinkLayerType());
+		}
+
+		reset();
+	}
+
+	void PacketTemplateBatch::reset()
+	{
+		for (size_t i = 0; i < m_RawPackets.size(); i++)
+		{
+			m_PacketTemplate.writeTo(getPacketData(i));
+		}
+	}
+
+	void PacketTemplateBatch::setTimestamp(timespec timestamp)
+	{
+		for (RawPacket& rawPacket : m_RawPackets)
+		{
+			rawPacket.setPacketTimeStamp(timestamp);
+		}
+	}
+
+}  // namespace pcpp
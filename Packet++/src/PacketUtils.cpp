@@ -5,6 +5,8 @@
 #include "UdpLayer.h"
 #include "Logger.h"
 #include "EndianPortable.h"
+#include <string.h>
+#include <utility>
 
 namespace pcpp
 {
@@ -244,4 +246,346 @@ namespace pcpp
 		return pcpp::fnvHash(vec, 2);
 	}
 
+	namespace
+	{
+		const uint64_t HashSecret0 = 0xA0761D6478BD642FULL;
+		const uint64_t HashSecret1 = 0xE7037ED1A0B428DBULL;
+		const uint64_t HashSecret2 = 0x8EBC6AF09C88C6E3ULL;
+		const uint64_t HashSecret3 = 0x589965CC75374CC3ULL;
+
+		// Multiply a and b into a 128bit result, a gets its low half and b its high half
+		inline void multiply128(uint64_t& a, uint64_t& b)
+		{
+#if defined(__SIZEOF_INT128__)
+			__uint128_t result = a;
+			result *= b;
+			a = static_cast<uint64_t>(result);
+			b = static_cast<uint64_t>(result >> 64);
+#else
+			uint64_t aHigh = a >> 32, aLow = static_cast<uint32_t>(a);
+			uint64_t bHigh = b >> 32, bLow = static_cast<uint32_t>(b);
+			uint64_t highHigh = aHigh * bHigh, highLow = aHigh * bLow;
+			uint64_t lowHigh = aLow * bHigh, lowLow = aLow * bLow;
+			uint64_t middle = (lowLow >> 32) + static_cast<uint32_t>(highLow) + static_cast<uint32_t>(lowHigh);
+			a = (middle << 32) | static_cast<uint32_t>(lowLow);
+			b = highHigh + (highLow >> 32) + (lowHigh >> 32) + (middle >> 32);
+#endif
+		}
+
+		inline uint64_t mix(uint64_t a, uint64_t b)
+		{
+			multiply128(a, b);
+			return a ^ b;
+		}
+
+		// The reads are little endian so hash values are the same on all platforms
+		inline uint64_t read64(const uint8_t* data)
+		{
+			uint64_t value;
+			memcpy(&value, data, sizeof(value));
+			return le64toh(value);
+		}
+
+		inline uint64_t read32(const uint8_t* data)
+		{
+			uint32_t value;
+			memcpy(&value, data, sizeof(value));
+			return le32toh(value);
+		}
+
+		inline uint64_t finalizeHash(uint64_t a, uint64_t b, uint64_t seed, uint64_t len)
+		{
+			a ^= HashSecret1;
+			b ^= seed;
+			multiply128(a, b);
+			return mix(a ^ HashSecret0 ^ len, b ^ HashSecret1);
+		}
+	}  // namespace
+
+	uint64_t hash64(const uint8_t* buffer, size_t bufSize, uint64_t seed)
+	{
+		const uint8_t* data = buffer;
+		seed ^= mix(seed ^ HashSecret0, HashSecret1);
+
+		uint64_t a, b;
+		if (bufSize <= 16)
+		{
+			if (bufSize >= 4)
+			{
+				// two overlapping 4-byte reads from each end cover the whole buffer
+				size_t offset = (bufSize >> 3) << 2;
+				a = (read32(data) << 32) | read32(data + offset);
+				b = (read32(data + bufSize - 4) << 32) | read32(data + bufSize - 4 - offset);
+			}
+			else if (bufSize > 0)
+			{
+				a = (static_cast<uint64_t>(data[0]) << 16) | (static_cast<uint64_t>(data[bufSize >> 1]) << 8) |
+				    data[bufSize - 1];
+				b = 0;
+			}
+			else
+			{
+				a = b = 0;
+			}
+		}
+		else
+		{
+			size_t remaining = bufSize;
+			if (remaining > 48)
+			{
+				// three independent lanes so the multiplications can run in parallel
+				uint64_t seed1 = seed, seed2 = seed;
+				do
+				{
+					seed = mix(read64(data) ^ HashSecret1, read64(data + 8) ^ seed);
+					seed1 = mix(read64(data + 16) ^ HashSecret2, read64(data + 24) ^ seed1);
+					seed2 = mix(read64(data + 32) ^ HashSecret3, read64(data + 40) ^ seed2);
+					data += 48;
+					remaining -= 48;
+				} while (remaining > 48);
+				seed ^= seed1 ^ seed2;
+			}
+
+			while (remaining > 16)
+			{
+				seed = mix(read64(data) ^ HashSecret1, read64(data + 8) ^ seed);
+				data += 16;
+				remaining -= 16;
+			}
+
+			// the last 16 bytes of the buffer, they may overlap bytes that were already hashed
+			a = read64(data + remaining - 16);
+			b = read64(data + remaining - 8);
+		}
+
+		return finalizeHash(a, b, seed, bufSize);
+	}
+
+	uint64_t hash5Tuple64(const uint8_t* srcIP, const uint8_t* dstIP, size_t ipLen, uint16_t srcPort,
+	                      uint16_t dstPort, uint8_t protocol, bool directionUnique)
+	{
+		if (!directionUnique)
+		{
+			// order the endpoints so both directions hash the same input
+			int ipCompare = memcmp(srcIP, dstIP, ipLen);
+			if (ipCompare > 0 || (ipCompare == 0 && srcPort > dstPort))
+			{
+				std::swap(srcIP, dstIP);
+				std::swap(srcPort, dstPort);
+			}
+		}
+
+		uint64_t portsAndProtocol = (static_cast<uint64_t>(srcPort) << 48) | (static_cast<uint64_t>(dstPort) << 32) |
+		                            (static_cast<uint64_t>(protocol) << 8) | ipLen;
+
+		if (ipLen == 4)
+		{
+			return finalizeHash((read32(srcIP) << 32) | read32(dstIP), portsAndProtocol, HashSecret2, 12);
+		}
+
+		uint64_t srcHash = mix(read64(srcIP) ^ HashSecret1, read64(srcIP + 8) ^ HashSecret2);
+		uint64_t dstHash = mix(read64(dstIP) ^ HashSecret3, read64(dstIP + 8) ^ HashSecret0);
+		return finalizeHash(srcHash, portsAndProtocol ^ dstHash, HashSecret2, 36);
+	}
+
+	uint64_t hash5Tuple64(Packet* packet, bool directionUnique)
+	{
+		if (!packet->isPacketOfType(IPv4) && !packet->isPacketOfType(IPv6))
+			return 0;
+
+		if (packet->isPacketOfType(ICMP))
+			return 0;
+
+		uint16_t portSrc, portDst;
+		TcpLayer* tcpLayer = packet->getLayerOfType<TcpLayer>(true);  // lookup in reverse order
+		if (tcpLayer != nullptr)
+		{
+			portSrc = tcpLayer->getTcpHeader()->portSrc;
+			portDst = tcpLayer->getTcpHeader()->portDst;
+		}
+		else
+		{
+			UdpLayer* udpLayer = packet->getLayerOfType<UdpLayer>(true);
+			if (udpLayer == nullptr)
+				return 0;
+
+			portSrc = udpLayer->getUdpHeader()->portSrc;
+			portDst = udpLayer->getUdpHeader()->portDst;
+		}
+
+		IPv4Layer* ipv4Layer = packet->getLayerOfType<IPv4Layer>();
+		if (ipv4Layer != nullptr)
+		{
+			iphdr* ipHeader = ipv4Layer->getIPv4Header();
+			return hash5Tuple64(reinterpret_cast<uint8_t*>(&ipHeader->ipSrc),
+			                    reinterpret_cast<uint8_t*>(&ipHeader->ipDst), 4, be16toh(portSrc), be16toh(portDst),
+			                    ipHeader->protocol, directionUnique);
+		}
+
+		ip6_hdr* ipHeader = packet->getLayerOfType<IPv6Layer>()->getIPv6Header();
+		return hash5Tuple64(ipHeader->ipSrc, ipHeader->ipDst, 16, be16toh(portSrc), be16toh(portDst),
+		                    ipHeader->nextHeader, directionUnique);
+	}
+
+	uint64_t hash2Tuple64(Packet* packet)
+	{
+		const uint8_t* srcIP;
+		const uint8_t* dstIP;
+		size_t ipLen;
+
+		IPv4Layer* ipv4Layer = packet->getLayerOfType<IPv4Layer>();
+		if (ipv4Layer != nullptr)
+		{
+			srcIP = reinterpret_cast<uint8_t*>(&ipv4Layer->getIPv4Header()->ipSrc);
+			dstIP = reinterpret_cast<uint8_t*>(&ipv4Layer->getIPv4Header()->ipDst);
+			ipLen = 4;
+		}
+		else
+		{
+			IPv6Layer* ipv6Layer = packet->getLayerOfType<IPv6Layer>();
+			if (ipv6Layer == nullptr)
+				return 0;
+
+			srcIP = ipv6Layer->getIPv6Header()->ipSrc;
+			dstIP = ipv6Layer->getIPv6Header()->ipDst;
+			ipLen = 16;
+		}
+
+		if (memcmp(srcIP, dstIP, ipLen) > 0)
+			std::swap(srcIP, dstIP);
+
+		// hashed as a 5-tuple with protocol and ports 0
+		return hash5Tuple64(srcIP, dstIP, ipLen, 0, 0, 0, true);
+	}
+
+	constexpr size_t ToeplitzHash::DefaultKeyLength;
+
+	const uint8_t ToeplitzHash::DefaultKey[ToeplitzHash::DefaultKeyLength] = {
+		0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A,
+		0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A,
+		0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A,
+	};
+
+	ToeplitzHash::ToeplitzHash(const uint8_t* key, size_t keyLength)
+	{
+		if (key == nullptr)
+		{
+			key = DefaultKey;
+			keyLength = DefaultKeyLength;
+		}
+		else if (keyLength < 5)
+		{
+			PCPP_LOG_ERROR("Toeplitz key length must be at least 5 bytes, using the default key");
+			key = DefaultKey;
+			keyLength = DefaultKeyLength;
+		}
+
+		m_MaxInputLength = keyLength - 4;
+		m_Table.resize(m_MaxInputLength * 256);
+
+		for (size_t offset = 0; offset < m_MaxInputLength; offset++)
+		{
+			// the 40 key bits that the 8 bits of the input byte at this offset are multiplied with
+			uint64_t keyBits = (static_cast<uint64_t>(key[offset]) << 32) |
+			                   (static_cast<uint64_t>(key[offset + 1]) << 24) |
+			                   (static_cast<uint64_t>(key[offset + 2]) << 16) |
+			                   (static_cast<uint64_t>(key[offset + 3]) << 8) | key[offset + 4];
+
+			uint32_t* byteTable = &m_Table[offset * 256];
+			for (int byteValue = 0; byteValue < 256; byteValue++)
+			{
+				uint32_t result = 0;
+				for (int bit = 0; bit < 8; bit++)
+				{
+					if (byteValue & (0x80 >> bit))
+						result ^= static_cast<uint32_t>(keyBits >> (8 - bit));
+				}
+				byteTable[byteValue] = result;
+			}
+		}
+	}
+
+	uint32_t ToeplitzHash::hash(const uint8_t* buffer, size_t bufSize) const
+	{
+		if (bufSize > m_MaxInputLength)
+		{
+			PCPP_LOG_ERROR("Toeplitz hash input of " << bufSize << " bytes is longer than the maximum of "
+			                                         << m_MaxInputLength << " bytes for this key");
+			return 0;
+		}
+
+		uint32_t result = 0;
+		const uint32_t* byteTable = m_Table.data();
+		for (size_t i = 0; i < bufSize; i++, byteTable += 256)
+		{
+			result ^= byteTable[buffer[i]];
+		}
+		return result;
+	}
+
+	uint32_t ToeplitzHash::hash5Tuple(Packet* packet) const
+	{
+		uint8_t input[36];
+		size_t ipLen;
+
+		IPv4Layer* ipv4Layer = packet->getLayerOfType<IPv4Layer>();
+		IPv6Layer* ipv6Layer = nullptr;
+		if (ipv4Layer != nullptr)
+		{
+			memcpy(input, &ipv4Layer->getIPv4Header()->ipSrc, 4);
+			memcpy(input + 4, &ipv4Layer->getIPv4Header()->ipDst, 4);
+			ipLen = 4;
+		}
+		else
+		{
+			ipv6Layer = packet->getLayerOfType<IPv6Layer>();
+			if (ipv6Layer == nullptr)
+				return 0;
+
+			memcpy(input, ipv6Layer->getIPv6Header()->ipSrc, 16);
+			memcpy(input + 16, ipv6Layer->getIPv6Header()->ipDst, 16);
+			ipLen = 16;
+		}
+
+		// the ports are copied in network byte order, as they appear in the packet
+		TcpLayer* tcpLayer = packet->getLayerOfType<TcpLayer>();
+		if (tcpLayer != nullptr)
+		{
+			memcpy(input + 2 * ipLen, &tcpLayer->getTcpHeader()->portSrc, 2);
+			memcpy(input + 2 * ipLen + 2, &tcpLayer->getTcpHeader()->portDst, 2);
+		}
+		else
+		{
+			UdpLayer* udpLayer = packet->getLayerOfType<UdpLayer>();
+			if (udpLayer == nullptr)
+				return 0;
+
+			memcpy(input + 2 * ipLen, &udpLayer->getUdpHeader()->portSrc, 2);
+			memcpy(input + 2 * ipLen + 2, &udpLayer->getUdpHeader()->portDst, 2);
+		}
+
+		return hash(input, 2 * ipLen + 4);
+	}
+
+	uint32_t ToeplitzHash::hash2Tuple(Packet* packet) const
+	{
+		IPv4Layer* ipv4Layer = packet->getLayerOfType<IPv4Layer>();
+		if (ipv4Layer != nullptr)
+		{
+			uint8_t input[8];
+			memcpy(input, &ipv4Layer->getIPv4Header()->ipSrc, 4);
+			memcpy(input + 4, &ipv4Layer->getIPv4Header()->ipDst, 4);
+			return hash(input, sizeof(input));
+		}
+
+		IPv6Layer* ipv6Layer = packet->getLayerOfType<IPv6Layer>();
+		if (ipv6Layer == nullptr)
+			return 0;
+
+		uint8_t input[32];
+		memcpy(input, ipv6Layer->getIPv6Header()->ipSrc, 16);
+		memcpy(input + 16, ipv6Layer->getIPv6Header()->ipDst, 16);
+		return hash(input, sizeof(input));
+	}
+
 }  // namespace pcpp
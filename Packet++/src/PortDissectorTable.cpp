@@ -0,0 +1,249 @@
+#define LOG_MODULE PacketLogModuleLayer
+
+#include "PortDissectorTable.h"
+#include "Logger.h"
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+#if defined(_MSC_VER)
+#	include <intrin.h>
+#endif
+
+namespace pcpp
+{
+
+	namespace
+	{
+		inline size_t lowestSetBit(uint64_t value)
+		{
+#if defined(_MSC_VER) && defined(_M_X64)
+			unsigned long index;
+			_BitScanForward64(&index, value);
+			return static_cast<size_t>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+			return static_cast<size_t>(__builtin_ctzll(value));
+#else
+			size_t index = 0;
+			while ((value & 1) == 0)
+			{
+				value >>= 1;
+				index++;
+			}
+			return index;
+#endif
+		}
+	}  // namespace
+
+	constexpr size_t PortDissectorTable::MaxDissectors;
+
+	PortDissectorTable::PortDissectorTable()
+	    : m_PortToMaskIndex(std::numeric_limits<uint16_t>::max() + 1, 0), m_CandidateMasks(1, 0), m_HeuristicMask(0)
+	{}
+
+	bool PortDissectorTable::registerDissector(const std::string& name, int priority, DissectorFunc dissector,
+	                                           const std::vector<uint16_t>& ports)
+	{
+		if (ports.empty())
+		{
+			PCPP_LOG_ERROR("Cannot register dissector '" << name << "' without ports");
+			return false;
+		}
+
+		return addDissector({ name, priority, dissector, ports, false, true });
+	}
+
+	bool PortDissectorTable::registerHeuristicDissector(const std::string& name, int priority, DissectorFunc dissector)
+	{
+		return addDissector({ name, priority, dissector, {}, true, true });
+	}
+
+	bool PortDissectorTable::addDissector(DissectorEntry&& entry)
+	{
+		if (entry.dissector == nullptr)
+		{
+			PCPP_LOG_ERROR("Cannot register dissector '" << entry.name << "' without a dissector function");
+			return false;
+		}
+
+		if (findDissector(entry.name) != m_Dissectors.end())
+		{
+			PCPP_LOG_ERROR("A dissector named '" << entry.name << "' is already registered");
+			return false;
+		}
+
+		if (m_Dissectors.size() >= MaxDissectors)
+		{
+			PCPP_LOG_ERROR("Cannot register dissector '" << entry.name << "', the table already has " << MaxDissectors
+			                                             << " dissectors");
+			return false;
+		}
+
+		// insert after all dissectors with the same or a lower priority, to keep the registration order on ties
+		auto insertPos =
+		    std::upper_bound(m_Dissectors.begin(), m_Dissectors.end(), entry.priority,
+		                     [](int priority, const DissectorEntry& other) { return priority < other.priority; });
+		m_Dissectors.insert(insertPos, std::move(entry));
+		rebuild();
+		return true;
+	}
+
+	bool PortDissectorTable::unregisterDissector(const std::string& name)
+	{
+		auto dissectorIter = findDissector(name);
+		if (dissectorIter == m_Dissectors.end())
+		{
+			return false;
+		}
+
+		m_Dissectors.erase(dissectorIter);
+		rebuild();
+		return true;
+	}
+
+	bool PortDissectorTable::setDissectorEnabled(const std::string& name, bool enabled)
+	{
+		auto dissectorIter = findDissector(name);
+		if (dissectorIter == m_Dissectors.end())
+		{
+			return false;
+		}
+
+		if (dissectorIter->isEnabled != enabled)
+		{
+			dissectorIter->isEnabled = enabled;
+			rebuild();
+		}
+
+		return true;
+	}
+
+	bool PortDissectorTable::isDissectorEnabled(const std::string& name) const
+	{
+		auto dissectorIter = findDissector(name);
+		return dissectorIter != m_Dissectors.end() && dissectorIter->isEnabled;
+	}
+
+	bool PortDissectorTable::isDissectorRegistered(const std::string& name) const
+	{
+		return findDissector(name) != m_Dissectors.end();
+	}
+
+	std::vector<std::string> PortDissectorTable::getDissectorNames() const
+	{
+		std::vector<std::string> result;
+		result.reserve(m_Dissectors.size());
+		for (const auto& dissector : m_Dissectors)
+		{
+			result.push_back(dissector.name);
+		}
+
+		return result;
+	}
+
+	size_t PortDissectorTable::getDissectorCount(uint16_t port) const
+	{
+		uint64_t candidates = m_CandidateMasks[m_PortToMaskIndex[port]] | m_HeuristicMask;
+		size_t count = 0;
+		for (; candidates != 0; candidates &= candidates - 1)
+		{
+			count++;
+		}
+
+		return count;
+	}
+
+	std::vector<uint16_t> PortDissectorTable::getMatchingPorts(bool (*isPort)(uint16_t port))
+	{
+		std::vector<uint16_t> result;
+		for (uint32_t port = 0; port <= std::numeric_limits<uint16_t>::max(); port++)
+		{
+			if (isPort(static_cast<uint16_t>(port)))
+			{
+				result.push_back(static_cast<uint16_t>(port));
+			}
+		}
+
+		return result;
+	}
+
+	Layer* PortDissectorTable::dissect(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet,
+	                                   uint16_t srcPort, uint16_t dstPort) const
+	{
+		uint64_t candidates = m_CandidateMasks[m_PortToMaskIndex[srcPort]] |
+		                      m_CandidateMasks[m_PortToMaskIndex[dstPort]] | m_HeuristicMask;
+		while (candidates != 0)
+		{
+			// the lowest bit belongs to the candidate with the lowest priority
+			const DissectorEntry& entry = m_Dissectors[lowestSetBit(candidates)];
+			candidates &= candidates - 1;
+
+			Layer* layer = entry.dissector(data, dataLen, prevLayer, packet, srcPort, dstPort);
+			if (layer != nullptr)
+			{
+				return layer;
+			}
+		}
+
+		return nullptr;
+	}
+
+	std::vector<PortDissectorTable::DissectorEntry>::iterator PortDissectorTable::findDissector(
+	    const std::string& name)
+	{
+		return std::find_if(m_Dissectors.begin(), m_Dissectors.end(),
+		                    [&name](const DissectorEntry& entry) { return entry.name == name; });
+	}
+
+	std::vector<PortDissectorTable::DissectorEntry>::const_iterator PortDissectorTable::findDissector(
+	    const std::string& name) const
+	{
+		return std::find_if(m_Dissectors.begin(), m_Dissectors.end(),
+		                    [&name](const DissectorEntry& entry) { return entry.name == name; });
+	}
+
+	void PortDissectorTable::rebuild()
+	{
+		m_HeuristicMask = 0;
+		std::vector<uint64_t> portMasks(m_PortToMaskIndex.size(), 0);
+		for (size_t i = 0; i < m_Dissectors.size(); i++)
+		{
+			const DissectorEntry& entry = m_Dissectors[i];
+			if (!entry.isEnabled)
+			{
+				continue;
+			}
+
+			uint64_t dissectorBit = static_cast<uint64_t>(1) << i;
+			if (entry.isHeuristic)
+			{
+				m_HeuristicMask |= dissectorBit;
+				continue;
+			}
+
+			for (auto port : entry.ports)
+			{
+				portMasks[port] |= dissectorBit;
+			}
+		}
+
+		// ports with the same candidates share a mask, so the table stays 2 bytes per port
+		m_CandidateMasks.assign(1, 0);
+		std::unordered_map<uint64_t, uint16_t> maskToIndex = {
+			{ 0, 0 }
+		};
+		for (size_t port = 0; port < portMasks.size(); port++)
+		{
+			auto maskIter = maskToIndex.find(portMasks[port]);
+			if (maskIter == maskToIndex.end())
+			{
+				maskIter =
+				    maskToIndex.emplace(portMasks[port], static_cast<uint16_t>(m_CandidateMasks.size())).first;
+				m_CandidateMasks.push_back(portMasks[port]);
+			}
+
+			m_PortToMaskIndex[port] = maskIter->second;
+		}
+	}
+
+}  // namespace pcpp
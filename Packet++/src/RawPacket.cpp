@@ -2,7 +2,9 @@
 
 #include "RawPacket.h"
 #include "Logger.h"
+#include "Instrumentation.h"
 #include "TimespecTimeval.h"
+#include <algorithm>
 #include <cstring>
 
 namespace pcpp
@@ -13,6 +15,8 @@ namespace pcpp
 		m_RawData = nullptr;
 		m_RawDataLen = 0;
 		m_FrameLength = 0;
+		m_Headroom = 0;
+		m_Tailroom = 0;
 		m_DeleteRawDataAtDestructor = deleteRawDataAtDestructor;
 		m_RawPacketSet = false;
 		m_LinkLayerType = LINKTYPE_ETHERNET;
@@ -43,13 +47,15 @@ namespace pcpp
 	{
 		if (m_DeleteRawDataAtDestructor)
 		{
-			delete[] m_RawData;
+			delete[] (m_RawData - m_Headroom);
 		}
 	}
 
 	RawPacket::RawPacket(const RawPacket& other)
 	{
 		m_RawData = nullptr;
+		m_Headroom = 0;
+		m_Tailroom = 0;
 		copyDataFrom(other, true);
 	}
 
@@ -58,7 +64,7 @@ namespace pcpp
 		if (this != &other)
 		{
 			if (m_RawData != nullptr)
-				delete[] m_RawData;
+				delete[] (m_RawData - m_Headroom);
 
 			m_RawPacketSet = false;
 
@@ -85,9 +91,13 @@ namespace pcpp
 			m_DeleteRawDataAtDestructor = true;
 			m_RawData = new uint8_t[other.m_RawDataLen];
 			m_RawDataLen = other.m_RawDataLen;
+			m_Headroom = 0;
+			m_Tailroom = 0;
 		}
 
 		memcpy(m_RawData, other.m_RawData, other.m_RawDataLen);
+		PCPP_INSTRUMENT_COUNT(RawPacketCopies, 1);
+		PCPP_INSTRUMENT_COUNT(RawPacketBytesCopied, other.m_RawDataLen);
 		m_LinkLayerType = other.m_LinkLayerType;
 		m_FrameLength = other.m_FrameLength;
 		m_RawPacketSet = true;
@@ -109,11 +119,13 @@ namespace pcpp
 		m_FrameLength = frameLength;
 		if (m_RawData != nullptr && m_DeleteRawDataAtDestructor)
 		{
-			delete[] m_RawData;
+			delete[] (m_RawData - m_Headroom);
 		}
 
 		m_RawData = (uint8_t*)pRawData;
 		m_RawDataLen = rawDataLen;
+		m_Headroom = 0;
+		m_Tailroom = 0;
 		m_TimeStamp = timestamp;
 		m_RawPacketSet = true;
 		m_LinkLayerType = layerType;
@@ -127,14 +139,34 @@ namespace pcpp
 		return setRawData(pRawData, rawDataLen, timestamp, layerType);
 	}
 
+	bool RawPacket::setOwnedRawData(uint8_t* pRawData, int rawDataLen, timeval timestamp, LinkLayerType layerType,
+	                                int frameLength)
+	{
+		timespec nsec_time;
+		TIMEVAL_TO_TIMESPEC(&timestamp, &nsec_time);
+		return setOwnedRawData(pRawData, rawDataLen, nsec_time, layerType, frameLength);
+	}
+
+	bool RawPacket::setOwnedRawData(uint8_t* pRawData, int rawDataLen, timespec timestamp, LinkLayerType layerType,
+	                                int frameLength)
+	{
+		if (!RawPacket::setRawData(pRawData, rawDataLen, timestamp, layerType, frameLength))
+			return false;
+
+		m_DeleteRawDataAtDestructor = true;
+		return true;
+	}
+
 	void RawPacket::clear()
 	{
-		if (m_RawData != nullptr)
-			delete[] m_RawData;
+		if (m_RawData != nullptr && m_DeleteRawDataAtDestructor)
+			delete[] (m_RawData - m_Headroom);
 
 		m_RawData = nullptr;
 		m_RawDataLen = 0;
 		m_FrameLength = 0;
+		m_Headroom = 0;
+		m_Tailroom = 0;
 		m_RawPacketSet = false;
 	}
 
@@ -143,6 +175,7 @@ namespace pcpp
 		memcpy((uint8_t*)m_RawData + m_RawDataLen, dataToAppend, dataToAppendLen);
 		m_RawDataLen += dataToAppendLen;
 		m_FrameLength = m_RawDataLen;
+		m_Tailroom -= std::min(m_Tailroom, dataToAppendLen);
 	}
 
 	void RawPacket::insertData(int atIndex, const uint8_t* dataToInsert, size_t dataToInsertLen)
@@ -160,6 +193,67 @@ namespace pcpp
 
 		m_RawDataLen += dataToInsertLen;
 		m_FrameLength = m_RawDataLen;
+		m_Tailroom -= std::min(m_Tailroom, dataToInsertLen);
+	}
+
+	bool RawPacket::prependData(const uint8_t* dataToPrepend, size_t dataToPrependLen)
+	{
+		if (dataToPrependLen > m_Headroom)
+		{
+			PCPP_LOG_ERROR("Cannot prepend " << dataToPrependLen << " bytes, the headroom is only " << m_Headroom
+			                                 << " bytes");
+			return false;
+		}
+
+		m_RawData -= dataToPrependLen;
+		m_Headroom -= dataToPrependLen;
+		if (dataToPrepend != nullptr)
+		{
+			memcpy(m_RawData, dataToPrepend, dataToPrependLen);
+		}
+
+		m_RawDataLen += dataToPrependLen;
+		m_FrameLength = m_RawDataLen;
+		return true;
+	}
+
+	bool RawPacket::removeDataFromStart(size_t numOfBytesToRemove)
+	{
+		if ((int)numOfBytesToRemove > m_RawDataLen)
+		{
+			PCPP_LOG_ERROR("Remove section is out of raw packet bound");
+			return false;
+		}
+
+		// the removed bytes become headroom, no data is moved
+		m_RawData += numOfBytesToRemove;
+		m_Headroom += numOfBytesToRemove;
+		m_RawDataLen -= numOfBytesToRemove;
+		m_FrameLength = m_RawDataLen;
+		return true;
+	}
+
+	bool RawPacket::reserveRoom(size_t headroom, size_t tailroom)
+	{
+		if (headroom <= m_Headroom && tailroom <= m_Tailroom)
+			return true;
+
+		size_t newHeadroom = std::max(headroom, m_Headroom);
+		size_t newTailroom = std::max(tailroom, m_Tailroom);
+		size_t newBufferLength = newHeadroom + m_RawDataLen + newTailroom;
+		uint8_t* newBuffer = new uint8_t[newBufferLength];
+		memset(newBuffer, 0, newBufferLength);
+		if (m_RawDataLen > 0)
+			memcpy(newBuffer + newHeadroom, m_RawData, m_RawDataLen);
+		if (m_DeleteRawDataAtDestructor)
+			delete[] (m_RawData - m_Headroom);
+
+		m_DeleteRawDataAtDestructor = true;
+		m_RawData = newBuffer + newHeadroom;
+		m_Headroom = newHeadroom;
+		m_Tailroom = newTailroom;
+
+		return true;
 	}
 
 	bool RawPacket::reallocateData(size_t newBufferLength)
@@ -174,14 +268,16 @@ namespace pcpp
 			return false;
 		}
 
-		uint8_t* newBuffer = new uint8_t[newBufferLength];
-		memset(newBuffer, 0, newBufferLength);
-		memcpy(newBuffer, m_RawData, m_RawDataLen);
+		// the headroom is kept so headers can still be prepended without moving the data
+		uint8_t* newBuffer = new uint8_t[m_Headroom + newBufferLength];
+		memset(newBuffer, 0, m_Headroom + newBufferLength);
+		memcpy(newBuffer + m_Headroom, m_RawData, m_RawDataLen);
 		if (m_DeleteRawDataAtDestructor)
-			delete[] m_RawData;
+			delete[] (m_RawData - m_Headroom);
 
 		m_DeleteRawDataAtDestructor = true;
-		m_RawData = newBuffer;
+		m_RawData = newBuffer + m_Headroom;
+		m_Tailroom = newBufferLength - m_RawDataLen;
 
 		return true;
 	}
@@ -205,6 +301,7 @@ namespace pcpp
 
 		m_RawDataLen -= numOfBytesToRemove;
 		m_FrameLength = m_RawDataLen;
+		m_Tailroom += numOfBytesToRemove;
 		return true;
 	}
 
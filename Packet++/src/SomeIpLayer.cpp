@@ -95,9 +95,7 @@ namespace pcpp
 
 	bool SomeIpLayer::isSomeIpPort(uint16_t port)
 	{
-		return SomeIpSdLayer::isSomeIpSdPort(port) ||
-		       std::any_of(m_SomeIpPorts.begin(), m_SomeIpPorts.end(),
-		                   [&](const uint16_t& someIpPort) { return someIpPort == port; });
+		return SomeIpSdLayer::isSomeIpSdPort(port) || m_SomeIpPorts.find(port) != m_SomeIpPorts.end();
 	}
 
 	void SomeIpLayer::addSomeIpPort(uint16_t port)
@@ -0,0 +1,988 @@
+#define LOG_MODULE PacketLogModuleSSLLayer
+
+#include "TLSFingerprint.h"
+#include "Logger.h"
+#include "md5.h"
+#include <algorithm>
+#include <cstring>
+
+namespace pcpp
+{
+
+	constexpr size_t TLSClientHelloFingerprint::MaxJa3Length;
+	constexpr size_t TLSClientHelloFingerprint::MaxJa4ListSize;
+	constexpr size_t TLSServerHelloFingerprint::MaxJa3sLength;
+
+	namespace
+	{
+
+		const uint8_t TlsRecordTypeHandshake = 22;
+		const uint8_t TlsHandshakeTypeClientHello = 1;
+		const uint8_t TlsHandshakeTypeServerHello = 2;
+		const size_t TlsRecordHeaderLength = 5;
+		const size_t TlsHandshakeHeaderLength = 4;
+		const size_t TlsRandomLength = 32;
+
+		const uint16_t ExtensionServerName = 0x0000;
+		const uint16_t ExtensionSupportedGroups = 0x000a;
+		const uint16_t ExtensionECPointFormats = 0x000b;
+		const uint16_t ExtensionSignatureAlgorithms = 0x000d;
+		const uint16_t ExtensionALPN = 0x0010;
+		const uint16_t ExtensionSupportedVersions = 0x002b;
+
+		const char HexDigits[] = "0123456789abcdef";
+
+		inline uint16_t readUInt16(const uint8_t* data)
+		{
+			return static_cast<uint16_t>((data[0] << 8) | data[1]);
+		}
+
+		inline size_t readUInt24(const uint8_t* data)
+		{
+			return (static_cast<size_t>(data[0]) << 16) | (static_cast<size_t>(data[1]) << 8) | data[2];
+		}
+
+		// GREASE values (RFC 8701) are 0x0a0a, 0x1a1a, ..., 0xfafa
+		inline bool isGrease(uint16_t value)
+		{
+			return (value & 0x0f0f) == 0x0a0a && (value >> 8) == (value & 0xff);
+		}
+
+		/**
+		 * A bounds-checked cursor over raw message data
+		 */
+		struct ByteReader
+		{
+			const uint8_t* cur;
+			const uint8_t* end;
+
+			ByteReader() : cur(nullptr), end(nullptr)
+			{}
+
+			ByteReader(const uint8_t* data, size_t dataLen) : cur(data), end(data + dataLen)
+			{}
+
+			size_t remaining() const
+			{
+				return static_cast<size_t>(end - cur);
+			}
+
+			bool readUInt8(uint8_t& value)
+			{
+				if (remaining() < 1)
+					return false;
+				value = *cur++;
+				return true;
+			}
+
+			bool readUInt16(uint16_t& value)
+			{
+				if (remaining() < 2)
+					return false;
+				value = pcpp::readUInt16(cur);
+				cur += 2;
+				return true;
+			}
+
+			bool skip(size_t len)
+			{
+				if (remaining() < len)
+					return false;
+				cur += len;
+				return true;
+			}
+
+			// split the next len bytes into their own reader
+			bool readBlock(size_t len, ByteReader& block)
+			{
+				if (remaining() < len)
+					return false;
+				block = ByteReader(cur, len);
+				cur += len;
+				return true;
+			}
+		};
+
+		/**
+		 * Writes a fingerprint string into a fixed-size buffer and computes its MD5 hash. Text that doesn't fit in the
+		 * buffer is only hashed, so the hash always covers the full string
+		 */
+		class FingerprintStringWriter
+		{
+		public:
+			FingerprintStringWriter(char* buffer, size_t maxLength)
+			    : m_Buffer(buffer), m_MaxLength(maxLength), m_Length(0), m_IsTruncated(false)
+			{}
+
+			void append(const char* text, size_t len)
+			{
+				if (m_IsTruncated)
+				{
+					m_Md5.add(text, len);
+					return;
+				}
+
+				size_t room = m_MaxLength - m_Length;
+				if (len <= room)
+				{
+					memcpy(m_Buffer + m_Length, text, len);
+					m_Length += len;
+					return;
+				}
+
+				memcpy(m_Buffer + m_Length, text, room);
+				m_Length = m_MaxLength;
+				m_IsTruncated = true;
+				m_Md5.add(m_Buffer, m_Length);
+				m_Md5.add(text + room, len - room);
+			}
+
+			void appendChar(char c)
+			{
+				append(&c, 1);
+			}
+
+			void appendNumber(uint32_t value)
+			{
+				char digits[10];
+				size_t start = sizeof(digits);
+				do
+				{
+					digits[--start] = static_cast<char>('0' + value % 10);
+					value /= 10;
+				} while (value != 0);
+				append(digits + start, sizeof(digits) - start);
+			}
+
+			// write a "-" separated list of 16-bit values, optionally without GREASE values
+			void appendUInt16List(ByteReader list, bool skipGrease)
+			{
+				bool isFirst = true;
+				uint16_t value;
+				while (list.readUInt16(value))
+				{
+					if (skipGrease && isGrease(value))
+						continue;
+					if (!isFirst)
+						appendChar('-');
+					appendNumber(value);
+					isFirst = false;
+				}
+			}
+
+			// null-terminate the string and write the hex MD5 hash into a 33-byte buffer
+			void finish(size_t& length, bool& isTruncated, char* hashHex)
+			{
+				m_Buffer[m_Length] = '\0';
+				if (!m_IsTruncated)
+					m_Md5.add(m_Buffer, m_Length);
+
+				unsigned char hash[MD5::HashBytes];
+				m_Md5.getHash(hash);
+				for (size_t i = 0; i < MD5::HashBytes; i++)
+				{
+					hashHex[2 * i] = HexDigits[hash[i] >> 4];
+					hashHex[2 * i + 1] = HexDigits[hash[i] & 0x0f];
+				}
+				hashHex[2 * MD5::HashBytes] = '\0';
+
+				length = m_Length;
+				isTruncated = m_IsTruncated;
+			}
+
+		private:
+			char* m_Buffer;
+			size_t m_MaxLength;
+			size_t m_Length;
+			bool m_IsTruncated;
+			MD5 m_Md5;
+		};
+
+		/**
+		 * A minimal SHA-256 (FIPS 180-4) used for the JA4 hashes, which are the first 12 hex digits of a SHA-256 hash
+		 */
+		class Sha256
+		{
+		public:
+			Sha256() : m_TotalLength(0), m_BufferLength(0)
+			{
+				static const uint32_t initialState[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+					                                      0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+				memcpy(m_State, initialState, sizeof(m_State));
+			}
+
+			void add(const void* data, size_t len)
+			{
+				const uint8_t* bytes = static_cast<const uint8_t*>(data);
+				m_TotalLength += len;
+
+				if (m_BufferLength > 0)
+				{
+					size_t toCopy = std::min(len, sizeof(m_Buffer) - m_BufferLength);
+					memcpy(m_Buffer + m_BufferLength, bytes, toCopy);
+					m_BufferLength += toCopy;
+					bytes += toCopy;
+					len -= toCopy;
+					if (m_BufferLength < sizeof(m_Buffer))
+						return;
+					processBlock(m_Buffer);
+					m_BufferLength = 0;
+				}
+
+				for (; len >= sizeof(m_Buffer); bytes += sizeof(m_Buffer), len -= sizeof(m_Buffer))
+					processBlock(bytes);
+
+				memcpy(m_Buffer, bytes, len);
+				m_BufferLength = len;
+			}
+
+			void getHash(uint8_t hash[32])
+			{
+				uint64_t totalBits = m_TotalLength * 8;
+
+				uint8_t padding[72] = { 0x80 };
+				size_t paddingLength = (m_BufferLength < 56 ? 56 : 120) - m_BufferLength;
+				for (int i = 0; i < 8; i++)
+					padding[paddingLength + i] = static_cast<uint8_t>(totalBits >> (56 - 8 * i));
+				add(padding, paddingLength + 8);
+
+				for (int i = 0; i < 8; i++)
+				{
+					hash[4 * i] = static_cast<uint8_t>(m_State[i] >> 24);
+					hash[4 * i + 1] = static_cast<uint8_t>(m_State[i] >> 16);
+					hash[4 * i + 2] = static_cast<uint8_t>(m_State[i] >> 8);
+					hash[4 * i + 3] = static_cast<uint8_t>(m_State[i]);
+				}
+			}
+
+		private:
+			uint32_t m_State[8];
+			uint64_t m_TotalLength;
+			uint8_t m_Buffer[64];
+			size_t m_BufferLength;
+
+			static uint32_t rotateRight(uint32_t value, int bits)
+			{
+				return (value >> bits) | (value << (32 - bits));
+			}
+
+			void processBlock(const uint8_t* block)
+			{
+				static const uint32_t roundConstants[64] = {
+					0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+					0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+					0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+					0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+					0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+					0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+					0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+					0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+				};
+
+				uint32_t w[64];
+				for (int i = 0; i < 16; i++)
+				{
+					w[i] = (static_cast<uint32_t>(block[4 * i]) << 24) |
+					       (static_cast<uint32_t>(block[4 * i + 1]) << 16) |
+					       (static_cast<uint32_t>(block[4 * i + 2]) << 8) | block[4 * i + 3];
+				}
+				for (int i = 16; i < 64; i++)
+				{
+					uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+					uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+					w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+				}
+
+				uint32_t a = m_State[0], b = m_State[1], c = m_State[2], d = m_State[3];
+				uint32_t e = m_State[4], f = m_State[5], g = m_State[6], h = m_State[7];
+				for (int i = 0; i < 64; i++)
+				{
+					uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+					uint32_t ch = (e & f) ^ (~e & g);
+					uint32_t temp1 = h + s1 + ch + roundConstants[i] + w[i];
+					uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+					uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+					uint32_t temp2 = s0 + maj;
+					h = g;
+					g = f;
+					f = e;
+					e = d + temp1;
+					d = c;
+					c = b;
+					b = a;
+					a = temp1 + temp2;
+				}
+
+				m_State[0] += a;
+				m_State[1] += b;
+				m_State[2] += c;
+				m_State[3] += d;
+				m_State[4] += e;
+				m_State[5] += f;
+				m_State[6] += g;
+				m_State[7] += h;
+			}
+		};
+
+		/**
+		 * Hashes a "," separated list of 4-digit hex values, as used by JA4, without building the string
+		 */
+		class HexListHasher
+		{
+		public:
+			HexListHasher() : m_IsHashEmpty(true), m_Length(0), m_IsEmpty(true)
+			{}
+
+			void addValue(uint16_t value)
+			{
+				if (m_Length + 5 > sizeof(m_Buffer))
+					flush();
+				if (!m_IsEmpty)
+					m_Buffer[m_Length++] = ',';
+				addHexDigits(value);
+			}
+
+			void addSeparator(char separator)
+			{
+				if (m_Length + 1 > sizeof(m_Buffer))
+					flush();
+				m_Buffer[m_Length++] = separator;
+				m_IsEmpty = true;
+			}
+
+			void addValues(const uint16_t* values, size_t count)
+			{
+				for (size_t i = 0; i < count; i++)
+					addValue(values[i]);
+			}
+
+			// write the first 12 hex digits of the hash, or "000000000000" if nothing was hashed
+			void finish(char* output)
+			{
+				if (m_Length == 0 && m_IsHashEmpty)
+				{
+					memset(output, '0', 12);
+					return;
+				}
+
+				flush();
+				uint8_t hash[32];
+				m_Sha256.getHash(hash);
+				for (int i = 0; i < 6; i++)
+				{
+					output[2 * i] = HexDigits[hash[i] >> 4];
+					output[2 * i + 1] = HexDigits[hash[i] & 0x0f];
+				}
+			}
+
+		private:
+			Sha256 m_Sha256;
+			bool m_IsHashEmpty;
+			char m_Buffer[256];
+			size_t m_Length;
+			bool m_IsEmpty;
+
+			void addHexDigits(uint16_t value)
+			{
+				m_Buffer[m_Length++] = HexDigits[(value >> 12) & 0x0f];
+				m_Buffer[m_Length++] = HexDigits[(value >> 8) & 0x0f];
+				m_Buffer[m_Length++] = HexDigits[(value >> 4) & 0x0f];
+				m_Buffer[m_Length++] = HexDigits[value & 0x0f];
+				m_IsEmpty = false;
+			}
+
+			void flush()
+			{
+				if (m_Length == 0)
+					return;
+				m_Sha256.add(m_Buffer, m_Length);
+				m_IsHashEmpty = false;
+				m_Length = 0;
+			}
+		};
+
+		// copy the non-GREASE 16-bit values of a list into a fixed-size array, return the number of values in the list
+		size_t collectUInt16List(ByteReader list, uint16_t* values, size_t maxValues, size_t& numOfValues,
+		                         bool& isTruncated)
+		{
+			size_t count = 0;
+			numOfValues = 0;
+			uint16_t value;
+			while (list.readUInt16(value))
+			{
+				if (isGrease(value))
+					continue;
+				count++;
+				if (numOfValues < maxValues)
+					values[numOfValues++] = value;
+				else
+					isTruncated = true;
+			}
+			return count;
+		}
+
+		const char* getJa4Version(uint16_t version)
+		{
+			switch (version)
+			{
+			case 0x0304:
+				return "13";
+			case 0x0303:
+				return "12";
+			case 0x0302:
+				return "11";
+			case 0x0301:
+				return "10";
+			case 0x0300:
+				return "s3";
+			case 0x0002:
+				return "s2";
+			case 0xfeff:
+				return "d1";
+			case 0xfefd:
+				return "d2";
+			case 0xfefc:
+				return "d3";
+			default:
+				return "00";
+			}
+		}
+
+		inline bool isAlphanumeric(uint8_t c)
+		{
+			return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+		}
+
+		inline void writeTwoDigits(char* output, size_t value)
+		{
+			value = std::min<size_t>(value, 99);
+			output[0] = static_cast<char>('0' + value / 10);
+			output[1] = static_cast<char>('0' + value % 10);
+		}
+
+		// the extensions a fingerprint is computed from; an empty reader means the extension isn't in the message
+		struct HelloExtensions
+		{
+			bool hasServerName;
+			bool hasSupportedGroups;
+			bool hasECPointFormats;
+			bool hasSignatureAlgorithms;
+			bool hasALPN;
+			bool hasSupportedVersions;
+			ByteReader supportedGroups;
+			ByteReader ecPointFormats;
+			ByteReader signatureAlgorithms;
+			ByteReader alpn;
+			ByteReader supportedVersions;
+
+			HelloExtensions()
+			    : hasServerName(false), hasSupportedGroups(false), hasECPointFormats(false),
+			      hasSignatureAlgorithms(false), hasALPN(false), hasSupportedVersions(false)
+			{}
+		};
+
+		// read the hello message header and return a reader over the message body
+		TLSFingerprintScanner::ScanResult getHelloMessageBody(const uint8_t* data, size_t dataLen, uint8_t helloType,
+		                                                      ByteReader& body)
+		{
+			if (dataLen < 1 || data[0] != helloType)
+				return TLSFingerprintScanner::ScanResult::NotHello;
+			if (dataLen < TlsHandshakeHeaderLength)
+				return TLSFingerprintScanner::ScanResult::NeedMoreData;
+
+			size_t messageLen = readUInt24(data + 1);
+			if (dataLen - TlsHandshakeHeaderLength < messageLen)
+				return TLSFingerprintScanner::ScanResult::NeedMoreData;
+
+			body = ByteReader(data + TlsHandshakeHeaderLength, messageLen);
+			return TLSFingerprintScanner::ScanResult::Success;
+		}
+
+		// find the handshake message in the first TLS record of the data
+		TLSFingerprintScanner::ScanResult getHandshakeMessageInRecord(const uint8_t* data, size_t dataLen,
+		                                                              uint8_t helloType, const uint8_t*& message,
+		                                                              size_t& messageLen)
+		{
+			if (dataLen < 1 || data[0] != TlsRecordTypeHandshake)
+				return TLSFingerprintScanner::ScanResult::NotHello;
+			if (dataLen < TlsRecordHeaderLength)
+				return TLSFingerprintScanner::ScanResult::NeedMoreData;
+			if (data[1] != 3)
+				return TLSFingerprintScanner::ScanResult::NotHello;
+
+			size_t recordLen = readUInt16(data + 3);
+			message = data + TlsRecordHeaderLength;
+			messageLen = std::min(recordLen, dataLen - TlsRecordHeaderLength);
+			if (messageLen >= 1 && message[0] != helloType)
+				return TLSFingerprintScanner::ScanResult::NotHello;
+
+			return TLSFingerprintScanner::ScanResult::Success;
+		}
+
+	}  // namespace
+
+	// ~~~~~~~~~~~~~~~~~~~~~
+	// TLSFingerprintScanner
+	// ~~~~~~~~~~~~~~~~~~~~~
+
+	TLSFingerprintScanner::ScanResult TLSFingerprintScanner::scanClientHelloMessage(const uint8_t* data,
+	                                                                                size_t dataLen,
+	                                                                                TLSClientHelloFingerprint& result)
+	{
+		ByteReader body;
+		ScanResult scanResult = getHelloMessageBody(data, dataLen, TlsHandshakeTypeClientHello, body);
+		if (scanResult != ScanResult::Success)
+			return scanResult;
+
+		uint8_t sessionIdLen, compressionMethodsLen;
+		uint16_t cipherSuitesLen;
+		ByteReader cipherSuites, extensions;
+		if (!body.readUInt16(result.tlsVersion) || !body.skip(TlsRandomLength) || !body.readUInt8(sessionIdLen) ||
+		    !body.skip(sessionIdLen) || !body.readUInt16(cipherSuitesLen) ||
+		    !body.readBlock(cipherSuitesLen, cipherSuites) || !body.readUInt8(compressionMethodsLen) ||
+		    !body.skip(compressionMethodsLen))
+			return ScanResult::Malformed;
+
+		// extensions are optional
+		uint16_t extensionsLen;
+		if (body.remaining() > 0 && (!body.readUInt16(extensionsLen) || !body.readBlock(extensionsLen, extensions)))
+			return ScanResult::Malformed;
+
+		// first pass over the extensions: find the ones the fingerprints need and validate the lengths
+		HelloExtensions helloExtensions;
+		ByteReader extensionsIter = extensions;
+		while (extensionsIter.remaining() > 0)
+		{
+			uint16_t type = 0, len = 0;
+			ByteReader extData;
+			if (!extensionsIter.readUInt16(type) || !extensionsIter.readUInt16(len) ||
+			    !extensionsIter.readBlock(len, extData))
+				return ScanResult::Malformed;
+
+			switch (type)
+			{
+			case ExtensionServerName:
+				helloExtensions.hasServerName = true;
+				break;
+			case ExtensionSupportedGroups:
+			{
+				uint16_t listLen;
+				// a list that doesn't match the extension length is ignored, like TLSSupportedGroupsExtension does
+				if (!helloExtensions.hasSupportedGroups && extData.readUInt16(listLen) &&
+				    listLen == extData.remaining() && listLen % 2 == 0)
+				{
+					helloExtensions.supportedGroups = extData;
+					helloExtensions.hasSupportedGroups = true;
+				}
+				break;
+			}
+			case ExtensionECPointFormats:
+			{
+				uint8_t listLen;
+				if (!helloExtensions.hasECPointFormats && extData.readUInt8(listLen) && listLen == extData.remaining())
+				{
+					helloExtensions.ecPointFormats = extData;
+					helloExtensions.hasECPointFormats = true;
+				}
+				break;
+			}
+			case ExtensionSignatureAlgorithms:
+			{
+				uint16_t listLen;
+				if (!helloExtensions.hasSignatureAlgorithms && extData.readUInt16(listLen) &&
+				    extData.readBlock(listLen, helloExtensions.signatureAlgorithms))
+					helloExtensions.hasSignatureAlgorithms = true;
+				break;
+			}
+			case ExtensionALPN:
+			{
+				uint16_t listLen;
+				uint8_t protocolLen;
+				ByteReader list;
+				if (!helloExtensions.hasALPN && extData.readUInt16(listLen) && extData.readBlock(listLen, list) &&
+				    list.readUInt8(protocolLen) && list.readBlock(protocolLen, helloExtensions.alpn))
+					helloExtensions.hasALPN = true;
+				break;
+			}
+			case ExtensionSupportedVersions:
+			{
+				uint8_t listLen;
+				if (!helloExtensions.hasSupportedVersions && extData.readUInt8(listLen) &&
+				    extData.readBlock(listLen, helloExtensions.supportedVersions))
+					helloExtensions.hasSupportedVersions = true;
+				break;
+			}
+			default:
+				break;
+			}
+		}
+
+		// JA3: TLSVersion,CipherSuites,Extensions,SupportedGroups,ECPointFormats
+
+		FingerprintStringWriter ja3(result.ja3, TLSClientHelloFingerprint::MaxJa3Length);
+		ja3.appendNumber(result.tlsVersion);
+		ja3.appendChar(',');
+		ja3.appendUInt16List(cipherSuites, true);
+		ja3.appendChar(',');
+
+		bool isFirst = true;
+		extensionsIter = extensions;
+		while (extensionsIter.remaining() > 0)
+		{
+			uint16_t type = 0, len = 0;
+			extensionsIter.readUInt16(type);
+			extensionsIter.readUInt16(len);
+			extensionsIter.skip(len);
+			if (isGrease(type))
+				continue;
+			if (!isFirst)
+				ja3.appendChar('-');
+			ja3.appendNumber(type);
+			isFirst = false;
+		}
+		ja3.appendChar(',');
+
+		if (helloExtensions.hasSupportedGroups)
+			ja3.appendUInt16List(helloExtensions.supportedGroups, true);
+		ja3.appendChar(',');
+
+		uint8_t pointFormat;
+		isFirst = true;
+		while (helloExtensions.ecPointFormats.readUInt8(pointFormat))
+		{
+			if (!isFirst)
+				ja3.appendChar('-');
+			ja3.appendNumber(pointFormat);
+			isFirst = false;
+		}
+		ja3.finish(result.ja3Length, result.isJa3Truncated, result.ja3Hash);
+
+		// JA4: a_b_c, where a is the protocol, version, SNI, counts and ALPN, b is the hash of the sorted cipher
+		// suites and c is the hash of the sorted extensions and the signature algorithms
+
+		uint16_t values[TLSClientHelloFingerprint::MaxJa4ListSize];
+		size_t numOfValues;
+		result.isJa4Truncated = false;
+
+		uint16_t ja4Version = result.tlsVersion;
+		if (helloExtensions.hasSupportedVersions)
+		{
+			uint16_t version, maxVersion = 0;
+			while (helloExtensions.supportedVersions.readUInt16(version))
+			{
+				if (!isGrease(version) && version > maxVersion)
+					maxVersion = version;
+			}
+			if (maxVersion != 0)
+				ja4Version = maxVersion;
+		}
+
+		char* ja4 = result.ja4;
+		ja4[0] = 't';
+		memcpy(ja4 + 1, getJa4Version(ja4Version), 2);
+		ja4[3] = helloExtensions.hasServerName ? 'd' : 'i';
+
+		size_t numOfCipherSuites = collectUInt16List(cipherSuites, values, TLSClientHelloFingerprint::MaxJa4ListSize,
+		                                             numOfValues, result.isJa4Truncated);
+		writeTwoDigits(ja4 + 4, numOfCipherSuites);
+
+		std::sort(values, values + numOfValues);
+		HexListHasher cipherSuitesHash;
+		cipherSuitesHash.addValues(values, numOfValues);
+		cipherSuitesHash.finish(ja4 + 11);
+
+		// the extension count includes SNI and ALPN, the hash doesn't
+		size_t numOfExtensions = 0;
+		numOfValues = 0;
+		extensionsIter = extensions;
+		while (extensionsIter.remaining() > 0)
+		{
+			uint16_t type = 0, len = 0;
+			extensionsIter.readUInt16(type);
+			extensionsIter.readUInt16(len);
+			extensionsIter.skip(len);
+			if (isGrease(type))
+				continue;
+			numOfExtensions++;
+			if (type == ExtensionServerName || type == ExtensionALPN)
+				continue;
+			if (numOfValues < TLSClientHelloFingerprint::MaxJa4ListSize)
+				values[numOfValues++] = type;
+			else
+				result.isJa4Truncated = true;
+		}
+		writeTwoDigits(ja4 + 6, numOfExtensions);
+
+		const ByteReader& alpn = helloExtensions.alpn;
+		if (!helloExtensions.hasALPN || alpn.remaining() == 0)
+		{
+			ja4[8] = '0';
+			ja4[9] = '0';
+		}
+		else if (isAlphanumeric(alpn.cur[0]) && isAlphanumeric(alpn.end[-1]))
+		{
+			ja4[8] = static_cast<char>(alpn.cur[0]);
+			ja4[9] = static_cast<char>(alpn.end[-1]);
+		}
+		else
+		{
+			ja4[8] = HexDigits[alpn.cur[0] >> 4];
+			ja4[9] = HexDigits[alpn.end[-1] & 0x0f];
+		}
+		ja4[10] = '_';
+		ja4[23] = '_';
+
+		std::sort(values, values + numOfValues);
+		HexListHasher extensionsHash;
+		extensionsHash.addValues(values, numOfValues);
+		if (helloExtensions.hasSignatureAlgorithms)
+		{
+			collectUInt16List(helloExtensions.signatureAlgorithms, values, TLSClientHelloFingerprint::MaxJa4ListSize,
+			                  numOfValues, result.isJa4Truncated);
+			if (numOfValues > 0)
+			{
+				extensionsHash.addSeparator('_');
+				extensionsHash.addValues(values, numOfValues);
+			}
+		}
+		extensionsHash.finish(ja4 + 24);
+		ja4[36] = '\0';
+
+		return ScanResult::Success;
+	}
+
+	TLSFingerprintScanner::ScanResult TLSFingerprintScanner::scanServerHelloMessage(const uint8_t* data,
+	                                                                                size_t dataLen,
+	                                                                                TLSServerHelloFingerprint& result)
+	{
+		ByteReader body;
+		ScanResult scanResult = getHelloMessageBody(data, dataLen, TlsHandshakeTypeServerHello, body);
+		if (scanResult != ScanResult::Success)
+			return scanResult;
+
+		uint8_t sessionIdLen, compressionMethod;
+		uint16_t cipherSuite;
+		ByteReader extensions;
+		if (!body.readUInt16(result.tlsVersion) || !body.skip(TlsRandomLength) || !body.readUInt8(sessionIdLen) ||
+		    !body.skip(sessionIdLen) || !body.readUInt16(cipherSuite) || !body.readUInt8(compressionMethod))
+			return ScanResult::Malformed;
+
+		uint16_t extensionsLen;
+		if (body.remaining() > 0 && (!body.readUInt16(extensionsLen) || !body.readBlock(extensionsLen, extensions)))
+			return ScanResult::Malformed;
+
+		// validate the extensions; a TLS 1.3 server puts the negotiated version in the "supported versions"
+		// extension, which is the version SSLServerHelloMessage::getHandshakeVersion() returns
+		ByteReader extensionsIter = extensions;
+		while (extensionsIter.remaining() > 0)
+		{
+			uint16_t type = 0, len = 0;
+			ByteReader extData;
+			if (!extensionsIter.readUInt16(type) || !extensionsIter.readUInt16(len) ||
+			    !extensionsIter.readBlock(len, extData))
+				return ScanResult::Malformed;
+			if (type == ExtensionSupportedVersions && len == sizeof(uint16_t))
+				extData.readUInt16(result.tlsVersion);
+		}
+
+		// JA3S: TLSVersion,CipherSuite,Extensions
+
+		FingerprintStringWriter ja3s(result.ja3s, TLSServerHelloFingerprint::MaxJa3sLength);
+		ja3s.appendNumber(result.tlsVersion);
+		ja3s.appendChar(',');
+		ja3s.appendNumber(cipherSuite);
+		ja3s.appendChar(',');
+
+		bool isFirst = true;
+		while (extensions.remaining() > 0)
+		{
+			uint16_t type = 0, len = 0;
+			extensions.readUInt16(type);
+			extensions.readUInt16(len);
+			extensions.skip(len);
+			if (!isFirst)
+				ja3s.appendChar('-');
+			ja3s.appendNumber(type);
+			isFirst = false;
+		}
+		ja3s.finish(result.ja3sLength, result.isJa3sTruncated, result.ja3sHash);
+
+		return ScanResult::Success;
+	}
+
+	TLSFingerprintScanner::ScanResult TLSFingerprintScanner::scanClientHello(const uint8_t* data, size_t dataLen,
+	                                                                         TLSClientHelloFingerprint& result)
+	{
+		const uint8_t* message;
+		size_t messageLen;
+		ScanResult scanResult =
+		    getHandshakeMessageInRecord(data, dataLen, TlsHandshakeTypeClientHello, message, messageLen);
+		if (scanResult != ScanResult::Success)
+			return scanResult;
+
+		return scanClientHelloMessage(message, messageLen, result);
+	}
+
+	TLSFingerprintScanner::ScanResult TLSFingerprintScanner::scanServerHello(const uint8_t* data, size_t dataLen,
+	                                                                         TLSServerHelloFingerprint& result)
+	{
+		const uint8_t* message;
+		size_t messageLen;
+		ScanResult scanResult =
+		    getHandshakeMessageInRecord(data, dataLen, TlsHandshakeTypeServerHello, message, messageLen);
+		if (scanResult != ScanResult::Success)
+			return scanResult;
+
+		return scanServerHelloMessage(message, messageLen, result);
+	}
+
+	// ~~~~~~~~~~~~~~~~~~~~~~~~
+	// TLSFingerprintReassembly
+	// ~~~~~~~~~~~~~~~~~~~~~~~~
+
+	TLSFingerprintReassembly::TLSFingerprintReassembly(OnClientHelloFingerprint onClientHello,
+	                                                   OnServerHelloFingerprint onServerHello, void* userCookie,
+	                                                   size_t maxHelloSize)
+	    : m_OnClientHello(onClientHello), m_OnServerHello(onServerHello), m_UserCookie(userCookie),
+	      m_MaxHelloSize(maxHelloSize)
+	{}
+
+	void TLSFingerprintReassembly::processTcpData(int8_t side, const TcpStreamData& tcpData)
+	{
+		if (side != 0 && side != 1)
+			return;
+
+		const ConnectionData& connData = tcpData.getConnectionData();
+		SideState& sideState = m_Connections[connData.flowKey].sides[side];
+		if (sideState.isDone)
+			return;
+
+		// the hello message can't be scanned if some of its data was lost
+		if (tcpData.getMissingByteCount() > 0)
+		{
+			PCPP_LOG_DEBUG("Data is missing in side " << (int)side << " of connection " << connData.flowKey
+			                                          << ", not looking for a hello message");
+			finishSide(sideState);
+			return;
+		}
+
+		processRecordData(sideState, side, tcpData.getData(), tcpData.getDataLength(), connData);
+	}
+
+	void TLSFingerprintReassembly::processRecordData(SideState& sideState, int8_t side, const uint8_t* data,
+	                                                 size_t dataLen, const ConnectionData& connData)
+	{
+		while (dataLen > 0)
+		{
+			// read the record header, which may be split between segments
+			if (sideState.recordRemaining == 0)
+			{
+				size_t toCopy = std::min(dataLen, TlsRecordHeaderLength - sideState.recordHeaderLength);
+				memcpy(sideState.recordHeader + sideState.recordHeaderLength, data, toCopy);
+				sideState.recordHeaderLength += static_cast<uint8_t>(toCopy);
+				data += toCopy;
+				dataLen -= toCopy;
+				if (sideState.recordHeaderLength < TlsRecordHeaderLength)
+					return;
+
+				sideState.recordHeaderLength = 0;
+				sideState.recordRemaining = readUInt16(sideState.recordHeader + 3);
+				if (sideState.recordHeader[0] != TlsRecordTypeHandshake || sideState.recordHeader[1] != 3 ||
+				    sideState.recordRemaining == 0)
+				{
+					finishSide(sideState);
+					return;
+				}
+				continue;
+			}
+
+			size_t toProcess = std::min(dataLen, sideState.recordRemaining);
+
+			// fast path: the whole message is in this piece of the record, scan it in place
+			if (sideState.message.empty())
+			{
+				if (data[0] != TlsHandshakeTypeClientHello && data[0] != TlsHandshakeTypeServerHello)
+				{
+					finishSide(sideState);
+					return;
+				}
+
+				if (toProcess >= TlsHandshakeHeaderLength &&
+				    TlsHandshakeHeaderLength + readUInt24(data + 1) <= toProcess)
+				{
+					scanMessage(side, data, toProcess, connData);
+					finishSide(sideState);
+					return;
+				}
+			}
+
+			if (sideState.message.size() + toProcess > m_MaxHelloSize)
+			{
+				PCPP_LOG_DEBUG("Hello message in side " << (int)side << " of connection " << connData.flowKey
+				                                        << " is larger than " << m_MaxHelloSize
+				                                        << " bytes, ignoring it");
+				finishSide(sideState);
+				return;
+			}
+
+			sideState.message.insert(sideState.message.end(), data, data + toProcess);
+			sideState.recordRemaining -= toProcess;
+			data += toProcess;
+			dataLen -= toProcess;
+
+			const std::vector<uint8_t>& message = sideState.message;
+			if (message.size() >= TlsHandshakeHeaderLength &&
+			    TlsHandshakeHeaderLength + readUInt24(message.data() + 1) <= message.size())
+			{
+				scanMessage(side, message.data(), message.size(), connData);
+				finishSide(sideState);
+				return;
+			}
+		}
+	}
+
+	void TLSFingerprintReassembly::scanMessage(int8_t side, const uint8_t* data, size_t dataLen,
+	                                           const ConnectionData& connData)
+	{
+		if (data[0] == TlsHandshakeTypeClientHello)
+		{
+			TLSClientHelloFingerprint fingerprint;
+			if (TLSFingerprintScanner::scanClientHelloMessage(data, dataLen, fingerprint) ==
+			        TLSFingerprintScanner::ScanResult::Success &&
+			    m_OnClientHello != nullptr)
+				m_OnClientHello(side, fingerprint, connData, m_UserCookie);
+		}
+		else
+		{
+			TLSServerHelloFingerprint fingerprint;
+			if (TLSFingerprintScanner::scanServerHelloMessage(data, dataLen, fingerprint) ==
+			        TLSFingerprintScanner::ScanResult::Success &&
+			    m_OnServerHello != nullptr)
+				m_OnServerHello(side, fingerprint, connData, m_UserCookie);
+		}
+	}
+
+	void TLSFingerprintReassembly::finishSide(SideState& sideState)
+	{
+		sideState.isDone = true;
+		std::vector<uint8_t>().swap(sideState.message);
+	}
+
+	void TLSFingerprintReassembly::closeConnection(const ConnectionData& connData)
+	{
+		m_Connections.erase(connData.flowKey);
+	}
+
+	void TLSFingerprintReassembly::onTcpMessageReady(int8_t side, const TcpStreamData& tcpData, void* userCookie)
+	{
+		static_cast<TLSFingerprintReassembly*>(userCookie)->processTcpData(side, tcpData);
+	}
+
+	void TLSFingerprintReassembly::onTcpConnectionEnd(const ConnectionData& connData,
+	                                                  TcpReassembly::ConnectionEndReason reason, void* userCookie)
+	{
+		(void)reason;
+		static_cast<TLSFingerprintReassembly*>(userCookie)->closeConnection(connData);
+	}
+
+}  // namespace pcpp
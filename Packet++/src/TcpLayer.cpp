@@ -5,19 +5,45 @@
 #include "IPv4Layer.h"
 #include "IPv6Layer.h"
 #include "PayloadLayer.h"
-#include "HttpLayer.h"
-#include "SSLLayer.h"
-#include "SipLayer.h"
-#include "BgpLayer.h"
-#include "SSHLayer.h"
-#include "DnsLayer.h"
-#include "TelnetLayer.h"
-#include "TpktLayer.h"
-#include "FtpLayer.h"
-#include "SomeIpLayer.h"
-#include "SmtpLayer.h"
-#include "LdapLayer.h"
-#include "GtpLayer.h"
+#ifndef PCPP_EXCLUDE_PROTOCOL_HTTP
+#	include "HttpLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_SSL
+#	include "SSLLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_SIP
+#	include "SipLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_BGP
+#	include "BgpLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_SSH
+#	include "SSHLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_DNS
+#	include "DnsLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_TELNET
+#	include "TelnetLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_TPKT
+#	include "TpktLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_FTP
+#	include "FtpLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_SOMEIP
+#	include "SomeIpLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_SMTP
+#	include "SmtpLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_LDAP
+#	include "LdapLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_GTP
+#	include "GtpLayer.h"
+#endif
 #include "PacketUtils.h"
 #include "Logger.h"
 #include "DeprecationUtils.h"
@@ -92,6 +118,235 @@ namespace pcpp
 		return TcpOption(recordBuffer);
 	}
 
+	/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	/// TcpLayer built-in dissectors
+	/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+	namespace
+	{
+#ifndef PCPP_EXCLUDE_PROTOCOL_HTTP
+		Layer* dissectHttp(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t srcPort,
+		                   uint16_t dstPort)
+		{
+			const char* dataChar = reinterpret_cast<const char*>(data);
+			if (HttpMessage::isHttpPort(dstPort) &&
+			    HttpRequestFirstLine::parseMethod(dataChar, dataLen) != HttpRequestLayer::HttpMethodUnknown)
+				return new HttpRequestLayer(data, dataLen, prevLayer, packet);
+
+			if (HttpMessage::isHttpPort(srcPort) &&
+			    HttpResponseFirstLine::parseVersion(dataChar, dataLen) != HttpVersion::HttpVersionUnknown &&
+			    !HttpResponseFirstLine::parseStatusCode(dataChar, dataLen).isUnsupportedCode())
+				return new HttpResponseLayer(data, dataLen, prevLayer, packet);
+
+			return nullptr;
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_SSL
+		Layer* dissectSsl(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t srcPort,
+		                  uint16_t dstPort)
+		{
+			if (SSLLayer::IsSSLMessage(srcPort, dstPort, data, dataLen))
+				return SSLLayer::createSSLMessage(data, dataLen, prevLayer, packet);
+
+			return nullptr;
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_SIP
+		Layer* dissectSip(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t, uint16_t)
+		{
+			const char* dataChar = reinterpret_cast<const char*>(data);
+			if (SipRequestFirstLine::parseMethod(dataChar, dataLen) != SipRequestLayer::SipMethodUnknown)
+				return new SipRequestLayer(data, dataLen, prevLayer, packet);
+
+			if (SipResponseFirstLine::parseStatusCode(dataChar, dataLen) != SipResponseLayer::SipStatusCodeUnknown)
+				return new SipResponseLayer(data, dataLen, prevLayer, packet);
+
+			return new PayloadLayer(data, dataLen, prevLayer, packet);
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_BGP
+		Layer* dissectBgp(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t, uint16_t)
+		{
+			Layer* bgpLayer = BgpLayer::parseBgpLayer(data, dataLen, prevLayer, packet);
+			if (bgpLayer == nullptr)
+				return new PayloadLayer(data, dataLen, prevLayer, packet);
+
+			return bgpLayer;
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_SSH
+		Layer* dissectSsh(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t, uint16_t)
+		{
+			return SSHLayer::createSSHMessage(data, dataLen, prevLayer, packet);
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_DNS
+		Layer* dissectDns(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t, uint16_t)
+		{
+			if (DnsLayer::isDataValid(data, dataLen, true))
+				return new DnsOverTcpLayer(data, dataLen, prevLayer, packet);
+
+			return nullptr;
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_TELNET
+		Layer* dissectTelnet(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t, uint16_t)
+		{
+			if (TelnetLayer::isDataValid(data, dataLen))
+				return new TelnetLayer(data, dataLen, prevLayer, packet);
+
+			return nullptr;
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_FTP
+		Layer* dissectFtp(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t srcPort,
+		                  uint16_t dstPort)
+		{
+			if (!FtpLayer::isDataValid(data, dataLen))
+				return nullptr;
+
+			if (FtpLayer::isFtpPort(srcPort))
+				return new FtpResponseLayer(data, dataLen, prevLayer, packet);
+
+			if (FtpLayer::isFtpPort(dstPort))
+				return new FtpRequestLayer(data, dataLen, prevLayer, packet);
+
+			return nullptr;
+		}
+
+		Layer* dissectFtpData(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t, uint16_t)
+		{
+			return new FtpDataLayer(data, dataLen, prevLayer, packet);
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_SOMEIP
+		// SOME/IP ports are configured at runtime, so this dissector is called for all ports and checks them itself
+		Layer* dissectSomeIp(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t srcPort,
+		                     uint16_t dstPort)
+		{
+			if (SomeIpLayer::isSomeIpPort(srcPort) || SomeIpLayer::isSomeIpPort(dstPort))
+				return SomeIpLayer::parseSomeIpLayer(data, dataLen, prevLayer, packet);
+
+			return nullptr;
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_TPKT
+		Layer* dissectTpkt(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t, uint16_t)
+		{
+			if (TpktLayer::isDataValid(data, dataLen))
+				return new TpktLayer(data, dataLen, prevLayer, packet);
+
+			return nullptr;
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_SMTP
+		Layer* dissectSmtp(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t srcPort,
+		                   uint16_t dstPort)
+		{
+			if (!SmtpLayer::isDataValid(data, dataLen))
+				return nullptr;
+
+			if (SmtpLayer::isSmtpPort(srcPort))
+				return new SmtpResponseLayer(data, dataLen, prevLayer, packet);
+
+			if (SmtpLayer::isSmtpPort(dstPort))
+				return new SmtpRequestLayer(data, dataLen, prevLayer, packet);
+
+			return nullptr;
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_LDAP
+		Layer* dissectLdap(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t, uint16_t)
+		{
+			Layer* ldapLayer = LdapLayer::parseLdapMessage(data, dataLen, prevLayer, packet);
+			if (ldapLayer == nullptr)
+				return new PayloadLayer(data, dataLen, prevLayer, packet);
+
+			return ldapLayer;
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_GTP
+		Layer* dissectGtpV2(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t, uint16_t)
+		{
+			if (GtpV2Layer::isDataValid(data, dataLen))
+				return new GtpV2Layer(data, dataLen, prevLayer, packet);
+
+			return nullptr;
+		}
+#endif
+
+		// the priorities keep the order in which these protocols were always checked
+		PortDissectorTable createDissectorTable()
+		{
+			PortDissectorTable table;
+#ifndef PCPP_EXCLUDE_PROTOCOL_HTTP
+			table.registerDissector("HTTP", 100, dissectHttp,
+			                        PortDissectorTable::getMatchingPorts(HttpMessage::isHttpPort));
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_SSL
+			table.registerDissector("SSL", 200, dissectSsl, PortDissectorTable::getMatchingPorts(SSLLayer::isSSLPort));
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_SIP
+			table.registerDissector("SIP", 300, dissectSip, PortDissectorTable::getMatchingPorts(SipLayer::isSipPort));
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_BGP
+			table.registerDissector(
+			    "BGP", 400, dissectBgp,
+			    PortDissectorTable::getMatchingPorts([](uint16_t port) { return BgpLayer::isBgpPort(port, port); }));
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_SSH
+			table.registerDissector(
+			    "SSH", 500, dissectSsh,
+			    PortDissectorTable::getMatchingPorts([](uint16_t port) { return SSHLayer::isSSHPort(port, port); }));
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_DNS
+			table.registerDissector("DNS", 600, dissectDns, PortDissectorTable::getMatchingPorts(DnsLayer::isDnsPort));
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_TELNET
+			table.registerDissector("Telnet", 700, dissectTelnet,
+			                        PortDissectorTable::getMatchingPorts(TelnetLayer::isTelnetPort));
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_FTP
+			table.registerDissector("FTP", 800, dissectFtp, PortDissectorTable::getMatchingPorts(FtpLayer::isFtpPort));
+			table.registerDissector("FTP-Data", 900, dissectFtpData,
+			                        PortDissectorTable::getMatchingPorts(FtpLayer::isFtpDataPort));
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_SOMEIP
+			table.registerHeuristicDissector("SOME/IP", 1000, dissectSomeIp);
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_TPKT
+			table.registerDissector(
+			    "TPKT", 1100, dissectTpkt,
+			    PortDissectorTable::getMatchingPorts([](uint16_t port) { return TpktLayer::isTpktPort(port, port); }));
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_SMTP
+			table.registerDissector("SMTP", 1200, dissectSmtp,
+			                        PortDissectorTable::getMatchingPorts(SmtpLayer::isSmtpPort));
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_LDAP
+			table.registerDissector("LDAP", 1300, dissectLdap,
+			                        PortDissectorTable::getMatchingPorts(LdapLayer::isLdapPort));
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_GTP
+			table.registerDissector("GTPv2", 1400, dissectGtpV2,
+			                        PortDissectorTable::getMatchingPorts(GtpV2Layer::isGTPv2Port));
+#endif
+			return table;
+		}
+	}  // namespace
+
 	/// ~~~~~~~~
 	/// TcpLayer
 	/// ~~~~~~~~
@@ -354,6 +609,15 @@ namespace pcpp
 		return *this;
 	}
 
+	PortDissectorTable& TcpLayer::getDissectorTable()
+	{
+		static PortDissectorTable dissectorTable = createDissectorTable();
+		return dissectorTable;
+	}
+
+	// build the table when the library is loaded rather than when the first packet is parsed
+	static PortDissectorTable& initialTcpDissectorTable = TcpLayer::getDissectorTable();
+
 	void TcpLayer::parseNextLayer()
 	{
 		const size_t headerLen = getHeaderLen();
@@ -362,67 +626,9 @@ namespace pcpp
 
 		uint8_t* payload = m_Data + headerLen;
 		const size_t payloadLen = m_DataLen - headerLen;
-		const uint16_t portDst = getDstPort();
-		const uint16_t portSrc = getSrcPort();
-		const char* payloadChar = reinterpret_cast<const char*>(payload);
-
-		if (HttpMessage::isHttpPort(portDst) &&
-		    HttpRequestFirstLine::parseMethod(payloadChar, payloadLen) != HttpRequestLayer::HttpMethodUnknown)
-			m_NextLayer = new HttpRequestLayer(payload, payloadLen, this, m_Packet);
-		else if (HttpMessage::isHttpPort(portSrc) &&
-		         HttpResponseFirstLine::parseVersion(payloadChar, payloadLen) != HttpVersion::HttpVersionUnknown &&
-		         !HttpResponseFirstLine::parseStatusCode(payloadChar, payloadLen).isUnsupportedCode())
-			m_NextLayer = new HttpResponseLayer(payload, payloadLen, this, m_Packet);
-		else if (SSLLayer::IsSSLMessage(portSrc, portDst, payload, payloadLen))
-			m_NextLayer = SSLLayer::createSSLMessage(payload, payloadLen, this, m_Packet);
-		else if (SipLayer::isSipPort(portDst) || SipLayer::isSipPort(portSrc))
-		{
-			if (SipRequestFirstLine::parseMethod(payloadChar, payloadLen) != SipRequestLayer::SipMethodUnknown)
-				m_NextLayer = new SipRequestLayer(payload, payloadLen, this, m_Packet);
-			else if (SipResponseFirstLine::parseStatusCode(payloadChar, payloadLen) !=
-			         SipResponseLayer::SipStatusCodeUnknown)
-				m_NextLayer = new SipResponseLayer(payload, payloadLen, this, m_Packet);
-			else
-				m_NextLayer = new PayloadLayer(payload, payloadLen, this, m_Packet);
-		}
-		else if (BgpLayer::isBgpPort(portSrc, portDst))
-		{
-			m_NextLayer = BgpLayer::parseBgpLayer(payload, payloadLen, this, m_Packet);
-			if (!m_NextLayer)
-				m_NextLayer = new PayloadLayer(payload, payloadLen, this, m_Packet);
-		}
-		else if (SSHLayer::isSSHPort(portSrc, portDst))
-			m_NextLayer = SSHLayer::createSSHMessage(payload, payloadLen, this, m_Packet);
-		else if (DnsLayer::isDataValid(payload, payloadLen, true) &&
-		         (DnsLayer::isDnsPort(portDst) || DnsLayer::isDnsPort(portSrc)))
-			m_NextLayer = new DnsOverTcpLayer(payload, payloadLen, this, m_Packet);
-		else if (TelnetLayer::isDataValid(payload, payloadLen) &&
-		         (TelnetLayer::isTelnetPort(portDst) || TelnetLayer::isTelnetPort(portSrc)))
-			m_NextLayer = new TelnetLayer(payload, payloadLen, this, m_Packet);
-		else if (FtpLayer::isFtpPort(portSrc) && FtpLayer::isDataValid(payload, payloadLen))
-			m_NextLayer = new FtpResponseLayer(payload, payloadLen, this, m_Packet);
-		else if (FtpLayer::isFtpPort(portDst) && FtpLayer::isDataValid(payload, payloadLen))
-			m_NextLayer = new FtpRequestLayer(payload, payloadLen, this, m_Packet);
-		else if (FtpLayer::isFtpDataPort(portSrc) || FtpLayer::isFtpDataPort(portDst))
-			m_NextLayer = new FtpDataLayer(payload, payloadLen, this, m_Packet);
-		else if (SomeIpLayer::isSomeIpPort(portSrc) || SomeIpLayer::isSomeIpPort(portDst))
-			m_NextLayer = SomeIpLayer::parseSomeIpLayer(payload, payloadLen, this, m_Packet);
-		else if (TpktLayer::isDataValid(payload, payloadLen) && TpktLayer::isTpktPort(portSrc, portDst))
-			m_NextLayer = new TpktLayer(payload, payloadLen, this, m_Packet);
-		else if (SmtpLayer::isSmtpPort(portSrc) && SmtpLayer::isDataValid(payload, payloadLen))
-			m_NextLayer = new SmtpResponseLayer(payload, payloadLen, this, m_Packet);
-		else if (SmtpLayer::isSmtpPort(portDst) && SmtpLayer::isDataValid(payload, payloadLen))
-			m_NextLayer = new SmtpRequestLayer(payload, payloadLen, this, m_Packet);
-		else if (LdapLayer::isLdapPort(portDst) || LdapLayer::isLdapPort(portSrc))
-		{
-			m_NextLayer = LdapLayer::parseLdapMessage(payload, payloadLen, this, m_Packet);
-			if (!m_NextLayer)
-				m_NextLayer = new PayloadLayer(payload, payloadLen, this, m_Packet);
-		}
-		else if ((GtpV2Layer::isGTPv2Port(portDst) || GtpV2Layer::isGTPv2Port(portSrc)) &&
-		         GtpV2Layer::isDataValid(payload, payloadLen))
-			m_NextLayer = new GtpV2Layer(payload, payloadLen, this, m_Packet);
-		else
+
+		m_NextLayer = getDissectorTable().dissect(payload, payloadLen, this, m_Packet, getSrcPort(), getDstPort());
+		if (m_NextLayer == nullptr)
 			m_NextLayer = new PayloadLayer(payload, payloadLen, this, m_Packet);
 	}
 
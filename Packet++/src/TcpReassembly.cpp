@@ -5,6 +5,7 @@
 #include "IPLayer.h"
 #include "PacketUtils.h"
 #include "Logger.h"
+#include "Instrumentation.h"
 #include <sstream>
 #include <vector>
 #include "EndianPortable.h"
@@ -463,6 +464,8 @@ namespace pcpp
 			newTcpFrag->timestamp = currTime;
 			memcpy(newTcpFrag->data, tcpLayer->getLayerPayload(), tcpPayloadSize);
 			tcpReassemblyData->twoSides[sideIndex].tcpFragmentList.pushBack(newTcpFrag);
+			PCPP_INSTRUMENT_COUNT(TcpReassemblyFragmentBuffers, 1);
+			PCPP_INSTRUMENT_COUNT(TcpReassemblyBytesBuffered, tcpPayloadSize);
 
 			PCPP_LOG_DEBUG("Found out-of-order packet and added a new TCP fragment with size "
 			               << tcpPayloadSize << " to the out-of-order list of side " << static_cast<int>(sideIndex));
@@ -2,8 +2,20 @@
 #include "Logger.h"
 #include "PayloadLayer.h"
 #include <cstring>
+#include <cctype>
 #include <algorithm>
-#include <utility>
+
+#if defined(__AVX2__)
+#	include <immintrin.h>
+#	define PCPP_TBP_SIMD_CHUNK_SIZE 32
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define PCPP_TBP_SIMD_CHUNK_SIZE 16
+#endif
+
+#if defined(PCPP_TBP_SIMD_CHUNK_SIZE) && defined(_MSC_VER)
+#	include <intrin.h>
+#endif
 
 namespace pcpp
 {
@@ -20,6 +32,165 @@ namespace pcpp
 		return i;
 	}
 
+	namespace
+	{
+
+#ifdef PCPP_TBP_SIMD_CHUNK_SIZE
+		inline uint32_t countTrailingZeros(uint32_t value)
+		{
+#	ifdef _MSC_VER
+			unsigned long index;
+			_BitScanForward(&index, value);
+			return static_cast<uint32_t>(index);
+#	else
+			return static_cast<uint32_t>(__builtin_ctz(value));
+#	endif
+		}
+
+		// compare a chunk of PCPP_TBP_SIMD_CHUNK_SIZE bytes against '\n' and the separator, one mask bit per byte
+		inline void matchChunk(const char* chunk, char separator, uint32_t& newLineMask, uint32_t& separatorMask)
+		{
+#	if PCPP_TBP_SIMD_CHUNK_SIZE == 32
+			__m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chunk));
+			newLineMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, _mm256_set1_epi8('\n'))));
+			separatorMask =
+			    static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, _mm256_set1_epi8(separator))));
+#	else
+			__m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chunk));
+			newLineMask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, _mm_set1_epi8('\n'))));
+			separatorMask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, _mm_set1_epi8(separator))));
+#	endif
+		}
+#endif
+
+		/**
+		 * Find the end of a header field and its name-value separator in a single pass over the data
+		 * @param[in] data The field start
+		 * @param[in] dataLen The number of bytes until the end of the message
+		 * @param[in] separator The name-value separator
+		 * @param[out] separatorPtr The first separator before the returned '\n', or the first separator in the data
+		 * if there is no '\n'. nullptr if there is no such separator
+		 * @return A pointer to the first '\n' or nullptr if the field isn't terminated
+		 */
+		const char* scanHeaderField(const char* data, size_t dataLen, char separator, const char*& separatorPtr)
+		{
+			const char* ptr = data;
+			const char* end = data + dataLen;
+			separatorPtr = nullptr;
+
+#ifdef PCPP_TBP_SIMD_CHUNK_SIZE
+			for (; end - ptr >= PCPP_TBP_SIMD_CHUNK_SIZE; ptr += PCPP_TBP_SIMD_CHUNK_SIZE)
+			{
+				uint32_t newLineMask, separatorMask;
+				matchChunk(ptr, separator, newLineMask, separatorMask);
+
+				if (separatorPtr == nullptr && separatorMask != 0)
+					separatorPtr = ptr + countTrailingZeros(separatorMask);
+
+				if (newLineMask != 0)
+				{
+					const char* newLinePtr = ptr + countTrailingZeros(newLineMask);
+					if (separatorPtr != nullptr && separatorPtr > newLinePtr)
+						separatorPtr = nullptr;
+					return newLinePtr;
+				}
+			}
+#endif
+
+			for (; ptr < end; ++ptr)
+			{
+				if (*ptr == '\n')
+					return ptr;
+
+				if (separatorPtr == nullptr && *ptr == separator)
+					separatorPtr = ptr;
+			}
+
+			return nullptr;
+		}
+
+		// A case insensitive FNV-1a hash. Setting bit 5 of every byte maps upper case letters to lower case ones
+		uint32_t hashFieldName(const char* name, size_t nameLen)
+		{
+			uint32_t hash = 2166136261u;
+			for (size_t i = 0; i < nameLen; ++i)
+			{
+				hash ^= static_cast<uint8_t>(name[i]) | 0x20;
+				hash *= 16777619u;
+			}
+
+			return hash;
+		}
+
+		bool equalsIgnoreCase(const char* str1, const char* str2, size_t len)
+		{
+			for (size_t i = 0; i < len; ++i)
+			{
+				if (::tolower(static_cast<unsigned char>(str1[i])) != ::tolower(static_cast<unsigned char>(str2[i])))
+					return false;
+			}
+
+			return true;
+		}
+
+		// Well-known field names of HTTP, SIP and RTSP. The ID of a name is its index in this array + 1
+		const char* const KnownFieldNames[] = {
+			"Host", "Connection", "User-Agent", "Referer", "Accept", "Accept-Encoding", "Accept-Language", "Cookie",
+			"Content-Length", "Content-Encoding", "Content-Type", "Transfer-Encoding", "Server", "From", "To", "Via",
+			"Call-ID", "Content-Disposition", "Content-Language", "CSeq", "Contact", "Max-Forwards", "Allow",
+			"Authorization", "Date", "MIME-Version", "Reason", "Supported", "WWW-Authenticate", "Retry-After",
+			"Record-Route", "Route", "Expires", "Cache-Control", "Set-Cookie", "Location", "Last-Modified", "ETag",
+			"If-Modified-Since", "If-None-Match", "Keep-Alive", "Upgrade", "Pragma", "Origin", "X-Forwarded-For",
+			"Session", "Transport", "Public", "Range", "RTP-Info"
+		};
+
+		const size_t NumOfKnownFieldNames = sizeof(KnownFieldNames) / sizeof(KnownFieldNames[0]);
+
+		// The names are placed in a table of 2^KnownFieldNameSlotBits slots by the top bits of their hash multiplied by
+		// KnownFieldNameMultiplier. The multiplier was searched so that no two names share a slot. If a name added to
+		// the list collides with another one it isn't resolved to an ID, which is still correct but slower, so the
+		// multiplier should be searched again
+		const uint32_t KnownFieldNameMultiplier = 0x0c055031u;
+		const int KnownFieldNameSlotBits = 7;
+
+		inline size_t getKnownFieldNameSlot(uint32_t nameHash)
+		{
+			return (nameHash * KnownFieldNameMultiplier) >> (32 - KnownFieldNameSlotBits);
+		}
+
+		struct KnownFieldNameTable
+		{
+			uint8_t slots[1 << KnownFieldNameSlotBits];
+			uint8_t nameLengths[NumOfKnownFieldNames];
+
+			KnownFieldNameTable()
+			{
+				memset(slots, 0, sizeof(slots));
+				for (size_t i = 0; i < NumOfKnownFieldNames; ++i)
+				{
+					nameLengths[i] = static_cast<uint8_t>(strlen(KnownFieldNames[i]));
+					size_t slot = getKnownFieldNameSlot(hashFieldName(KnownFieldNames[i], nameLengths[i]));
+					if (slots[slot] == 0)
+						slots[slot] = static_cast<uint8_t>(i + 1);
+				}
+			}
+		};
+
+		// return the ID of a well-known field name or 0 if the name isn't one of them
+		uint16_t getKnownFieldNameId(const char* name, size_t nameLen, uint32_t nameHash)
+		{
+			static const KnownFieldNameTable table;
+
+			uint8_t id = table.slots[getKnownFieldNameSlot(nameHash)];
+			if (id != 0 && table.nameLengths[id - 1] == nameLen &&
+			    equalsIgnoreCase(KnownFieldNames[id - 1], name, nameLen))
+				return id;
+
+			return 0;
+		}
+
+	}  // namespace
+
 	// -------- Class TextBasedProtocolMessage -----------------
 
 	TextBasedProtocolMessage::TextBasedProtocolMessage(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet,
@@ -44,6 +215,7 @@ namespace pcpp
 			delete temp;
 		}
 
+		m_FieldIndex.clear();
 		copyDataFrom(other);
 
 		return *this;
@@ -77,10 +249,11 @@ namespace pcpp
 
 		m_FieldsOffset = other.m_FieldsOffset;
 
-		// copy map
+		// build the field index
+		m_FieldIndex.reserve(other.m_FieldIndex.size());
 		for (HeaderField* field = m_FieldList; field != nullptr; field = field->getNextField())
 		{
-			m_FieldNameToFieldMap.insert(std::pair<std::string, HeaderField*>(field->getFieldName(), field));
+			m_FieldIndex.push_back(makeFieldIndexEntry(field));
 		}
 	}
 
@@ -101,9 +274,7 @@ namespace pcpp
 		else
 			m_FieldList->setNextField(firstField);
 
-		std::string fieldName = firstField->getFieldName();
-		std::transform(fieldName.begin(), fieldName.end(), fieldName.begin(), ::tolower);
-		m_FieldNameToFieldMap.insert(std::pair<std::string, HeaderField*>(fieldName, firstField));
+		m_FieldIndex.push_back(makeFieldIndexEntry(firstField));
 
 		// Last field will be empty and contain just "\n" or "\r\n". This field will mark the end of the header
 		HeaderField* curField = m_FieldList;
@@ -124,9 +295,7 @@ namespace pcpp
 				PCPP_LOG_DEBUG("     Field value = " << newField->getFieldValue());
 				curField->setNextField(newField);
 				curField = newField;
-				fieldName = newField->getFieldName();
-				std::transform(fieldName.begin(), fieldName.end(), fieldName.begin(), ::tolower);
-				m_FieldNameToFieldMap.insert(std::pair<std::string, HeaderField*>(fieldName, newField));
+				m_FieldIndex.push_back(makeFieldIndexEntry(newField));
 			}
 			else
 			{
@@ -248,32 +417,15 @@ namespace pcpp
 		if (newFieldToAdd->getNextField() == nullptr)
 			m_LastField = newFieldToAdd;
 
-		// insert the new field into name to field map
-		std::string fieldName = newFieldToAdd->getFieldName();
-		std::transform(fieldName.begin(), fieldName.end(), fieldName.begin(), ::tolower);
-		m_FieldNameToFieldMap.insert(std::pair<std::string, HeaderField*>(fieldName, newFieldToAdd));
+		// add the new field to the field index. Fields with the same name keep the order they were added in
+		m_FieldIndex.push_back(makeFieldIndexEntry(newFieldToAdd));
 
 		return newFieldToAdd;
 	}
 
 	bool TextBasedProtocolMessage::removeField(std::string fieldName, int index)
 	{
-		std::transform(fieldName.begin(), fieldName.end(), fieldName.begin(), ::tolower);
-
-		HeaderField* fieldToRemove = nullptr;
-
-		auto range = m_FieldNameToFieldMap.equal_range(fieldName);
-		int i = 0;
-		for (std::multimap<std::string, HeaderField*>::iterator iter = range.first; iter != range.second; ++iter)
-		{
-			if (i == index)
-			{
-				fieldToRemove = iter->second;
-				break;
-			}
-
-			i++;
-		}
+		HeaderField* fieldToRemove = getFieldByName(fieldName, index);
 
 		if (fieldToRemove != nullptr)
 			return removeField(fieldToRemove);
@@ -295,8 +447,6 @@ namespace pcpp
 			return false;
 		}
 
-		std::string fieldName = fieldToRemove->getFieldName();
-
 		// shorten layer and delete this field
 		if (!shortenLayer(fieldToRemove->m_NameOffsetInMessage, fieldToRemove->getFieldSize()))
 		{
@@ -334,17 +484,8 @@ namespace pcpp
 			}
 		}
 
-		// remove the hash entry for this field
-		std::transform(fieldName.begin(), fieldName.end(), fieldName.begin(), ::tolower);
-		auto range = m_FieldNameToFieldMap.equal_range(fieldName);
-		for (std::multimap<std::string, HeaderField*>::iterator iter = range.first; iter != range.second; ++iter)
-		{
-			if (iter->second == fieldToRemove)
-			{
-				m_FieldNameToFieldMap.erase(iter);
-				break;
-			}
-		}
+		// remove the index entry for this field
+		unindexField(fieldToRemove);
 
 		// finally - delete this field
 		delete fieldToRemove;
@@ -373,14 +514,29 @@ namespace pcpp
 
 	HeaderField* TextBasedProtocolMessage::getFieldByName(std::string fieldName, int index) const
 	{
-		std::transform(fieldName.begin(), fieldName.end(), fieldName.begin(), ::tolower);
+		uint32_t nameHash = hashFieldName(fieldName.c_str(), fieldName.length());
+		uint16_t knownNameId = getKnownFieldNameId(fieldName.c_str(), fieldName.length(), nameHash);
 
-		auto range = m_FieldNameToFieldMap.equal_range(fieldName);
 		int i = 0;
-		for (std::multimap<std::string, HeaderField*>::const_iterator iter = range.first; iter != range.second; ++iter)
+		for (const FieldIndexEntry& entry : m_FieldIndex)
 		{
+			if (knownNameId != 0)
+			{
+				// well-known names have unique IDs, so no need to compare the names
+				if (entry.knownNameId != knownNameId)
+					continue;
+			}
+			else
+			{
+				const HeaderField* field = entry.field;
+				size_t nameLen = (field->m_FieldNameSize != static_cast<size_t>(-1) ? field->m_FieldNameSize : 0);
+				if (entry.knownNameId != 0 || entry.nameHash != nameHash || nameLen != fieldName.length() ||
+				    !equalsIgnoreCase(field->getData() + field->m_NameOffsetInMessage, fieldName.c_str(), nameLen))
+					continue;
+			}
+
 			if (i == index)
-				return iter->second;
+				return entry.field;
 
 			i++;
 		}
@@ -388,6 +544,27 @@ namespace pcpp
 		return nullptr;
 	}
 
+	TextBasedProtocolMessage::FieldIndexEntry TextBasedProtocolMessage::makeFieldIndexEntry(HeaderField* field) const
+	{
+		// the end-of-header field has no name, it's indexed with an empty name
+		const char* name = field->getData() + field->m_NameOffsetInMessage;
+		size_t nameLen = (field->m_FieldNameSize != static_cast<size_t>(-1) ? field->m_FieldNameSize : 0);
+
+		FieldIndexEntry entry;
+		entry.field = field;
+		entry.nameHash = hashFieldName(name, nameLen);
+		entry.knownNameId = getKnownFieldNameId(name, nameLen, entry.nameHash);
+		return entry;
+	}
+
+	void TextBasedProtocolMessage::unindexField(HeaderField* field)
+	{
+		auto position = std::find_if(m_FieldIndex.begin(), m_FieldIndex.end(),
+		                             [field](const FieldIndexEntry& entry) { return entry.field == field; });
+		if (position != m_FieldIndex.end())
+			m_FieldIndex.erase(position);
+	}
+
 	int TextBasedProtocolMessage::getFieldCount() const
 	{
 		int result = 0;
@@ -431,8 +608,10 @@ namespace pcpp
 	      m_SpacesAllowedBetweenNameAndValue(spacesAllowedBetweenNameAndValue)
 	{
 		char* fieldData = reinterpret_cast<char*>(m_TextBasedProtocolMessage->m_Data + m_NameOffsetInMessage);
-		char* fieldEndPtr = static_cast<char*>(memchr(
-		    fieldData, '\n', m_TextBasedProtocolMessage->m_DataLen - static_cast<size_t>(m_NameOffsetInMessage)));
+		const char* separatorPtr = nullptr;
+		char* fieldEndPtr = const_cast<char*>(scanHeaderField(
+		    fieldData, m_TextBasedProtocolMessage->m_DataLen - static_cast<size_t>(m_NameOffsetInMessage),
+		    nameValueSeparator, separatorPtr));
 		if (fieldEndPtr == nullptr)
 			m_FieldSize = tbp_my_own_strnlen(fieldData, m_TextBasedProtocolMessage->m_DataLen -
 			                                                static_cast<size_t>(m_NameOffsetInMessage));
@@ -451,11 +630,9 @@ namespace pcpp
 		else
 			m_IsEndOfHeaderField = false;
 
-		char* fieldValuePtr = static_cast<char*>(
-		    memchr(fieldData, nameValueSeparator,
-		           m_TextBasedProtocolMessage->m_DataLen - static_cast<size_t>(m_NameOffsetInMessage)));
+		char* fieldValuePtr = const_cast<char*>(separatorPtr);
 		// could not find the position of the separator, meaning field value position is unknown
-		if (fieldValuePtr == nullptr || (fieldEndPtr != nullptr && fieldValuePtr >= fieldEndPtr))
+		if (fieldValuePtr == nullptr)
 		{
 			m_ValueOffsetInMessage = -1;
 			m_FieldValueSize = -1;
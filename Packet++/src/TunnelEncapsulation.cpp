@@ -0,0 +1,540 @@
+#define LOG_MODULE PacketLogModulePacket
+
+#include "TunnelEncapsulation.h"
+#include "EthLayer.h"
+#include "GreLayer.h"
+#include "GtpLayer.h"
+#include "IPv4Layer.h"
+#include "IPv6Layer.h"
+#include "UdpLayer.h"
+#include "VxlanLayer.h"
+#include "PacketUtils.h"
+#include "Logger.h"
+#include "EndianPortable.h"
+#include <cstring>
+
+namespace pcpp
+{
+
+	namespace
+	{
+		constexpr size_t EthHeaderLen = sizeof(ether_header);
+		constexpr size_t VlanTagLen = 4;
+		constexpr size_t IPv6HeaderLen = sizeof(ip6_hdr);
+		constexpr size_t UdpHeaderLen = sizeof(udphdr);
+		constexpr size_t VxlanHeaderLen = 8;
+		constexpr size_t GtpHeaderLen = 8;
+		constexpr uint16_t GtpUPort = 2152;
+		constexpr size_t MaxLengthFieldValue = 0xffff;
+
+		uint16_t readUint16(const uint8_t* data)
+		{
+			uint16_t value;
+			memcpy(&value, data, sizeof(value));
+			return be16toh(value);
+		}
+
+		void writeUint16(uint8_t* data, uint16_t value)
+		{
+			value = htobe16(value);
+			memcpy(data, &value, sizeof(value));
+		}
+
+		// returns the offset of the L3 header of an Ethernet frame, skipping VLAN tags, and its EtherType
+		size_t getL3Offset(const uint8_t* data, size_t dataLen, uint16_t& etherType)
+		{
+			if (dataLen < EthHeaderLen)
+				return 0;
+
+			size_t offset = EthHeaderLen;
+			etherType = readUint16(data + offset - 2);
+			while (etherType == PCPP_ETHERTYPE_VLAN || etherType == PCPP_ETHERTYPE_IEEE_802_1AD)
+			{
+				if (dataLen < offset + VlanTagLen)
+					return 0;
+
+				offset += VlanTagLen;
+				etherType = readUint16(data + offset - 2);
+			}
+
+			return offset;
+		}
+
+		bool isIPEtherType(uint16_t etherType)
+		{
+			return etherType == PCPP_ETHERTYPE_IP || etherType == PCPP_ETHERTYPE_IPV6;
+		}
+
+		// returns the length of a GTP-U G-PDU header including its extension headers, or 0 if it isn't one
+		size_t getGtpUHeaderLen(const uint8_t* data, size_t dataLen)
+		{
+			if (dataLen < GtpHeaderLen)
+				return 0;
+
+			const gtpv1_header* gtpHeader = reinterpret_cast<const gtpv1_header*>(data);
+			if (gtpHeader->version != 1 || gtpHeader->protocolType != 1 || gtpHeader->messageType != GtpV1_GPDU)
+				return 0;
+
+			if (!gtpHeader->extensionHeaderFlag && !gtpHeader->sequenceNumberFlag && !gtpHeader->npduNumberFlag)
+				return GtpHeaderLen;
+
+			// the optional fields: sequence number, N-PDU number and next extension header type
+			size_t headerLen = GtpHeaderLen + 4;
+			if (dataLen < headerLen)
+				return 0;
+
+			if (!gtpHeader->extensionHeaderFlag)
+				return headerLen;
+
+			uint8_t nextExtType = data[headerLen - 1];
+			while (nextExtType != 0)
+			{
+				// the extension length is in 4-byte units and includes the next extension header type
+				if (dataLen < headerLen + 1 || data[headerLen] == 0)
+					return 0;
+
+				headerLen += static_cast<size_t>(data[headerLen]) * 4;
+				if (dataLen < headerLen)
+					return 0;
+
+				nextExtType = data[headerLen - 1];
+			}
+
+			return headerLen;
+		}
+
+		// returns the length of a GRE version 0 header, or 0 if it isn't one or it has routing information
+		size_t getGreHeaderLen(const uint8_t* data, size_t dataLen)
+		{
+			if (dataLen < sizeof(gre_basic_header))
+				return 0;
+
+			const gre_basic_header* greHeader = reinterpret_cast<const gre_basic_header*>(data);
+			if (greHeader->version != 0 || greHeader->routingBit)
+				return 0;
+
+			size_t headerLen = sizeof(gre_basic_header);
+			if (greHeader->checksumBit)
+				headerLen += 4;
+			if (greHeader->keyBit)
+				headerLen += 4;
+			if (greHeader->sequenceNumBit)
+				headerLen += 4;
+
+			return dataLen < headerLen ? 0 : headerLen;
+		}
+
+	}  // namespace
+
+	TunnelEncapsulator::TunnelEncapsulator(Packet& outerHeaders)
+	    : m_TunnelType(TunnelType::VXLAN), m_Valid(false), m_InnerEthernet(false), m_IsIPv4(false), m_IPOffset(0),
+	      m_UdpOffset(0), m_TunnelOffset(0)
+	{
+		outerHeaders.computeCalculateFields();
+
+		Layer* curLayer = outerHeaders.getFirstLayer();
+		if (curLayer == nullptr || curLayer->getProtocol() != Ethernet)
+		{
+			PCPP_LOG_ERROR("Outer headers must start with an Ethernet layer");
+			return;
+		}
+
+		size_t offset = curLayer->getHeaderLen();
+		curLayer = curLayer->getNextLayer();
+		while (curLayer != nullptr && curLayer->getProtocol() == VLAN)
+		{
+			offset += curLayer->getHeaderLen();
+			curLayer = curLayer->getNextLayer();
+		}
+
+		if (curLayer == nullptr || (curLayer->getProtocol() != IPv4 && curLayer->getProtocol() != IPv6))
+		{
+			PCPP_LOG_ERROR("Outer headers must contain an IPv4 or IPv6 layer after the Ethernet layer");
+			return;
+		}
+
+		m_IsIPv4 = curLayer->getProtocol() == IPv4;
+		m_IPOffset = offset;
+		offset += curLayer->getHeaderLen();
+		curLayer = curLayer->getNextLayer();
+
+		if (curLayer == nullptr)
+		{
+			m_TunnelType = TunnelType::IPinIP;
+			m_TunnelOffset = offset;
+		}
+		else if (curLayer->getProtocol() == UDP)
+		{
+			m_UdpOffset = offset;
+			offset += curLayer->getHeaderLen();
+			m_TunnelOffset = offset;
+			curLayer = curLayer->getNextLayer();
+			if (curLayer != nullptr && curLayer->getProtocol() == VXLAN)
+			{
+				m_TunnelType = TunnelType::VXLAN;
+				m_InnerEthernet = true;
+			}
+			else if (curLayer != nullptr && curLayer->getProtocol() == GTPv1 &&
+			         static_cast<GtpV1Layer*>(curLayer)->getMessageType() == GtpV1_GPDU)
+			{
+				m_TunnelType = TunnelType::GTPv1U;
+			}
+			else
+			{
+				PCPP_LOG_ERROR("UDP outer headers must be followed by a VXLAN layer or a GTP-U G-PDU layer");
+				return;
+			}
+		}
+		else if (curLayer->getProtocol() == GREv0)
+		{
+			gre_basic_header* greHeader = static_cast<GREv0Layer*>(curLayer)->getGreHeader();
+			if (greHeader->checksumBit || greHeader->sequenceNumBit || greHeader->routingBit)
+			{
+				PCPP_LOG_ERROR("GRE outer headers with checksum, sequence number or routing aren't supported");
+				return;
+			}
+
+			m_TunnelType = TunnelType::GRE;
+			m_TunnelOffset = offset;
+			m_InnerEthernet = be16toh(greHeader->protocol) == PCPP_ETHERTYPE_ETHBRIDGE;
+		}
+		else
+		{
+			PCPP_LOG_ERROR("Unsupported tunnel layer after the outer IP layer");
+			return;
+		}
+
+		if (curLayer != nullptr)
+		{
+			offset += curLayer->getHeaderLen();
+			if (curLayer->getNextLayer() != nullptr)
+			{
+				PCPP_LOG_ERROR("Outer headers must end with the tunnel layer");
+				return;
+			}
+		}
+
+		if (offset != static_cast<size_t>(outerHeaders.getRawPacket()->getRawDataLen()))
+		{
+			PCPP_LOG_ERROR("Outer headers contain trailing data");
+			return;
+		}
+
+		const uint8_t* data = outerHeaders.getRawPacket()->getRawData();
+		m_Header.assign(data, data + offset);
+		m_Valid = true;
+	}
+
+	bool TunnelEncapsulator::encapsulate(RawPacket& rawPacket) const
+	{
+		if (!m_Valid)
+		{
+			PCPP_LOG_ERROR("Tunnel encapsulator isn't valid");
+			return false;
+		}
+
+		if (rawPacket.getLinkLayerType() != LINKTYPE_ETHERNET)
+		{
+			PCPP_LOG_ERROR("Only Ethernet packets can be encapsulated");
+			return false;
+		}
+
+		// tunnels that carry IP packets drop the Ethernet header and VLAN tags of the inner packet
+		size_t innerOffset = 0;
+		uint16_t innerEtherType = 0;
+		if (!m_InnerEthernet)
+		{
+			innerOffset = getL3Offset(rawPacket.getRawData(), rawPacket.getRawDataLen(), innerEtherType);
+			if (innerOffset == 0 || !isIPEtherType(innerEtherType))
+			{
+				PCPP_LOG_ERROR("Packet doesn't contain an IPv4 or IPv6 packet to encapsulate");
+				return false;
+			}
+		}
+		else if (static_cast<size_t>(rawPacket.getRawDataLen()) < EthHeaderLen)
+		{
+			PCPP_LOG_ERROR("Packet is too short to be an Ethernet packet");
+			return false;
+		}
+
+		// the outer IP length covers at least the bytes of the UDP and GTP lengths, so if it fits they fit too
+		size_t headerLen = m_Header.size();
+		size_t ipLength = static_cast<size_t>(rawPacket.getRawDataLen()) - innerOffset + headerLen - m_IPOffset;
+		if (!m_IsIPv4)
+			ipLength -= IPv6HeaderLen;
+		if (ipLength > MaxLengthFieldValue)
+		{
+			PCPP_LOG_ERROR("Packet is too long to be encapsulated, the outer IP length would be " << ipLength);
+			return false;
+		}
+
+		if (headerLen > innerOffset && rawPacket.getHeadroom() < headerLen - innerOffset &&
+		    !rawPacket.reserveRoom(headerLen - innerOffset, 0))
+		{
+			PCPP_LOG_ERROR("Couldn't allocate headroom for the outer headers");
+			return false;
+		}
+
+		if (innerOffset > 0 && !rawPacket.removeDataFromStart(innerOffset))
+			return false;
+
+		if (!rawPacket.prependData(m_Header.data(), headerLen))
+			return false;
+
+		uint8_t* data = const_cast<uint8_t*>(rawPacket.getRawData());
+		size_t dataLen = static_cast<size_t>(rawPacket.getRawDataLen());
+		uint8_t* ipHeader = data + m_IPOffset;
+
+		uint8_t ipProtocol = 0;
+		if (m_TunnelType == TunnelType::IPinIP)
+			ipProtocol = innerEtherType == PCPP_ETHERTYPE_IP ? PACKETPP_IPPROTO_IPIP : PACKETPP_IPPROTO_IPV6;
+
+		if (m_IsIPv4)
+		{
+			iphdr* ipv4Header = reinterpret_cast<iphdr*>(ipHeader);
+			ipv4Header->totalLength = htobe16(static_cast<uint16_t>(dataLen - m_IPOffset));
+			if (ipProtocol != 0)
+				ipv4Header->protocol = ipProtocol;
+
+			ipv4Header->headerChecksum = 0;
+			ScalarBuffer<uint16_t> scalar = { reinterpret_cast<uint16_t*>(ipHeader),
+				                              static_cast<size_t>(ipv4Header->internetHeaderLength * 4) };
+			ipv4Header->headerChecksum = htobe16(computeChecksum(&scalar, 1));
+		}
+		else
+		{
+			ip6_hdr* ipv6Header = reinterpret_cast<ip6_hdr*>(ipHeader);
+			ipv6Header->payloadLength = htobe16(static_cast<uint16_t>(dataLen - m_IPOffset - IPv6HeaderLen));
+			if (ipProtocol != 0)
+				ipv6Header->nextHeader = ipProtocol;
+		}
+
+		if (m_TunnelType == TunnelType::GTPv1U)
+		{
+			gtpv1_header* gtpHeader = reinterpret_cast<gtpv1_header*>(data + m_TunnelOffset);
+			gtpHeader->messageLength = htobe16(static_cast<uint16_t>(dataLen - m_TunnelOffset - GtpHeaderLen));
+		}
+		else if (m_TunnelType == TunnelType::GRE && !m_InnerEthernet)
+		{
+			gre_basic_header* greHeader = reinterpret_cast<gre_basic_header*>(data + m_TunnelOffset);
+			greHeader->protocol = htobe16(innerEtherType);
+		}
+
+		if (m_UdpOffset != 0)
+		{
+			udphdr* udpHeader = reinterpret_cast<udphdr*>(data + m_UdpOffset);
+			size_t udpLen = dataLen - m_UdpOffset;
+			udpHeader->length = htobe16(static_cast<uint16_t>(udpLen));
+			udpHeader->headerChecksum = 0;
+
+			// the UDP checksum is optional over IPv4 and covers the whole inner packet, so it's only computed over IPv6
+			if (!m_IsIPv4)
+			{
+				const ip6_hdr* ipv6Header = reinterpret_cast<const ip6_hdr*>(ipHeader);
+				uint16_t checksum =
+				    computePseudoHdrChecksum(data + m_UdpOffset, udpLen, IPAddress::IPv6AddressType,
+				                             PACKETPP_IPPROTO_UDP, IPv6Address(ipv6Header->ipSrc),
+				                             IPv6Address(ipv6Header->ipDst));
+				udpHeader->headerChecksum = htobe16(checksum == 0 ? 0xffff : checksum);
+			}
+		}
+
+		return true;
+	}
+
+	size_t TunnelEncapsulator::encapsulate(RawPacket* rawPackets, size_t count) const
+	{
+		size_t result = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			if (encapsulate(rawPackets[i]))
+				result++;
+		}
+
+		return result;
+	}
+
+	size_t TunnelEncapsulator::encapsulate(RawPacket** rawPackets, size_t count) const
+	{
+		size_t result = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			if (rawPackets[i] != nullptr && encapsulate(*rawPackets[i]))
+				result++;
+		}
+
+		return result;
+	}
+
+	bool decapsulateTunnel(RawPacket& rawPacket, TunnelType* tunnelType)
+	{
+		if (rawPacket.getLinkLayerType() != LINKTYPE_ETHERNET)
+			return false;
+
+		uint8_t* data = const_cast<uint8_t*>(rawPacket.getRawData());
+		size_t dataLen = static_cast<size_t>(rawPacket.getRawDataLen());
+
+		uint16_t etherType = 0;
+		size_t ipOffset = getL3Offset(data, dataLen, etherType);
+		if (ipOffset == 0)
+			return false;
+
+		uint8_t ipProtocol;
+		size_t offset;
+		if (etherType == PCPP_ETHERTYPE_IP)
+		{
+			if (dataLen < ipOffset + sizeof(iphdr))
+				return false;
+
+			const iphdr* ipv4Header = reinterpret_cast<const iphdr*>(data + ipOffset);
+			size_t ipHeaderLen = static_cast<size_t>(ipv4Header->internetHeaderLength) * 4;
+			if (ipv4Header->ipVersion != 4 || ipHeaderLen < sizeof(iphdr) || dataLen < ipOffset + ipHeaderLen ||
+			    (be16toh(ipv4Header->fragmentOffset) & 0x3fff) != 0)
+				return false;
+
+			ipProtocol = ipv4Header->protocol;
+			offset = ipOffset + ipHeaderLen;
+		}
+		else if (etherType == PCPP_ETHERTYPE_IPV6)
+		{
+			if (dataLen < ipOffset + IPv6HeaderLen)
+				return false;
+
+			ipProtocol = reinterpret_cast<const ip6_hdr*>(data + ipOffset)->nextHeader;
+			offset = ipOffset + IPv6HeaderLen;
+		}
+		else
+		{
+			return false;
+		}
+
+		TunnelType type;
+		uint16_t innerEtherType = 0;
+		switch (ipProtocol)
+		{
+		case PACKETPP_IPPROTO_UDP:
+		{
+			if (dataLen < offset + UdpHeaderLen)
+				return false;
+
+			uint16_t dstPort = readUint16(data + offset + 2);
+			offset += UdpHeaderLen;
+			if (VxlanLayer::isVxlanPort(dstPort))
+			{
+				if (dataLen < offset + VxlanHeaderLen + EthHeaderLen)
+					return false;
+
+				type = TunnelType::VXLAN;
+				offset += VxlanHeaderLen;
+			}
+			else if (dstPort == GtpUPort)
+			{
+				size_t gtpHeaderLen = getGtpUHeaderLen(data + offset, dataLen - offset);
+				if (gtpHeaderLen == 0 || dataLen <= offset + gtpHeaderLen)
+					return false;
+
+				type = TunnelType::GTPv1U;
+				offset += gtpHeaderLen;
+				uint8_t ipVersion = data[offset] >> 4;
+				if (ipVersion == 4)
+					innerEtherType = PCPP_ETHERTYPE_IP;
+				else if (ipVersion == 6)
+					innerEtherType = PCPP_ETHERTYPE_IPV6;
+				else
+					return false;
+			}
+			else
+			{
+				return false;
+			}
+			break;
+		}
+		case PACKETPP_IPPROTO_GRE:
+		{
+			size_t greHeaderLen = getGreHeaderLen(data + offset, dataLen - offset);
+			if (greHeaderLen == 0)
+				return false;
+
+			uint16_t protocol = readUint16(data + offset + 2);
+			offset += greHeaderLen;
+			if (protocol == PCPP_ETHERTYPE_ETHBRIDGE)
+			{
+				if (dataLen < offset + EthHeaderLen)
+					return false;
+			}
+			else if (isIPEtherType(protocol) && dataLen > offset)
+			{
+				innerEtherType = protocol;
+			}
+			else
+			{
+				return false;
+			}
+
+			type = TunnelType::GRE;
+			break;
+		}
+		case PACKETPP_IPPROTO_IPIP:
+		case PACKETPP_IPPROTO_IPV6:
+		{
+			if (dataLen <= offset)
+				return false;
+
+			uint8_t expectedVersion = ipProtocol == PACKETPP_IPPROTO_IPIP ? 4 : 6;
+			if ((data[offset] >> 4) != expectedVersion)
+				return false;
+
+			type = TunnelType::IPinIP;
+			innerEtherType = ipProtocol == PACKETPP_IPPROTO_IPIP ? PCPP_ETHERTYPE_IP : PCPP_ETHERTYPE_IPV6;
+			break;
+		}
+		default:
+			return false;
+		}
+
+		if (innerEtherType == 0)
+		{
+			// the inner packet is an Ethernet frame
+			if (!rawPacket.removeDataFromStart(offset))
+				return false;
+		}
+		else
+		{
+			// keep the outer Ethernet header and VLAN tags in front of the inner IP packet
+			memmove(data + offset - ipOffset, data, ipOffset);
+			writeUint16(data + offset - 2, innerEtherType);
+			if (!rawPacket.removeDataFromStart(offset - ipOffset))
+				return false;
+		}
+
+		if (tunnelType != nullptr)
+			*tunnelType = type;
+
+		return true;
+	}
+
+	size_t decapsulateTunnel(RawPacket* rawPackets, size_t count)
+	{
+		size_t result = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			if (decapsulateTunnel(rawPackets[i]))
+				result++;
+		}
+
+		return result;
+	}
+
+	size_t decapsulateTunnel(RawPacket** rawPackets, size_t count)
+	{
+		size_t result = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			if (rawPackets[i] != nullptr && decapsulateTunnel(*rawPackets[i]))
+				result++;
+		}
+
+		return result;
+	}
+
+}  // namespace pcpp
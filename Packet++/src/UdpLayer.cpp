@@ -5,17 +5,39 @@
 #include "PayloadLayer.h"
 #include "IPv4Layer.h"
 #include "IPv6Layer.h"
-#include "DnsLayer.h"
-#include "DhcpLayer.h"
-#include "DhcpV6Layer.h"
-#include "VxlanLayer.h"
-#include "SipLayer.h"
-#include "RadiusLayer.h"
-#include "GtpLayer.h"
-#include "NtpLayer.h"
-#include "SomeIpLayer.h"
-#include "WakeOnLanLayer.h"
-#include "WireGuardLayer.h"
+#ifndef PCPP_EXCLUDE_PROTOCOL_DNS
+#	include "DnsLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_DHCP
+#	include "DhcpLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_DHCPV6
+#	include "DhcpV6Layer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_VXLAN
+#	include "VxlanLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_SIP
+#	include "SipLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_RADIUS
+#	include "RadiusLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_GTP
+#	include "GtpLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_NTP
+#	include "NtpLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_SOMEIP
+#	include "SomeIpLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_WAKEONLAN
+#	include "WakeOnLanLayer.h"
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_WIREGUARD
+#	include "WireGuardLayer.h"
+#endif
 #include "PacketUtils.h"
 #include "Logger.h"
 #include <sstream>
@@ -23,6 +45,191 @@
 namespace pcpp
 {
 
+	namespace
+	{
+#ifndef PCPP_EXCLUDE_PROTOCOL_DHCP
+		Layer* dissectDhcp(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t srcPort,
+		                   uint16_t dstPort)
+		{
+			if (DhcpLayer::isDhcpPorts(srcPort, dstPort))
+				return new DhcpLayer(data, dataLen, prevLayer, packet);
+
+			return nullptr;
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_VXLAN
+		Layer* dissectVxlan(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t,
+		                    uint16_t dstPort)
+		{
+			if (VxlanLayer::isVxlanPort(dstPort))
+				return new VxlanLayer(data, dataLen, prevLayer, packet);
+
+			return nullptr;
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_DNS
+		Layer* dissectDns(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t, uint16_t)
+		{
+			if (DnsLayer::isDataValid(data, dataLen))
+				return new DnsLayer(data, dataLen, prevLayer, packet);
+
+			return nullptr;
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_SIP
+		Layer* dissectSip(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t, uint16_t)
+		{
+			char* dataChar = reinterpret_cast<char*>(data);
+			if (SipRequestFirstLine::parseMethod(dataChar, dataLen) != SipRequestLayer::SipMethodUnknown)
+				return new SipRequestLayer(data, dataLen, prevLayer, packet);
+
+			if (SipResponseFirstLine::parseStatusCode(dataChar, dataLen) != SipResponseLayer::SipStatusCodeUnknown &&
+			    SipResponseFirstLine::parseVersion(dataChar, dataLen) != "")
+				return new SipResponseLayer(data, dataLen, prevLayer, packet);
+
+			return new PayloadLayer(data, dataLen, prevLayer, packet);
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_RADIUS
+		Layer* dissectRadius(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t, uint16_t)
+		{
+			if (RadiusLayer::isDataValid(data, dataLen))
+				return new RadiusLayer(data, dataLen, prevLayer, packet);
+
+			return nullptr;
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_GTP
+		Layer* dissectGtpV1(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t, uint16_t)
+		{
+			if (GtpV1Layer::isGTPv1(data, dataLen))
+				return new GtpV1Layer(data, dataLen, prevLayer, packet);
+
+			return nullptr;
+		}
+
+		Layer* dissectGtpV2(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t, uint16_t)
+		{
+			if (GtpV2Layer::isDataValid(data, dataLen))
+				return new GtpV2Layer(data, dataLen, prevLayer, packet);
+
+			return nullptr;
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_DHCPV6
+		Layer* dissectDhcpV6(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t, uint16_t)
+		{
+			if (DhcpV6Layer::isDataValid(data, dataLen))
+				return new DhcpV6Layer(data, dataLen, prevLayer, packet);
+
+			return nullptr;
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_NTP
+		Layer* dissectNtp(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t, uint16_t)
+		{
+			if (NtpLayer::isDataValid(data, dataLen))
+				return new NtpLayer(data, dataLen, prevLayer, packet);
+
+			return nullptr;
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_SOMEIP
+		// SOME/IP ports are configured at runtime, so this dissector is called for all ports and checks them itself
+		Layer* dissectSomeIp(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t srcPort,
+		                     uint16_t dstPort)
+		{
+			if (SomeIpLayer::isSomeIpPort(srcPort) || SomeIpLayer::isSomeIpPort(dstPort))
+				return SomeIpLayer::parseSomeIpLayer(data, dataLen, prevLayer, packet);
+
+			return nullptr;
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_WAKEONLAN
+		Layer* dissectWakeOnLan(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t,
+		                        uint16_t dstPort)
+		{
+			if (WakeOnLanLayer::isWakeOnLanPort(dstPort) && WakeOnLanLayer::isDataValid(data, dataLen))
+				return new WakeOnLanLayer(data, dataLen, prevLayer, packet);
+
+			return nullptr;
+		}
+#endif
+
+#ifndef PCPP_EXCLUDE_PROTOCOL_WIREGUARD
+		Layer* dissectWireGuard(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet, uint16_t, uint16_t)
+		{
+			if (!WireGuardLayer::isDataValid(data, dataLen))
+				return nullptr;
+
+			Layer* wireGuardLayer = WireGuardLayer::parseWireGuardLayer(data, dataLen, prevLayer, packet);
+			if (wireGuardLayer == nullptr)
+				return new PayloadLayer(data, dataLen, prevLayer, packet);
+
+			return wireGuardLayer;
+		}
+#endif
+
+		// the priorities keep the order in which these protocols were always checked
+		PortDissectorTable createDissectorTable()
+		{
+			PortDissectorTable table;
+#ifndef PCPP_EXCLUDE_PROTOCOL_DHCP
+			table.registerDissector("DHCP", 100, dissectDhcp, { 67, 68 });
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_VXLAN
+			table.registerDissector("VXLAN", 200, dissectVxlan,
+			                        PortDissectorTable::getMatchingPorts(VxlanLayer::isVxlanPort));
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_DNS
+			table.registerDissector("DNS", 300, dissectDns, PortDissectorTable::getMatchingPorts(DnsLayer::isDnsPort));
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_SIP
+			table.registerDissector("SIP", 400, dissectSip, PortDissectorTable::getMatchingPorts(SipLayer::isSipPort));
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_RADIUS
+			table.registerDissector("RADIUS", 500, dissectRadius,
+			                        PortDissectorTable::getMatchingPorts(RadiusLayer::isRadiusPort));
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_GTP
+			table.registerDissector("GTPv1", 600, dissectGtpV1,
+			                        PortDissectorTable::getMatchingPorts(GtpV1Layer::isGTPv1Port));
+			table.registerDissector("GTPv2", 700, dissectGtpV2,
+			                        PortDissectorTable::getMatchingPorts(GtpV2Layer::isGTPv2Port));
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_DHCPV6
+			table.registerDissector("DHCPv6", 800, dissectDhcpV6,
+			                        PortDissectorTable::getMatchingPorts(DhcpV6Layer::isDhcpV6Port));
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_NTP
+			table.registerDissector("NTP", 900, dissectNtp, PortDissectorTable::getMatchingPorts(NtpLayer::isNTPPort));
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_SOMEIP
+			table.registerHeuristicDissector("SOME/IP", 1000, dissectSomeIp);
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_WAKEONLAN
+			table.registerDissector("WakeOnLan", 1100, dissectWakeOnLan,
+			                        PortDissectorTable::getMatchingPorts(WakeOnLanLayer::isWakeOnLanPort));
+#endif
+#ifndef PCPP_EXCLUDE_PROTOCOL_WIREGUARD
+			table.registerDissector("WireGuard", 1200, dissectWireGuard,
+			                        PortDissectorTable::getMatchingPorts([](uint16_t port) {
+				                        return WireGuardLayer::isWireGuardPorts(port, port);
+			                        }));
+#endif
+			return table;
+		}
+	}  // namespace
+
 	UdpLayer::UdpLayer(uint16_t portSrc, uint16_t portDst)
 	{
 		const size_t headerLen = sizeof(udphdr);
@@ -89,62 +296,25 @@ namespace pcpp
 		return checksumRes;
 	}
 
+	PortDissectorTable& UdpLayer::getDissectorTable()
+	{
+		static PortDissectorTable dissectorTable = createDissectorTable();
+		return dissectorTable;
+	}
+
+	// build the table when the library is loaded rather than when the first packet is parsed
+	static PortDissectorTable& initialUdpDissectorTable = UdpLayer::getDissectorTable();
+
 	void UdpLayer::parseNextLayer()
 	{
 		if (m_DataLen <= sizeof(udphdr))
 			return;
 
-		uint16_t portDst = getDstPort();
-		uint16_t portSrc = getSrcPort();
-
 		uint8_t* udpData = m_Data + sizeof(udphdr);
 		size_t udpDataLen = m_DataLen - sizeof(udphdr);
 
-		if (DhcpLayer::isDhcpPorts(portSrc, portDst))
-			m_NextLayer = new DhcpLayer(udpData, udpDataLen, this, m_Packet);
-		else if (VxlanLayer::isVxlanPort(portDst))
-			m_NextLayer = new VxlanLayer(udpData, udpDataLen, this, m_Packet);
-		else if (DnsLayer::isDataValid(udpData, udpDataLen) &&
-		         (DnsLayer::isDnsPort(portDst) || DnsLayer::isDnsPort(portSrc)))
-			m_NextLayer = new DnsLayer(udpData, udpDataLen, this, m_Packet);
-		else if (SipLayer::isSipPort(portDst) || SipLayer::isSipPort(portSrc))
-		{
-			if (SipRequestFirstLine::parseMethod((char*)udpData, udpDataLen) != SipRequestLayer::SipMethodUnknown)
-				m_NextLayer = new SipRequestLayer(udpData, udpDataLen, this, m_Packet);
-			else if (SipResponseFirstLine::parseStatusCode((char*)udpData, udpDataLen) !=
-			             SipResponseLayer::SipStatusCodeUnknown &&
-			         SipResponseFirstLine::parseVersion((char*)udpData, udpDataLen) != "")
-				m_NextLayer = new SipResponseLayer(udpData, udpDataLen, this, m_Packet);
-			else
-				m_NextLayer = new PayloadLayer(udpData, udpDataLen, this, m_Packet);
-		}
-		else if ((RadiusLayer::isRadiusPort(portDst) || RadiusLayer::isRadiusPort(portSrc)) &&
-		         RadiusLayer::isDataValid(udpData, udpDataLen))
-			m_NextLayer = new RadiusLayer(udpData, udpDataLen, this, m_Packet);
-		else if ((GtpV1Layer::isGTPv1Port(portDst) || GtpV1Layer::isGTPv1Port(portSrc)) &&
-		         GtpV1Layer::isGTPv1(udpData, udpDataLen))
-			m_NextLayer = new GtpV1Layer(udpData, udpDataLen, this, m_Packet);
-		else if ((GtpV2Layer::isGTPv2Port(portDst) || GtpV2Layer::isGTPv2Port(portSrc)) &&
-		         GtpV2Layer::isDataValid(udpData, udpDataLen))
-			m_NextLayer = new GtpV2Layer(udpData, udpDataLen, this, m_Packet);
-		else if ((DhcpV6Layer::isDhcpV6Port(portSrc) || DhcpV6Layer::isDhcpV6Port(portDst)) &&
-		         (DhcpV6Layer::isDataValid(udpData, udpDataLen)))
-			m_NextLayer = new DhcpV6Layer(udpData, udpDataLen, this, m_Packet);
-		else if ((NtpLayer::isNTPPort(portSrc) || NtpLayer::isNTPPort(portDst)) &&
-		         NtpLayer::isDataValid(udpData, udpDataLen))
-			m_NextLayer = new NtpLayer(udpData, udpDataLen, this, m_Packet);
-		else if (SomeIpLayer::isSomeIpPort(portSrc) || SomeIpLayer::isSomeIpPort(portDst))
-			m_NextLayer = SomeIpLayer::parseSomeIpLayer(udpData, udpDataLen, this, m_Packet);
-		else if ((WakeOnLanLayer::isWakeOnLanPort(portDst) && WakeOnLanLayer::isDataValid(udpData, udpDataLen)))
-			m_NextLayer = new WakeOnLanLayer(udpData, udpDataLen, this, m_Packet);
-		else if ((WireGuardLayer::isWireGuardPorts(portDst, portSrc) &&
-		          WireGuardLayer::isDataValid(udpData, udpDataLen)))
-		{
-			m_NextLayer = WireGuardLayer::parseWireGuardLayer(udpData, udpDataLen, this, m_Packet);
-			if (!m_NextLayer)
-				m_NextLayer = new PayloadLayer(udpData, udpDataLen, this, m_Packet);
-		}
-		else
+		m_NextLayer = getDissectorTable().dissect(udpData, udpDataLen, this, m_Packet, getSrcPort(), getDstPort());
+		if (m_NextLayer == nullptr)
 			m_NextLayer = new PayloadLayer(udpData, udpDataLen, this, m_Packet);
 	}
 
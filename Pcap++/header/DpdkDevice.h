@@ -165,6 +165,12 @@ namespace pcpp
 	 * http://dpdk.org/doc/api/rte__ethdev_8h.html#a0e941a74ae1b1b886764bc282458d946). DpdkDevice supports that option
 	 * as well. See DpdkDevice#sendPackets()<BR>
 	 *
+	 * __Jumbo frames__: packets which don't fit in a single mbuf are received and sent as chains of mbufs, if the PMD
+	 * supports scattered RX and multi-segment TX (these offloads are enabled whenever the PMD supports them).
+	 * Packets given to the sendPackets() overloads as RawPacket or Packet are copied to a chain of mbufs if they are
+	 * larger than a single mbuf. Receiving jumbo frames usually also requires raising the MTU with setMtu(). See
+	 * MBufRawPacket for how chained mbufs are accessed<BR>
+	 *
 	 * __Get interface info__: DpdkDevice provides all kind of information on the interface/device such as MAC address,
 	 * MTU, link status, PCI address, PMD (poll-mode-driver) used for this port, etc. In addition it provides RX/TX
 	 * statistics when receiving or sending packets<BR>
@@ -0,0 +1,235 @@
+#pragma once
+
+// GCOVR_EXCL_START
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "DpdkDevice.h"
+#include "Packet.h"
+
+/**
+ * @file
+ * A burst-oriented packet processing pipeline on top of DpdkDevice. See DpdkPipeline for more details
+ */
+
+struct rte_ring;
+
+/**
+ * \namespace pcpp
+ * \brief The main namespace for the PcapPlusPlus lib
+ */
+namespace pcpp
+{
+	/**
+	 * @class DpdkPipeline
+	 * A multi-core RX -> parse/classify -> TX pipeline over DPDK devices. Each stage runs on its own DPDK lcore and
+	 * the stages pass mbufs to each other in bursts through lock-free rte_rings:
+	 *    - The RX stage receives bursts of packets from one RX queue of a DpdkDevice and enqueues them to the parse
+	 *      ring
+	 *    - One or more worker stages dequeue bursts from the parse ring, parse each packet into a Packet object and
+	 *      pass it to a user classification callback. While a packet is parsed the data of the packets a few places
+	 *      ahead of it in the burst is prefetched to the CPU cache. The callback returns the index of the output the
+	 *      packet should be sent to, or DpdkPipeline#DropPacket to drop it. The callback may also edit the packet
+	 *    - The TX stage drains the ring of each output and sends the packets in bursts to the output's TX queue
+	 *
+	 * The RX queue and the TX queues of the outputs must not be used by anyone else while the pipeline is running.
+	 * Since DPDK virtual devices behave like any other port, the pipeline can run without a NIC, for example with
+	 * `--vdev=net_pcap0,rx_pcap=in.pcap,tx_pcap=out.pcap` or `--vdev=net_null0` passed to DpdkDeviceList#initDpdk()
+	 */
+	class DpdkPipeline
+	{
+	public:
+		/** The value a classification callback returns to drop a packet */
+		static constexpr int DropPacket = -1;
+
+		/**
+		 * @typedef OnPacketClassifyCallback
+		 * A callback that is called by a worker stage for every packet
+		 * @param[in] packet The parsed packet. The packet and its raw packet are valid only until the callback returns
+		 * @param[in] workerId The index of the worker stage, between 0 and the number of workers - 1
+		 * @param[in] userCookie The user cookie given in the constructor
+		 * @return The index of the output to send the packet to (as returned from addOutput()) or
+		 * DpdkPipeline#DropPacket. Packets classified to a non-existing output are dropped
+		 */
+		typedef int (*OnPacketClassifyCallback)(Packet& packet, uint8_t workerId, void* userCookie);
+
+		/**
+		 * @struct PipelineConfig
+		 * The pipeline configuration
+		 */
+		struct PipelineConfig
+		{
+			/** The maximum number of packets moved by a stage at once. Must be between 1 and 64. The default is 32 */
+			uint16_t burstSize;
+			/** The number of entries of each ring, must be a power of 2. The default is 4096 */
+			uint32_t ringSize;
+			/** How many packets ahead of the packet currently parsed to prefetch. 0 disables prefetching. The default
+			 * is 4 */
+			uint8_t prefetchOffset;
+			/** Parse each packet only until this protocol. The default is UnknownProtocol which means parse all
+			 * layers */
+			ProtocolTypeFamily parseUntil;
+			/** Parse each packet only until this OSI layer. The default is OsiModelLayerUnknown which means parse all
+			 * layers */
+			OsiModelLayer parseUntilLayer;
+
+			/**
+			 * A c'tor for this struct
+			 * @param[in] burstSize The burst size, default is 32
+			 * @param[in] ringSize The ring size, default is 4096
+			 * @param[in] prefetchOffset The prefetch offset, default is 4
+			 */
+			explicit PipelineConfig(uint16_t burstSize = 32, uint32_t ringSize = 4096, uint8_t prefetchOffset = 4)
+			    : burstSize(burstSize), ringSize(ringSize), prefetchOffset(prefetchOffset),
+			      parseUntil(UnknownProtocol), parseUntilLayer(OsiModelLayerUnknown)
+			{}
+		};
+
+		/**
+		 * @struct PipelineStats
+		 * Packet counters of all stages
+		 */
+		struct PipelineStats
+		{
+			/** Packets received by the RX stage */
+			uint64_t rxPackets;
+			/** Packets dropped by the RX stage because the parse ring was full */
+			uint64_t rxRingDrops;
+			/** Packets parsed by the worker stages */
+			uint64_t parsedPackets;
+			/** Packets dropped by the classification callback */
+			uint64_t classifierDrops;
+			/** Packets dropped by the worker stages because an output ring was full */
+			uint64_t txRingDrops;
+			/** Packets sent by the TX stage */
+			uint64_t txPackets;
+			/** Packets dropped by the TX stage because the device didn't accept them */
+			uint64_t txDrops;
+		};
+
+		/**
+		 * A c'tor for this class. The pipeline isn't started until start() is called
+		 * @param[in] rxDevice The device to receive packets from. Must be opened before start() is called
+		 * @param[in] rxQueueId The RX queue to receive packets from
+		 * @param[in] onPacketClassify The classification callback
+		 * @param[in] userCookie A pointer passed to the classification callback
+		 * @param[in] config The pipeline configuration
+		 */
+		DpdkPipeline(DpdkDevice* rxDevice, uint16_t rxQueueId, OnPacketClassifyCallback onPacketClassify,
+		             void* userCookie, const PipelineConfig& config = PipelineConfig());
+
+		/**
+		 * A d'tor for this class. Stops the pipeline if it's running
+		 */
+		~DpdkPipeline();
+
+		DpdkPipeline(const DpdkPipeline&) = delete;
+		DpdkPipeline& operator=(const DpdkPipeline&) = delete;
+
+		/**
+		 * Add an output the classification callback can send packets to. Can't be called while the pipeline is
+		 * running
+		 * @param[in] txDevice The device to send the packets with. Must be opened before start() is called
+		 * @param[in] txQueueId The TX queue to send the packets on
+		 * @return The output index to return from the classification callback, or -1 if the pipeline is running or
+		 * the device is nullptr
+		 */
+		int addOutput(DpdkDevice* txDevice, uint16_t txQueueId);
+
+		/**
+		 * Create the rings and start all stages. Each stage runs on its own core, which must be one of the cores
+		 * DPDK was initialized with, other than the master core
+		 * @param[in] rxCore The core to run the RX stage on
+		 * @param[in] workerCores The cores to run the worker stages on. A worker is started on each core in the mask
+		 * @param[in] txCore The core to run the TX stage on. Not used if no output was added
+		 * @return True if all stages were started, false otherwise (an error is printed to log). If false is returned
+		 * nothing remains running
+		 */
+		bool start(SystemCore rxCore, CoreMask workerCores, SystemCore txCore);
+
+		/**
+		 * Stop the pipeline. The stages are stopped one after the other starting with the RX stage, so the packets
+		 * already in the rings are still processed and sent. Does nothing if the pipeline isn't running
+		 */
+		void stop();
+
+		/**
+		 * @return True if the pipeline is running, false otherwise
+		 */
+		bool isRunning() const
+		{
+			return m_Running;
+		}
+
+		/**
+		 * @return The number of outputs added so far
+		 */
+		size_t getNumOfOutputs() const
+		{
+			return m_Outputs.size();
+		}
+
+		/**
+		 * Get the packet counters of all stages. Can be called while the pipeline is running, in which case the
+		 * counters of the different stages may be a few bursts apart
+		 * @param[out] stats The counters
+		 */
+		void getStatistics(PipelineStats& stats) const;
+
+	private:
+		enum StageType
+		{
+			RxStage,
+			WorkerStage,
+			TxStage
+		};
+
+		struct Output
+		{
+			DpdkDevice* device;
+			uint16_t txQueueId;
+			struct rte_ring* ring;
+		};
+
+		// counters are written only by the stage's own core
+		struct Stage
+		{
+			DpdkPipeline* pipeline;
+			StageType type;
+			uint32_t coreId;
+			uint8_t workerId;
+			std::atomic<uint64_t> packets;
+			std::atomic<uint64_t> drops;
+			std::atomic<uint64_t> classifierDrops;
+			std::atomic<uint64_t> ringDrops;
+
+			Stage(DpdkPipeline* pipeline, StageType type, uint32_t coreId, uint8_t workerId);
+		};
+
+		DpdkDevice* m_RxDevice;
+		uint16_t m_RxQueueId;
+		OnPacketClassifyCallback m_OnPacketClassify;
+		void* m_UserCookie;
+		PipelineConfig m_Config;
+		std::vector<Output> m_Outputs;
+		std::vector<std::unique_ptr<Stage>> m_Stages;
+		struct rte_ring* m_ParseRing;
+		bool m_Running;
+		std::atomic<bool> m_StopRx;
+		std::atomic<bool> m_StopWorkers;
+		std::atomic<bool> m_StopTx;
+
+		bool createRings();
+		void freeRings();
+		void waitForStages(StageType type);
+
+		static int stageMain(void* ptr);
+		void runRxStage(Stage& stage);
+		void runWorkerStage(Stage& stage);
+		void runTxStage(Stage& stage);
+	};
+
+}  // namespace pcpp
+
+// GCOVR_EXCL_STOP
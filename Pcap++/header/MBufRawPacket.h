@@ -23,6 +23,10 @@ namespace pcpp
 
 #define MBUFRAWPACKET_OBJECT_TYPE 1
 
+/// The number of bytes moved to the first segment of a chained mbuf when it's attached to MBufRawPacket, if the first
+/// segment is shorter
+#define MBUFRAWPACKET_HEADER_PULLUP_LEN 256
+
 	/**
 	 * @class MBufRawPacket
 	 * A class that inherits RawPacket and wraps DPDK's mbuf object (see some info about mbuf in DpdkDevice.h) but is
@@ -39,15 +43,24 @@ namespace pcpp
 	 *      user should call the init() method after constructing the object in order to allocate a new mbuf from DPDK
 	 *      port pool (encapsulated by DpdkDevice)
 	 *
-	 * Limitations of this class:
-	 *    - Currently chained mbufs are not supported. An mbuf has the capability to be linked to another mbuf and
-	 *      create a linked list of mbufs. This is good for Jumbo packets or other uses. MBufRawPacket doesn't support
-	 *      this capability so there is no way to access the mbufs linked to the mbuf wrapped by MBufRawPacket instance.
-	 *      I hope I'll be able to add this support in the future
+	 * Chained mbufs: an mbuf can be linked to other mbufs to hold a packet which doesn't fit in a single mbuf, for
+	 * example a jumbo frame or a packet coalesced by GRO/LRO. When MBufRawPacket wraps such a chain:
+	 *    - The raw data (getRawData(), getRawDataLen()) is the data of the first segment only, while getFrameLength()
+	 *      is the length of the whole packet. This means a Packet created from it parses the headers in the first
+	 *      segment and sees the rest of the packet as truncated, the same as a packet captured with a snapshot length.
+	 *      When a chain is attached the first #MBUFRAWPACKET_HEADER_PULLUP_LEN bytes are moved to the first segment if
+	 *      it's shorter than that, so headers spanning several segments can still be parsed
+	 *    - The whole packet can be accessed by iterating its segments (getFirstSegment(), getNextSegment()), by
+	 *      copying a range out of it (readData()) or by linearizing it into the first segment (linearize()) if the
+	 *      first mbuf is large enough
+	 *    - Data can be inserted or removed only in the first segment, as long as it has enough tailroom
+	 *    - initFromRawPacket() and setRawData() create a chain if the data doesn't fit in a single mbuf, and
+	 *      DpdkDevice sends chains as multi-segment packets
 	 */
 	class MBufRawPacket : public RawPacket
 	{
 		friend class DpdkDevice;
+		friend class DpdkPipeline;
 #ifdef USE_DPDK_KNI
 		friend class KniDevice;
 #endif
@@ -62,7 +75,28 @@ namespace pcpp
 		bool init(struct rte_mempool* mempool);
 		bool initFromRawPacket(const RawPacket* rawPacket, struct rte_mempool* mempool);
 
+		// point the raw data to the first segment of the mbuf and set the frame length to the length of all segments
+		void setRawDataFromMBuf(timespec timestamp, LinkLayerType layerType);
+		// turn the mbuf into an empty single segment
+		void resetMBuf();
+		// append data to the end of the mbuf, allocating more segments from the pool if needed
+		bool appendToMBufChain(const uint8_t* data, size_t dataLen);
+
 	public:
+		/**
+		 * @struct Segment
+		 * A segment of a packet which spans a chain of mbufs
+		 */
+		struct Segment
+		{
+			/** The mbuf holding this segment */
+			struct rte_mbuf* mbuf;
+			/** A pointer to the data of this segment */
+			uint8_t* data;
+			/** The length in bytes of the data of this segment */
+			uint16_t dataLen;
+		};
+
 		/**
 		 * A default c'tor for this class. Constructs an instance of this class without an mbuf attached to it. In order
 		 * to allocate an mbuf the user should call the init() method. Without calling init() the instance of this class
@@ -120,6 +154,7 @@ namespace pcpp
 		 * Calling it more than once will result with an error
 		 * @param[in] rawPacket A pointer to a RawPacket object from which data will be copied
 		 * @param[in] device The DpdkDevice which has the pool to allocate the mbuf from
+		 * If the data doesn't fit in a single mbuf, more mbufs are allocated and chained to it
 		 * @return True if initialization succeeded and false if this method was already called for this instance (and
 		 * an mbuf is already attached) or if allocating an mbuf from the pool failed for some reason
 		 */
@@ -148,6 +183,62 @@ namespace pcpp
 			return m_MBuf;
 		}
 
+		/**
+		 * @return The number of mbufs in the chain stored in this object, or 0 if no mbuf is stored
+		 */
+		uint16_t getNumOfSegments() const;
+
+		/**
+		 * @return True if the packet spans more than one mbuf, false otherwise
+		 */
+		bool isChained() const
+		{
+			return getNumOfSegments() > 1;
+		}
+
+		/**
+		 * Get the first segment of the packet
+		 * @param[out] segment The first segment
+		 * @return False if no mbuf is stored in this object, true otherwise
+		 */
+		bool getFirstSegment(Segment& segment) const;
+
+		/**
+		 * Get the segment following a given segment
+		 * @param[in,out] segment A segment returned by getFirstSegment() or getNextSegment(). Replaced by the next
+		 * segment
+		 * @return False if the given segment is the last one, true otherwise
+		 */
+		bool getNextSegment(Segment& segment) const;
+
+		/**
+		 * Get a contiguous range of the packet data, which may span several segments
+		 * @param[in] offset The offset of the range from the start of the packet
+		 * @param[in] length The length of the range
+		 * @param[in] buffer A buffer of at least length bytes. Used only if the range spans more than one segment
+		 * @return A pointer to the range, either inside the segment holding it or to buffer the range was copied to.
+		 * nullptr if no mbuf is stored in this object or if the range exceeds the packet
+		 */
+		const uint8_t* readData(size_t offset, size_t length, uint8_t* buffer) const;
+
+		/**
+		 * Move data from the following segments to the first segment until it holds at least a given number of bytes.
+		 * The raw data is updated accordingly, so a Packet object already created from this object should be
+		 * re-created
+		 * @param[in] length The number of bytes the first segment should hold. If larger than the packet, the whole
+		 * packet is moved to the first segment
+		 * @return True if the first segment holds length bytes, false if the first mbuf doesn't have enough room or
+		 * if its data is shared with other mbufs (an error is printed to log)
+		 */
+		bool pullUp(size_t length);
+
+		/**
+		 * Move the whole packet to the first segment and free the other segments. See pullUp() for more details
+		 * @return True if the packet is in a single mbuf, false if the first mbuf doesn't have enough room for the
+		 * whole packet. A larger mbuf data size can be set in DpdkDeviceList#initDpdk()
+		 */
+		bool linearize();
+
 		// overridden methods
 
 		/**
@@ -186,13 +277,26 @@ namespace pcpp
 		 * @param[in] frameLength When reading from pcap files, sometimes the captured length is different from the
 		 * actual packet length. This parameter represents the packet length. This parameter is optional, if not set or
 		 * set to -1 it is assumed both lengths are equal
-		 * @return True if raw data was copied to the mbuf successfully, false if rawDataLen is larger than mbuf max
-		 * size, if initialization failed or if copying the data to the mbuf failed. In all of these cases an error will
-		 * be printed to log
+		 * @return True if raw data was copied to the mbuf successfully, false if initialization failed or if copying
+		 * the data to the mbuf failed. In all of these cases an error will be printed to log. If the data doesn't fit
+		 * in a single mbuf more mbufs are allocated from the same pool and chained to it
 		 */
 		bool setRawData(const uint8_t* pRawData, int rawDataLen, timespec timestamp,
 		                LinkLayerType layerType = LINKTYPE_ETHERNET, int frameLength = -1);
 
+		/**
+		 * Same as setRawData(): the data is copied to the mbuf and pRawData is freed right away
+		 * @param[in] pRawData A pointer to the new raw data, allocated with new[]
+		 * @param[in] rawDataLen The new raw data length in bytes
+		 * @param[in] timestamp The timestamp packet was received by the NIC
+		 * @param[in] layerType The link layer type for this raw data. Default is Ethernet
+		 * @param[in] frameLength The packet length if it's different from the captured length, or -1 if both lengths
+		 * are equal
+		 * @return True if raw data was copied to the mbuf successfully, false otherwise
+		 */
+		bool setOwnedRawData(uint8_t* pRawData, int rawDataLen, timespec timestamp,
+		                     LinkLayerType layerType = LINKTYPE_ETHERNET, int frameLength = -1);
+
 		/**
 		 * Clears the object and frees the mbuf
 		 */
@@ -229,10 +333,50 @@ namespace pcpp
 		 */
 		bool removeData(int atIndex, size_t numOfBytesToRemove);
 
+		/**
+		 * @return The headroom of the mbuf, or 0 if MBufRawPacket is not initialized (mbuf is nullptr)
+		 */
+		size_t getHeadroom() const;
+
+		/**
+		 * @return The tailroom of the mbuf (of its first segment if it's chained), or 0 if MBufRawPacket is not
+		 * initialized (mbuf is nullptr)
+		 */
+		size_t getTailroom() const;
+
+		/**
+		 * Add data in front of the current data using the headroom of the mbuf (see rte_pktmbuf_prepend()), without
+		 * moving the current data
+		 * @param[in] dataToPrepend A pointer to the data to prepend, or nullptr to only add the bytes
+		 * @param[in] dataToPrependLen Length in bytes of dataToPrepend
+		 * @return True if the data was prepended, or false if MBufRawPacket is not initialized (mbuf is nullptr) or the
+		 * mbuf headroom is too small. In these cases an error is printed to log
+		 */
+		bool prependData(const uint8_t* dataToPrepend, size_t dataToPrependLen);
+
+		/**
+		 * Remove bytes from the start of the current data (see rte_pktmbuf_adj()), the removed bytes become headroom
+		 * of the mbuf
+		 * @param[in] numOfBytesToRemove Number of bytes to remove
+		 * @return True if the bytes were removed, or false if MBufRawPacket is not initialized (mbuf is nullptr) or the
+		 * first mbuf segment is shorter than numOfBytesToRemove. In these cases an error is printed to log
+		 */
+		bool removeDataFromStart(size_t numOfBytesToRemove);
+
+		/**
+		 * An mbuf can't be reallocated, so this overridden method only checks that the mbuf has the required headroom
+		 * and tailroom
+		 * @param[in] headroom The required headroom in bytes
+		 * @param[in] tailroom The required tailroom in bytes
+		 * @return True if the mbuf has the required headroom and tailroom, false otherwise
+		 */
+		bool reserveRoom(size_t headroom, size_t tailroom);
+
 		/**
 		 * This overridden method,in contrast to its ancestor RawPacket#reallocateData() doesn't need to do anything
 		 * because mbuf is already allocated to its maximum extent. So it only performs a check to verify the size after
-		 * re-allocation doesn't exceed mbuf max size
+		 * re-allocation doesn't exceed mbuf max size. For a chained mbuf the size is checked against the room in the
+		 * first segment
 		 * @param[in] newBufferLength The new buffer length as required by the user
 		 * @return True if new size is larger than current size but smaller than mbuf max size, false otherwise
 		 */
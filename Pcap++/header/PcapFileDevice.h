@@ -16,6 +16,17 @@ typedef struct pcap_dumper pcap_dumper_t;
  */
 namespace pcpp
 {
+	/// @cond PCPP_INTERNAL
+
+	namespace internal
+	{
+		class PcapNgBlockReader;
+		class ZstdFrameReader;
+		class ZstdFrameWriter;
+	}  // namespace internal
+
+	/// @endcond
+
 	/**
 	 * @enum FileTimestampPrecision
 	 * An enumeration representing the precision of timestamps in a pcap file.
@@ -284,13 +295,23 @@ namespace pcpp
 	/**
 	 * @class PcapNgFileReaderDevice
 	 * A class for opening a pcap-ng file in read-only mode. This class enable to open the file and read all packets,
-	 * packet-by-packet
+	 * packet-by-packet.<BR>
+	 * Uncompressed files and zstd files read with parallel decompression (see setDecompressionThreads()) are parsed
+	 * by a streaming block parser that reads the file through a memory mapping or a large buffer, which also allows
+	 * reading packets without copying them (see getNextPacketZeroCopy()). Other compressed files are read through
+	 * LightPcapNg
 	 */
 	class PcapNgFileReaderDevice : public IFileReaderDevice
 	{
 	private:
 		void* m_LightPcapNg;
+		internal::PcapNgBlockReader* m_BlockReader;
 		BpfFilterWrapper m_BpfWrapper;
+		int m_DecompressionThreads;
+		internal::ZstdFrameReader* m_FrameReader;
+
+		bool readNextPacket(const uint8_t*& data, uint32_t& capturedLength, uint32_t& originalLength,
+		                    timespec& timestamp, LinkLayerType& linkType, std::string* packetComment);
 
 		// private copy c'tor
 		PcapNgFileReaderDevice(const PcapNgFileReaderDevice& other);
@@ -344,6 +365,35 @@ namespace pcpp
 		 */
 		std::string getCaptureFileComment() const;
 
+		/**
+		 * Decompress the file with multiple threads. The compressed frames are decompressed ahead of the reading thread
+		 * by a pool of worker threads and returned in order. Parallel decompression requires a zstd compressed file
+		 * that ends with a seek table, as written by PcapNgFileWriterDevice when compression threads are set. Other
+		 * files are read sequentially. This method should be called before open(), and is relevant only if
+		 * PcapPlusPlus was built with zstd support
+		 * @param[in] numOfThreads The number of decompression threads, 0 disables parallel decompression. Default is 0
+		 */
+		void setDecompressionThreads(int numOfThreads)
+		{
+			m_DecompressionThreads = numOfThreads;
+		}
+
+		/**
+		 * @return The number of independently compressed frames in the file, or 0 if the file isn't opened with
+		 * parallel decompression (see setDecompressionThreads())
+		 */
+		uint32_t getNumOfCompressedFrames() const;
+
+		/**
+		 * Continue reading from the first packet stored in a compressed frame. The interfaces of the packets are known
+		 * after the seek even if their description appears in frames that weren't read. This method is available only
+		 * when the file is opened with parallel decompression (see setDecompressionThreads())
+		 * @param[in] frameIndex The index of the frame, between 0 and getNumOfCompressedFrames() - 1
+		 * @return True if the seek succeeded, false if the device isn't opened with parallel decompression or the frame
+		 * index is out of range (an error will be printed to log)
+		 */
+		bool seekToCompressedFrame(uint32_t frameIndex);
+
 		/**
 		 * The pcap-ng format allows storing a user-defined comment for every packet (besides the comment per-file).
 		 * This method reads the next packet and the comment attached to it (if such comment exists), and returns them
@@ -355,6 +405,17 @@ namespace pcpp
 		 */
 		bool getNextPacket(RawPacket& rawPacket, std::string& packetComment);
 
+		/**
+		 * Read the next packet without copying its data. The raw packet points directly into the memory-mapped file
+		 * or into the internal read buffer of the device, so its data is valid only until the next packet is read or
+		 * the device is closed. Copy the raw packet (or its data) to keep it for longer. The raw packet doesn't own
+		 * its data after this call. If it's passed to getNextPacket() afterwards it owns its data again
+		 * @param[out] rawPacket A reference for a RawPacket where the packet will be set
+		 * @return True if a packet was read successfully. False will be returned if the file isn't opened (also, an
+		 * error log will be printed) or if reached end-of-file
+		 */
+		bool getNextPacketZeroCopy(RawPacket& rawPacket);
+
 		// overridden methods
 
 		/**
@@ -548,6 +609,11 @@ namespace pcpp
 		void* m_LightPcapNg;
 		int m_CompressionLevel;
 		BpfFilterWrapper m_BpfWrapper;
+		int m_CompressionThreads;
+		uint32_t m_CompressionFrameSize;
+		internal::ZstdFrameWriter* m_FrameWriter;
+
+		bool openWrite(void* fileInfo);
 
 		// private copy c'tor
 		PcapNgFileWriterDevice(const PcapFileWriterDevice& other);
@@ -572,6 +638,25 @@ namespace pcpp
 			close();
 		}
 
+		/**
+		 * The default amount of uncompressed data in each compressed frame when compressing with multiple threads
+		 */
+		static constexpr uint32_t DefaultCompressionFrameSize = 1024 * 1024;
+
+		/**
+		 * Compress the file with multiple threads. The written blocks are grouped into frames which are compressed
+		 * independently by a pool of worker threads and written to the file in order, followed by a seek table in the
+		 * zstd seekable format. Such files can be read by any zstd decompressor, and PcapNgFileReaderDevice can
+		 * decompress them in parallel and seek to any frame. Frames are always cut at block boundaries, and flush()
+		 * ends the current frame. This method should be called before open(), and is relevant only if the compression
+		 * level is greater than 0 and PcapPlusPlus was built with zstd support. It doesn't apply to append mode
+		 * @param[in] numOfThreads The number of compression threads, 0 compresses on the writing thread as a single
+		 * frame. Default is 0
+		 * @param[in] frameSize The amount of uncompressed data in each frame. Larger frames compress better, smaller
+		 * frames allow more fine-grained seeking. Default is DefaultCompressionFrameSize
+		 */
+		void setCompressionThreads(int numOfThreads, uint32_t frameSize = DefaultCompressionFrameSize);
+
 		/**
 		 * Open the file in a write mode. If file doesn't exist, it will be created. If it does exist it will be
 		 * overwritten, meaning all its current content will be deleted. As opposed to open(), this method also allows
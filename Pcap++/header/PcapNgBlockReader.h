@@ -0,0 +1,150 @@
+#pragma once
+
+#include "RawPacket.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/// @file
+
+namespace pcpp
+{
+	/// @cond PCPP_INTERNAL
+
+	namespace internal
+	{
+		/**
+		 * @class PcapNgBlockReader
+		 * A streaming pcap-ng block parser. Regular files are memory-mapped where supported, other sources are read
+		 * into a large buffer that grows to fit the largest block. Packets from enhanced and simple packet blocks are
+		 * returned as pointers into the mapped file or the buffer, with the timestamp resolution and offset of their
+		 * interface applied. Options of packet blocks are parsed only when the caller asks for the packet comment
+		 */
+		class PcapNgBlockReader
+		{
+		public:
+			/**
+			 * A function that reads up to count bytes from a stream
+			 * @return The number of bytes read, less than count only at the end of the stream
+			 */
+			typedef size_t (*ReadFunc)(void* cookie, void* buf, size_t count);
+
+			/**
+			 * A packet returned by getNextPacket(). The data and comment pointers are valid until the next call to
+			 * getNextPacket(), restart() or close()
+			 */
+			struct PacketInfo
+			{
+				const uint8_t* data;
+				uint32_t capturedLength;
+				uint32_t originalLength;
+				timespec timestamp;
+				LinkLayerType linkType;
+				const char* comment;
+				size_t commentLength;
+			};
+
+			/**
+			 * The metadata of the first section header block in the stream
+			 */
+			struct SectionInfo
+			{
+				std::string os;
+				std::string hardware;
+				std::string application;
+				std::string comment;
+			};
+
+			/** Interfaces described after this many interface blocks in a section are ignored */
+			static constexpr size_t MaxSupportedInterfaces = 32;
+
+			PcapNgBlockReader();
+			~PcapNgBlockReader();
+
+			PcapNgBlockReader(const PcapNgBlockReader&) = delete;
+			PcapNgBlockReader& operator=(const PcapNgBlockReader&) = delete;
+
+			/**
+			 * Open a file and read its first section header block
+			 * @return False if the file can't be opened or doesn't start with a pcap-ng section header block
+			 */
+			bool openFile(const std::string& fileName);
+
+			/**
+			 * Read a stream through a user supplied function and read its first section header block. The stream is
+			 * owned by the caller
+			 * @return False if the stream doesn't start with a pcap-ng section header block
+			 */
+			bool openStream(ReadFunc readFunc, void* cookie);
+
+			void close();
+
+			bool isOpened() const
+			{
+				return m_Opened;
+			}
+
+			/**
+			 * Drop the buffered data and the known interfaces and read a section header block from the current
+			 * position of the stream. Should be called after the stream was repositioned, relevant only for streams
+			 * @return False if the stream doesn't continue with a section header block
+			 */
+			bool restart();
+
+			/**
+			 * Read blocks until the next enhanced or simple packet block
+			 * @param[out] packet The packet that was read
+			 * @param[in] readComment Whether to look for a comment in the block options
+			 * @return False at the end of the stream or if a corrupted block was encountered (an error is printed to
+			 * log in the latter case)
+			 */
+			bool getNextPacket(PacketInfo& packet, bool readComment);
+
+			const SectionInfo& getSectionInfo() const
+			{
+				return m_SectionInfo;
+			}
+
+		private:
+			struct InterfaceInfo
+			{
+				LinkLayerType linkType;
+				uint32_t snapLen;
+				uint64_t ticksPerSecond;
+				int64_t offsetSeconds;
+			};
+
+			bool m_Opened;
+			bool m_BigEndian;
+			// either the mapped file or m_Buffer
+			const uint8_t* m_Data;
+			size_t m_DataLen;
+			size_t m_Pos;
+			void* m_MappedData;
+			size_t m_MappedLen;
+			FILE* m_File;
+			ReadFunc m_ReadFunc;
+			void* m_ReadCookie;
+			bool m_EndOfStream;
+			std::vector<uint8_t> m_Buffer;
+			std::vector<InterfaceInfo> m_Interfaces;
+			SectionInfo m_SectionInfo;
+			bool m_SectionInfoSet;
+
+			bool mapFile(const std::string& fileName);
+			bool ensureAvailable(size_t len);
+			uint16_t read16(const uint8_t* ptr) const;
+			uint32_t read32(const uint8_t* ptr) const;
+			uint64_t read64(const uint8_t* ptr) const;
+			bool readSectionHeader();
+			void parseSectionHeader(const uint8_t* block, uint32_t blockLen);
+			void parseInterfaceDescription(const uint8_t* block, uint32_t blockLen);
+			bool findOption(const uint8_t* options, const uint8_t* optionsEnd, uint16_t code, const uint8_t*& value,
+			                uint16_t& valueLen) const;
+			void setTimestamp(PacketInfo& packet, uint64_t ticks, const InterfaceInfo& iface) const;
+		};
+	}  // namespace internal
+
+	/// @endcond
+}  // namespace pcpp
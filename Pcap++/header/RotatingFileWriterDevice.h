@@ -0,0 +1,247 @@
+#pragma once
+
+#include "PcapFileDevice.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+/// @file
+
+/**
+ * \namespace pcpp
+ * \brief The main namespace for the PcapPlusPlus lib
+ */
+namespace pcpp
+{
+	/**
+	 * @class RotatingFileWriterDevice
+	 * A file writer device that splits the written packets into a series of pcap or pcap-ng files. A new file is
+	 * started ("rolled over") when the current file reaches a configured size, a configured number of packets or a
+	 * configured duration (measured by packet timestamps). File names are generated from a strftime() pattern applied
+	 * to the timestamp of the first packet in each file.<BR>
+	 * Writing is always done on the caller thread. Flushing and closing of completed files, pre-allocation of disk
+	 * space for new files and deletion of files that exceed the retention limit are done on a background thread, so
+	 * a rollover never blocks the writing thread on disk I/O of the previous file.<BR>
+	 * This class is not thread-safe: all write methods should be called from a single thread
+	 */
+	class RotatingFileWriterDevice : public IFileWriterDevice
+	{
+	public:
+		/**
+		 * The file format of the files written by the device
+		 */
+		enum FileFormat
+		{
+			/** pcap file format, written by PcapFileWriterDevice */
+			Pcap,
+			/** pcap-ng file format, written by PcapNgFileWriterDevice */
+			PcapNg
+		};
+
+		/**
+		 * @struct RotationConfig
+		 * A struct that contains the rollover and retention parameters of the device. A limit set to 0 is disabled.
+		 * If all limits are disabled all packets are written to a single file
+		 */
+		struct RotationConfig
+		{
+			/** The format of the written files */
+			FileFormat format;
+
+			/** The link layer type of the written packets */
+			LinkLayerType linkLayerType;
+
+			/** Write timestamps in nanosecond precision. Relevant only for pcap files */
+			bool nanosecondsPrecision;
+
+			/** Compression level for pcap-ng files, 0 disables compression. Relevant only for pcap-ng files */
+			int compressionLevel;
+
+			/**
+			 * Start a new file once the current file reaches this size in bytes. The size is calculated from the
+			 * uncompressed record sizes, so for compressed pcap-ng files the actual file size will be smaller
+			 */
+			uint64_t maxFileSize;
+
+			/** Start a new file once the current file contains this number of packets */
+			uint64_t maxPacketsPerFile;
+
+			/** Start a new file once a packet's timestamp is this number of seconds after the file's first packet */
+			uint32_t maxFileDurationSec;
+
+			/**
+			 * The maximum number of files kept on disk, including the file currently written. When a new file is
+			 * started and this limit is exceeded, the oldest file written by this device is deleted, so the files
+			 * form a ring buffer
+			 */
+			uint32_t maxFilesToKeep;
+
+			/**
+			 * Number of bytes to pre-allocate on disk for every new file to reduce fragmentation. Pre-allocated space
+			 * which isn't used is released when the file is closed. Currently supported on Linux only
+			 */
+			uint64_t preallocateSize;
+
+			/**
+			 * A c'tor for this struct
+			 * @param[in] format The format of the written files. Default is pcap
+			 * @param[in] maxFileSize Maximum file size in bytes. Default is 0 (no limit)
+			 * @param[in] maxPacketsPerFile Maximum number of packets per file. Default is 0 (no limit)
+			 * @param[in] maxFileDurationSec Maximum file duration in seconds. Default is 0 (no limit)
+			 * @param[in] maxFilesToKeep Maximum number of files to keep on disk. Default is 0 (keep all files)
+			 */
+			explicit RotationConfig(FileFormat format = Pcap, uint64_t maxFileSize = 0, uint64_t maxPacketsPerFile = 0,
+			                        uint32_t maxFileDurationSec = 0, uint32_t maxFilesToKeep = 0)
+			    : format(format), linkLayerType(LINKTYPE_ETHERNET), nanosecondsPrecision(false), compressionLevel(0),
+			      maxFileSize(maxFileSize), maxPacketsPerFile(maxPacketsPerFile),
+			      maxFileDurationSec(maxFileDurationSec), maxFilesToKeep(maxFilesToKeep), preallocateSize(0)
+			{}
+		};
+
+		/**
+		 * A constructor for this class. Notice that after calling this constructor no file is opened yet. For opening
+		 * the device call open()
+		 * @param[in] fileNamePattern The pattern used to generate the file names. The pattern is passed to strftime()
+		 * with the local time of the first packet in the file, after every occurrence of "{index}" is replaced by
+		 * the running number of the file (starting at 0). For example: "capture_%Y%m%d_%H%M%S_{index}.pcap". If a file
+		 * resolves to the name of an earlier file since the device was opened, for example when the pattern has no
+		 * "{index}" or a low time resolution, "_<index>" is added before the file extension so no file is overwritten
+		 * @param[in] config The rollover and retention parameters
+		 */
+		RotatingFileWriterDevice(const std::string& fileNamePattern, const RotationConfig& config = RotationConfig());
+
+		/**
+		 * A destructor for this class. Closes the device and waits for all pending background work to complete
+		 */
+		~RotatingFileWriterDevice();
+
+		RotatingFileWriterDevice(const RotatingFileWriterDevice& other) = delete;
+		RotatingFileWriterDevice& operator=(const RotatingFileWriterDevice& other) = delete;
+
+		/**
+		 * @return The rollover and retention parameters of the device
+		 */
+		const RotationConfig& getConfig() const
+		{
+			return m_Config;
+		}
+
+		/**
+		 * @return The name of the file currently written, or an empty string if no file is open
+		 */
+		std::string getCurrentFileName() const
+		{
+			return m_CurrentFileName;
+		}
+
+		/**
+		 * @return The number of files created since the device was opened
+		 */
+		uint32_t getNumOfFilesCreated() const
+		{
+			return m_FileIndex;
+		}
+
+		/**
+		 * Close the current file and start a new one with the next packet, regardless of the rollover limits
+		 */
+		void rotate();
+
+		// override methods
+
+		/**
+		 * Write a RawPacket to the current file, starting a new file first if one of the rollover limits is reached
+		 * @param[in] packet A reference for an existing RawPacket to write
+		 * @return True if the packet was written successfully. False will be returned if the device isn't opened,
+		 * if a new file couldn't be created or if the underlying writer failed to write the packet (in all cases an
+		 * error will be printed to log)
+		 */
+		bool writePacket(RawPacket const& packet) override;
+
+		/**
+		 * Write multiple RawPacket, rolling over to new files as needed
+		 * @param[in] packets A reference for an existing RawPacketVector, all of its packets will be written
+		 * @return True if all packets were written successfully. False will be returned if at least one of the packets
+		 * wasn't written successfully
+		 */
+		bool writePackets(const RawPacketVector& packets) override;
+
+		/**
+		 * Open the device and start the background thread. The first file is created only when the first packet is
+		 * written, since its name depends on the packet timestamp
+		 * @return True if the device was opened successfully or if it's already opened
+		 */
+		bool open() override;
+
+		/**
+		 * Appending is not supported by this device, every file is created from scratch
+		 * @param[in] appendMode If set to false this method acts like open(). If set to true it fails
+		 * @return Same as open() if appendMode is false, otherwise false
+		 */
+		bool open(bool appendMode) override;
+
+		/**
+		 * Close the current file and wait until the background thread finished closing all files and applying the
+		 * retention limit
+		 */
+		void close() override;
+
+		/**
+		 * Get statistics of packets written so far across all files
+		 * @param[out] stats The stats struct where stats are returned
+		 */
+		void getStatistics(PcapStats& stats) const override;
+
+		/**
+		 * Filtering isn't supported by this device, filter the packets before writing them
+		 * @return Always false
+		 */
+		bool setFilter(std::string filterAsString) override;
+
+		/**
+		 * Filtering isn't supported by this device
+		 * @return Always true
+		 */
+		bool clearFilter() override;
+
+	private:
+		struct BackgroundJob
+		{
+			std::unique_ptr<IFileWriterDevice> writer;
+			std::string fileName;
+			bool preallocate;
+		};
+
+		RotationConfig m_Config;
+		std::unique_ptr<IFileWriterDevice> m_CurrentWriter;
+		std::string m_CurrentFileName;
+		// all the names generated since the device was opened, a name is never reused since an older file of the
+		// same name may still be on disk or waiting to be deleted by the retention policy
+		std::unordered_set<std::string> m_UsedFileNames;
+		uint32_t m_FileIndex;
+		uint64_t m_CurrentFileSize;
+		uint64_t m_CurrentFilePackets;
+		time_t m_CurrentFileStartTime;
+
+		std::thread m_BackgroundThread;
+		std::mutex m_JobsMutex;
+		std::condition_variable m_JobsCond;
+		std::deque<BackgroundJob> m_Jobs;
+		bool m_StopBackgroundThread;
+		// files written by this device which weren't deleted yet, oldest first. Accessed only by the background thread
+		std::deque<std::string> m_FilesOnDisk;
+
+		std::string generateFileName(time_t firstPacketTime);
+		bool openNewFile(time_t firstPacketTime);
+		void closeCurrentFile();
+		bool shouldRotate(const RawPacket& packet, uint64_t recordSize) const;
+		uint64_t getRecordSize(const RawPacket& packet) const;
+		void pushJob(BackgroundJob&& job);
+		void backgroundThreadMain();
+		void handleJob(BackgroundJob& job);
+	};
+
+}  // namespace pcpp
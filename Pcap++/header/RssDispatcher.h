@@ -0,0 +1,271 @@
+#pragma once
+
+#include "PcapFileDevice.h"
+#include "PcapLiveDevice.h"
+#include "PacketUtils.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/// @file
+
+/**
+ * \namespace pcpp
+ * \brief The main namespace for the PcapPlusPlus lib
+ */
+namespace pcpp
+{
+	/**
+	 * @class RssDispatcher
+	 * A software Receive Side Scaling (RSS) stage for devices that deliver all packets on a single thread, such as
+	 * PcapLiveDevice and the file reader devices. Each packet is hashed by its IP addresses and ports and copied to
+	 * the ring of one of N worker threads, which call a user callback for it. The hash is symmetric, so both
+	 * directions of a flow go to the same worker, and a flow always goes to the same worker in the order its packets
+	 * were dispatched. This lets analysis applications that keep per-flow state, for example TCP reassembly, run on
+	 * several cores without locks.<BR>
+	 * The hash is computed on the raw packet bytes without parsing a Packet. Ethernet (with VLAN tags), Linux cooked
+	 * capture (SLL and SLL2) and raw IP link types are supported. Packets that aren't IPv4 or IPv6 always go to worker
+	 * 0. The worker is chosen the way NICs do it, through an indirection table of 128 entries filled with the workers
+	 * in turn, so with the Toeplitz hash and the default key a packet goes to the worker whose number is the RX queue
+	 * a DpdkDevice with the same number of RSS queues would receive it on.<BR>
+	 * Each worker has a single-producer single-consumer ring, so dispatching takes no lock. The dispatch methods must
+	 * be called from a single thread, for example the capture thread of a PcapLiveDevice
+	 */
+	class RssDispatcher
+	{
+	public:
+		/**
+		 * The hash functions that can choose the worker of a packet
+		 */
+		enum class HashFunction
+		{
+			/** The Toeplitz hash of NIC RSS (see ToeplitzHash). It's symmetric only with a symmetric key, such as
+			 * the default one. Notice that with the default key the hash depends only on the XOR of the 16-bit words
+			 * of the addresses and ports, so flows that differ in the same bits of an address and a port, for example
+			 * sequential addresses and ports, may all go to the same worker */
+			Toeplitz,
+			/** The 64bit hash of hash5Tuple64(), which is always symmetric and faster than Toeplitz */
+			Hash64
+		};
+
+		/**
+		 * What to do with a packet when the ring of its worker is full
+		 */
+		enum class BackpressurePolicy
+		{
+			/** Drop the packet and count it in DispatcherStats#ringDrops. The dispatching thread never waits */
+			Drop,
+			/** Wait until the worker makes room. No packet is lost, but a slow worker slows down the capture */
+			Block
+		};
+
+		/**
+		 * The number of entries of the indirection table that maps hash values to workers
+		 */
+		static constexpr size_t IndirectionTableSize = 128;
+
+		/**
+		 * The maximum number of workers
+		 */
+		static constexpr size_t MaxNumOfWorkers = 64;
+
+		/**
+		 * @typedef OnPacketCallback
+		 * A callback that is called by a worker thread for every packet dispatched to it
+		 * @param[in] packet The packet. Its data is valid only until the callback returns, and it may be modified
+		 * @param[in] workerId The index of the worker, between 0 and the number of workers - 1
+		 * @param[in] userCookie The user cookie given in the constructor
+		 */
+		using OnPacketCallback = std::function<void(RawPacket& packet, uint8_t workerId, void* userCookie)>;
+
+		/**
+		 * @struct DispatcherConfig
+		 * The dispatcher configuration
+		 */
+		struct DispatcherConfig
+		{
+			/** The number of packets each worker ring can hold, must be a power of 2. The default is 4096 */
+			uint32_t ringSize;
+			/** The maximum number of packets a worker takes from its ring at once. The default is 32 */
+			uint16_t burstSize;
+			/** The hash function. The default is HashFunction#Toeplitz */
+			HashFunction hashFunction;
+			/** What to do when a ring is full. The default is BackpressurePolicy#Drop */
+			BackpressurePolicy backpressure;
+			/** Hash the TCP, UDP and SCTP ports as well as the IP addresses. IP fragments are always hashed by their
+			 * addresses only, so when a flow may be fragmented set it to false to keep all its packets on one worker.
+			 * The default is true */
+			bool hashPorts;
+			/** The key of the Toeplitz hash, or nullptr for the default key of ToeplitzHash. The key is copied by
+			 * the constructor */
+			const uint8_t* rssKey;
+			/** The length of rssKey in bytes, at least 40 */
+			size_t rssKeyLength;
+
+			/**
+			 * A c'tor for this struct
+			 * @param[in] ringSize The ring size, default is 4096
+			 * @param[in] hashFunction The hash function, default is Toeplitz
+			 * @param[in] backpressure The backpressure policy, default is Drop
+			 */
+			explicit DispatcherConfig(uint32_t ringSize = 4096, HashFunction hashFunction = HashFunction::Toeplitz,
+			                          BackpressurePolicy backpressure = BackpressurePolicy::Drop)
+			    : ringSize(ringSize), burstSize(32), hashFunction(hashFunction), backpressure(backpressure),
+			      hashPorts(true), rssKey(nullptr), rssKeyLength(ToeplitzHash::DefaultKeyLength)
+			{}
+		};
+
+		/**
+		 * @struct DispatcherStats
+		 * Packet counters of one worker or of all of them
+		 */
+		struct DispatcherStats
+		{
+			/** Packets queued to the worker rings */
+			uint64_t dispatchedPackets;
+			/** Packets dropped because a worker ring was full */
+			uint64_t ringDrops;
+			/** Packets the workers called the callback for */
+			uint64_t processedPackets;
+		};
+
+		/**
+		 * A c'tor for this class. The workers aren't started until start() is called
+		 * @param[in] numOfWorkers The number of worker threads, between 1 and MaxNumOfWorkers
+		 * @param[in] onPacket The callback the workers call for each packet
+		 * @param[in] userCookie A pointer passed to the callback
+		 * @param[in] config The dispatcher configuration
+		 */
+		RssDispatcher(size_t numOfWorkers, OnPacketCallback onPacket, void* userCookie,
+		              const DispatcherConfig& config = DispatcherConfig());
+
+		/**
+		 * A d'tor for this class. Stops the workers if they're running
+		 */
+		~RssDispatcher();
+
+		RssDispatcher(const RssDispatcher&) = delete;
+		RssDispatcher& operator=(const RssDispatcher&) = delete;
+
+		/**
+		 * Allocate the rings and start the worker threads
+		 * @return True if the workers were started, false if they're already running or the configuration is
+		 * invalid (an error is printed to log)
+		 */
+		bool start();
+
+		/**
+		 * Stop the workers. The packets already in the rings are processed before the workers exit, so when this
+		 * method returns the callback was called for every dispatched packet. Must be called from the dispatching
+		 * thread, or after it stopped dispatching. Does nothing if the workers aren't running
+		 */
+		void stop();
+
+		/**
+		 * @return True if the workers are running, false otherwise
+		 */
+		bool isRunning() const
+		{
+			return m_Running;
+		}
+
+		/**
+		 * @return The number of workers
+		 */
+		size_t getNumOfWorkers() const
+		{
+			return m_NumOfWorkers;
+		}
+
+		/**
+		 * Copy a packet to the ring of its worker
+		 * @param[in] rawPacket The packet to dispatch
+		 * @return True if the packet was queued, false if it was dropped because the ring was full or the workers
+		 * aren't running
+		 */
+		bool dispatch(const RawPacket& rawPacket);
+
+		/**
+		 * Copy a batch of packets to the rings of their workers. The rings are published once per batch, so the
+		 * workers are woken up less often than when the packets are dispatched one by one
+		 * @param[in] rawPackets An array of pointers to packets
+		 * @param[in] count The number of packets in the array
+		 * @return The number of packets that were queued
+		 */
+		size_t dispatch(const RawPacket* const* rawPackets, size_t count);
+
+		/**
+		 * Copy a batch of packets to the rings of their workers, see dispatch(const RawPacket* const*, size_t)
+		 * @param[in] rawPackets The packets to dispatch
+		 * @return The number of packets that were queued
+		 */
+		size_t dispatch(const RawPacketVector& rawPackets);
+
+		/**
+		 * Read all the remaining packets of a file and dispatch them in batches
+		 * @param[in] reader An opened file reader device
+		 * @param[in] batchSize The number of packets read before they are dispatched. The default is 64
+		 * @return The number of packets that were queued
+		 */
+		size_t dispatchFromReader(IFileReaderDevice& reader, size_t batchSize = 64);
+
+		/**
+		 * A callback that can be passed to PcapLiveDevice#startCapture() together with a pointer to the dispatcher
+		 * as the user cookie, to dispatch the captured packets
+		 * @param[in] rawPacket The captured packet
+		 * @param[in] device The capturing device
+		 * @param[in] userCookie A pointer to an RssDispatcher
+		 */
+		static void onPacketArrives(RawPacket* rawPacket, PcapLiveDevice* device, void* userCookie);
+
+		/**
+		 * Compute the hash that chooses the worker of a packet. Can be called from any thread
+		 * @param[in] rawPacket The packet
+		 * @return The hash value, or 0 if the packet isn't IPv4 or IPv6
+		 */
+		uint64_t computeHash(const RawPacket& rawPacket) const;
+
+		/**
+		 * Get the worker a packet is dispatched to. Can be called from any thread
+		 * @param[in] rawPacket The packet
+		 * @return The index of the worker
+		 */
+		uint8_t getWorkerId(const RawPacket& rawPacket) const
+		{
+			return m_IndirectionTable[computeHash(rawPacket) & (IndirectionTableSize - 1)];
+		}
+
+		/**
+		 * Get the counters of all workers. Can be called while the workers are running
+		 * @param[out] stats The sums of the counters of all workers
+		 */
+		void getStatistics(DispatcherStats& stats) const;
+
+		/**
+		 * Get the counters of one worker. Can be called while the workers are running
+		 * @param[in] workerId The index of the worker
+		 * @param[out] stats The counters of the worker. If the index is out of range they are all set to 0
+		 */
+		void getWorkerStatistics(size_t workerId, DispatcherStats& stats) const;
+
+	private:
+		// a worker thread and its ring, defined in RssDispatcher.cpp
+		struct Worker;
+
+		size_t m_NumOfWorkers;
+		OnPacketCallback m_OnPacket;
+		void* m_UserCookie;
+		DispatcherConfig m_Config;
+		ToeplitzHash m_ToeplitzHash;
+		uint8_t m_IndirectionTable[IndirectionTableSize];
+		std::vector<std::unique_ptr<Worker>> m_Workers;
+		bool m_Running;
+		std::atomic<bool> m_Stop;
+
+		bool push(Worker& worker, const RawPacket& rawPacket);
+		void publish(Worker& worker);
+		void runWorker(Worker& worker);
+	};
+
+}  // namespace pcpp
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @file
+
+namespace pcpp
+{
+	/// @cond PCPP_INTERNAL
+
+	namespace internal
+	{
+		/**
+		 * @class ZstdFramePool
+		 * A pool of worker threads that compress or decompress independent zstd frames. Frames are returned in the
+		 * order they were submitted, regardless of the order in which the workers completed them
+		 */
+		class ZstdFramePool
+		{
+		public:
+			enum Mode
+			{
+				Compress,
+				Decompress
+			};
+
+			struct Frame
+			{
+				std::vector<uint8_t> data;
+				size_t inputSize;
+				bool success;
+			};
+
+			ZstdFramePool(Mode mode, int compressionLevel, int numOfThreads);
+			~ZstdFramePool();
+
+			ZstdFramePool(const ZstdFramePool&) = delete;
+			ZstdFramePool& operator=(const ZstdFramePool&) = delete;
+
+			/**
+			 * Queue a frame for processing
+			 * @param[in] input The uncompressed data (compress mode) or a complete zstd frame (decompress mode)
+			 * @param[in] decompressedSize The size of the decompressed frame. Relevant only in decompress mode
+			 */
+			void submit(std::vector<uint8_t>&& input, size_t decompressedSize = 0);
+
+			/**
+			 * Get the oldest submitted frame which wasn't returned yet
+			 * @param[out] frame The processed frame
+			 * @param[in] wait If true wait until the frame is processed, otherwise return immediately if it isn't
+			 * @return True if a frame was returned. False if no frame is in flight or if wait is false and the next
+			 * frame isn't ready yet
+			 */
+			bool getNext(Frame& frame, bool wait);
+
+			/**
+			 * @return The number of frames submitted and not returned yet
+			 */
+			size_t getNumOfFramesInFlight() const;
+
+			/**
+			 * Drop all frames in flight. Frames currently processed by workers are dropped once they complete
+			 */
+			void discardAll();
+
+		private:
+			struct Job
+			{
+				uint64_t seq;
+				std::vector<uint8_t> input;
+				size_t decompressedSize;
+			};
+
+			Mode m_Mode;
+			int m_CompressionLevel;
+			std::vector<std::thread> m_Workers;
+			mutable std::mutex m_Mutex;
+			std::condition_variable m_JobsCond;
+			std::condition_variable m_DoneCond;
+			std::deque<Job> m_Jobs;
+			std::map<uint64_t, Frame> m_Done;
+			uint64_t m_NextSeq;
+			uint64_t m_NextToReturn;
+			bool m_Stop;
+
+			void workerMain();
+		};
+
+		/**
+		 * @class ZstdFrameWriter
+		 * Writes a stream as a series of independent zstd frames compressed in parallel, followed by a seek table in
+		 * the zstd seekable format. Frames are cut only between calls to write(), so when every call writes whole
+		 * pcapng blocks each frame starts at a block boundary
+		 */
+		class ZstdFrameWriter
+		{
+		public:
+			ZstdFrameWriter(int compressionLevel, int numOfThreads, uint32_t frameSize);
+			~ZstdFrameWriter();
+
+			ZstdFrameWriter(const ZstdFrameWriter&) = delete;
+			ZstdFrameWriter& operator=(const ZstdFrameWriter&) = delete;
+
+			bool open(const std::string& fileName);
+			bool write(const void* data, size_t len);
+			/** End the current frame and wait until all frames are written to the file */
+			bool flush();
+			/** Flush, write the seek table and close the file */
+			bool close();
+
+			uint32_t getNumOfFrames() const
+			{
+				return static_cast<uint32_t>(m_SeekTable.size());
+			}
+
+		private:
+			int m_CompressionLevel;
+			int m_NumOfThreads;
+			uint32_t m_FrameSize;
+			FILE* m_File;
+			std::unique_ptr<ZstdFramePool> m_Pool;
+			std::vector<uint8_t> m_PendingFrame;
+			// compressed and decompressed size of every frame written so far
+			std::vector<std::pair<uint32_t, uint32_t>> m_SeekTable;
+			bool m_Error;
+
+			void submitPendingFrame();
+			bool writeCompletedFrames(size_t maxFramesInFlight);
+		};
+
+		/**
+		 * @class ZstdFrameReader
+		 * Reads a file written in the zstd seekable format, decompressing the frames ahead of the reader in parallel.
+		 * The reader can be positioned at the start of any frame. Since pcapng interface description blocks may
+		 * appear in any frame, the reader tracks the section header and interface blocks it encountered and replays
+		 * them before the data of the frame it was positioned at
+		 */
+		class ZstdFrameReader
+		{
+		public:
+			explicit ZstdFrameReader(int numOfThreads);
+			~ZstdFrameReader();
+
+			ZstdFrameReader(const ZstdFrameReader&) = delete;
+			ZstdFrameReader& operator=(const ZstdFrameReader&) = delete;
+
+			/**
+			 * Open a file and load its seek table
+			 * @return False if the file can't be opened or it doesn't end with a valid seek table
+			 */
+			bool open(const std::string& fileName);
+			void close();
+
+			/**
+			 * Read decompressed data
+			 * @return The number of bytes read, less than count only at the end of the file or if a frame is corrupted
+			 */
+			size_t read(void* buf, size_t count);
+
+			uint32_t getNumOfFrames() const
+			{
+				return static_cast<uint32_t>(m_Frames.size());
+			}
+
+			/**
+			 * Position the reader at the start of a frame. The data returned by the next read() starts with the last
+			 * pcapng section header block and the interface description blocks of this section preceding the frame
+			 * @param[in] frameIndex The frame index
+			 * @return False if the frame index is out of range or if one of the frames preceding it is corrupted
+			 */
+			bool seekToFrame(uint32_t frameIndex);
+
+		private:
+			struct FrameInfo
+			{
+				uint64_t offset;
+				uint32_t compressedSize;
+				uint32_t decompressedSize;
+			};
+
+			struct Section
+			{
+				uint32_t firstFrame;
+				std::vector<uint8_t> headerBlock;
+				// interface description blocks of the section with the frame they appeared in
+				std::vector<std::pair<uint32_t, std::vector<uint8_t>>> interfaceBlocks;
+			};
+
+			int m_NumOfThreads;
+			FILE* m_File;
+			std::vector<FrameInfo> m_Frames;
+			std::unique_ptr<ZstdFramePool> m_Pool;
+			uint32_t m_NextFrameToSubmit;
+			uint32_t m_NextFrameToConsume;
+			uint64_t m_FilePos;
+			std::vector<uint8_t> m_Prefix;
+			size_t m_PrefixPos;
+			std::vector<uint8_t> m_Current;
+			size_t m_CurrentPos;
+			uint32_t m_NumOfScannedFrames;
+			std::vector<Section> m_Sections;
+
+			bool submitFrame(uint32_t frameIndex);
+			bool getNextFrame(std::vector<uint8_t>& frameData);
+			void scanFrame(uint32_t frameIndex, const std::vector<uint8_t>& frameData);
+		};
+	}  // namespace internal
+
+	/// @endcond
+}  // namespace pcpp
@@ -8,6 +8,7 @@
 #include "DpdkDevice.h"
 #include "DpdkDeviceList.h"
 #include "Logger.h"
+#include "Instrumentation.h"
 #include "rte_version.h"
 #if (RTE_VER_YEAR > 17) || (RTE_VER_YEAR == 17 && RTE_VER_MONTH >= 11)
 #	include "rte_bus_pci.h"
@@ -50,10 +51,14 @@ namespace pcpp
 #	define DPDK_CONFIG_ETH_LINK_FULL_DUPLEX ETH_LINK_FULL_DUPLEX
 #	define DPDK_CONFIG_MQ_RSS ETH_RSS
 #	define DPDK_CONFIG_MQ_NO_RSS ETH_MQ_RX_NONE
+#	define DPDK_CONFIG_TX_OFFLOAD_MULTI_SEGS DEV_TX_OFFLOAD_MULTI_SEGS
+#	define DPDK_CONFIG_RX_OFFLOAD_SCATTER DEV_RX_OFFLOAD_SCATTER
 #else
 #	define DPDK_CONFIG_ETH_LINK_FULL_DUPLEX RTE_ETH_LINK_FULL_DUPLEX
 #	define DPDK_CONFIG_MQ_RSS RTE_ETH_MQ_RX_RSS
 #	define DPDK_CONFIG_MQ_NO_RSS RTE_ETH_MQ_RX_NONE
+#	define DPDK_CONFIG_TX_OFFLOAD_MULTI_SEGS RTE_ETH_TX_OFFLOAD_MULTI_SEGS
+#	define DPDK_CONFIG_RX_OFFLOAD_SCATTER RTE_ETH_RX_OFFLOAD_SCATTER
 #endif
 
 #if (RTE_VER_YEAR < 22) || (RTE_VER_YEAR == 22 && RTE_VER_MONTH < 11)
@@ -330,6 +335,16 @@ namespace pcpp
 		portConf.rx_adv_conf.rss_conf.rss_key_len = m_Config.rssKeyLength;
 		portConf.rx_adv_conf.rss_conf.rss_hf = convertRssHfToDpdkRssHf(getConfiguredRssHashFunction());
 
+#if (RTE_VER_YEAR > 18) || (RTE_VER_YEAR == 18 && RTE_VER_MONTH >= 5)
+		// send and receive packets spanning a chain of mbufs (such as jumbo frames) if the PMD supports it
+		rte_eth_dev_info devInfo;
+		rte_eth_dev_info_get(m_Id, &devInfo);
+		if (devInfo.tx_offload_capa & DPDK_CONFIG_TX_OFFLOAD_MULTI_SEGS)
+			portConf.txmode.offloads |= DPDK_CONFIG_TX_OFFLOAD_MULTI_SEGS;
+		if (devInfo.rx_offload_capa & DPDK_CONFIG_RX_OFFLOAD_SCATTER)
+			portConf.rxmode.offloads |= DPDK_CONFIG_RX_OFFLOAD_SCATTER;
+#endif
+
 		int res = rte_eth_dev_configure((uint8_t)m_Id, numOfRxQueues, numOfTxQueues, &portConf);
 		if (res < 0)
 		{
@@ -527,11 +542,11 @@ namespace pcpp
 			m_PMDType = PMD_IXGBEVF;
 		else if (m_PMDName == "librte_pmd_mlx4")
 			m_PMDType = PMD_MLX4;
-		else if (m_PMDName == "eth_null")
+		else if (m_PMDName == "eth_null" || m_PMDName == "net_null")
 			m_PMDType = PMD_NULL;
-		else if (m_PMDName == "eth_pcap")
+		else if (m_PMDName == "eth_pcap" || m_PMDName == "net_pcap")
 			m_PMDType = PMD_PCAP;
-		else if (m_PMDName == "eth_ring")
+		else if (m_PMDName == "eth_ring" || m_PMDName == "net_ring")
 			m_PMDType = PMD_RING;
 		else if (m_PMDName == "rte_virtio_pmd")
 			m_PMDType = PMD_VIRTIO;
@@ -764,6 +779,9 @@ namespace pcpp
 			if (unlikely(numOfPktsReceived == 0))
 				continue;
 
+			PCPP_INSTRUMENT_COUNT(DeviceRxBatches, 1);
+			PCPP_INSTRUMENT_COUNT(DeviceRxPackets, numOfPktsReceived);
+
 			timespec time;
 			clock_gettime(CLOCK_REALTIME, &time);
 
@@ -888,6 +906,9 @@ namespace pcpp
 			return 0;
 		}
 
+		PCPP_INSTRUMENT_COUNT(DeviceRxBatches, 1);
+		PCPP_INSTRUMENT_COUNT(DeviceRxPackets, numOfPktsReceived);
+
 		timespec time;
 		clock_gettime(CLOCK_REALTIME, &time);
 
@@ -937,6 +958,9 @@ namespace pcpp
 			return 0;
 		}
 
+		PCPP_INSTRUMENT_COUNT(DeviceRxBatches, 1);
+		PCPP_INSTRUMENT_COUNT(DeviceRxPackets, packetsReceived);
+
 		timespec time;
 		clock_gettime(CLOCK_REALTIME, &time);
 
@@ -980,6 +1004,9 @@ namespace pcpp
 			return 0;
 		}
 
+		PCPP_INSTRUMENT_COUNT(DeviceRxBatches, 1);
+		PCPP_INSTRUMENT_COUNT(DeviceRxPackets, packetsReceived);
+
 		timespec time;
 		clock_gettime(CLOCK_REALTIME, &time);
 
@@ -1105,6 +1132,8 @@ namespace pcpp
 			packetsSent += rte_eth_tx_burst(m_Id, txQueueId, mBufArr, mBufArrIndex);
 		}
 
+		PCPP_INSTRUMENT_COUNT(DeviceTxBatches, 1);
+		PCPP_INSTRUMENT_COUNT(DeviceTxPackets, packetsSent);
 		return packetsSent;
 	}
 
@@ -0,0 +1,488 @@
+// GCOVR_EXCL_START
+
+#define LOG_MODULE PcapLogModuleDpdkDevice
+
+#include "DpdkPipeline.h"
+#include "Logger.h"
+#include "rte_version.h"
+#include "rte_config.h"
+#include "rte_ethdev.h"
+#include "rte_errno.h"
+#include "rte_lcore.h"
+#include "rte_launch.h"
+#include "rte_mbuf.h"
+#include "rte_ring.h"
+#include "rte_prefetch.h"
+#include "rte_branch_prediction.h"
+#include <cstring>
+#include <sstream>
+#include <time.h>
+
+#if (RTE_VER_YEAR < 21) || (RTE_VER_YEAR == 21 && RTE_VER_MONTH < 11)
+#	define GET_MASTER_CORE rte_get_master_lcore
+#else
+#	define GET_MASTER_CORE rte_get_main_lcore
+#endif
+
+// the burst functions of rte_ring got an extra out parameter in 17.05
+#if (RTE_VER_YEAR < 17) || (RTE_VER_YEAR == 17 && RTE_VER_MONTH < 5)
+#	define RING_ENQUEUE_BURST(ring, objs, n) rte_ring_enqueue_burst(ring, objs, n)
+#	define RING_DEQUEUE_BURST(ring, objs, n) rte_ring_dequeue_burst(ring, objs, n)
+#else
+#	define RING_ENQUEUE_BURST(ring, objs, n) rte_ring_enqueue_burst(ring, objs, n, nullptr)
+#	define RING_DEQUEUE_BURST(ring, objs, n) rte_ring_dequeue_burst(ring, objs, n, nullptr)
+#endif
+
+#define MAX_BURST_SIZE 64
+
+namespace pcpp
+{
+
+	static std::atomic<uint32_t> pipelineCounter(0);
+
+	// add to a counter which has a single writer without a locked instruction
+	static inline void addToCounter(std::atomic<uint64_t>& counter, uint64_t value)
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+	}
+
+	static void freeMbufs(struct rte_mbuf** mBufs, uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; i++)
+			rte_pktmbuf_free(mBufs[i]);
+	}
+
+	static void drainRing(struct rte_ring* ring)
+	{
+		struct rte_mbuf* mBufs[MAX_BURST_SIZE];
+		uint32_t count;
+		while ((count = RING_DEQUEUE_BURST(ring, (void**)mBufs, MAX_BURST_SIZE)) > 0)
+			freeMbufs(mBufs, count);
+	}
+
+	DpdkPipeline::Stage::Stage(DpdkPipeline* pipeline, StageType type, uint32_t coreId, uint8_t workerId)
+	    : pipeline(pipeline), type(type), coreId(coreId), workerId(workerId), packets(0), drops(0),
+	      classifierDrops(0), ringDrops(0)
+	{}
+
+	DpdkPipeline::DpdkPipeline(DpdkDevice* rxDevice, uint16_t rxQueueId, OnPacketClassifyCallback onPacketClassify,
+	                           void* userCookie, const PipelineConfig& config)
+	    : m_RxDevice(rxDevice), m_RxQueueId(rxQueueId), m_OnPacketClassify(onPacketClassify),
+	      m_UserCookie(userCookie), m_Config(config), m_ParseRing(nullptr), m_Running(false), m_StopRx(false),
+	      m_StopWorkers(false), m_StopTx(false)
+	{}
+
+	DpdkPipeline::~DpdkPipeline()
+	{
+		stop();
+	}
+
+	int DpdkPipeline::addOutput(DpdkDevice* txDevice, uint16_t txQueueId)
+	{
+		if (m_Running)
+		{
+			PCPP_LOG_ERROR("Cannot add an output while the pipeline is running");
+			return -1;
+		}
+
+		if (txDevice == nullptr)
+		{
+			PCPP_LOG_ERROR("Output device is nullptr");
+			return -1;
+		}
+
+		Output output;
+		output.device = txDevice;
+		output.txQueueId = txQueueId;
+		output.ring = nullptr;
+		m_Outputs.push_back(output);
+		return static_cast<int>(m_Outputs.size() - 1);
+	}
+
+	bool DpdkPipeline::createRings()
+	{
+		uint32_t pipelineId = pipelineCounter++;
+		int socketId = rte_eth_dev_socket_id(m_RxDevice->getDeviceId());
+
+		int numOfWorkers = 0;
+		for (const auto& stage : m_Stages)
+		{
+			if (stage->type == WorkerStage)
+				numOfWorkers++;
+		}
+
+		// the parse ring has a single producer (the RX stage), the output rings have a single consumer (the TX
+		// stage). With a single worker all rings are single producer single consumer
+		unsigned int parseRingFlags = RING_F_SP_ENQ | (numOfWorkers == 1 ? RING_F_SC_DEQ : 0);
+		unsigned int outputRingFlags = RING_F_SC_DEQ | (numOfWorkers == 1 ? RING_F_SP_ENQ : 0);
+
+		std::stringstream parseRingName;
+		parseRingName << "pcpp_pl" << pipelineId << "_rx";
+		m_ParseRing = rte_ring_create(parseRingName.str().c_str(), m_Config.ringSize, socketId, parseRingFlags);
+		if (m_ParseRing == nullptr)
+		{
+			PCPP_LOG_ERROR("Failed to create parse ring: " << rte_strerror(rte_errno));
+			return false;
+		}
+
+		for (size_t i = 0; i < m_Outputs.size(); i++)
+		{
+			std::stringstream outputRingName;
+			outputRingName << "pcpp_pl" << pipelineId << "_tx" << i;
+			m_Outputs[i].ring =
+			    rte_ring_create(outputRingName.str().c_str(), m_Config.ringSize, socketId, outputRingFlags);
+			if (m_Outputs[i].ring == nullptr)
+			{
+				PCPP_LOG_ERROR("Failed to create ring for output #" << i << ": " << rte_strerror(rte_errno));
+				freeRings();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void DpdkPipeline::freeRings()
+	{
+		if (m_ParseRing != nullptr)
+		{
+			drainRing(m_ParseRing);
+			rte_ring_free(m_ParseRing);
+			m_ParseRing = nullptr;
+		}
+
+		for (auto& output : m_Outputs)
+		{
+			if (output.ring == nullptr)
+				continue;
+
+			drainRing(output.ring);
+			rte_ring_free(output.ring);
+			output.ring = nullptr;
+		}
+	}
+
+	bool DpdkPipeline::start(SystemCore rxCore, CoreMask workerCores, SystemCore txCore)
+	{
+		if (m_Running)
+		{
+			PCPP_LOG_ERROR("Pipeline is already running");
+			return false;
+		}
+
+		if (m_RxDevice == nullptr || !m_RxDevice->isOpened())
+		{
+			PCPP_LOG_ERROR("RX device is nullptr or not opened");
+			return false;
+		}
+
+		if (m_OnPacketClassify == nullptr)
+		{
+			PCPP_LOG_ERROR("Classification callback is nullptr");
+			return false;
+		}
+
+		if (m_Config.burstSize == 0 || m_Config.burstSize > MAX_BURST_SIZE)
+		{
+			PCPP_LOG_ERROR("Burst size must be between 1 and " << MAX_BURST_SIZE);
+			return false;
+		}
+
+		if (m_Config.ringSize < m_Config.burstSize || (m_Config.ringSize & (m_Config.ringSize - 1)) != 0)
+		{
+			PCPP_LOG_ERROR("Ring size must be a power of 2 which is not smaller than the burst size");
+			return false;
+		}
+
+		for (const auto& output : m_Outputs)
+		{
+			if (!output.device->isOpened())
+			{
+				PCPP_LOG_ERROR("Output device '" << output.device->getDeviceName() << "' is not opened");
+				return false;
+			}
+		}
+
+		bool useTxCore = !m_Outputs.empty();
+		CoreMask usedCores = 0;
+		std::vector<SystemCore> cores;
+		cores.push_back(rxCore);
+		createCoreVectorFromCoreMask(workerCores, cores);
+		if (useTxCore)
+			cores.push_back(txCore);
+
+		if (cores.size() < (useTxCore ? 3u : 2u))
+		{
+			PCPP_LOG_ERROR("At least one worker core is required");
+			return false;
+		}
+
+		for (const auto& core : cores)
+		{
+			if (core.Id >= MAX_NUM_OF_CORES || core.Id == GET_MASTER_CORE() || !rte_lcore_is_enabled(core.Id))
+			{
+				PCPP_LOG_ERROR("Core " << (int)core.Id << " is not enabled or is the master core");
+				return false;
+			}
+
+			if ((usedCores & core.Mask) != 0)
+			{
+				PCPP_LOG_ERROR("Core " << (int)core.Id << " is assigned to more than one stage");
+				return false;
+			}
+
+			usedCores |= core.Mask;
+		}
+
+		m_Stages.clear();
+		m_Stages.emplace_back(new Stage(this, RxStage, rxCore.Id, 0));
+		uint8_t workerId = 0;
+		for (size_t i = 1; i < cores.size() - (useTxCore ? 1 : 0); i++)
+			m_Stages.emplace_back(new Stage(this, WorkerStage, cores[i].Id, workerId++));
+		if (useTxCore)
+			m_Stages.emplace_back(new Stage(this, TxStage, txCore.Id, 0));
+
+		if (!createRings())
+		{
+			m_Stages.clear();
+			return false;
+		}
+
+		m_StopRx = false;
+		m_StopWorkers = false;
+		m_StopTx = false;
+		m_Running = true;
+
+		// start the stages from the last to the first so every stage has a consumer when it starts producing
+		for (auto iter = m_Stages.rbegin(); iter != m_Stages.rend(); ++iter)
+		{
+			Stage* stage = iter->get();
+			int err = rte_eal_remote_launch(stageMain, stage, stage->coreId);
+			if (err != 0)
+			{
+				PCPP_LOG_ERROR("Cannot start pipeline stage on core " << stage->coreId << ": [" << strerror(-err)
+				                                                      << "]");
+				// the stages after this one are running, stop them
+				m_Stages.erase(m_Stages.begin(), iter.base());
+				stop();
+				return false;
+			}
+		}
+
+		PCPP_LOG_DEBUG("Pipeline started on device [" << m_RxDevice->getDeviceName() << "] with "
+		                                              << (m_Stages.size() - (useTxCore ? 2 : 1)) << " workers");
+		return true;
+	}
+
+	void DpdkPipeline::waitForStages(StageType type)
+	{
+		for (const auto& stage : m_Stages)
+		{
+			if (stage->type == type)
+				rte_eal_wait_lcore(stage->coreId);
+		}
+	}
+
+	void DpdkPipeline::stop()
+	{
+		if (!m_Running)
+			return;
+
+		PCPP_LOG_DEBUG("Stopping pipeline on device [" << m_RxDevice->getDeviceName() << "]");
+
+		// each stage drains its input ring before exiting, so stop them in the order packets flow through them
+		m_StopRx = true;
+		waitForStages(RxStage);
+		m_StopWorkers = true;
+		waitForStages(WorkerStage);
+		m_StopTx = true;
+		waitForStages(TxStage);
+
+		freeRings();
+		m_Running = false;
+
+		PCPP_LOG_DEBUG("Pipeline stopped");
+	}
+
+	void DpdkPipeline::getStatistics(PipelineStats& stats) const
+	{
+		stats = PipelineStats();
+		for (const auto& stage : m_Stages)
+		{
+			uint64_t packets = stage->packets.load(std::memory_order_relaxed);
+			switch (stage->type)
+			{
+			case RxStage:
+				stats.rxPackets += packets;
+				stats.rxRingDrops += stage->ringDrops.load(std::memory_order_relaxed);
+				break;
+			case WorkerStage:
+				stats.parsedPackets += packets;
+				stats.classifierDrops += stage->classifierDrops.load(std::memory_order_relaxed);
+				stats.txRingDrops += stage->ringDrops.load(std::memory_order_relaxed);
+				break;
+			case TxStage:
+				stats.txPackets += packets;
+				stats.txDrops += stage->drops.load(std::memory_order_relaxed);
+				break;
+			}
+		}
+	}
+
+	int DpdkPipeline::stageMain(void* ptr)
+	{
+		Stage* stage = static_cast<Stage*>(ptr);
+		PCPP_LOG_DEBUG("Starting pipeline stage " << stage->type << " on core " << stage->coreId);
+
+		switch (stage->type)
+		{
+		case RxStage:
+			stage->pipeline->runRxStage(*stage);
+			break;
+		case WorkerStage:
+			stage->pipeline->runWorkerStage(*stage);
+			break;
+		case TxStage:
+			stage->pipeline->runTxStage(*stage);
+			break;
+		}
+
+		PCPP_LOG_DEBUG("Exiting pipeline stage " << stage->type << " on core " << stage->coreId);
+		return 0;
+	}
+
+	void DpdkPipeline::runRxStage(Stage& stage)
+	{
+		struct rte_mbuf* mBufs[MAX_BURST_SIZE];
+		uint16_t portId = static_cast<uint16_t>(m_RxDevice->getDeviceId());
+		uint16_t burstSize = m_Config.burstSize;
+
+		while (likely(!m_StopRx.load(std::memory_order_relaxed)))
+		{
+			uint32_t numOfPktsReceived = rte_eth_rx_burst(portId, m_RxQueueId, mBufs, burstSize);
+			if (unlikely(numOfPktsReceived == 0))
+				continue;
+
+			uint32_t numOfPktsEnqueued = RING_ENQUEUE_BURST(m_ParseRing, (void**)mBufs, numOfPktsReceived);
+			if (unlikely(numOfPktsEnqueued < numOfPktsReceived))
+			{
+				freeMbufs(mBufs + numOfPktsEnqueued, numOfPktsReceived - numOfPktsEnqueued);
+				addToCounter(stage.ringDrops, numOfPktsReceived - numOfPktsEnqueued);
+			}
+
+			addToCounter(stage.packets, numOfPktsReceived);
+		}
+	}
+
+	void DpdkPipeline::runWorkerStage(Stage& stage)
+	{
+		struct rte_mbuf* mBufs[MAX_BURST_SIZE];
+		uint16_t burstSize = m_Config.burstSize;
+		uint32_t prefetchOffset = m_Config.prefetchOffset;
+		int numOfOutputs = static_cast<int>(m_Outputs.size());
+
+		// packets classified to each output in the current burst
+		std::vector<struct rte_mbuf*> outputBursts(m_Outputs.size() * burstSize);
+		std::vector<uint32_t> outputBurstSizes(m_Outputs.size(), 0);
+
+		// the mbufs are owned by the pipeline, the raw packet only points to them
+		MBufRawPacket rawPacket;
+		rawPacket.setFreeMbuf(false);
+		Packet packet;
+
+		while (true)
+		{
+			uint32_t numOfPkts = RING_DEQUEUE_BURST(m_ParseRing, (void**)mBufs, burstSize);
+			if (unlikely(numOfPkts == 0))
+			{
+				// the RX stage is stopped before the workers, so an empty ring means no more packets will arrive
+				if (m_StopWorkers.load(std::memory_order_relaxed))
+					break;
+				continue;
+			}
+
+			timespec time;
+			clock_gettime(CLOCK_REALTIME, &time);
+
+			for (uint32_t i = 0; i < prefetchOffset && i < numOfPkts; i++)
+				rte_prefetch0(rte_pktmbuf_mtod(mBufs[i], void*));
+
+			uint32_t numOfDrops = 0;
+			for (uint32_t i = 0; i < numOfPkts; i++)
+			{
+				if (prefetchOffset > 0 && i + prefetchOffset < numOfPkts)
+					rte_prefetch0(rte_pktmbuf_mtod(mBufs[i + prefetchOffset], void*));
+
+				rawPacket.setMBuf(mBufs[i], time);
+				packet.setRawPacket(&rawPacket, false, m_Config.parseUntil, m_Config.parseUntilLayer);
+
+				int outputIndex = m_OnPacketClassify(packet, stage.workerId, m_UserCookie);
+				if (outputIndex < 0 || outputIndex >= numOfOutputs)
+				{
+					rte_pktmbuf_free(mBufs[i]);
+					numOfDrops++;
+					continue;
+				}
+
+				outputBursts[outputIndex * burstSize + outputBurstSizes[outputIndex]++] = mBufs[i];
+			}
+
+			for (int outputIndex = 0; outputIndex < numOfOutputs; outputIndex++)
+			{
+				uint32_t count = outputBurstSizes[outputIndex];
+				if (count == 0)
+					continue;
+
+				struct rte_mbuf** burst = &outputBursts[outputIndex * burstSize];
+				uint32_t numOfPktsEnqueued = RING_ENQUEUE_BURST(m_Outputs[outputIndex].ring, (void**)burst, count);
+				if (unlikely(numOfPktsEnqueued < count))
+				{
+					freeMbufs(burst + numOfPktsEnqueued, count - numOfPktsEnqueued);
+					addToCounter(stage.ringDrops, count - numOfPktsEnqueued);
+				}
+
+				outputBurstSizes[outputIndex] = 0;
+			}
+
+			addToCounter(stage.packets, numOfPkts);
+			if (numOfDrops > 0)
+				addToCounter(stage.classifierDrops, numOfDrops);
+		}
+	}
+
+	void DpdkPipeline::runTxStage(Stage& stage)
+	{
+		struct rte_mbuf* mBufs[MAX_BURST_SIZE];
+		uint16_t burstSize = m_Config.burstSize;
+
+		while (true)
+		{
+			uint32_t totalDequeued = 0;
+			for (auto& output : m_Outputs)
+			{
+				uint32_t numOfPkts = RING_DEQUEUE_BURST(output.ring, (void**)mBufs, burstSize);
+				if (numOfPkts == 0)
+					continue;
+
+				totalDequeued += numOfPkts;
+				uint32_t numOfPktsSent =
+				    rte_eth_tx_burst(static_cast<uint16_t>(output.device->getDeviceId()), output.txQueueId, mBufs,
+				                     static_cast<uint16_t>(numOfPkts));
+				if (unlikely(numOfPktsSent < numOfPkts))
+				{
+					freeMbufs(mBufs + numOfPktsSent, numOfPkts - numOfPktsSent);
+					addToCounter(stage.drops, numOfPkts - numOfPktsSent);
+				}
+
+				addToCounter(stage.packets, numOfPktsSent);
+			}
+
+			// the workers are stopped before the TX stage, so empty rings mean no more packets will arrive
+			if (totalDequeued == 0 && m_StopTx.load(std::memory_order_relaxed))
+				break;
+		}
+	}
+
+}  // namespace pcpp
+
+// GCOVR_EXCL_STOP
@@ -16,6 +16,7 @@
 #	include "KniDevice.h"
 #endif
 
+#include <algorithm>
 #include <string>
 #include <stdint.h>
 #include <unistd.h>
@@ -82,6 +83,16 @@ namespace pcpp
 
 		m_RawPacketSet = false;
 
+		// the data doesn't fit in a single mbuf, spread it over a chain
+		if (rawPacket->getRawDataLen() > rte_pktmbuf_tailroom(m_MBuf))
+		{
+			if (!appendToMBufChain(rawPacket->getRawData(), rawPacket->getRawDataLen()))
+				return false;
+
+			setRawDataFromMBuf(rawPacket->getPacketTimeStamp(), rawPacket->getLinkLayerType());
+			return true;
+		}
+
 		// mbuf is allocated with length of 0, need to adjust it to the size of other
 		if (rte_pktmbuf_append(m_MBuf, rawPacket->getRawDataLen()) == nullptr)
 		{
@@ -118,6 +129,7 @@ namespace pcpp
 		m_RawData = nullptr;
 		m_Mempool = other.m_Mempool;
 		m_MbufDataSize = other.m_MbufDataSize;
+		m_FreeMbuf = true;
 
 		rte_mbuf* newMbuf = rte_pktmbuf_alloc(m_Mempool);
 		if (newMbuf == nullptr)
@@ -126,6 +138,20 @@ namespace pcpp
 			return;
 		}
 
+		if (other.isChained())
+		{
+			m_MBuf = newMbuf;
+			Segment segment;
+			for (bool found = other.getFirstSegment(segment); found; found = other.getNextSegment(segment))
+			{
+				if (!appendToMBufChain(segment.data, segment.dataLen))
+					return;
+			}
+
+			setRawDataFromMBuf(other.m_TimeStamp, other.m_LinkLayerType);
+			return;
+		}
+
 		// mbuf is allocated with length of 0, need to adjust it to the size of other
 		if (rte_pktmbuf_append(newMbuf, other.m_RawDataLen) == nullptr)
 		{
@@ -148,6 +174,23 @@ namespace pcpp
 			return *this;
 		}
 
+		if (this == &other)
+			return *this;
+
+		if (isChained() || other.isChained())
+		{
+			resetMBuf();
+			Segment segment;
+			for (bool found = other.getFirstSegment(segment); found; found = other.getNextSegment(segment))
+			{
+				if (!appendToMBufChain(segment.data, segment.dataLen))
+					return *this;
+			}
+
+			setRawDataFromMBuf(other.m_TimeStamp, other.m_LinkLayerType);
+			return *this;
+		}
+
 		// adjust the size of the mbuf to the new data
 		if (m_RawDataLen < other.m_RawDataLen)
 		{
@@ -181,13 +224,6 @@ namespace pcpp
 	bool MBufRawPacket::setRawData(const uint8_t* pRawData, int rawDataLen, timespec timestamp, LinkLayerType layerType,
 	                               int frameLength)
 	{
-		if (rawDataLen > m_MbufDataSize)
-		{
-			PCPP_LOG_ERROR("Cannot set raw data which length is larger than mBuf max size. mBuf max length: "
-			               << m_MbufDataSize << "; requested length: " << rawDataLen);
-			return false;
-		}
-
 		if (m_MBuf == nullptr)
 		{
 			if (!(init(m_Mempool)))
@@ -197,6 +233,21 @@ namespace pcpp
 			}
 		}
 
+		// the data doesn't fit in the first mbuf, spread it over a chain
+		if (isChained() || rawDataLen > rte_pktmbuf_data_len(m_MBuf) + rte_pktmbuf_tailroom(m_MBuf))
+		{
+			resetMBuf();
+			bool appended = appendToMBufChain(pRawData, rawDataLen);
+			delete[] pRawData;
+			if (!appended)
+				return false;
+
+			setRawDataFromMBuf(timestamp, layerType);
+			if (frameLength > m_FrameLength)
+				m_FrameLength = frameLength;
+			return true;
+		}
+
 		// adjust the size of the mbuf to the new data
 		if (m_RawDataLen < rawDataLen)
 		{
@@ -227,6 +278,12 @@ namespace pcpp
 		return true;
 	}
 
+	bool MBufRawPacket::setOwnedRawData(uint8_t* pRawData, int rawDataLen, timespec timestamp,
+	                                    LinkLayerType layerType, int frameLength)
+	{
+		return setRawData(pRawData, rawDataLen, timestamp, layerType, frameLength);
+	}
+
 	void MBufRawPacket::clear()
 	{
 		if (m_MBuf != nullptr && m_FreeMbuf)
@@ -249,6 +306,14 @@ namespace pcpp
 			return;  // TODO: need to return false here or something
 		}
 
+		// the raw data covers only the first segment, so the data is appended to the last one
+		if (isChained())
+		{
+			if (appendToMBufChain(dataToAppend, dataToAppendLen))
+				m_FrameLength = rte_pktmbuf_pkt_len(m_MBuf);
+			return;
+		}
+
 		char* startOfNewlyAppendedData = rte_pktmbuf_append(m_MBuf, dataToAppendLen);
 		if (startOfNewlyAppendedData == nullptr)
 		{
@@ -269,6 +334,23 @@ namespace pcpp
 			return;  // TODO: need to return false here or something
 		}
 
+		// the raw data covers only the first segment, so the data is inserted into the first segment
+		if (isChained())
+		{
+			if (atIndex > m_RawDataLen || dataToInsertLen > rte_pktmbuf_tailroom(m_MBuf))
+			{
+				PCPP_LOG_ERROR("Couldn't insert " << dataToInsertLen
+				                                  << " bytes to RawPacket - not enough room in first mBuf segment");
+				return;
+			}
+
+			m_MBuf->data_len += dataToInsertLen;
+			m_MBuf->pkt_len += dataToInsertLen;
+			RawPacket::insertData(atIndex, dataToInsert, dataToInsertLen);
+			m_FrameLength = rte_pktmbuf_pkt_len(m_MBuf);
+			return;
+		}
+
 		char* startOfNewlyAppendedData = rte_pktmbuf_append(m_MBuf, dataToInsertLen);
 		if (startOfNewlyAppendedData == nullptr)
 		{
@@ -289,6 +371,18 @@ namespace pcpp
 			return false;
 		}
 
+		// the raw data covers only the first segment, so the data is removed from the first segment
+		if (isChained())
+		{
+			if (!RawPacket::removeData(atIndex, numOfBytesToRemove))
+				return false;
+
+			m_MBuf->data_len -= numOfBytesToRemove;
+			m_MBuf->pkt_len -= numOfBytesToRemove;
+			m_FrameLength = rte_pktmbuf_pkt_len(m_MBuf);
+			return true;
+		}
+
 		if (!RawPacket::removeData(atIndex, numOfBytesToRemove))
 			return false;
 
@@ -303,6 +397,81 @@ namespace pcpp
 		return true;
 	}
 
+	size_t MBufRawPacket::getHeadroom() const
+	{
+		return m_MBuf != nullptr ? rte_pktmbuf_headroom(m_MBuf) : 0;
+	}
+
+	size_t MBufRawPacket::getTailroom() const
+	{
+		return m_MBuf != nullptr ? rte_pktmbuf_tailroom(m_MBuf) : 0;
+	}
+
+	bool MBufRawPacket::prependData(const uint8_t* dataToPrepend, size_t dataToPrependLen)
+	{
+		if (m_MBuf == nullptr)
+		{
+			PCPP_LOG_ERROR("MBufRawPacket not initialized. Please call the init() method");
+			return false;
+		}
+
+		char* startOfPrependedData = rte_pktmbuf_prepend(m_MBuf, dataToPrependLen);
+		if (startOfPrependedData == nullptr)
+		{
+			PCPP_LOG_ERROR("Couldn't prepend " << dataToPrependLen
+			                                   << " bytes to RawPacket - not enough headroom in mBuf");
+			return false;
+		}
+
+		if (dataToPrepend != nullptr)
+			memcpy(startOfPrependedData, dataToPrepend, dataToPrependLen);
+
+		m_RawData = (uint8_t*)startOfPrependedData;
+		m_RawDataLen += dataToPrependLen;
+		m_FrameLength = rte_pktmbuf_pkt_len(m_MBuf);
+
+		PCPP_LOG_DEBUG("Prepended " << dataToPrependLen << " bytes to MBufRawPacket");
+
+		return true;
+	}
+
+	bool MBufRawPacket::removeDataFromStart(size_t numOfBytesToRemove)
+	{
+		if (m_MBuf == nullptr)
+		{
+			PCPP_LOG_ERROR("MBufRawPacket not initialized. Please call the init() method");
+			return false;
+		}
+
+		char* newStart = rte_pktmbuf_adj(m_MBuf, numOfBytesToRemove);
+		if (newStart == nullptr)
+		{
+			PCPP_LOG_ERROR("Couldn't remove " << numOfBytesToRemove << " bytes from the start of the mBuf");
+			return false;
+		}
+
+		m_RawData = (uint8_t*)newStart;
+		m_RawDataLen -= numOfBytesToRemove;
+		m_FrameLength = rte_pktmbuf_pkt_len(m_MBuf);
+
+		PCPP_LOG_DEBUG("Removed " << numOfBytesToRemove << " bytes from the start of MBufRawPacket");
+
+		return true;
+	}
+
+	bool MBufRawPacket::reserveRoom(size_t headroom, size_t tailroom)
+	{
+		if (headroom > getHeadroom() || tailroom > getTailroom())
+		{
+			PCPP_LOG_DEBUG("Cannot reserve room in mBuf raw packet. Requested headroom: "
+			               << headroom << ", tailroom: " << tailroom << "; mBuf headroom: " << getHeadroom()
+			               << ", tailroom: " << getTailroom());
+			return false;
+		}
+
+		return true;
+	}
+
 	bool MBufRawPacket::reallocateData(size_t newBufferLength)
 	{
 		if ((int)newBufferLength < m_RawDataLen)
@@ -312,6 +481,19 @@ namespace pcpp
 			return false;
 		}
 
+		if (isChained())
+		{
+			if (newBufferLength > static_cast<size_t>(m_RawDataLen) + rte_pktmbuf_tailroom(m_MBuf))
+			{
+				PCPP_LOG_ERROR("Cannot reallocate mBuf raw packet to a size larger than the first mBuf segment. "
+				               "Requested length: "
+				               << newBufferLength);
+				return false;
+			}
+
+			return true;
+		}
+
 		if ((int)newBufferLength > m_MbufDataSize)
 		{
 			PCPP_LOG_ERROR("Cannot reallocate mBuf raw packet to a size larger than mBuf data. mBuf max length: "
@@ -336,8 +518,177 @@ namespace pcpp
 		}
 
 		m_MBuf = mBuf;
-		RawPacket::setRawData(rte_pktmbuf_mtod(mBuf, const uint8_t*), rte_pktmbuf_pkt_len(mBuf), timestamp,
-		                      LINKTYPE_ETHERNET);
+
+		// make sure the headers of the packet are in the first segment
+		if (rte_pktmbuf_data_len(mBuf) < MBUFRAWPACKET_HEADER_PULLUP_LEN &&
+		    rte_pktmbuf_data_len(mBuf) < rte_pktmbuf_pkt_len(mBuf))
+		{
+			pullUp(MBUFRAWPACKET_HEADER_PULLUP_LEN);
+		}
+
+		setRawDataFromMBuf(timestamp, LINKTYPE_ETHERNET);
+	}
+
+	void MBufRawPacket::setRawDataFromMBuf(timespec timestamp, LinkLayerType layerType)
+	{
+		RawPacket::setRawData(rte_pktmbuf_mtod(m_MBuf, const uint8_t*), rte_pktmbuf_data_len(m_MBuf), timestamp,
+		                      layerType, rte_pktmbuf_pkt_len(m_MBuf));
+	}
+
+	void MBufRawPacket::resetMBuf()
+	{
+		if (m_MBuf->next != nullptr)
+		{
+			rte_pktmbuf_free(m_MBuf->next);
+			m_MBuf->next = nullptr;
+			m_MBuf->nb_segs = 1;
+		}
+
+		m_MBuf->data_len = 0;
+		m_MBuf->pkt_len = 0;
+	}
+
+	bool MBufRawPacket::appendToMBufChain(const uint8_t* data, size_t dataLen)
+	{
+		size_t appended = 0;
+		while (appended < dataLen)
+		{
+			rte_mbuf* lastSegment = rte_pktmbuf_lastseg(m_MBuf);
+			size_t room = rte_pktmbuf_tailroom(lastSegment);
+			if (room == 0)
+			{
+				rte_mbuf* newSegment = rte_pktmbuf_alloc(m_Mempool);
+				if (newSegment == nullptr)
+				{
+					PCPP_LOG_ERROR("Couldn't allocate mbuf for segment #" << m_MBuf->nb_segs);
+					return false;
+				}
+
+				// headroom is needed only in the first segment
+				newSegment->data_off = 0;
+				if (rte_pktmbuf_chain(m_MBuf, newSegment) != 0)
+				{
+					PCPP_LOG_ERROR("Couldn't chain more than " << m_MBuf->nb_segs << " mbufs");
+					rte_pktmbuf_free(newSegment);
+					return false;
+				}
+
+				continue;
+			}
+
+			uint16_t lenToAppend = static_cast<uint16_t>(std::min(room, dataLen - appended));
+			char* dest = rte_pktmbuf_append(m_MBuf, lenToAppend);
+			if (dest == nullptr)
+			{
+				PCPP_LOG_ERROR("Couldn't append " << lenToAppend << " bytes to mbuf");
+				return false;
+			}
+
+			memcpy(dest, data + appended, lenToAppend);
+			appended += lenToAppend;
+		}
+
+		return true;
+	}
+
+	uint16_t MBufRawPacket::getNumOfSegments() const
+	{
+		return m_MBuf == nullptr ? 0 : m_MBuf->nb_segs;
+	}
+
+	bool MBufRawPacket::getFirstSegment(Segment& segment) const
+	{
+		if (m_MBuf == nullptr)
+			return false;
+
+		segment.mbuf = m_MBuf;
+		segment.data = rte_pktmbuf_mtod(m_MBuf, uint8_t*);
+		segment.dataLen = rte_pktmbuf_data_len(m_MBuf);
+		return true;
+	}
+
+	bool MBufRawPacket::getNextSegment(Segment& segment) const
+	{
+		if (segment.mbuf == nullptr || segment.mbuf->next == nullptr)
+			return false;
+
+		segment.mbuf = segment.mbuf->next;
+		segment.data = rte_pktmbuf_mtod(segment.mbuf, uint8_t*);
+		segment.dataLen = rte_pktmbuf_data_len(segment.mbuf);
+		return true;
+	}
+
+	const uint8_t* MBufRawPacket::readData(size_t offset, size_t length, uint8_t* buffer) const
+	{
+		if (m_MBuf == nullptr)
+			return nullptr;
+
+		return static_cast<const uint8_t*>(
+		    rte_pktmbuf_read(m_MBuf, static_cast<uint32_t>(offset), static_cast<uint32_t>(length), buffer));
+	}
+
+	bool MBufRawPacket::pullUp(size_t length)
+	{
+		if (m_MBuf == nullptr)
+		{
+			PCPP_LOG_ERROR("MBufRawPacket not initialized. Please call the init() method");
+			return false;
+		}
+
+		length = std::min<size_t>(length, rte_pktmbuf_pkt_len(m_MBuf));
+		if (rte_pktmbuf_data_len(m_MBuf) >= length)
+			return true;
+
+		size_t missing = length - rte_pktmbuf_data_len(m_MBuf);
+		if (missing > rte_pktmbuf_tailroom(m_MBuf))
+		{
+			PCPP_LOG_ERROR("Not enough room in the first mbuf segment to hold " << length << " bytes");
+			return false;
+		}
+
+		// writing to the tailroom would corrupt the data of other mbufs pointing to the same buffer
+		if (!RTE_MBUF_DIRECT(m_MBuf) || rte_mbuf_refcnt_read(m_MBuf) > 1)
+		{
+			PCPP_LOG_ERROR("Cannot move data to the first mbuf segment since its buffer is shared");
+			return false;
+		}
+
+		uint8_t* dest = rte_pktmbuf_mtod_offset(m_MBuf, uint8_t*, rte_pktmbuf_data_len(m_MBuf));
+		while (missing > 0)
+		{
+			rte_mbuf* nextSegment = m_MBuf->next;
+			uint16_t lenToMove = static_cast<uint16_t>(std::min<size_t>(missing, rte_pktmbuf_data_len(nextSegment)));
+			memcpy(dest, rte_pktmbuf_mtod(nextSegment, uint8_t*), lenToMove);
+			dest += lenToMove;
+			missing -= lenToMove;
+			m_MBuf->data_len += lenToMove;
+			nextSegment->data_off += lenToMove;
+			nextSegment->data_len -= lenToMove;
+
+			if (nextSegment->data_len == 0)
+			{
+				m_MBuf->next = nextSegment->next;
+				m_MBuf->nb_segs--;
+				nextSegment->next = nullptr;
+				rte_pktmbuf_free_seg(nextSegment);
+			}
+		}
+
+		if (m_RawPacketSet)
+			setRawDataFromMBuf(m_TimeStamp, m_LinkLayerType);
+
+		return true;
+	}
+
+	bool MBufRawPacket::linearize()
+	{
+		if (m_MBuf == nullptr)
+		{
+			PCPP_LOG_ERROR("MBufRawPacket not initialized. Please call the init() method");
+			return false;
+		}
+
+		return pullUp(rte_pktmbuf_pkt_len(m_MBuf));
 	}
 
 }  // namespace pcpp
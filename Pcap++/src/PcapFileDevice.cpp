@@ -2,12 +2,17 @@
 
 #include <cerrno>
 #include "PcapFileDevice.h"
+#include "PcapNgBlockReader.h"
 #include "light_pcapng_ext.h"
 #include "Logger.h"
 #include "TimespecTimeval.h"
 #include "pcap.h"
 #include <fstream>
+#include <algorithm>
 #include "EndianPortable.h"
+#ifdef USE_Z_STD
+#	include "ZstdFrameStream.h"
+#endif
 
 namespace pcpp
 {
@@ -226,8 +231,8 @@ namespace pcpp
 		}
 		timespec ts = { static_cast<time_t>(be32toh(snoop_packet_header.time_sec)),
 			            static_cast<long>(be32toh(snoop_packet_header.time_usec)) * 1000 };
-		if (!rawPacket.setRawData((const uint8_t*)packetData.release(), packetSize, ts,
-		                          static_cast<LinkLayerType>(m_PcapLinkLayerType)))
+		if (!rawPacket.setOwnedRawData(reinterpret_cast<uint8_t*>(packetData.release()), packetSize, ts,
+		                               static_cast<LinkLayerType>(m_PcapLinkLayerType)))
 		{
 			PCPP_LOG_ERROR("Couldn't set data to raw packet");
 			return false;
@@ -343,8 +348,8 @@ namespace pcpp
 #else
 		struct timeval ts = pkthdr.ts;
 #endif
-		if (!rawPacket.setRawData(pMyPacketData, pkthdr.caplen, ts, static_cast<LinkLayerType>(m_PcapLinkLayerType),
-		                          pkthdr.len))
+		if (!rawPacket.setOwnedRawData(pMyPacketData, pkthdr.caplen, ts,
+		                               static_cast<LinkLayerType>(m_PcapLinkLayerType), pkthdr.len))
 		{
 			PCPP_LOG_ERROR("Couldn't set data to raw packet");
 			return false;
@@ -353,6 +358,23 @@ namespace pcpp
 		return true;
 	}
 
+#ifdef USE_Z_STD
+	static size_t readFromFrameReader(void* cookie, void* buf, size_t count)
+	{
+		return static_cast<internal::ZstdFrameReader*>(cookie)->read(buf, count);
+	}
+
+	static size_t writeToFrameWriter(void* cookie, const void* buf, size_t count)
+	{
+		return static_cast<internal::ZstdFrameWriter*>(cookie)->write(buf, count) ? count : static_cast<size_t>(-1);
+	}
+
+	static int flushFrameWriter(void* cookie)
+	{
+		return static_cast<internal::ZstdFrameWriter*>(cookie)->flush() ? 0 : -1;
+	}
+#endif
+
 	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 	// PcapNgFileReaderDevice members
 	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -360,6 +382,9 @@ namespace pcpp
 	PcapNgFileReaderDevice::PcapNgFileReaderDevice(const std::string& fileName) : IFileReaderDevice(fileName)
 	{
 		m_LightPcapNg = nullptr;
+		m_BlockReader = nullptr;
+		m_DecompressionThreads = 0;
+		m_FrameReader = nullptr;
 	}
 
 	bool PcapNgFileReaderDevice::open()
@@ -367,12 +392,46 @@ namespace pcpp
 		m_NumOfPacketsRead = 0;
 		m_NumOfPacketsNotParsed = 0;
 
-		if (m_LightPcapNg != nullptr)
+		if (m_LightPcapNg != nullptr || m_BlockReader != nullptr)
 		{
 			PCPP_LOG_DEBUG("pcapng descriptor already opened. Nothing to do");
 			return true;
 		}
 
+		m_BlockReader = new internal::PcapNgBlockReader();
+
+#ifdef USE_Z_STD
+		if (m_DecompressionThreads > 0)
+		{
+			m_FrameReader = new internal::ZstdFrameReader(m_DecompressionThreads);
+			if (m_FrameReader->open(m_FileName) && m_BlockReader->openStream(readFromFrameReader, m_FrameReader))
+			{
+				PCPP_LOG_DEBUG("Successfully opened pcapng reader device for filename '"
+				               << m_FileName << "' with " << m_FrameReader->getNumOfFrames() << " compressed frames");
+				m_DeviceOpened = true;
+				return true;
+			}
+
+			// not a seekable zstd file, read it sequentially
+			delete m_FrameReader;
+			m_FrameReader = nullptr;
+		}
+#else
+		if (m_DecompressionThreads > 0)
+			PCPP_LOG_DEBUG("PcapPlusPlus was built without zstd support, reading file sequentially");
+#endif
+
+		if (m_BlockReader->openFile(m_FileName))
+		{
+			PCPP_LOG_DEBUG("Successfully opened pcapng reader device for filename '" << m_FileName << "'");
+			m_DeviceOpened = true;
+			return true;
+		}
+
+		delete m_BlockReader;
+		m_BlockReader = nullptr;
+
+		// not an uncompressed pcapng file, let LightPcapNg handle compressed files
 		m_LightPcapNg = light_pcapng_open_read(m_FileName.c_str(), LIGHT_FALSE);
 		if (m_LightPcapNg == nullptr)
 		{
@@ -386,55 +445,88 @@ namespace pcpp
 		return true;
 	}
 
-	bool PcapNgFileReaderDevice::getNextPacket(RawPacket& rawPacket, std::string& packetComment)
+	bool PcapNgFileReaderDevice::readNextPacket(const uint8_t*& data, uint32_t& capturedLength,
+	                                            uint32_t& originalLength, timespec& timestamp, LinkLayerType& linkType,
+	                                            std::string* packetComment)
 	{
-		rawPacket.clear();
-		packetComment = "";
-
-		if (m_LightPcapNg == nullptr)
+		if (m_BlockReader == nullptr && m_LightPcapNg == nullptr)
 		{
 			PCPP_LOG_ERROR("Pcapng file device '" << m_FileName << "' not opened");
 			return false;
 		}
 
-		light_packet_header pktHeader;
-		const uint8_t* pktData = nullptr;
-
-		if (!light_get_next_packet((light_pcapng_t*)m_LightPcapNg, &pktHeader, &pktData))
-		{
-			PCPP_LOG_DEBUG("Packet could not be read. Probably end-of-file");
-			return false;
-		}
-
-		while (!m_BpfWrapper.matchPacketWithFilter(pktData, pktHeader.captured_length, pktHeader.timestamp,
-		                                           pktHeader.data_link))
+		const char* comment = nullptr;
+		size_t commentLength = 0;
+		do
 		{
-			if (!light_get_next_packet((light_pcapng_t*)m_LightPcapNg, &pktHeader, &pktData))
+			if (m_BlockReader != nullptr)
 			{
-				PCPP_LOG_DEBUG("Packet could not be read. Probably end-of-file");
-				return false;
+				internal::PcapNgBlockReader::PacketInfo packet;
+				if (!m_BlockReader->getNextPacket(packet, packetComment != nullptr))
+				{
+					PCPP_LOG_DEBUG("Packet could not be read. Probably end-of-file");
+					return false;
+				}
+
+				data = packet.data;
+				capturedLength = packet.capturedLength;
+				originalLength = packet.originalLength;
+				timestamp = packet.timestamp;
+				linkType = packet.linkType;
+				comment = packet.comment;
+				commentLength = packet.commentLength;
 			}
-		}
+			else
+			{
+				light_packet_header pktHeader;
+				if (!light_get_next_packet((light_pcapng_t*)m_LightPcapNg, &pktHeader, &data))
+				{
+					PCPP_LOG_DEBUG("Packet could not be read. Probably end-of-file");
+					return false;
+				}
+
+				capturedLength = pktHeader.captured_length;
+				originalLength = pktHeader.original_length;
+				timestamp = pktHeader.timestamp;
+				linkType = static_cast<LinkLayerType>(pktHeader.data_link);
+				comment = pktHeader.comment;
+				commentLength = pktHeader.comment_length;
+			}
+		} while (!m_BpfWrapper.matchPacketWithFilter(data, capturedLength, timestamp, linkType));
 
-		uint8_t* myPacketData = new uint8_t[pktHeader.captured_length];
-		memcpy(myPacketData, pktData, pktHeader.captured_length);
-		const LinkLayerType linkType = static_cast<LinkLayerType>(pktHeader.data_link);
 		if (linkType == LinkLayerType::LINKTYPE_INVALID)
 		{
 			PCPP_LOG_ERROR("Link layer type of raw packet could not be determined");
 		}
 
-		if (!rawPacket.setRawData(myPacketData, pktHeader.captured_length, pktHeader.timestamp, linkType,
-		                          pktHeader.original_length))
+		if (packetComment != nullptr && comment != nullptr && commentLength > 0)
+			packetComment->assign(comment, commentLength);
+
+		m_NumOfPacketsRead++;
+		return true;
+	}
+
+	bool PcapNgFileReaderDevice::getNextPacket(RawPacket& rawPacket, std::string& packetComment)
+	{
+		rawPacket.clear();
+		packetComment = "";
+
+		const uint8_t* pktData = nullptr;
+		uint32_t capturedLength = 0;
+		uint32_t originalLength = 0;
+		timespec timestamp;
+		LinkLayerType linkType = LINKTYPE_INVALID;
+		if (!readNextPacket(pktData, capturedLength, originalLength, timestamp, linkType, &packetComment))
+			return false;
+
+		uint8_t* myPacketData = new uint8_t[capturedLength];
+		memcpy(myPacketData, pktData, capturedLength);
+		if (!rawPacket.setOwnedRawData(myPacketData, capturedLength, timestamp, linkType, originalLength))
 		{
 			PCPP_LOG_ERROR("Couldn't set data to raw packet");
 			return false;
 		}
 
-		if (pktHeader.comment != nullptr && pktHeader.comment_length > 0)
-			packetComment = std::string(pktHeader.comment, pktHeader.comment_length);
-
-		m_NumOfPacketsRead++;
 		return true;
 	}
 
@@ -444,6 +536,29 @@ namespace pcpp
 		return getNextPacket(rawPacket, temp);
 	}
 
+	bool PcapNgFileReaderDevice::getNextPacketZeroCopy(RawPacket& rawPacket)
+	{
+		rawPacket.clear();
+
+		const uint8_t* pktData = nullptr;
+		uint32_t capturedLength = 0;
+		uint32_t originalLength = 0;
+		timespec timestamp;
+		LinkLayerType linkType = LINKTYPE_INVALID;
+		if (!readNextPacket(pktData, capturedLength, originalLength, timestamp, linkType, nullptr))
+			return false;
+
+		// initWithRawData() makes sure the raw packet doesn't own the data, setRawData() sets the frame length
+		if (!rawPacket.initWithRawData(pktData, capturedLength, timestamp, linkType) ||
+		    !rawPacket.setRawData(pktData, capturedLength, timestamp, linkType, originalLength))
+		{
+			PCPP_LOG_ERROR("Couldn't set data to raw packet");
+			return false;
+		}
+
+		return true;
+	}
+
 	void PcapNgFileReaderDevice::getStatistics(PcapStats& stats) const
 	{
 		stats.packetsRecv = m_NumOfPacketsRead;
@@ -457,20 +572,68 @@ namespace pcpp
 		return m_BpfWrapper.setFilter(filterAsString);
 	}
 
+	uint32_t PcapNgFileReaderDevice::getNumOfCompressedFrames() const
+	{
+#ifdef USE_Z_STD
+		if (m_FrameReader != nullptr)
+			return m_FrameReader->getNumOfFrames();
+#endif
+		return 0;
+	}
+
+	bool PcapNgFileReaderDevice::seekToCompressedFrame(uint32_t frameIndex)
+	{
+#ifdef USE_Z_STD
+		if (m_FrameReader == nullptr || m_BlockReader == nullptr)
+		{
+			PCPP_LOG_ERROR("Pcapng file device '" << m_FileName << "' isn't opened with parallel decompression");
+			return false;
+		}
+
+		if (!m_FrameReader->seekToFrame(frameIndex))
+			return false;
+
+		// the stream restarts with the section header, so the interfaces are re-read from scratch
+		if (!m_BlockReader->restart())
+		{
+			PCPP_LOG_ERROR("Cannot read pcapng section header after seeking to frame #" << frameIndex);
+			close();
+			return false;
+		}
+
+		return true;
+#else
+		PCPP_LOG_ERROR("PcapPlusPlus was built without zstd support, seeking isn't supported");
+		return false;
+#endif
+	}
+
 	void PcapNgFileReaderDevice::close()
 	{
-		if (m_LightPcapNg == nullptr)
+		if (m_LightPcapNg == nullptr && m_BlockReader == nullptr)
 			return;
 
-		light_pcapng_close((light_pcapng_t*)m_LightPcapNg);
+		if (m_LightPcapNg != nullptr)
+			light_pcapng_close((light_pcapng_t*)m_LightPcapNg);
 		m_LightPcapNg = nullptr;
 
+		delete m_BlockReader;
+		m_BlockReader = nullptr;
+
+#ifdef USE_Z_STD
+		delete m_FrameReader;
+		m_FrameReader = nullptr;
+#endif
+
 		m_DeviceOpened = false;
 		PCPP_LOG_DEBUG("File reader closed for file '" << m_FileName << "'");
 	}
 
 	std::string PcapNgFileReaderDevice::getOS() const
 	{
+		if (m_BlockReader != nullptr)
+			return m_BlockReader->getSectionInfo().os;
+
 		if (m_LightPcapNg == nullptr)
 		{
 			PCPP_LOG_ERROR("Pcapng file device '" << m_FileName << "' not opened");
@@ -490,6 +653,9 @@ namespace pcpp
 
 	std::string PcapNgFileReaderDevice::getHardware() const
 	{
+		if (m_BlockReader != nullptr)
+			return m_BlockReader->getSectionInfo().hardware;
+
 		if (m_LightPcapNg == nullptr)
 		{
 			PCPP_LOG_ERROR("Pcapng file device '" << m_FileName << "' not opened");
@@ -509,6 +675,9 @@ namespace pcpp
 
 	std::string PcapNgFileReaderDevice::getCaptureApplication() const
 	{
+		if (m_BlockReader != nullptr)
+			return m_BlockReader->getSectionInfo().application;
+
 		if (m_LightPcapNg == nullptr)
 		{
 			PCPP_LOG_ERROR("Pcapng file device '" << m_FileName << "' not opened");
@@ -528,6 +697,9 @@ namespace pcpp
 
 	std::string PcapNgFileReaderDevice::getCaptureFileComment() const
 	{
+		if (m_BlockReader != nullptr)
+			return m_BlockReader->getSectionInfo().comment;
+
 		if (m_LightPcapNg == nullptr)
 		{
 			PCPP_LOG_ERROR("Pcapng file device '" << m_FileName << "' not opened");
@@ -824,11 +996,55 @@ namespace pcpp
 	// PcapNgFileWriterDevice members
 	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
+	constexpr uint32_t PcapNgFileWriterDevice::DefaultCompressionFrameSize;
+
 	PcapNgFileWriterDevice::PcapNgFileWriterDevice(const std::string& fileName, int compressionLevel)
 	    : IFileWriterDevice(fileName)
 	{
 		m_LightPcapNg = nullptr;
 		m_CompressionLevel = compressionLevel;
+		m_CompressionThreads = 0;
+		m_CompressionFrameSize = DefaultCompressionFrameSize;
+		m_FrameWriter = nullptr;
+	}
+
+	void PcapNgFileWriterDevice::setCompressionThreads(int numOfThreads, uint32_t frameSize)
+	{
+		m_CompressionThreads = numOfThreads;
+		m_CompressionFrameSize = (frameSize > 0 ? frameSize : DefaultCompressionFrameSize);
+	}
+
+	bool PcapNgFileWriterDevice::openWrite(void* fileInfo)
+	{
+		light_pcapng_file_info* info = (light_pcapng_file_info*)fileInfo;
+
+#ifdef USE_Z_STD
+		if (m_CompressionThreads > 0 && m_CompressionLevel > 0)
+		{
+			// LightPcapNg expects a compression level between 0 and 10 which is scaled to zstd's 0-20 range
+			m_FrameWriter = new internal::ZstdFrameWriter(std::min(m_CompressionLevel, 10) * 2, m_CompressionThreads,
+			                                              m_CompressionFrameSize);
+			if (m_FrameWriter->open(m_FileName))
+			{
+				light_io_callbacks callbacks;
+				callbacks.cookie = m_FrameWriter;
+				callbacks.write = writeToFrameWriter;
+				callbacks.flush = flushFrameWriter;
+				m_LightPcapNg = light_pcapng_open_write_callbacks(&callbacks, info);
+			}
+
+			if (m_LightPcapNg == nullptr)
+			{
+				delete m_FrameWriter;
+				m_FrameWriter = nullptr;
+			}
+
+			return m_LightPcapNg != nullptr;
+		}
+#endif
+
+		m_LightPcapNg = light_pcapng_open_write(m_FileName.c_str(), info, m_CompressionLevel);
+		return m_LightPcapNg != nullptr;
 	}
 
 	bool PcapNgFileWriterDevice::open(const std::string& os, const std::string& hardware, const std::string& captureApp,
@@ -846,8 +1062,7 @@ namespace pcpp
 		light_pcapng_file_info* info =
 		    light_create_file_info(os.c_str(), hardware.c_str(), captureApp.c_str(), fileComment.c_str());
 
-		m_LightPcapNg = light_pcapng_open_write(m_FileName.c_str(), info, m_CompressionLevel);
-		if (m_LightPcapNg == nullptr)
+		if (!openWrite(info))
 		{
 			PCPP_LOG_ERROR("Error opening file writer device for file '"
 			               << m_FileName << "': light_pcapng_open_write returned nullptr");
@@ -930,8 +1145,7 @@ namespace pcpp
 
 		light_pcapng_file_info* info = light_create_default_file_info();
 
-		m_LightPcapNg = light_pcapng_open_write(m_FileName.c_str(), info, m_CompressionLevel);
-		if (m_LightPcapNg == nullptr)
+		if (!openWrite(info))
 		{
 			PCPP_LOG_ERROR("Error opening file writer device for file '"
 			               << m_FileName << "': light_pcapng_open_write returned nullptr");
@@ -986,6 +1200,16 @@ namespace pcpp
 		light_pcapng_close((light_pcapng_t*)m_LightPcapNg);
 		m_LightPcapNg = nullptr;
 
+#ifdef USE_Z_STD
+		if (m_FrameWriter != nullptr)
+		{
+			// completes the frames in flight and writes the seek table
+			m_FrameWriter->close();
+			delete m_FrameWriter;
+			m_FrameWriter = nullptr;
+		}
+#endif
+
 		m_DeviceOpened = false;
 		PCPP_LOG_DEBUG("File writer closed for file '" << m_FileName << "'");
 	}
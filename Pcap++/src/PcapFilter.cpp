@@ -2,6 +2,7 @@
 
 #include "PcapFilter.h"
 #include "Logger.h"
+#include "Instrumentation.h"
 #include "IPv4Layer.h"
 #include "PcapUtils.h"
 #include <sstream>
@@ -113,6 +114,7 @@ namespace pcpp
 		pktHdr.len = packetDataLength;
 		TIMESPEC_TO_TIMEVAL(&pktHdr.ts, &packetTimestamp);
 
+		PCPP_INSTRUMENT_COUNT(FilterEvaluations, 1);
 		return (pcap_offline_filter(m_Program.get(), &pktHdr, packetData) != 0);
 	}
 
@@ -12,6 +12,7 @@
 #include "pcap.h"
 #include <thread>
 #include "Logger.h"
+#include "Instrumentation.h"
 #include "SystemUtils.h"
 #include <cstring>
 #include <iostream>
@@ -86,6 +87,18 @@ namespace pcpp
 	}
 #endif
 
+	// pcap_dispatch() that also counts the received batch when instrumentation is enabled
+	static int dispatchPackets(pcap_t* descriptor, int count, pcap_handler callback, uint8_t* user)
+	{
+		int numOfPackets = pcap_dispatch(descriptor, count, callback, user);
+		if (numOfPackets > 0)
+		{
+			PCPP_INSTRUMENT_COUNT(DeviceRxBatches, 1);
+			PCPP_INSTRUMENT_COUNT(DeviceRxPackets, numOfPackets);
+		}
+		return numOfPackets;
+	}
+
 	PcapLiveDevice::DeviceInterfaceDetails::DeviceInterfaceDetails(pcap_if_t* pInterface)
 	    : name(pInterface->name), isLoopback(pInterface->flags & PCAP_IF_LOOPBACK)
 	{
@@ -219,7 +232,8 @@ namespace pcpp
 		{
 			while (!m_StopThread)
 			{
-				if (pcap_dispatch(m_PcapDescriptor.get(), -1, onPacketArrives, reinterpret_cast<uint8_t*>(this)) == -1)
+				if (dispatchPackets(m_PcapDescriptor.get(), -1, onPacketArrives,
+				                    reinterpret_cast<uint8_t*>(this)) == -1)
 				{
 					PCPP_LOG_ERROR("pcap_dispatch returned an error: " << m_PcapDescriptor.getLastError());
 					m_StopThread = true;
@@ -230,8 +244,8 @@ namespace pcpp
 		{
 			while (!m_StopThread)
 			{
-				if (pcap_dispatch(m_PcapDescriptor.get(), 100, onPacketArrivesNoCallback,
-				                  reinterpret_cast<uint8_t*>(this)) == -1)
+				if (dispatchPackets(m_PcapDescriptor.get(), 100, onPacketArrivesNoCallback,
+				                    reinterpret_cast<uint8_t*>(this)) == -1)
 				{
 					PCPP_LOG_ERROR("pcap_dispatch returned an error: " << m_PcapDescriptor.getLastError());
 					m_StopThread = true;
@@ -578,8 +592,8 @@ namespace pcpp
 		{
 			while (!m_StopThread)
 			{
-				if (pcap_dispatch(m_PcapDescriptor.get(), -1, onPacketArrivesBlockingMode,
-				                  reinterpret_cast<uint8_t*>(this)) == -1)
+				if (dispatchPackets(m_PcapDescriptor.get(), -1, onPacketArrivesBlockingMode,
+				                    reinterpret_cast<uint8_t*>(this)) == -1)
 				{
 					PCPP_LOG_ERROR("pcap_dispatch returned an error: " << m_PcapDescriptor.getLastError());
 					shouldReturnError = true;
@@ -605,8 +619,8 @@ namespace pcpp
 
 					if (ready > 0)
 					{
-						if (pcap_dispatch(m_PcapDescriptor.get(), -1, onPacketArrivesBlockingMode,
-						                  reinterpret_cast<uint8_t*>(this)) == -1)
+						if (dispatchPackets(m_PcapDescriptor.get(), -1, onPacketArrivesBlockingMode,
+						                    reinterpret_cast<uint8_t*>(this)) == -1)
 						{
 							PCPP_LOG_ERROR("pcap_dispatch returned an error: " << m_PcapDescriptor.getLastError());
 							shouldReturnError = true;
@@ -627,8 +641,8 @@ namespace pcpp
 				}
 				else
 				{
-					if (pcap_dispatch(m_PcapDescriptor.get(), -1, onPacketArrivesBlockingMode,
-					                  reinterpret_cast<uint8_t*>(this)) == -1)
+					if (dispatchPackets(m_PcapDescriptor.get(), -1, onPacketArrivesBlockingMode,
+					                    reinterpret_cast<uint8_t*>(this)) == -1)
 					{
 						PCPP_LOG_ERROR("pcap_dispatch returned an error: " << m_PcapDescriptor.getLastError());
 						shouldReturnError = true;
@@ -759,6 +773,7 @@ namespace pcpp
 			return false;
 		}
 
+		PCPP_INSTRUMENT_COUNT(DeviceTxPackets, 1);
 		PCPP_LOG_DEBUG("Packet sent successfully. Packet length: " << packetDataLength);
 		return true;
 	}
@@ -788,6 +803,7 @@ namespace pcpp
 
 	int PcapLiveDevice::sendPackets(RawPacket* rawPacketsArr, int arrLength, bool checkMtu)
 	{
+		PCPP_INSTRUMENT_COUNT(DeviceTxBatches, 1);
 		int packetsSent = 0;
 		for (int i = 0; i < arrLength; i++)
 		{
@@ -801,6 +817,7 @@ namespace pcpp
 
 	int PcapLiveDevice::sendPackets(Packet** packetsArr, int arrLength, bool checkMtu)
 	{
+		PCPP_INSTRUMENT_COUNT(DeviceTxBatches, 1);
 		int packetsSent = 0;
 		for (int i = 0; i < arrLength; i++)
 		{
@@ -814,6 +831,7 @@ namespace pcpp
 
 	int PcapLiveDevice::sendPackets(const RawPacketVector& rawPackets, bool checkMtu)
 	{
+		PCPP_INSTRUMENT_COUNT(DeviceTxBatches, 1);
 		int packetsSent = 0;
 		for (RawPacketVector::ConstVectorIterator iter = rawPackets.begin(); iter != rawPackets.end(); iter++)
 		{
@@ -0,0 +1,528 @@
+#define LOG_MODULE PcapLogModuleFileDevice
+
+#include "PcapNgBlockReader.h"
+#include "Logger.h"
+#include "EndianPortable.h"
+#include <algorithm>
+#include <cstring>
+#if !defined(_WIN32)
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace pcpp
+{
+	namespace internal
+	{
+		static const uint32_t SECTION_HEADER_BLOCK = 0x0A0D0D0A;
+		static const uint32_t INTERFACE_DESCRIPTION_BLOCK = 0x00000001;
+		static const uint32_t SIMPLE_PACKET_BLOCK = 0x00000003;
+		static const uint32_t ENHANCED_PACKET_BLOCK = 0x00000006;
+		static const uint32_t BYTE_ORDER_MAGIC = 0x1A2B3C4D;
+
+		// block type, block length and the trailing block length
+		static const uint32_t BLOCK_OVERHEAD = 12;
+		// block overhead, byte order magic, version and section length
+		static const uint32_t SECTION_HEADER_MIN_LEN = 28;
+		// block overhead, link type, reserved and snap length
+		static const uint32_t INTERFACE_DESCRIPTION_MIN_LEN = 20;
+		// block overhead and original packet length
+		static const uint32_t SIMPLE_PACKET_MIN_LEN = 16;
+		// block overhead, interface id, timestamp (high/low), captured length and original length
+		static const uint32_t ENHANCED_PACKET_MIN_LEN = 32;
+		// a packet of up to 16MB with room for the block fields and options. Longer blocks are treated as corrupted,
+		// so a corrupted block length can't make the read buffer grow without bound
+		static const uint32_t MAX_BLOCK_LEN = 16 * 1024 * 1024 + 64 * 1024;
+
+		static const uint16_t OPTION_END = 0;
+		static const uint16_t OPTION_COMMENT = 1;
+		static const uint16_t OPTION_SHB_HARDWARE = 2;
+		static const uint16_t OPTION_SHB_OS = 3;
+		static const uint16_t OPTION_SHB_USER_APPL = 4;
+		static const uint16_t OPTION_IF_TSRESOL = 9;
+		static const uint16_t OPTION_IF_TSOFFSET = 14;
+
+		static const size_t READ_BUFFER_SIZE = 1024 * 1024;
+		static const uint64_t NSEC_PER_SEC = 1000000000;
+		// timestamps with more seconds than this can't be represented in nanoseconds
+		static const uint64_t MAXIMUM_PACKET_SECONDS_VALUE = UINT64_MAX / NSEC_PER_SEC;
+
+		static size_t readFromFile(void* cookie, void* buf, size_t count)
+		{
+			return fread(buf, 1, count, static_cast<FILE*>(cookie));
+		}
+
+		static inline uint32_t alignTo4(uint32_t len)
+		{
+			return (len + 3) & ~static_cast<uint32_t>(3);
+		}
+
+		PcapNgBlockReader::PcapNgBlockReader()
+		    : m_Opened(false), m_BigEndian(false), m_Data(nullptr), m_DataLen(0), m_Pos(0), m_MappedData(nullptr),
+		      m_MappedLen(0), m_File(nullptr), m_ReadFunc(nullptr), m_ReadCookie(nullptr), m_EndOfStream(false),
+		      m_SectionInfoSet(false)
+		{}
+
+		PcapNgBlockReader::~PcapNgBlockReader()
+		{
+			close();
+		}
+
+		bool PcapNgBlockReader::openFile(const std::string& fileName)
+		{
+			close();
+
+			if (!mapFile(fileName))
+			{
+				m_File = fopen(fileName.c_str(), "rb");
+				if (m_File == nullptr)
+				{
+					PCPP_LOG_DEBUG("Cannot open file '" << fileName << "'");
+					return false;
+				}
+
+				m_ReadFunc = readFromFile;
+				m_ReadCookie = m_File;
+			}
+
+			if (!readSectionHeader())
+			{
+				close();
+				return false;
+			}
+
+			m_Opened = true;
+			return true;
+		}
+
+		bool PcapNgBlockReader::openStream(ReadFunc readFunc, void* cookie)
+		{
+			close();
+
+			m_ReadFunc = readFunc;
+			m_ReadCookie = cookie;
+			if (!readSectionHeader())
+			{
+				close();
+				return false;
+			}
+
+			m_Opened = true;
+			return true;
+		}
+
+		void PcapNgBlockReader::close()
+		{
+#if !defined(_WIN32)
+			if (m_MappedData != nullptr)
+				munmap(m_MappedData, m_MappedLen);
+#endif
+			if (m_File != nullptr)
+				fclose(m_File);
+
+			m_MappedData = nullptr;
+			m_MappedLen = 0;
+			m_File = nullptr;
+			m_ReadFunc = nullptr;
+			m_ReadCookie = nullptr;
+			m_Data = nullptr;
+			m_DataLen = 0;
+			m_Pos = 0;
+			m_EndOfStream = false;
+			m_Buffer.clear();
+			m_Buffer.shrink_to_fit();
+			m_Interfaces.clear();
+			m_SectionInfo = SectionInfo();
+			m_SectionInfoSet = false;
+			m_Opened = false;
+		}
+
+		bool PcapNgBlockReader::restart()
+		{
+			if (m_ReadFunc == nullptr || m_File != nullptr)
+				return false;
+
+			m_Data = m_Buffer.data();
+			m_DataLen = 0;
+			m_Pos = 0;
+			m_EndOfStream = false;
+			m_SectionInfoSet = false;
+			m_Opened = readSectionHeader();
+			return m_Opened;
+		}
+
+		bool PcapNgBlockReader::mapFile(const std::string& fileName)
+		{
+#if !defined(_WIN32)
+			int fd = ::open(fileName.c_str(), O_RDONLY);
+			if (fd < 0)
+				return false;
+
+			struct stat fileStat;
+			if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) || fileStat.st_size == 0)
+			{
+				::close(fd);
+				return false;
+			}
+
+			size_t len = static_cast<size_t>(fileStat.st_size);
+			void* data = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+			// the mapping stays valid after the descriptor is closed
+			::close(fd);
+			if (data == MAP_FAILED)
+				return false;
+
+			madvise(data, len, MADV_SEQUENTIAL);
+			m_MappedData = data;
+			m_MappedLen = len;
+			m_Data = static_cast<const uint8_t*>(data);
+			m_DataLen = len;
+			m_Pos = 0;
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		bool PcapNgBlockReader::ensureAvailable(size_t len)
+		{
+			if (m_DataLen - m_Pos >= len)
+				return true;
+
+			if (m_ReadFunc == nullptr || m_EndOfStream)
+				return false;
+
+			// move the partial block to the start of the buffer and fill the rest
+			size_t remaining = m_DataLen - m_Pos;
+			if (remaining > 0 && m_Pos > 0)
+				memmove(m_Buffer.data(), m_Buffer.data() + m_Pos, remaining);
+
+			if (m_Buffer.size() < std::max(len, READ_BUFFER_SIZE))
+				m_Buffer.resize(std::max(len, std::max(READ_BUFFER_SIZE, m_Buffer.size() * 2)));
+
+			m_Data = m_Buffer.data();
+			m_DataLen = remaining;
+			m_Pos = 0;
+
+			while (m_DataLen < len)
+			{
+				size_t bytesRead = m_ReadFunc(m_ReadCookie, m_Buffer.data() + m_DataLen, m_Buffer.size() - m_DataLen);
+				if (bytesRead == 0)
+				{
+					m_EndOfStream = true;
+					return false;
+				}
+
+				m_DataLen += bytesRead;
+			}
+
+			return true;
+		}
+
+		uint16_t PcapNgBlockReader::read16(const uint8_t* ptr) const
+		{
+			uint16_t value;
+			memcpy(&value, ptr, sizeof(value));
+			return m_BigEndian ? be16toh(value) : le16toh(value);
+		}
+
+		uint32_t PcapNgBlockReader::read32(const uint8_t* ptr) const
+		{
+			uint32_t value;
+			memcpy(&value, ptr, sizeof(value));
+			return m_BigEndian ? be32toh(value) : le32toh(value);
+		}
+
+		uint64_t PcapNgBlockReader::read64(const uint8_t* ptr) const
+		{
+			uint64_t value;
+			memcpy(&value, ptr, sizeof(value));
+			return m_BigEndian ? be64toh(value) : le64toh(value);
+		}
+
+		bool PcapNgBlockReader::readSectionHeader()
+		{
+			if (!ensureAvailable(BLOCK_OVERHEAD))
+				return false;
+
+			const uint8_t* block = m_Data + m_Pos;
+			uint32_t blockType;
+			uint32_t magic;
+			memcpy(&blockType, block, sizeof(blockType));
+			memcpy(&magic, block + 8, sizeof(magic));
+			// the block type is a palindrome, so it can be checked before the byte order is known
+			if (blockType != SECTION_HEADER_BLOCK)
+			{
+				PCPP_LOG_DEBUG("Stream doesn't start with a pcapng section header block");
+				return false;
+			}
+
+			if (le32toh(magic) == BYTE_ORDER_MAGIC)
+				m_BigEndian = false;
+			else if (be32toh(magic) == BYTE_ORDER_MAGIC)
+				m_BigEndian = true;
+			else
+			{
+				PCPP_LOG_ERROR("Invalid byte order magic in pcapng section header block");
+				return false;
+			}
+
+			uint32_t blockLen = read32(block + 4);
+			if (blockLen < SECTION_HEADER_MIN_LEN || blockLen > MAX_BLOCK_LEN || blockLen % 4 != 0 ||
+			    !ensureAvailable(blockLen))
+			{
+				PCPP_LOG_ERROR("Corrupted pcapng section header block");
+				return false;
+			}
+
+			block = m_Data + m_Pos;
+			m_Pos += blockLen;
+			parseSectionHeader(block, blockLen);
+			return true;
+		}
+
+		void PcapNgBlockReader::parseSectionHeader(const uint8_t* block, uint32_t blockLen)
+		{
+			// a new section starts with no interfaces
+			m_Interfaces.clear();
+
+			if (m_SectionInfoSet)
+				return;
+
+			const uint8_t* options = block + SECTION_HEADER_MIN_LEN - 4;
+			const uint8_t* optionsEnd = block + blockLen - 4;
+			const uint8_t* value;
+			uint16_t valueLen;
+			if (findOption(options, optionsEnd, OPTION_COMMENT, value, valueLen))
+				m_SectionInfo.comment.assign(reinterpret_cast<const char*>(value), valueLen);
+			if (findOption(options, optionsEnd, OPTION_SHB_HARDWARE, value, valueLen))
+				m_SectionInfo.hardware.assign(reinterpret_cast<const char*>(value), valueLen);
+			if (findOption(options, optionsEnd, OPTION_SHB_OS, value, valueLen))
+				m_SectionInfo.os.assign(reinterpret_cast<const char*>(value), valueLen);
+			if (findOption(options, optionsEnd, OPTION_SHB_USER_APPL, value, valueLen))
+				m_SectionInfo.application.assign(reinterpret_cast<const char*>(value), valueLen);
+
+			m_SectionInfoSet = true;
+		}
+
+		void PcapNgBlockReader::parseInterfaceDescription(const uint8_t* block, uint32_t blockLen)
+		{
+			if (blockLen < INTERFACE_DESCRIPTION_MIN_LEN || m_Interfaces.size() >= MaxSupportedInterfaces)
+				return;
+
+			InterfaceInfo iface;
+			iface.linkType = static_cast<LinkLayerType>(read16(block + 8));
+			iface.snapLen = read32(block + 12);
+			iface.ticksPerSecond = 1000000;
+			iface.offsetSeconds = 0;
+
+			const uint8_t* options = block + INTERFACE_DESCRIPTION_MIN_LEN - 4;
+			const uint8_t* optionsEnd = block + blockLen - 4;
+			const uint8_t* value;
+			uint16_t valueLen;
+			if (findOption(options, optionsEnd, OPTION_IF_TSRESOL, value, valueLen) && valueLen >= 1)
+			{
+				// the most significant bit selects between a negative power of 10 and a negative power of 2
+				uint8_t exponent = value[0] & 0x7F;
+				bool powerOf2 = (value[0] & 0x80) != 0;
+				uint64_t ticksPerSecond = 1;
+				for (uint8_t i = 0; i < exponent && ticksPerSecond != 0; i++)
+				{
+					uint64_t next = ticksPerSecond * (powerOf2 ? 2 : 10);
+					ticksPerSecond = (next / (powerOf2 ? 2 : 10) == ticksPerSecond ? next : 0);
+				}
+				iface.ticksPerSecond = ticksPerSecond;
+			}
+
+			if (findOption(options, optionsEnd, OPTION_IF_TSOFFSET, value, valueLen) && valueLen >= 8)
+				iface.offsetSeconds = static_cast<int64_t>(read64(value));
+
+			m_Interfaces.push_back(iface);
+		}
+
+		bool PcapNgBlockReader::findOption(const uint8_t* options, const uint8_t* optionsEnd, uint16_t code,
+		                                   const uint8_t*& value, uint16_t& valueLen) const
+		{
+			while (options + 4 <= optionsEnd)
+			{
+				uint16_t optionCode = read16(options);
+				uint16_t optionLen = read16(options + 2);
+				if (optionCode == OPTION_END || options + 4 + optionLen > optionsEnd)
+					return false;
+
+				if (optionCode == code)
+				{
+					value = options + 4;
+					valueLen = optionLen;
+					return true;
+				}
+
+				options += 4 + alignTo4(optionLen);
+			}
+
+			return false;
+		}
+
+		void PcapNgBlockReader::setTimestamp(PacketInfo& packet, uint64_t ticks, const InterfaceInfo& iface) const
+		{
+			packet.timestamp.tv_sec = 0;
+			packet.timestamp.tv_nsec = 0;
+			if (iface.ticksPerSecond == 0)
+				return;
+
+			uint64_t seconds = ticks / iface.ticksPerSecond;
+			if (seconds > MAXIMUM_PACKET_SECONDS_VALUE)
+				return;
+
+			uint64_t fraction = ticks % iface.ticksPerSecond;
+			uint64_t nsec = (iface.ticksPerSecond <= MAXIMUM_PACKET_SECONDS_VALUE
+			                     ? fraction * NSEC_PER_SEC / iface.ticksPerSecond
+			                     : fraction / (iface.ticksPerSecond / NSEC_PER_SEC));
+			packet.timestamp.tv_sec = static_cast<time_t>(static_cast<int64_t>(seconds) + iface.offsetSeconds);
+			packet.timestamp.tv_nsec = static_cast<long>(nsec);
+		}
+
+		bool PcapNgBlockReader::getNextPacket(PacketInfo& packet, bool readComment)
+		{
+			if (!m_Opened)
+				return false;
+
+			while (true)
+			{
+				if (!ensureAvailable(8))
+					return false;
+
+				const uint8_t* block = m_Data + m_Pos;
+				uint32_t blockType = read32(block);
+				if (blockType == SECTION_HEADER_BLOCK)
+				{
+					if (!readSectionHeader())
+					{
+						m_Opened = false;
+						return false;
+					}
+
+					continue;
+				}
+
+				uint32_t blockLen = read32(block + 4);
+				if (blockLen < BLOCK_OVERHEAD || blockLen % 4 != 0)
+				{
+					PCPP_LOG_ERROR("Corrupted pcapng block of type 0x" << std::hex << blockType << " with length "
+					                                                    << std::dec << blockLen);
+					m_Opened = false;
+					return false;
+				}
+
+				if (blockLen > MAX_BLOCK_LEN)
+				{
+					PCPP_LOG_ERROR("pcapng block of type 0x" << std::hex << blockType << " is too long: " << std::dec
+					                                         << blockLen << " bytes");
+					m_Opened = false;
+					return false;
+				}
+
+				if (!ensureAvailable(blockLen))
+				{
+					PCPP_LOG_DEBUG("pcapng stream ends with a truncated block");
+					return false;
+				}
+
+				// the buffer may have moved while reading the rest of the block
+				block = m_Data + m_Pos;
+				m_Pos += blockLen;
+
+				if (read32(block + blockLen - 4) != blockLen)
+				{
+					PCPP_LOG_ERROR("Corrupted pcapng block of type 0x" << std::hex << blockType
+					                                                    << ", trailing length doesn't match");
+					m_Opened = false;
+					return false;
+				}
+
+				if (blockType == ENHANCED_PACKET_BLOCK)
+				{
+					if (blockLen < ENHANCED_PACKET_MIN_LEN)
+					{
+						PCPP_LOG_ERROR("Corrupted pcapng enhanced packet block");
+						m_Opened = false;
+						return false;
+					}
+
+					uint32_t interfaceId = read32(block + 8);
+					uint64_t ticks = (static_cast<uint64_t>(read32(block + 12)) << 32) | read32(block + 16);
+					packet.capturedLength = read32(block + 20);
+					packet.originalLength = read32(block + 24);
+					if (packet.capturedLength > blockLen - ENHANCED_PACKET_MIN_LEN)
+					{
+						PCPP_LOG_ERROR("Corrupted pcapng enhanced packet block, captured length "
+						               << packet.capturedLength << " exceeds block length " << blockLen);
+						m_Opened = false;
+						return false;
+					}
+
+					packet.data = block + ENHANCED_PACKET_MIN_LEN - 4;
+					if (interfaceId < m_Interfaces.size())
+					{
+						packet.linkType = m_Interfaces[interfaceId].linkType;
+						setTimestamp(packet, ticks, m_Interfaces[interfaceId]);
+					}
+					else
+					{
+						packet.linkType = LINKTYPE_INVALID;
+						packet.timestamp.tv_sec = 0;
+						packet.timestamp.tv_nsec = 0;
+					}
+
+					packet.comment = nullptr;
+					packet.commentLength = 0;
+					const uint8_t* value;
+					uint16_t valueLen;
+					if (readComment && findOption(packet.data + alignTo4(packet.capturedLength),
+					                              block + blockLen - 4, OPTION_COMMENT, value, valueLen))
+					{
+						packet.comment = reinterpret_cast<const char*>(value);
+						packet.commentLength = valueLen;
+					}
+
+					return true;
+				}
+
+				if (blockType == SIMPLE_PACKET_BLOCK)
+				{
+					if (blockLen < SIMPLE_PACKET_MIN_LEN)
+					{
+						PCPP_LOG_ERROR("Corrupted pcapng simple packet block");
+						m_Opened = false;
+						return false;
+					}
+
+					// simple packet blocks belong to the first interface and have no timestamp
+					packet.originalLength = read32(block + 8);
+					packet.capturedLength = std::min(packet.originalLength, blockLen - SIMPLE_PACKET_MIN_LEN);
+					packet.linkType = LINKTYPE_INVALID;
+					if (!m_Interfaces.empty())
+					{
+						packet.linkType = m_Interfaces[0].linkType;
+						if (m_Interfaces[0].snapLen != 0)
+							packet.capturedLength = std::min(packet.capturedLength, m_Interfaces[0].snapLen);
+					}
+
+					packet.data = block + SIMPLE_PACKET_MIN_LEN - 4;
+					packet.timestamp.tv_sec = 0;
+					packet.timestamp.tv_nsec = 0;
+					packet.comment = nullptr;
+					packet.commentLength = 0;
+					return true;
+				}
+
+				if (blockType == INTERFACE_DESCRIPTION_BLOCK)
+					parseInterfaceDescription(block, blockLen);
+
+				// all other block types are skipped
+			}
+		}
+	}  // namespace internal
+}  // namespace pcpp
@@ -136,7 +136,7 @@ namespace pcpp
 		{
 			timeval time;
 			gettimeofday(&time, nullptr);
-			rawPacket.setRawData((const uint8_t*)buffer, bufferLen, time, LINKTYPE_DLT_RAW1);
+			rawPacket.setOwnedRawData(reinterpret_cast<uint8_t*>(buffer), bufferLen, time, LINKTYPE_DLT_RAW1);
 			return RecvSuccess;
 		}
 
@@ -199,7 +199,7 @@ namespace pcpp
 		{
 			timeval time;
 			gettimeofday(&time, nullptr);
-			rawPacket.setRawData((const uint8_t*)buffer, bufferLen, time, LINKTYPE_ETHERNET);
+			rawPacket.setOwnedRawData(reinterpret_cast<uint8_t*>(buffer), bufferLen, time, LINKTYPE_ETHERNET);
 			return RecvSuccess;
 		}
 
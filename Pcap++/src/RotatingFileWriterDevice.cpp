@@ -0,0 +1,365 @@
+#define LOG_MODULE PcapLogModuleFileDevice
+
+#include "RotatingFileWriterDevice.h"
+#include "Logger.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <sstream>
+#if defined(__linux__)
+#	include <fcntl.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace pcpp
+{
+
+	static const char* const INDEX_PLACEHOLDER = "{index}";
+	static const uint64_t PCAP_FILE_HEADER_SIZE = 24;
+	static const uint64_t PCAP_RECORD_HEADER_SIZE = 16;
+	// block type, block length x2, interface id, timestamp (high/low), captured length, original length
+	static const uint64_t PCAPNG_EPB_OVERHEAD = 32;
+
+	RotatingFileWriterDevice::RotatingFileWriterDevice(const std::string& fileNamePattern,
+	                                                   const RotationConfig& config)
+	    : IFileWriterDevice(fileNamePattern), m_Config(config), m_FileIndex(0), m_CurrentFileSize(0),
+	      m_CurrentFilePackets(0), m_CurrentFileStartTime(0), m_StopBackgroundThread(false)
+	{}
+
+	RotatingFileWriterDevice::~RotatingFileWriterDevice()
+	{
+		RotatingFileWriterDevice::close();
+	}
+
+	bool RotatingFileWriterDevice::open()
+	{
+		if (m_DeviceOpened)
+		{
+			PCPP_LOG_DEBUG("Rotating file writer device already opened. Nothing to do");
+			return true;
+		}
+
+		if (m_FileName.empty())
+		{
+			PCPP_LOG_ERROR("File name pattern is empty");
+			return false;
+		}
+
+		m_NumOfPacketsWritten = 0;
+		m_NumOfPacketsNotWritten = 0;
+		m_FileIndex = 0;
+		m_UsedFileNames.clear();
+		m_StopBackgroundThread = false;
+		m_BackgroundThread = std::thread(&RotatingFileWriterDevice::backgroundThreadMain, this);
+
+		m_DeviceOpened = true;
+		PCPP_LOG_DEBUG("Rotating file writer device for pattern '" << m_FileName << "' opened successfully");
+		return true;
+	}
+
+	bool RotatingFileWriterDevice::open(bool appendMode)
+	{
+		if (appendMode)
+		{
+			PCPP_LOG_ERROR("Append mode is not supported by rotating file writer device");
+			return false;
+		}
+
+		return open();
+	}
+
+	void RotatingFileWriterDevice::close()
+	{
+		if (!m_DeviceOpened)
+			return;
+
+		closeCurrentFile();
+
+		{
+			std::lock_guard<std::mutex> lock(m_JobsMutex);
+			m_StopBackgroundThread = true;
+		}
+		m_JobsCond.notify_one();
+
+		if (m_BackgroundThread.joinable())
+			m_BackgroundThread.join();
+
+		m_FilesOnDisk.clear();
+		m_DeviceOpened = false;
+		PCPP_LOG_DEBUG("Rotating file writer device for pattern '" << m_FileName << "' closed");
+	}
+
+	void RotatingFileWriterDevice::rotate()
+	{
+		closeCurrentFile();
+	}
+
+	bool RotatingFileWriterDevice::writePacket(RawPacket const& packet)
+	{
+		if (!m_DeviceOpened)
+		{
+			PCPP_LOG_ERROR("Device not opened");
+			m_NumOfPacketsNotWritten++;
+			return false;
+		}
+
+		uint64_t recordSize = getRecordSize(packet);
+
+		if (m_CurrentWriter != nullptr && shouldRotate(packet, recordSize))
+			closeCurrentFile();
+
+		if (m_CurrentWriter == nullptr && !openNewFile(packet.getPacketTimeStamp().tv_sec))
+		{
+			m_NumOfPacketsNotWritten++;
+			return false;
+		}
+
+		if (!m_CurrentWriter->writePacket(packet))
+		{
+			m_NumOfPacketsNotWritten++;
+			return false;
+		}
+
+		m_CurrentFileSize += recordSize;
+		m_CurrentFilePackets++;
+		m_NumOfPacketsWritten++;
+		return true;
+	}
+
+	bool RotatingFileWriterDevice::writePackets(const RawPacketVector& packets)
+	{
+		bool result = true;
+		for (RawPacketVector::ConstVectorIterator iter = packets.begin(); iter != packets.end(); iter++)
+		{
+			if (!writePacket(**iter))
+				result = false;
+		}
+
+		return result;
+	}
+
+	void RotatingFileWriterDevice::getStatistics(PcapStats& stats) const
+	{
+		stats.packetsRecv = m_NumOfPacketsWritten;
+		stats.packetsDrop = m_NumOfPacketsNotWritten;
+		stats.packetsDropByInterface = 0;
+		PCPP_LOG_DEBUG("Statistics received for rotating writer device for pattern '" << m_FileName << "'");
+	}
+
+	bool RotatingFileWriterDevice::setFilter(std::string filterAsString)
+	{
+		PCPP_LOG_ERROR("Filtering is not supported by rotating file writer device");
+		return false;
+	}
+
+	bool RotatingFileWriterDevice::clearFilter()
+	{
+		return true;
+	}
+
+	uint64_t RotatingFileWriterDevice::getRecordSize(const RawPacket& packet) const
+	{
+		uint64_t capturedLength = static_cast<uint64_t>(packet.getRawDataLen());
+		if (m_Config.format == PcapNg)
+			return PCAPNG_EPB_OVERHEAD + ((capturedLength + 3) & ~static_cast<uint64_t>(3));
+
+		return PCAP_RECORD_HEADER_SIZE + capturedLength;
+	}
+
+	bool RotatingFileWriterDevice::shouldRotate(const RawPacket& packet, uint64_t recordSize) const
+	{
+		// never leave a file empty, even if a single packet exceeds the size limit
+		if (m_CurrentFilePackets == 0)
+			return false;
+
+		if (m_Config.maxPacketsPerFile > 0 && m_CurrentFilePackets >= m_Config.maxPacketsPerFile)
+			return true;
+
+		if (m_Config.maxFileSize > 0 && m_CurrentFileSize + recordSize > m_Config.maxFileSize)
+			return true;
+
+		if (m_Config.maxFileDurationSec > 0 &&
+		    packet.getPacketTimeStamp().tv_sec - m_CurrentFileStartTime >= (time_t)m_Config.maxFileDurationSec)
+			return true;
+
+		return false;
+	}
+
+	std::string RotatingFileWriterDevice::generateFileName(time_t firstPacketTime)
+	{
+		std::string pattern = m_FileName;
+		std::string indexAsString = std::to_string(m_FileIndex);
+		size_t pos = pattern.find(INDEX_PLACEHOLDER);
+		while (pos != std::string::npos)
+		{
+			pattern.replace(pos, strlen(INDEX_PLACEHOLDER), indexAsString);
+			pos = pattern.find(INDEX_PLACEHOLDER, pos + indexAsString.size());
+		}
+
+		struct tm* timeInfo = nullptr;
+#if !defined(_WIN32)
+		struct tm timeInfoR;
+		timeInfo = localtime_r(&firstPacketTime, &timeInfoR);
+#else
+		// on Windows localtime is already thread-safe
+		timeInfo = localtime(&firstPacketTime);
+#endif
+
+		std::string result = pattern;
+		if (timeInfo != nullptr && pattern.find('%') != std::string::npos)
+		{
+			char buf[1024];
+			size_t len = strftime(buf, sizeof(buf), pattern.c_str(), timeInfo);
+			if (len > 0)
+				result = std::string(buf, len);
+		}
+
+		// make sure an earlier file is never overwritten when the pattern has no index or a low time resolution
+		if (m_UsedFileNames.count(result) > 0)
+		{
+			size_t extensionPos = result.find_last_of('.');
+			size_t separatorPos = result.find_last_of("/\\");
+			if (extensionPos == std::string::npos || (separatorPos != std::string::npos && extensionPos < separatorPos))
+				extensionPos = result.size();
+
+			// the pattern itself may produce names that end with an index, so look for a free one
+			std::string uniqueName;
+			uint32_t suffix = m_FileIndex;
+			do
+			{
+				uniqueName = result;
+				uniqueName.insert(extensionPos, "_" + std::to_string(suffix++));
+			} while (m_UsedFileNames.count(uniqueName) > 0);
+
+			result = uniqueName;
+		}
+
+		return result;
+	}
+
+	bool RotatingFileWriterDevice::openNewFile(time_t firstPacketTime)
+	{
+		std::string fileName = generateFileName(firstPacketTime);
+
+		std::unique_ptr<IFileWriterDevice> writer;
+		if (m_Config.format == PcapNg)
+			writer.reset(new PcapNgFileWriterDevice(fileName, m_Config.compressionLevel));
+		else
+			writer.reset(new PcapFileWriterDevice(fileName, m_Config.linkLayerType, m_Config.nanosecondsPrecision));
+
+		if (!writer->open())
+		{
+			PCPP_LOG_ERROR("Couldn't open file '" << fileName << "' for writing");
+			return false;
+		}
+
+		m_CurrentWriter = std::move(writer);
+		m_CurrentFileName = fileName;
+		m_UsedFileNames.insert(fileName);
+		m_CurrentFileSize = (m_Config.format == Pcap ? PCAP_FILE_HEADER_SIZE : 0);
+		m_CurrentFilePackets = 0;
+		m_CurrentFileStartTime = firstPacketTime;
+		m_FileIndex++;
+
+		pushJob(BackgroundJob{ nullptr, fileName, m_Config.preallocateSize > 0 });
+
+		PCPP_LOG_DEBUG("Started writing to file '" << fileName << "'");
+		return true;
+	}
+
+	void RotatingFileWriterDevice::closeCurrentFile()
+	{
+		if (m_CurrentWriter == nullptr)
+			return;
+
+		PCPP_LOG_DEBUG("Rolling over file '" << m_CurrentFileName << "' after " << m_CurrentFilePackets << " packets");
+
+		pushJob(BackgroundJob{ std::move(m_CurrentWriter), m_CurrentFileName, false });
+		m_CurrentWriter = nullptr;
+		m_CurrentFileName.clear();
+		m_CurrentFileSize = 0;
+		m_CurrentFilePackets = 0;
+	}
+
+	void RotatingFileWriterDevice::pushJob(BackgroundJob&& job)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_JobsMutex);
+			m_Jobs.push_back(std::move(job));
+		}
+		m_JobsCond.notify_one();
+	}
+
+	void RotatingFileWriterDevice::backgroundThreadMain()
+	{
+		while (true)
+		{
+			BackgroundJob job;
+			{
+				std::unique_lock<std::mutex> lock(m_JobsMutex);
+				m_JobsCond.wait(lock, [this] { return !m_Jobs.empty() || m_StopBackgroundThread; });
+
+				// pending jobs are always completed before the thread exits
+				if (m_Jobs.empty())
+					return;
+
+				job = std::move(m_Jobs.front());
+				m_Jobs.pop_front();
+			}
+
+			handleJob(job);
+		}
+	}
+
+	void RotatingFileWriterDevice::handleJob(BackgroundJob& job)
+	{
+		if (job.writer != nullptr)
+		{
+			// a completed file: flush and close it, then give back pre-allocated space it didn't use
+			job.writer->close();
+			job.writer.reset();
+#if defined(__linux__)
+			if (m_Config.preallocateSize > 0)
+			{
+				struct stat fileStat;
+				if (stat(job.fileName.c_str(), &fileStat) == 0 && truncate(job.fileName.c_str(), fileStat.st_size) != 0)
+					PCPP_LOG_DEBUG("Couldn't release pre-allocated space of file '" << job.fileName << "'");
+			}
+#endif
+			return;
+		}
+
+		// a newly opened file
+		if (job.preallocate)
+		{
+#if defined(__linux__)
+			int fd = ::open(job.fileName.c_str(), O_WRONLY);
+			if (fd >= 0)
+			{
+				// FALLOC_FL_KEEP_SIZE reserves the blocks without changing the file size the writer sees
+				if (fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(m_Config.preallocateSize)) != 0)
+					PCPP_LOG_DEBUG("Couldn't pre-allocate space for file '" << job.fileName << "'");
+				::close(fd);
+			}
+#endif
+		}
+
+		m_FilesOnDisk.push_back(job.fileName);
+		if (m_Config.maxFilesToKeep == 0)
+			return;
+
+		// the oldest file is always closed at this point, since its close job was queued before this one
+		while (m_FilesOnDisk.size() > m_Config.maxFilesToKeep)
+		{
+			const std::string& oldestFile = m_FilesOnDisk.front();
+			if (std::remove(oldestFile.c_str()) != 0)
+				PCPP_LOG_ERROR("Couldn't delete file '" << oldestFile << "'");
+			else
+				PCPP_LOG_DEBUG("Deleted file '" << oldestFile << "' due to retention limit");
+
+			m_FilesOnDisk.pop_front();
+		}
+	}
+
+}  // namespace pcpp
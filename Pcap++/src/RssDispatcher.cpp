@@ -0,0 +1,530 @@
+#define LOG_MODULE PcapLogModuleRssDispatcher
+
+#include "RssDispatcher.h"
+#include "IPv4Layer.h"
+#include "Logger.h"
+#include "EndianPortable.h"
+#include <chrono>
+#include <string.h>
+#include <thread>
+
+namespace pcpp
+{
+	namespace
+	{
+		const uint16_t EtherTypeIPv4 = 0x0800;
+		const uint16_t EtherTypeIPv6 = 0x86DD;
+		const uint16_t EtherTypeVlan = 0x8100;
+		const uint16_t EtherTypeQinQ = 0x88A8;
+		const uint16_t EtherTypeVlan9100 = 0x9100;
+		const uint8_t IPProtocolSctp = 132;
+
+		// The fields the RSS hash is computed on, pointing into the packet data
+		struct FlowFields
+		{
+			const uint8_t* srcIP;
+			const uint8_t* dstIP;
+			size_t ipLen;
+			// nullptr if the packet has no ports or they aren't hashed
+			const uint8_t* ports;
+			uint8_t protocol;
+		};
+
+		inline uint16_t readBE16(const uint8_t* data)
+		{
+			return static_cast<uint16_t>((data[0] << 8) | data[1]);
+		}
+
+		// Find the offset of the IP header and its EtherType by the link layer type. Returns false for non-IP packets
+		bool findIPHeader(const uint8_t* data, size_t dataLen, LinkLayerType linkType, size_t& offset,
+		                  uint16_t& etherType)
+		{
+			switch (linkType)
+			{
+			case LINKTYPE_ETHERNET:
+			{
+				offset = 14;
+				if (dataLen < offset)
+					return false;
+				etherType = readBE16(data + 12);
+				while ((etherType == EtherTypeVlan || etherType == EtherTypeQinQ || etherType == EtherTypeVlan9100) &&
+				       dataLen >= offset + 4)
+				{
+					etherType = readBE16(data + offset + 2);
+					offset += 4;
+				}
+				return true;
+			}
+			case LINKTYPE_LINUX_SLL:
+			{
+				offset = 16;
+				if (dataLen < offset)
+					return false;
+				etherType = readBE16(data + 14);
+				return true;
+			}
+			case LINKTYPE_LINUX_SLL2:
+			{
+				offset = 20;
+				if (dataLen < offset)
+					return false;
+				etherType = readBE16(data);
+				return true;
+			}
+			case LINKTYPE_RAW:
+			case LINKTYPE_DLT_RAW1:
+			case LINKTYPE_DLT_RAW2:
+			case LINKTYPE_IPV4:
+			case LINKTYPE_IPV6:
+			{
+				offset = 0;
+				if (dataLen < 1)
+					return false;
+				etherType = (data[0] >> 4) == 6 ? EtherTypeIPv6 : EtherTypeIPv4;
+				return true;
+			}
+			default:
+				return false;
+			}
+		}
+
+		bool extractFlowFields(const uint8_t* data, size_t dataLen, LinkLayerType linkType, bool hashPorts,
+		                       FlowFields& fields)
+		{
+			size_t offset;
+			uint16_t etherType;
+			if (!findIPHeader(data, dataLen, linkType, offset, etherType))
+				return false;
+
+			const uint8_t* ipHeader = data + offset;
+			size_t ipDataLen = dataLen - offset;
+			size_t transportOffset;
+			bool isFragment;
+
+			if (etherType == EtherTypeIPv4)
+			{
+				if (ipDataLen < 20 || (ipHeader[0] >> 4) != 4)
+					return false;
+
+				fields.srcIP = ipHeader + 12;
+				fields.dstIP = ipHeader + 16;
+				fields.ipLen = 4;
+				fields.protocol = ipHeader[9];
+				// the MF flag or a non-zero fragment offset
+				isFragment = (readBE16(ipHeader + 6) & 0x3FFF) != 0;
+				transportOffset = static_cast<size_t>(ipHeader[0] & 0x0F) * 4;
+				// a header length below the minimum would point the ports into the IP header, so the packet is
+				// hashed by its addresses only
+				if (transportOffset < 20)
+					hashPorts = false;
+			}
+			else if (etherType == EtherTypeIPv6)
+			{
+				if (ipDataLen < 40 || (ipHeader[0] >> 4) != 6)
+					return false;
+
+				fields.srcIP = ipHeader + 8;
+				fields.dstIP = ipHeader + 24;
+				fields.ipLen = 16;
+				isFragment = false;
+
+				// skip the extension headers that may precede the transport header
+				uint8_t nextHeader = ipHeader[6];
+				transportOffset = 40;
+				while (transportOffset + 8 <= ipDataLen)
+				{
+					const uint8_t* extension = ipHeader + transportOffset;
+					if (nextHeader == 0 || nextHeader == 43 || nextHeader == 60)  // hop-by-hop, routing, destination
+						transportOffset += (static_cast<size_t>(extension[1]) + 1) * 8;
+					else if (nextHeader == 51)  // authentication header
+						transportOffset += (static_cast<size_t>(extension[1]) + 2) * 4;
+					else if (nextHeader == 44)  // fragment header
+					{
+						isFragment = true;
+						transportOffset += 8;
+					}
+					else
+						break;
+					nextHeader = extension[0];
+				}
+				fields.protocol = nextHeader;
+			}
+			else
+			{
+				return false;
+			}
+
+			fields.ports = nullptr;
+			if (hashPorts && !isFragment && transportOffset + 4 <= ipDataLen &&
+			    (fields.protocol == PACKETPP_IPPROTO_TCP || fields.protocol == PACKETPP_IPPROTO_UDP ||
+			     fields.protocol == IPProtocolSctp))
+			{
+				fields.ports = ipHeader + transportOffset;
+			}
+
+			return true;
+		}
+	}  // namespace
+
+	// The ring is a power-of-2 array of slots indexed by free-running head and tail counters. The producer (the
+	// dispatching thread) writes slots at pendingTail and publishes them by storing tail, the worker thread reads
+	// slots from head to tail and releases them by storing head
+	struct RssDispatcher::Worker
+	{
+		struct Slot
+		{
+			// keeps its capacity, so after the first packets no memory is allocated
+			std::vector<uint8_t> data;
+			timespec timestamp;
+			LinkLayerType linkType;
+			int frameLength;
+		};
+
+		std::vector<Slot> slots;
+		size_t mask;
+		uint8_t id;
+		std::thread thread;
+
+		// head is written by the worker and tail by the producer, on separate cache lines to avoid false sharing
+		std::atomic<size_t> head;
+		char padding1[64];
+		std::atomic<size_t> tail;
+		char padding2[64];
+
+		// used only by the producer
+		size_t pendingTail;
+		size_t cachedHead;
+		std::atomic<uint64_t> dispatchedPackets;
+		std::atomic<uint64_t> ringDrops;
+		char padding3[64];
+
+		// used only by the worker
+		std::atomic<uint64_t> processedPackets;
+
+		Worker(size_t ringSize, uint8_t workerId)
+		    : slots(ringSize), mask(ringSize - 1), id(workerId), head(0), tail(0), pendingTail(0), cachedHead(0),
+		      dispatchedPackets(0), ringDrops(0), processedPackets(0)
+		{}
+	};
+
+	constexpr size_t RssDispatcher::IndirectionTableSize;
+	constexpr size_t RssDispatcher::MaxNumOfWorkers;
+
+	RssDispatcher::RssDispatcher(size_t numOfWorkers, OnPacketCallback onPacket, void* userCookie,
+	                             const DispatcherConfig& config)
+	    : m_NumOfWorkers(numOfWorkers), m_OnPacket(std::move(onPacket)), m_UserCookie(userCookie), m_Config(config),
+	      m_ToeplitzHash(config.rssKey, config.rssKeyLength), m_Running(false), m_Stop(false)
+	{
+		// the same default indirection table as DPDK and most NICs
+		for (size_t i = 0; i < IndirectionTableSize; i++)
+		{
+			m_IndirectionTable[i] = static_cast<uint8_t>(numOfWorkers > 0 ? i % numOfWorkers : 0);
+		}
+
+		// the key is copied by ToeplitzHash, don't keep a pointer the user may free
+		m_Config.rssKey = nullptr;
+	}
+
+	RssDispatcher::~RssDispatcher()
+	{
+		stop();
+	}
+
+	bool RssDispatcher::start()
+	{
+		if (m_Running)
+		{
+			PCPP_LOG_ERROR("RSS dispatcher is already running");
+			return false;
+		}
+
+		if (m_NumOfWorkers == 0 || m_NumOfWorkers > MaxNumOfWorkers)
+		{
+			PCPP_LOG_ERROR("Number of RSS dispatcher workers must be between 1 and " << MaxNumOfWorkers);
+			return false;
+		}
+
+		if (m_Config.ringSize == 0 || (m_Config.ringSize & (m_Config.ringSize - 1)) != 0)
+		{
+			PCPP_LOG_ERROR("RSS dispatcher ring size must be a power of 2");
+			return false;
+		}
+
+		if (m_Config.burstSize == 0)
+		{
+			PCPP_LOG_ERROR("RSS dispatcher burst size must be at least 1");
+			return false;
+		}
+
+		if (m_Config.hashFunction == HashFunction::Toeplitz && m_ToeplitzHash.getMaxInputLength() < 36)
+		{
+			PCPP_LOG_ERROR("RSS key must be at least 40 bytes long to hash IPv6 packets");
+			return false;
+		}
+
+		if (!m_OnPacket)
+		{
+			PCPP_LOG_ERROR("RSS dispatcher callback is empty");
+			return false;
+		}
+
+		m_Stop = false;
+		m_Workers.clear();
+		for (size_t i = 0; i < m_NumOfWorkers; i++)
+		{
+			m_Workers.emplace_back(new Worker(m_Config.ringSize, static_cast<uint8_t>(i)));
+		}
+
+		for (auto& worker : m_Workers)
+		{
+			worker->thread = std::thread(&RssDispatcher::runWorker, this, std::ref(*worker));
+		}
+
+		m_Running = true;
+		return true;
+	}
+
+	void RssDispatcher::stop()
+	{
+		if (!m_Running)
+			return;
+
+		// publish what a batch may have left pending, then let the workers drain their rings and exit
+		for (auto& worker : m_Workers)
+		{
+			publish(*worker);
+		}
+
+		m_Stop.store(true, std::memory_order_release);
+		for (auto& worker : m_Workers)
+		{
+			worker->thread.join();
+		}
+
+		m_Running = false;
+	}
+
+	uint64_t RssDispatcher::computeHash(const RawPacket& rawPacket) const
+	{
+		FlowFields fields;
+		if (!extractFlowFields(rawPacket.getRawData(), static_cast<size_t>(rawPacket.getRawDataLen()),
+		                       rawPacket.getLinkLayerType(), m_Config.hashPorts, fields))
+		{
+			return 0;
+		}
+
+		if (m_Config.hashFunction == HashFunction::Hash64)
+		{
+			uint16_t srcPort = fields.ports != nullptr ? readBE16(fields.ports) : 0;
+			uint16_t dstPort = fields.ports != nullptr ? readBE16(fields.ports + 2) : 0;
+			uint8_t protocol = fields.ports != nullptr ? fields.protocol : 0;
+			return hash5Tuple64(fields.srcIP, fields.dstIP, fields.ipLen, srcPort, dstPort, protocol);
+		}
+
+		// the input of the RSS hash: source and destination addresses followed by the ports, in network byte order
+		uint8_t input[36];
+		memcpy(input, fields.srcIP, fields.ipLen);
+		memcpy(input + fields.ipLen, fields.dstIP, fields.ipLen);
+		size_t inputLen = 2 * fields.ipLen;
+		if (fields.ports != nullptr)
+		{
+			memcpy(input + inputLen, fields.ports, 4);
+			inputLen += 4;
+		}
+
+		return m_ToeplitzHash.hash(input, inputLen);
+	}
+
+	bool RssDispatcher::push(Worker& worker, const RawPacket& rawPacket)
+	{
+		// the cached head is refreshed only when the ring looks full, so the producer rarely reads the worker's
+		// cache line
+		if (worker.pendingTail - worker.cachedHead == worker.slots.size())
+		{
+			worker.cachedHead = worker.head.load(std::memory_order_acquire);
+			if (worker.pendingTail - worker.cachedHead == worker.slots.size())
+			{
+				if (m_Config.backpressure == BackpressurePolicy::Drop)
+				{
+					worker.ringDrops.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+
+				// the worker can only free slots it was given
+				publish(worker);
+				do
+				{
+					std::this_thread::yield();
+					worker.cachedHead = worker.head.load(std::memory_order_acquire);
+				} while (worker.pendingTail - worker.cachedHead == worker.slots.size());
+			}
+		}
+
+		Worker::Slot& slot = worker.slots[worker.pendingTail & worker.mask];
+		const uint8_t* data = rawPacket.getRawData();
+		slot.data.assign(data, data + rawPacket.getRawDataLen());
+		slot.timestamp = rawPacket.getPacketTimeStamp();
+		slot.linkType = rawPacket.getLinkLayerType();
+		slot.frameLength = rawPacket.getFrameLength();
+		worker.pendingTail++;
+		worker.dispatchedPackets.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	void RssDispatcher::publish(Worker& worker)
+	{
+		if (worker.tail.load(std::memory_order_relaxed) != worker.pendingTail)
+			worker.tail.store(worker.pendingTail, std::memory_order_release);
+	}
+
+	bool RssDispatcher::dispatch(const RawPacket& rawPacket)
+	{
+		if (!m_Running)
+			return false;
+
+		Worker& worker = *m_Workers[getWorkerId(rawPacket)];
+		bool queued = push(worker, rawPacket);
+		publish(worker);
+		return queued;
+	}
+
+	size_t RssDispatcher::dispatch(const RawPacket* const* rawPackets, size_t count)
+	{
+		if (!m_Running)
+			return 0;
+
+		size_t queued = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			if (push(*m_Workers[getWorkerId(*rawPackets[i])], *rawPackets[i]))
+				queued++;
+		}
+
+		for (auto& worker : m_Workers)
+		{
+			publish(*worker);
+		}
+
+		return queued;
+	}
+
+	size_t RssDispatcher::dispatch(const RawPacketVector& rawPackets)
+	{
+		if (rawPackets.size() == 0)
+			return 0;
+
+		return dispatch(&*rawPackets.begin(), rawPackets.size());
+	}
+
+	size_t RssDispatcher::dispatchFromReader(IFileReaderDevice& reader, size_t batchSize)
+	{
+		if (!m_Running || batchSize == 0)
+			return 0;
+
+		// the raw packets are reused for all batches
+		std::vector<RawPacket> batch(batchSize);
+		std::vector<const RawPacket*> batchPointers(batchSize);
+		for (size_t i = 0; i < batchSize; i++)
+		{
+			batchPointers[i] = &batch[i];
+		}
+
+		size_t queued = 0;
+		size_t numOfPacketsRead;
+		do
+		{
+			numOfPacketsRead = 0;
+			while (numOfPacketsRead < batchSize && reader.getNextPacket(batch[numOfPacketsRead]))
+			{
+				numOfPacketsRead++;
+			}
+
+			queued += dispatch(batchPointers.data(), numOfPacketsRead);
+		} while (numOfPacketsRead == batchSize);
+
+		return queued;
+	}
+
+	void RssDispatcher::onPacketArrives(RawPacket* rawPacket, PcapLiveDevice* /*device*/, void* userCookie)
+	{
+		static_cast<RssDispatcher*>(userCookie)->dispatch(*rawPacket);
+	}
+
+	void RssDispatcher::runWorker(Worker& worker)
+	{
+		RawPacket rawPacket(nullptr, 0, timespec{ 0, 0 }, false);
+		size_t idleRounds = 0;
+
+		while (true)
+		{
+			size_t head = worker.head.load(std::memory_order_relaxed);
+			size_t tail = worker.tail.load(std::memory_order_acquire);
+			if (head == tail)
+			{
+				if (m_Stop.load(std::memory_order_acquire))
+				{
+					// the last packets were published before the stop flag was set
+					if (head == worker.tail.load(std::memory_order_acquire))
+						break;
+					continue;
+				}
+
+				// the producer doesn't wake the workers up, so an idle worker polls its ring, first by yielding and
+				// then by sleeping to leave the CPU to others
+				if (++idleRounds < 64)
+					std::this_thread::yield();
+				else
+					std::this_thread::sleep_for(std::chrono::microseconds(50));
+				continue;
+			}
+
+			idleRounds = 0;
+			size_t count = tail - head;
+			if (count > m_Config.burstSize)
+				count = m_Config.burstSize;
+
+			for (size_t i = 0; i < count; i++)
+			{
+				Worker::Slot& slot = worker.slots[(head + i) & worker.mask];
+				rawPacket.setRawData(slot.data.data(), static_cast<int>(slot.data.size()), slot.timestamp,
+				                     slot.linkType, slot.frameLength);
+				m_OnPacket(rawPacket, worker.id, m_UserCookie);
+			}
+
+			worker.head.store(head + count, std::memory_order_release);
+			worker.processedPackets.fetch_add(count, std::memory_order_relaxed);
+		}
+	}
+
+	void RssDispatcher::getStatistics(DispatcherStats& stats) const
+	{
+		stats.dispatchedPackets = 0;
+		stats.ringDrops = 0;
+		stats.processedPackets = 0;
+		for (size_t i = 0; i < m_Workers.size(); i++)
+		{
+			DispatcherStats workerStats;
+			getWorkerStatistics(i, workerStats);
+			stats.dispatchedPackets += workerStats.dispatchedPackets;
+			stats.ringDrops += workerStats.ringDrops;
+			stats.processedPackets += workerStats.processedPackets;
+		}
+	}
+
+	void RssDispatcher::getWorkerStatistics(size_t workerId, DispatcherStats& stats) const
+	{
+		if (workerId >= m_Workers.size())
+		{
+			stats.dispatchedPackets = 0;
+			stats.ringDrops = 0;
+			stats.processedPackets = 0;
+			return;
+		}
+
+		const Worker& worker = *m_Workers[workerId];
+		stats.dispatchedPackets = worker.dispatchedPackets.load(std::memory_order_relaxed);
+		stats.ringDrops = worker.ringDrops.load(std::memory_order_relaxed);
+		stats.processedPackets = worker.processedPackets.load(std::memory_order_relaxed);
+	}
+
+}  // namespace pcpp
@@ -0,0 +1,586 @@
+#define LOG_MODULE PcapLogModuleFileDevice
+
+#include "ZstdFrameStream.h"
+#include "Logger.h"
+#include "EndianPortable.h"
+#include <algorithm>
+#include <cstring>
+#include <zstd.h>
+
+namespace pcpp
+{
+	namespace internal
+	{
+		// zstd seekable format: the seek table is stored in a skippable frame at the end of the file
+		static const uint32_t SKIPPABLE_FRAME_MAGIC = 0x184D2A5E;
+		static const uint32_t SEEKABLE_MAGIC = 0x8F92EAB1;
+		static const size_t SKIPPABLE_HEADER_SIZE = 8;
+		static const size_t SEEK_TABLE_FOOTER_SIZE = 9;
+		static const uint8_t SEEK_TABLE_CHECKSUM_FLAG = 0x80;
+		static const uint8_t SEEK_TABLE_RESERVED_BITS = 0x7C;
+
+		static const uint32_t PCAPNG_SECTION_HEADER_BLOCK = 0x0A0D0D0A;
+		static const uint32_t PCAPNG_INTERFACE_BLOCK = 0x00000001;
+		// block type, block total length (twice)
+		static const uint32_t PCAPNG_MIN_BLOCK_SIZE = 12;
+
+		static uint32_t readLE32(const uint8_t* data)
+		{
+			uint32_t value;
+			memcpy(&value, data, sizeof(value));
+			return le32toh(value);
+		}
+
+		static void appendLE32(std::vector<uint8_t>& buffer, uint32_t value)
+		{
+			value = htole32(value);
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+			buffer.insert(buffer.end(), bytes, bytes + sizeof(value));
+		}
+
+		static int seekFile(FILE* file, int64_t offset, int origin)
+		{
+#if defined(_WIN32)
+			return _fseeki64(file, offset, origin);
+#else
+			return fseeko(file, static_cast<off_t>(offset), origin);
+#endif
+		}
+
+		static int64_t tellFile(FILE* file)
+		{
+#if defined(_WIN32)
+			return _ftelli64(file);
+#else
+			return static_cast<int64_t>(ftello(file));
+#endif
+		}
+
+		// ~~~~~~~~~~~~~~~~~~~~~
+		// ZstdFramePool members
+		// ~~~~~~~~~~~~~~~~~~~~~
+
+		ZstdFramePool::ZstdFramePool(Mode mode, int compressionLevel, int numOfThreads)
+		    : m_Mode(mode), m_CompressionLevel(compressionLevel), m_NextSeq(0), m_NextToReturn(0), m_Stop(false)
+		{
+			if (numOfThreads < 1)
+				numOfThreads = 1;
+
+			for (int i = 0; i < numOfThreads; i++)
+				m_Workers.push_back(std::thread(&ZstdFramePool::workerMain, this));
+		}
+
+		ZstdFramePool::~ZstdFramePool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Stop = true;
+				m_Jobs.clear();
+			}
+			m_JobsCond.notify_all();
+
+			for (std::vector<std::thread>::iterator iter = m_Workers.begin(); iter != m_Workers.end(); iter++)
+				iter->join();
+		}
+
+		void ZstdFramePool::submit(std::vector<uint8_t>&& input, size_t decompressedSize)
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				Job job;
+				job.seq = m_NextSeq++;
+				job.input = std::move(input);
+				job.decompressedSize = decompressedSize;
+				m_Jobs.push_back(std::move(job));
+			}
+			m_JobsCond.notify_one();
+		}
+
+		bool ZstdFramePool::getNext(Frame& frame, bool wait)
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			if (m_NextToReturn == m_NextSeq)
+				return false;
+
+			std::map<uint64_t, Frame>::iterator iter = m_Done.find(m_NextToReturn);
+			if (iter == m_Done.end())
+			{
+				if (!wait)
+					return false;
+
+				m_DoneCond.wait(lock, [this] { return m_Done.find(m_NextToReturn) != m_Done.end(); });
+				iter = m_Done.find(m_NextToReturn);
+			}
+
+			frame = std::move(iter->second);
+			m_Done.erase(iter);
+			m_NextToReturn++;
+			return true;
+		}
+
+		size_t ZstdFramePool::getNumOfFramesInFlight() const
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			return static_cast<size_t>(m_NextSeq - m_NextToReturn);
+		}
+
+		void ZstdFramePool::discardAll()
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Jobs.clear();
+			m_Done.clear();
+			m_NextToReturn = m_NextSeq;
+		}
+
+		void ZstdFramePool::workerMain()
+		{
+			// every worker keeps its own context, contexts are expensive to create and can't be shared
+			ZSTD_CCtx* cctx = (m_Mode == Compress ? ZSTD_createCCtx() : nullptr);
+			ZSTD_DCtx* dctx = (m_Mode == Decompress ? ZSTD_createDCtx() : nullptr);
+
+			while (true)
+			{
+				Job job;
+				{
+					std::unique_lock<std::mutex> lock(m_Mutex);
+					m_JobsCond.wait(lock, [this] { return !m_Jobs.empty() || m_Stop; });
+					if (m_Stop)
+						break;
+
+					job = std::move(m_Jobs.front());
+					m_Jobs.pop_front();
+				}
+
+				Frame frame;
+				frame.inputSize = job.input.size();
+				size_t result;
+				if (m_Mode == Compress)
+				{
+					frame.data.resize(ZSTD_compressBound(job.input.size()));
+					result = ZSTD_compressCCtx(cctx, frame.data.data(), frame.data.size(), job.input.data(),
+					                           job.input.size(), m_CompressionLevel);
+					frame.success = !ZSTD_isError(result);
+				}
+				else
+				{
+					frame.data.resize(job.decompressedSize);
+					result = ZSTD_decompressDCtx(dctx, frame.data.data(), frame.data.size(), job.input.data(),
+					                             job.input.size());
+					frame.success = !ZSTD_isError(result) && result == job.decompressedSize;
+				}
+				frame.data.resize(frame.success ? result : 0);
+
+				{
+					std::lock_guard<std::mutex> lock(m_Mutex);
+					// frames submitted before the last discardAll() aren't expected anymore
+					if (job.seq >= m_NextToReturn)
+						m_Done[job.seq] = std::move(frame);
+				}
+				m_DoneCond.notify_all();
+			}
+
+			if (cctx != nullptr)
+				ZSTD_freeCCtx(cctx);
+			if (dctx != nullptr)
+				ZSTD_freeDCtx(dctx);
+		}
+
+		// ~~~~~~~~~~~~~~~~~~~~~~~
+		// ZstdFrameWriter members
+		// ~~~~~~~~~~~~~~~~~~~~~~~
+
+		ZstdFrameWriter::ZstdFrameWriter(int compressionLevel, int numOfThreads, uint32_t frameSize)
+		    : m_CompressionLevel(compressionLevel), m_NumOfThreads(std::max(numOfThreads, 1)), m_FrameSize(frameSize),
+		      m_File(nullptr), m_Error(false)
+		{}
+
+		ZstdFrameWriter::~ZstdFrameWriter()
+		{
+			close();
+		}
+
+		bool ZstdFrameWriter::open(const std::string& fileName)
+		{
+			m_File = fopen(fileName.c_str(), "wb");
+			if (m_File == nullptr)
+			{
+				PCPP_LOG_ERROR("Cannot open file '" << fileName << "' for writing");
+				return false;
+			}
+
+			m_Pool.reset(new ZstdFramePool(ZstdFramePool::Compress, m_CompressionLevel, m_NumOfThreads));
+			m_PendingFrame.clear();
+			m_PendingFrame.reserve(m_FrameSize);
+			m_SeekTable.clear();
+			m_Error = false;
+			return true;
+		}
+
+		bool ZstdFrameWriter::write(const void* data, size_t len)
+		{
+			if (m_File == nullptr || m_Error)
+				return false;
+
+			const uint8_t* bytes = static_cast<const uint8_t*>(data);
+			m_PendingFrame.insert(m_PendingFrame.end(), bytes, bytes + len);
+			if (m_PendingFrame.size() < m_FrameSize)
+				return true;
+
+			submitPendingFrame();
+			// bound the memory held by frames in flight: wait for the oldest frame if all workers are busy
+			return writeCompletedFrames(2 * static_cast<size_t>(m_NumOfThreads));
+		}
+
+		bool ZstdFrameWriter::flush()
+		{
+			if (m_File == nullptr)
+				return false;
+
+			submitPendingFrame();
+			if (!writeCompletedFrames(0))
+				return false;
+
+			return fflush(m_File) == 0;
+		}
+
+		bool ZstdFrameWriter::close()
+		{
+			if (m_File == nullptr)
+				return false;
+
+			bool result = flush();
+			m_Pool.reset();
+
+			if (result)
+			{
+				std::vector<uint8_t> seekTable;
+				uint32_t numOfFrames = static_cast<uint32_t>(m_SeekTable.size());
+				appendLE32(seekTable, SKIPPABLE_FRAME_MAGIC);
+				appendLE32(seekTable, numOfFrames * 8 + static_cast<uint32_t>(SEEK_TABLE_FOOTER_SIZE));
+				for (std::vector<std::pair<uint32_t, uint32_t>>::const_iterator iter = m_SeekTable.begin();
+				     iter != m_SeekTable.end(); iter++)
+				{
+					appendLE32(seekTable, iter->first);
+					appendLE32(seekTable, iter->second);
+				}
+				appendLE32(seekTable, numOfFrames);
+				// seek table descriptor: no checksums
+				seekTable.push_back(0);
+				appendLE32(seekTable, SEEKABLE_MAGIC);
+
+				result = (fwrite(seekTable.data(), 1, seekTable.size(), m_File) == seekTable.size());
+			}
+
+			if (fclose(m_File) != 0)
+				result = false;
+			m_File = nullptr;
+
+			if (!result)
+				PCPP_LOG_ERROR("Failed to complete compressed file");
+
+			return result;
+		}
+
+		void ZstdFrameWriter::submitPendingFrame()
+		{
+			if (m_PendingFrame.empty())
+				return;
+
+			m_Pool->submit(std::move(m_PendingFrame));
+			m_PendingFrame = std::vector<uint8_t>();
+			m_PendingFrame.reserve(m_FrameSize);
+		}
+
+		bool ZstdFrameWriter::writeCompletedFrames(size_t maxFramesInFlight)
+		{
+			ZstdFramePool::Frame frame;
+			while (m_Pool->getNext(frame, m_Pool->getNumOfFramesInFlight() > maxFramesInFlight))
+			{
+				if (!frame.success || fwrite(frame.data.data(), 1, frame.data.size(), m_File) != frame.data.size())
+				{
+					PCPP_LOG_ERROR("Failed to compress or write frame #" << m_SeekTable.size());
+					m_Error = true;
+					return false;
+				}
+
+				m_SeekTable.push_back(
+				    std::make_pair(static_cast<uint32_t>(frame.data.size()), static_cast<uint32_t>(frame.inputSize)));
+			}
+
+			return !m_Error;
+		}
+
+		// ~~~~~~~~~~~~~~~~~~~~~~~
+		// ZstdFrameReader members
+		// ~~~~~~~~~~~~~~~~~~~~~~~
+
+		ZstdFrameReader::ZstdFrameReader(int numOfThreads)
+		    : m_NumOfThreads(std::max(numOfThreads, 1)), m_File(nullptr), m_NextFrameToSubmit(0),
+		      m_NextFrameToConsume(0), m_FilePos(0), m_PrefixPos(0), m_CurrentPos(0), m_NumOfScannedFrames(0)
+		{}
+
+		ZstdFrameReader::~ZstdFrameReader()
+		{
+			close();
+		}
+
+		bool ZstdFrameReader::open(const std::string& fileName)
+		{
+			close();
+
+			m_File = fopen(fileName.c_str(), "rb");
+			if (m_File == nullptr)
+				return false;
+
+			uint8_t footer[SEEK_TABLE_FOOTER_SIZE];
+			int64_t fileSize = -1;
+			if (seekFile(m_File, 0, SEEK_END) == 0)
+				fileSize = tellFile(m_File);
+
+			if (fileSize < static_cast<int64_t>(SKIPPABLE_HEADER_SIZE + SEEK_TABLE_FOOTER_SIZE) ||
+			    seekFile(m_File, fileSize - SEEK_TABLE_FOOTER_SIZE, SEEK_SET) != 0 ||
+			    fread(footer, 1, sizeof(footer), m_File) != sizeof(footer) || readLE32(footer + 5) != SEEKABLE_MAGIC ||
+			    (footer[4] & SEEK_TABLE_RESERVED_BITS) != 0)
+			{
+				PCPP_LOG_DEBUG("File '" << fileName << "' doesn't have a zstd seek table");
+				close();
+				return false;
+			}
+
+			uint64_t numOfFrames = readLE32(footer);
+			uint64_t entrySize = ((footer[4] & SEEK_TABLE_CHECKSUM_FLAG) ? 12 : 8);
+			uint64_t tableSize = numOfFrames * entrySize;
+			uint64_t tableFrameSize = SKIPPABLE_HEADER_SIZE + tableSize + SEEK_TABLE_FOOTER_SIZE;
+			std::vector<uint8_t> table(SKIPPABLE_HEADER_SIZE + tableSize);
+			if (tableFrameSize > static_cast<uint64_t>(fileSize) ||
+			    seekFile(m_File, fileSize - static_cast<int64_t>(tableFrameSize), SEEK_SET) != 0 ||
+			    fread(table.data(), 1, table.size(), m_File) != table.size() ||
+			    readLE32(table.data()) != SKIPPABLE_FRAME_MAGIC ||
+			    readLE32(table.data() + 4) != tableSize + SEEK_TABLE_FOOTER_SIZE)
+			{
+				PCPP_LOG_ERROR("File '" << fileName << "' has a corrupted zstd seek table");
+				close();
+				return false;
+			}
+
+			uint64_t offset = 0;
+			for (uint64_t i = 0; i < numOfFrames; i++)
+			{
+				const uint8_t* entry = table.data() + SKIPPABLE_HEADER_SIZE + i * entrySize;
+				FrameInfo frameInfo;
+				frameInfo.offset = offset;
+				frameInfo.compressedSize = readLE32(entry);
+				frameInfo.decompressedSize = readLE32(entry + 4);
+				m_Frames.push_back(frameInfo);
+				offset += frameInfo.compressedSize;
+			}
+
+			if (offset + tableFrameSize != static_cast<uint64_t>(fileSize) || seekFile(m_File, 0, SEEK_SET) != 0)
+			{
+				PCPP_LOG_ERROR("Zstd seek table of file '" << fileName << "' doesn't match the file size");
+				close();
+				return false;
+			}
+
+			m_Pool.reset(new ZstdFramePool(ZstdFramePool::Decompress, 0, m_NumOfThreads));
+			return true;
+		}
+
+		void ZstdFrameReader::close()
+		{
+			m_Pool.reset();
+			if (m_File != nullptr)
+			{
+				fclose(m_File);
+				m_File = nullptr;
+			}
+
+			m_Frames.clear();
+			m_NextFrameToSubmit = 0;
+			m_NextFrameToConsume = 0;
+			m_FilePos = 0;
+			m_Prefix.clear();
+			m_PrefixPos = 0;
+			m_Current.clear();
+			m_CurrentPos = 0;
+			m_NumOfScannedFrames = 0;
+			m_Sections.clear();
+		}
+
+		size_t ZstdFrameReader::read(void* buf, size_t count)
+		{
+			if (m_File == nullptr)
+				return 0;
+
+			uint8_t* dest = static_cast<uint8_t*>(buf);
+			size_t bytesRead = 0;
+			while (bytesRead < count)
+			{
+				if (m_PrefixPos < m_Prefix.size())
+				{
+					size_t len = std::min(count - bytesRead, m_Prefix.size() - m_PrefixPos);
+					memcpy(dest + bytesRead, m_Prefix.data() + m_PrefixPos, len);
+					m_PrefixPos += len;
+					bytesRead += len;
+					continue;
+				}
+
+				if (m_CurrentPos < m_Current.size())
+				{
+					size_t len = std::min(count - bytesRead, m_Current.size() - m_CurrentPos);
+					memcpy(dest + bytesRead, m_Current.data() + m_CurrentPos, len);
+					m_CurrentPos += len;
+					bytesRead += len;
+					continue;
+				}
+
+				m_CurrentPos = 0;
+				if (!getNextFrame(m_Current))
+				{
+					m_Current.clear();
+					break;
+				}
+			}
+
+			return bytesRead;
+		}
+
+		bool ZstdFrameReader::seekToFrame(uint32_t frameIndex)
+		{
+			if (m_File == nullptr || frameIndex >= m_Frames.size())
+			{
+				PCPP_LOG_ERROR("Frame index " << frameIndex << " is out of range, file has " << m_Frames.size()
+				                              << " frames");
+				return false;
+			}
+
+			m_Pool->discardAll();
+			m_Prefix.clear();
+			m_PrefixPos = 0;
+			m_Current.clear();
+			m_CurrentPos = 0;
+
+			// interface blocks in frames which weren't read yet are needed to interpret the packets after the seek
+			m_NextFrameToSubmit = std::min(m_NumOfScannedFrames, frameIndex);
+			m_NextFrameToConsume = m_NextFrameToSubmit;
+			std::vector<uint8_t> frameData;
+			while (m_NextFrameToConsume <= frameIndex)
+			{
+				if (!getNextFrame(frameData))
+					return false;
+			}
+
+			// the frames following the requested frame are already in flight, keep them
+			m_Current = std::move(frameData);
+
+			// a frame that starts a new section needs no context from previous frames
+			if (m_Current.size() >= sizeof(uint32_t) && readLE32(m_Current.data()) == PCAPNG_SECTION_HEADER_BLOCK)
+				return true;
+
+			for (std::vector<Section>::const_reverse_iterator section = m_Sections.rbegin();
+			     section != m_Sections.rend(); section++)
+			{
+				if (section->firstFrame >= frameIndex)
+					continue;
+
+				m_Prefix = section->headerBlock;
+				for (std::vector<std::pair<uint32_t, std::vector<uint8_t>>>::const_iterator iter =
+				         section->interfaceBlocks.begin();
+				     iter != section->interfaceBlocks.end() && iter->first < frameIndex; iter++)
+				{
+					m_Prefix.insert(m_Prefix.end(), iter->second.begin(), iter->second.end());
+				}
+				break;
+			}
+
+			return true;
+		}
+
+		bool ZstdFrameReader::submitFrame(uint32_t frameIndex)
+		{
+			const FrameInfo& frameInfo = m_Frames[frameIndex];
+			if (m_FilePos != frameInfo.offset)
+			{
+				if (seekFile(m_File, static_cast<int64_t>(frameInfo.offset), SEEK_SET) != 0)
+					return false;
+				m_FilePos = frameInfo.offset;
+			}
+
+			std::vector<uint8_t> compressedFrame(frameInfo.compressedSize);
+			if (fread(compressedFrame.data(), 1, compressedFrame.size(), m_File) != compressedFrame.size())
+			{
+				PCPP_LOG_ERROR("Failed to read compressed frame #" << frameIndex);
+				return false;
+			}
+
+			m_FilePos += frameInfo.compressedSize;
+			m_Pool->submit(std::move(compressedFrame), frameInfo.decompressedSize);
+			return true;
+		}
+
+		bool ZstdFrameReader::getNextFrame(std::vector<uint8_t>& frameData)
+		{
+			// keep the workers busy decompressing the frames ahead of the reader
+			size_t maxFramesInFlight = 2 * static_cast<size_t>(m_NumOfThreads);
+			while (m_NextFrameToSubmit < m_Frames.size() && m_Pool->getNumOfFramesInFlight() < maxFramesInFlight)
+			{
+				if (!submitFrame(m_NextFrameToSubmit))
+					return false;
+				m_NextFrameToSubmit++;
+			}
+
+			ZstdFramePool::Frame frame;
+			if (!m_Pool->getNext(frame, true))
+				return false;
+
+			if (!frame.success)
+			{
+				PCPP_LOG_ERROR("Failed to decompress frame #" << m_NextFrameToConsume);
+				return false;
+			}
+
+			frameData = std::move(frame.data);
+			if (m_NextFrameToConsume == m_NumOfScannedFrames)
+			{
+				scanFrame(m_NextFrameToConsume, frameData);
+				m_NumOfScannedFrames++;
+			}
+
+			m_NextFrameToConsume++;
+			return true;
+		}
+
+		void ZstdFrameReader::scanFrame(uint32_t frameIndex, const std::vector<uint8_t>& frameData)
+		{
+			size_t offset = 0;
+			while (offset + PCAPNG_MIN_BLOCK_SIZE <= frameData.size())
+			{
+				uint32_t blockType = readLE32(frameData.data() + offset);
+				uint32_t blockLength = readLE32(frameData.data() + offset + 4);
+				if (blockLength < PCAPNG_MIN_BLOCK_SIZE || blockLength % 4 != 0 ||
+				    blockLength > frameData.size() - offset)
+				{
+					PCPP_LOG_DEBUG("Frame #" << frameIndex << " doesn't end at a pcapng block boundary");
+					return;
+				}
+
+				const uint8_t* block = frameData.data() + offset;
+				if (blockType == PCAPNG_SECTION_HEADER_BLOCK)
+				{
+					Section section;
+					section.firstFrame = frameIndex;
+					section.headerBlock.assign(block, block + blockLength);
+					m_Sections.push_back(section);
+				}
+				else if (blockType == PCAPNG_INTERFACE_BLOCK && !m_Sections.empty())
+				{
+					m_Sections.back().interfaceBlocks.push_back(
+					    std::make_pair(frameIndex, std::vector<uint8_t>(block, block + blockLength)));
+				}
+
+				offset += blockLength;
+			}
+		}
+
+	}  // namespace internal
+}  // namespace pcpp
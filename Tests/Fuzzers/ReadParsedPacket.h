@@ -7,6 +7,7 @@
 #include <DhcpLayer.h>
 #include <DhcpV6Layer.h>
 #include <DnsLayer.h>
+#include <DnsView.h>
 #include <IcmpLayer.h>
 #include <NtpLayer.h>
 #include <SSLLayer.h>
@@ -481,6 +482,21 @@ static void readParsedPacket(pcpp::Packet parsedPacket, pcpp::Layer* layer)
 	{
 		if (auto dnsLayer = dynamic_cast<pcpp::DnsLayer*>(layer))
 		{
+			pcpp::DnsView dnsView(*dnsLayer);
+			char name[pcpp::DnsView::NameBufferSize];
+			pcpp::DnsRecordView record;
+			for (size_t i = 0; dnsView.getRecord(i, record); i++)
+			{
+				size_t nameLength = 0;
+				if (dnsView.decodeName(record.nameOffset, name, sizeof(name), &nameLength))
+					dnsView.isNameEqual(record.nameOffset, name, nameLength);
+				dnsView.isNameEqual(record.nameOffset, "a.b.c.");
+				if (record.dataLength > 0)
+					dnsView.decodeName(record.dataOffset, name, sizeof(name));
+			}
+			dnsView.findRecord(pcpp::DnsQueryType, "a", false);
+			dnsView.findRecord(pcpp::DnsAnswerType, "a.b.c", true);
+
 			dnsLayer->addQuery("mail-attachment.googleusercontent.com", pcpp::DNS_TYPE_A, pcpp::DNS_CLASS_IN);
 			dnsLayer->removeQuery("a", true);
 			dnsLayer->removeQuery("mail-attachment.googleusercontent.com", false);
@@ -44,6 +44,26 @@ PTF_TEST_CASE(TcpChecksumMultiBuffer);
 PTF_TEST_CASE(PacketUtilsHash5TupleUdp);
 PTF_TEST_CASE(PacketUtilsHash5TupleTcp);
 PTF_TEST_CASE(PacketUtilsHash5TupleIPv6);
+PTF_TEST_CASE(PacketUtilsHash64);
+PTF_TEST_CASE(PacketUtilsToeplitzHash);
+
+// Implemented in FlowTableTests.cpp
+PTF_TEST_CASE(FlowKeyFromPacketTest);
+PTF_TEST_CASE(FiveTupleTest);
+PTF_TEST_CASE(FlowTableTest);
+
+// Implemented in FlowMeterTests.cpp
+PTF_TEST_CASE(FlowMeterTest);
+PTF_TEST_CASE(FlowExportIpfixTest);
+PTF_TEST_CASE(FlowExportFileTest);
+
+// Implemented in PacketTemplateTests.cpp
+PTF_TEST_CASE(PacketTemplateTest);
+PTF_TEST_CASE(PacketTemplateBatchTest);
+
+// Implemented in TunnelEncapsulationTests.cpp
+PTF_TEST_CASE(TunnelEncapsulationTest);
+PTF_TEST_CASE(TunnelEncapsulationBatchTest);
 
 // Implemented in PacketTests.cpp
 PTF_TEST_CASE(InsertDataToPacket);
@@ -59,6 +79,9 @@ PTF_TEST_CASE(ResizeLayerTest);
 PTF_TEST_CASE(PrintPacketAndLayersTest);
 PTF_TEST_CASE(ProtocolFamilyMembershipTest);
 PTF_TEST_CASE(PacketParseLayerLimitTest);
+PTF_TEST_CASE(PortDissectorTableTest);
+PTF_TEST_CASE(InstrumentationTest);
+PTF_TEST_CASE(PacketHeadroomTest);
 
 // Implemented in HttpTests.cpp
 PTF_TEST_CASE(HttpRequestParseMethodTest);
@@ -71,6 +94,8 @@ PTF_TEST_CASE(HttpResponseLayerParsingTest);
 PTF_TEST_CASE(HttpResponseLayerCreationTest);
 PTF_TEST_CASE(HttpResponseLayerEditTest);
 PTF_TEST_CASE(HttpMalformedResponseTest);
+PTF_TEST_CASE(HttpFieldLookupTest);
+PTF_TEST_CASE(HttpReassemblyTest);
 
 // Implemented in PPPoETests.cpp
 PTF_TEST_CASE(PPPoESessionLayerParsingTest);
@@ -87,6 +112,7 @@ PTF_TEST_CASE(DnsLayerRemoveResourceTest);
 PTF_TEST_CASE(DnsOverTcpParsingTest);
 PTF_TEST_CASE(DnsOverTcpCreationTest);
 PTF_TEST_CASE(DnsLayerAddDnsKeyTest);
+PTF_TEST_CASE(DnsViewTest);
 
 // Implemented in IcmpTests.cpp
 PTF_TEST_CASE(IcmpParsingTest);
@@ -132,6 +158,7 @@ PTF_TEST_CASE(TLS1_3ParsingTest);
 PTF_TEST_CASE(TLSCipherSuiteTest);
 PTF_TEST_CASE(ClientHelloTLSFingerprintTest);
 PTF_TEST_CASE(ServerHelloTLSFingerprintTest);
+PTF_TEST_CASE(TLSFingerprintScannerTest);
 
 // Implemented in IgmpTests.cpp
 PTF_TEST_CASE(IgmpParsingTest);
@@ -262,6 +289,8 @@ PTF_TEST_CASE(SmtpEditTests);
 // Implemented in Asn1Tests.cpp
 PTF_TEST_CASE(Asn1DecodingTest);
 PTF_TEST_CASE(Asn1EncodingTest);
+PTF_TEST_CASE(Asn1ReaderTest);
+PTF_TEST_CASE(Asn1WriterTest);
 
 // Implemented in LdapTests.cpp
 PTF_TEST_CASE(LdapParsingTest);
@@ -3,6 +3,7 @@
 #include "RawPacket.h"
 #include "GeneralUtils.h"
 #include <functional>
+#include <memory>
 #include <cstring>
 #include <sstream>
 
@@ -689,3 +690,314 @@ PTF_TEST_CASE(Asn1EncodingTest)
 		PTF_ASSERT_BUF_COMPARE(encodedValue.data(), data, dataLen);
 	}
 }  // Asn1EncodingTest
+
+PTF_TEST_CASE(Asn1ReaderTest)
+{
+	// Nested elements
+	{
+		// SEQUENCE { INTEGER 1000, [APPLICATION 3] { OCTET STRING "abcd", BOOLEAN true }, NULL }
+		uint8_t data[30];
+		auto dataLen = pcpp::hexStringToByteArray("3011020203e863090404616263640101ff0500", data, 30);
+
+		pcpp::Asn1Reader reader(data, dataLen);
+		PTF_ASSERT_EQUAL(reader.next(), pcpp::Asn1Reader::Event::Element, enumclass);
+		auto element = reader.getElement();
+		PTF_ASSERT_TRUE(element.hasTag(pcpp::Asn1UniversalTagType::Sequence, true));
+		PTF_ASSERT_EQUAL(element.depth, 0);
+		PTF_ASSERT_EQUAL(element.offset, 0);
+		PTF_ASSERT_EQUAL(element.headerLength, 2);
+		PTF_ASSERT_EQUAL(element.valueLength, 17);
+		PTF_ASSERT_EQUAL(reader.getDepth(), 1);
+
+		PTF_ASSERT_EQUAL(reader.next(), pcpp::Asn1Reader::Event::Element, enumclass);
+		element = reader.getElement();
+		PTF_ASSERT_TRUE(element.hasTag(pcpp::Asn1UniversalTagType::Integer, false));
+		PTF_ASSERT_EQUAL(element.depth, 1);
+		PTF_ASSERT_EQUAL(element.offset, 2);
+		uint32_t intValue;
+		PTF_ASSERT_TRUE(element.getIntegerValue(intValue));
+		PTF_ASSERT_EQUAL(intValue, 1000);
+		bool boolValue;
+		PTF_ASSERT_FALSE(element.getBooleanValue(boolValue));
+
+		PTF_ASSERT_EQUAL(reader.next(), pcpp::Asn1Reader::Event::Element, enumclass);
+		element = reader.getElement();
+		PTF_ASSERT_TRUE(element.hasTag(pcpp::Asn1TagClass::Application, true, 3));
+		PTF_ASSERT_EQUAL(element.getUniversalTagType(), pcpp::Asn1UniversalTagType::NotApplicable, enumclass);
+		PTF_ASSERT_EQUAL(element.getTotalLength(), 11);
+		pcpp::Asn1Element subElement;
+		PTF_ASSERT_TRUE(element.getSubElement(1, subElement));
+		PTF_ASSERT_TRUE(subElement.hasTag(pcpp::Asn1UniversalTagType::Boolean, false));
+		PTF_ASSERT_FALSE(element.getSubElement(2, subElement));
+
+		PTF_ASSERT_EQUAL(reader.next(), pcpp::Asn1Reader::Event::Element, enumclass);
+		element = reader.getElement();
+		PTF_ASSERT_TRUE(element.hasTag(pcpp::Asn1UniversalTagType::OctetString, false));
+		PTF_ASSERT_EQUAL(element.depth, 2);
+		PTF_ASSERT_EQUAL(std::string(reinterpret_cast<const char*>(element.value), element.valueLength), "abcd");
+		PTF_ASSERT_TRUE(element.value == data + 10);
+
+		PTF_ASSERT_EQUAL(reader.next(), pcpp::Asn1Reader::Event::Element, enumclass);
+		PTF_ASSERT_TRUE(reader.getElement().getBooleanValue(boolValue));
+		PTF_ASSERT_TRUE(boolValue);
+
+		PTF_ASSERT_EQUAL(reader.next(), pcpp::Asn1Reader::Event::EndOfConstructed, enumclass);
+		PTF_ASSERT_EQUAL(reader.getDepth(), 1);
+
+		PTF_ASSERT_EQUAL(reader.next(), pcpp::Asn1Reader::Event::Element, enumclass);
+		PTF_ASSERT_TRUE(reader.getElement().hasTag(pcpp::Asn1UniversalTagType::Null, false));
+		PTF_ASSERT_EQUAL(reader.getElement().valueLength, 0);
+
+		PTF_ASSERT_EQUAL(reader.next(), pcpp::Asn1Reader::Event::EndOfConstructed, enumclass);
+		PTF_ASSERT_EQUAL(reader.getDepth(), 0);
+		PTF_ASSERT_EQUAL(reader.next(), pcpp::Asn1Reader::Event::EndOfData, enumclass);
+		PTF_ASSERT_EQUAL(reader.next(), pcpp::Asn1Reader::Event::EndOfData, enumclass);
+		PTF_ASSERT_FALSE(reader.hasError());
+		PTF_ASSERT_EQUAL(reader.getOffset(), dataLen);
+
+		// Skip the content of constructed elements
+		pcpp::Asn1Reader skipReader(data, dataLen);
+		PTF_ASSERT_FALSE(skipReader.skip());
+		PTF_ASSERT_EQUAL(skipReader.next(), pcpp::Asn1Reader::Event::Element, enumclass);
+		PTF_ASSERT_EQUAL(skipReader.next(), pcpp::Asn1Reader::Event::Element, enumclass);
+		PTF_ASSERT_TRUE(skipReader.skip());
+		PTF_ASSERT_EQUAL(skipReader.next(), pcpp::Asn1Reader::Event::Element, enumclass);
+		PTF_ASSERT_TRUE(skipReader.skip());
+		PTF_ASSERT_FALSE(skipReader.skip());
+		PTF_ASSERT_EQUAL(skipReader.getDepth(), 1);
+		PTF_ASSERT_EQUAL(skipReader.next(), pcpp::Asn1Reader::Event::Element, enumclass);
+		PTF_ASSERT_TRUE(skipReader.getElement().hasTag(pcpp::Asn1UniversalTagType::Null, false));
+		PTF_ASSERT_EQUAL(skipReader.next(), pcpp::Asn1Reader::Event::EndOfConstructed, enumclass);
+		PTF_ASSERT_EQUAL(skipReader.next(), pcpp::Asn1Reader::Event::EndOfData, enumclass);
+	}
+
+	// Long length and high tag number
+	{
+		std::string longValue(300, 'a');
+		std::vector<uint8_t> data = { 0x9f, 0x81, 0x00, 0x82, 0x01, 0x2c };
+		data.insert(data.end(), longValue.begin(), longValue.end());
+
+		pcpp::Asn1Element element;
+		PTF_ASSERT_TRUE(pcpp::Asn1Reader::readElement(data.data(), data.size(), element));
+		PTF_ASSERT_TRUE(element.hasTag(pcpp::Asn1TagClass::ContextSpecific, false, 128));
+		PTF_ASSERT_EQUAL(element.headerLength, 6);
+		PTF_ASSERT_EQUAL(element.valueLength, 300);
+		uint32_t intValue;
+		PTF_ASSERT_FALSE(element.getIntegerValue(intValue));
+
+		// Tag numbers above 255 aren't supported
+		data[1] = 0x82;
+		PTF_ASSERT_FALSE(pcpp::Asn1Reader::readElement(data.data(), data.size(), element));
+	}
+
+	// Malformed data
+	{
+		std::vector<std::string> malformedData = {
+			// Truncated header
+			"30",
+			// Truncated long length
+			"308201",
+			// Value longer than the data
+			"3005020101",
+			// Indefinite length
+			"3080020101",
+			// Child longer than its parent
+			"30030203010203",
+			// Truncated high tag number
+			"1f81",
+		};
+
+		for (const auto& hexData : malformedData)
+		{
+			uint8_t data[20];
+			auto dataLen = pcpp::hexStringToByteArray(hexData, data, 20);
+
+			pcpp::Asn1Reader reader(data, dataLen);
+			auto event = reader.next();
+			while (event == pcpp::Asn1Reader::Event::Element || event == pcpp::Asn1Reader::Event::EndOfConstructed)
+			{
+				event = reader.next();
+			}
+
+			PTF_ASSERT_EQUAL(event, pcpp::Asn1Reader::Event::Error, enumclass);
+			PTF_ASSERT_TRUE(reader.hasError());
+			PTF_ASSERT_EQUAL(reader.next(), pcpp::Asn1Reader::Event::Error, enumclass);
+		}
+	}
+
+	// Nesting deeper than the maximum depth
+	{
+		uint8_t data[2 * (pcpp::Asn1Reader::MaxDepth + 1)];
+		for (size_t i = 0; i <= pcpp::Asn1Reader::MaxDepth; i++)
+		{
+			data[2 * i] = 0x30;
+			data[2 * i + 1] = static_cast<uint8_t>(sizeof(data) - 2 * (i + 1));
+		}
+
+		pcpp::Asn1Reader reader(data, sizeof(data));
+		for (size_t i = 0; i < pcpp::Asn1Reader::MaxDepth; i++)
+		{
+			PTF_ASSERT_EQUAL(reader.next(), pcpp::Asn1Reader::Event::Element, enumclass);
+		}
+
+		PTF_ASSERT_EQUAL(reader.getDepth(), pcpp::Asn1Reader::MaxDepth);
+		PTF_ASSERT_EQUAL(reader.next(), pcpp::Asn1Reader::Event::Error, enumclass);
+	}
+}  // Asn1ReaderTest
+
+PTF_TEST_CASE(Asn1WriterTest)
+{
+	// Same encoding as Asn1Record
+	{
+		pcpp::Asn1IntegerRecord integerRecord(1000);
+		pcpp::Asn1EnumeratedRecord enumeratedRecord(0x10000);
+		pcpp::Asn1OctetStringRecord octetStringRecord("abcd");
+		pcpp::Asn1BooleanRecord booleanRecord(true);
+		pcpp::Asn1NullRecord nullRecord;
+		pcpp::Asn1SetRecord setRecord({ &octetStringRecord, &booleanRecord });
+		pcpp::Asn1ConstructedRecord applicationRecord(pcpp::Asn1TagClass::Application, 3,
+		                                              { &setRecord, &enumeratedRecord });
+		pcpp::Asn1SequenceRecord rootRecord({ &integerRecord, &applicationRecord, &nullRecord });
+
+		pcpp::Asn1Writer writer;
+		writer.beginSequence();
+		writer.writeInteger(1000);
+		writer.beginConstructed(pcpp::Asn1TagClass::Application, 3);
+		writer.beginSet();
+		writer.writeOctetString("abcd");
+		writer.writeBoolean(true);
+		writer.endConstructed();
+		writer.writeEnumerated(0x10000);
+		writer.endConstructed();
+		writer.writeNull();
+		PTF_ASSERT_EQUAL(writer.getDepth(), 1);
+		writer.endConstructed();
+		PTF_ASSERT_EQUAL(writer.getDepth(), 0);
+
+		auto expected = rootRecord.encode();
+		PTF_ASSERT_EQUAL(writer.getDataLen(), expected.size());
+		PTF_ASSERT_BUF_COMPARE(writer.getData(), expected.data(), expected.size());
+	}
+
+	// Back-patched long lengths
+	for (size_t valueLength : { 127, 128, 255, 256, 70000 })
+	{
+		std::string value(valueLength, 'b');
+		pcpp::Asn1OctetStringRecord octetStringRecord(value);
+		pcpp::Asn1SequenceRecord innerRecord({ &octetStringRecord });
+		pcpp::Asn1SequenceRecord rootRecord({ &innerRecord });
+
+		pcpp::Asn1Writer writer(16);
+		writer.beginSequence();
+		writer.beginSequence();
+		writer.writeOctetString(value);
+		writer.endConstructed();
+		writer.endConstructed();
+
+		auto expected = rootRecord.encode();
+		PTF_ASSERT_EQUAL(writer.getDataLen(), expected.size());
+		PTF_ASSERT_BUF_COMPARE(writer.getData(), expected.data(), expected.size());
+
+		// Round trip
+		pcpp::Asn1Reader reader(writer.getData(), writer.getDataLen());
+		PTF_ASSERT_EQUAL(reader.next(), pcpp::Asn1Reader::Event::Element, enumclass);
+		PTF_ASSERT_EQUAL(reader.next(), pcpp::Asn1Reader::Event::Element, enumclass);
+		PTF_ASSERT_EQUAL(reader.next(), pcpp::Asn1Reader::Event::Element, enumclass);
+		PTF_ASSERT_EQUAL(reader.getElement().valueLength, valueLength);
+		PTF_ASSERT_EQUAL(reader.next(), pcpp::Asn1Reader::Event::EndOfConstructed, enumclass);
+		PTF_ASSERT_EQUAL(reader.next(), pcpp::Asn1Reader::Event::EndOfConstructed, enumclass);
+		PTF_ASSERT_EQUAL(reader.next(), pcpp::Asn1Reader::Event::EndOfData, enumclass);
+	}
+
+	// Nested elements with long and short lengths and several top-level elements
+	{
+		std::string longValue(300, 'c');
+		pcpp::Asn1OctetStringRecord longRecord(longValue);
+		pcpp::Asn1IntegerRecord integerRecord(5);
+		std::vector<std::unique_ptr<pcpp::Asn1SequenceRecord>> nestedRecords;
+		nestedRecords.emplace_back(new pcpp::Asn1SequenceRecord({ &longRecord }));
+		for (int i = 0; i < 20; i++)
+		{
+			nestedRecords.emplace_back(
+			    new pcpp::Asn1SequenceRecord({ &integerRecord, nestedRecords.back().get(), &longRecord }));
+		}
+		pcpp::Asn1SequenceRecord shortRecord({ &integerRecord });
+		auto expected = nestedRecords.back()->encode();
+		auto expectedShort = shortRecord.encode();
+		expected.insert(expected.end(), expectedShort.begin(), expectedShort.end());
+
+		pcpp::Asn1Writer nestedWriter;
+		for (int i = 0; i < 20; i++)
+		{
+			nestedWriter.beginSequence();
+			nestedWriter.writeInteger(5);
+		}
+		nestedWriter.beginSequence();
+		nestedWriter.writeOctetString(longValue);
+		nestedWriter.endConstructed();
+		for (int i = 0; i < 20; i++)
+		{
+			nestedWriter.writeOctetString(longValue);
+			nestedWriter.endConstructed();
+		}
+		nestedWriter.beginSequence();
+		nestedWriter.writeInteger(5);
+		nestedWriter.endConstructed();
+
+		PTF_ASSERT_EQUAL(nestedWriter.getDepth(), 0);
+		PTF_ASSERT_EQUAL(nestedWriter.getDataLen(), expected.size());
+		PTF_ASSERT_BUF_COMPARE(nestedWriter.getData(), expected.data(), expected.size());
+	}
+
+	// High tag numbers
+	{
+		uint8_t value[] = { 0x01, 0x02, 0x03 };
+
+		pcpp::Asn1Writer writer;
+		writer.writePrimitive(pcpp::Asn1TagClass::ContextSpecific, 200, value, sizeof(value));
+
+		uint8_t expected[10];
+		auto expectedLen = pcpp::hexStringToByteArray("9f814803010203", expected, 10);
+		PTF_ASSERT_EQUAL(writer.getDataLen(), expectedLen);
+		PTF_ASSERT_BUF_COMPARE(writer.getData(), expected, expectedLen);
+
+		pcpp::Asn1Element element;
+		PTF_ASSERT_TRUE(pcpp::Asn1Reader::readElement(writer.getData(), writer.getDataLen(), element));
+		PTF_ASSERT_TRUE(element.hasTag(pcpp::Asn1TagClass::ContextSpecific, false, 200));
+		PTF_ASSERT_EQUAL(element.valueLength, sizeof(value));
+	}
+
+	// Pre-encoded records and clear
+	{
+		pcpp::Asn1IntegerRecord integerRecord(6);
+		auto encodedInteger = integerRecord.encode();
+
+		pcpp::Asn1Writer writer;
+		writer.beginSequence();
+		writer.writeEncoded(encodedInteger.data(), encodedInteger.size());
+		writer.endConstructed();
+
+		uint8_t expected[10];
+		auto expectedLen = pcpp::hexStringToByteArray("3003020106", expected, 10);
+		PTF_ASSERT_EQUAL(writer.getDataLen(), expectedLen);
+		PTF_ASSERT_BUF_COMPARE(writer.getData(), expected, expectedLen);
+
+		writer.clear();
+		PTF_ASSERT_EQUAL(writer.getDataLen(), 0);
+		PTF_ASSERT_EQUAL(writer.getDepth(), 0);
+	}
+
+	// Unbalanced constructed elements
+	{
+		pcpp::Asn1Writer writer;
+		PTF_ASSERT_RAISES(writer.endConstructed(), std::runtime_error,
+		                  "Cannot end ASN.1 constructed record, no record was begun");
+
+		for (size_t i = 0; i < pcpp::Asn1Writer::MaxDepth; i++)
+		{
+			writer.beginSequence();
+		}
+		PTF_ASSERT_RAISES(writer.beginSequence(), std::runtime_error,
+		                  "Cannot begin ASN.1 constructed record, too many nested records");
+	}
+}  // Asn1WriterTest
@@ -9,6 +9,7 @@
 #include "IPv6Layer.h"
 #include "UdpLayer.h"
 #include "DnsLayer.h"
+#include "DnsView.h"
 #include "SystemUtils.h"
 
 PTF_TEST_CASE(DnsLayerParsingTest)
@@ -745,3 +746,244 @@ PTF_TEST_CASE(DnsNXDomainTest)
 
 	PTF_ASSERT_EQUAL(1, dnsLayer->getDnsHeader()->queryOrResponse);
 }  // DnsNXDomainTest
+
+PTF_TEST_CASE(DnsViewTest)
+{
+	timeval time;
+	gettimeofday(&time, nullptr);
+
+	// the view returns the same records and names as DnsLayer
+
+	std::vector<std::string> dnsFiles = { "PacketExamples/Dns1.dat",
+		                                  "PacketExamples/Dns2.dat",
+		                                  "PacketExamples/Dns3.dat",
+		                                  "PacketExamples/Dns4.dat",
+		                                  "PacketExamples/DnsEdit1.dat",
+		                                  "PacketExamples/DnsEdit2.dat",
+		                                  "PacketExamples/DnsEdit3.dat",
+		                                  "PacketExamples/DnsEdit4.dat",
+		                                  "PacketExamples/DnsEdit5.dat",
+		                                  "PacketExamples/DnsEdit6.dat",
+		                                  "PacketExamples/DnsEdit7.dat",
+		                                  "PacketExamples/DNS_NXDomain.dat",
+		                                  "PacketExamples/dns_over_tcp_query.dat",
+		                                  "PacketExamples/dns_over_tcp_response.dat",
+		                                  "PacketExamples/dns_over_tcp_answer.dat",
+		                                  "PacketExamples/dns_over_tcp_answer2.dat" };
+
+	for (const auto& dnsFile : dnsFiles)
+	{
+		READ_FILE_AND_CREATE_PACKET(1, dnsFile.c_str());
+		pcpp::Packet dnsPacket(&rawPacket1);
+		pcpp::DnsLayer* dnsLayer = dnsPacket.getLayerOfType<pcpp::DnsLayer>();
+		PTF_ASSERT_NOT_NULL(dnsLayer);
+
+		pcpp::DnsView dnsView(*dnsLayer);
+		PTF_ASSERT_TRUE(dnsView.isValid());
+		PTF_ASSERT_EQUAL(dnsView.getQueryCount(), dnsLayer->getQueryCount());
+		PTF_ASSERT_EQUAL(dnsView.getAnswerCount(), dnsLayer->getAnswerCount());
+		PTF_ASSERT_EQUAL(dnsView.getAuthorityCount(), dnsLayer->getAuthorityCount());
+		PTF_ASSERT_EQUAL(dnsView.getAdditionalRecordCount(), dnsLayer->getAdditionalRecordCount());
+
+		std::vector<pcpp::IDnsResource*> resources;
+		for (pcpp::DnsQuery* query = dnsLayer->getFirstQuery(); query != nullptr;
+		     query = dnsLayer->getNextQuery(query))
+			resources.push_back(query);
+		for (pcpp::DnsResource* answer = dnsLayer->getFirstAnswer(); answer != nullptr;
+		     answer = dnsLayer->getNextAnswer(answer))
+			resources.push_back(answer);
+		for (pcpp::DnsResource* authority = dnsLayer->getFirstAuthority(); authority != nullptr;
+		     authority = dnsLayer->getNextAuthority(authority))
+			resources.push_back(authority);
+		for (pcpp::DnsResource* additional = dnsLayer->getFirstAdditionalRecord(); additional != nullptr;
+		     additional = dnsLayer->getNextAdditionalRecord(additional))
+			resources.push_back(additional);
+		PTF_ASSERT_EQUAL(dnsView.getRecordCount(), resources.size());
+
+		char name[pcpp::DnsView::NameBufferSize];
+		for (size_t i = 0; i < resources.size(); i++)
+		{
+			pcpp::DnsRecordView record;
+			PTF_ASSERT_TRUE(dnsView.getRecord(i, record));
+			PTF_ASSERT_EQUAL(record.resourceType, resources[i]->getType(), enum);
+			PTF_ASSERT_EQUAL(record.dnsType, resources[i]->getDnsType(), enum);
+			PTF_ASSERT_EQUAL(record.dnsClass, resources[i]->getDnsClass(), enum);
+			PTF_ASSERT_EQUAL(record.size, resources[i]->getSize());
+			PTF_ASSERT_TRUE(dnsView.decodeName(record.nameOffset, name, sizeof(name)));
+			PTF_ASSERT_EQUAL(std::string(name), resources[i]->getName());
+			PTF_ASSERT_TRUE(dnsView.isNameEqual(record.nameOffset, resources[i]->getName()));
+			if (record.resourceType != pcpp::DnsQueryType)
+			{
+				auto resource = static_cast<pcpp::DnsResource*>(resources[i]);
+				PTF_ASSERT_EQUAL(record.ttl, resource->getTTL());
+				PTF_ASSERT_EQUAL(record.dataLength, resource->getDataLength());
+			}
+		}
+
+		pcpp::DnsRecordView record;
+		PTF_ASSERT_FALSE(dnsView.getRecord(resources.size(), record));
+	}
+
+	READ_FILE_AND_CREATE_PACKET(2, "PacketExamples/dns_over_tcp_response.dat");
+	pcpp::Packet dnsOverTcpPacket(&rawPacket2);
+	pcpp::DnsOverTcpLayer* dnsOverTcpLayer = dnsOverTcpPacket.getLayerOfType<pcpp::DnsOverTcpLayer>();
+	PTF_ASSERT_NOT_NULL(dnsOverTcpLayer);
+	pcpp::DnsView dnsOverTcpView(*dnsOverTcpLayer);
+	PTF_ASSERT_EQUAL(dnsOverTcpView.getDataLen(), 1133);
+	PTF_ASSERT_EQUAL(dnsOverTcpView.findRecord(pcpp::DnsAuthorityType, "a1rt98bs5qgc9nfi51s9hci47uljg6jh.NET.", true),
+	                 2);
+	PTF_ASSERT_EQUAL(dnsOverTcpView.findRecord(pcpp::DnsAuthorityType, "qt8sce02", false), 4);
+	PTF_ASSERT_EQUAL(dnsOverTcpView.findRecord(pcpp::DnsAuthorityType, "www.net", false), -1);
+	PTF_ASSERT_EQUAL(dnsOverTcpView.findRecord(pcpp::DnsQueryType, "net", true), -1);
+
+	// compression pointers, the name cache and name comparisons
+
+	// clang-format off
+	uint8_t message[] = {
+		0x00, 0x01, 0x81, 0x80, 0x00, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,
+		// query: www.example.com, A, IN
+		3, 'w', 'w', 'w', 7, 'e', 'x', 'a', 'm', 'p', 'l', 'e', 3, 'c', 'o', 'm', 0, 0x00, 0x01, 0x00, 0x01,
+		// answer: pointer to www.example.com, A, IN, TTL 60, 1.2.3.4
+		0xc0, 0x0c, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x04, 1, 2, 3, 4,
+		// answer: pointer to www.example.com, CNAME, IN, TTL 60, mail + pointer to example.com
+		0xc0, 0x0c, 0x00, 0x05, 0x00, 0x01, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x07, 4, 'm', 'a', 'i', 'l', 0xc0, 0x10
+	};
+	// clang-format on
+
+	pcpp::DnsView dnsView(message, sizeof(message));
+	PTF_ASSERT_TRUE(dnsView.isValid());
+	PTF_ASSERT_EQUAL(dnsView.getRecordCount(), 3);
+
+	pcpp::DnsRecordView record;
+	char name[pcpp::DnsView::NameBufferSize];
+	size_t nameLength = 0;
+	PTF_ASSERT_TRUE(dnsView.getRecord(pcpp::DnsQueryType, 0, record));
+	PTF_ASSERT_EQUAL(record.nameOffset, 12);
+	PTF_ASSERT_EQUAL(record.size, 21);
+	PTF_ASSERT_NULL(record.data);
+	PTF_ASSERT_TRUE(dnsView.decodeName(record.nameOffset, name, sizeof(name), &nameLength));
+	PTF_ASSERT_EQUAL(std::string(name), "www.example.com");
+	PTF_ASSERT_EQUAL(nameLength, 15);
+
+	PTF_ASSERT_TRUE(dnsView.getRecord(pcpp::DnsAnswerType, 0, record));
+	PTF_ASSERT_EQUAL(record.dnsType, pcpp::DNS_TYPE_A, enum);
+	PTF_ASSERT_EQUAL(record.ttl, 60);
+	PTF_ASSERT_EQUAL(record.dataLength, 4);
+	PTF_ASSERT_EQUAL(record.data[3], 4);
+	PTF_ASSERT_TRUE(dnsView.decodeName(record.nameOffset, name, sizeof(name)));
+	PTF_ASSERT_EQUAL(std::string(name), "www.example.com");
+	PTF_ASSERT_EQUAL(dnsView.getNameCacheHitCount(), 0);
+	PTF_ASSERT_TRUE(dnsView.decodeName(record.nameOffset, name, sizeof(name)));
+	PTF_ASSERT_EQUAL(std::string(name), "www.example.com");
+	PTF_ASSERT_EQUAL(dnsView.getNameCacheHitCount(), 1);
+
+	PTF_ASSERT_TRUE(dnsView.isNameEqual(record.nameOffset, "WWW.Example.COM."));
+	PTF_ASSERT_TRUE(dnsView.isNameEqual(record.nameOffset, "www.example.com"));
+	PTF_ASSERT_EQUAL(dnsView.getNameCacheHitCount(), 3);
+	PTF_ASSERT_TRUE(dnsView.isNameEqual(12, "www.example.com"));
+	PTF_ASSERT_FALSE(dnsView.isNameEqual(12, "www.example.co"));
+	PTF_ASSERT_FALSE(dnsView.isNameEqual(12, "www.example.com.x"));
+	PTF_ASSERT_FALSE(dnsView.isNameEqual(12, "wwwexample.com"));
+	PTF_ASSERT_FALSE(dnsView.isNameEqual(12, ""));
+
+	PTF_ASSERT_TRUE(dnsView.getRecord(2, record));
+	PTF_ASSERT_EQUAL(record.resourceType, pcpp::DnsAnswerType, enum);
+	PTF_ASSERT_EQUAL(record.dnsType, pcpp::DNS_TYPE_CNAME, enum);
+	PTF_ASSERT_EQUAL(record.dataOffset, 61);
+	PTF_ASSERT_TRUE(dnsView.decodeName(record.dataOffset, name, sizeof(name), &nameLength));
+	PTF_ASSERT_EQUAL(std::string(name), "mail.example.com");
+	PTF_ASSERT_EQUAL(nameLength, 16);
+	PTF_ASSERT_TRUE(dnsView.isNameEqual(record.dataOffset, "mail.EXAMPLE.com"));
+	PTF_ASSERT_FALSE(dnsView.isNameEqual(record.dataOffset, "mail.example.org"));
+	PTF_ASSERT_FALSE(dnsView.isNameEqual(record.dataOffset, "mail"));
+
+	// the buffer must fit the name and its terminating null
+	PTF_ASSERT_FALSE(dnsView.decodeName(12, name, 15));
+	PTF_ASSERT_TRUE(dnsView.decodeName(12, name, 16));
+	PTF_ASSERT_FALSE(dnsView.decodeName(record.dataOffset, name, 16));
+	PTF_ASSERT_TRUE(dnsView.decodeName(record.dataOffset, name, 17));
+
+	PTF_ASSERT_EQUAL(dnsView.findRecord(pcpp::DnsAnswerType, "www.example.com", true), 0);
+	PTF_ASSERT_EQUAL(dnsView.findRecord(pcpp::DnsQueryType, "EXAMPLE", false), 0);
+	PTF_ASSERT_EQUAL(dnsView.findRecord(pcpp::DnsAnswerType, "example.org", false), -1);
+	PTF_ASSERT_EQUAL(dnsView.findRecord(pcpp::DnsAuthorityType, "www.example.com", true), -1);
+
+	// malformed messages
+
+	PTF_ASSERT_FALSE(pcpp::DnsView(message, 11).isValid());
+	PTF_ASSERT_FALSE(pcpp::DnsView(nullptr, 0).isValid());
+	PTF_ASSERT_EQUAL(pcpp::DnsView(message, 11).getRecordCount(), 0);
+
+	pcpp::DnsView truncatedView(message, sizeof(message) - 1);
+	PTF_ASSERT_TRUE(truncatedView.getRecord(1, record));
+	PTF_ASSERT_FALSE(truncatedView.getRecord(2, record));
+	PTF_ASSERT_FALSE(truncatedView.getRecord(2, record));
+	PTF_ASSERT_TRUE(truncatedView.getRecord(0, record));
+
+	// a name that ends in the middle of a label
+	PTF_ASSERT_FALSE(pcpp::DnsView(message, 20).decodeName(12, name, sizeof(name)));
+	PTF_ASSERT_FALSE(pcpp::DnsView(message, 20).getRecord(0, record));
+
+	uint8_t malformed[sizeof(message)];
+	memcpy(malformed, message, sizeof(message));
+	pcpp::DnsView malformedView(malformed, sizeof(malformed));
+
+	// a forward pointer
+	malformed[sizeof(malformed) - 1] = 0x40;
+	PTF_ASSERT_FALSE(malformedView.decodeName(61, name, sizeof(name)));
+	PTF_ASSERT_FALSE(malformedView.isNameEqual(61, "mail"));
+	// a pointer to itself
+	malformed[sizeof(malformed) - 1] = 66;
+	PTF_ASSERT_FALSE(malformedView.decodeName(61, name, sizeof(name)));
+	// a pointer into the header
+	malformed[sizeof(malformed) - 1] = 4;
+	PTF_ASSERT_FALSE(malformedView.decodeName(61, name, sizeof(name)));
+	// a pointer that is cut off
+	PTF_ASSERT_FALSE(pcpp::DnsView(malformed, sizeof(malformed) - 1).decodeName(61, name, sizeof(name)));
+	// an extended label type
+	malformed[61] = 0x44;
+	PTF_ASSERT_FALSE(malformedView.decodeName(61, name, sizeof(name)));
+	PTF_ASSERT_FALSE(malformedView.isNameEqual(61, "mail.example.com"));
+	// an offset outside the message
+	PTF_ASSERT_FALSE(malformedView.decodeName(sizeof(malformed), name, sizeof(name)));
+
+	// names longer than 255 bytes are rejected, whether or not they are compressed
+	uint8_t longName[12 + 3 * 64 + 1 + 64 + 2];
+	memset(longName, 'a', sizeof(longName));
+	memset(longName, 0, 12);
+	for (size_t i = 0; i < 3; i++)
+		longName[12 + i * 64] = 63;
+	longName[12 + 3 * 64] = 0;
+	longName[12 + 3 * 64 + 1] = 63;
+	longName[sizeof(longName) - 2] = 0xc0;
+	longName[sizeof(longName) - 1] = 12;
+	pcpp::DnsView longNameView(longName, sizeof(longName));
+	PTF_ASSERT_TRUE(longNameView.decodeName(12, name, sizeof(name), &nameLength));
+	PTF_ASSERT_EQUAL(nameLength, 63 * 3 + 2);
+	std::string longLabel(63, 'a');
+	PTF_ASSERT_TRUE(longNameView.isNameEqual(12, longLabel + "." + longLabel + "." + longLabel));
+	PTF_ASSERT_FALSE(longNameView.decodeName(12 + 3 * 64 + 1, name, sizeof(name)));
+	PTF_ASSERT_FALSE(longNameView.isNameEqual(12 + 3 * 64 + 1, std::string(63 * 4 + 3, 'a')));
+	longName[sizeof(longName) - 1] = 12 + 64;
+	PTF_ASSERT_TRUE(longNameView.decodeName(12 + 3 * 64 + 1, name, sizeof(name), &nameLength));
+	PTF_ASSERT_EQUAL(nameLength, 63 * 3 + 2);
+
+	// records beyond the inline index are reached by walking from the last indexed record
+	std::vector<uint8_t> manyQueries(12, 0);
+	manyQueries[5] = 40;
+	for (uint8_t i = 0; i < 40; i++)
+	{
+		std::vector<uint8_t> query = { 1, 'x', 0, 0x00, i, 0x00, 0x01 };
+		manyQueries.insert(manyQueries.end(), query.begin(), query.end());
+	}
+	pcpp::DnsView manyQueriesView(manyQueries.data(), manyQueries.size());
+	PTF_ASSERT_EQUAL(manyQueriesView.getQueryCount(), 40);
+	size_t indexes[] = { 39, 35, 0, 31, 32, 38, 33, 10 };
+	for (size_t index : indexes)
+	{
+		PTF_ASSERT_TRUE(manyQueriesView.getRecord(index, record));
+		PTF_ASSERT_EQUAL(record.recordOffset, 12 + index * 7);
+		PTF_ASSERT_EQUAL(record.dnsType, index);
+	}
+	PTF_ASSERT_FALSE(manyQueriesView.getRecord(40, record));
+}  // DnsViewTest
@@ -8,6 +8,7 @@
 #include "PayloadLayer.h"
 #include "Packet.h"
 #include "OUILookup.h"
+#include "Logger.h"
 #include "SystemUtils.h"
 
 PTF_TEST_CASE(OUILookup)
@@ -25,6 +26,51 @@ PTF_TEST_CASE(OUILookup)
 	PTF_ASSERT_EQUAL(lookupEngineJson.getVendorName("68:79:12:4f:ff:ff"), "McDonald's Corporation");
 	// Short
 	PTF_ASSERT_EQUAL(lookupEngineJson.getVendorName("00:08:55:01:01:01"), "NASA-Goddard Space Flight Center");
+	PTF_ASSERT_NULL(lookupEngineJson.findVendorName("aa:aa:aa:aa:aa:aa"));
+	PTF_ASSERT_EQUAL(std::string(lookupEngineJson.findVendorName("68:79:12:40:00:00")), "McDonald's Corporation");
+
+	pcpp::OUILookup lookupEngineBinary;
+	PTF_ASSERT_EQUAL(lookupEngineBinary.initOUIDatabaseFromBinary("../../3rdParty/OUIDataset/PCPP_OUIDataset.bin"),
+	                 lookupEngineJson.initOUIDatabaseFromJson("../../3rdParty/OUIDataset/PCPP_OUIDataset.json"));
+
+	PTF_ASSERT_EQUAL(lookupEngineBinary.getVendorName("aa:aa:aa:aa:aa:aa"), "Unknown");
+	PTF_ASSERT_NULL(lookupEngineBinary.findVendorName("aa:aa:aa:aa:aa:aa"));
+	// CIDR 36
+	PTF_ASSERT_EQUAL(lookupEngineBinary.getVendorName("70:B3:D5:2A:B0:00"), "NASA Johnson Space Center");
+	PTF_ASSERT_EQUAL(lookupEngineBinary.getVendorName("70:B3:D5:2A:BF:FF"), "NASA Johnson Space Center");
+	// CIDR 28
+	PTF_ASSERT_EQUAL(lookupEngineBinary.getVendorName("68:79:12:40:00:00"), "McDonald's Corporation");
+	PTF_ASSERT_EQUAL(lookupEngineBinary.getVendorName("68:79:12:4f:ff:ff"), "McDonald's Corporation");
+	// Short
+	PTF_ASSERT_EQUAL(lookupEngineBinary.getVendorName("00:08:55:01:01:01"), "NASA-Goddard Space Flight Center");
+	PTF_ASSERT_EQUAL(std::string(lookupEngineBinary.findVendorName("00:08:55:01:01:01")),
+	                 "NASA-Goddard Space Flight Center");
+
+	// Both databases return the same vendors, also for OUIs with masked entries
+	const uint8_t maskedOUIs[2][3] = {
+		{ 0x70, 0xb3, 0xd5 },
+		{ 0x68, 0x79, 0x12 }
+	};
+	for (uint32_t i = 0; i < 20000; ++i)
+	{
+		uint32_t value = i * 2654435761u;
+		uint8_t macBytes[6] = { static_cast<uint8_t>((value >> 24) & 0xfc), static_cast<uint8_t>(value >> 16),
+			                    static_cast<uint8_t>(value >> 8),           static_cast<uint8_t>(value),
+			                    static_cast<uint8_t>(value >> 4),           static_cast<uint8_t>(i) };
+		if (i % 4 < 2)
+			memcpy(macBytes, maskedOUIs[i % 4], 3);
+
+		pcpp::MacAddress macAddr(macBytes);
+		PTF_ASSERT_EQUAL(lookupEngineBinary.getVendorName(macAddr), lookupEngineJson.getVendorName(macAddr));
+	}
+
+	// Not a binary database
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_EQUAL(lookupEngineBinary.initOUIDatabaseFromBinary("../../3rdParty/OUIDataset/PCPP_OUIDataset.json"),
+	                 -1);
+	PTF_ASSERT_EQUAL(lookupEngineBinary.initOUIDatabaseFromBinary("nonexistent.bin"), -1);
+	pcpp::Logger::getInstance().enableLogs();
+	PTF_ASSERT_EQUAL(lookupEngineBinary.getVendorName("00:08:55:01:01:01"), "Unknown");
 }
 
 PTF_TEST_CASE(EthPacketCreation)
@@ -0,0 +1,437 @@
+#include "../TestDefinition.h"
+#include "EndianPortable.h"
+#include "Packet.h"
+#include "EthLayer.h"
+#include "IPv4Layer.h"
+#include "IPv6Layer.h"
+#include "TcpLayer.h"
+#include "UdpLayer.h"
+#include "PayloadLayer.h"
+#include "FlowMeter.h"
+#include "FlowExport.h"
+#include "Logger.h"
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+	class CollectingFlowSink : public pcpp::FlowRecordSink
+	{
+	public:
+		std::vector<pcpp::FlowRecord> records;
+		int numOfBatches;
+		int numOfFlushes;
+
+		CollectingFlowSink() : numOfBatches(0), numOfFlushes(0)
+		{}
+
+		bool exportRecords(const pcpp::FlowRecord* recordsToExport, size_t count) override
+		{
+			records.insert(records.end(), recordsToExport, recordsToExport + count);
+			numOfBatches++;
+			return true;
+		}
+
+		bool flush() override
+		{
+			numOfFlushes++;
+			return true;
+		}
+	};
+
+	enum TestTcpFlags
+	{
+		TestFin = 0x01,
+		TestSyn = 0x02,
+		TestRst = 0x04,
+		TestAck = 0x10
+	};
+
+	bool meterPacket(pcpp::FlowMeter& meter, const char* srcIP, const char* dstIP, uint16_t srcPort, uint16_t dstPort,
+	                 int tcpFlags, size_t payloadLen, time_t sec, long nsec = 0)
+	{
+		pcpp::Packet packet(100);
+		packet.addLayer(
+		    new pcpp::EthLayer(pcpp::MacAddress("aa:bb:cc:dd:ee:01"), pcpp::MacAddress("aa:bb:cc:dd:ee:02")), true);
+
+		pcpp::IPAddress src(srcIP);
+		pcpp::IPAddress dst(dstIP);
+		if (src.isIPv4())
+			packet.addLayer(new pcpp::IPv4Layer(src.getIPv4(), dst.getIPv4()), true);
+		else
+			packet.addLayer(new pcpp::IPv6Layer(src.getIPv6(), dst.getIPv6()), true);
+
+		if (tcpFlags >= 0)
+		{
+			pcpp::TcpLayer* tcpLayer = new pcpp::TcpLayer(srcPort, dstPort);
+			tcpLayer->getTcpHeader()->finFlag = (tcpFlags & TestFin) ? 1 : 0;
+			tcpLayer->getTcpHeader()->synFlag = (tcpFlags & TestSyn) ? 1 : 0;
+			tcpLayer->getTcpHeader()->rstFlag = (tcpFlags & TestRst) ? 1 : 0;
+			tcpLayer->getTcpHeader()->ackFlag = (tcpFlags & TestAck) ? 1 : 0;
+			packet.addLayer(tcpLayer, true);
+		}
+		else
+		{
+			packet.addLayer(new pcpp::UdpLayer(srcPort, dstPort), true);
+		}
+
+		if (payloadLen > 0)
+		{
+			std::vector<uint8_t> payload(payloadLen, 0x42);
+			packet.addLayer(new pcpp::PayloadLayer(payload.data(), payload.size()), true);
+		}
+
+		packet.computeCalculateFields();
+
+		timespec ts;
+		ts.tv_sec = sec;
+		ts.tv_nsec = nsec;
+		packet.getRawPacket()->setPacketTimeStamp(ts);
+
+		// meter the raw packet to also exercise the partial parsing
+		return meter.processPacket(packet.getRawPacket());
+	}
+
+	const int Udp = -1;
+
+	uint16_t readBE16(const uint8_t* data)
+	{
+		return static_cast<uint16_t>((data[0] << 8) | data[1]);
+	}
+
+	uint32_t readBE32(const uint8_t* data)
+	{
+		return (static_cast<uint32_t>(readBE16(data)) << 16) | readBE16(data + 2);
+	}
+
+	uint64_t readBE64(const uint8_t* data)
+	{
+		return (static_cast<uint64_t>(readBE32(data)) << 32) | readBE32(data + 4);
+	}
+
+	bool collectIpfixMessage(const uint8_t* message, size_t messageLen, void* userCookie)
+	{
+		static_cast<std::vector<std::vector<uint8_t>>*>(userCookie)->push_back(
+		    std::vector<uint8_t>(message, message + messageLen));
+		return true;
+	}
+}  // namespace
+
+PTF_TEST_CASE(FlowMeterTest)
+{
+	CollectingFlowSink sink;
+	pcpp::FlowMeter meter(&sink, pcpp::FlowMeter::FlowMeterConfig(100, 100, 60, 2));
+
+	// a TCP connection initiated by 10.0.0.2 which is endpoint 2 of the canonical key
+	PTF_ASSERT_TRUE(meterPacket(meter, "10.0.0.2", "10.0.0.1", 40000, 80, TestSyn, 0, 100));
+	PTF_ASSERT_TRUE(meterPacket(meter, "10.0.0.1", "10.0.0.2", 80, 40000, TestSyn | TestAck, 0, 100, 500000));
+	PTF_ASSERT_TRUE(meterPacket(meter, "10.0.0.2", "10.0.0.1", 40000, 80, TestAck, 100, 101));
+	PTF_ASSERT_TRUE(meterPacket(meter, "10.0.0.1", "10.0.0.2", 80, 40000, TestAck, 1000, 102));
+	PTF_ASSERT_TRUE(meterPacket(meter, "10.0.0.2", "10.0.0.1", 40000, 80, TestFin | TestAck, 0, 103));
+	PTF_ASSERT_TRUE(meterPacket(meter, "10.0.0.1", "10.0.0.2", 80, 40000, TestFin | TestAck, 0, 103));
+	PTF_ASSERT_TRUE(meterPacket(meter, "10.0.0.2", "10.0.0.1", 40000, 80, TestAck, 0, 103));
+	PTF_ASSERT_EQUAL(meter.getNumOfActiveFlows(), 1);
+	PTF_ASSERT_TRUE(sink.records.empty());
+
+	// a new SYN on the closed connection ends its record
+	PTF_ASSERT_TRUE(meterPacket(meter, "10.0.0.2", "10.0.0.1", 40000, 80, TestSyn, 0, 104));
+	PTF_ASSERT_EQUAL(meter.getNumOfActiveFlows(), 1);
+
+	// a UDP flow initiated by the lower endpoint
+	PTF_ASSERT_TRUE(meterPacket(meter, "10.0.0.1", "10.0.0.3", 5000, 53, Udp, 20, 104));
+	PTF_ASSERT_TRUE(meterPacket(meter, "10.0.0.3", "10.0.0.1", 53, 5000, Udp, 60, 104));
+
+	// an IPv6 flow that exceeds the active timeout
+	PTF_ASSERT_TRUE(meterPacket(meter, "2001:db8::1", "2001:db8::2", 1000, 2000, Udp, 0, 104));
+	PTF_ASSERT_TRUE(meterPacket(meter, "2001:db8::1", "2001:db8::2", 1000, 2000, Udp, 0, 110));
+	PTF_ASSERT_TRUE(meterPacket(meter, "2001:db8::1", "2001:db8::2", 1000, 2000, Udp, 0, 164));
+	PTF_ASSERT_EQUAL(meter.getNumOfActiveFlows(), 3);
+
+	// the batch size is 2, so both records were exported together
+	PTF_ASSERT_EQUAL(sink.records.size(), 2);
+	PTF_ASSERT_EQUAL(sink.numOfBatches, 1);
+
+	const pcpp::FlowRecord& tcpRecord = sink.records[0];
+	PTF_ASSERT_EQUAL(tcpRecord.endReason, pcpp::FlowEndOfFlowDetected, enum);
+	PTF_ASSERT_EQUAL(tcpRecord.key.protocol, 6);
+	PTF_ASSERT_TRUE(tcpRecord.isReversed);
+	PTF_ASSERT_EQUAL(tcpRecord.getSrcPort(), 40000);
+	PTF_ASSERT_EQUAL(tcpRecord.getDstPort(), 80);
+	PTF_ASSERT_EQUAL(pcpp::IPv4Address(tcpRecord.getSrcIP()), pcpp::IPv4Address("10.0.0.2"));
+	PTF_ASSERT_EQUAL(tcpRecord.packets[0], 4);
+	PTF_ASSERT_EQUAL(tcpRecord.packets[1], 3);
+	PTF_ASSERT_EQUAL(tcpRecord.bytes[0], 4 * 40 + 100);
+	PTF_ASSERT_EQUAL(tcpRecord.bytes[1], 3 * 40 + 1000);
+	PTF_ASSERT_EQUAL(tcpRecord.tcpFlags[0], TestSyn | TestAck | TestFin);
+	PTF_ASSERT_EQUAL(tcpRecord.tcpFlags[1], TestSyn | TestAck | TestFin);
+	PTF_ASSERT_EQUAL(tcpRecord.startTime, 100000000000ULL);
+	PTF_ASSERT_EQUAL(tcpRecord.endTime, 103000000000ULL);
+
+	const pcpp::FlowRecord& activeRecord = sink.records[1];
+	PTF_ASSERT_EQUAL(activeRecord.endReason, pcpp::FlowEndActiveTimeout, enum);
+	PTF_ASSERT_EQUAL(activeRecord.key.ipVersion, 6);
+	PTF_ASSERT_EQUAL(activeRecord.packets[0], 2);
+	PTF_ASSERT_EQUAL(activeRecord.packets[1], 0);
+	PTF_ASSERT_EQUAL(activeRecord.bytes[0], 2 * (40 + 8));
+
+	// the TCP and UDP flows become idle
+	timespec now;
+	now.tv_sec = 205;
+	now.tv_nsec = 0;
+	meter.advanceTime(now);
+	PTF_ASSERT_EQUAL(sink.records.size(), 4);
+	PTF_ASSERT_EQUAL(meter.getNumOfActiveFlows(), 1);
+
+	const pcpp::FlowRecord& newTcpRecord = sink.records[2];
+	PTF_ASSERT_EQUAL(newTcpRecord.endReason, pcpp::FlowEndIdleTimeout, enum);
+	PTF_ASSERT_EQUAL(newTcpRecord.packets[0], 1);
+	PTF_ASSERT_EQUAL(newTcpRecord.tcpFlags[0], TestSyn);
+
+	const pcpp::FlowRecord& udpRecord = sink.records[3];
+	PTF_ASSERT_EQUAL(udpRecord.key.protocol, 17);
+	PTF_ASSERT_FALSE(udpRecord.isReversed);
+	PTF_ASSERT_EQUAL(udpRecord.getSrcPort(), 5000);
+	PTF_ASSERT_EQUAL(udpRecord.bytes[0], 20 + 8 + 20);
+	PTF_ASSERT_EQUAL(udpRecord.bytes[1], 20 + 8 + 60);
+
+	// non-IP packets are ignored
+	pcpp::Packet ethPacket(100);
+	ethPacket.addLayer(
+	    new pcpp::EthLayer(pcpp::MacAddress("aa:bb:cc:dd:ee:01"), pcpp::MacAddress("aa:bb:cc:dd:ee:02")), true);
+	PTF_ASSERT_FALSE(meter.processPacket(ethPacket));
+
+	meter.flush();
+	PTF_ASSERT_EQUAL(sink.records.size(), 5);
+	PTF_ASSERT_EQUAL(sink.records[4].endReason, pcpp::FlowEndForcedEnd, enum);
+	PTF_ASSERT_EQUAL(sink.records[4].packets[0], 1);
+	PTF_ASSERT_EQUAL(sink.records[4].startTime, 164000000000ULL);
+	PTF_ASSERT_EQUAL(sink.numOfFlushes, 1);
+	PTF_ASSERT_EQUAL(meter.getNumOfActiveFlows(), 0);
+
+	const pcpp::FlowMeter::FlowMeterStats& stats = meter.getStatistics();
+	PTF_ASSERT_EQUAL(stats.packets, 14);
+	PTF_ASSERT_EQUAL(stats.nonIPPackets, 1);
+	PTF_ASSERT_EQUAL(stats.flows, 4);
+	PTF_ASSERT_EQUAL(stats.records, 5);
+	PTF_ASSERT_EQUAL(stats.exportErrors, 0);
+}  // FlowMeterTest
+
+PTF_TEST_CASE(FlowExportIpfixTest)
+{
+	std::vector<pcpp::FlowRecord> records;
+
+	pcpp::FlowRecord ipv4Record;
+	ipv4Record.key.ipVersion = 4;
+	ipv4Record.key.protocol = 6;
+	ipv4Record.key.ip1[0] = 10;
+	ipv4Record.key.ip1[3] = 1;
+	ipv4Record.key.ip2[0] = 10;
+	ipv4Record.key.ip2[3] = 2;
+	ipv4Record.key.port1 = 80;
+	ipv4Record.key.port2 = 40000;
+	ipv4Record.isReversed = true;
+	ipv4Record.endReason = pcpp::FlowEndIdleTimeout;
+	ipv4Record.tcpFlags[0] = 0x12;
+	ipv4Record.tcpFlags[1] = 0x11;
+	ipv4Record.startTime = 1000123456789ULL;
+	ipv4Record.endTime = 1002000000000ULL;
+	ipv4Record.packets[0] = 3;
+	ipv4Record.packets[1] = 5;
+	ipv4Record.bytes[0] = 300;
+	ipv4Record.bytes[1] = 5000;
+
+	pcpp::FlowRecord ipv6Record = ipv4Record;
+	ipv6Record.key.ipVersion = 6;
+	ipv6Record.key.ip1[15] = 1;
+	ipv6Record.key.ip2[15] = 2;
+	ipv6Record.endTime = 1003000000000ULL;
+
+	// 20 IPv4 records, then one IPv6 record
+	for (int i = 0; i < 20; i++)
+		records.push_back(ipv4Record);
+	records.push_back(ipv6Record);
+
+	std::vector<std::vector<uint8_t>> messages;
+	pcpp::IpfixEncoder encoder(collectIpfixMessage, &messages, 7, 512, 0);
+	PTF_ASSERT_TRUE(encoder.exportRecords(records.data(), records.size()));
+	PTF_ASSERT_EQUAL(encoder.getSequenceNumber(), 21);
+	PTF_ASSERT_GREATER_THAN(messages.size(), 1);
+
+	uint32_t expectedSequence = 0;
+	size_t numOfDataRecords = 0;
+	bool sawIPv6Set = false;
+	for (size_t msgIndex = 0; msgIndex < messages.size(); msgIndex++)
+	{
+		const std::vector<uint8_t>& msg = messages[msgIndex];
+		PTF_ASSERT_LOWER_OR_EQUAL_THAN(msg.size(), 512);
+		PTF_ASSERT_EQUAL(readBE16(msg.data()), 10);
+		PTF_ASSERT_EQUAL(readBE16(msg.data() + 2), msg.size());
+		PTF_ASSERT_EQUAL(readBE32(msg.data() + 8), expectedSequence);
+		PTF_ASSERT_EQUAL(readBE32(msg.data() + 12), 7);
+
+		size_t offset = 16;
+		while (offset < msg.size())
+		{
+			uint16_t setId = readBE16(msg.data() + offset);
+			uint16_t setLen = readBE16(msg.data() + offset + 2);
+			PTF_ASSERT_LOWER_OR_EQUAL_THAN(offset + setLen, msg.size());
+
+			if (setId == 2)
+			{
+				// templates are sent only in the first message
+				PTF_ASSERT_EQUAL(msgIndex, 0);
+				PTF_ASSERT_EQUAL(readBE16(msg.data() + offset + 4), IPFIX_IPV4_TEMPLATE_ID);
+				PTF_ASSERT_EQUAL(readBE16(msg.data() + offset + 6), 14);
+				// first field is sourceIPv4Address, 4 bytes
+				PTF_ASSERT_EQUAL(readBE16(msg.data() + offset + 8), 8);
+				PTF_ASSERT_EQUAL(readBE16(msg.data() + offset + 10), 4);
+				// 14 fields, 3 of them with an enterprise number
+				size_t templateLen = 4 + 14 * 4 + 3 * 4;
+				PTF_ASSERT_EQUAL(setLen, 4 + 2 * templateLen);
+				PTF_ASSERT_EQUAL(readBE16(msg.data() + offset + 4 + templateLen), IPFIX_IPV6_TEMPLATE_ID);
+				PTF_ASSERT_EQUAL(readBE16(msg.data() + offset + 4 + templateLen + 4), 27);
+				PTF_ASSERT_EQUAL(readBE16(msg.data() + offset + 4 + templateLen + 6), 16);
+			}
+			else if (setId == IPFIX_IPV4_TEMPLATE_ID)
+			{
+				PTF_ASSERT_EQUAL((setLen - 4) % 66, 0);
+				numOfDataRecords += (setLen - 4) / 66;
+
+				const uint8_t* rec = msg.data() + offset + 4;
+				// the initiator is endpoint 2
+				PTF_ASSERT_EQUAL(pcpp::IPv4Address(rec), pcpp::IPv4Address("10.0.0.2"));
+				PTF_ASSERT_EQUAL(pcpp::IPv4Address(rec + 4), pcpp::IPv4Address("10.0.0.1"));
+				PTF_ASSERT_EQUAL(readBE16(rec + 8), 40000);
+				PTF_ASSERT_EQUAL(readBE16(rec + 10), 80);
+				PTF_ASSERT_EQUAL(rec[12], 6);
+				PTF_ASSERT_EQUAL(readBE16(rec + 13), 0x12);
+				PTF_ASSERT_EQUAL(readBE16(rec + 15), 0x11);
+				PTF_ASSERT_EQUAL(readBE64(rec + 17), 1000123);
+				PTF_ASSERT_EQUAL(readBE64(rec + 25), 1002000);
+				PTF_ASSERT_EQUAL(readBE64(rec + 33), 300);
+				PTF_ASSERT_EQUAL(readBE64(rec + 41), 3);
+				PTF_ASSERT_EQUAL(readBE64(rec + 49), 5000);
+				PTF_ASSERT_EQUAL(readBE64(rec + 57), 5);
+				PTF_ASSERT_EQUAL(rec[65], pcpp::FlowEndIdleTimeout);
+			}
+			else
+			{
+				PTF_ASSERT_EQUAL(setId, IPFIX_IPV6_TEMPLATE_ID);
+				PTF_ASSERT_EQUAL(setLen, 4 + 90);
+				PTF_ASSERT_EQUAL(msg.data()[offset + 4 + 15], 2);
+				PTF_ASSERT_EQUAL(msg.data()[offset + 4 + 31], 1);
+				PTF_ASSERT_EQUAL(readBE32(msg.data() + 4), 1003);
+				numOfDataRecords++;
+				sawIPv6Set = true;
+			}
+
+			offset += setLen;
+		}
+		PTF_ASSERT_EQUAL(offset, msg.size());
+
+		// the sequence number counts the data records sent before each message
+		expectedSequence = static_cast<uint32_t>(numOfDataRecords);
+	}
+
+	PTF_ASSERT_EQUAL(numOfDataRecords, 21);
+	PTF_ASSERT_TRUE(sawIPv6Set);
+
+	// with a refresh interval of 1 the templates are sent in every message
+	messages.clear();
+	pcpp::IpfixEncoder refreshingEncoder(collectIpfixMessage, &messages, 0, 1400, 1);
+	PTF_ASSERT_TRUE(refreshingEncoder.exportRecords(records.data(), 1));
+	PTF_ASSERT_TRUE(refreshingEncoder.exportRecords(records.data(), 1));
+	PTF_ASSERT_EQUAL(messages.size(), 2);
+	PTF_ASSERT_EQUAL(readBE16(messages[1].data() + 16), 2);
+	PTF_ASSERT_EQUAL(readBE32(messages[1].data() + 8), 1);
+}  // FlowExportIpfixTest
+
+PTF_TEST_CASE(FlowExportFileTest)
+{
+	const char* fileName = "flow_records_test.pfr";
+
+	std::vector<pcpp::FlowRecord> records(3);
+	records[0].key.ipVersion = 4;
+	records[0].key.protocol = 17;
+	records[0].key.ip1[0] = 192;
+	records[0].key.ip2[0] = 193;
+	records[0].key.port1 = 53;
+	records[0].key.port2 = 33000;
+	records[0].isReversed = true;
+	records[0].endReason = pcpp::FlowEndIdleTimeout;
+	records[0].startTime = 1700000000123456789ULL;
+	records[0].endTime = 1700000005000000000ULL;
+	records[0].packets[0] = 1;
+	records[0].packets[1] = 1;
+	records[0].bytes[0] = 60;
+	records[0].bytes[1] = 300;
+
+	records[1] = records[0];
+	records[1].key.ipVersion = 6;
+	records[1].key.protocol = 6;
+	records[1].key.ip1[15] = 0xAB;
+	records[1].key.ip2[15] = 0xCD;
+	records[1].isReversed = false;
+	records[1].endReason = pcpp::FlowEndOfFlowDetected;
+	records[1].tcpFlags[0] = 0x1B;
+	records[1].tcpFlags[1] = 0x12;
+	records[1].packets[0] = 123456789012ULL;
+	records[1].bytes[1] = 0xFFFFFFFFFFFFFFFFULL;
+
+	records[2].key.ipVersion = 4;
+	records[2].endReason = pcpp::FlowEndForcedEnd;
+
+	{
+		pcpp::FlowRecordFileWriter writer(fileName);
+		PTF_ASSERT_FALSE(writer.isOpened());
+		PTF_ASSERT_TRUE(writer.open());
+		PTF_ASSERT_TRUE(writer.exportRecords(records.data(), 2));
+		PTF_ASSERT_TRUE(writer.exportRecords(records.data() + 2, 1));
+		PTF_ASSERT_TRUE(writer.flush());
+		writer.close();
+		PTF_ASSERT_FALSE(writer.isOpened());
+
+		pcpp::Logger::getInstance().suppressLogs();
+		PTF_ASSERT_FALSE(writer.exportRecords(records.data(), 1));
+		pcpp::Logger::getInstance().enableLogs();
+	}
+
+	FILE* file = fopen(fileName, "rb");
+	PTF_ASSERT_NOT_NULL(file);
+	fseek(file, 0, SEEK_END);
+	long fileSize = ftell(file);
+	fclose(file);
+	// header + a short IPv4 record of 25 bytes of fixed fields and 5 one-byte varints
+	PTF_ASSERT_LOWER_OR_EQUAL_THAN(fileSize, 8 + 40 + 90 + 30);
+
+	pcpp::FlowRecordFileReader reader(fileName);
+	PTF_ASSERT_TRUE(reader.open());
+	for (size_t i = 0; i < records.size(); i++)
+	{
+		pcpp::FlowRecord record;
+		PTF_ASSERT_TRUE(reader.getNextRecord(record));
+		PTF_ASSERT_TRUE(record.key == records[i].key);
+		PTF_ASSERT_EQUAL(record.isReversed, records[i].isReversed);
+		PTF_ASSERT_EQUAL(record.endReason, records[i].endReason, enum);
+		PTF_ASSERT_EQUAL(record.tcpFlags[0], records[i].tcpFlags[0]);
+		PTF_ASSERT_EQUAL(record.tcpFlags[1], records[i].tcpFlags[1]);
+		PTF_ASSERT_EQUAL(record.startTime, records[i].startTime);
+		PTF_ASSERT_EQUAL(record.endTime, records[i].endTime);
+		PTF_ASSERT_EQUAL(record.packets[0], records[i].packets[0]);
+		PTF_ASSERT_EQUAL(record.packets[1], records[i].packets[1]);
+		PTF_ASSERT_EQUAL(record.bytes[0], records[i].bytes[0]);
+		PTF_ASSERT_EQUAL(record.bytes[1], records[i].bytes[1]);
+	}
+
+	pcpp::FlowRecord record;
+	PTF_ASSERT_FALSE(reader.getNextRecord(record));
+	reader.close();
+
+	// not a flow record file
+	pcpp::FlowRecordFileReader badReader("PacketExamples/TcpPacketNoOptions.dat");
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(badReader.open());
+	pcpp::Logger::getInstance().enableLogs();
+
+	remove(fileName);
+}  // FlowExportFileTest
@@ -0,0 +1,381 @@
+#include "../TestDefinition.h"
+#include "Packet.h"
+#include "EthLayer.h"
+#include "IPv4Layer.h"
+#include "IPv6Layer.h"
+#include "TcpLayer.h"
+#include "UdpLayer.h"
+#include "IcmpLayer.h"
+#include "FlowTable.h"
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+	struct TestFlowState
+	{
+		int packets;
+		uint64_t bytes;
+
+		TestFlowState() : packets(0), bytes(0)
+		{}
+	};
+
+	struct EvictedFlow
+	{
+		pcpp::FlowKey key;
+		int packets;
+		pcpp::FlowEvictionReason reason;
+	};
+
+	void onTestFlowEvicted(const pcpp::FlowKey& key, TestFlowState& state, pcpp::FlowEvictionReason reason,
+	                       void* userCookie)
+	{
+		EvictedFlow evicted;
+		evicted.key = key;
+		evicted.packets = state.packets;
+		evicted.reason = reason;
+		static_cast<std::vector<EvictedFlow>*>(userCookie)->push_back(evicted);
+	}
+
+	pcpp::FlowKey makeFlowKey(uint32_t index)
+	{
+		pcpp::FlowKey key;
+		key.ipVersion = 4;
+		key.protocol = 17;
+		key.ip1[0] = 10;
+		key.ip1[1] = static_cast<uint8_t>(index >> 16);
+		key.ip1[2] = static_cast<uint8_t>(index >> 8);
+		key.ip1[3] = static_cast<uint8_t>(index);
+		key.ip2[0] = 192;
+		key.ip2[1] = 168;
+		key.port1 = 1000;
+		key.port2 = 53;
+		return key;
+	}
+
+	timespec makeTime(time_t sec)
+	{
+		timespec ts;
+		ts.tv_sec = sec;
+		ts.tv_nsec = 0;
+		return ts;
+	}
+}  // namespace
+
+PTF_TEST_CASE(FlowKeyFromPacketTest)
+{
+	pcpp::MacAddress srcMac("aa:bb:cc:dd:ee:01");
+	pcpp::MacAddress dstMac("aa:bb:cc:dd:ee:02");
+
+	// TCP over IPv4, both directions
+	pcpp::Packet clientToServer(100);
+	clientToServer.addLayer(new pcpp::EthLayer(srcMac, dstMac), true);
+	clientToServer.addLayer(new pcpp::IPv4Layer(pcpp::IPv4Address("192.168.1.10"), pcpp::IPv4Address("10.0.0.1")),
+	                        true);
+	clientToServer.addLayer(new pcpp::TcpLayer(51000, 80), true);
+	clientToServer.computeCalculateFields();
+
+	pcpp::Packet serverToClient(100);
+	serverToClient.addLayer(new pcpp::EthLayer(dstMac, srcMac), true);
+	serverToClient.addLayer(new pcpp::IPv4Layer(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("192.168.1.10")),
+	                        true);
+	serverToClient.addLayer(new pcpp::TcpLayer(80, 51000), true);
+	serverToClient.computeCalculateFields();
+
+	pcpp::FlowKey key1, key2;
+	bool reversed1 = true, reversed2 = false;
+	PTF_ASSERT_TRUE(key1.fromPacket(clientToServer, &reversed1));
+	PTF_ASSERT_TRUE(key2.fromPacket(serverToClient, &reversed2));
+	PTF_ASSERT_TRUE(key1 == key2);
+	PTF_ASSERT_EQUAL(key1.hash(), key2.hash());
+	PTF_ASSERT_TRUE(reversed1);
+	PTF_ASSERT_FALSE(reversed2);
+	PTF_ASSERT_EQUAL(key1.ipVersion, 4);
+	PTF_ASSERT_EQUAL(key1.protocol, 6);
+	PTF_ASSERT_EQUAL(key1.port1, 80);
+	PTF_ASSERT_EQUAL(key1.port2, 51000);
+	PTF_ASSERT_EQUAL(key1.toString(), "10.0.0.1:80 <-> 192.168.1.10:51000 proto 6");
+
+	// same endpoints with UDP is a different flow
+	pcpp::Packet udpPacket(100);
+	udpPacket.addLayer(new pcpp::EthLayer(srcMac, dstMac), true);
+	udpPacket.addLayer(new pcpp::IPv4Layer(pcpp::IPv4Address("192.168.1.10"), pcpp::IPv4Address("10.0.0.1")), true);
+	udpPacket.addLayer(new pcpp::UdpLayer(51000, 80), true);
+	udpPacket.computeCalculateFields();
+
+	pcpp::FlowKey udpKey;
+	PTF_ASSERT_TRUE(udpKey.fromPacket(udpPacket));
+	PTF_ASSERT_TRUE(udpKey != key1);
+	PTF_ASSERT_EQUAL(udpKey.protocol, 17);
+
+	// same IPs, ports are used to order the endpoints
+	pcpp::Packet sameIP1(100);
+	sameIP1.addLayer(new pcpp::IPv6Layer(pcpp::IPv6Address("fe80::1"), pcpp::IPv6Address("fe80::1")), true);
+	sameIP1.addLayer(new pcpp::UdpLayer(5000, 4000), true);
+	sameIP1.computeCalculateFields();
+
+	pcpp::Packet sameIP2(100);
+	sameIP2.addLayer(new pcpp::IPv6Layer(pcpp::IPv6Address("fe80::1"), pcpp::IPv6Address("fe80::1")), true);
+	sameIP2.addLayer(new pcpp::UdpLayer(4000, 5000), true);
+	sameIP2.computeCalculateFields();
+
+	PTF_ASSERT_TRUE(key1.fromPacket(sameIP1, &reversed1));
+	PTF_ASSERT_TRUE(key2.fromPacket(sameIP2, &reversed2));
+	PTF_ASSERT_TRUE(key1 == key2);
+	PTF_ASSERT_TRUE(reversed1);
+	PTF_ASSERT_FALSE(reversed2);
+	PTF_ASSERT_EQUAL(key1.ipVersion, 6);
+	PTF_ASSERT_EQUAL(key1.toString(), "[fe80::1]:4000 <-> [fe80::1]:5000 proto 17");
+
+	// no transport layer
+	pcpp::Packet icmpPacket(100);
+	icmpPacket.addLayer(new pcpp::IPv4Layer(pcpp::IPv4Address("1.1.1.1"), pcpp::IPv4Address("2.2.2.2")), true);
+	pcpp::IcmpLayer* icmpLayer = new pcpp::IcmpLayer();
+	icmpPacket.addLayer(icmpLayer, true);
+	icmpLayer->setEchoRequestData(1, 1, 0, nullptr, 0);
+	icmpPacket.computeCalculateFields();
+
+	pcpp::FlowKey icmpKey;
+	PTF_ASSERT_TRUE(icmpKey.fromPacket(icmpPacket));
+	PTF_ASSERT_EQUAL(icmpKey.protocol, 1);
+	PTF_ASSERT_EQUAL(icmpKey.port1, 0);
+	PTF_ASSERT_EQUAL(icmpKey.port2, 0);
+
+	// no IP layer
+	pcpp::Packet ethPacket(100);
+	ethPacket.addLayer(new pcpp::EthLayer(srcMac, dstMac), true);
+	pcpp::FlowKey ethKey;
+	PTF_ASSERT_FALSE(ethKey.fromPacket(ethPacket));
+	PTF_ASSERT_TRUE(ethKey == pcpp::FlowKey());
+
+	// allocation-free formatting
+	char keyBuffer[pcpp::FlowKey::MaxStringLength + 1];
+	PTF_ASSERT_EQUAL(key1.toString(keyBuffer, sizeof(keyBuffer)), key1.toString().size());
+	PTF_ASSERT_EQUAL(std::string(keyBuffer), "[fe80::1]:4000 <-> [fe80::1]:5000 proto 17");
+	PTF_ASSERT_EQUAL(key1.toString(keyBuffer, key1.toString().size()), 0);
+}  // FlowKeyFromPacketTest
+
+PTF_TEST_CASE(FiveTupleTest)
+{
+	pcpp::MacAddress srcMac("aa:bb:cc:dd:ee:01");
+	pcpp::MacAddress dstMac("aa:bb:cc:dd:ee:02");
+
+	pcpp::Packet clientToServer(100);
+	clientToServer.addLayer(new pcpp::EthLayer(srcMac, dstMac), true);
+	clientToServer.addLayer(new pcpp::IPv4Layer(pcpp::IPv4Address("192.168.1.10"), pcpp::IPv4Address("10.0.0.1")),
+	                        true);
+	clientToServer.addLayer(new pcpp::TcpLayer(51000, 80), true);
+	clientToServer.computeCalculateFields();
+
+	pcpp::Packet serverToClient(100);
+	serverToClient.addLayer(new pcpp::EthLayer(dstMac, srcMac), true);
+	serverToClient.addLayer(new pcpp::IPv4Layer(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("192.168.1.10")),
+	                        true);
+	serverToClient.addLayer(new pcpp::TcpLayer(80, 51000), true);
+	serverToClient.computeCalculateFields();
+
+	pcpp::FiveTuple tuple1, tuple2;
+	PTF_ASSERT_TRUE(tuple1.fromPacket(clientToServer));
+	PTF_ASSERT_TRUE(tuple2.fromPacket(serverToClient));
+	PTF_ASSERT_EQUAL(tuple1.ipVersion, 4);
+	PTF_ASSERT_EQUAL(tuple1.protocol, 6);
+	PTF_ASSERT_EQUAL(tuple1.srcPort, 51000);
+	PTF_ASSERT_EQUAL(tuple1.dstPort, 80);
+	PTF_ASSERT_EQUAL(tuple1.getSrcIPAddress(), pcpp::IPAddress("192.168.1.10"));
+	PTF_ASSERT_EQUAL(tuple1.getDstIPAddress(), pcpp::IPAddress("10.0.0.1"));
+	PTF_ASSERT_EQUAL(tuple1.toString(), "192.168.1.10:51000 -> 10.0.0.1:80 proto 6");
+
+	// the tuple is directional, the symmetric hash isn't
+	PTF_ASSERT_TRUE(tuple1 != tuple2);
+	PTF_ASSERT_TRUE(tuple1.reversed() == tuple2);
+	PTF_ASSERT_TRUE(tuple2.reversed().reversed() == tuple2);
+	PTF_ASSERT_NOT_EQUAL(tuple1.hash(), tuple2.hash());
+	PTF_ASSERT_EQUAL(tuple1.symmetricHash(), tuple2.symmetricHash());
+	PTF_ASSERT_EQUAL(tuple1.hash(), tuple2.reversed().hash());
+
+	pcpp::FiveTuple constructed(pcpp::IPv4Address("192.168.1.10"), pcpp::IPv4Address("10.0.0.1"), 51000, 80, 6);
+	PTF_ASSERT_TRUE(constructed == tuple1);
+	PTF_ASSERT_EQUAL(constructed.hash(), tuple1.hash());
+
+	// conversion to the bidirectional flow key
+	pcpp::FlowKey key;
+	PTF_ASSERT_TRUE(key.fromPacket(clientToServer));
+	bool reversed1 = false, reversed2 = true;
+	PTF_ASSERT_TRUE(tuple1.toFlowKey(&reversed1) == key);
+	PTF_ASSERT_TRUE(tuple2.toFlowKey(&reversed2) == key);
+	PTF_ASSERT_TRUE(reversed1);
+	PTF_ASSERT_FALSE(reversed2);
+
+	// IPv6 and allocation-free formatting
+	pcpp::FiveTuple ipv6Tuple(pcpp::IPv6Address("2001:db8::1"), pcpp::IPv6Address("2001:db8::2"), 5353, 53, 17);
+	PTF_ASSERT_EQUAL(ipv6Tuple.ipVersion, 6);
+	PTF_ASSERT_EQUAL(ipv6Tuple.getDstIPAddress(), pcpp::IPAddress("2001:db8::2"));
+	char tupleBuffer[pcpp::FiveTuple::MaxStringLength + 1];
+	PTF_ASSERT_EQUAL(ipv6Tuple.toString(tupleBuffer, sizeof(tupleBuffer)), 47);
+	PTF_ASSERT_EQUAL(std::string(tupleBuffer), "[2001:db8::1]:5353 -> [2001:db8::2]:53 proto 17");
+	PTF_ASSERT_EQUAL(ipv6Tuple.toString(tupleBuffer, 47), 0);
+	PTF_ASSERT_NOT_EQUAL(ipv6Tuple.hash(), ipv6Tuple.reversed().hash());
+	PTF_ASSERT_EQUAL(ipv6Tuple.symmetricHash(), ipv6Tuple.reversed().symmetricHash());
+
+	// usable as a key of unordered containers
+	std::unordered_set<pcpp::FiveTuple> tupleSet = { tuple1, tuple2, constructed, ipv6Tuple };
+	PTF_ASSERT_EQUAL(tupleSet.size(), 3);
+	std::unordered_set<pcpp::FlowKey> keySet = { tuple1.toFlowKey(), tuple2.toFlowKey(), ipv6Tuple.toFlowKey() };
+	PTF_ASSERT_EQUAL(keySet.size(), 2);
+
+	// no IP layer
+	pcpp::Packet ethPacket(100);
+	ethPacket.addLayer(new pcpp::EthLayer(srcMac, dstMac), true);
+	pcpp::FiveTuple ethTuple;
+	PTF_ASSERT_FALSE(ethTuple.fromPacket(ethPacket));
+	PTF_ASSERT_TRUE(ethTuple == pcpp::FiveTuple());
+}  // FiveTupleTest
+
+PTF_TEST_CASE(FlowTableTest)
+{
+	std::vector<EvictedFlow> evicted;
+
+	// capacity eviction: the least recently used flow is evicted
+	{
+		pcpp::FlowTable<TestFlowState> table(3, 0, onTestFlowEvicted, &evicted);
+		PTF_ASSERT_EQUAL(table.getMaxNumOfFlows(), 3);
+
+		bool isNew = false;
+		for (uint32_t i = 0; i < 3; i++)
+		{
+			TestFlowState* state = table.getOrCreateFlow(makeFlowKey(i), makeTime(i), &isNew);
+			PTF_ASSERT_NOT_NULL(state);
+			PTF_ASSERT_TRUE(isNew);
+			state->packets++;
+		}
+		PTF_ASSERT_EQUAL(table.getNumOfFlows(), 3);
+
+		// touch flow 0 so flow 1 becomes the least recently used one
+		TestFlowState* state = table.getOrCreateFlow(makeFlowKey(0), makeTime(10), &isNew);
+		PTF_ASSERT_FALSE(isNew);
+		PTF_ASSERT_EQUAL(state->packets, 1);
+		state->packets++;
+
+		table.getOrCreateFlow(makeFlowKey(3), makeTime(11), &isNew)->packets++;
+		PTF_ASSERT_TRUE(isNew);
+		PTF_ASSERT_EQUAL(table.getNumOfFlows(), 3);
+		PTF_ASSERT_EQUAL(evicted.size(), 1);
+		PTF_ASSERT_TRUE(evicted[0].key == makeFlowKey(1));
+		PTF_ASSERT_EQUAL(evicted[0].reason, pcpp::FlowTableFull, enum);
+		PTF_ASSERT_NULL(table.getFlow(makeFlowKey(1)));
+		PTF_ASSERT_EQUAL(table.getFlow(makeFlowKey(0))->packets, 2);
+
+		// a re-created flow starts with a fresh state
+		table.getOrCreateFlow(makeFlowKey(1), makeTime(12), &isNew);
+		PTF_ASSERT_TRUE(isNew);
+		PTF_ASSERT_EQUAL(table.getFlow(makeFlowKey(1))->packets, 0);
+		PTF_ASSERT_EQUAL(evicted.size(), 2);
+		PTF_ASSERT_TRUE(evicted[1].key == makeFlowKey(2));
+
+		// iteration is from the most recently used flow
+		std::vector<pcpp::FlowKey> keys;
+		table.forEachFlow([&keys](const pcpp::FlowKey& key, TestFlowState&) { keys.push_back(key); });
+		PTF_ASSERT_EQUAL(keys.size(), 3);
+		PTF_ASSERT_TRUE(keys[0] == makeFlowKey(1));
+		PTF_ASSERT_TRUE(keys[1] == makeFlowKey(3));
+		PTF_ASSERT_TRUE(keys[2] == makeFlowKey(0));
+
+		PTF_ASSERT_TRUE(table.removeFlow(makeFlowKey(3)));
+		PTF_ASSERT_FALSE(table.removeFlow(makeFlowKey(3)));
+		PTF_ASSERT_EQUAL(table.getNumOfFlows(), 2);
+		PTF_ASSERT_EQUAL(evicted.size(), 2);
+
+		table.clear();
+		PTF_ASSERT_EQUAL(table.getNumOfFlows(), 0);
+		PTF_ASSERT_EQUAL(evicted.size(), 4);
+		PTF_ASSERT_TRUE(evicted[2].key == makeFlowKey(0));
+		PTF_ASSERT_EQUAL(evicted[2].packets, 2);
+		PTF_ASSERT_EQUAL(evicted[3].reason, pcpp::FlowTableCleared, enum);
+	}
+
+	// idle eviction driven by the timestamps of new flows
+	evicted.clear();
+	{
+		pcpp::FlowTable<TestFlowState> table(100, 30, onTestFlowEvicted, &evicted);
+		PTF_ASSERT_EQUAL(table.getIdleTimeout(), 30);
+
+		table.getOrCreateFlow(makeFlowKey(0), makeTime(1000));
+		table.getOrCreateFlow(makeFlowKey(1), makeTime(1010));
+		table.getOrCreateFlow(makeFlowKey(2), makeTime(1020));
+		table.getOrCreateFlow(makeFlowKey(0), makeTime(1025));
+
+		// flow 1 is idle for 31 seconds
+		table.getOrCreateFlow(makeFlowKey(3), makeTime(1041));
+		PTF_ASSERT_EQUAL(evicted.size(), 1);
+		PTF_ASSERT_TRUE(evicted[0].key == makeFlowKey(1));
+		PTF_ASSERT_EQUAL(evicted[0].reason, pcpp::FlowIdleTimeout, enum);
+		PTF_ASSERT_EQUAL(table.getNumOfFlows(), 3);
+
+		PTF_ASSERT_EQUAL(table.evictIdleFlows(makeTime(1056)), 2);
+		PTF_ASSERT_EQUAL(table.getNumOfFlows(), 1);
+		PTF_ASSERT_NOT_NULL(table.getFlow(makeFlowKey(3)));
+	}
+
+	// many flows with removals in between, every flow must remain reachable
+	evicted.clear();
+	{
+		const uint32_t numOfFlows = 50000;
+		pcpp::FlowTable<TestFlowState> table(numOfFlows, 0, onTestFlowEvicted, &evicted);
+		for (uint32_t i = 0; i < numOfFlows; i++)
+			table.getOrCreateFlow(makeFlowKey(i), makeTime(i))->packets = static_cast<int>(i);
+
+		for (uint32_t i = 0; i < numOfFlows; i += 3)
+			PTF_ASSERT_TRUE(table.removeFlow(makeFlowKey(i)));
+
+		for (uint32_t i = 0; i < numOfFlows; i++)
+		{
+			TestFlowState* state = table.getFlow(makeFlowKey(i));
+			if (i % 3 == 0)
+			{
+				PTF_ASSERT_NULL(state);
+			}
+			else
+			{
+				PTF_ASSERT_NOT_NULL(state);
+				PTF_ASSERT_EQUAL(state->packets, static_cast<int>(i));
+			}
+		}
+		PTF_ASSERT_TRUE(evicted.empty());
+	}
+
+	// building the key from the packet uses the packet timestamp
+	evicted.clear();
+	{
+		pcpp::FlowTable<TestFlowState> table(10, 5, onTestFlowEvicted, &evicted);
+
+		pcpp::Packet packet1(100);
+		packet1.addLayer(new pcpp::IPv4Layer(pcpp::IPv4Address("1.1.1.1"), pcpp::IPv4Address("2.2.2.2")), true);
+		packet1.addLayer(new pcpp::UdpLayer(1234, 53), true);
+		packet1.computeCalculateFields();
+		packet1.getRawPacket()->setPacketTimeStamp(makeTime(100));
+
+		pcpp::Packet packet2(100);
+		packet2.addLayer(new pcpp::IPv4Layer(pcpp::IPv4Address("2.2.2.2"), pcpp::IPv4Address("1.1.1.1")), true);
+		packet2.addLayer(new pcpp::UdpLayer(53, 1234), true);
+		packet2.computeCalculateFields();
+		packet2.getRawPacket()->setPacketTimeStamp(makeTime(103));
+
+		bool isNew = false, isReversed = true;
+		PTF_ASSERT_NOT_NULL(table.getOrCreateFlow(packet1, &isNew, &isReversed));
+		PTF_ASSERT_TRUE(isNew);
+		PTF_ASSERT_FALSE(isReversed);
+		PTF_ASSERT_NOT_NULL(table.getOrCreateFlow(packet2, &isNew, &isReversed));
+		PTF_ASSERT_FALSE(isNew);
+		PTF_ASSERT_TRUE(isReversed);
+
+		PTF_ASSERT_EQUAL(table.evictIdleFlows(makeTime(108)), 0);
+		PTF_ASSERT_EQUAL(table.evictIdleFlows(makeTime(109)), 1);
+
+		pcpp::Packet nonIPPacket(100);
+		nonIPPacket.addLayer(new pcpp::EthLayer(pcpp::MacAddress("aa:bb:cc:dd:ee:01"),
+		                                        pcpp::MacAddress("aa:bb:cc:dd:ee:02")),
+		                     true);
+		PTF_ASSERT_NULL(table.getOrCreateFlow(nonIPPacket));
+	}
+}  // FlowTableTest
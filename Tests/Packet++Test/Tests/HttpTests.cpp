@@ -7,9 +7,11 @@
 #include "IPv4Layer.h"
 #include "TcpLayer.h"
 #include "HttpLayer.h"
+#include "HttpReassembly.h"
 #include "PayloadLayer.h"
 #include "SystemUtils.h"
 #include <iostream>
+#include <sstream>
 PTF_TEST_CASE(HttpRequestParseMethodTest)
 {
 	PTF_ASSERT_EQUAL(pcpp::HttpRequestFirstLine::parseMethod(nullptr, 0),
@@ -549,3 +551,242 @@ PTF_TEST_CASE(HttpMalformedResponseTest)
 		index++;
 	}
 }  // HttpMalformedResponseTest
+
+PTF_TEST_CASE(HttpFieldLookupTest)
+{
+	// field names and values longer than the scanner's chunk size, separators inside values, duplicate names, names
+	// in different cases and a field terminated by LF only
+	const std::string longName = "X-Custom-Header-With-A-Name-Longer-Than-Thirty-Two-Bytes";
+	const std::string longValue = "a:b:c " + std::string(100, 'v');
+	const std::string httpMessage = "GET /index.html HTTP/1.1\r\n"
+	                                "host: www.example.com\r\n" +
+	                                longName + ": " + longValue +
+	                                "\r\n"
+	                                "Via: first\n"
+	                                "VIA: second\r\n"
+	                                "X-Empty:\r\n"
+	                                "CONTENT-LENGTH: 0\r\n"
+	                                "\r\n";
+
+	pcpp::EthLayer ethLayer(pcpp::MacAddress("00:11:22:33:44:55"), pcpp::MacAddress("66:77:88:99:aa:bb"));
+	pcpp::IPv4Layer ip4Layer(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("10.0.0.2"));
+	pcpp::TcpLayer tcpLayer(12345, 80);
+	pcpp::PayloadLayer payloadLayer(reinterpret_cast<const uint8_t*>(httpMessage.c_str()), httpMessage.length());
+	pcpp::Packet newPacket(100);
+	PTF_ASSERT_TRUE(newPacket.addLayer(&ethLayer));
+	PTF_ASSERT_TRUE(newPacket.addLayer(&ip4Layer));
+	PTF_ASSERT_TRUE(newPacket.addLayer(&tcpLayer));
+	PTF_ASSERT_TRUE(newPacket.addLayer(&payloadLayer));
+	newPacket.computeCalculateFields();
+
+	pcpp::RawPacket rawPacket(*newPacket.getRawPacket());
+	pcpp::Packet parsedPacket(&rawPacket);
+	pcpp::HttpRequestLayer* httpLayer = parsedPacket.getLayerOfType<pcpp::HttpRequestLayer>();
+	PTF_ASSERT_NOT_NULL(httpLayer);
+	PTF_ASSERT_TRUE(httpLayer->isHeaderComplete());
+	PTF_ASSERT_EQUAL(httpLayer->getFieldCount(), 6);
+	PTF_ASSERT_EQUAL(httpLayer->getHeaderLen(), httpMessage.length());
+
+	PTF_ASSERT_NOT_NULL(httpLayer->getFieldByName(PCPP_HTTP_HOST_FIELD));
+	PTF_ASSERT_EQUAL(httpLayer->getFieldByName(PCPP_HTTP_HOST_FIELD)->getFieldName(), "host");
+	PTF_ASSERT_EQUAL(httpLayer->getFieldByName("HOST")->getFieldValue(), "www.example.com");
+	PTF_ASSERT_NOT_NULL(httpLayer->getFieldByName("x-custom-header-with-a-name-longer-than-thirty-two-bytes"));
+	PTF_ASSERT_EQUAL(httpLayer->getFieldByName(longName)->getFieldName(), longName);
+	PTF_ASSERT_EQUAL(httpLayer->getFieldByName(longName)->getFieldValue(), longValue);
+	PTF_ASSERT_EQUAL(httpLayer->getFieldByName("via")->getFieldValue(), "first");
+	PTF_ASSERT_EQUAL(httpLayer->getFieldByName("via", 1)->getFieldValue(), "second");
+	PTF_ASSERT_NULL(httpLayer->getFieldByName("via", 2));
+	PTF_ASSERT_NOT_NULL(httpLayer->getFieldByName("x-EMPTY"));
+	PTF_ASSERT_EQUAL(httpLayer->getFieldByName("x-EMPTY")->getFieldValue(), "");
+	PTF_ASSERT_EQUAL(httpLayer->getFieldByName(PCPP_HTTP_CONTENT_LENGTH_FIELD)->getFieldValue(), "0");
+	PTF_ASSERT_NULL(httpLayer->getFieldByName("Hos"));
+	PTF_ASSERT_NULL(httpLayer->getFieldByName("Hostt"));
+	PTF_ASSERT_NULL(httpLayer->getFieldByName(PCPP_HTTP_USER_AGENT_FIELD));
+
+	// a copied layer is looked up the same way
+	pcpp::HttpRequestLayer copiedLayer(*httpLayer);
+	PTF_ASSERT_NOT_NULL(copiedLayer.getFieldByName("Host"));
+	PTF_ASSERT_EQUAL(copiedLayer.getFieldByName("Host")->getFieldValue(), "www.example.com");
+	PTF_ASSERT_EQUAL(copiedLayer.getFieldByName("via", 1)->getFieldValue(), "second");
+
+	// removed fields are removed from the lookup
+	PTF_ASSERT_TRUE(httpLayer->removeField("VIA"));
+	PTF_ASSERT_EQUAL(httpLayer->getFieldByName("Via")->getFieldValue(), "second");
+	PTF_ASSERT_NULL(httpLayer->getFieldByName("Via", 1));
+	PTF_ASSERT_TRUE(httpLayer->removeField(httpLayer->getFieldByName(longName)));
+	PTF_ASSERT_NULL(httpLayer->getFieldByName(longName));
+	PTF_ASSERT_EQUAL(httpLayer->getFieldCount(), 4);
+	PTF_ASSERT_NOT_NULL(httpLayer->insertField(httpLayer->getFieldByName("Host"), "User-Agent", "test"));
+	PTF_ASSERT_EQUAL(httpLayer->getFieldByName("user-agent")->getFieldValue(), "test");
+}  // HttpFieldLookupTest
+
+struct HttpReassemblyTestData
+{
+	std::string events[2];
+	std::string body[2];
+
+	static void onHeaders(int8_t side, const pcpp::HttpMessageView& message, const pcpp::ConnectionData&,
+	                      void* userCookie)
+	{
+		auto data = static_cast<HttpReassemblyTestData*>(userCookie);
+		std::ostringstream stream;
+		if (message.isRequest())
+			stream << "request " << message.getMethod() << " " << std::string(message.getUri(), message.getUriLength());
+		else
+			stream << "response " << message.getStatusCode() << " " << message.getMethod();
+
+		const pcpp::HttpFieldView* host = message.getFieldByName("host");
+		if (host != nullptr)
+			stream << " host=" << std::string(host->value, host->valueLength);
+		stream << "|";
+		data->events[side] += stream.str();
+	}
+
+	static void onBodyData(int8_t side, const uint8_t* bodyData, size_t bodyDataLen, const pcpp::ConnectionData&,
+	                       void* userCookie)
+	{
+		auto data = static_cast<HttpReassemblyTestData*>(userCookie);
+		data->body[side].append(reinterpret_cast<const char*>(bodyData), bodyDataLen);
+	}
+
+	static void onMessageEnd(int8_t side, const pcpp::HttpMessageInfo& message, const pcpp::ConnectionData&,
+	                         void* userCookie)
+	{
+		auto data = static_cast<HttpReassemblyTestData*>(userCookie);
+		std::ostringstream stream;
+		stream << "end " << data->body[side] << " " << message.bodyLength << (message.isComplete ? "" : " incomplete")
+		       << "|";
+		data->events[side] += stream.str();
+		data->body[side].clear();
+	}
+};
+
+static void feedHttpReassembly(pcpp::HttpReassembly& httpReassembly, const pcpp::ConnectionData& connData,
+                               int8_t side, const std::string& data, size_t segmentSize, size_t missingBytes = 0)
+{
+	for (size_t offset = 0; offset < data.length(); offset += segmentSize)
+	{
+		size_t len = std::min(segmentSize, data.length() - offset);
+		pcpp::TcpStreamData tcpData(reinterpret_cast<const uint8_t*>(data.c_str()) + offset, len,
+		                            offset == 0 ? missingBytes : 0, connData,
+		                            std::chrono::high_resolution_clock::now());
+		httpReassembly.processTcpData(side, tcpData);
+	}
+}
+
+PTF_TEST_CASE(HttpReassemblyTest)
+{
+	// pipelined requests, a response to HEAD, an interim response, a chunked body with a trailer and a body that
+	// ends with the connection
+	const std::string requests = "GET /a HTTP/1.1\r\nHost: www.example.com\r\n\r\n"
+	                             "HEAD /b HTTP/1.1\r\nHost: www.example.com\r\n\r\n"
+	                             "POST /c HTTP/1.1\r\nExpect: 100-continue\r\nContent-Length: 5\r\n\r\nhello"
+	                             "GET /d HTTP/1.0\r\n\r\n";
+	const std::string responses = "HTTP/1.1 200 OK\r\nContent-Length: 3\r\n\r\nabc"
+	                              "HTTP/1.1 200 OK\r\nContent-Length: 100\r\n\r\n"
+	                              "HTTP/1.1 100 Continue\r\n\r\n"
+	                              "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+	                              "4\r\nWiki\r\n5;ext=1\r\npedia\r\n0\r\nTrailer: x\r\n\r\n"
+	                              "HTTP/1.0 200 OK\r\n\r\nuntil close";
+	const std::string expectedRequestEvents = "request 0 /a host=www.example.com|end  0|"
+	                                          "request 1 /b host=www.example.com|end  0|"
+	                                          "request 2 /c|end hello 5|"
+	                                          "request 0 /d|end  0|";
+	const std::string expectedResponseEvents = "response 200 0|end abc 3|"
+	                                           "response 200 1|end  0|"
+	                                           "response 100 2|end  0|"
+	                                           "response 200 2|end Wikipedia 9|"
+	                                           "response 200 0|end until close 11|";
+
+	pcpp::ConnectionData connData;
+	connData.flowKey = 1;
+
+	// whole messages, then every possible split of the messages between segments
+	size_t segmentSizes[] = { 1000, 1, 2, 3, 7, 16 };
+	for (size_t segmentSize : segmentSizes)
+	{
+		HttpReassemblyTestData data;
+		pcpp::HttpReassembly httpReassembly(HttpReassemblyTestData::onHeaders, HttpReassemblyTestData::onBodyData,
+		                                    HttpReassemblyTestData::onMessageEnd, &data);
+		feedHttpReassembly(httpReassembly, connData, 0, requests, segmentSize);
+		feedHttpReassembly(httpReassembly, connData, 1, responses, segmentSize);
+		PTF_ASSERT_EQUAL(httpReassembly.getNumOfConnections(), 1);
+		httpReassembly.closeConnection(connData, true);
+		PTF_ASSERT_EQUAL(httpReassembly.getNumOfConnections(), 0);
+
+		PTF_ASSERT_EQUAL(data.events[0], expectedRequestEvents);
+		PTF_ASSERT_EQUAL(data.events[1], expectedResponseEvents);
+		PTF_ASSERT_EQUAL(httpReassembly.getStatistics().requests, 4);
+		PTF_ASSERT_EQUAL(httpReassembly.getStatistics().responses, 5);
+		PTF_ASSERT_EQUAL(httpReassembly.getStatistics().incompleteMessages, 0);
+		PTF_ASSERT_EQUAL(httpReassembly.getStatistics().parseErrors, 0);
+	}
+
+	// lost body bytes are skipped, lost data elsewhere is skipped until a new message starts
+	{
+		HttpReassemblyTestData data;
+		pcpp::HttpReassembly httpReassembly(HttpReassemblyTestData::onHeaders, HttpReassemblyTestData::onBodyData,
+		                                    HttpReassemblyTestData::onMessageEnd, &data);
+		feedHttpReassembly(httpReassembly, connData, 1, "HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\n0123", 1000);
+		feedHttpReassembly(httpReassembly, connData, 1, "[3 bytes missing]789HTTP/1.1 204 No Content\r\n\r\n", 1000,
+		                   3);
+		feedHttpReassembly(httpReassembly, connData, 1, "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n5\r\n",
+		                   1000);
+		feedHttpReassembly(httpReassembly, connData, 1, "[10 bytes missing]ignored", 1000, 10);
+		feedHttpReassembly(httpReassembly, connData, 1, "data", 1000);
+		feedHttpReassembly(httpReassembly, connData, 1, "[10 bytes missing]HTTP/1.1 304 Not Modified\r\n\r\n", 1000,
+		                   10);
+		PTF_ASSERT_EQUAL(data.events[1], "response 200 9|end 0123789 7 incomplete|"
+		                                 "response 204 9|end  0|"
+		                                 "response 200 9|end  0 incomplete|"
+		                                 "response 304 9|end  0|");
+		PTF_ASSERT_EQUAL(httpReassembly.getStatistics().incompleteMessages, 2);
+	}
+
+	// invalid data is skipped until a segment starts a new message
+	{
+		HttpReassemblyTestData data;
+		pcpp::HttpReassemblyConfiguration config(64);
+		pcpp::HttpReassembly httpReassembly(HttpReassemblyTestData::onHeaders, HttpReassemblyTestData::onBodyData,
+		                                    HttpReassemblyTestData::onMessageEnd, &data, config);
+		feedHttpReassembly(httpReassembly, connData, 0, "NOT HTTP\r\n\r\nGET /skipped HTTP/1.1\r\n\r\n", 1000);
+		feedHttpReassembly(httpReassembly, connData, 0, "GET /x HTTP/1.1\r\n\r\n", 1000);
+		feedHttpReassembly(httpReassembly, connData, 0, "GET /" + std::string(100, 'x') + " HTTP/1.1\r\n\r\n", 10);
+		feedHttpReassembly(httpReassembly, connData, 0, "GET /y HTTP/1.1\r\nContent-Length: 1x\r\n\r\n", 1000);
+		PTF_ASSERT_EQUAL(data.events[0], "request 0 /x|end  0|");
+		PTF_ASSERT_EQUAL(httpReassembly.getStatistics().parseErrors, 3);
+	}
+
+	// the connection isn't parsed after a successful CONNECT
+	{
+		HttpReassemblyTestData data;
+		pcpp::HttpReassembly httpReassembly(HttpReassemblyTestData::onHeaders, HttpReassemblyTestData::onBodyData,
+		                                    HttpReassemblyTestData::onMessageEnd, &data);
+		feedHttpReassembly(httpReassembly, connData, 0, "CONNECT www.example.com:443 HTTP/1.1\r\n\r\n", 1000);
+		feedHttpReassembly(httpReassembly, connData, 1, "HTTP/1.1 200 Connection established\r\n\r\n", 1000);
+		feedHttpReassembly(httpReassembly, connData, 0, "GET / HTTP/1.1\r\n\r\n", 1000);
+		feedHttpReassembly(httpReassembly, connData, 1, "HTTP/1.1 200 OK\r\n\r\n", 1000);
+		PTF_ASSERT_EQUAL(data.events[0], "request 7 www.example.com:443|end  0|");
+		PTF_ASSERT_EQUAL(data.events[1], "response 200 7|end  0|");
+	}
+
+	// connections above the maximum are ignored
+	{
+		HttpReassemblyTestData data;
+		pcpp::HttpReassemblyConfiguration config(16384, 1);
+		pcpp::HttpReassembly httpReassembly(HttpReassemblyTestData::onHeaders, HttpReassemblyTestData::onBodyData,
+		                                    HttpReassemblyTestData::onMessageEnd, &data, config);
+		pcpp::ConnectionData connData2;
+		connData2.flowKey = 2;
+		feedHttpReassembly(httpReassembly, connData, 0, "GET /1 HTTP/1.1\r\n\r\n", 1000);
+		feedHttpReassembly(httpReassembly, connData2, 0, "GET /2 HTTP/1.1\r\n\r\n", 1000);
+		PTF_ASSERT_EQUAL(data.events[0], "request 0 /1|end  0|");
+		PTF_ASSERT_EQUAL(httpReassembly.getNumOfConnections(), 1);
+		PTF_ASSERT_EQUAL(httpReassembly.getStatistics().ignoredTcpData, 1);
+
+		// a message in progress ends incomplete when the connection is closed manually
+		feedHttpReassembly(httpReassembly, connData, 0, "POST /3 HTTP/1.1\r\nContent-Length: 10\r\n\r\nabc", 1000);
+		httpReassembly.closeConnection(connData, false);
+		PTF_ASSERT_EQUAL(data.events[0], "request 0 /1|end  0|request 2 /3|end abc 3 incomplete|");
+	}
+}  // HttpReassemblyTest
@@ -0,0 +1,191 @@
+#include "../TestDefinition.h"
+#include "Packet.h"
+#include "EthLayer.h"
+#include "IPv4Layer.h"
+#include "IPv6Layer.h"
+#include "TcpLayer.h"
+#include "UdpLayer.h"
+#include "VxlanLayer.h"
+#include "PayloadLayer.h"
+#include "PacketTemplate.h"
+#include "Logger.h"
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	// Parse a copy of a variant, compute all of its calculated fields and check that nothing changed
+	bool hasValidChecksums(const uint8_t* data, size_t dataLen)
+	{
+		uint8_t* dataCopy = new uint8_t[dataLen];
+		memcpy(dataCopy, data, dataLen);
+		timeval time = { 0, 0 };
+		pcpp::RawPacket rawPacket(dataCopy, static_cast<int>(dataLen), time, true);
+		pcpp::Packet packet(&rawPacket);
+		packet.computeCalculateFields();
+		return memcmp(rawPacket.getRawData(), data, dataLen) == 0;
+	}
+}  // namespace
+
+PTF_TEST_CASE(PacketTemplateTest)
+{
+	const uint8_t payload[] = "hello template";  // 15 bytes
+
+	// IPv4 and TCP
+	pcpp::Packet tcpPacket(100);
+	pcpp::EthLayer ethLayer(pcpp::MacAddress("00:11:22:33:44:55"), pcpp::MacAddress("66:77:88:99:aa:bb"));
+	pcpp::IPv4Layer ipLayer(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("10.0.0.2"));
+	ipLayer.getIPv4Header()->timeToLive = 64;
+	pcpp::TcpLayer tcpLayer(1000, 80);
+	pcpp::PayloadLayer payloadLayer(payload, sizeof(payload));
+	PTF_ASSERT_TRUE(tcpPacket.addLayer(&ethLayer));
+	PTF_ASSERT_TRUE(tcpPacket.addLayer(&ipLayer));
+	PTF_ASSERT_TRUE(tcpPacket.addLayer(&tcpLayer));
+	PTF_ASSERT_TRUE(tcpPacket.addLayer(&payloadLayer));
+
+	pcpp::PacketTemplate tcpTemplate(tcpPacket);
+	PTF_ASSERT_EQUAL(tcpTemplate.getDataLen(), 14 + 20 + 20 + sizeof(payload));
+	PTF_ASSERT_TRUE(hasValidChecksums(tcpTemplate.getData(), tcpTemplate.getDataLen()));
+
+	int srcIP = tcpTemplate.addField("src_ip", pcpp::PacketTemplateField::SrcIP);
+	int dstIP = tcpTemplate.addField("dst_ip", pcpp::PacketTemplateField::DstIP);
+	int ttl = tcpTemplate.addField("ttl", pcpp::PacketTemplateField::Ttl);
+	int ipId = tcpTemplate.addField("ip_id", pcpp::PacketTemplateField::IPv4Id);
+	int srcPort = tcpTemplate.addField("src_port", pcpp::PacketTemplateField::SrcPort);
+	int seq = tcpTemplate.addField("seq", pcpp::PacketTemplateField::TcpSequence);
+	int payloadField = tcpTemplate.addField("payload", pcpp::PacketTemplateField::Payload);
+	// a field that starts at an odd offset of the TCP segment
+	int oddField = tcpTemplate.addField("odd", 14 + 20 + 20 + 3, 5);
+	PTF_ASSERT_EQUAL(srcIP, 0);
+	PTF_ASSERT_EQUAL(oddField, 7);
+	PTF_ASSERT_EQUAL(tcpTemplate.getFieldIndex("seq"), seq);
+	PTF_ASSERT_EQUAL(tcpTemplate.getFieldOffset(srcIP), 14 + 12);
+	PTF_ASSERT_EQUAL(tcpTemplate.getFieldLength(payloadField), sizeof(payload));
+
+	std::vector<uint8_t> variant(tcpTemplate.getDataLen());
+	for (uint32_t i = 0; i < 200; i++)
+	{
+		tcpTemplate.writeTo(variant.data());
+		PTF_ASSERT_TRUE(tcpTemplate.setFieldValue(variant.data(), srcIP, pcpp::IPv4Address(0xc0a80000 + i * 7919)));
+		PTF_ASSERT_TRUE(tcpTemplate.setFieldValue(variant.data(), dstIP, pcpp::IPv4Address(0x0a000000 + i * 104729)));
+		PTF_ASSERT_TRUE(tcpTemplate.setFieldValue(variant.data(), ttl, i % 256));
+		PTF_ASSERT_TRUE(tcpTemplate.setFieldValue(variant.data(), ipId, i * 331));
+		PTF_ASSERT_TRUE(tcpTemplate.setFieldValue(variant.data(), srcPort, 1024 + i * 97));
+		PTF_ASSERT_TRUE(tcpTemplate.setFieldValue(variant.data(), seq, 0xfffff000 + i * 65537));
+		uint8_t newPayload[3] = { static_cast<uint8_t>(i), static_cast<uint8_t>(i * 3), static_cast<uint8_t>(~i) };
+		PTF_ASSERT_TRUE(tcpTemplate.setFieldData(variant.data(), payloadField, newPayload, sizeof(newPayload)));
+		PTF_ASSERT_TRUE(tcpTemplate.setFieldValue(variant.data(), oddField, 0x0102030405ULL * i));
+		PTF_ASSERT_TRUE(hasValidChecksums(variant.data(), variant.size()));
+	}
+
+	// the last variant
+	timeval time = { 0, 0 };
+	pcpp::RawPacket variantRawPacket(variant.data(), static_cast<int>(variant.size()), time, false);
+	pcpp::Packet variantPacket(&variantRawPacket);
+	PTF_ASSERT_EQUAL(variantPacket.getLayerOfType<pcpp::IPv4Layer>()->getSrcIPv4Address(),
+	                 pcpp::IPv4Address(0xc0a80000 + 199 * 7919));
+	PTF_ASSERT_EQUAL(variantPacket.getLayerOfType<pcpp::IPv4Layer>()->getIPv4Header()->timeToLive, 199);
+	PTF_ASSERT_EQUAL(variantPacket.getLayerOfType<pcpp::TcpLayer>()->getSrcPort(), 1024 + 199 * 97);
+
+	// errors
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_EQUAL(tcpTemplate.addField("src_ip", pcpp::PacketTemplateField::DstIP), -1);
+	PTF_ASSERT_EQUAL(tcpTemplate.addField("inner_ip", pcpp::PacketTemplateField::SrcIP, 1), -1);
+	PTF_ASSERT_EQUAL(tcpTemplate.addField("ip_checksum", 14 + 9, 2), -1);
+	PTF_ASSERT_EQUAL(tcpTemplate.addField("out_of_packet", tcpTemplate.getDataLen() - 1, 2), -1);
+	PTF_ASSERT_FALSE(tcpTemplate.setFieldValue(variant.data(), srcPort, pcpp::IPv4Address("1.1.1.1")));
+	PTF_ASSERT_FALSE(tcpTemplate.setFieldValue(variant.data(), 100, 1));
+	PTF_ASSERT_FALSE(tcpTemplate.setFieldData(variant.data(), srcPort, payload, 3));
+	pcpp::Logger::getInstance().enableLogs();
+
+	// IPv6 and UDP inside a VXLAN tunnel over IPv4 and UDP, the inner fields are covered by the outer UDP checksum
+	pcpp::Packet tunnelPacket(200);
+	pcpp::EthLayer outerEthLayer(pcpp::MacAddress("00:11:22:33:44:55"), pcpp::MacAddress("66:77:88:99:aa:bb"));
+	pcpp::IPv4Layer outerIPLayer(pcpp::IPv4Address("192.168.1.1"), pcpp::IPv4Address("192.168.1.2"));
+	pcpp::UdpLayer outerUdpLayer(50000, 4789);
+	pcpp::VxlanLayer vxlanLayer(100);
+	pcpp::EthLayer innerEthLayer(pcpp::MacAddress("00:00:00:00:00:01"), pcpp::MacAddress("00:00:00:00:00:02"));
+	pcpp::IPv6Layer innerIPLayer(pcpp::IPv6Address("2001:db8::1"), pcpp::IPv6Address("2001:db8::2"));
+	pcpp::UdpLayer innerUdpLayer(40000, 9999);
+	pcpp::PayloadLayer innerPayloadLayer(payload, sizeof(payload));
+	PTF_ASSERT_TRUE(tunnelPacket.addLayer(&outerEthLayer));
+	PTF_ASSERT_TRUE(tunnelPacket.addLayer(&outerIPLayer));
+	PTF_ASSERT_TRUE(tunnelPacket.addLayer(&outerUdpLayer));
+	PTF_ASSERT_TRUE(tunnelPacket.addLayer(&vxlanLayer));
+	PTF_ASSERT_TRUE(tunnelPacket.addLayer(&innerEthLayer));
+	PTF_ASSERT_TRUE(tunnelPacket.addLayer(&innerIPLayer));
+	PTF_ASSERT_TRUE(tunnelPacket.addLayer(&innerUdpLayer));
+	PTF_ASSERT_TRUE(tunnelPacket.addLayer(&innerPayloadLayer));
+
+	pcpp::PacketTemplate tunnelTemplate(tunnelPacket);
+	int outerSrcIP = tunnelTemplate.addField("outer_src_ip", pcpp::PacketTemplateField::SrcIP);
+	int innerSrcIP = tunnelTemplate.addField("inner_src_ip", pcpp::PacketTemplateField::SrcIP, 1);
+	int innerDstPort = tunnelTemplate.addField("inner_dst_port", pcpp::PacketTemplateField::DstPort, 1);
+	int innerHopLimit = tunnelTemplate.addField("inner_hop_limit", pcpp::PacketTemplateField::Ttl, 1);
+	int innerPayload = tunnelTemplate.addField("inner_payload", pcpp::PacketTemplateField::Payload, 1);
+	PTF_ASSERT_EQUAL(tunnelTemplate.getFieldLength(innerSrcIP), 16);
+	PTF_ASSERT_EQUAL(tunnelTemplate.getFieldLength(innerPayload), sizeof(payload));
+
+	variant.resize(tunnelTemplate.getDataLen());
+	for (uint32_t i = 0; i < 200; i++)
+	{
+		tunnelTemplate.writeTo(variant.data());
+		PTF_ASSERT_TRUE(tunnelTemplate.setFieldValue(variant.data(), outerSrcIP, pcpp::IPv4Address(0x01020304 * i)));
+		uint8_t innerAddress[16] = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+		memcpy(innerAddress + 12, &i, sizeof(i));
+		PTF_ASSERT_TRUE(tunnelTemplate.setFieldValue(variant.data(), innerSrcIP, pcpp::IPv6Address(innerAddress)));
+		PTF_ASSERT_TRUE(tunnelTemplate.setFieldValue(variant.data(), innerDstPort, 20000 + i * 151));
+		PTF_ASSERT_TRUE(tunnelTemplate.setFieldValue(variant.data(), innerHopLimit, 255 - i));
+		PTF_ASSERT_TRUE(tunnelTemplate.setFieldData(variant.data(), innerPayload, payload + i % 10, 5));
+		PTF_ASSERT_TRUE(hasValidChecksums(variant.data(), variant.size()));
+	}
+}  // PacketTemplateTest
+
+PTF_TEST_CASE(PacketTemplateBatchTest)
+{
+	pcpp::Packet udpPacket(100);
+	pcpp::EthLayer ethLayer(pcpp::MacAddress("00:11:22:33:44:55"), pcpp::MacAddress("66:77:88:99:aa:bb"));
+	pcpp::IPv4Layer ipLayer(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("10.0.0.2"));
+	pcpp::UdpLayer udpLayer(1000, 2000);
+	const uint8_t payload[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	pcpp::PayloadLayer payloadLayer(payload, sizeof(payload));
+	PTF_ASSERT_TRUE(udpPacket.addLayer(&ethLayer));
+	PTF_ASSERT_TRUE(udpPacket.addLayer(&ipLayer));
+	PTF_ASSERT_TRUE(udpPacket.addLayer(&udpLayer));
+	PTF_ASSERT_TRUE(udpPacket.addLayer(&payloadLayer));
+
+	pcpp::PacketTemplate udpTemplate(udpPacket);
+	int srcPort = udpTemplate.addField("src_port", pcpp::PacketTemplateField::SrcPort);
+	int dstIP = udpTemplate.addField("dst_ip", pcpp::PacketTemplateField::DstIP);
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_EQUAL(udpTemplate.addField("seq", pcpp::PacketTemplateField::TcpSequence), -1);
+	pcpp::Logger::getInstance().enableLogs();
+
+	pcpp::PacketTemplateBatch batch(udpTemplate, 16);
+	PTF_ASSERT_EQUAL(batch.getBatchSize(), 16);
+	for (size_t i = 0; i < batch.getBatchSize(); i++)
+	{
+		PTF_ASSERT_TRUE(batch.setFieldValue(i, srcPort, 30000 + i));
+		PTF_ASSERT_TRUE(batch.setFieldValue(i, dstIP, pcpp::IPv4Address(0x0a000100 + static_cast<uint32_t>(i))));
+	}
+
+	timespec timestamp = { 1000, 500 };
+	batch.setTimestamp(timestamp);
+	pcpp::RawPacket* rawPackets = batch.getRawPackets();
+	for (size_t i = 0; i < batch.getBatchSize(); i++)
+	{
+		PTF_ASSERT_EQUAL(rawPackets[i].getRawData(), batch.getPacketData(i), ptr);
+		PTF_ASSERT_EQUAL(rawPackets[i].getRawDataLen(), static_cast<int>(udpTemplate.getDataLen()));
+		PTF_ASSERT_EQUAL(rawPackets[i].getPacketTimeStamp().tv_sec, 1000);
+		PTF_ASSERT_TRUE(hasValidChecksums(rawPackets[i].getRawData(), rawPackets[i].getRawDataLen()));
+
+		pcpp::Packet packet(&rawPackets[i]);
+		PTF_ASSERT_EQUAL(packet.getLayerOfType<pcpp::UdpLayer>()->getSrcPort(), 30000 + i);
+		PTF_ASSERT_EQUAL(packet.getLayerOfType<pcpp::IPv4Layer>()->getDstIPv4Address(),
+		                 pcpp::IPv4Address(0x0a000100 + static_cast<uint32_t>(i)));
+	}
+
+	// reset() restores the template in all the variants
+	batch.reset();
+	PTF_ASSERT_BUF_COMPARE(batch.getPacketData(5), udpTemplate.getData(), udpTemplate.getDataLen());
+}  // PacketTemplateBatchTest
@@ -18,8 +18,12 @@
 #include "RadiusLayer.h"
 #include "PacketTrailerLayer.h"
 #include "PayloadLayer.h"
+#include "VxlanLayer.h"
 #include "GeneralUtils.h"
+#include "Instrumentation.h"
 #include "SystemUtils.h"
+#include <memory>
+#include <thread>
 
 PTF_TEST_CASE(InsertDataToPacket)
 {
@@ -1082,3 +1086,340 @@ PTF_TEST_CASE(PacketParseLayerLimitTest)
 	pcpp::Packet packet1(&rawPacket1, pcpp::OsiModelTransportLayer);
 	PTF_ASSERT_EQUAL(packet1.getLastLayer()->getOsiModelLayer(), pcpp::OsiModelTransportLayer);
 }
+
+static pcpp::Layer* payloadDissector(uint8_t* data, size_t dataLen, pcpp::Layer*, pcpp::Packet*, uint16_t, uint16_t)
+{
+	return new pcpp::PayloadLayer(data, dataLen);
+}
+
+static pcpp::Layer* ignoreDissector(uint8_t*, size_t, pcpp::Layer*, pcpp::Packet*, uint16_t, uint16_t)
+{
+	return nullptr;
+}
+
+static pcpp::Layer* oddLengthDissector(uint8_t* data, size_t dataLen, pcpp::Layer*, pcpp::Packet*, uint16_t, uint16_t)
+{
+	return dataLen % 2 == 1 ? new pcpp::PayloadLayer(data, dataLen) : nullptr;
+}
+
+PTF_TEST_CASE(PortDissectorTableTest)
+{
+	// Built-in dissectors
+	{
+		auto tcpDissectors = pcpp::TcpLayer::getDissectorTable().getDissectorNames();
+		PTF_ASSERT_EQUAL(tcpDissectors.size(), 14);
+		PTF_ASSERT_EQUAL(tcpDissectors.front(), "HTTP");
+		PTF_ASSERT_EQUAL(tcpDissectors.back(), "GTPv2");
+		PTF_ASSERT_TRUE(pcpp::TcpLayer::getDissectorTable().isDissectorEnabled("LDAP"));
+
+		auto udpDissectors = pcpp::UdpLayer::getDissectorTable().getDissectorNames();
+		PTF_ASSERT_EQUAL(udpDissectors.size(), 12);
+		PTF_ASSERT_EQUAL(udpDissectors.front(), "DHCP");
+		PTF_ASSERT_EQUAL(udpDissectors.back(), "WireGuard");
+
+		// SOME/IP is a heuristic dissector, so it's a candidate for every port
+		PTF_ASSERT_EQUAL(pcpp::UdpLayer::getDissectorTable().getDissectorCount(1000), 1);
+		PTF_ASSERT_EQUAL(pcpp::UdpLayer::getDissectorTable().getDissectorCount(53), 2);
+		// port 2123 is both GTPv1 and GTPv2
+		PTF_ASSERT_EQUAL(pcpp::UdpLayer::getDissectorTable().getDissectorCount(2123), 3);
+	}
+
+	// Disable a built-in dissector
+	{
+		timeval time;
+		gettimeofday(&time, nullptr);
+
+		READ_FILE_AND_CREATE_PACKET(1, "PacketExamples/TwoHttpRequests1.dat");
+
+		pcpp::Packet httpPacket(&rawPacket1);
+		PTF_ASSERT_TRUE(httpPacket.isPacketOfType(pcpp::HTTPRequest));
+
+		PTF_ASSERT_TRUE(pcpp::TcpLayer::getDissectorTable().setDissectorEnabled("HTTP", false));
+		pcpp::Packet payloadPacket(&rawPacket1);
+		bool isHttp = payloadPacket.isPacketOfType(pcpp::HTTPRequest);
+		bool isPayload = payloadPacket.getLastLayer()->getProtocol() == pcpp::GenericPayload;
+		PTF_ASSERT_TRUE(pcpp::TcpLayer::getDissectorTable().setDissectorEnabled("HTTP", true));
+
+		PTF_ASSERT_FALSE(isHttp);
+		PTF_ASSERT_TRUE(isPayload);
+		PTF_ASSERT_FALSE(pcpp::TcpLayer::getDissectorTable().setDissectorEnabled("Unknown", true));
+
+		pcpp::Packet httpPacketAgain(&rawPacket1);
+		PTF_ASSERT_TRUE(httpPacketAgain.isPacketOfType(pcpp::HTTPRequest));
+	}
+
+	// Register dissectors
+	{
+		pcpp::PortDissectorTable table;
+		uint8_t payload[4] = { 1, 2, 3, 4 };
+		PTF_ASSERT_NULL(table.dissect(payload, sizeof(payload), nullptr, nullptr, 1000, 2000));
+
+		pcpp::Logger::getInstance().suppressLogs();
+		PTF_ASSERT_FALSE(table.registerDissector("Empty", 0, payloadDissector, {}));
+		PTF_ASSERT_FALSE(table.registerDissector("Null", 0, nullptr, { 1000 }));
+		PTF_ASSERT_TRUE(table.registerDissector("Payload", 200, payloadDissector, { 1000 }));
+		PTF_ASSERT_FALSE(table.registerDissector("Payload", 100, ignoreDissector, { 2000 }));
+		PTF_ASSERT_TRUE(table.registerDissector("Ignore", 100, ignoreDissector, { 1000, 2000 }));
+		PTF_ASSERT_TRUE(table.registerHeuristicDissector("OddLength", 100, oddLengthDissector));
+		pcpp::Logger::getInstance().enableLogs();
+
+		std::vector<std::string> expectedNames = { "Ignore", "OddLength", "Payload" };
+		PTF_ASSERT_VECTORS_EQUAL(table.getDissectorNames(), expectedNames);
+		PTF_ASSERT_EQUAL(table.getDissectorCount(1000), 3);
+		PTF_ASSERT_EQUAL(table.getDissectorCount(2000), 2);
+		PTF_ASSERT_EQUAL(table.getDissectorCount(3000), 1);
+
+		// "Ignore" and "OddLength" don't accept the payload, "Payload" is registered on the destination port
+		std::unique_ptr<pcpp::Layer> layer(table.dissect(payload, sizeof(payload), nullptr, nullptr, 2000, 1000));
+		PTF_ASSERT_NOT_NULL(layer);
+		PTF_ASSERT_EQUAL(layer->getDataLen(), 4);
+
+		PTF_ASSERT_NULL(table.dissect(payload, sizeof(payload), nullptr, nullptr, 2000, 3000));
+
+		layer.reset(table.dissect(payload, 3, nullptr, nullptr, 2000, 3000));
+		PTF_ASSERT_NOT_NULL(layer);
+		PTF_ASSERT_EQUAL(layer->getDataLen(), 3);
+
+		PTF_ASSERT_TRUE(table.setDissectorEnabled("Payload", false));
+		PTF_ASSERT_FALSE(table.isDissectorEnabled("Payload"));
+		PTF_ASSERT_TRUE(table.isDissectorRegistered("Payload"));
+		PTF_ASSERT_EQUAL(table.getDissectorCount(1000), 2);
+		PTF_ASSERT_NULL(table.dissect(payload, sizeof(payload), nullptr, nullptr, 2000, 1000));
+		PTF_ASSERT_TRUE(table.setDissectorEnabled("Payload", true));
+
+		PTF_ASSERT_TRUE(table.unregisterDissector("Ignore"));
+		PTF_ASSERT_FALSE(table.unregisterDissector("Ignore"));
+		PTF_ASSERT_FALSE(table.isDissectorRegistered("Ignore"));
+		PTF_ASSERT_EQUAL(table.getDissectorCount(2000), 1);
+		PTF_ASSERT_EQUAL(table.getDissectorCount(1000), 2);
+
+		std::vector<uint16_t> expectedPorts = { 80, 8080 };
+		PTF_ASSERT_VECTORS_EQUAL(pcpp::PortDissectorTable::getMatchingPorts(pcpp::HttpMessage::isHttpPort),
+		                         expectedPorts);
+	}
+}  // PortDissectorTableTest
+
+PTF_TEST_CASE(InstrumentationTest)
+{
+	timeval time;
+	gettimeofday(&time, nullptr);
+
+	pcpp::resetInstrumentation();
+	PTF_ASSERT_EQUAL(pcpp::getInstrumentationSnapshot().getTotalLayerAllocations(), 0);
+	PTF_ASSERT_EQUAL(pcpp::getInstrumentationCounterName(pcpp::InstrumentationCounter::RawPacketCopies),
+	                 "raw_packet_copies");
+
+	READ_FILE_AND_CREATE_PACKET(1, "PacketExamples/TcpPacketWithOptions3.dat");
+	pcpp::Packet packet1(&rawPacket1);
+	pcpp::RawPacket rawPacketCopy(rawPacket1);
+
+	// events of another thread are counted in the totals but not in the snapshot of this thread
+	std::thread otherThread([&rawPacket1]() { pcpp::RawPacket otherCopy(rawPacket1); });
+	otherThread.join();
+
+	pcpp::InstrumentationSnapshot snapshot = pcpp::getInstrumentationSnapshot();
+	pcpp::InstrumentationSnapshot threadSnapshot = pcpp::getThreadInstrumentationSnapshot();
+	if (!pcpp::isInstrumentationEnabled())
+	{
+		PTF_ASSERT_EQUAL(snapshot.getCounter(pcpp::InstrumentationCounter::RawPacketCopies), 0);
+		PTF_ASSERT_EQUAL(snapshot.getTotalLayerAllocations(), 0);
+		PTF_ASSERT_EQUAL(snapshot.toJson(),
+		                 "{\"raw_packet_copies\":0,\"raw_packet_bytes_copied\":0,"
+		                 "\"tcp_reassembly_fragment_buffers\":0,\"tcp_reassembly_bytes_buffered\":0,"
+		                 "\"ip_reassembly_buffers\":0,\"ip_reassembly_bytes_buffered\":0,\"filter_evaluations\":0,"
+		                 "\"device_rx_batches\":0,\"device_rx_packets\":0,\"device_tx_batches\":0,"
+		                 "\"device_tx_packets\":0,\"layer_allocations\":{}}");
+		return;
+	}
+
+	PTF_ASSERT_EQUAL(snapshot.getCounter(pcpp::InstrumentationCounter::RawPacketCopies), 2);
+	PTF_ASSERT_EQUAL(snapshot.getCounter(pcpp::InstrumentationCounter::RawPacketBytesCopied),
+	                 2 * rawPacket1.getRawDataLen());
+	PTF_ASSERT_EQUAL(threadSnapshot.getCounter(pcpp::InstrumentationCounter::RawPacketCopies), 1);
+	PTF_ASSERT_EQUAL(snapshot.getLayerAllocations(pcpp::Ethernet), 1);
+	PTF_ASSERT_EQUAL(snapshot.getLayerAllocations(pcpp::IPv4), 1);
+	PTF_ASSERT_EQUAL(snapshot.getLayerAllocations(pcpp::TCP), 1);
+	PTF_ASSERT_EQUAL(snapshot.getLayerAllocations(pcpp::UDP), 0);
+
+	std::string prometheusText = snapshot.toPrometheusText();
+	PTF_ASSERT_TRUE(prometheusText.find("# TYPE pcpp_raw_packet_copies_total counter\n"
+	                                    "pcpp_raw_packet_copies_total 2\n") != std::string::npos);
+	PTF_ASSERT_TRUE(prometheusText.find("pcpp_layer_allocations_total{protocol=\"IPv4\"} 1\n") != std::string::npos);
+	PTF_ASSERT_TRUE(snapshot.toJson().find("\"raw_packet_copies\":2,") != std::string::npos);
+	PTF_ASSERT_TRUE(snapshot.toJson().find("\"IPv4\":1") != std::string::npos);
+
+	// parsing a copy of the packet allocates its layers again
+	pcpp::Packet packetCopy(packet1);
+	pcpp::InstrumentationSnapshot difference = pcpp::getInstrumentationSnapshot() - snapshot;
+	PTF_ASSERT_EQUAL(difference.getCounter(pcpp::InstrumentationCounter::RawPacketCopies), 1);
+	PTF_ASSERT_EQUAL(difference.getLayerAllocations(pcpp::TCP), 1);
+
+	pcpp::resetInstrumentation();
+	PTF_ASSERT_EQUAL(pcpp::getInstrumentationSnapshot().getCounter(pcpp::InstrumentationCounter::RawPacketCopies), 0);
+	PTF_ASSERT_EQUAL(pcpp::getThreadInstrumentationSnapshot().getTotalLayerAllocations(), 0);
+}  // InstrumentationTest
+
+PTF_TEST_CASE(PacketHeadroomTest)
+{
+	timeval time;
+	gettimeofday(&time, nullptr);
+
+	// RawPacket headroom and tailroom
+	uint8_t* buffer = new uint8_t[4]{ 1, 2, 3, 4 };
+	pcpp::RawPacket rawPacket(buffer, 4, time, true);
+	PTF_ASSERT_EQUAL(rawPacket.getHeadroom(), 0);
+	PTF_ASSERT_EQUAL(rawPacket.getTailroom(), 0);
+	PTF_ASSERT_TRUE(rawPacket.reserveRoom(8, 4));
+	PTF_ASSERT_EQUAL(rawPacket.getHeadroom(), 8);
+	PTF_ASSERT_EQUAL(rawPacket.getTailroom(), 4);
+	const uint8_t* rawData = rawPacket.getRawData();
+	uint8_t expectedData[] = { 1, 2, 3, 4 };
+	PTF_ASSERT_BUF_COMPARE(rawData, expectedData, 4);
+
+	uint8_t header[] = { 0xaa, 0xbb };
+	PTF_ASSERT_TRUE(rawPacket.prependData(header, sizeof(header)));
+	PTF_ASSERT_EQUAL(rawPacket.getRawData(), rawData - 2, ptr);
+	PTF_ASSERT_EQUAL(rawPacket.getRawDataLen(), 6);
+	PTF_ASSERT_EQUAL(rawPacket.getHeadroom(), 6);
+	uint8_t expectedPrependedData[] = { 0xaa, 0xbb, 1, 2, 3, 4 };
+	PTF_ASSERT_BUF_COMPARE(rawPacket.getRawData(), expectedPrependedData, 6);
+
+	PTF_ASSERT_TRUE(rawPacket.removeDataFromStart(3));
+	PTF_ASSERT_EQUAL(rawPacket.getRawData(), rawData + 1, ptr);
+	PTF_ASSERT_EQUAL(rawPacket.getRawDataLen(), 3);
+	PTF_ASSERT_EQUAL(rawPacket.getHeadroom(), 9);
+
+	rawPacket.appendData(header, sizeof(header));
+	PTF_ASSERT_EQUAL(rawPacket.getTailroom(), 2);
+	PTF_ASSERT_TRUE(rawPacket.reserveRoom(9, 2));
+	PTF_ASSERT_EQUAL(rawPacket.getRawData(), rawData + 1, ptr);
+
+	pcpp::Logger::getInstance().suppressLogs();
+	uint8_t longHeader[10] = {};
+	PTF_ASSERT_FALSE(rawPacket.prependData(longHeader, sizeof(longHeader)));
+	PTF_ASSERT_FALSE(rawPacket.removeDataFromStart(100));
+	pcpp::Logger::getInstance().enableLogs();
+
+	// the copy of a raw packet has no headroom
+	pcpp::RawPacket rawPacketCopy(rawPacket);
+	PTF_ASSERT_EQUAL(rawPacketCopy.getHeadroom(), 0);
+	PTF_ASSERT_BUF_COMPARE(rawPacketCopy.getRawData(), rawPacket.getRawData(), rawPacket.getRawDataLen());
+
+	// encapsulate a packet in a VXLAN tunnel and compare it to the same packet built layer by layer
+	const uint8_t payload[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a };
+	pcpp::MacAddress innerSrcMac("00:00:00:00:00:01");
+	pcpp::MacAddress innerDstMac("00:00:00:00:00:02");
+	pcpp::MacAddress outerSrcMac("00:11:22:33:44:55");
+	pcpp::MacAddress outerDstMac("66:77:88:99:aa:bb");
+	pcpp::IPv4Address innerSrcIP("10.0.0.1"), innerDstIP("10.0.0.2");
+	pcpp::IPv4Address outerSrcIP("192.168.1.1"), outerDstIP("192.168.1.2");
+
+	pcpp::Packet expectedPacket(100);
+	expectedPacket.addLayer(new pcpp::EthLayer(outerSrcMac, outerDstMac), true);
+	expectedPacket.addLayer(new pcpp::IPv4Layer(outerSrcIP, outerDstIP), true);
+	expectedPacket.addLayer(new pcpp::UdpLayer(50000, 4789), true);
+	expectedPacket.addLayer(new pcpp::VxlanLayer(100), true);
+	expectedPacket.addLayer(new pcpp::EthLayer(innerSrcMac, innerDstMac), true);
+	expectedPacket.addLayer(new pcpp::IPv4Layer(innerSrcIP, innerDstIP), true);
+	expectedPacket.addLayer(new pcpp::UdpLayer(40000, 9999), true);
+	expectedPacket.addLayer(new pcpp::PayloadLayer(payload, sizeof(payload)), true);
+	expectedPacket.computeCalculateFields();
+
+	const size_t tunnelHeadersLen = 14 + 20 + 8 + 8;
+	pcpp::Packet packet(100, tunnelHeadersLen);
+	packet.addLayer(new pcpp::EthLayer(innerSrcMac, innerDstMac), true);
+	packet.addLayer(new pcpp::IPv4Layer(innerSrcIP, innerDstIP), true);
+	packet.addLayer(new pcpp::UdpLayer(40000, 9999), true);
+	packet.addLayer(new pcpp::PayloadLayer(payload, sizeof(payload)), true);
+	packet.computeCalculateFields();
+	PTF_ASSERT_EQUAL(packet.getRawPacket()->getHeadroom(), tunnelHeadersLen);
+
+	std::vector<uint8_t> innerData(packet.getRawPacket()->getRawData(),
+	                               packet.getRawPacket()->getRawData() + packet.getRawPacket()->getRawDataLen());
+	const uint8_t* innerDataPtr = packet.getRawPacket()->getRawData();
+
+	PTF_ASSERT_TRUE(packet.encapsulate({ new pcpp::EthLayer(outerSrcMac, outerDstMac),
+	                                     new pcpp::IPv4Layer(outerSrcIP, outerDstIP), new pcpp::UdpLayer(50000, 4789),
+	                                     new pcpp::VxlanLayer(100) },
+	                                   true));
+	packet.computeCalculateFields();
+
+	// the headers were written to the headroom, the inner packet wasn't moved
+	PTF_ASSERT_EQUAL(packet.getRawPacket()->getRawData(), innerDataPtr - tunnelHeadersLen, ptr);
+	PTF_ASSERT_EQUAL(packet.getRawPacket()->getHeadroom(), 0);
+	PTF_ASSERT_EQUAL(packet.getRawPacket()->getRawDataLen(), expectedPacket.getRawPacket()->getRawDataLen());
+	PTF_ASSERT_BUF_COMPARE(packet.getRawPacket()->getRawData(), expectedPacket.getRawPacket()->getRawData(),
+	                       expectedPacket.getRawPacket()->getRawDataLen());
+	PTF_ASSERT_EQUAL(packet.getFirstLayer()->getProtocol(), pcpp::Ethernet, enum);
+	pcpp::Layer* innerEthLayer = packet.getLayerOfType(pcpp::Ethernet, 1);
+	PTF_ASSERT_EQUAL(packet.getLayerOfType<pcpp::VxlanLayer>()->getNextLayer(), innerEthLayer, ptr);
+
+	// the tunnel headers become headroom again
+	PTF_ASSERT_TRUE(packet.decapsulate(innerEthLayer));
+	PTF_ASSERT_EQUAL(packet.getRawPacket()->getRawData(), innerDataPtr, ptr);
+	PTF_ASSERT_EQUAL(packet.getRawPacket()->getHeadroom(), tunnelHeadersLen);
+	PTF_ASSERT_VECTORS_EQUAL(std::vector<uint8_t>(packet.getRawPacket()->getRawData(),
+	                                              packet.getRawPacket()->getRawData() +
+	                                                  packet.getRawPacket()->getRawDataLen()),
+	                         innerData);
+	PTF_ASSERT_EQUAL(packet.getFirstLayer()->getProtocol(), pcpp::Ethernet, enum);
+	PTF_ASSERT_EQUAL(packet.getLayerOfType<pcpp::UdpLayer>()->getDstPort(), 9999);
+	PTF_ASSERT_NULL(packet.getLayerOfType<pcpp::VxlanLayer>());
+
+	// a packet without headroom allocates it once
+	pcpp::Packet packetWithoutHeadroom(10);
+	packetWithoutHeadroom.addLayer(new pcpp::EthLayer(innerSrcMac, innerDstMac), true);
+	packetWithoutHeadroom.addLayer(new pcpp::IPv4Layer(innerSrcIP, innerDstIP), true);
+	packetWithoutHeadroom.addLayer(new pcpp::UdpLayer(40000, 9999), true);
+	packetWithoutHeadroom.addLayer(new pcpp::PayloadLayer(payload, sizeof(payload)), true);
+	pcpp::EthLayer outerEthLayer(outerSrcMac, outerDstMac);
+	pcpp::IPv4Layer outerIPLayer(outerSrcIP, outerDstIP);
+	pcpp::UdpLayer outerUdpLayer(50000, 4789);
+	pcpp::VxlanLayer vxlanLayer(100);
+	PTF_ASSERT_TRUE(packetWithoutHeadroom.encapsulate({ &outerEthLayer, &outerIPLayer, &outerUdpLayer, &vxlanLayer }));
+	packetWithoutHeadroom.computeCalculateFields();
+	PTF_ASSERT_BUF_COMPARE(packetWithoutHeadroom.getRawPacket()->getRawData(),
+	                       expectedPacket.getRawPacket()->getRawData(), expectedPacket.getRawPacket()->getRawDataLen());
+
+	// layers that weren't allocated by the packet are detached
+	PTF_ASSERT_TRUE(packetWithoutHeadroom.decapsulate(packetWithoutHeadroom.getLayerOfType(pcpp::Ethernet, 1)));
+	PTF_ASSERT_FALSE(outerEthLayer.isAllocatedToPacket());
+	PTF_ASSERT_EQUAL(vxlanLayer.getVNI(), 100);
+
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(packetWithoutHeadroom.decapsulate(&outerEthLayer));
+	PTF_ASSERT_FALSE(packet.encapsulate({ nullptr }));
+	pcpp::Logger::getInstance().enableLogs();
+
+	// a packet created on a user buffer keeps its data at the start of the buffer
+	uint8_t userBuffer[100];
+	pcpp::Packet userBufferPacket(userBuffer, sizeof(userBuffer));
+	userBufferPacket.addLayer(new pcpp::EthLayer(innerSrcMac, innerDstMac), true);
+	userBufferPacket.addLayer(new pcpp::IPv4Layer(innerSrcIP, innerDstIP), true);
+	PTF_ASSERT_TRUE(userBufferPacket.removeFirstLayer());
+	PTF_ASSERT_EQUAL(userBufferPacket.getRawPacket()->getRawData(), userBuffer, ptr);
+	PTF_ASSERT_EQUAL(userBufferPacket.getFirstLayer()->getProtocol(), pcpp::IPv4, enum);
+
+	// and so does a parsed packet whose raw packet doesn't own its buffer
+	std::vector<uint8_t> userOwnedData(expectedPacket.getRawPacket()->getRawData(),
+	                                   expectedPacket.getRawPacket()->getRawData() +
+	                                       expectedPacket.getRawPacket()->getRawDataLen());
+	pcpp::RawPacket userOwnedRawPacket(userOwnedData.data(), static_cast<int>(userOwnedData.size()), time, false);
+	PTF_ASSERT_FALSE(userOwnedRawPacket.isRawDataOwned());
+	pcpp::Packet userOwnedPacket(&userOwnedRawPacket);
+	PTF_ASSERT_TRUE(userOwnedPacket.removeFirstLayer());
+	PTF_ASSERT_EQUAL(userOwnedRawPacket.getRawData(), userOwnedData.data(), ptr);
+	PTF_ASSERT_EQUAL(userOwnedRawPacket.getHeadroom(), 0);
+	PTF_ASSERT_EQUAL(userOwnedRawPacket.getRawDataLen(), static_cast<int>(userOwnedData.size()) - 14);
+	PTF_ASSERT_EQUAL(userOwnedPacket.getFirstLayer()->getProtocol(), pcpp::IPv4, enum);
+	PTF_ASSERT_EQUAL(userOwnedPacket.getLayerOfType<pcpp::VxlanLayer>()->getVNI(), 100);
+
+	// a raw packet that owns its buffer turns the removed layer into headroom
+	pcpp::RawPacket ownedRawPacket(*expectedPacket.getRawPacket());
+	PTF_ASSERT_TRUE(ownedRawPacket.isRawDataOwned());
+	const uint8_t* ownedRawData = ownedRawPacket.getRawData();
+	pcpp::Packet ownedPacket(&ownedRawPacket);
+	PTF_ASSERT_TRUE(ownedPacket.removeFirstLayer());
+	PTF_ASSERT_EQUAL(ownedRawPacket.getRawData(), ownedRawData + 14, ptr);
+	PTF_ASSERT_EQUAL(ownedRawPacket.getHeadroom(), 14);
+}  // PacketHeadroomTest
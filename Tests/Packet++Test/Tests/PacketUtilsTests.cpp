@@ -8,6 +8,11 @@
 #include "UdpLayer.h"
 #include "SystemUtils.h"
 #include "PacketUtils.h"
+#include "Logger.h"
+#include <memory>
+#include <random>
+#include <unordered_set>
+#include <vector>
 
 PTF_TEST_CASE(PacketUtilsHash5TupleUdp)
 {
@@ -148,3 +153,212 @@ PTF_TEST_CASE(PacketUtilsHash5TupleIPv6)
 	PTF_ASSERT_NOT_EQUAL(pcpp::hash5Tuple(&srcDstPacket, true), pcpp::hash5Tuple(&dstSrcPacket, true));
 
 }  // PacketUtilsHash5TupleIPv6
+
+namespace
+{
+	pcpp::Packet* createTcpPacket(const pcpp::IPAddress& srcIP, const pcpp::IPAddress& dstIP, uint16_t srcPort,
+	                              uint16_t dstPort)
+	{
+		pcpp::Packet* packet = new pcpp::Packet(100);
+		if (srcIP.isIPv4())
+			packet->addLayer(new pcpp::IPv4Layer(srcIP.getIPv4(), dstIP.getIPv4()), true);
+		else
+			packet->addLayer(new pcpp::IPv6Layer(srcIP.getIPv6(), dstIP.getIPv6()), true);
+		packet->addLayer(new pcpp::TcpLayer(srcPort, dstPort), true);
+		packet->computeCalculateFields();
+		return packet;
+	}
+
+	int countBits(uint64_t value)
+	{
+		int count = 0;
+		for (; value != 0; value &= value - 1)
+			count++;
+		return count;
+	}
+
+	// Chi-square statistic of the distribution of values into buckets
+	double chiSquare(const std::vector<int>& buckets, size_t numOfValues)
+	{
+		double expected = static_cast<double>(numOfValues) / buckets.size();
+		double result = 0;
+		for (int bucket : buckets)
+			result += (bucket - expected) * (bucket - expected) / expected;
+		return result;
+	}
+}  // namespace
+
+PTF_TEST_CASE(PacketUtilsHash64)
+{
+	// avalanche: flipping any input bit flips about half of the output bits, for all the input length ranges
+	std::mt19937 random(1);
+	const size_t lengths[] = { 3, 8, 13, 16, 40, 100 };
+	for (size_t len : lengths)
+	{
+		std::vector<uint8_t> buffer(len);
+		uint64_t flippedBits = 0, samples = 0;
+		for (int round = 0; round < 20; round++)
+		{
+			for (auto& byte : buffer)
+				byte = static_cast<uint8_t>(random());
+
+			uint64_t original = pcpp::hash64(buffer.data(), len);
+			for (size_t bit = 0; bit < len * 8; bit++)
+			{
+				buffer[bit / 8] ^= static_cast<uint8_t>(1 << (bit % 8));
+				flippedBits += countBits(original ^ pcpp::hash64(buffer.data(), len));
+				buffer[bit / 8] ^= static_cast<uint8_t>(1 << (bit % 8));
+				samples++;
+			}
+		}
+		double averageFlipped = static_cast<double>(flippedBits) / samples;
+		PTF_ASSERT_GREATER_THAN(averageFlipped, 31.0);
+		PTF_ASSERT_LOWER_THAN(averageFlipped, 33.0);
+	}
+
+	// the seed and the length are part of the hash
+	uint8_t zeros[32] = { 0 };
+	PTF_ASSERT_NOT_EQUAL(pcpp::hash64(zeros, 32), pcpp::hash64(zeros, 32, 1));
+	PTF_ASSERT_NOT_EQUAL(pcpp::hash64(zeros, 16), pcpp::hash64(zeros, 17));
+	PTF_ASSERT_NOT_EQUAL(pcpp::hash64(zeros, 0), pcpp::hash64(zeros, 1));
+	PTF_ASSERT_EQUAL(pcpp::hash64(zeros, 0), pcpp::hash64(nullptr, 0));
+
+	// sequential 5-tuples, the worst case of FNV: no collisions and both the low and high bits are uniform
+	const size_t numOfTuples = 65536;
+	std::unordered_set<uint64_t> hashes;
+	std::vector<int> lowBuckets(256, 0), highBuckets(256, 0);
+	uint8_t dstIP[4] = { 192, 168, 0, 1 };
+	for (uint32_t i = 0; i < numOfTuples; i++)
+	{
+		uint8_t srcIP[4] = { 10, 0, static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i) };
+		uint64_t hash = pcpp::hash5Tuple64(srcIP, dstIP, 4, 1024 + (i & 7), 80, 6);
+		hashes.insert(hash);
+		lowBuckets[hash & 0xFF]++;
+		highBuckets[hash >> 56]++;
+	}
+	PTF_ASSERT_EQUAL(hashes.size(), numOfTuples);
+	// 255 degrees of freedom, the 99.9th percentile is about 330
+	PTF_ASSERT_LOWER_THAN(chiSquare(lowBuckets, numOfTuples), 330.0);
+	PTF_ASSERT_LOWER_THAN(chiSquare(highBuckets, numOfTuples), 330.0);
+
+	// symmetric and direction unique 5-tuple hashes of packets
+	std::unique_ptr<pcpp::Packet> ipv4Packet(
+	    createTcpPacket(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("10.0.0.2"), 40000, 443));
+	std::unique_ptr<pcpp::Packet> ipv4Reply(
+	    createTcpPacket(pcpp::IPv4Address("10.0.0.2"), pcpp::IPv4Address("10.0.0.1"), 443, 40000));
+	PTF_ASSERT_EQUAL(pcpp::hash5Tuple64(ipv4Packet.get()), pcpp::hash5Tuple64(ipv4Reply.get()));
+	PTF_ASSERT_NOT_EQUAL(pcpp::hash5Tuple64(ipv4Packet.get(), true), pcpp::hash5Tuple64(ipv4Reply.get(), true));
+	PTF_ASSERT_EQUAL(pcpp::hash5Tuple64(ipv4Packet.get(), true),
+	                 pcpp::hash5Tuple64(ipv4Packet->getLayerOfType<pcpp::IPv4Layer>()->getDataPtr(12),
+	                                    ipv4Packet->getLayerOfType<pcpp::IPv4Layer>()->getDataPtr(16), 4, 40000, 443,
+	                                    6, true));
+	PTF_ASSERT_EQUAL(pcpp::hash2Tuple64(ipv4Packet.get()), pcpp::hash2Tuple64(ipv4Reply.get()));
+	PTF_ASSERT_NOT_EQUAL(pcpp::hash2Tuple64(ipv4Packet.get()), pcpp::hash5Tuple64(ipv4Packet.get()));
+
+	std::unique_ptr<pcpp::Packet> ipv6Packet(
+	    createTcpPacket(pcpp::IPv6Address("2001:db8::1"), pcpp::IPv6Address("2001:db8::2"), 40000, 443));
+	std::unique_ptr<pcpp::Packet> ipv6Reply(
+	    createTcpPacket(pcpp::IPv6Address("2001:db8::2"), pcpp::IPv6Address("2001:db8::1"), 443, 40000));
+	PTF_ASSERT_EQUAL(pcpp::hash5Tuple64(ipv6Packet.get()), pcpp::hash5Tuple64(ipv6Reply.get()));
+	PTF_ASSERT_NOT_EQUAL(pcpp::hash5Tuple64(ipv6Packet.get(), true), pcpp::hash5Tuple64(ipv6Reply.get(), true));
+	PTF_ASSERT_EQUAL(pcpp::hash2Tuple64(ipv6Packet.get()), pcpp::hash2Tuple64(ipv6Reply.get()));
+	PTF_ASSERT_NOT_EQUAL(pcpp::hash5Tuple64(ipv6Packet.get()), pcpp::hash5Tuple64(ipv4Packet.get()));
+
+	// same IPs, the ports order the endpoints
+	std::unique_ptr<pcpp::Packet> sameIPPacket(
+	    createTcpPacket(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("10.0.0.1"), 5000, 4000));
+	std::unique_ptr<pcpp::Packet> sameIPReply(
+	    createTcpPacket(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("10.0.0.1"), 4000, 5000));
+	PTF_ASSERT_EQUAL(pcpp::hash5Tuple64(sameIPPacket.get()), pcpp::hash5Tuple64(sameIPReply.get()));
+	PTF_ASSERT_NOT_EQUAL(pcpp::hash5Tuple64(sameIPPacket.get(), true), pcpp::hash5Tuple64(sameIPReply.get(), true));
+
+	// packets without a 5-tuple
+	pcpp::Packet ethPacket(100);
+	ethPacket.addLayer(new pcpp::IPv4Layer(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("10.0.0.2")), true);
+	PTF_ASSERT_EQUAL(pcpp::hash5Tuple64(&ethPacket), 0);
+	PTF_ASSERT_NOT_EQUAL(pcpp::hash2Tuple64(&ethPacket), 0);
+	pcpp::Packet emptyPacket(100);
+	PTF_ASSERT_EQUAL(pcpp::hash2Tuple64(&emptyPacket), 0);
+}  // PacketUtilsHash64
+
+PTF_TEST_CASE(PacketUtilsToeplitzHash)
+{
+	// the verification suite of the Microsoft RSS specification
+	const uint8_t microsoftKey[] = { 0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2, 0x41, 0x67,
+		                             0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0, 0xd0, 0xca, 0x2b, 0xcb,
+		                             0xae, 0x7b, 0x30, 0xb4, 0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30,
+		                             0xf2, 0x0c, 0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa };
+	pcpp::ToeplitzHash microsoftHash(microsoftKey, sizeof(microsoftKey));
+	PTF_ASSERT_EQUAL(microsoftHash.getMaxInputLength(), 36);
+
+	struct RssTestVector
+	{
+		const char* dstIP;
+		uint16_t dstPort;
+		const char* srcIP;
+		uint16_t srcPort;
+		uint32_t ipHash;
+		uint32_t tcpHash;
+	};
+
+	const RssTestVector testVectors[] = {
+		{ "161.142.100.80",            1766,  "66.9.149.187",                        2794,  0x323e8fc2, 0x51ccc178 },
+		{ "65.69.140.83",              4739,  "199.92.111.2",                        14230, 0xd718262a, 0xc626b0ea },
+		{ "12.22.207.184",             38024, "24.19.198.95",                        12898, 0xd2d0a5de, 0x5c2b394a },
+		{ "209.142.163.6",             2217,  "38.27.205.30",                        48228, 0x82989176, 0xafc7327f },
+		{ "202.188.127.2",             1303,  "153.39.163.191",                      44251, 0x5d1809c5, 0x10e828a2 },
+		{ "3ffe:2501:200:3::1",        1766,  "3ffe:2501:200:1fff::7",               2794,  0x2cc18cd5, 0x40207d3d },
+		{ "ff02::1",                   4739,  "3ffe:501:8::260:97ff:fe40:efab",      14230, 0x0f0c461c, 0xdde51bbf },
+		{ "fe80::200:f8ff:fe21:67cf",  38024, "3ffe:1900:4545:3:200:f8ff:fe21:67cf", 44251, 0x4b61e985, 0x02d1feef },
+	};
+
+	for (const auto& testVector : testVectors)
+	{
+		std::unique_ptr<pcpp::Packet> packet(createTcpPacket(pcpp::IPAddress(testVector.srcIP),
+		                                                     pcpp::IPAddress(testVector.dstIP), testVector.srcPort,
+		                                                     testVector.dstPort));
+		PTF_ASSERT_EQUAL(microsoftHash.hash2Tuple(packet.get()), testVector.ipHash, hex);
+		PTF_ASSERT_EQUAL(microsoftHash.hash5Tuple(packet.get()), testVector.tcpHash, hex);
+	}
+
+	// the default key is symmetric
+	pcpp::ToeplitzHash symmetricHash;
+	PTF_ASSERT_EQUAL(symmetricHash.getMaxInputLength(), 36);
+	std::vector<int> queues(8, 0);
+	std::mt19937 random(1);
+	for (int i = 0; i < 4096; i++)
+	{
+		pcpp::IPv4Address clientIP(static_cast<uint32_t>(random()));
+		pcpp::IPv4Address serverIP(static_cast<uint32_t>(random()));
+		uint16_t clientPort = static_cast<uint16_t>(random());
+		std::unique_ptr<pcpp::Packet> request(createTcpPacket(clientIP, serverIP, clientPort, 443));
+		std::unique_ptr<pcpp::Packet> response(createTcpPacket(serverIP, clientIP, 443, clientPort));
+		uint32_t hash = symmetricHash.hash5Tuple(request.get());
+		PTF_ASSERT_EQUAL(hash, symmetricHash.hash5Tuple(response.get()));
+		PTF_ASSERT_EQUAL(symmetricHash.hash2Tuple(request.get()), symmetricHash.hash2Tuple(response.get()));
+		queues[hash % queues.size()]++;
+	}
+	// 7 degrees of freedom, the 99.9th percentile is about 24.3
+	PTF_ASSERT_LOWER_THAN(chiSquare(queues, 4096), 24.3);
+
+	// raw input
+	uint8_t input[36] = { 0 };
+	PTF_ASSERT_EQUAL(symmetricHash.hash(input, 36), 0);
+	input[0] = 0x80;
+	PTF_ASSERT_EQUAL(symmetricHash.hash(input, 1), 0x6D5A6D5A, hex);
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_EQUAL(symmetricHash.hash(input, 37), 0);
+	pcpp::ToeplitzHash shortKeyHash(microsoftKey, 4);
+	pcpp::Logger::getInstance().enableLogs();
+	PTF_ASSERT_EQUAL(shortKeyHash.getMaxInputLength(), 36);
+	pcpp::ToeplitzHash customKeyHash(microsoftKey, 12);
+	PTF_ASSERT_EQUAL(customKeyHash.getMaxInputLength(), 8);
+	PTF_ASSERT_EQUAL(customKeyHash.hash(input, 1), 0x6d5a56da, hex);
+
+	// packets without IP addresses or ports
+	pcpp::Packet ipPacket(100);
+	ipPacket.addLayer(new pcpp::IPv4Layer(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("10.0.0.2")), true);
+	PTF_ASSERT_EQUAL(symmetricHash.hash5Tuple(&ipPacket), 0);
+	pcpp::Packet emptyPacket(100);
+	PTF_ASSERT_EQUAL(symmetricHash.hash2Tuple(&emptyPacket), 0);
+}  // PacketUtilsToeplitzHash
@@ -3,6 +3,8 @@
 #include "EndianPortable.h"
 #include "Packet.h"
 #include "SSLLayer.h"
+#include "TLSFingerprint.h"
+#include "TcpLayer.h"
 #include "SystemUtils.h"
 #include <fstream>
 #include <sstream>
@@ -753,3 +755,250 @@ PTF_TEST_CASE(ServerHelloTLSFingerprintTest)
 	PTF_ASSERT_EQUAL(tlsFingerprint.toString(), "771,49195,23-65281-11-35-16");
 	PTF_ASSERT_EQUAL(tlsFingerprint.toMD5(), "eca9b8f0f3eae50309eaf901cb822d9b");
 }  // ServerHelloTLSFingerprintTest
+
+struct TLSFingerprintTestData
+{
+	std::vector<std::string> clientHelloFingerprints;
+	std::vector<std::string> serverHelloFingerprints;
+
+	static void onClientHello(int8_t side, const pcpp::TLSClientHelloFingerprint& fingerprint,
+	                          const pcpp::ConnectionData&, void* userCookie)
+	{
+		static_cast<TLSFingerprintTestData*>(userCookie)->clientHelloFingerprints.push_back(
+		    std::to_string(side) + " " + fingerprint.ja3Hash + " " + fingerprint.ja4);
+	}
+
+	static void onServerHello(int8_t side, const pcpp::TLSServerHelloFingerprint& fingerprint,
+	                          const pcpp::ConnectionData&, void* userCookie)
+	{
+		static_cast<TLSFingerprintTestData*>(userCookie)->serverHelloFingerprints.push_back(
+		    std::to_string(side) + " " + fingerprint.ja3sHash);
+	}
+};
+
+static void feedTLSFingerprintReassembly(pcpp::TLSFingerprintReassembly& reassembly, int8_t side,
+                                         const std::vector<uint8_t>& data, size_t segmentSize)
+{
+	pcpp::ConnectionData connData;
+	connData.flowKey = 1;
+	for (size_t offset = 0; offset < data.size(); offset += segmentSize)
+	{
+		pcpp::TcpStreamData tcpData(data.data() + offset, std::min(segmentSize, data.size() - offset), 0, connData,
+		                            std::chrono::high_resolution_clock::now());
+		reassembly.processTcpData(side, tcpData);
+	}
+}
+
+PTF_TEST_CASE(TLSFingerprintScannerTest)
+{
+	timeval time;
+	gettimeofday(&time, nullptr);
+
+	// the scanner produces the same JA3 strings as the SSLHandshakeLayer classes
+	std::vector<std::pair<std::string, std::string>> clientHelloFiles = {
+		{ "PacketExamples/tls1_3_client_hello1.dat", "t00d041000_16476d049b0b_78f1d400d464" },
+		{ "PacketExamples/tls1_3_client_hello2.dat", "t13d1814h2_e8a523a41297_d267a5f792d4" },
+		{ "PacketExamples/tls_grease.dat",           "t13d1515h2_8daaf6152771_de4a06bb82e3" },
+		{ "PacketExamples/SSL-ClientHello1.dat",     "t12d1109h2_43e74fd21232_fed6c16fddd0" }
+	};
+
+	std::vector<uint8_t> clientHelloPayload;
+	for (const auto& clientHelloFile : clientHelloFiles)
+	{
+		READ_FILE_AND_CREATE_PACKET(1, clientHelloFile.first.c_str());
+		pcpp::Packet clientHelloPacket(&rawPacket1);
+		pcpp::SSLClientHelloMessage* clientHelloMsg =
+		    clientHelloPacket.getLayerOfType<pcpp::SSLHandshakeLayer>()
+		        ->getHandshakeMessageOfType<pcpp::SSLClientHelloMessage>();
+		PTF_ASSERT_NOT_NULL(clientHelloMsg);
+		std::pair<std::string, std::string> expectedJa3 = clientHelloMsg->generateTLSFingerprint().toStringAndMD5();
+
+		pcpp::TcpLayer* tcpLayer = clientHelloPacket.getLayerOfType<pcpp::TcpLayer>();
+		pcpp::TLSClientHelloFingerprint fingerprint;
+		PTF_ASSERT_EQUAL(pcpp::TLSFingerprintScanner::scanClientHello(tcpLayer->getLayerPayload(),
+		                                                              tcpLayer->getLayerPayloadSize(), fingerprint),
+		                 pcpp::TLSFingerprintScanner::ScanResult::Success, enumclass);
+		PTF_ASSERT_EQUAL(std::string(fingerprint.ja3), expectedJa3.first);
+		PTF_ASSERT_EQUAL(fingerprint.ja3Length, expectedJa3.first.length());
+		PTF_ASSERT_FALSE(fingerprint.isJa3Truncated);
+		PTF_ASSERT_EQUAL(std::string(fingerprint.ja3Hash), expectedJa3.second);
+		PTF_ASSERT_EQUAL(std::string(fingerprint.ja4), clientHelloFile.second);
+		PTF_ASSERT_FALSE(fingerprint.isJa4Truncated);
+
+		clientHelloPayload.assign(tcpLayer->getLayerPayload(),
+		                          tcpLayer->getLayerPayload() + tcpLayer->getLayerPayloadSize());
+	}
+
+	// the Chrome ClientHello example of the JA4 specification published by FoxIO: GREASE values in the cipher
+	// suites, extensions, supported groups and supported versions, SNI and ALPN extensions which aren't hashed and
+	// the signature algorithms hashed in their original order
+	std::vector<uint8_t> chromeHello;
+	auto append8 = [&chromeHello](uint8_t value) { chromeHello.push_back(value); };
+	auto append16 = [&chromeHello](uint16_t value) {
+		chromeHello.push_back(static_cast<uint8_t>(value >> 8));
+		chromeHello.push_back(static_cast<uint8_t>(value));
+	};
+	auto appendExtension = [&chromeHello, &append16](uint16_t type, const std::vector<uint8_t>& data) {
+		append16(type);
+		append16(static_cast<uint16_t>(data.size()));
+		chromeHello.insert(chromeHello.end(), data.begin(), data.end());
+	};
+
+	// handshake header, its length is set at the end
+	append8(0x01);
+	append8(0);
+	append16(0);
+	append16(0x0303);
+	chromeHello.insert(chromeHello.end(), 32, 0x11);
+	append8(32);
+	chromeHello.insert(chromeHello.end(), 32, 0x22);
+	std::vector<uint16_t> chromeCipherSuites = { 0x0a0a, 0x1301, 0x1302, 0x1303, 0xc02b, 0xc02f, 0xc02c, 0xc030,
+		                                         0xcca9, 0xcca8, 0xc013, 0xc014, 0x009c, 0x009d, 0x002f, 0x0035 };
+	append16(static_cast<uint16_t>(chromeCipherSuites.size() * 2));
+	for (uint16_t cipherSuite : chromeCipherSuites)
+		append16(cipherSuite);
+	append8(1);
+	append8(0);
+
+	size_t extensionsLengthOffset = chromeHello.size();
+	append16(0);
+	appendExtension(0x1a1a, {});
+	appendExtension(0x0000, { 0x00, 0x0e, 0x00, 0x00, 0x0b, 'e', 'x', 'a', 'm', 'p', 'l', 'e', '.', 'c', 'o', 'm' });
+	appendExtension(0x0017, {});
+	appendExtension(0xff01, { 0x00 });
+	appendExtension(0x000a, { 0x00, 0x08, 0x2a, 0x2a, 0x00, 0x1d, 0x00, 0x17, 0x00, 0x18 });
+	appendExtension(0x000b, { 0x01, 0x00 });
+	appendExtension(0x0023, {});
+	appendExtension(0x0010, { 0x00, 0x0c, 0x02, 'h', '2', 0x08, 'h', 't', 't', 'p', '/', '1', '.', '1' });
+	appendExtension(0x0005, { 0x01, 0x00, 0x00, 0x00, 0x00 });
+	appendExtension(0x000d, { 0x00, 0x10, 0x04, 0x03, 0x08, 0x04, 0x04, 0x01, 0x05, 0x03, 0x08, 0x05, 0x05, 0x01,
+	                          0x08, 0x06, 0x06, 0x01 });
+	appendExtension(0x0012, {});
+	std::vector<uint8_t> keyShare = { 0x00, 0x29, 0x3a, 0x3a, 0x00, 0x01, 0x00, 0x00, 0x1d, 0x00, 0x20 };
+	keyShare.insert(keyShare.end(), 32, 0x33);
+	appendExtension(0x0033, keyShare);
+	appendExtension(0x002d, { 0x01, 0x01 });
+	appendExtension(0x002b, { 0x06, 0x6a, 0x6a, 0x03, 0x04, 0x03, 0x03 });
+	appendExtension(0x001b, { 0x02, 0x00, 0x02 });
+	appendExtension(0x4469, { 0x00, 0x03, 0x02, 'h', '2' });
+	appendExtension(0x0015, std::vector<uint8_t>(20, 0));
+	appendExtension(0xfafa, { 0x00 });
+
+	size_t extensionsLength = chromeHello.size() - extensionsLengthOffset - 2;
+	chromeHello[extensionsLengthOffset] = static_cast<uint8_t>(extensionsLength >> 8);
+	chromeHello[extensionsLengthOffset + 1] = static_cast<uint8_t>(extensionsLength);
+	size_t messageLength = chromeHello.size() - 4;
+	chromeHello[2] = static_cast<uint8_t>(messageLength >> 8);
+	chromeHello[3] = static_cast<uint8_t>(messageLength);
+
+	pcpp::TLSClientHelloFingerprint chromeFingerprint;
+	PTF_ASSERT_EQUAL(
+	    pcpp::TLSFingerprintScanner::scanClientHelloMessage(chromeHello.data(), chromeHello.size(), chromeFingerprint),
+	    pcpp::TLSFingerprintScanner::ScanResult::Success, enumclass);
+	PTF_ASSERT_EQUAL(std::string(chromeFingerprint.ja4), "t13d1516h2_8daaf6152771_e5627efa2ab1");
+
+	std::vector<std::string> serverHelloFiles = { "PacketExamples/SSL-MultipleRecords1.dat",
+		                                          "PacketExamples/tls1_3_server_hello1.dat",
+		                                          "PacketExamples/tls_server_hello.dat" };
+	std::vector<uint8_t> serverHelloPayload;
+	for (const auto& serverHelloFile : serverHelloFiles)
+	{
+		READ_FILE_AND_CREATE_PACKET(1, serverHelloFile.c_str());
+		pcpp::Packet serverHelloPacket(&rawPacket1);
+		pcpp::SSLServerHelloMessage* serverHelloMsg =
+		    serverHelloPacket.getLayerOfType<pcpp::SSLHandshakeLayer>()
+		        ->getHandshakeMessageOfType<pcpp::SSLServerHelloMessage>();
+		PTF_ASSERT_NOT_NULL(serverHelloMsg);
+		std::pair<std::string, std::string> expectedJa3s = serverHelloMsg->generateTLSFingerprint().toStringAndMD5();
+
+		pcpp::TcpLayer* tcpLayer = serverHelloPacket.getLayerOfType<pcpp::TcpLayer>();
+		pcpp::TLSServerHelloFingerprint fingerprint;
+		PTF_ASSERT_EQUAL(pcpp::TLSFingerprintScanner::scanServerHello(tcpLayer->getLayerPayload(),
+		                                                              tcpLayer->getLayerPayloadSize(), fingerprint),
+		                 pcpp::TLSFingerprintScanner::ScanResult::Success, enumclass);
+		PTF_ASSERT_EQUAL(std::string(fingerprint.ja3s), expectedJa3s.first);
+		PTF_ASSERT_EQUAL(std::string(fingerprint.ja3sHash), expectedJa3s.second);
+
+		pcpp::TLSClientHelloFingerprint clientHelloFingerprint;
+		PTF_ASSERT_EQUAL(pcpp::TLSFingerprintScanner::scanClientHello(
+		                     tcpLayer->getLayerPayload(), tcpLayer->getLayerPayloadSize(), clientHelloFingerprint),
+		                 pcpp::TLSFingerprintScanner::ScanResult::NotHello, enumclass);
+
+		serverHelloPayload.assign(tcpLayer->getLayerPayload(),
+		                          tcpLayer->getLayerPayload() + tcpLayer->getLayerPayloadSize());
+	}
+
+	// partial and malformed messages
+	pcpp::TLSClientHelloFingerprint fingerprint;
+	PTF_ASSERT_EQUAL(pcpp::TLSFingerprintScanner::scanClientHello(clientHelloPayload.data(), 100, fingerprint),
+	                 pcpp::TLSFingerprintScanner::ScanResult::NeedMoreData, enumclass);
+	PTF_ASSERT_EQUAL(pcpp::TLSFingerprintScanner::scanClientHello(clientHelloPayload.data(), 3, fingerprint),
+	                 pcpp::TLSFingerprintScanner::ScanResult::NeedMoreData, enumclass);
+	PTF_ASSERT_EQUAL(pcpp::TLSFingerprintScanner::scanClientHelloMessage(clientHelloPayload.data() + 5,
+	                                                                     clientHelloPayload.size() - 5, fingerprint),
+	                 pcpp::TLSFingerprintScanner::ScanResult::Success, enumclass);
+	std::vector<uint8_t> malformedPayload = clientHelloPayload;
+	// the cipher suites length is right after the handshake header, version, random and an empty session ID
+	PTF_ASSERT_EQUAL(malformedPayload[5 + 4 + 2 + 32], 0);
+	malformedPayload[5 + 4 + 2 + 32 + 1] = 0xff;
+	PTF_ASSERT_EQUAL(pcpp::TLSFingerprintScanner::scanClientHello(malformedPayload.data(), malformedPayload.size(),
+	                                                              fingerprint),
+	                 pcpp::TLSFingerprintScanner::ScanResult::Malformed, enumclass);
+	uint8_t notTls[] = { 0x17, 0x03, 0x03, 0x00, 0x01, 0x00 };
+	PTF_ASSERT_EQUAL(pcpp::TLSFingerprintScanner::scanClientHello(notTls, sizeof(notTls), fingerprint),
+	                 pcpp::TLSFingerprintScanner::ScanResult::NotHello, enumclass);
+
+	// hello messages split across segments and records
+	const std::string expectedClientHello = "0 07b4162d4db57554961824a21c4a0fde t12d1109h2_43e74fd21232_fed6c16fddd0";
+	size_t segmentSizes[] = { 1, 3, 100, 10000 };
+	for (size_t segmentSize : segmentSizes)
+	{
+		TLSFingerprintTestData data;
+		pcpp::TLSFingerprintReassembly reassembly(TLSFingerprintTestData::onClientHello,
+		                                          TLSFingerprintTestData::onServerHello, &data);
+		feedTLSFingerprintReassembly(reassembly, 0, clientHelloPayload, segmentSize);
+		feedTLSFingerprintReassembly(reassembly, 1, serverHelloPayload, segmentSize);
+		// later data is ignored
+		feedTLSFingerprintReassembly(reassembly, 0, clientHelloPayload, segmentSize);
+		PTF_ASSERT_VECTORS_EQUAL(data.clientHelloFingerprints, std::vector<std::string>{ expectedClientHello });
+		PTF_ASSERT_EQUAL(data.serverHelloFingerprints.size(), 1);
+		PTF_ASSERT_EQUAL(reassembly.getNumOfConnections(), 1);
+	}
+
+	std::vector<uint8_t> twoRecords(clientHelloPayload.begin(), clientHelloPayload.begin() + 5 + 50);
+	uint8_t secondRecordHeader[] = { 0x16, 0x03, 0x01, 0x00, static_cast<uint8_t>(clientHelloPayload.size() - 55) };
+	twoRecords.insert(twoRecords.end(), secondRecordHeader, secondRecordHeader + sizeof(secondRecordHeader));
+	twoRecords.insert(twoRecords.end(), clientHelloPayload.begin() + 55, clientHelloPayload.end());
+	twoRecords[4] = 50;
+	PTF_ASSERT_EQUAL(pcpp::TLSFingerprintScanner::scanClientHello(twoRecords.data(), twoRecords.size(), fingerprint),
+	                 pcpp::TLSFingerprintScanner::ScanResult::NeedMoreData, enumclass);
+	for (size_t segmentSize : segmentSizes)
+	{
+		TLSFingerprintTestData data;
+		pcpp::TLSFingerprintReassembly reassembly(TLSFingerprintTestData::onClientHello,
+		                                          TLSFingerprintTestData::onServerHello, &data);
+		feedTLSFingerprintReassembly(reassembly, 0, twoRecords, segmentSize);
+		PTF_ASSERT_VECTORS_EQUAL(data.clientHelloFingerprints, std::vector<std::string>{ expectedClientHello });
+	}
+
+	// non-TLS data and lost data stop the scan
+	{
+		TLSFingerprintTestData data;
+		pcpp::TLSFingerprintReassembly reassembly(TLSFingerprintTestData::onClientHello,
+		                                          TLSFingerprintTestData::onServerHello, &data);
+		feedTLSFingerprintReassembly(reassembly, 0, std::vector<uint8_t>(notTls, notTls + sizeof(notTls)), 100);
+		feedTLSFingerprintReassembly(reassembly, 0, clientHelloPayload, 100);
+
+		pcpp::ConnectionData connData;
+		connData.flowKey = 1;
+		pcpp::TcpStreamData tcpData(serverHelloPayload.data(), serverHelloPayload.size(), 10, connData,
+		                            std::chrono::high_resolution_clock::now());
+		reassembly.processTcpData(1, tcpData);
+		feedTLSFingerprintReassembly(reassembly, 1, serverHelloPayload, 100);
+
+		PTF_ASSERT_TRUE(data.clientHelloFingerprints.empty());
+		PTF_ASSERT_TRUE(data.serverHelloFingerprints.empty());
+		reassembly.closeConnection(connData);
+		PTF_ASSERT_EQUAL(reassembly.getNumOfConnections(), 0);
+	}
+}  // TLSFingerprintScannerTest
@@ -0,0 +1,340 @@
+#include "../TestDefinition.h"
+#include "EndianPortable.h"
+#include "Packet.h"
+#include "EthLayer.h"
+#include "VlanLayer.h"
+#include "IPv4Layer.h"
+#include "IPv6Layer.h"
+#include "TcpLayer.h"
+#include "UdpLayer.h"
+#include "VxlanLayer.h"
+#include "GreLayer.h"
+#include "GtpLayer.h"
+#include "PayloadLayer.h"
+#include "TunnelEncapsulation.h"
+#include "Logger.h"
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	const uint8_t innerPayload[] = "inner packet payload";
+
+	// Build an Ethernet/IP/UDP packet
+	void buildInnerPacket(pcpp::Packet& packet, bool isIPv6)
+	{
+		packet.addLayer(
+		    new pcpp::EthLayer(pcpp::MacAddress("00:00:00:00:00:01"), pcpp::MacAddress("00:00:00:00:00:02")), true);
+		if (isIPv6)
+			packet.addLayer(new pcpp::IPv6Layer(pcpp::IPv6Address("fe80::1"), pcpp::IPv6Address("fe80::2")), true);
+		else
+			packet.addLayer(new pcpp::IPv4Layer(pcpp::IPv4Address("192.168.0.1"), pcpp::IPv4Address("192.168.0.2")),
+			                true);
+		packet.addLayer(new pcpp::UdpLayer(40000, 9999), true);
+		packet.addLayer(new pcpp::PayloadLayer(innerPayload, sizeof(innerPayload)), true);
+		packet.computeCalculateFields();
+	}
+
+	// Parse a copy of an encapsulated packet, compute all of its calculated fields and check that nothing changed.
+	// UDP checksums over IPv4 aren't computed by the encapsulator, so the outer one is zeroed again before comparing
+	bool hasValidOuterFields(const pcpp::RawPacket& rawPacket, bool zeroOuterUdpChecksum)
+	{
+		size_t dataLen = static_cast<size_t>(rawPacket.getRawDataLen());
+		uint8_t* dataCopy = new uint8_t[dataLen];
+		memcpy(dataCopy, rawPacket.getRawData(), dataLen);
+		timeval time = { 0, 0 };
+		pcpp::RawPacket rawPacketCopy(dataCopy, static_cast<int>(dataLen), time, true);
+		pcpp::Packet packet(&rawPacketCopy);
+		packet.computeCalculateFields();
+		pcpp::UdpLayer* udpLayer = packet.getLayerOfType<pcpp::UdpLayer>();
+		if (zeroOuterUdpChecksum && udpLayer != nullptr)
+			udpLayer->getUdpHeader()->headerChecksum = 0;
+
+		return memcmp(rawPacketCopy.getRawData(), rawPacket.getRawData(), dataLen) == 0;
+	}
+}  // namespace
+
+PTF_TEST_CASE(TunnelEncapsulationTest)
+{
+	pcpp::EthLayer outerEthLayer(pcpp::MacAddress("aa:aa:aa:aa:aa:01"), pcpp::MacAddress("aa:aa:aa:aa:aa:02"));
+	pcpp::IPv4Layer outerIPv4Layer(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("10.0.0.2"));
+	outerIPv4Layer.getIPv4Header()->timeToLive = 32;
+	outerIPv4Layer.getIPv4Header()->ipId = htobe16(1234);
+	pcpp::IPv6Layer outerIPv6Layer(pcpp::IPv6Address("2001:db8::1"), pcpp::IPv6Address("2001:db8::2"));
+	outerIPv6Layer.getIPv6Header()->hopLimit = 32;
+
+	// VXLAN over IPv4, the inner packet has enough headroom
+	{
+		pcpp::Packet outerHeaders;
+		PTF_ASSERT_TRUE(outerHeaders.addLayer(new pcpp::EthLayer(outerEthLayer), true));
+		PTF_ASSERT_TRUE(outerHeaders.addLayer(new pcpp::IPv4Layer(outerIPv4Layer), true));
+		PTF_ASSERT_TRUE(outerHeaders.addLayer(new pcpp::UdpLayer(50000, 4789), true));
+		PTF_ASSERT_TRUE(outerHeaders.addLayer(new pcpp::VxlanLayer(100), true));
+
+		pcpp::TunnelEncapsulator encapsulator(outerHeaders);
+		PTF_ASSERT_TRUE(encapsulator.isValid());
+		PTF_ASSERT_EQUAL(encapsulator.getTunnelType(), pcpp::TunnelType::VXLAN, enumclass);
+		PTF_ASSERT_EQUAL(encapsulator.getHeaderLen(), 50);
+
+		pcpp::Packet innerPacket(100, 64);
+		buildInnerPacket(innerPacket, false);
+		pcpp::RawPacket* rawPacket = innerPacket.getRawPacket();
+		std::vector<uint8_t> original(rawPacket->getRawData(), rawPacket->getRawData() + rawPacket->getRawDataLen());
+		const uint8_t* originalData = rawPacket->getRawData();
+
+		PTF_ASSERT_TRUE(encapsulator.encapsulate(*rawPacket));
+		PTF_ASSERT_EQUAL(rawPacket->getRawData(), originalData - 50, ptr);
+		PTF_ASSERT_EQUAL(rawPacket->getRawDataLen(), static_cast<int>(original.size() + 50));
+		PTF_ASSERT_TRUE(hasValidOuterFields(*rawPacket, true));
+		PTF_ASSERT_BUF_COMPARE(rawPacket->getRawData() + 50, original.data(), original.size());
+
+		pcpp::TunnelType tunnelType = pcpp::TunnelType::IPinIP;
+		PTF_ASSERT_TRUE(pcpp::decapsulateTunnel(*rawPacket, &tunnelType));
+		PTF_ASSERT_EQUAL(tunnelType, pcpp::TunnelType::VXLAN, enumclass);
+		PTF_ASSERT_EQUAL(rawPacket->getRawData(), originalData, ptr);
+		PTF_ASSERT_EQUAL(rawPacket->getRawDataLen(), static_cast<int>(original.size()));
+		PTF_ASSERT_BUF_COMPARE(rawPacket->getRawData(), original.data(), original.size());
+	}
+
+	// GTP-U with a sequence number over VLAN and IPv6, the inner packet has no headroom
+	{
+		pcpp::Packet outerHeaders;
+		PTF_ASSERT_TRUE(outerHeaders.addLayer(new pcpp::EthLayer(outerEthLayer), true));
+		PTF_ASSERT_TRUE(outerHeaders.addLayer(new pcpp::VlanLayer(20, false, 0), true));
+		PTF_ASSERT_TRUE(outerHeaders.addLayer(new pcpp::IPv6Layer(outerIPv6Layer), true));
+		PTF_ASSERT_TRUE(outerHeaders.addLayer(new pcpp::UdpLayer(2152, 2152), true));
+		PTF_ASSERT_TRUE(
+		    outerHeaders.addLayer(new pcpp::GtpV1Layer(pcpp::GtpV1_GPDU, 0xabcd, true, 7, false, 0), true));
+
+		pcpp::TunnelEncapsulator encapsulator(outerHeaders);
+		PTF_ASSERT_TRUE(encapsulator.isValid());
+		PTF_ASSERT_EQUAL(encapsulator.getTunnelType(), pcpp::TunnelType::GTPv1U, enumclass);
+		PTF_ASSERT_EQUAL(encapsulator.getHeaderLen(), 18 + 40 + 8 + 12);
+
+		pcpp::Packet innerPacket(100);
+		buildInnerPacket(innerPacket, false);
+		pcpp::RawPacket rawPacket(*innerPacket.getRawPacket());
+		PTF_ASSERT_EQUAL(rawPacket.getHeadroom(), 0);
+		std::vector<uint8_t> original(rawPacket.getRawData(), rawPacket.getRawData() + rawPacket.getRawDataLen());
+
+		PTF_ASSERT_TRUE(encapsulator.encapsulate(rawPacket));
+		PTF_ASSERT_EQUAL(rawPacket.getRawDataLen(), static_cast<int>(original.size() - 14 + 78));
+		PTF_ASSERT_TRUE(hasValidOuterFields(rawPacket, false));
+		PTF_ASSERT_BUF_COMPARE(rawPacket.getRawData() + 78, original.data() + 14, original.size() - 14);
+
+		pcpp::Packet parsedPacket(&rawPacket);
+		PTF_ASSERT_NOT_NULL(parsedPacket.getLayerOfType<pcpp::GtpV1Layer>());
+		PTF_ASSERT_EQUAL(parsedPacket.getLayerOfType<pcpp::IPv4Layer>()->getDstIPv4Address(),
+		                 pcpp::IPv4Address("192.168.0.2"));
+
+		pcpp::TunnelType tunnelType = pcpp::TunnelType::VXLAN;
+		PTF_ASSERT_TRUE(pcpp::decapsulateTunnel(rawPacket, &tunnelType));
+		PTF_ASSERT_EQUAL(tunnelType, pcpp::TunnelType::GTPv1U, enumclass);
+		// the outer Ethernet header and VLAN tag are kept in front of the inner IP packet
+		PTF_ASSERT_EQUAL(rawPacket.getRawDataLen(), static_cast<int>(original.size() + 4));
+		PTF_ASSERT_BUF_COMPARE(rawPacket.getRawData(), outerHeaders.getRawPacket()->getRawData(), 16);
+		PTF_ASSERT_EQUAL(rawPacket.getRawData()[16], 0x08);
+		PTF_ASSERT_EQUAL(rawPacket.getRawData()[17], 0x00);
+		PTF_ASSERT_BUF_COMPARE(rawPacket.getRawData() + 18, original.data() + 14, original.size() - 14);
+	}
+
+	// GRE with a key over IPv4, carrying Ethernet frames and IP packets
+	{
+		pcpp::Packet outerHeaders;
+		pcpp::GREv0Layer* greLayer = new pcpp::GREv0Layer();
+		PTF_ASSERT_TRUE(outerHeaders.addLayer(new pcpp::EthLayer(outerEthLayer), true));
+		PTF_ASSERT_TRUE(outerHeaders.addLayer(new pcpp::IPv4Layer(outerIPv4Layer), true));
+		PTF_ASSERT_TRUE(outerHeaders.addLayer(greLayer, true));
+		PTF_ASSERT_TRUE(greLayer->setKey(0x1234));
+		greLayer->getGreHeader()->protocol = htobe16(PCPP_ETHERTYPE_ETHBRIDGE);
+
+		pcpp::TunnelEncapsulator ethEncapsulator(outerHeaders);
+		PTF_ASSERT_TRUE(ethEncapsulator.isValid());
+		PTF_ASSERT_EQUAL(ethEncapsulator.getTunnelType(), pcpp::TunnelType::GRE, enumclass);
+		PTF_ASSERT_EQUAL(ethEncapsulator.getHeaderLen(), 14 + 20 + 8);
+
+		pcpp::Packet innerPacket(100, 64);
+		buildInnerPacket(innerPacket, true);
+		pcpp::RawPacket* rawPacket = innerPacket.getRawPacket();
+		std::vector<uint8_t> original(rawPacket->getRawData(), rawPacket->getRawData() + rawPacket->getRawDataLen());
+
+		PTF_ASSERT_TRUE(ethEncapsulator.encapsulate(*rawPacket));
+		PTF_ASSERT_TRUE(hasValidOuterFields(*rawPacket, false));
+		PTF_ASSERT_BUF_COMPARE(rawPacket->getRawData() + 42, original.data(), original.size());
+		pcpp::TunnelType tunnelType = pcpp::TunnelType::VXLAN;
+		PTF_ASSERT_TRUE(pcpp::decapsulateTunnel(*rawPacket, &tunnelType));
+		PTF_ASSERT_EQUAL(tunnelType, pcpp::TunnelType::GRE, enumclass);
+		PTF_ASSERT_EQUAL(rawPacket->getRawDataLen(), static_cast<int>(original.size()));
+		PTF_ASSERT_BUF_COMPARE(rawPacket->getRawData(), original.data(), original.size());
+
+		greLayer->getGreHeader()->protocol = 0;
+		pcpp::TunnelEncapsulator ipEncapsulator(outerHeaders);
+		PTF_ASSERT_TRUE(ipEncapsulator.isValid());
+		PTF_ASSERT_TRUE(ipEncapsulator.encapsulate(*rawPacket));
+		PTF_ASSERT_EQUAL(rawPacket->getRawDataLen(), static_cast<int>(original.size() - 14 + 42));
+		PTF_ASSERT_TRUE(hasValidOuterFields(*rawPacket, false));
+		PTF_ASSERT_EQUAL(rawPacket->getRawData()[36], 0x86);
+		PTF_ASSERT_EQUAL(rawPacket->getRawData()[37], 0xdd);
+		PTF_ASSERT_TRUE(pcpp::decapsulateTunnel(*rawPacket));
+		PTF_ASSERT_EQUAL(rawPacket->getRawDataLen(), static_cast<int>(original.size()));
+		PTF_ASSERT_BUF_COMPARE(rawPacket->getRawData(), outerHeaders.getRawPacket()->getRawData(), 12);
+		PTF_ASSERT_BUF_COMPARE(rawPacket->getRawData() + 12, original.data() + 12, original.size() - 12);
+	}
+
+	// IPv6 over IPv4
+	{
+		pcpp::Packet outerHeaders;
+		PTF_ASSERT_TRUE(outerHeaders.addLayer(new pcpp::EthLayer(outerEthLayer), true));
+		PTF_ASSERT_TRUE(outerHeaders.addLayer(new pcpp::IPv4Layer(outerIPv4Layer), true));
+
+		pcpp::TunnelEncapsulator encapsulator(outerHeaders);
+		PTF_ASSERT_TRUE(encapsulator.isValid());
+		PTF_ASSERT_EQUAL(encapsulator.getTunnelType(), pcpp::TunnelType::IPinIP, enumclass);
+
+		pcpp::Packet innerPacket(100, 64);
+		buildInnerPacket(innerPacket, true);
+		pcpp::RawPacket* rawPacket = innerPacket.getRawPacket();
+		std::vector<uint8_t> original(rawPacket->getRawData(), rawPacket->getRawData() + rawPacket->getRawDataLen());
+
+		PTF_ASSERT_TRUE(encapsulator.encapsulate(*rawPacket));
+		PTF_ASSERT_EQUAL(rawPacket->getRawDataLen(), static_cast<int>(original.size() + 20));
+		PTF_ASSERT_EQUAL(reinterpret_cast<const pcpp::iphdr*>(rawPacket->getRawData() + 14)->protocol,
+		                 pcpp::PACKETPP_IPPROTO_IPV6);
+		PTF_ASSERT_TRUE(hasValidOuterFields(*rawPacket, false));
+
+		pcpp::TunnelType tunnelType = pcpp::TunnelType::VXLAN;
+		PTF_ASSERT_TRUE(pcpp::decapsulateTunnel(*rawPacket, &tunnelType));
+		PTF_ASSERT_EQUAL(tunnelType, pcpp::TunnelType::IPinIP, enumclass);
+		PTF_ASSERT_EQUAL(rawPacket->getRawDataLen(), static_cast<int>(original.size()));
+		PTF_ASSERT_BUF_COMPARE(rawPacket->getRawData() + 12, original.data() + 12, original.size() - 12);
+	}
+
+	// packets that aren't tunnels and outer headers that aren't supported
+	{
+		pcpp::Packet innerPacket(100);
+		buildInnerPacket(innerPacket, false);
+		pcpp::RawPacket* rawPacket = innerPacket.getRawPacket();
+		std::vector<uint8_t> original(rawPacket->getRawData(), rawPacket->getRawData() + rawPacket->getRawDataLen());
+		PTF_ASSERT_FALSE(pcpp::decapsulateTunnel(*rawPacket));
+		PTF_ASSERT_EQUAL(rawPacket->getRawDataLen(), static_cast<int>(original.size()));
+		PTF_ASSERT_BUF_COMPARE(rawPacket->getRawData(), original.data(), original.size());
+
+		pcpp::Packet outerHeaders;
+		PTF_ASSERT_TRUE(outerHeaders.addLayer(new pcpp::EthLayer(outerEthLayer), true));
+		PTF_ASSERT_TRUE(outerHeaders.addLayer(new pcpp::IPv4Layer(outerIPv4Layer), true));
+		PTF_ASSERT_TRUE(outerHeaders.addLayer(new pcpp::TcpLayer(1000, 80), true));
+
+		pcpp::Logger::getInstance().suppressLogs();
+		pcpp::TunnelEncapsulator encapsulator(outerHeaders);
+		PTF_ASSERT_FALSE(encapsulator.isValid());
+		PTF_ASSERT_FALSE(encapsulator.encapsulate(*rawPacket));
+
+		// GTP-U carries IP packets only
+		pcpp::Packet gtpHeaders;
+		PTF_ASSERT_TRUE(gtpHeaders.addLayer(new pcpp::EthLayer(outerEthLayer), true));
+		PTF_ASSERT_TRUE(gtpHeaders.addLayer(new pcpp::IPv4Layer(outerIPv4Layer), true));
+		PTF_ASSERT_TRUE(gtpHeaders.addLayer(new pcpp::UdpLayer(2152, 2152), true));
+		PTF_ASSERT_TRUE(gtpHeaders.addLayer(new pcpp::GtpV1Layer(pcpp::GtpV1_GPDU, 1), true));
+		pcpp::TunnelEncapsulator gtpEncapsulator(gtpHeaders);
+		PTF_ASSERT_TRUE(gtpEncapsulator.isValid());
+		uint8_t arpFrame[42] = { 0 };
+		arpFrame[12] = 0x08;
+		arpFrame[13] = 0x06;
+		timeval time = { 0, 0 };
+		pcpp::RawPacket arpPacket(arpFrame, sizeof(arpFrame), time, false);
+		PTF_ASSERT_FALSE(gtpEncapsulator.encapsulate(arpPacket));
+		PTF_ASSERT_EQUAL(arpPacket.getRawDataLen(), 42);
+		pcpp::Logger::getInstance().enableLogs();
+	}
+
+	// the outer IPv4 total length and IPv6 payload length must fit the encapsulated packet
+	{
+		pcpp::Packet ipv4Headers;
+		PTF_ASSERT_TRUE(ipv4Headers.addLayer(new pcpp::EthLayer(outerEthLayer), true));
+		PTF_ASSERT_TRUE(ipv4Headers.addLayer(new pcpp::IPv4Layer(outerIPv4Layer), true));
+		PTF_ASSERT_TRUE(ipv4Headers.addLayer(new pcpp::UdpLayer(50000, 4789), true));
+		PTF_ASSERT_TRUE(ipv4Headers.addLayer(new pcpp::VxlanLayer(100), true));
+		pcpp::TunnelEncapsulator ipv4Encapsulator(ipv4Headers);
+		PTF_ASSERT_TRUE(ipv4Encapsulator.isValid());
+
+		pcpp::Packet ipv6Headers;
+		PTF_ASSERT_TRUE(ipv6Headers.addLayer(new pcpp::EthLayer(outerEthLayer), true));
+		PTF_ASSERT_TRUE(ipv6Headers.addLayer(new pcpp::IPv6Layer(outerIPv6Layer), true));
+		PTF_ASSERT_TRUE(ipv6Headers.addLayer(new pcpp::UdpLayer(50000, 4789), true));
+		PTF_ASSERT_TRUE(ipv6Headers.addLayer(new pcpp::VxlanLayer(100), true));
+		pcpp::TunnelEncapsulator ipv6Encapsulator(ipv6Headers);
+		PTF_ASSERT_TRUE(ipv6Encapsulator.isValid());
+
+		// the outer IPv4 total length is the frame length + 36, the IPv6 payload length is the frame length + 16
+		const size_t maxIPv4FrameLen = 0xffff - 36;
+		const size_t maxIPv6FrameLen = 0xffff - 16;
+		std::vector<uint8_t> frame(maxIPv6FrameLen + 1);
+		timeval time = { 0, 0 };
+
+		pcpp::RawPacket ipv4Packet(frame.data(), static_cast<int>(maxIPv4FrameLen), time, false);
+		PTF_ASSERT_TRUE(ipv4Encapsulator.encapsulate(ipv4Packet));
+		PTF_ASSERT_EQUAL(be16toh(reinterpret_cast<const pcpp::iphdr*>(ipv4Packet.getRawData() + 14)->totalLength),
+		                 0xffff);
+
+		pcpp::RawPacket ipv6Packet(frame.data(), static_cast<int>(maxIPv6FrameLen), time, false);
+		PTF_ASSERT_TRUE(ipv6Encapsulator.encapsulate(ipv6Packet));
+		PTF_ASSERT_EQUAL(be16toh(reinterpret_cast<const pcpp::ip6_hdr*>(ipv6Packet.getRawData() + 14)->payloadLength),
+		                 0xffff);
+
+		pcpp::Logger::getInstance().suppressLogs();
+		pcpp::RawPacket longIPv4Packet(frame.data(), static_cast<int>(maxIPv4FrameLen + 1), time, false);
+		PTF_ASSERT_FALSE(ipv4Encapsulator.encapsulate(longIPv4Packet));
+		PTF_ASSERT_EQUAL(longIPv4Packet.getRawData(), frame.data(), ptr);
+		PTF_ASSERT_EQUAL(longIPv4Packet.getRawDataLen(), static_cast<int>(maxIPv4FrameLen + 1));
+
+		pcpp::RawPacket longIPv6Packet(frame.data(), static_cast<int>(maxIPv6FrameLen + 1), time, false);
+		PTF_ASSERT_FALSE(ipv6Encapsulator.encapsulate(longIPv6Packet));
+		PTF_ASSERT_EQUAL(longIPv6Packet.getRawData(), frame.data(), ptr);
+		PTF_ASSERT_EQUAL(longIPv6Packet.getRawDataLen(), static_cast<int>(maxIPv6FrameLen + 1));
+		pcpp::Logger::getInstance().enableLogs();
+	}
+}  // TunnelEncapsulationTest
+
+PTF_TEST_CASE(TunnelEncapsulationBatchTest)
+{
+	pcpp::Packet outerHeaders;
+	PTF_ASSERT_TRUE(outerHeaders.addLayer(
+	    new pcpp::EthLayer(pcpp::MacAddress("aa:aa:aa:aa:aa:01"), pcpp::MacAddress("aa:aa:aa:aa:aa:02")), true));
+	PTF_ASSERT_TRUE(outerHeaders.addLayer(
+	    new pcpp::IPv4Layer(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("10.0.0.2")), true));
+	PTF_ASSERT_TRUE(outerHeaders.addLayer(new pcpp::UdpLayer(50000, 4789), true));
+	PTF_ASSERT_TRUE(outerHeaders.addLayer(new pcpp::VxlanLayer(7), true));
+	pcpp::TunnelEncapsulator encapsulator(outerHeaders);
+	PTF_ASSERT_TRUE(encapsulator.isValid());
+
+	pcpp::Packet innerPacket(100);
+	buildInnerPacket(innerPacket, false);
+	const pcpp::RawPacket* innerRawPacket = innerPacket.getRawPacket();
+	std::vector<uint8_t> original(innerRawPacket->getRawData(),
+	                              innerRawPacket->getRawData() + innerRawPacket->getRawDataLen());
+
+	std::vector<pcpp::RawPacket> rawPackets(4, *innerRawPacket);
+	PTF_ASSERT_EQUAL(encapsulator.encapsulate(rawPackets.data(), rawPackets.size()), 4);
+	for (const pcpp::RawPacket& rawPacket : rawPackets)
+	{
+		PTF_ASSERT_EQUAL(rawPacket.getRawDataLen(), static_cast<int>(original.size() + 50));
+		PTF_ASSERT_TRUE(hasValidOuterFields(rawPacket, true));
+	}
+
+	// a packet that isn't a tunnel in the middle of the batch is skipped
+	pcpp::RawPacket plainPacket(*innerRawPacket);
+	pcpp::RawPacket* rawPacketPtrs[] = { &rawPackets[0], &rawPackets[1], &plainPacket, &rawPackets[2], nullptr };
+	PTF_ASSERT_EQUAL(pcpp::decapsulateTunnel(rawPacketPtrs, 5), 3);
+	PTF_ASSERT_EQUAL(pcpp::decapsulateTunnel(&rawPackets[3], 1), 1);
+	for (const pcpp::RawPacket& rawPacket : rawPackets)
+	{
+		PTF_ASSERT_EQUAL(rawPacket.getRawDataLen(), static_cast<int>(original.size()));
+		PTF_ASSERT_BUF_COMPARE(rawPacket.getRawData(), original.data(), original.size());
+	}
+	PTF_ASSERT_BUF_COMPARE(plainPacket.getRawData(), original.data(), original.size());
+
+	pcpp::RawPacket* encapsulatePtrs[] = { &rawPackets[0], nullptr, &rawPackets[1] };
+	PTF_ASSERT_EQUAL(encapsulator.encapsulate(encapsulatePtrs, 3), 2);
+	PTF_ASSERT_EQUAL(rawPackets[1].getRawDataLen(), static_cast<int>(original.size() + 50));
+	PTF_ASSERT_EQUAL(rawPackets[2].getRawDataLen(), static_cast<int>(original.size()));
+}  // TunnelEncapsulationBatchTest
@@ -146,6 +146,22 @@ int main(int argc, char* argv[])
 	PTF_RUN_TEST(PacketUtilsHash5TupleUdp, "udp");
 	PTF_RUN_TEST(PacketUtilsHash5TupleTcp, "tcp");
 	PTF_RUN_TEST(PacketUtilsHash5TupleIPv6, "ipv6");
+	PTF_RUN_TEST(PacketUtilsHash64, "hash");
+	PTF_RUN_TEST(PacketUtilsToeplitzHash, "hash");
+
+	PTF_RUN_TEST(FlowKeyFromPacketTest, "flow_table");
+	PTF_RUN_TEST(FiveTupleTest, "flow_table");
+	PTF_RUN_TEST(FlowTableTest, "flow_table");
+
+	PTF_RUN_TEST(FlowMeterTest, "flow_meter");
+	PTF_RUN_TEST(FlowExportIpfixTest, "flow_meter;ipfix");
+	PTF_RUN_TEST(FlowExportFileTest, "flow_meter");
+
+	PTF_RUN_TEST(PacketTemplateTest, "packet_template");
+	PTF_RUN_TEST(PacketTemplateBatchTest, "packet_template");
+
+	PTF_RUN_TEST(TunnelEncapsulationTest, "tunnel");
+	PTF_RUN_TEST(TunnelEncapsulationBatchTest, "tunnel");
 
 	PTF_RUN_TEST(InsertDataToPacket, "packet;insert");
 	PTF_RUN_TEST(CreatePacketFromBuffer, "packet");
@@ -160,6 +176,9 @@ int main(int argc, char* argv[])
 	PTF_RUN_TEST(PrintPacketAndLayersTest, "packet;print");
 	PTF_RUN_TEST(ProtocolFamilyMembershipTest, "packet");
 	PTF_RUN_TEST(PacketParseLayerLimitTest, "packet");
+	PTF_RUN_TEST(PortDissectorTableTest, "packet");
+	PTF_RUN_TEST(InstrumentationTest, "packet;instrumentation");
+	PTF_RUN_TEST(PacketHeadroomTest, "packet;insert;remove_layer");
 
 	PTF_RUN_TEST(HttpRequestParseMethodTest, "http");
 	PTF_RUN_TEST(HttpRequestLayerParsingTest, "http");
@@ -171,6 +190,8 @@ int main(int argc, char* argv[])
 	PTF_RUN_TEST(HttpResponseLayerCreationTest, "http");
 	PTF_RUN_TEST(HttpResponseLayerEditTest, "http");
 	PTF_RUN_TEST(HttpMalformedResponseTest, "http");
+	PTF_RUN_TEST(HttpFieldLookupTest, "http");
+	PTF_RUN_TEST(HttpReassemblyTest, "http;http_reassembly");
 
 	PTF_RUN_TEST(PPPoESessionLayerParsingTest, "pppoe");
 	PTF_RUN_TEST(PPPoESessionLayerCreationTest, "pppoe");
@@ -185,6 +206,7 @@ int main(int argc, char* argv[])
 	PTF_RUN_TEST(DnsOverTcpParsingTest, "dns");
 	PTF_RUN_TEST(DnsOverTcpCreationTest, "dns");
 	PTF_RUN_TEST(DnsLayerAddDnsKeyTest, "dns");
+	PTF_RUN_TEST(DnsViewTest, "dns");
 
 	PTF_RUN_TEST(IcmpParsingTest, "icmp");
 	PTF_RUN_TEST(IcmpCreationTest, "icmp");
@@ -210,6 +232,7 @@ int main(int argc, char* argv[])
 	PTF_RUN_TEST(TLSCipherSuiteTest, "ssl");
 	PTF_RUN_TEST(ClientHelloTLSFingerprintTest, "ssl");
 	PTF_RUN_TEST(ServerHelloTLSFingerprintTest, "ssl");
+	PTF_RUN_TEST(TLSFingerprintScannerTest, "ssl");
 
 	PTF_RUN_TEST(SllPacketParsingTest, "sll");
 	PTF_RUN_TEST(SllPacketCreationTest, "sll");
@@ -331,6 +354,8 @@ int main(int argc, char* argv[])
 
 	PTF_RUN_TEST(Asn1DecodingTest, "asn1");
 	PTF_RUN_TEST(Asn1EncodingTest, "asn1");
+	PTF_RUN_TEST(Asn1ReaderTest, "asn1");
+	PTF_RUN_TEST(Asn1WriterTest, "asn1");
 
 	PTF_RUN_TEST(LdapParsingTest, "ldap");
 	PTF_RUN_TEST(LdapCreationTest, "ldap");
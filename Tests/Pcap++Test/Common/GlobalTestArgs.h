@@ -10,5 +10,6 @@ struct PcapTestArgs
 	std::string remoteIp;
 	uint16_t remotePort;
 	int dpdkPort;
+	std::string dpdkVdev;
 	std::string kniIp;
 };
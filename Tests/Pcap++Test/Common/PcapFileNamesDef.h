@@ -21,6 +21,8 @@
 #define EXAMPLE_PCAPNG_ZSTD_WRITE_PATH "PcapExamples/many_interfaces_copy.pcapng.zstd"
 #define EXAMPLE2_PCAPNG_ZSTD_WRITE_PATH "PcapExamples/pcapng-example-write.pcapng.zstd"
 #define EXAMPLE2_PCAPNG_ZST_WRITE_PATH "PcapExamples/pcapng-example-write.pcapng.zst"
+#define EXAMPLE2_PCAPNG_ZST_PARALLEL_WRITE_PATH "PcapExamples/pcapng-example-parallel.pcapng.zst"
+#define EXAMPLE_PCAPNG_BIG_ENDIAN_WRITE_PATH "PcapExamples/big-endian-write.pcapng"
 #define EXAMPLE_PCAPNG_INTERFACES_PATH "PcapExamples/too_many_interfaces.pcapng"
 #define EXAMPLE_PCAP_GRE "PcapExamples/GrePackets.cap"
 #define EXAMPLE_PCAP_IGMP "PcapExamples/IgmpPackets.pcap"
@@ -34,3 +36,7 @@
 #define EXAMPLE_PCAP_DESTRUCTOR2_PATH "PcapExamples/destructor2.pcap"
 #define EXAMPLE_PCAP_NANO_PATH "PcapExamples/nanosecs.pcap"
 #define EXAMPLE_PCAPNG_NANO_PATH "PcapExamples/nanosecs.pcapng"
+#define EXAMPLE_PCAP_ROTATING_PATH_PATTERN "PcapExamples/rotating_{index}.pcap"
+#define EXAMPLE_PCAPNG_ROTATING_PATH_PATTERN "PcapExamples/rotating_ng_{index}.pcapng"
+#define EXAMPLE_PCAP_ROTATING_NO_INDEX_PATH "PcapExamples/rotating_no_index.pcap"
+#define EXAMPLE_PCAP_ROTATING_TIME_PATH_PATTERN "PcapExamples/rotating_time_%Y.pcap"
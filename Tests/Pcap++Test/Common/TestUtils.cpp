@@ -105,7 +105,16 @@ void testSetUp()
 		{
 			coreMask |= pcpp::SystemCores::IdToSystemCore[i].Mask;
 		}
-		pcpp::DpdkDeviceList::initDpdk(coreMask, 16383);
+		if (PcapTestGlobalArgs.dpdkVdev.empty())
+		{
+			pcpp::DpdkDeviceList::initDpdk(coreMask, 16383);
+		}
+		else
+		{
+			std::string vdevArg = "--vdev=" + PcapTestGlobalArgs.dpdkVdev;
+			char* dpdkArgs[] = { (char*)"--no-huge", (char*)"--no-pci", (char*)vdevArg.c_str() };
+			pcpp::DpdkDeviceList::initDpdk(coreMask, 16383, 0, 0, 3, dpdkArgs, "pcapplusplusapp", false);
+		}
 	}
 #endif
 }
@@ -15,6 +15,8 @@ PTF_TEST_CASE(TestIPNetwork);
 // Implemented in LoggerTests.cpp
 PTF_TEST_CASE(TestLogger);
 PTF_TEST_CASE(TestLoggerMultiThread);
+PTF_TEST_CASE(TestLoggerAsync);
+PTF_TEST_CASE(TestLoggerRateLimit);
 
 // Implemented in FileTests.cpp
 PTF_TEST_CASE(TestPcapFileReadWrite);
@@ -26,11 +28,18 @@ PTF_TEST_CASE(TestPcapFileAppend);
 PTF_TEST_CASE(TestPcapNgFileReadWrite);
 PTF_TEST_CASE(TestPcapNgFileReadWriteAdv);
 PTF_TEST_CASE(TestPcapNgFileTooManyInterfaces);
+PTF_TEST_CASE(TestPcapNgFileParallelCompression);
+PTF_TEST_CASE(TestPcapNgFileZeroCopyRead);
 PTF_TEST_CASE(TestPcapFileReadLinkTypeIPv6);
 PTF_TEST_CASE(TestPcapFileReadLinkTypeIPv4);
 PTF_TEST_CASE(TestSolarisSnoopFileRead);
 PTF_TEST_CASE(TestPcapNgFilePrecision);
 PTF_TEST_CASE(TestPcapFileWriterDeviceDestructor);
+PTF_TEST_CASE(TestRotatingFileWriterDevice);
+
+// Implemented in RssDispatcherTests.cpp
+PTF_TEST_CASE(TestRssDispatcherHashing);
+PTF_TEST_CASE(TestRssDispatcher);
 
 // Implemented in LiveDeviceTests.cpp
 PTF_TEST_CASE(TestPcapLiveDeviceList);
@@ -81,6 +90,7 @@ PTF_TEST_CASE(TestTcpReassemblyDisableOOOCleanup);
 PTF_TEST_CASE(TestTcpReassemblyTimeStamps);
 PTF_TEST_CASE(TestTcpReassemblyFinReset);
 PTF_TEST_CASE(TestTcpReassemblyHighPrecision);
+PTF_TEST_CASE(TestHttpReassembly);
 
 // Implemented in IPFragmentationTests.cpp
 PTF_TEST_CASE(TestIPFragmentationSanity);
@@ -90,6 +100,7 @@ PTF_TEST_CASE(TestIPFragMultipleFrags);
 PTF_TEST_CASE(TestIPFragMapOverflow);
 PTF_TEST_CASE(TestIPFragRemove);
 PTF_TEST_CASE(TestIPFragWithPadding);
+PTF_TEST_CASE(TestIPFragLimits);
 
 // Implemented in PfRingTests.cpp
 PTF_TEST_CASE(TestPfRingDevice);
@@ -107,6 +118,8 @@ PTF_TEST_CASE(TestDpdkMultiThread);
 PTF_TEST_CASE(TestDpdkDeviceSendPackets);
 PTF_TEST_CASE(TestDpdkDeviceWorkerThreads);
 PTF_TEST_CASE(TestDpdkMbufRawPacket);
+PTF_TEST_CASE(TestDpdkMbufRawPacketChained);
+PTF_TEST_CASE(TestDpdkPipeline);
 
 // Implemented in KniTests.cpp
 PTF_TEST_CASE(TestKniDevice);
@@ -5,6 +5,7 @@
 #include <sstream>
 
 #ifdef USE_DPDK
+#	include <atomic>
 #	include <mutex>
 #	include "Logger.h"
 #	include "PacketUtils.h"
@@ -12,7 +13,10 @@
 #	include "TcpLayer.h"
 #	include "UdpLayer.h"
 #	include "DnsLayer.h"
+#	include "EthLayer.h"
+#	include "PayloadLayer.h"
 #	include "DpdkDeviceList.h"
+#	include "DpdkPipeline.h"
 #	include "PcapFileDevice.h"
 #endif
 
@@ -260,6 +264,25 @@ public:
 	}
 };
 
+struct DpdkPipelineTestData
+{
+	std::atomic<int> PacketCount;
+	std::atomic<int> UdpCount;
+};
+
+int dpdkPipelineClassify(pcpp::Packet& packet, uint8_t workerId, void* userCookie)
+{
+	DpdkPipelineTestData* data = (DpdkPipelineTestData*)userCookie;
+	data->PacketCount++;
+	if (packet.isPacketOfType(pcpp::UDP))
+	{
+		data->UdpCount++;
+		return pcpp::DpdkPipeline::DropPacket;
+	}
+
+	return 0;
+}
+
 #endif  // USE_DPDK
 
 PTF_TEST_CASE(TestDpdkInitDevice)
@@ -1024,3 +1047,180 @@ PTF_TEST_CASE(TestDpdkMbufRawPacket)
 	PTF_SKIP_TEST("DPDK not configured");
 #endif
 }  // TestDpdkMbufRawPacket
+
+PTF_TEST_CASE(TestDpdkMbufRawPacketChained)
+{
+#ifdef USE_DPDK
+	pcpp::DpdkDevice* dev = pcpp::DpdkDeviceList::getInstance().getDeviceByPort(PcapTestGlobalArgs.dpdkPort);
+	PTF_ASSERT_NOT_NULL(dev);
+
+	if (dev->getPMDType() != pcpp::PMD_PCAP)
+	{
+		PTF_SKIP_TEST("Chained mbuf test requires a net_pcap virtual device");
+	}
+
+	PTF_ASSERT_TRUE(dev->openMultiQueues(1, 1));
+	DeviceTeardown devTeardown(dev);
+
+	// build a 9000 byte UDP packet
+	const size_t jumboFrameLen = 9000;
+	pcpp::Packet jumboPacket(jumboFrameLen);
+	pcpp::EthLayer ethLayer(pcpp::MacAddress("00:11:22:33:44:55"), pcpp::MacAddress("66:77:88:99:aa:bb"));
+	pcpp::IPv4Layer ipLayer(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("10.0.0.2"));
+	ipLayer.getIPv4Header()->timeToLive = 64;
+	pcpp::UdpLayer udpLayer(1234, 5678);
+	std::vector<uint8_t> payload(jumboFrameLen - 14 - 20 - 8);
+	for (size_t i = 0; i < payload.size(); i++)
+		payload[i] = (uint8_t)i;
+	pcpp::PayloadLayer payloadLayer(payload.data(), payload.size());
+	PTF_ASSERT_TRUE(jumboPacket.addLayer(&ethLayer));
+	PTF_ASSERT_TRUE(jumboPacket.addLayer(&ipLayer));
+	PTF_ASSERT_TRUE(jumboPacket.addLayer(&udpLayer));
+	PTF_ASSERT_TRUE(jumboPacket.addLayer(&payloadLayer));
+	jumboPacket.computeCalculateFields();
+	const pcpp::RawPacket* jumboRawPacket = jumboPacket.getRawPacketReadOnly();
+	PTF_ASSERT_EQUAL(jumboRawPacket->getRawDataLen(), (int)jumboFrameLen);
+
+	// copy to a chain of mbufs
+	pcpp::MBufRawPacket mbufRawPacket;
+	PTF_ASSERT_TRUE(mbufRawPacket.initFromRawPacket(jumboRawPacket, dev));
+	PTF_ASSERT_TRUE(mbufRawPacket.isChained());
+	PTF_ASSERT_EQUAL(mbufRawPacket.getFrameLength(), (int)jumboFrameLen);
+	PTF_ASSERT_LOWER_THAN(mbufRawPacket.getRawDataLen(), (int)jumboFrameLen);
+
+	size_t offset = 0;
+	int numOfSegments = 0;
+	pcpp::MBufRawPacket::Segment segment;
+	for (bool found = mbufRawPacket.getFirstSegment(segment); found; found = mbufRawPacket.getNextSegment(segment))
+	{
+		PTF_ASSERT_LOWER_OR_EQUAL_THAN(offset + segment.dataLen, jumboFrameLen);
+		PTF_ASSERT_BUF_COMPARE(segment.data, jumboRawPacket->getRawData() + offset, segment.dataLen);
+		offset += segment.dataLen;
+		numOfSegments++;
+	}
+	PTF_ASSERT_EQUAL(offset, jumboFrameLen);
+	PTF_ASSERT_EQUAL(numOfSegments, mbufRawPacket.getNumOfSegments());
+	PTF_PRINT_VERBOSE("Jumbo frame spans " << numOfSegments << " mbufs");
+
+	// read a range spanning the first two segments
+	uint8_t buffer[100];
+	size_t firstSegmentLen = (size_t)mbufRawPacket.getRawDataLen();
+	const uint8_t* range = mbufRawPacket.readData(firstSegmentLen - 50, sizeof(buffer), buffer);
+	PTF_ASSERT_NOT_NULL(range);
+	PTF_ASSERT_BUF_COMPARE(range, jumboRawPacket->getRawData() + firstSegmentLen - 50, sizeof(buffer));
+	PTF_ASSERT_NULL(mbufRawPacket.readData(jumboFrameLen - 50, sizeof(buffer), buffer));
+
+	// headers are parsed from the first segment
+	pcpp::Packet parsedPacket(&mbufRawPacket);
+	PTF_ASSERT_TRUE(parsedPacket.isPacketOfType(pcpp::UDP));
+	PTF_ASSERT_EQUAL(parsedPacket.getLayerOfType<pcpp::UdpLayer>()->getDstPort(), 5678);
+	PTF_ASSERT_EQUAL(parsedPacket.getLayerOfType<pcpp::IPv4Layer>()->getDstIPv4Address(),
+	                 pcpp::IPv4Address("10.0.0.2"));
+
+	// copying a chain copies all segments
+	pcpp::MBufRawPacket mbufRawPacketCopy(mbufRawPacket);
+	PTF_ASSERT_TRUE(mbufRawPacketCopy.isChained());
+	std::vector<uint8_t> copiedData(jumboFrameLen);
+	range = mbufRawPacketCopy.readData(0, jumboFrameLen, copiedData.data());
+	PTF_ASSERT_NOT_NULL(range);
+	PTF_ASSERT_BUF_COMPARE(range, jumboRawPacket->getRawData(), jumboFrameLen);
+
+	// a chain can be linearized only if the first mbuf can hold the whole packet
+	pcpp::Logger::getInstance().suppressLogs();
+	bool linearized = mbufRawPacketCopy.linearize();
+	pcpp::Logger::getInstance().enableLogs();
+	PTF_ASSERT_EQUAL(linearized, !mbufRawPacketCopy.isChained());
+
+	// send multi-segment packets, both from a chain and from a RawPacket larger than an mbuf
+	pcpp::RawPacketVector rawPacketVec;
+	for (int i = 0; i < 10; i++)
+		rawPacketVec.pushBack(new pcpp::RawPacket(*jumboRawPacket));
+	PTF_ASSERT_EQUAL(dev->sendPackets(rawPacketVec, 0), 10);
+	PTF_ASSERT_TRUE(dev->sendPacket(mbufRawPacket, 0));
+
+#else
+	PTF_SKIP_TEST("DPDK not configured");
+#endif
+}  // TestDpdkMbufRawPacketChained
+
+PTF_TEST_CASE(TestDpdkPipeline)
+{
+#ifdef USE_DPDK
+	pcpp::DpdkDevice* dev = pcpp::DpdkDeviceList::getInstance().getDeviceByPort(PcapTestGlobalArgs.dpdkPort);
+	PTF_ASSERT_NOT_NULL(dev);
+
+	if (dev->getPMDType() != pcpp::PMD_PCAP && dev->getPMDType() != pcpp::PMD_NULL)
+	{
+		PTF_SKIP_TEST("Pipeline test requires a net_pcap or net_null virtual device");
+	}
+
+	std::vector<pcpp::SystemCore> cores;
+	pcpp::SystemCore masterCore = pcpp::DpdkDeviceList::getInstance().getDpdkMasterCore();
+	for (int coreId = 0; coreId < pcpp::getNumOfCores() && cores.size() < 3; coreId++)
+	{
+		if (coreId != masterCore.Id)
+			cores.push_back(pcpp::SystemCores::IdToSystemCore[coreId]);
+	}
+
+	if (cores.size() < 3)
+	{
+		PTF_SKIP_TEST("Pipeline test requires at least 4 cores");
+	}
+
+	PTF_ASSERT_TRUE(dev->openMultiQueues(1, 1));
+
+	DpdkPipelineTestData data;
+	data.PacketCount = 0;
+	data.UdpCount = 0;
+	pcpp::DpdkPipeline pipeline(dev, 0, dpdkPipelineClassify, &data);
+
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_EQUAL(pipeline.addOutput(nullptr, 0), -1);
+	pcpp::Logger::getInstance().enableLogs();
+	PTF_ASSERT_EQUAL(pipeline.addOutput(dev, 0), 0);
+	PTF_ASSERT_EQUAL(pipeline.getNumOfOutputs(), 1);
+
+	// a core can't run more than one stage
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(pipeline.start(cores[0], cores[0].Mask, cores[1]));
+	pcpp::Logger::getInstance().enableLogs();
+	PTF_ASSERT_FALSE(pipeline.isRunning());
+
+	PTF_ASSERT_TRUE(pipeline.start(cores[0], cores[1].Mask, cores[2]));
+	PTF_ASSERT_TRUE(pipeline.isRunning());
+
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_EQUAL(pipeline.addOutput(dev, 0), -1);
+	pcpp::Logger::getInstance().enableLogs();
+
+	pcpp::DpdkPipeline::PipelineStats stats;
+	int numOfAttempts = 0;
+	while (numOfAttempts < 10)
+	{
+		pcpp::multiPlatformSleep(1);
+		pipeline.getStatistics(stats);
+		if (stats.rxPackets > 0)
+			break;
+		numOfAttempts++;
+	}
+
+	pcpp::multiPlatformSleep(1);
+	pipeline.stop();
+	PTF_ASSERT_FALSE(pipeline.isRunning());
+
+	// all packets received were processed by the time the pipeline stopped
+	pipeline.getStatistics(stats);
+	PTF_PRINT_VERBOSE("RX: " << stats.rxPackets << ", parsed: " << stats.parsedPackets << ", dropped by classifier: "
+	                         << stats.classifierDrops << ", TX: " << stats.txPackets);
+	PTF_ASSERT_GREATER_THAN(stats.rxPackets, 0);
+	PTF_ASSERT_EQUAL(stats.parsedPackets, stats.rxPackets - stats.rxRingDrops);
+	PTF_ASSERT_EQUAL(stats.parsedPackets, (uint64_t)data.PacketCount.load());
+	PTF_ASSERT_EQUAL(stats.classifierDrops, (uint64_t)data.UdpCount.load());
+	PTF_ASSERT_EQUAL(stats.txPackets + stats.txDrops + stats.txRingDrops, stats.parsedPackets - stats.classifierDrops);
+
+	dev->close();
+
+#else
+	PTF_SKIP_TEST("DPDK not configured");
+#endif
+}  // TestDpdkPipeline
@@ -2,6 +2,7 @@
 #include "Logger.h"
 #include "Packet.h"
 #include "PcapFileDevice.h"
+#include "RotatingFileWriterDevice.h"
 #include "../Common/PcapFileNamesDef.h"
 #include <array>
 #include <fstream>
@@ -840,6 +841,296 @@ PTF_TEST_CASE(TestPcapNgFileTooManyInterfaces)
 	readerDev.close();
 }  // TestPcapNgFileTooManyInterfaces
 
+PTF_TEST_CASE(TestPcapNgFileParallelCompression)
+{
+	std::vector<pcpp::RawPacket> packets;
+	std::vector<std::string> comments;
+
+	pcpp::PcapNgFileReaderDevice readerDev(EXAMPLE2_PCAPNG_PATH);
+	PTF_ASSERT_TRUE(readerDev.open());
+
+	// small frames make sure the packets are spread over many independently compressed frames
+	pcpp::PcapNgFileWriterDevice writerDev(EXAMPLE2_PCAPNG_ZST_PARALLEL_WRITE_PATH, 5);
+	writerDev.setCompressionThreads(4, 2048);
+	PTF_ASSERT_TRUE(writerDev.open());
+
+	pcpp::RawPacket rawPacket;
+	std::string pktComment;
+	while (readerDev.getNextPacket(rawPacket, pktComment))
+	{
+		PTF_ASSERT_TRUE(writerDev.writePacket(rawPacket, pktComment));
+		packets.push_back(rawPacket);
+		comments.push_back(pktComment);
+	}
+
+	readerDev.close();
+	writerDev.close();
+	PTF_ASSERT_EQUAL(packets.size(), 159);
+
+	// read the remaining packets and compare them to the same number of packets at the end of the original file
+	auto verifyPacketsUntilEnd = [&](pcpp::PcapNgFileReaderDevice& reader) -> size_t {
+		std::vector<pcpp::RawPacket> readPackets;
+		std::vector<std::string> readComments;
+		while (reader.getNextPacket(rawPacket, pktComment))
+		{
+			readPackets.push_back(rawPacket);
+			readComments.push_back(pktComment);
+		}
+
+		if (readPackets.size() > packets.size())
+			return 0;
+
+		size_t offset = packets.size() - readPackets.size();
+		for (size_t i = 0; i < readPackets.size(); i++)
+		{
+			const pcpp::RawPacket& expected = packets[offset + i];
+			if (readPackets[i].getRawDataLen() != expected.getRawDataLen() ||
+			    readPackets[i].getFrameLength() != expected.getFrameLength() ||
+			    readPackets[i].getLinkLayerType() != expected.getLinkLayerType() ||
+			    readPackets[i].getPacketTimeStamp().tv_sec != expected.getPacketTimeStamp().tv_sec ||
+			    readPackets[i].getPacketTimeStamp().tv_nsec != expected.getPacketTimeStamp().tv_nsec ||
+			    memcmp(readPackets[i].getRawData(), expected.getRawData(), expected.getRawDataLen()) != 0 ||
+			    readComments[i] != comments[offset + i])
+				return 0;
+		}
+
+		return readPackets.size();
+	};
+
+	// sequential read with parallel decompression
+	pcpp::PcapNgFileReaderDevice parallelReaderDev(EXAMPLE2_PCAPNG_ZST_PARALLEL_WRITE_PATH);
+	parallelReaderDev.setDecompressionThreads(3);
+	PTF_ASSERT_TRUE(parallelReaderDev.open());
+	PTF_ASSERT_EQUAL(verifyPacketsUntilEnd(parallelReaderDev), 159);
+	parallelReaderDev.close();
+
+	// the file is readable by the classic reader as well
+	pcpp::PcapNgFileReaderDevice sequentialReaderDev(EXAMPLE2_PCAPNG_ZST_PARALLEL_WRITE_PATH);
+	PTF_ASSERT_TRUE(sequentialReaderDev.open());
+	PTF_ASSERT_EQUAL(verifyPacketsUntilEnd(sequentialReaderDev), 159);
+	sequentialReaderDev.close();
+
+	PTF_ASSERT_TRUE(parallelReaderDev.open());
+	uint32_t numOfFrames = parallelReaderDev.getNumOfCompressedFrames();
+	if (numOfFrames == 0)
+	{
+		// built without zstd support: the file is written uncompressed and can't be seeked
+		pcpp::Logger::getInstance().suppressLogs();
+		PTF_ASSERT_FALSE(parallelReaderDev.seekToCompressedFrame(0));
+		pcpp::Logger::getInstance().enableLogs();
+		return;
+	}
+
+	PTF_ASSERT_GREATER_THAN(numOfFrames, 10);
+
+	// seek forward over frames that were never read, the interfaces they define must still be known
+	PTF_ASSERT_TRUE(parallelReaderDev.seekToCompressedFrame(numOfFrames / 2));
+	size_t packetCount = verifyPacketsUntilEnd(parallelReaderDev);
+	PTF_ASSERT_GREATER_THAN(packetCount, 0);
+	PTF_ASSERT_LOWER_THAN(packetCount, 159);
+	size_t prevPacketCount = packetCount;
+
+	PTF_ASSERT_TRUE(parallelReaderDev.seekToCompressedFrame(numOfFrames - 1));
+	packetCount = verifyPacketsUntilEnd(parallelReaderDev);
+	PTF_ASSERT_GREATER_THAN(packetCount, 0);
+	PTF_ASSERT_LOWER_THAN(packetCount, prevPacketCount);
+
+	PTF_ASSERT_TRUE(parallelReaderDev.seekToCompressedFrame(numOfFrames / 4));
+	packetCount = verifyPacketsUntilEnd(parallelReaderDev);
+	PTF_ASSERT_GREATER_THAN(packetCount, prevPacketCount);
+
+	PTF_ASSERT_TRUE(parallelReaderDev.seekToCompressedFrame(0));
+	PTF_ASSERT_EQUAL(verifyPacketsUntilEnd(parallelReaderDev), 159);
+
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(parallelReaderDev.seekToCompressedFrame(numOfFrames));
+	pcpp::Logger::getInstance().enableLogs();
+
+	parallelReaderDev.close();
+}  // TestPcapNgFileParallelCompression
+
+PTF_TEST_CASE(TestPcapNgFileZeroCopyRead)
+{
+	// zero-copy reading returns the same packets as regular reading
+	pcpp::PcapNgFileReaderDevice readerDev(EXAMPLE2_PCAPNG_PATH);
+	pcpp::PcapNgFileReaderDevice zeroCopyReaderDev(EXAMPLE2_PCAPNG_PATH);
+	PTF_ASSERT_TRUE(readerDev.open());
+	PTF_ASSERT_TRUE(zeroCopyReaderDev.open());
+	PTF_ASSERT_EQUAL(zeroCopyReaderDev.getOS(), readerDev.getOS());
+	PTF_ASSERT_EQUAL(zeroCopyReaderDev.getCaptureApplication(), readerDev.getCaptureApplication());
+
+	pcpp::RawPacket rawPacket;
+	pcpp::RawPacket zeroCopyRawPacket;
+	int packetCount = 0;
+	while (readerDev.getNextPacket(rawPacket))
+	{
+		PTF_ASSERT_TRUE(zeroCopyReaderDev.getNextPacketZeroCopy(zeroCopyRawPacket));
+		PTF_ASSERT_EQUAL(zeroCopyRawPacket.getRawDataLen(), rawPacket.getRawDataLen());
+		PTF_ASSERT_EQUAL(zeroCopyRawPacket.getFrameLength(), rawPacket.getFrameLength());
+		PTF_ASSERT_EQUAL(zeroCopyRawPacket.getLinkLayerType(), rawPacket.getLinkLayerType(), enum);
+		PTF_ASSERT_EQUAL(zeroCopyRawPacket.getPacketTimeStamp().tv_sec, rawPacket.getPacketTimeStamp().tv_sec);
+		PTF_ASSERT_EQUAL(zeroCopyRawPacket.getPacketTimeStamp().tv_nsec, rawPacket.getPacketTimeStamp().tv_nsec);
+		PTF_ASSERT_BUF_COMPARE(zeroCopyRawPacket.getRawData(), rawPacket.getRawData(), rawPacket.getRawDataLen());
+		packetCount++;
+	}
+	PTF_ASSERT_FALSE(zeroCopyReaderDev.getNextPacketZeroCopy(zeroCopyRawPacket));
+	PTF_ASSERT_EQUAL(packetCount, 159);
+	readerDev.close();
+	zeroCopyReaderDev.close();
+
+	// a raw packet used for zero-copy reading owns a copy of its data again after a regular read, so the data
+	// remains valid after the device is closed
+	PTF_ASSERT_TRUE(readerDev.open());
+	PTF_ASSERT_TRUE(zeroCopyReaderDev.open());
+	PTF_ASSERT_TRUE(zeroCopyReaderDev.getNextPacketZeroCopy(zeroCopyRawPacket));
+	PTF_ASSERT_TRUE(zeroCopyReaderDev.getNextPacket(zeroCopyRawPacket));
+	PTF_ASSERT_TRUE(readerDev.getNextPacket(rawPacket));
+	PTF_ASSERT_TRUE(readerDev.getNextPacket(rawPacket));
+	zeroCopyReaderDev.close();
+	readerDev.close();
+	PTF_ASSERT_EQUAL(zeroCopyRawPacket.getRawDataLen(), rawPacket.getRawDataLen());
+	PTF_ASSERT_EQUAL(zeroCopyRawPacket.getFrameLength(), rawPacket.getFrameLength());
+	PTF_ASSERT_EQUAL(zeroCopyRawPacket.getPacketTimeStamp().tv_nsec, rawPacket.getPacketTimeStamp().tv_nsec);
+	PTF_ASSERT_BUF_COMPARE(zeroCopyRawPacket.getRawData(), rawPacket.getRawData(), rawPacket.getRawDataLen());
+
+	// also when packets are read into alternately, or the raw packet was set by another reader or by the user
+	pcpp::RawPacket otherZeroCopyRawPacket;
+	PTF_ASSERT_TRUE(zeroCopyReaderDev.open());
+	PTF_ASSERT_TRUE(zeroCopyReaderDev.getNextPacketZeroCopy(zeroCopyRawPacket));
+	PTF_ASSERT_TRUE(zeroCopyReaderDev.getNextPacketZeroCopy(otherZeroCopyRawPacket));
+	PTF_ASSERT_FALSE(otherZeroCopyRawPacket.isRawDataOwned());
+	PTF_ASSERT_TRUE(zeroCopyReaderDev.getNextPacket(zeroCopyRawPacket));
+	PTF_ASSERT_TRUE(zeroCopyRawPacket.isRawDataOwned());
+	PTF_ASSERT_TRUE(readerDev.open());
+	PTF_ASSERT_TRUE(readerDev.getNextPacket(otherZeroCopyRawPacket));
+	PTF_ASSERT_TRUE(otherZeroCopyRawPacket.isRawDataOwned());
+	zeroCopyReaderDev.close();
+	readerDev.close();
+
+	uint8_t userBuffer[4] = { 0 };
+	timespec userTimestamp = { 0, 0 };
+	pcpp::RawPacket userRawPacket(userBuffer, sizeof(userBuffer), userTimestamp, false);
+	pcpp::PcapFileReaderDevice pcapReaderDev(EXAMPLE_PCAP_PATH);
+	PTF_ASSERT_TRUE(pcapReaderDev.open());
+	PTF_ASSERT_TRUE(pcapReaderDev.getNextPacket(userRawPacket));
+	PTF_ASSERT_TRUE(userRawPacket.isRawDataOwned());
+	PTF_ASSERT_TRUE(pcapReaderDev.getNextPacket(userRawPacket));
+	pcapReaderDev.close();
+
+	// a big-endian file with a power of 2 timestamp resolution, a timestamp offset and a simple packet block
+	std::vector<uint8_t> fileData;
+	auto append16 = [&fileData](uint16_t value) {
+		fileData.push_back(static_cast<uint8_t>(value >> 8));
+		fileData.push_back(static_cast<uint8_t>(value));
+	};
+	auto append32 = [&append16](uint32_t value) {
+		append16(static_cast<uint16_t>(value >> 16));
+		append16(static_cast<uint16_t>(value));
+	};
+	auto appendBytes = [&fileData](const std::string& bytes) {
+		fileData.insert(fileData.end(), bytes.begin(), bytes.end());
+		fileData.resize((fileData.size() + 3) & ~static_cast<size_t>(3), 0);
+	};
+
+	// section header block with an OS option
+	append32(0x0A0D0D0A);
+	append32(40);
+	append32(0x1A2B3C4D);
+	append16(1);
+	append16(0);
+	append32(0xFFFFFFFF);
+	append32(0xFFFFFFFF);
+	append16(3);
+	append16(6);
+	appendBytes("TestOS");
+	append32(40);
+
+	// interface description block, 1024 ticks per second and timestamps relative to second 100
+	append32(1);
+	append32(44);
+	append16(pcpp::LINKTYPE_ETHERNET);
+	append16(0);
+	append32(0);
+	append16(9);
+	append16(1);
+	appendBytes("\x8A");
+	append16(14);
+	append16(8);
+	append32(0);
+	append32(100);
+	append16(0);
+	append16(0);
+	append32(44);
+
+	// enhanced packet block at 5.5 seconds with a comment
+	append32(6);
+	append32(44);
+	append32(0);
+	append32(0);
+	append32(5 * 1024 + 512);
+	append32(4);
+	append32(60);
+	appendBytes("\x01\x02\x03\x04");
+	append16(1);
+	append16(2);
+	appendBytes("hi");
+	append32(44);
+
+	// simple packet block
+	append32(3);
+	append32(24);
+	append32(6);
+	appendBytes("\x05\x06\x07\x08\x09\x0A");
+	append32(24);
+
+	{
+		std::ofstream bigEndianFile(EXAMPLE_PCAPNG_BIG_ENDIAN_WRITE_PATH, std::ios::binary);
+		bigEndianFile.write(reinterpret_cast<const char*>(fileData.data()), fileData.size());
+	}
+
+	pcpp::PcapNgFileReaderDevice bigEndianReaderDev(EXAMPLE_PCAPNG_BIG_ENDIAN_WRITE_PATH);
+	PTF_ASSERT_TRUE(bigEndianReaderDev.open());
+	PTF_ASSERT_EQUAL(bigEndianReaderDev.getOS(), "TestOS");
+
+	std::string packetComment;
+	PTF_ASSERT_TRUE(bigEndianReaderDev.getNextPacket(rawPacket, packetComment));
+	PTF_ASSERT_EQUAL(packetComment, "hi");
+	PTF_ASSERT_EQUAL(rawPacket.getRawDataLen(), 4);
+	PTF_ASSERT_EQUAL(rawPacket.getFrameLength(), 60);
+	PTF_ASSERT_EQUAL(rawPacket.getLinkLayerType(), pcpp::LINKTYPE_ETHERNET, enum);
+	PTF_ASSERT_EQUAL(rawPacket.getPacketTimeStamp().tv_sec, 105);
+	PTF_ASSERT_EQUAL(rawPacket.getPacketTimeStamp().tv_nsec, 500000000);
+	PTF_ASSERT_EQUAL(rawPacket.getRawData()[3], 0x04);
+
+	PTF_ASSERT_TRUE(bigEndianReaderDev.getNextPacket(rawPacket, packetComment));
+	PTF_ASSERT_EQUAL(packetComment, "");
+	PTF_ASSERT_EQUAL(rawPacket.getRawDataLen(), 6);
+	PTF_ASSERT_EQUAL(rawPacket.getLinkLayerType(), pcpp::LINKTYPE_ETHERNET, enum);
+	PTF_ASSERT_EQUAL(rawPacket.getRawData()[5], 0x0A);
+
+	PTF_ASSERT_FALSE(bigEndianReaderDev.getNextPacket(rawPacket));
+	bigEndianReaderDev.close();
+
+	// a block length beyond the maximal block length is rejected before any data is read for it
+	append32(6);
+	append32(0x7FFFFFF0);
+	append32(0);
+	{
+		std::ofstream bigEndianFile(EXAMPLE_PCAPNG_BIG_ENDIAN_WRITE_PATH, std::ios::binary);
+		bigEndianFile.write(reinterpret_cast<const char*>(fileData.data()), fileData.size());
+	}
+
+	PTF_ASSERT_TRUE(bigEndianReaderDev.open());
+	PTF_ASSERT_TRUE(bigEndianReaderDev.getNextPacket(rawPacket));
+	PTF_ASSERT_TRUE(bigEndianReaderDev.getNextPacket(rawPacket));
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(bigEndianReaderDev.getNextPacket(rawPacket));
+	pcpp::Logger::getInstance().enableLogs();
+	PTF_ASSERT_EQUAL(pcpp::Logger::getInstance().getLastError(),
+	                 "pcapng block of type 0x6 is too long: 2147483632 bytes");
+	bigEndianReaderDev.close();
+}  // TestPcapNgFileZeroCopyRead
+
 PTF_TEST_CASE(TestPcapFileReadLinkTypeIPv6)
 {
 	pcpp::PcapFileReaderDevice readerDev(EXAMPLE_LINKTYPE_IPV6);
@@ -1016,3 +1307,154 @@ PTF_TEST_CASE(TestPcapFileWriterDeviceDestructor)
 	PTF_ASSERT_NOT_EQUAL(0, posExplicitClose);
 	PTF_ASSERT_EQUAL(posNoClose, posExplicitClose);
 }  // TestPcapFileWriterDeviceDestructor
+
+PTF_TEST_CASE(TestRotatingFileWriterDevice)
+{
+	pcpp::PcapFileReaderDevice readerDev(EXAMPLE_PCAP_PATH);
+	PTF_ASSERT_TRUE(readerDev.open());
+	pcpp::RawPacketVector packetVec;
+	PTF_ASSERT_EQUAL(readerDev.getNextPackets(packetVec), 4631);
+	readerDev.close();
+
+	// rollover by packet count, keep only the 3 newest files
+	pcpp::RotatingFileWriterDevice::RotationConfig config(pcpp::RotatingFileWriterDevice::Pcap, 0, 1000, 0, 3);
+	pcpp::RotatingFileWriterDevice rotatingWriter(EXAMPLE_PCAP_ROTATING_PATH_PATTERN, config);
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(rotatingWriter.writePacket(*packetVec.front()));
+	PTF_ASSERT_FALSE(rotatingWriter.open(true));
+	pcpp::Logger::getInstance().enableLogs();
+	PTF_ASSERT_TRUE(rotatingWriter.open());
+	PTF_ASSERT_TRUE(rotatingWriter.isOpened());
+	PTF_ASSERT_TRUE(rotatingWriter.writePackets(packetVec));
+	PTF_ASSERT_EQUAL(rotatingWriter.getNumOfFilesCreated(), 5);
+	PTF_ASSERT_EQUAL(rotatingWriter.getCurrentFileName(), "PcapExamples/rotating_4.pcap");
+	rotatingWriter.close();
+	PTF_ASSERT_FALSE(rotatingWriter.isOpened());
+
+	pcpp::IPcapDevice::PcapStats writerStatistics;
+	rotatingWriter.getStatistics(writerStatistics);
+	PTF_ASSERT_EQUAL((uint32_t)writerStatistics.packetsRecv, 4631);
+	PTF_ASSERT_EQUAL((uint32_t)writerStatistics.packetsDrop, 0);
+
+	std::array<int, 5> expectedPacketCount = { -1, -1, 1000, 1000, 631 };
+	for (size_t i = 0; i < expectedPacketCount.size(); i++)
+	{
+		std::string fileName = "PcapExamples/rotating_" + std::to_string(i) + ".pcap";
+		std::ifstream fileStream(fileName.c_str());
+		if (expectedPacketCount[i] < 0)
+		{
+			PTF_ASSERT_FALSE(fileStream.good());
+			continue;
+		}
+
+		PTF_ASSERT_TRUE(fileStream.good());
+		pcpp::PcapFileReaderDevice rotatedReader(fileName);
+		PTF_ASSERT_TRUE(rotatedReader.open());
+		pcpp::RawPacketVector rotatedPackets;
+		PTF_ASSERT_EQUAL(rotatedReader.getNextPackets(rotatedPackets), expectedPacketCount[i]);
+		PTF_ASSERT_BUF_COMPARE(rotatedPackets.front()->getRawData(),
+		                       packetVec.at(1000 * i)->getRawData(),
+		                       rotatedPackets.front()->getRawDataLen());
+		rotatedReader.close();
+		std::remove(fileName.c_str());
+	}
+
+	// rollover by file size, write pcap-ng files and keep all of them
+	pcpp::RotatingFileWriterDevice::RotationConfig sizeConfig(pcpp::RotatingFileWriterDevice::PcapNg, 1000000);
+	sizeConfig.preallocateSize = 1000000;
+	pcpp::RotatingFileWriterDevice rotatingNgWriter(EXAMPLE_PCAPNG_ROTATING_PATH_PATTERN, sizeConfig);
+	PTF_ASSERT_TRUE(rotatingNgWriter.open());
+	PTF_ASSERT_TRUE(rotatingNgWriter.writePackets(packetVec));
+	uint32_t numOfFiles = rotatingNgWriter.getNumOfFilesCreated();
+	PTF_ASSERT_GREATER_THAN(numOfFiles, 1);
+	rotatingNgWriter.close();
+
+	int totalPacketCount = 0;
+	for (uint32_t i = 0; i < numOfFiles; i++)
+	{
+		std::string fileName = "PcapExamples/rotating_ng_" + std::to_string(i) + ".pcapng";
+		pcpp::PcapNgFileReaderDevice rotatedReader(fileName);
+		PTF_ASSERT_TRUE(rotatedReader.open());
+		PTF_ASSERT_LOWER_THAN(rotatedReader.getFileSize(), 1000000 + 1000);
+		pcpp::RawPacketVector rotatedPackets;
+		totalPacketCount += rotatedReader.getNextPackets(rotatedPackets);
+		rotatedReader.close();
+		std::remove(fileName.c_str());
+	}
+
+	PTF_ASSERT_EQUAL(totalPacketCount, 4631);
+
+	// a pattern without an index never reuses the name of an earlier file
+	std::array<std::string, 5> noIndexFileNames = {
+		"PcapExamples/rotating_no_index.pcap", "PcapExamples/rotating_no_index_1.pcap",
+		"PcapExamples/rotating_no_index_2.pcap", "PcapExamples/rotating_no_index_3.pcap",
+		"PcapExamples/rotating_no_index_4.pcap"
+	};
+	for (const auto& fileName : noIndexFileNames)
+		std::remove(fileName.c_str());
+
+	pcpp::RotatingFileWriterDevice::RotationConfig noIndexConfig(pcpp::RotatingFileWriterDevice::Pcap, 0, 1000);
+	pcpp::RotatingFileWriterDevice noIndexWriter(EXAMPLE_PCAP_ROTATING_NO_INDEX_PATH, noIndexConfig);
+	PTF_ASSERT_TRUE(noIndexWriter.open());
+	PTF_ASSERT_TRUE(noIndexWriter.writePackets(packetVec));
+	PTF_ASSERT_EQUAL(noIndexWriter.getNumOfFilesCreated(), 5);
+	PTF_ASSERT_EQUAL(noIndexWriter.getCurrentFileName(), noIndexFileNames[4]);
+	noIndexWriter.close();
+
+	for (size_t i = 0; i < noIndexFileNames.size(); i++)
+	{
+		pcpp::PcapFileReaderDevice rotatedReader(noIndexFileNames[i]);
+		PTF_ASSERT_TRUE(rotatedReader.open());
+		pcpp::RawPacketVector rotatedPackets;
+		PTF_ASSERT_EQUAL(rotatedReader.getNextPackets(rotatedPackets), i < 4 ? 1000 : 631);
+		PTF_ASSERT_BUF_COMPARE(rotatedPackets.front()->getRawData(), packetVec.at(1000 * i)->getRawData(),
+		                       rotatedPackets.front()->getRawDataLen());
+		rotatedReader.close();
+		std::remove(noIndexFileNames[i].c_str());
+	}
+
+	// rollover by time with a pattern that repeats within a year, keep only the 2 newest files. The newest files must
+	// not be deleted in place of older files of the same name
+	std::array<std::string, 5> timeFileNames = {
+		"PcapExamples/rotating_time_2001.pcap", "PcapExamples/rotating_time_2001_1.pcap",
+		"PcapExamples/rotating_time_2001_2.pcap", "PcapExamples/rotating_time_2001_3.pcap",
+		"PcapExamples/rotating_time_2001_4.pcap"
+	};
+	for (const auto& fileName : timeFileNames)
+		std::remove(fileName.c_str());
+
+	pcpp::RotatingFileWriterDevice::RotationConfig timeConfig(pcpp::RotatingFileWriterDevice::Pcap, 0, 0, 10, 2);
+	pcpp::RotatingFileWriterDevice timeWriter(EXAMPLE_PCAP_ROTATING_TIME_PATH_PATTERN, timeConfig);
+	PTF_ASSERT_TRUE(timeWriter.open());
+	for (size_t i = 0; i < 50; i++)
+	{
+		// 10 packets in every 10 seconds, starting in September 2001
+		pcpp::RawPacket timedPacket(*packetVec.at(i));
+		timespec timestamp = { static_cast<time_t>(1000000000 + i), 0 };
+		timedPacket.setPacketTimeStamp(timestamp);
+		PTF_ASSERT_TRUE(timeWriter.writePacket(timedPacket));
+	}
+	PTF_ASSERT_EQUAL(timeWriter.getNumOfFilesCreated(), 5);
+	PTF_ASSERT_EQUAL(timeWriter.getCurrentFileName(), timeFileNames[4]);
+	timeWriter.close();
+
+	for (size_t i = 0; i < timeFileNames.size(); i++)
+	{
+		std::ifstream fileStream(timeFileNames[i].c_str());
+		if (i < 3)
+		{
+			PTF_ASSERT_FALSE(fileStream.good());
+			continue;
+		}
+
+		PTF_ASSERT_TRUE(fileStream.good());
+		pcpp::PcapFileReaderDevice rotatedReader(timeFileNames[i]);
+		PTF_ASSERT_TRUE(rotatedReader.open());
+		pcpp::RawPacketVector rotatedPackets;
+		PTF_ASSERT_EQUAL(rotatedReader.getNextPackets(rotatedPackets), 10);
+		PTF_ASSERT_BUF_COMPARE(rotatedPackets.front()->getRawData(), packetVec.at(10 * i)->getRawData(),
+		                       rotatedPackets.front()->getRawDataLen());
+		rotatedReader.close();
+		std::remove(timeFileNames[i].c_str());
+	}
+}  // TestRotatingFileWriterDevice
@@ -1,7 +1,10 @@
 #include "../TestDefinition.h"
 #include "../Common/TestUtils.h"
 #include "IPReassembly.h"
+#include "IPv4Layer.h"
 #include "IPv6Layer.h"
+#include "EthLayer.h"
+#include "PayloadLayer.h"
 #include "HttpLayer.h"
 #include "PcapFileDevice.h"
 #include "EndianPortable.h"
@@ -1073,3 +1076,232 @@ PTF_TEST_CASE(TestIPFragWithPadding)
 	delete result;
 	delete[] buffer;
 }  // TestIPFragWithPadding
+
+PTF_TEST_CASE(TestIPFragLimits)
+{
+	pcpp::PcapFileReaderDevice reader("PcapExamples/ip4_fragments.pcap");
+	PTF_ASSERT_TRUE(reader.open());
+
+	pcpp::RawPacketVector ip4Packet1Frags;
+	pcpp::RawPacketVector ip4Packet2Frags;
+	pcpp::RawPacketVector ip4Packet3Frags;
+
+	PTF_ASSERT_EQUAL(reader.getNextPackets(ip4Packet1Frags, 6), 6);
+	PTF_ASSERT_EQUAL(reader.getNextPackets(ip4Packet2Frags, 6), 6);
+	PTF_ASSERT_EQUAL(reader.getNextPackets(ip4Packet3Frags, 6), 6);
+
+	reader.close();
+
+	pcpp::PointerVector<pcpp::IPReassembly::PacketKey> packetsRemovedFromIPReassemblyEngine;
+	pcpp::IPReassembly::ReassemblyStatus status;
+
+	// fragments in reverse order with a duplicated fragment
+	// ======================================================
+
+	pcpp::IPReassembly ipReassembly(ipReassemblyOnFragmentsClean, &packetsRemovedFromIPReassemblyEngine);
+
+	for (int i = 5; i > 0; i--)
+	{
+		PTF_ASSERT_NULL(ipReassembly.processPacket(ip4Packet1Frags.at(i), status));
+		PTF_ASSERT_EQUAL(status, pcpp::IPReassembly::OUT_OF_ORDER_FRAGMENT, enum);
+	}
+
+	PTF_ASSERT_NULL(ipReassembly.processPacket(ip4Packet1Frags.at(3), status));
+	PTF_ASSERT_EQUAL(ipReassembly.getStatistics().duplicateFragments, 1);
+	PTF_ASSERT_EQUAL(ipReassembly.getCurrentCapacity(), 1);
+
+	pcpp::Packet* ip4Packet1 = ipReassembly.processPacket(ip4Packet1Frags.at(0), status);
+	PTF_ASSERT_EQUAL(status, pcpp::IPReassembly::REASSEMBLED, enum);
+	PTF_ASSERT_NOT_NULL(ip4Packet1);
+	PTF_ASSERT_EQUAL(ipReassembly.getCurrentCapacity(), 0);
+	PTF_ASSERT_EQUAL(ipReassembly.getCurrentMemoryUsage(), 0);
+	PTF_ASSERT_EQUAL(ipReassembly.getStatistics().packetsReassembled, 1);
+
+	int bufferLength = 0;
+	uint8_t* buffer = readFileIntoBuffer("PcapExamples/ip4_fragments_packet1.txt", bufferLength);
+	PTF_ASSERT_EQUAL(ip4Packet1->getRawPacket()->getRawDataLen(), bufferLength);
+	PTF_ASSERT_BUF_COMPARE(ip4Packet1->getRawPacket()->getRawData(), buffer, bufferLength);
+	delete ip4Packet1;
+	delete[] buffer;
+
+	// fragment beyond the last fragment
+	// =================================
+
+	pcpp::Packet lastFragPacket(ip4Packet2Frags.at(5));
+	uint16_t lastFragOffset = lastFragPacket.getLayerOfType<pcpp::IPv4Layer>()->getFragmentOffset();
+	PTF_ASSERT_NULL(ipReassembly.processPacket(&lastFragPacket, status));
+
+	// a middle fragment that starts 8 bytes after the last fragment
+	pcpp::RawPacket beyondLastRawPacket(*ip4Packet2Frags.at(4));
+	pcpp::Packet beyondLastPacket(&beyondLastRawPacket);
+	pcpp::IPv4Layer* beyondLastIPLayer = beyondLastPacket.getLayerOfType<pcpp::IPv4Layer>();
+	PTF_ASSERT_NOT_NULL(beyondLastIPLayer);
+	beyondLastIPLayer->getIPv4Header()->fragmentOffset =
+	    htobe16(static_cast<uint16_t>((PCPP_IP_MORE_FRAGMENTS << 8) | (lastFragOffset / 8 + 1)));
+	PTF_ASSERT_NULL(ipReassembly.processPacket(&beyondLastPacket, status));
+	PTF_ASSERT_EQUAL(status, pcpp::IPReassembly::MALFORMED_FRAGMENT, enum);
+	PTF_ASSERT_EQUAL(ipReassembly.getStatistics().malformedFragments, 1);
+
+	ipReassembly.resetStatistics();
+	PTF_ASSERT_EQUAL(ipReassembly.getStatistics().malformedFragments, 0);
+	PTF_ASSERT_EQUAL(ipReassembly.getStatistics().packetsReassembled, 0);
+
+	pcpp::IPReassembly::IPv4PacketKey ip4Key;
+	ip4Key.setSrcIP(pcpp::IPv4Address(std::string("10.118.213.212")));
+	ip4Key.setDstIP(pcpp::IPv4Address(std::string("10.118.213.211")));
+	ip4Key.setIpID(0x1ea1);
+	ipReassembly.removePacket(ip4Key);
+	PTF_ASSERT_EQUAL(ipReassembly.getCurrentCapacity(), 0);
+	PTF_ASSERT_EQUAL(ipReassembly.getCurrentMemoryUsage(), 0);
+
+	// memory limit
+	// ============
+
+	size_t firstFragmentLen = ip4Packet1Frags.at(0)->getRawDataLen();
+	ipReassembly.setMaxMemoryUsage(firstFragmentLen + 10);
+	PTF_ASSERT_EQUAL(ipReassembly.getMaxMemoryUsage(), firstFragmentLen + 10);
+
+	ipReassembly.processPacket(ip4Packet1Frags.at(0), status);
+	PTF_ASSERT_EQUAL(status, pcpp::IPReassembly::FIRST_FRAGMENT, enum);
+	PTF_ASSERT_EQUAL(ipReassembly.getCurrentMemoryUsage(), firstFragmentLen);
+
+	// the first packet is dropped to make room for the second one
+	ipReassembly.processPacket(ip4Packet2Frags.at(0), status);
+	PTF_ASSERT_EQUAL(status, pcpp::IPReassembly::FIRST_FRAGMENT, enum);
+	PTF_ASSERT_EQUAL(ipReassembly.getCurrentCapacity(), 1);
+	PTF_ASSERT_EQUAL(ipReassembly.getStatistics().packetsDroppedMemory, 1);
+	PTF_ASSERT_EQUAL(packetsRemovedFromIPReassemblyEngine.size(), 1);
+	pcpp::IPReassembly::IPv4PacketKey* removedKey =
+	    dynamic_cast<pcpp::IPReassembly::IPv4PacketKey*>(packetsRemovedFromIPReassemblyEngine.at(0));
+	PTF_ASSERT_NOT_NULL(removedKey);
+	PTF_ASSERT_EQUAL(removedKey->getIpID(), 0x1ea0);
+
+	// a packet that doesn't fit by itself is dropped too
+	ipReassembly.setMaxMemoryUsage(100);
+	PTF_ASSERT_NULL(ipReassembly.processPacket(ip4Packet3Frags.at(0), status));
+	PTF_ASSERT_EQUAL(ipReassembly.getCurrentCapacity(), 0);
+	PTF_ASSERT_EQUAL(ipReassembly.getCurrentMemoryUsage(), 0);
+	PTF_ASSERT_EQUAL(ipReassembly.getStatistics().packetsDroppedMemory, 3);
+	PTF_ASSERT_EQUAL(packetsRemovedFromIPReassemblyEngine.size(), 3);
+
+	ipReassembly.setMaxMemoryUsage(0);
+
+	// timeout
+	// =======
+
+	ipReassembly.setFragmentTimeout(10);
+	PTF_ASSERT_EQUAL(ipReassembly.getFragmentTimeout(), 10);
+
+	timespec timestamp = {};
+	timestamp.tv_sec = 1000;
+	ip4Packet1Frags.at(0)->setPacketTimeStamp(timestamp);
+	ipReassembly.processPacket(ip4Packet1Frags.at(0), status);
+	timestamp.tv_sec = 1005;
+	ip4Packet2Frags.at(0)->setPacketTimeStamp(timestamp);
+	ipReassembly.processPacket(ip4Packet2Frags.at(0), status);
+	PTF_ASSERT_EQUAL(ipReassembly.getCurrentCapacity(), 2);
+
+	// only the first packet didn't get a fragment in the last 10 seconds
+	timestamp.tv_sec = 1012;
+	ip4Packet3Frags.at(0)->setPacketTimeStamp(timestamp);
+	ipReassembly.processPacket(ip4Packet3Frags.at(0), status);
+	PTF_ASSERT_EQUAL(ipReassembly.getCurrentCapacity(), 2);
+	PTF_ASSERT_EQUAL(ipReassembly.getStatistics().packetsDroppedTimeout, 1);
+	PTF_ASSERT_EQUAL(packetsRemovedFromIPReassemblyEngine.size(), 4);
+	removedKey = dynamic_cast<pcpp::IPReassembly::IPv4PacketKey*>(packetsRemovedFromIPReassemblyEngine.at(3));
+	PTF_ASSERT_NOT_NULL(removedKey);
+	PTF_ASSERT_EQUAL(removedKey->getIpID(), 0x1ea0);
+
+	// the second packet isn't dropped while its fragments keep arriving
+	for (int i = 1; i < 6; i++)
+	{
+		timestamp.tv_sec = 1008 + i * 5;
+		ip4Packet2Frags.at(i)->setPacketTimeStamp(timestamp);
+		pcpp::Packet* result = ipReassembly.processPacket(ip4Packet2Frags.at(i), status);
+		if (i < 5)
+		{
+			PTF_ASSERT_NULL(result);
+		}
+		else
+		{
+			PTF_ASSERT_NOT_NULL(result);
+			PTF_ASSERT_EQUAL(status, pcpp::IPReassembly::REASSEMBLED, enum);
+			delete result;
+		}
+	}
+
+	PTF_ASSERT_EQUAL(ipReassembly.getCurrentCapacity(), 0);
+	PTF_ASSERT_EQUAL(ipReassembly.getStatistics().packetsDroppedTimeout, 2);
+
+	// IPv4 total length limit
+	// =======================
+
+	auto createFragment = [](uint16_t ipId, size_t offset, size_t payloadLen, bool isLastFragment,
+	                         bool withOption) -> pcpp::RawPacket {
+		std::vector<uint8_t> payload(payloadLen, 0x42);
+		pcpp::Packet packet(static_cast<int>(payloadLen + 100));
+		pcpp::EthLayer ethLayer(pcpp::MacAddress("00:11:22:33:44:55"), pcpp::MacAddress("66:77:88:99:aa:bb"));
+		pcpp::IPv4Layer ipLayer(pcpp::IPv4Address("1.1.1.1"), pcpp::IPv4Address("2.2.2.2"));
+		pcpp::PayloadLayer payloadLayer(payload.data(), payload.size());
+		packet.addLayer(&ethLayer);
+		packet.addLayer(&ipLayer);
+		packet.addLayer(&payloadLayer);
+		if (withOption)
+		{
+			ipLayer.addOption(pcpp::IPv4OptionBuilder(pcpp::IPV4OPT_RouterAlert, static_cast<uint16_t>(0)));
+		}
+		packet.computeCalculateFields();
+		ipLayer.getIPv4Header()->ipId = htobe16(ipId);
+		uint16_t fragmentOffset = static_cast<uint16_t>(offset / 8);
+		if (!isLastFragment)
+		{
+			fragmentOffset |= (PCPP_IP_MORE_FRAGMENTS << 8);
+		}
+		ipLayer.getIPv4Header()->fragmentOffset = htobe16(fragmentOffset);
+		return *packet.getRawPacket();
+	};
+
+	pcpp::IPReassembly lengthReassembly;
+	const size_t maxPayloadLen = 0xffff - sizeof(pcpp::iphdr);
+
+	// a fragment that ends beyond the longest payload of a 20-byte header, but within 64K, is malformed
+	pcpp::RawPacket beyondMaxRawPacket = createFragment(1, maxPayloadLen - 3, 8, true, false);
+	pcpp::Packet beyondMaxPacket(&beyondMaxRawPacket);
+	PTF_ASSERT_NULL(lengthReassembly.processPacket(&beyondMaxPacket, status));
+	PTF_ASSERT_EQUAL(status, pcpp::IPReassembly::MALFORMED_FRAGMENT, enum);
+	PTF_ASSERT_EQUAL(lengthReassembly.getStatistics().malformedFragments, 1);
+
+	// a packet with the longest payload is reassembled with a total length of 0xffff
+	pcpp::RawPacket maxLastRawPacket = createFragment(2, maxPayloadLen - 3, 3, true, false);
+	pcpp::RawPacket maxFirstRawPacket = createFragment(2, 0, maxPayloadLen - 3, false, false);
+	pcpp::Packet maxLastPacket(&maxLastRawPacket);
+	pcpp::Packet maxFirstPacket(&maxFirstRawPacket);
+	PTF_ASSERT_NULL(lengthReassembly.processPacket(&maxLastPacket, status));
+	PTF_ASSERT_EQUAL(status, pcpp::IPReassembly::OUT_OF_ORDER_FRAGMENT, enum);
+	pcpp::Packet* maxPacket = lengthReassembly.processPacket(&maxFirstPacket, status);
+	PTF_ASSERT_EQUAL(status, pcpp::IPReassembly::REASSEMBLED, enum);
+	PTF_ASSERT_NOT_NULL(maxPacket);
+	pcpp::IPv4Layer* maxIPLayer = maxPacket->getLayerOfType<pcpp::IPv4Layer>();
+	PTF_ASSERT_NOT_NULL(maxIPLayer);
+	PTF_ASSERT_EQUAL(be16toh(maxIPLayer->getIPv4Header()->totalLength), 0xffff);
+	PTF_ASSERT_EQUAL(maxIPLayer->getLayerPayloadSize(), maxPayloadLen);
+	delete maxPacket;
+
+	// the same payload doesn't fit when the first fragment has a longer header than the fragments checked before it
+	pcpp::RawPacket optionLastRawPacket = createFragment(3, maxPayloadLen - 3, 3, true, false);
+	pcpp::RawPacket optionMiddleRawPacket = createFragment(3, maxPayloadLen - 11, 8, false, false);
+	pcpp::RawPacket optionFirstRawPacket = createFragment(3, 0, maxPayloadLen - 11, false, true);
+	pcpp::Packet optionLastPacket(&optionLastRawPacket);
+	pcpp::Packet optionMiddlePacket(&optionMiddleRawPacket);
+	pcpp::Packet optionFirstPacket(&optionFirstRawPacket);
+	PTF_ASSERT_NULL(lengthReassembly.processPacket(&optionLastPacket, status));
+	PTF_ASSERT_NULL(lengthReassembly.processPacket(&optionMiddlePacket, status));
+	PTF_ASSERT_EQUAL(lengthReassembly.getStatistics().malformedFragments, 1);
+	PTF_ASSERT_NULL(lengthReassembly.processPacket(&optionFirstPacket, status));
+	PTF_ASSERT_EQUAL(status, pcpp::IPReassembly::MALFORMED_FRAGMENT, enum);
+	PTF_ASSERT_EQUAL(lengthReassembly.getStatistics().malformedFragments, 2);
+	PTF_ASSERT_EQUAL(lengthReassembly.getStatistics().packetsReassembled, 1);
+
+	// only the packet of the first malformed fragment is left
+	PTF_ASSERT_EQUAL(lengthReassembly.getCurrentCapacity(), 1);
+}  // TestIPFragLimits
@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <cmath>
 #include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 #include "EndianPortable.h"
 #include "Logger.h"
 #include "GeneralUtils.h"
@@ -245,6 +247,49 @@ PTF_TEST_CASE(TestIPAddress)
 	PTF_ASSERT_FALSE(baseIPv6_2 < baseIpv4_1);
 	PTF_ASSERT_FALSE(baseIPv6_1 < baseIpv4_2);
 	PTF_ASSERT_FALSE(baseIPv6_2 < baseIpv4_2);
+
+	// Allocation-free formatting
+	char addrBuffer[pcpp::IPAddress::MaxStringLength + 1];
+	PTF_ASSERT_EQUAL(pcpp::IPv4Address("255.255.255.255").toString(addrBuffer, sizeof(addrBuffer)),
+	                 pcpp::IPv4Address::MaxStringLength);
+	PTF_ASSERT_EQUAL(std::string(addrBuffer), "255.255.255.255");
+	PTF_ASSERT_EQUAL(pcpp::IPv4Address("10.0.100.7").toString(addrBuffer, 11), 10);
+	PTF_ASSERT_EQUAL(std::string(addrBuffer), "10.0.100.7");
+	PTF_ASSERT_EQUAL(pcpp::IPv4Address("10.0.100.7").toString(addrBuffer, 10), 0);
+	PTF_ASSERT_EQUAL(pcpp::IPv4Address::Zero.toString(addrBuffer, sizeof(addrBuffer)), 7);
+	PTF_ASSERT_EQUAL(std::string(addrBuffer), "0.0.0.0");
+	PTF_ASSERT_EQUAL(baseIPv6_1.toString(addrBuffer, sizeof(addrBuffer)), 13);
+	PTF_ASSERT_EQUAL(std::string(addrBuffer), "2001:db8::2:1");
+	PTF_ASSERT_EQUAL(baseIPv6_1.toString(addrBuffer, 13), 0);
+	PTF_ASSERT_EQUAL(baseIpv4_2.toString(addrBuffer, sizeof(addrBuffer)), 7);
+	PTF_ASSERT_EQUAL(std::string(addrBuffer), "1.1.1.2");
+	pcpp::IPv6Address longIPv6("ffff:ffff:ffff:ffff:ffff:ffff:ffff:fffe");
+	PTF_ASSERT_EQUAL(longIPv6.toString(addrBuffer, sizeof(addrBuffer)), longIPv6.toString().size());
+	PTF_ASSERT_EQUAL(std::string(addrBuffer), longIPv6.toString());
+
+	// Hashing
+	PTF_ASSERT_EQUAL(pcpp::IPv4Address("1.1.1.1").hash(), pcpp::IPv4Address("1.1.1.1").hash());
+	PTF_ASSERT_NOT_EQUAL(pcpp::IPv4Address("1.1.1.1").hash(), pcpp::IPv4Address("1.1.1.2").hash());
+	PTF_ASSERT_NOT_EQUAL(pcpp::IPv6Address("2001:db8::1").hash(), pcpp::IPv6Address("2001:db8::2").hash());
+	PTF_ASSERT_NOT_EQUAL(pcpp::IPv6Address("2001:db8::1").hash(), pcpp::IPv6Address("2001:db9::1").hash());
+	PTF_ASSERT_EQUAL(baseIpv4_1.hash(), baseIpv4_1.getIPv4().hash());
+	PTF_ASSERT_EQUAL(baseIPv6_1.hash(), baseIPv6_1.getIPv6().hash());
+	PTF_ASSERT_EQUAL(std::hash<pcpp::IPAddress>()(baseIPv6_2), static_cast<size_t>(baseIPv6_2.hash()));
+
+	std::unordered_set<pcpp::IPv4Address> ipv4Set;
+	for (uint32_t i = 0; i < 1000; i++)
+		ipv4Set.insert(pcpp::IPv4Address(htobe32(0x0a000000 + i)));
+	ipv4Set.insert(pcpp::IPv4Address("10.0.0.1"));
+	PTF_ASSERT_EQUAL(ipv4Set.size(), 1000);
+
+	std::unordered_map<pcpp::IPAddress, int> ipMap;
+	ipMap[baseIpv4_1] = 1;
+	ipMap[baseIPv6_1] = 2;
+	ipMap[pcpp::IPAddress("1.1.1.1")]++;
+	PTF_ASSERT_EQUAL(ipMap.size(), 2);
+	PTF_ASSERT_EQUAL(ipMap[baseIpv4_1], 2);
+	PTF_ASSERT_EQUAL(ipMap.count(pcpp::IPv6Address("2001:db8::2:1")), 1);
+	PTF_ASSERT_EQUAL(ipMap.count(baseIPv6_2), 0);
 }  // TestIPAddress
 
 PTF_TEST_CASE(TestMacAddress)
@@ -304,6 +349,21 @@ PTF_TEST_CASE(TestMacAddress)
 	                  "Invalid MAC address format, should be xx:xx:xx:xx:xx:xx");
 	PTF_ASSERT_RAISES(pcpp::MacAddress("aa:aa:aa:aa:aa:aa:"), std::invalid_argument,
 	                  "Invalid MAC address format, should be xx:xx:xx:xx:xx:xx");
+
+	// Allocation-free formatting
+	char macBuffer[pcpp::MacAddress::MaxStringLength + 1];
+	PTF_ASSERT_EQUAL(macAddr1.toString(macBuffer, sizeof(macBuffer)), pcpp::MacAddress::MaxStringLength);
+	PTF_ASSERT_EQUAL(std::string(macBuffer), "11:02:33:04:55:06");
+	PTF_ASSERT_EQUAL(pcpp::MacAddress("AB:CD:EF:00:FF:10").toString(macBuffer, sizeof(macBuffer)), 17);
+	PTF_ASSERT_EQUAL(std::string(macBuffer), "ab:cd:ef:00:ff:10");
+	PTF_ASSERT_EQUAL(macAddr1.toString(macBuffer, pcpp::MacAddress::MaxStringLength), 0);
+
+	// Hashing
+	PTF_ASSERT_EQUAL(macAddr1.hash(), macAddr2.hash());
+	PTF_ASSERT_NOT_EQUAL(macAddr1.hash(), macWithZero.hash());
+	std::unordered_set<pcpp::MacAddress> macSet = { macAddr1, macAddr2, macWithZero, pcpp::MacAddress::Zero };
+	PTF_ASSERT_EQUAL(macSet.size(), 3);
+	PTF_ASSERT_EQUAL(macSet.count(macAddr3), 1);
 }  // TestMacAddress
 
 PTF_TEST_CASE(TestLRUList)
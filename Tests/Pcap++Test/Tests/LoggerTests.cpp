@@ -138,6 +138,7 @@ public:
 		pcpp::Logger::getInstance().enableLogs();
 		pcpp::Logger::getInstance().setAllModulesToLogLevel(pcpp::Logger::Info);
 		pcpp::Logger::getInstance().resetLogPrinter();
+		pcpp::Logger::getInstance().setRateLimit(0);
 		std::cout.clear();
 		LogPrinter::clean();
 	}
@@ -301,3 +302,138 @@ PTF_TEST_CASE(TestLogger)
 	PTF_ASSERT_EQUAL(LogPrinter::lastLogLevelSeen, 999);
 	PTF_ASSERT_NULL(LogPrinter::lastLogMessageSeen);
 }  // TestLogger
+
+class AsyncLogCounter
+{
+public:
+	static int numOfMessages;
+	static int numOfMessagesFromOtherThreads;
+	static std::thread::id loggingThreadId;
+
+	static void logPrinter(pcpp::Logger::LogLevel logLevel, const std::string& logMessage, const std::string& fileName,
+	                       const std::string& method, const int line)
+	{
+		AsyncLogCounter::numOfMessages++;
+		if (std::this_thread::get_id() != AsyncLogCounter::loggingThreadId)
+		{
+			AsyncLogCounter::numOfMessagesFromOtherThreads++;
+		}
+	}
+};
+
+int AsyncLogCounter::numOfMessages = 0;
+int AsyncLogCounter::numOfMessagesFromOtherThreads = 0;
+std::thread::id AsyncLogCounter::loggingThreadId;
+
+class AsyncLoggerCleaner
+{
+public:
+	~AsyncLoggerCleaner()
+	{
+		pcpp::Logger::getInstance().disableAsyncLogging();
+		pcpp::Logger::getInstance().resetLogPrinter();
+	}
+};
+
+PTF_TEST_CASE(TestLoggerAsync)
+{
+	// cppcheck-suppress unusedVariable
+	AsyncLoggerCleaner loggerCleaner;
+
+	AsyncLogCounter::numOfMessages = 0;
+	AsyncLogCounter::numOfMessagesFromOtherThreads = 0;
+	AsyncLogCounter::loggingThreadId = std::this_thread::get_id();
+	pcpp::Logger::getInstance().setLogPrinter(&AsyncLogCounter::logPrinter);
+	PTF_ASSERT_FALSE(pcpp::Logger::getInstance().isAsyncLoggingEnabled());
+
+	// messages are printed by the background thread, the last error is updated by the logging thread
+	pcpp::Logger::getInstance().enableAsyncLogging();
+	PTF_ASSERT_TRUE(pcpp::Logger::getInstance().isAsyncLoggingEnabled());
+	uint64_t droppedBefore = pcpp::Logger::getInstance().getNumOfDroppedLogMessages();
+	for (int i = 0; i < 100; i++)
+	{
+		pcpp::invokeErrorLog(std::to_string(i));
+	}
+	PTF_ASSERT_EQUAL(pcpp::Logger::getInstance().getLastError(), "error log99");
+	pcpp::Logger::getInstance().flushLogs();
+	PTF_ASSERT_EQUAL(AsyncLogCounter::numOfMessages, 100);
+	PTF_ASSERT_EQUAL(AsyncLogCounter::numOfMessagesFromOtherThreads, 100);
+	PTF_ASSERT_EQUAL(pcpp::Logger::getInstance().getNumOfDroppedLogMessages(), droppedBefore);
+
+	// messages of threads that exit before they are printed are not lost
+	AsyncLogCounter::numOfMessages = 0;
+	for (int i = 0; i < 50; i++)
+	{
+		std::thread loggingThread([] {
+			for (int j = 0; j < 10; j++)
+			{
+				pcpp::invokeErrorLog();
+			}
+		});
+		loggingThread.join();
+	}
+	pcpp::Logger::getInstance().flushLogs();
+	PTF_ASSERT_EQUAL(AsyncLogCounter::numOfMessages, 500);
+	PTF_ASSERT_EQUAL(pcpp::Logger::getInstance().getNumOfDroppedLogMessages(), droppedBefore);
+
+	// with a tiny queue messages may be dropped, but every message is either printed or counted
+	AsyncLogCounter::numOfMessages = 0;
+	pcpp::Logger::getInstance().enableAsyncLogging(2);
+	for (int i = 0; i < 1000; i++)
+	{
+		pcpp::invokeErrorLog();
+	}
+	pcpp::Logger::getInstance().disableAsyncLogging();
+	PTF_ASSERT_FALSE(pcpp::Logger::getInstance().isAsyncLoggingEnabled());
+	uint64_t dropped = pcpp::Logger::getInstance().getNumOfDroppedLogMessages() - droppedBefore;
+	PTF_ASSERT_EQUAL(AsyncLogCounter::numOfMessages + dropped, 1000);
+
+	// back to synchronous printing
+	AsyncLogCounter::numOfMessages = 0;
+	AsyncLogCounter::numOfMessagesFromOtherThreads = 0;
+	pcpp::invokeErrorLog();
+	PTF_ASSERT_EQUAL(AsyncLogCounter::numOfMessages, 1);
+	PTF_ASSERT_EQUAL(AsyncLogCounter::numOfMessagesFromOtherThreads, 0);
+}  // TestLoggerAsync
+
+PTF_TEST_CASE(TestLoggerRateLimit)
+{
+	// cppcheck-suppress unusedVariable
+	LoggerCleaner loggerCleaner;
+
+	LogPrinter::clean();
+	AsyncLogCounter::numOfMessages = 0;
+	pcpp::Logger::getInstance().setLogPrinter(&AsyncLogCounter::logPrinter);
+	pcpp::Logger::getInstance().setRateLimit(3);
+	PTF_ASSERT_EQUAL(pcpp::Logger::getInstance().getRateLimit(), 3);
+
+	// a burst is cut after 3 messages, or after 6 if it crosses a second boundary
+	for (int i = 0; i < 20; i++)
+	{
+		pcpp::invokeErrorLog(std::to_string(i));
+	}
+	PTF_ASSERT_TRUE(AsyncLogCounter::numOfMessages == 3 || AsyncLogCounter::numOfMessages == 6);
+	PTF_ASSERT_NOT_EQUAL(pcpp::Logger::getInstance().getLastError(), "error log19");
+
+	// the next printed message reports the suppressed ones
+	pcpp::multiPlatformSleep(1);
+	pcpp::Logger::getInstance().setLogPrinter(&LogPrinter::logPrinter);
+	pcpp::invokeErrorLog();
+	PTF_ASSERT_NOT_NULL(LogPrinter::lastLogMessageSeen);
+	if (AsyncLogCounter::numOfMessages == 3)
+	{
+		PTF_ASSERT_EQUAL(*LogPrinter::lastLogMessageSeen, "error log (17 similar messages were suppressed)");
+	}
+	else
+	{
+		PTF_ASSERT_EQUAL(LogPrinter::lastLogMessageSeen->find("error log ("), 0);
+	}
+
+	// disabling the limit prints every message
+	pcpp::Logger::getInstance().setRateLimit(0);
+	for (int i = 0; i < 20; i++)
+	{
+		pcpp::invokeErrorLog(std::to_string(i));
+	}
+	PTF_ASSERT_EQUAL(pcpp::Logger::getInstance().getLastError(), "error log19");
+}  // TestLoggerRateLimit
@@ -0,0 +1,340 @@
+#include "../TestDefinition.h"
+#include "../Common/PcapFileNamesDef.h"
+#include "Logger.h"
+#include "Packet.h"
+#include "IPv4Layer.h"
+#include "IPv6Layer.h"
+#include "TcpLayer.h"
+#include "UdpLayer.h"
+#include "EthLayer.h"
+#include "VlanLayer.h"
+#include "PacketUtils.h"
+#include "PcapFileDevice.h"
+#include "RssDispatcher.h"
+#include "EndianPortable.h"
+#include <atomic>
+#include <map>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct DispatchedPacket
+	{
+		uint32_t flowHash;
+		uint16_t sequence;
+		uint64_t dispatcherHash;
+	};
+
+	// Each worker appends only to its own vector, so no lock is needed
+	struct WorkerRecords
+	{
+		pcpp::RssDispatcher* dispatcher;
+		std::vector<std::vector<DispatchedPacket>> packets;
+		std::atomic<bool> blockWorkers;
+
+		explicit WorkerRecords(size_t numOfWorkers) : dispatcher(nullptr), packets(numOfWorkers), blockWorkers(false)
+		{}
+	};
+
+	void recordPacket(pcpp::RawPacket& rawPacket, uint8_t workerId, void* userCookie)
+	{
+		WorkerRecords* records = static_cast<WorkerRecords*>(userCookie);
+		while (records->blockWorkers.load())
+			std::this_thread::yield();
+
+		pcpp::Packet packet(&rawPacket);
+		DispatchedPacket record;
+		record.flowHash = pcpp::hash5Tuple(&packet);
+		pcpp::IPv4Layer* ipLayer = packet.getLayerOfType<pcpp::IPv4Layer>();
+		record.sequence = ipLayer != nullptr ? be16toh(ipLayer->getIPv4Header()->ipId) : 0;
+		record.dispatcherHash = records->dispatcher->computeHash(rawPacket);
+		records->packets[workerId].push_back(record);
+	}
+
+	pcpp::RawPacket createUdpPacket(const pcpp::IPv4Address& srcIP, const pcpp::IPv4Address& dstIP,
+	                                uint16_t srcPort, uint16_t dstPort, uint16_t ipId)
+	{
+		pcpp::Packet packet(100);
+		packet.addLayer(
+		    new pcpp::EthLayer(pcpp::MacAddress("00:11:22:33:44:55"), pcpp::MacAddress("66:77:88:99:aa:bb")), true);
+		pcpp::IPv4Layer* ipLayer = new pcpp::IPv4Layer(srcIP, dstIP);
+		ipLayer->getIPv4Header()->ipId = htobe16(ipId);
+		packet.addLayer(ipLayer, true);
+		packet.addLayer(new pcpp::UdpLayer(srcPort, dstPort), true);
+		packet.computeCalculateFields();
+		return *packet.getRawPacket();
+	}
+}  // namespace
+
+PTF_TEST_CASE(TestRssDispatcherHashing)
+{
+	// the hash computed on the raw bytes is the one ToeplitzHash computes on the parsed packet, for all link types
+	pcpp::ToeplitzHash toeplitzHash;
+	pcpp::RssDispatcher dispatcher(4, recordPacket, nullptr);
+	pcpp::RssDispatcher::DispatcherConfig hash64Config;
+	hash64Config.hashFunction = pcpp::RssDispatcher::HashFunction::Hash64;
+	pcpp::RssDispatcher hash64Dispatcher(4, recordPacket, nullptr, hash64Config);
+
+	const char* files[] = { EXAMPLE_PCAP_PATH,      EXAMPLE_PCAP_VLAN,  SLL_PCAP_PATH,
+		                    SLL2_PCAP_PATH,         RAW_IP_PCAP_PATH,   EXAMPLE_LINKTYPE_IPV6,
+		                    EXAMPLE_LINKTYPE_IPV4,  EXAMPLE_PCAP_HTTP_REQUEST };
+
+	size_t comparedPackets = 0;
+	for (const char* fileName : files)
+	{
+		pcpp::PcapFileReaderDevice reader(fileName);
+		PTF_ASSERT_TRUE(reader.open());
+
+		pcpp::RawPacket rawPacket;
+		while (reader.getNextPacket(rawPacket))
+		{
+			pcpp::Packet packet(&rawPacket);
+			pcpp::IPv4Layer* ipv4Layer = packet.getLayerOfType<pcpp::IPv4Layer>();
+			pcpp::IPv6Layer* ipv6Layer = packet.getLayerOfType<pcpp::IPv6Layer>();
+			pcpp::Layer* ipLayer = ipv4Layer != nullptr ? static_cast<pcpp::Layer*>(ipv4Layer) : ipv6Layer;
+			if (ipLayer == nullptr)
+			{
+				PTF_ASSERT_EQUAL(dispatcher.computeHash(rawPacket), 0);
+				PTF_ASSERT_EQUAL(dispatcher.getWorkerId(rawPacket), 0);
+				continue;
+			}
+
+			// only IP directly over the link layer, and the transport layer directly over it, without tunnels
+			if (ipv4Layer != nullptr && ipv6Layer != nullptr)
+				continue;
+			pcpp::Layer* linkLayer = ipLayer->getPrevLayer();
+			if (linkLayer != nullptr && linkLayer->getProtocol() != pcpp::Ethernet &&
+			    linkLayer->getProtocol() != pcpp::VLAN && linkLayer->getProtocol() != pcpp::SLL &&
+			    linkLayer->getProtocol() != pcpp::SLL2)
+				continue;
+			pcpp::Layer* transportLayer = packet.getLayerOfType<pcpp::TcpLayer>();
+			if (transportLayer == nullptr)
+				transportLayer = packet.getLayerOfType<pcpp::UdpLayer>();
+			if (transportLayer != nullptr && transportLayer->getPrevLayer() != ipLayer)
+				continue;
+			if (ipv4Layer != nullptr && ipv4Layer->isFragment())
+				continue;
+
+			uint32_t expectedHash =
+			    transportLayer != nullptr ? toeplitzHash.hash5Tuple(&packet) : toeplitzHash.hash2Tuple(&packet);
+			PTF_ASSERT_EQUAL(dispatcher.computeHash(rawPacket), expectedHash, hex);
+			PTF_ASSERT_EQUAL(dispatcher.getWorkerId(rawPacket), expectedHash % 128 % 4);
+			if (transportLayer != nullptr)
+				PTF_ASSERT_EQUAL(hash64Dispatcher.computeHash(rawPacket), pcpp::hash5Tuple64(&packet));
+			comparedPackets++;
+		}
+	}
+	PTF_ASSERT_GREATER_THAN(comparedPackets, 4000);
+
+	// IPv4 fragments are hashed by their addresses only
+	pcpp::PcapFileReaderDevice fragmentsReader("PcapExamples/ip4_fragments.pcap");
+	PTF_ASSERT_TRUE(fragmentsReader.open());
+	pcpp::RawPacket fragment;
+	size_t numOfFragments = 0;
+	while (fragmentsReader.getNextPacket(fragment))
+	{
+		pcpp::Packet packet(&fragment);
+		if (!packet.getLayerOfType<pcpp::IPv4Layer>()->isFragment())
+			continue;
+		PTF_ASSERT_EQUAL(dispatcher.computeHash(fragment), toeplitzHash.hash2Tuple(&packet), hex);
+		numOfFragments++;
+	}
+	PTF_ASSERT_GREATER_THAN(numOfFragments, 0);
+
+	// so are IPv4 packets with a header length below the minimum
+	pcpp::RawPacket shortHeader =
+	    createUdpPacket(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("10.0.0.2"), 1000, 53, 0);
+	pcpp::Packet shortHeaderPacket(&shortHeader);
+	uint32_t shortHeaderHash = toeplitzHash.hash2Tuple(&shortHeaderPacket);
+	for (uint8_t headerLen = 0; headerLen < 5; headerLen++)
+	{
+		shortHeaderPacket.getLayerOfType<pcpp::IPv4Layer>()->getIPv4Header()->internetHeaderLength = headerLen;
+		PTF_ASSERT_EQUAL(dispatcher.computeHash(shortHeader), shortHeaderHash, hex);
+	}
+
+	// VLAN tags don't change the hash
+	pcpp::RawPacket untagged =
+	    createUdpPacket(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("10.0.0.2"), 1000, 53, 0);
+	pcpp::Packet tagged(&untagged);
+	tagged.insertLayer(tagged.getFirstLayer(), new pcpp::VlanLayer(100, false, 0, PCPP_ETHERTYPE_IP), true);
+	tagged.insertLayer(tagged.getFirstLayer(), new pcpp::VlanLayer(200, false, 0, PCPP_ETHERTYPE_VLAN), true);
+	tagged.getLayerOfType<pcpp::EthLayer>()->getEthHeader()->etherType = htobe16(PCPP_ETHERTYPE_VLAN);
+	pcpp::RawPacket untaggedCopy =
+	    createUdpPacket(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("10.0.0.2"), 1000, 53, 0);
+	PTF_ASSERT_EQUAL(dispatcher.computeHash(*tagged.getRawPacket()), dispatcher.computeHash(untaggedCopy));
+	PTF_ASSERT_NOT_EQUAL(dispatcher.computeHash(untaggedCopy), 0);
+
+	// without ports only the addresses are hashed
+	pcpp::RssDispatcher::DispatcherConfig noPortsConfig;
+	noPortsConfig.hashPorts = false;
+	pcpp::RssDispatcher noPortsDispatcher(4, recordPacket, nullptr, noPortsConfig);
+	pcpp::Packet untaggedPacket(&untaggedCopy);
+	PTF_ASSERT_EQUAL(noPortsDispatcher.computeHash(untaggedCopy), toeplitzHash.hash2Tuple(&untaggedPacket));
+}  // TestRssDispatcherHashing
+
+PTF_TEST_CASE(TestRssDispatcher)
+{
+	const size_t numOfWorkers = 4;
+	const size_t numOfFlows = 64;
+	const uint16_t packetsPerFlow = 50;
+
+	// packets of many flows, interleaved, in both directions. The IP ID is the sequence number within the flow
+	std::vector<pcpp::RawPacket> packets;
+	for (uint16_t sequence = 0; sequence < packetsPerFlow; sequence++)
+	{
+		for (uint32_t flow = 0; flow < numOfFlows; flow++)
+		{
+			// the default Toeplitz key only depends on the XOR of the 16-bit words of the addresses and ports, so
+			// they shouldn't change together
+			pcpp::IPv4Address clientIP(htobe32(0x0A000000 + ((flow * 2654435761U) >> 8)));
+			pcpp::IPv4Address serverIP("192.168.1.1");
+			uint16_t clientPort = static_cast<uint16_t>(20000 + flow * 7);
+			if (sequence % 2 == 0)
+				packets.push_back(createUdpPacket(clientIP, serverIP, clientPort, 53, sequence));
+			else
+				packets.push_back(createUdpPacket(serverIP, clientIP, 53, clientPort, sequence));
+		}
+	}
+
+	for (int hashFunction = 0; hashFunction < 2; hashFunction++)
+	{
+		pcpp::RssDispatcher::DispatcherConfig config(
+		    256, hashFunction == 0 ? pcpp::RssDispatcher::HashFunction::Toeplitz
+		                           : pcpp::RssDispatcher::HashFunction::Hash64,
+		    pcpp::RssDispatcher::BackpressurePolicy::Block);
+		WorkerRecords records(numOfWorkers);
+		pcpp::RssDispatcher dispatcher(numOfWorkers, recordPacket, &records, config);
+		records.dispatcher = &dispatcher;
+		PTF_ASSERT_EQUAL(dispatcher.getNumOfWorkers(), numOfWorkers);
+		PTF_ASSERT_FALSE(dispatcher.dispatch(packets[0]));
+		PTF_ASSERT_TRUE(dispatcher.start());
+		PTF_ASSERT_TRUE(dispatcher.isRunning());
+
+		// the first half one by one, the second half in batches
+		size_t half = packets.size() / 2;
+		for (size_t i = 0; i < half; i++)
+		{
+			PTF_ASSERT_TRUE(dispatcher.dispatch(packets[i]));
+		}
+		std::vector<const pcpp::RawPacket*> batch;
+		for (size_t i = half; i < packets.size(); i++)
+		{
+			batch.push_back(&packets[i]);
+			if (batch.size() == 32 || i == packets.size() - 1)
+			{
+				PTF_ASSERT_EQUAL(dispatcher.dispatch(batch.data(), batch.size()), batch.size());
+				batch.clear();
+			}
+		}
+		dispatcher.stop();
+		PTF_ASSERT_FALSE(dispatcher.isRunning());
+
+		pcpp::RssDispatcher::DispatcherStats stats;
+		dispatcher.getStatistics(stats);
+		PTF_ASSERT_EQUAL(stats.dispatchedPackets, packets.size());
+		PTF_ASSERT_EQUAL(stats.processedPackets, packets.size());
+		PTF_ASSERT_EQUAL(stats.ringDrops, 0);
+
+		// each flow went to a single worker, in order, and the workers were all used
+		std::map<uint32_t, size_t> flowWorkers;
+		for (size_t workerId = 0; workerId < numOfWorkers; workerId++)
+		{
+			const std::vector<DispatchedPacket>& workerPackets = records.packets[workerId];
+			PTF_ASSERT_GREATER_THAN(workerPackets.size(), 0);
+			dispatcher.getWorkerStatistics(workerId, stats);
+			PTF_ASSERT_EQUAL(stats.processedPackets, workerPackets.size());
+
+			std::map<uint32_t, uint16_t> nextSequence;
+			for (const auto& record : workerPackets)
+			{
+				PTF_ASSERT_EQUAL((record.dispatcherHash & 127) % numOfWorkers, workerId);
+				auto flowWorker = flowWorkers.emplace(record.flowHash, workerId).first;
+				PTF_ASSERT_EQUAL(flowWorker->second, workerId);
+				PTF_ASSERT_EQUAL(record.sequence, nextSequence[record.flowHash]);
+				nextSequence[record.flowHash]++;
+			}
+		}
+		PTF_ASSERT_EQUAL(flowWorkers.size(), numOfFlows);
+	}
+
+	// with the drop policy a full ring drops packets without waiting
+	{
+		WorkerRecords records(1);
+		records.blockWorkers = true;
+		pcpp::RssDispatcher dispatcher(1, recordPacket, &records, pcpp::RssDispatcher::DispatcherConfig(16));
+		records.dispatcher = &dispatcher;
+		PTF_ASSERT_TRUE(dispatcher.start());
+		for (size_t i = 0; i < 100; i++)
+		{
+			dispatcher.dispatch(packets[i]);
+		}
+
+		pcpp::RssDispatcher::DispatcherStats stats;
+		dispatcher.getStatistics(stats);
+		PTF_ASSERT_EQUAL(stats.dispatchedPackets, 16);
+		PTF_ASSERT_EQUAL(stats.ringDrops, 84);
+		records.blockWorkers = false;
+		dispatcher.stop();
+		dispatcher.getStatistics(stats);
+		PTF_ASSERT_EQUAL(stats.processedPackets, 16);
+		PTF_ASSERT_EQUAL(records.packets[0].size(), 16);
+
+		// the dispatcher can be started again
+		PTF_ASSERT_TRUE(dispatcher.start());
+		PTF_ASSERT_TRUE(dispatcher.dispatch(packets[0]));
+		dispatcher.stop();
+		PTF_ASSERT_EQUAL(records.packets[0].size(), 17);
+	}
+
+	// dispatch a file
+	{
+		WorkerRecords records(numOfWorkers);
+		pcpp::RssDispatcher dispatcher(numOfWorkers, recordPacket, &records,
+		                               pcpp::RssDispatcher::DispatcherConfig(
+		                                   64, pcpp::RssDispatcher::HashFunction::Toeplitz,
+		                                   pcpp::RssDispatcher::BackpressurePolicy::Block));
+		records.dispatcher = &dispatcher;
+		PTF_ASSERT_TRUE(dispatcher.start());
+		pcpp::PcapFileReaderDevice reader(EXAMPLE_PCAP_HTTP_REQUEST);
+		PTF_ASSERT_TRUE(reader.open());
+		size_t dispatched = dispatcher.dispatchFromReader(reader, 50);
+		dispatcher.stop();
+
+		pcpp::IFileDevice::PcapStats readerStats;
+		reader.getStatistics(readerStats);
+		PTF_ASSERT_EQUAL(dispatched, readerStats.packetsRecv);
+		pcpp::RssDispatcher::DispatcherStats stats;
+		dispatcher.getStatistics(stats);
+		PTF_ASSERT_EQUAL(stats.processedPackets, dispatched);
+		size_t recorded = 0;
+		for (const auto& workerPackets : records.packets)
+		{
+			recorded += workerPackets.size();
+		}
+		PTF_ASSERT_EQUAL(recorded, dispatched);
+	}
+
+	// invalid configurations
+	pcpp::Logger::getInstance().suppressLogs();
+	pcpp::RssDispatcher noWorkers(0, recordPacket, nullptr);
+	PTF_ASSERT_FALSE(noWorkers.start());
+	pcpp::RssDispatcher tooManyWorkers(pcpp::RssDispatcher::MaxNumOfWorkers + 1, recordPacket, nullptr);
+	PTF_ASSERT_FALSE(tooManyWorkers.start());
+	pcpp::RssDispatcher badRingSize(2, recordPacket, nullptr, pcpp::RssDispatcher::DispatcherConfig(1000));
+	PTF_ASSERT_FALSE(badRingSize.start());
+	pcpp::RssDispatcher noCallback(2, nullptr, nullptr);
+	PTF_ASSERT_FALSE(noCallback.start());
+	pcpp::RssDispatcher::DispatcherConfig shortKeyConfig;
+	uint8_t shortRssKey[12] = { 0 };
+	shortKeyConfig.rssKey = shortRssKey;
+	shortKeyConfig.rssKeyLength = sizeof(shortRssKey);
+	pcpp::RssDispatcher shortKey(2, recordPacket, nullptr, shortKeyConfig);
+	PTF_ASSERT_FALSE(shortKey.start());
+	pcpp::RssDispatcher running(1, recordPacket, nullptr);
+	PTF_ASSERT_TRUE(running.start());
+	PTF_ASSERT_FALSE(running.start());
+	pcpp::Logger::getInstance().enableLogs();
+	running.stop();
+	PTF_ASSERT_FALSE(running.dispatch(packets[0]));
+}  // TestRssDispatcher
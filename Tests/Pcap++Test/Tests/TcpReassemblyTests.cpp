@@ -7,6 +7,7 @@
 #include "EndianPortable.h"
 #include "SystemUtils.h"
 #include "TcpReassembly.h"
+#include "HttpReassembly.h"
 #include "IPv4Layer.h"
 #include "TcpLayer.h"
 #include "PayloadLayer.h"
@@ -1375,3 +1376,80 @@ PTF_TEST_CASE(TestTcpReassemblyHighPrecision)
 	    readFileIntoString(std::string("PcapExamples/three_http_streams_conn_1_output.txt"));
 	PTF_ASSERT_EQUAL(expectedReassemblyData, stats.begin()->second.reassembledData);
 }  // TestTcpReassemblyHighPrecision
+
+// ~~~~~~~~~~~~~~~~~~~
+// HttpReassemblyStats
+// ~~~~~~~~~~~~~~~~~~~
+
+struct HttpReassemblyStats
+{
+	int numOfHeaders[2] = { 0, 0 };
+	int numOfMessages[2] = { 0, 0 };
+	int numOfIncompleteMessages = 0;
+	size_t bodyBytes[2] = { 0, 0 };
+	size_t reportedBodyBytes[2] = { 0, 0 };
+	std::vector<int> statusCodes;
+};
+
+static void httpReassemblyHeadersCallback(int8_t side, const pcpp::HttpMessageView& message,
+                                          const pcpp::ConnectionData&, void* userCookie)
+{
+	HttpReassemblyStats* stats = (HttpReassemblyStats*)userCookie;
+	stats->numOfHeaders[side]++;
+	if (!message.isRequest())
+		stats->statusCodes.push_back(message.getStatusCode());
+}
+
+static void httpReassemblyBodyCallback(int8_t side, const uint8_t*, size_t bodyDataLen, const pcpp::ConnectionData&,
+                                       void* userCookie)
+{
+	((HttpReassemblyStats*)userCookie)->bodyBytes[side] += bodyDataLen;
+}
+
+static void httpReassemblyMessageEndCallback(int8_t side, const pcpp::HttpMessageInfo& message,
+                                             const pcpp::ConnectionData&, void* userCookie)
+{
+	HttpReassemblyStats* stats = (HttpReassemblyStats*)userCookie;
+	stats->numOfMessages[side]++;
+	stats->reportedBodyBytes[side] += message.bodyLength;
+	if (!message.isComplete)
+		stats->numOfIncompleteMessages++;
+}
+
+PTF_TEST_CASE(TestHttpReassembly)
+{
+	std::string errMsg;
+	std::vector<pcpp::RawPacket> packetStream;
+
+	PTF_ASSERT_TRUE(readPcapIntoPacketVec("PcapExamples/three_http_streams.pcap", packetStream, errMsg));
+
+	HttpReassemblyStats results;
+	pcpp::HttpReassembly httpReassembly(httpReassemblyHeadersCallback, httpReassemblyBodyCallback,
+	                                    httpReassemblyMessageEndCallback, &results);
+	pcpp::TcpReassembly tcpReassembly(pcpp::HttpReassembly::onTcpMessageReady, &httpReassembly, nullptr,
+	                                  pcpp::HttpReassembly::onTcpConnectionEnd);
+
+	for (auto& rawPacket : packetStream)
+	{
+		pcpp::Packet packet(&rawPacket);
+		tcpReassembly.reassemblePacket(packet);
+	}
+	tcpReassembly.closeAllConnections();
+
+	PTF_ASSERT_EQUAL(httpReassembly.getNumOfConnections(), 0);
+	PTF_ASSERT_EQUAL(results.numOfHeaders[0], 3);
+	PTF_ASSERT_EQUAL(results.numOfHeaders[1], 3);
+	PTF_ASSERT_EQUAL(results.numOfMessages[0], 3);
+	PTF_ASSERT_EQUAL(results.numOfMessages[1], 3);
+	PTF_ASSERT_EQUAL(results.numOfIncompleteMessages, 0);
+	PTF_ASSERT_EQUAL(results.bodyBytes[0], results.reportedBodyBytes[0]);
+	PTF_ASSERT_EQUAL(results.bodyBytes[1], results.reportedBodyBytes[1]);
+	PTF_ASSERT_EQUAL(results.statusCodes.size(), 3);
+	for (auto statusCode : results.statusCodes)
+		PTF_ASSERT_EQUAL(statusCode, 200);
+
+	pcpp::HttpReassembly::HttpReassemblyStats stats = httpReassembly.getStatistics();
+	PTF_ASSERT_EQUAL(stats.requests, 3);
+	PTF_ASSERT_EQUAL(stats.responses, 3);
+	PTF_ASSERT_EQUAL(stats.parseErrors, 0);
+}  // TestHttpReassembly
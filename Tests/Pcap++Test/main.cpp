@@ -13,6 +13,7 @@ static struct option PcapTestOptions[] = {
 	{ "remote-ip",           required_argument, nullptr, 'r' },
 	{ "remote-port",         required_argument, nullptr, 'p' },
 	{ "dpdk-port",           required_argument, nullptr, 'd' },
+	{ "dpdk-vdev",           required_argument, nullptr, 'e' },
 	{ "no-networking",       no_argument,       nullptr, 'n' },
 	{ "verbose",             no_argument,       nullptr, 'v' },
 	{ "mem-verbose",         no_argument,       nullptr, 'm' },
@@ -29,13 +30,16 @@ static struct option PcapTestOptions[] = {
 void printUsage()
 {
 	std::cout << "Usage: Pcap++Test -i ip_to_use | [-n] [-b] [-s] [-m] [-r remote_ip_addr] [-p remote_port] [-d "
-	             "dpdk_port] [-k ip_addr] [-t tags] [-w] [-h]\n\n"
+	             "dpdk_port] [-e dpdk_vdev] [-k ip_addr] [-t tags] [-w] [-h]\n\n"
 	          << "Flags:\n"
 	          << "-i --use-ip              IP to use for sending and receiving packets\n"
 	          << "-b --debug-mode          Set log level to DEBUG\n"
 	          << "-r --remote-ip	          IP of remote machine running rpcapd to test remote capture\n"
 	          << "-p --remote-port         Port of remote machine running rpcapd to test remote capture\n"
-	          << "-d --dpdk-port           The DPDK NIC port to test. Required if compiling with DPDK\n"
+	          << "-d --dpdk-port           The DPDK NIC port to test. Required if compiling with DPDK, unless -e is used\n"
+	          << "-e --dpdk-vdev           A DPDK virtual device to create and test instead of a NIC, for example:\n"
+	          << "                         net_pcap0,rx_pcap=PcapExamples/example.pcap,tx_pcap=/tmp/out.pcap\n"
+	          << "                         or net_null0. Hugepages and PCI devices are not used in this mode\n"
 	          << "-n --no-networking       Do not run tests that requires networking\n"
 	          << "-v --verbose             Run in verbose mode (emits more output in several tests)\n"
 	          << "-m --mem-verbose         Output information about each memory allocation and deallocation\n"
@@ -66,7 +70,7 @@ int main(int argc, char* argv[])
 
 	int optionIndex = 0;
 	int opt = 0;
-	while ((opt = getopt_long(argc, argv, "k:i:br:p:d:nvt:x:smw", PcapTestOptions, &optionIndex)) != -1)
+	while ((opt = getopt_long(argc, argv, "k:i:br:p:d:e:nvt:x:smw", PcapTestOptions, &optionIndex)) != -1)
 	{
 		switch (opt)
 		{
@@ -90,6 +94,9 @@ int main(int argc, char* argv[])
 		case 'd':
 			PcapTestGlobalArgs.dpdkPort = (int)atoi(optarg);
 			break;
+		case 'e':
+			PcapTestGlobalArgs.dpdkVdev = optarg;
+			break;
 		case 'n':
 			runWithNetworking = false;
 			break;
@@ -166,6 +173,10 @@ int main(int argc, char* argv[])
 	}
 
 #ifdef USE_DPDK
+	// the virtual device is the only DPDK port when PCI devices aren't used
+	if (!PcapTestGlobalArgs.dpdkVdev.empty())
+		PcapTestGlobalArgs.dpdkPort = 0;
+
 	if (PcapTestGlobalArgs.dpdkPort == -1 && runWithNetworking)
 	{
 		std::cerr << "When testing with DPDK you must provide the DPDK NIC port to test\n\n";
@@ -211,6 +222,8 @@ int main(int argc, char* argv[])
 
 	PTF_RUN_TEST(TestLogger, "no_network;logger");
 	PTF_RUN_TEST(TestLoggerMultiThread, "no_network;logger;skip_mem_leak_check");
+	PTF_RUN_TEST(TestLoggerAsync, "no_network;logger");
+	PTF_RUN_TEST(TestLoggerRateLimit, "no_network;logger");
 
 	PTF_RUN_TEST(TestPcapFileReadWrite, "no_network;pcap");
 	PTF_RUN_TEST(TestPcapFilePrecision, "no_network;pcap");
@@ -221,11 +234,17 @@ int main(int argc, char* argv[])
 	PTF_RUN_TEST(TestPcapNgFileReadWrite, "no_network;pcap;pcapng");
 	PTF_RUN_TEST(TestPcapNgFileReadWriteAdv, "no_network;pcap;pcapng");
 	PTF_RUN_TEST(TestPcapNgFileTooManyInterfaces, "no_network;pcap;pcapng");
+	PTF_RUN_TEST(TestPcapNgFileParallelCompression, "no_network;pcapng");
+	PTF_RUN_TEST(TestPcapNgFileZeroCopyRead, "no_network;pcapng");
 	PTF_RUN_TEST(TestPcapNgFilePrecision, "no_network;pcapng");
 	PTF_RUN_TEST(TestPcapFileReadLinkTypeIPv6, "no_network;pcap");
 	PTF_RUN_TEST(TestPcapFileReadLinkTypeIPv4, "no_network;pcap");
 	PTF_RUN_TEST(TestSolarisSnoopFileRead, "no_network;pcap;snoop");
 	PTF_RUN_TEST(TestPcapFileWriterDeviceDestructor, "no_network;pcap");
+	PTF_RUN_TEST(TestRotatingFileWriterDevice, "no_network;pcap;pcapng");
+
+	PTF_RUN_TEST(TestRssDispatcherHashing, "no_network;rss");
+	PTF_RUN_TEST(TestRssDispatcher, "no_network;rss");
 
 	PTF_RUN_TEST(TestPcapLiveDeviceList, "no_network;live_device;skip_mem_leak_check");
 	PTF_RUN_TEST(TestPcapLiveDeviceListSearch, "live_device");
@@ -268,6 +287,8 @@ int main(int argc, char* argv[])
 	PTF_RUN_TEST(TestDpdkDeviceSendPackets, "dpdk");
 	PTF_RUN_TEST(TestDpdkDeviceWorkerThreads, "dpdk");
 	PTF_RUN_TEST(TestDpdkMbufRawPacket, "dpdk");
+	PTF_RUN_TEST(TestDpdkMbufRawPacketChained, "dpdk");
+	PTF_RUN_TEST(TestDpdkPipeline, "dpdk");
 
 	PTF_RUN_TEST(TestKniDevice, "dpdk;kni;skip_mem_leak_check");
 	PTF_RUN_TEST(TestKniDeviceSendReceive, "dpdk;kni;skip_mem_leak_check");
@@ -290,6 +311,7 @@ int main(int argc, char* argv[])
 	PTF_RUN_TEST(TestTcpReassemblyTimeStamps, "no_network;tcp_reassembly");
 	PTF_RUN_TEST(TestTcpReassemblyFinReset, "no_network;tcp_reassembly");
 	PTF_RUN_TEST(TestTcpReassemblyHighPrecision, "no_network;tcp_reassembly");
+	PTF_RUN_TEST(TestHttpReassembly, "no_network;tcp_reassembly;http_reassembly");
 
 	PTF_RUN_TEST(TestIPFragmentationSanity, "no_network;ip_frag");
 	PTF_RUN_TEST(TestIPFragOutOfOrder, "no_network;ip_frag");
@@ -298,6 +320,7 @@ int main(int argc, char* argv[])
 	PTF_RUN_TEST(TestIPFragMapOverflow, "no_network;ip_frag");
 	PTF_RUN_TEST(TestIPFragRemove, "no_network;ip_frag");
 	PTF_RUN_TEST(TestIPFragWithPadding, "no_network;ip_frag");
+	PTF_RUN_TEST(TestIPFragLimits, "no_network;ip_frag");
 
 	PTF_RUN_TEST(TestRawSockets, "raw_sockets");
 